@@ -21,6 +21,28 @@ typedef struct {
     uint8_t error_code;                // Current error code from serial data
 } matter_attributes_t;
 
+/**
+ * Smoothing of noisy readings before they reach Matter attributes
+ * Exponentially weighted moving average: each new reading moves the
+ * published value 1/2^shift of the way towards it (0 = no smoothing).
+ */
+typedef struct {
+    uint8_t temperature_shift;  // TemperatureMeasurement MeasuredValue
+    uint8_t fan_speed_shift;    // LevelControl CurrentLevel
+} matter_bridge_smoothing_t;
+
+/**
+ * Burner control requested by Matter controllers
+ * OnOff commands set enable, LevelControl MoveToLevel sets power.  The
+ * Viking Bio serial link only carries data from the burner, so requests
+ * are recorded for the control path to pick up rather than sent.
+ */
+typedef struct {
+    bool enable;                // Burner on (OnOff On / Off / Toggle)
+    uint8_t power;              // Power setpoint 0-100% (MoveToLevel)
+    uint32_t requested_ms;      // Time of the last request (milliseconds)
+} matter_bridge_burner_request_t;
+
 /**
  * Initialize the Matter bridge
  * Initializes platform, connects WiFi, and prints commissioning info
@@ -79,6 +101,56 @@ void matter_bridge_update_temperature(uint16_t temp);
  */
 void matter_bridge_update_diagnostics(uint8_t error_code);
 
+/**
+ * Report the Viking Bio serial link going quiet or coming back
+ * Logs a DataTimeoutChange event. While the link is down, flame and fault
+ * changes (from the cleared readings) are not logged as events.
+ * @param active False when data timed out, true when it resumed
+ */
+void matter_bridge_update_serial_link(bool active);
+
+/**
+ * Set reading smoothing
+ * Takes effect from the next reading; use matter_bridge_save_report_config()
+ * to keep it across reboots.
+ * @param smoothing New smoothing (shifts 0-8)
+ * @return 0 on success, -1 on invalid settings
+ */
+int matter_bridge_set_smoothing(const matter_bridge_smoothing_t *smoothing);
+
+/**
+ * Get reading smoothing
+ * @param smoothing Output smoothing (must not be NULL)
+ */
+void matter_bridge_get_smoothing(matter_bridge_smoothing_t *smoothing);
+
+/**
+ * Save smoothing and the attributes' reportable-change thresholds to flash
+ * Thresholds are set with matter_attributes_set_report_threshold().
+ * @return 0 on success, -1 on failure
+ */
+int matter_bridge_save_report_config(void);
+
+/**
+ * Request the burner be enabled or disabled (OnOff cluster commands)
+ * @param enable True to enable the burner
+ * @return 0 on success, -1 if the bridge is not initialized
+ */
+int matter_bridge_request_burner_enable(bool enable);
+
+/**
+ * Request a burner power setpoint (LevelControl cluster commands)
+ * @param power Power in percent (0-100)
+ * @return 0 on success, -1 if out of range or the bridge is not initialized
+ */
+int matter_bridge_request_burner_power(uint8_t power);
+
+/**
+ * Get the last burner control request
+ * @param request Output request (must not be NULL)
+ */
+void matter_bridge_get_burner_request(matter_bridge_burner_request_t *request);
+
 /**
  * Add a Matter controller to receive attribute reports over WiFi
  * @param ip_address Controller IP address (e.g., "192.168.1.100")
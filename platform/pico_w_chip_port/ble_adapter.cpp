@@ -34,6 +34,7 @@
 #include <inttypes.h>
 #include "pico/stdlib.h"
 #include "ble_adapter.h"
+#include "msg_pool.h"
 #include "btstack_tlv_littlefs.h"
 
 /* BTstack headers (available when pico_btstack_ble + pico_btstack_cyw43 are linked) */
@@ -178,7 +179,9 @@ static hci_con_handle_t active_con_handle = HCI_CON_HANDLE_INVALID;
 /* COBLe reassembly state                                               */
 /* ------------------------------------------------------------------ */
 
-static uint8_t  coble_rx_buf[COBLE_MAX_MSG_SIZE];
+/* Reassembly buffer: message pool block, allocated on the first segment and
+ * handed to the caller by ble_adapter_receive_buffer() (NULL when idle). */
+static packet_buffer_t *coble_rx_pb  = NULL;
 static size_t   coble_rx_offset      = 0;
 static size_t   coble_rx_total_len   = 0;
 static bool     coble_rx_in_progress = false;
@@ -198,11 +201,29 @@ static uint8_t  coble_tx_counter     = 1;
 /* Indication-based TX state (COBLe fragmented sending via indicate)   */
 /* ------------------------------------------------------------------ */
 
-static uint8_t  coble_tx_msg[COBLE_MAX_MSG_SIZE];
+/* Message being fragmented; referenced, not copied (see ble_adapter_send_data) */
+static const uint8_t *coble_tx_msg       = NULL;
 static size_t   coble_tx_msg_len         = 0;
 static size_t   coble_tx_msg_sent        = 0;
 static bool     coble_tx_first_frag      = false;
 static bool     coble_tx_active          = false;
+/* Pool block backing coble_tx_msg (ble_adapter_send_buffer), NULL otherwise */
+static packet_buffer_t *coble_tx_pb      = NULL;
+
+/* End the current transmission and drop the reference to its buffer */
+static void coble_tx_finish(void) {
+    coble_tx_active = false;
+    msg_pool_release(coble_tx_pb);
+    coble_tx_pb = NULL;
+}
+
+/* Drop a partially or fully reassembled message */
+static void coble_rx_discard(void) {
+    msg_pool_release(coble_rx_pb);
+    coble_rx_pb     = NULL;
+    coble_rx_offset = 0;
+    coble_rx_ready  = false;
+}
 
 /*
  * BLE transport capabilities response.
@@ -438,6 +459,17 @@ static int att_write_callback(hci_con_handle_t connection_handle,
             return 0;
         }
 
+        /* A new message replaces any unconsumed one; reuse its block */
+        if (coble_rx_pb == NULL) {
+            coble_rx_pb = msg_pool_alloc();
+            if (coble_rx_pb == NULL) {
+                printf("BLE COBLe: Message pool exhausted, dropping message\n");
+                coble_rx_in_progress = false;
+                return 0;
+            }
+        }
+        packet_buffer_reset_rx(coble_rx_pb);
+
         coble_rx_offset      = 0;
         coble_rx_total_len   = total_len;
         coble_rx_in_progress = true;
@@ -452,12 +484,13 @@ static int att_write_callback(hci_con_handle_t connection_handle,
         if (coble_rx_offset + data_len > COBLE_MAX_MSG_SIZE) {
             data_len = (uint16_t)(COBLE_MAX_MSG_SIZE - coble_rx_offset);
         }
-        memcpy(coble_rx_buf + coble_rx_offset,
+        memcpy(coble_rx_pb->data + coble_rx_offset,
                buffer + offset2, data_len);
         coble_rx_offset += data_len;
     }
 
     if (flags & COBLE_FLAG_END) {
+        coble_rx_pb->length  = coble_rx_offset;
         coble_rx_ready       = true;
         coble_rx_in_progress = false;
         printf("BLE COBLe: Complete message received (%zu/%zu bytes)\n",
@@ -467,13 +500,13 @@ static int att_write_callback(hci_con_handle_t connection_handle,
             printf("BLE-DBG: COBLe RX complete len=%zu data=",
                    coble_rx_offset);
             for (size_t i = 0; i < dump_len; i++) {
-                printf("%02X", (unsigned)coble_rx_buf[i]);
+                printf("%02X", (unsigned)coble_rx_pb->data[i]);
             }
             printf("%s\n", (coble_rx_offset > BLE_DEBUG_DUMP_BYTES) ? "..." : "");
         }
         /* Notify data callback if registered */
         if (data_callback) {
-            data_callback(coble_rx_buf, coble_rx_offset);
+            data_callback(coble_rx_pb->data, coble_rx_offset);
         }
     }
 
@@ -688,10 +721,9 @@ static void packet_handler(uint8_t packet_type, uint16_t channel,
             current_state        = BLE_STATE_ADVERTISING;
             /* Reset COBLe/BTP state for next connection */
             coble_rx_in_progress = false;
-            coble_rx_ready       = false;
-            coble_rx_offset      = 0;
+            coble_rx_discard();
             coble_rx_need_ack    = false;
-            coble_tx_active      = false;
+            coble_tx_finish();
             coble_tx_counter     = 1;   /* peripheral TX seq starts at 1 */
             char_rx_cccd_value   = 0;   /* reset subscription for next session */
             ble_caps_resp_ready   = false;
@@ -795,7 +827,7 @@ static void packet_handler(uint8_t packet_type, uint16_t channel,
             } else {
                 printf("BLE-DBG: Indication complete, TX done (sent=%zu/%zu)\n",
                        coble_tx_msg_sent, coble_tx_msg_len);
-                coble_tx_active = false;
+                coble_tx_finish();
             }
             break;
 
@@ -905,7 +937,7 @@ static void build_scan_response(void) {
  */
 static void coble_tx_send_next(void) {
     if (!coble_tx_active || active_con_handle == HCI_CON_HANDLE_INVALID) {
-        coble_tx_active = false;
+        coble_tx_finish();
         return;
     }
 
@@ -991,14 +1023,14 @@ static void coble_tx_send_next(void) {
         if (err != ERROR_CODE_SUCCESS) {
             printf("BLE: Send failed (err=0x%02X, sent=%zu/%zu)\n",
                    (unsigned)err, coble_tx_msg_sent - chunk, coble_tx_msg_len);
-            coble_tx_active = false;
+            coble_tx_finish();
             return;
         }
         /* Notifications don't wait for confirmation — continue immediately */
         if (coble_tx_msg_sent < coble_tx_msg_len) {
             coble_tx_send_next();
         } else {
-            coble_tx_active = false;
+            coble_tx_finish();
         }
         return;
     }
@@ -1210,20 +1242,24 @@ int ble_adapter_stop_advertising(void) {
  * ble_adapter_send_data – send a raw Matter message over the BLE RX
  * characteristic using COBLe framing (Matter Core Spec §3.6.1).
  *
- * The message is buffered and sent as one or more ATT indications.
+ * The message is sent by reference as one or more ATT indications; the
+ * caller's buffer must remain valid until the last fragment is out.
  * For multi-fragment messages, each subsequent fragment is sent from
  * the ATT_EVENT_HANDLE_VALUE_INDICATION_COMPLETE callback.  If
  * indications are not available (controller subscribed for notifications
  * only), falls back to ATT notifications.
  */
 int ble_adapter_send_data(const uint8_t *data, size_t length) {
+    /* A new message supersedes any transmission still in flight */
+    coble_tx_finish();
+
     if (!ble_initialized || active_con_handle == HCI_CON_HANDLE_INVALID ||
         char_rx_handle == 0 || length == 0 || length > COBLE_MAX_MSG_SIZE) {
         return -1;
     }
 
-    /* Buffer the complete message */
-    memcpy(coble_tx_msg, data, length);
+    /* Reference the complete message (caller keeps it alive) */
+    coble_tx_msg        = data;
     coble_tx_msg_len    = length;
     coble_tx_msg_sent   = 0;
     coble_tx_first_frag = true;
@@ -1234,6 +1270,23 @@ int ble_adapter_send_data(const uint8_t *data, size_t length) {
     return coble_tx_active ? 0 : -1;
 }
 
+/*
+ * ble_adapter_send_buffer – as ble_adapter_send_data(), but takes a
+ * reference on a message pool block so the caller may release its own
+ * reference immediately.  The block is released after the last fragment.
+ */
+int ble_adapter_send_buffer(packet_buffer_t *pb) {
+    if (pb == NULL) {
+        return -1;
+    }
+
+    int ret = ble_adapter_send_data(packet_buffer_data(pb), pb->length);
+    if (coble_tx_active) {
+        coble_tx_pb = msg_pool_retain(pb);
+    }
+    return ret;
+}
+
 /*
  * ble_adapter_receive_message – dequeue the most recently reassembled
  * COBLe message.  Returns 0 and fills *buffer if a complete message is
@@ -1249,13 +1302,29 @@ int ble_adapter_receive_message(uint8_t *buffer, size_t max_len,
     if (copy_len > max_len) {
         copy_len = max_len;
     }
-    memcpy(buffer, coble_rx_buf, copy_len);
+    memcpy(buffer, coble_rx_pb->data, copy_len);
     if (actual_len) {
         *actual_len = copy_len;
     }
 
-    coble_rx_ready  = false;
+    coble_rx_discard();
+    return 0;
+}
+
+/*
+ * ble_adapter_receive_buffer – dequeue the most recently reassembled COBLe
+ * message without copying.  Ownership of the pool block passes to the
+ * caller, which must release it with msg_pool_release().
+ */
+int ble_adapter_receive_buffer(packet_buffer_t **pb) {
+    if (!coble_rx_ready || pb == NULL) {
+        return -1;
+    }
+
+    *pb = coble_rx_pb;
+    coble_rx_pb     = NULL;
     coble_rx_offset = 0;
+    coble_rx_ready  = false;
     return 0;
 }
 
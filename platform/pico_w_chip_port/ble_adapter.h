@@ -10,6 +10,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include "packet_buffer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -52,12 +53,28 @@ int ble_adapter_stop_advertising(void);
 
 /**
  * @brief Send data over BLE connection using COBLe framing
+ *
+ * The message is not copied: fragments are read from data as indications
+ * complete, so the buffer must stay valid until the next call.  Prefer
+ * ble_adapter_send_buffer() for message pool blocks.
+ *
  * @param data Pointer to data buffer
  * @param length Length of data
  * @return 0 on success, -1 on failure
  */
 int ble_adapter_send_data(const uint8_t *data, size_t length);
 
+/**
+ * @brief Send a message pool block over BLE using COBLe framing
+ *
+ * The adapter takes its own reference to the block and releases it after
+ * the last fragment, so the caller may release its reference right away.
+ *
+ * @param pb Message pool block holding the encoded message
+ * @return 0 on success, -1 on failure
+ */
+int ble_adapter_send_buffer(packet_buffer_t *pb);
+
 /**
  * @brief Dequeue the next fully-reassembled COBLe message received from controller.
  * @param buffer  Destination buffer
@@ -67,6 +84,14 @@ int ble_adapter_send_data(const uint8_t *data, size_t length);
  */
 int ble_adapter_receive_message(uint8_t *buffer, size_t max_len, size_t *actual_len);
 
+/**
+ * @brief Dequeue the next fully-reassembled COBLe message without copying.
+ * @param pb Set to the message pool block holding the message; the caller
+ *           owns the reference and must call msg_pool_release()
+ * @return 0 if a complete message was available, -1 otherwise
+ */
+int ble_adapter_receive_buffer(packet_buffer_t **pb);
+
 /**
  * @brief Check if BLE is connected
  * @return true if connected, false otherwise
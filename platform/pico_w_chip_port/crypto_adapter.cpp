@@ -13,6 +13,10 @@
 #include "mbedtls/aes.h"
 // RP2040 hardware RNG
 #include "pico/rand.h"
+// Per-operation crypto timing
+#include "crypto_stats.h"
+// Constant-time AES-128 block cipher (shared with session CCM)
+#include "aes_ccm.h"
 
 static bool crypto_initialized = false;
 
@@ -56,6 +60,7 @@ int crypto_adapter_sha256(const uint8_t *input, size_t input_len, uint8_t *outpu
         return -1;
     }
 
+    uint64_t t0 = crypto_stats_begin();
     mbedtls_sha256_context ctx;
     mbedtls_sha256_init(&ctx);
 
@@ -64,6 +69,7 @@ int crypto_adapter_sha256(const uint8_t *input, size_t input_len, uint8_t *outpu
     mbedtls_sha256_finish(&ctx, output);
 
     mbedtls_sha256_free(&ctx);
+    crypto_stats_end(CRYPTO_OP_SHA256, t0, input_len);
     return 0;  // Success
 }
 
@@ -77,6 +83,48 @@ int crypto_adapter_aes_encrypt(
         return -1;
     }
 
+    uint64_t t0 = crypto_stats_begin();
+
+    // AES-128 goes through the same block cipher backend as session CCM;
+    // the backend only implements AES-128 encryption, so other key sizes
+    // fall through to mbedTLS below.
+    if (key_len == AES_CCM_KEY_LENGTH) {
+        aes_ccm_ctx_t ctx;
+        if (aes_ccm_setkey(&ctx, key, key_len) != 0) {
+            return -1;
+        }
+
+        int ret = 0;
+        if (iv && iv_len >= 16) {
+            // CBC: each block depends on the previous one, so only one
+            // lane of the two-block call carries data
+            if (input_len % AES_CCM_BLOCK_SIZE != 0) {
+                ret = -1;
+            } else {
+                uint8_t chain[AES_CCM_BLOCK_SIZE];
+                uint8_t unused[AES_CCM_BLOCK_SIZE];
+                memcpy(chain, iv, AES_CCM_BLOCK_SIZE);
+                for (size_t off = 0; off < input_len; off += AES_CCM_BLOCK_SIZE) {
+                    for (size_t i = 0; i < AES_CCM_BLOCK_SIZE; i++) {
+                        chain[i] ^= input[off + i];
+                    }
+                    aes_ccm_block_encrypt_x2(&ctx, chain, chain, chain, unused);
+                    memcpy(output + off, chain, AES_CCM_BLOCK_SIZE);
+                }
+            }
+        } else if (input_len == 16) {
+            // ECB mode for single block
+            uint8_t unused[AES_CCM_BLOCK_SIZE];
+            aes_ccm_block_encrypt_x2(&ctx, input, input, output, unused);
+        } else {
+            ret = -1;  // Invalid length for ECB
+        }
+
+        aes_ccm_free(&ctx);
+        crypto_stats_end(CRYPTO_OP_AES, t0, input_len);
+        return ret;
+    }
+
     mbedtls_aes_context aes;
     mbedtls_aes_init(&aes);
 
@@ -101,6 +149,7 @@ int crypto_adapter_aes_encrypt(
     }
 
     mbedtls_aes_free(&aes);
+    crypto_stats_end(CRYPTO_OP_AES, t0, input_len);
     return ret;
 }
 
@@ -114,6 +163,7 @@ int crypto_adapter_aes_decrypt(
         return -1;
     }
 
+    uint64_t t0 = crypto_stats_begin();
     mbedtls_aes_context aes;
     mbedtls_aes_init(&aes);
 
@@ -138,6 +188,7 @@ int crypto_adapter_aes_decrypt(
     }
 
     mbedtls_aes_free(&aes);
+    crypto_stats_end(CRYPTO_OP_AES, t0, input_len);
     return ret;
 }
 
@@ -4,17 +4,55 @@
  */
 
 #include "matter_attributes.h"
+#include "attribute_table.h"
 #include <stdio.h>
 #include <inttypes.h>
 #include <string.h>
 #include "pico/stdlib.h"
 
-// Maximum number of attributes we can track
-#define MAX_ATTRIBUTES 16
+// Flash storage (storage_adapter.cpp)
+extern "C" {
+    int storage_adapter_write(const char *key, const uint8_t *value, size_t value_len);
+    int storage_adapter_read(const char *key, uint8_t *value, size_t max_value_len,
+                             size_t *actual_len);
+}
+
+// Storage key and layout version of the saved thresholds
+#define REPORT_THRESHOLDS_KEY "/report_thresholds"
+#define REPORT_THRESHOLDS_VERSION 2
+
+// One bit per attribute ID in the registered and dirty sets
+typedef uint32_t attr_mask_t;
+static_assert(MATTER_ATTR_ID_COUNT <= 32, "attr_mask_t too small for MATTER_ATTRIBUTE_STORE");
+
+#define ATTR_BIT(id) ((attr_mask_t)1 << (id))
 
-// Attribute storage
-static matter_attribute_t attributes[MAX_ATTRIBUTES];
-static size_t attribute_count = 0;
+// Attribute descriptors, indexed by ID
+static const matter_attribute_t descriptors[MATTER_ATTR_ID_COUNT] = {
+#define DESCRIPTOR(name, endpoint, cluster, attribute, type) \
+    { (cluster), (attribute), (endpoint), (type) },
+    MATTER_ATTRIBUTE_STORE(DESCRIPTOR)
+#undef DESCRIPTOR
+};
+
+// Attribute storage, indexed by ID
+static matter_attr_value_t values[MATTER_ATTR_ID_COUNT];
+static uint32_t changed_ms[MATTER_ATTR_ID_COUNT];      // Time of the latest change
+static attr_mask_t registered_mask = 0;
+static attr_mask_t dirty_mask = 0;      // Changed since last report
+static attr_mask_t held_mask = 0;       // Reportable change waiting out its quiet time
+
+// Reportable-change state, indexed by ID
+static matter_report_threshold_t thresholds[MATTER_ATTR_ID_COUNT];
+static matter_attr_value_t reported[MATTER_ATTR_ID_COUNT];     // Last value reported
+static uint32_t reported_ms[MATTER_ATTR_ID_COUNT];            // Time of the last report
+
+// Saved thresholds: store layout hash, version, then one threshold per ID
+typedef struct {
+    uint32_t layout;
+    uint8_t version;
+    matter_report_threshold_t thresholds[MATTER_ATTR_ID_COUNT];
+} saved_thresholds_t;
 
 // Subscriber storage
 static matter_subscriber_callback_t subscribers[MATTER_MAX_SUBSCRIBERS];
@@ -30,8 +68,11 @@ int matter_attributes_init(void) {
     }
     
     // Clear all attributes
-    memset(attributes, 0, sizeof(attributes));
-    attribute_count = 0;
+    memset(values, 0, sizeof(values));
+    memset(changed_ms, 0, sizeof(changed_ms));
+    registered_mask = 0;
+    dirty_mask = 0;
+    held_mask = 0;
     
     // Clear subscribers
     memset(subscribers, 0, sizeof(subscribers));
@@ -43,6 +84,28 @@ int matter_attributes_init(void) {
     return 0;
 }
 
+// Packed (endpoint, cluster, attribute) key; Matter cluster and attribute
+// IDs used here fit 16 bits
+#define STORE_KEY(endpoint, cluster, attribute) \
+    (((uint64_t)(endpoint) << 32) | ((uint64_t)(cluster) << 16) | (uint64_t)(attribute))
+
+int matter_attributes_lookup(uint8_t endpoint, uint32_t cluster_id, uint32_t attribute_id) {
+    if (cluster_id > 0xFFFF || attribute_id > 0xFFFF) {
+        return -1;
+    }
+    
+    // Generated from MATTER_ATTRIBUTE_STORE; compiles to a compare tree on
+    // constants rather than a scan of the store
+    switch (STORE_KEY(endpoint, cluster_id, attribute_id)) {
+#define LOOKUP_CASE(name, ep, cluster, attribute, type) \
+        case STORE_KEY(ep, cluster, attribute): return MATTER_ATTR_ID_##name;
+        MATTER_ATTRIBUTE_STORE(LOOKUP_CASE)
+#undef LOOKUP_CASE
+        default:
+            return -1;
+    }
+}
+
 int matter_attributes_register(uint8_t endpoint, uint32_t cluster_id, 
                                uint32_t attribute_id, matter_attr_type_t type,
                                const matter_attr_value_t *initial_value) {
@@ -50,37 +113,31 @@ int matter_attributes_register(uint8_t endpoint, uint32_t cluster_id,
         return -1;
     }
     
-    if (attribute_count >= MAX_ATTRIBUTES) {
-        printf("[Matter] ERROR: Maximum attributes reached\n");
+    int id = matter_attributes_lookup(endpoint, cluster_id, attribute_id);
+    if (id < 0 || descriptors[id].type != type) {
+        printf("[Matter] ERROR: Attribute not in store (EP:%u, CL:0x%04" PRIx32 ", AT:0x%04" PRIx32 ")\n",
+               endpoint, cluster_id, attribute_id);
         return -1;
     }
     
     // Check if attribute already exists
-    for (size_t i = 0; i < attribute_count; i++) {
-        if (attributes[i].endpoint == endpoint &&
-            attributes[i].cluster_id == cluster_id &&
-            attributes[i].attribute_id == attribute_id) {
-            printf("Matter: Attribute already registered (EP:%u, CL:0x%04lX, AT:0x%04lX)\n",
-                   endpoint, (unsigned long)cluster_id, (unsigned long)attribute_id);
-            return 0;  // Already registered
-        }
+    if (registered_mask & ATTR_BIT(id)) {
+        printf("Matter: Attribute already registered (EP:%u, CL:0x%04lX, AT:0x%04lX)\n",
+               endpoint, (unsigned long)cluster_id, (unsigned long)attribute_id);
+        return 0;  // Already registered
     }
     
     // Register new attribute
-    matter_attribute_t *attr = &attributes[attribute_count];
-    attr->endpoint = endpoint;
-    attr->cluster_id = cluster_id;
-    attr->attribute_id = attribute_id;
-    attr->type = type;
-    attr->dirty = false;
-    
     if (initial_value) {
-        attr->value = *initial_value;
+        values[id] = *initial_value;
     } else {
-        memset(&attr->value, 0, sizeof(attr->value));
+        memset(&values[id], 0, sizeof(values[id]));
     }
-    
-    attribute_count++;
+    reported[id] = values[id];
+    reported_ms[id] = 0;
+    registered_mask |= ATTR_BIT(id);
+    dirty_mask &= ~ATTR_BIT(id);
+    held_mask &= ~ATTR_BIT(id);
     
     printf("Matter: Registered attribute (EP:%u, CL:0x%04" PRIx32 ", AT:0x%04" PRIx32 ")\n",
            endpoint, cluster_id, attribute_id);
@@ -88,17 +145,6 @@ int matter_attributes_register(uint8_t endpoint, uint32_t cluster_id,
     return 0;
 }
 
-static matter_attribute_t* find_attribute(uint8_t endpoint, uint32_t cluster_id, uint32_t attribute_id) {
-    for (size_t i = 0; i < attribute_count; i++) {
-        if (attributes[i].endpoint == endpoint &&
-            attributes[i].cluster_id == cluster_id &&
-            attributes[i].attribute_id == attribute_id) {
-            return &attributes[i];
-        }
-    }
-    return NULL;
-}
-
 static bool values_equal(const matter_attr_value_t *a, const matter_attr_value_t *b, matter_attr_type_t type) {
     switch (type) {
         case MATTER_TYPE_BOOL:
@@ -114,65 +160,141 @@ static bool values_equal(const matter_attr_value_t *a, const matter_attr_value_t
     }
 }
 
-int matter_attributes_update(uint8_t endpoint, uint32_t cluster_id,
-                            uint32_t attribute_id, const matter_attr_value_t *value) {
-    if (!initialized || !value) {
-        return -1;
+// Numeric value of an attribute, for threshold comparisons
+static int64_t numeric_value(const matter_attr_value_t *value, matter_attr_type_t type) {
+    switch (type) {
+        case MATTER_TYPE_UINT8:
+            return value->uint8_val;
+        case MATTER_TYPE_INT16:
+            return value->int16_val;
+        case MATTER_TYPE_UINT32:
+            return value->uint32_val;
+        default:
+            return value->bool_val ? 1 : 0;
     }
+}
+
+// Whether the current value has moved far enough from the last reported one
+static bool reportable_change(int id) {
+    const matter_report_threshold_t *threshold = &thresholds[id];
+    matter_attr_type_t type = descriptors[id].type;
     
-    matter_attribute_t *attr = find_attribute(endpoint, cluster_id, attribute_id);
-    if (!attr) {
-        printf("Matter: WARNING - Attribute not found (EP:%u, CL:0x%04" PRIx32 ", AT:0x%04" PRIx32 ")\n",
-               endpoint, cluster_id, attribute_id);
+    if (type == MATTER_TYPE_BOOL || (threshold->abs_delta == 0 && threshold->percent == 0)) {
+        return !values_equal(&values[id], &reported[id], type);
+    }
+    
+    int64_t last = numeric_value(&reported[id], type);
+    int64_t delta = numeric_value(&values[id], type) - last;
+    if (delta < 0) {
+        delta = -delta;
+    }
+    if (last < 0) {
+        last = -last;
+    }
+    
+    return (threshold->abs_delta > 0 && delta >= threshold->abs_delta) ||
+           (threshold->percent > 0 && delta > 0 &&
+            delta * 100 >= (int64_t)threshold->percent * last);
+}
+
+// Whether the attribute is still inside its quiet time
+static bool in_quiet_time(int id, uint32_t now) {
+    return thresholds[id].min_quiet_ms > 0 && reported_ms[id] != 0 &&
+           now - reported_ms[id] < thresholds[id].min_quiet_ms;
+}
+
+int matter_attributes_set(matter_attr_id_t id, const matter_attr_value_t *value) {
+    if (!initialized || !value || (unsigned)id >= MATTER_ATTR_ID_COUNT ||
+        !(registered_mask & ATTR_BIT(id))) {
         return -1;
     }
     
+    const matter_attribute_t *attr = &descriptors[id];
+    
     // Check if value actually changed
-    if (!values_equal(&attr->value, value, attr->type)) {
-        attr->value = *value;
-        attr->dirty = true;
+    if (!values_equal(&values[id], value, attr->type)) {
+        uint32_t now = to_ms_since_boot(get_absolute_time());
+        values[id] = *value;
+        changed_ms[id] = now;
+        
+        // Only moves past the reportable-change threshold reach subscribers;
+        // inside the quiet time they wait in held_mask
+        held_mask &= ~ATTR_BIT(id);
+        if (!reportable_change(id)) {
+            dirty_mask &= ~ATTR_BIT(id);
+        } else if (in_quiet_time(id, now)) {
+            dirty_mask &= ~ATTR_BIT(id);
+            held_mask |= ATTR_BIT(id);
+        } else {
+            dirty_mask |= ATTR_BIT(id);
+        }
+        
+        // New DataVersion for the cluster, so filtered reads see the change
+        attribute_table_bump_data_version(attr->endpoint, attr->cluster_id);
         
         // Log the change
         printf("Matter: Attribute changed (EP:%u, CL:0x%04" PRIx32 ", AT:0x%04" PRIx32 ") = ",
-               endpoint, cluster_id, attribute_id);
+               attr->endpoint, attr->cluster_id, attr->attribute_id);
         
         switch (attr->type) {
             case MATTER_TYPE_BOOL:
-                printf("%s\n", attr->value.bool_val ? "true" : "false");
+                printf("%s\n", value->bool_val ? "true" : "false");
                 break;
             case MATTER_TYPE_UINT8:
-                printf("%u\n", attr->value.uint8_val);
+                printf("%u\n", value->uint8_val);
                 break;
             case MATTER_TYPE_INT16:
-                printf("%d\n", attr->value.int16_val);
+                printf("%d\n", value->int16_val);
                 break;
             case MATTER_TYPE_UINT32:
-                printf("%lu\n", (unsigned long)attr->value.uint32_val);
+                printf("%lu\n", (unsigned long)value->uint32_val);
                 break;
         }
         // Subscribers are notified via matter_attributes_process_reports()
-        // which is called from the main loop (platform_manager_task).
+        // which is called from the main loop (platform_manager_task), so a
+        // burst of updates reaches them as one change set.
     }
     
     return 0;
 }
 
-int matter_attributes_get(uint8_t endpoint, uint32_t cluster_id,
-                         uint32_t attribute_id, matter_attr_value_t *value) {
+int matter_attributes_update(uint8_t endpoint, uint32_t cluster_id,
+                            uint32_t attribute_id, const matter_attr_value_t *value) {
     if (!initialized || !value) {
         return -1;
     }
     
-    matter_attribute_t *attr = find_attribute(endpoint, cluster_id, attribute_id);
-    if (!attr) {
+    int id = matter_attributes_lookup(endpoint, cluster_id, attribute_id);
+    if (id < 0 || !(registered_mask & ATTR_BIT(id))) {
+        printf("Matter: WARNING - Attribute not found (EP:%u, CL:0x%04" PRIx32 ", AT:0x%04" PRIx32 ")\n",
+               endpoint, cluster_id, attribute_id);
+        return -1;
+    }
+    
+    return matter_attributes_set((matter_attr_id_t)id, value);
+}
+
+int matter_attributes_read(matter_attr_id_t id, matter_attr_value_t *value) {
+    if (!initialized || !value || (unsigned)id >= MATTER_ATTR_ID_COUNT ||
+        !(registered_mask & ATTR_BIT(id))) {
         return -1;
     }
     
-    *value = attr->value;
+    *value = values[id];
     
     return 0;
 }
 
+int matter_attributes_get(uint8_t endpoint, uint32_t cluster_id,
+                         uint32_t attribute_id, matter_attr_value_t *value) {
+    int id = matter_attributes_lookup(endpoint, cluster_id, attribute_id);
+    if (id < 0) {
+        return -1;
+    }
+    
+    return matter_attributes_read((matter_attr_id_t)id, value);
+}
+
 int matter_attributes_subscribe(matter_subscriber_callback_t callback) {
     if (!initialized || !callback) {
         return -1;
@@ -202,24 +324,131 @@ void matter_attributes_unsubscribe(int subscriber_id) {
     printf("Matter: Subscriber %d unregistered\n", subscriber_id);
 }
 
+int matter_attributes_set_report_threshold(matter_attr_id_t id,
+                                           const matter_report_threshold_t *threshold) {
+    if ((unsigned)id >= MATTER_ATTR_ID_COUNT) {
+        return -1;
+    }
+    
+    if (threshold) {
+        thresholds[id] = *threshold;
+    } else {
+        memset(&thresholds[id], 0, sizeof(thresholds[id]));
+    }
+    return 0;
+}
+
+int matter_attributes_get_report_threshold(matter_attr_id_t id,
+                                           matter_report_threshold_t *threshold) {
+    if ((unsigned)id >= MATTER_ATTR_ID_COUNT || !threshold) {
+        return -1;
+    }
+    
+    *threshold = thresholds[id];
+    return 0;
+}
+
+// FNV-1a hash of the store list (endpoint, cluster, attribute and type of
+// each ID): any change to MATTER_ATTRIBUTE_STORE changes it, even one that
+// keeps the number of attributes
+static uint32_t store_layout_hash(void) {
+    uint32_t hash = 2166136261u;
+    
+    for (int id = 0; id < MATTER_ATTR_ID_COUNT; id++) {
+        const uint32_t fields[4] = {
+            descriptors[id].endpoint, descriptors[id].cluster_id,
+            descriptors[id].attribute_id, (uint32_t)descriptors[id].type
+        };
+        for (int f = 0; f < 4; f++) {
+            for (int shift = 0; shift < 32; shift += 8) {
+                hash ^= (fields[f] >> shift) & 0xFF;
+                hash *= 16777619u;
+            }
+        }
+    }
+    return hash;
+}
+
+int matter_attributes_save_report_thresholds(void) {
+    saved_thresholds_t saved;
+    
+    memset(&saved, 0, sizeof(saved));
+    saved.layout = store_layout_hash();
+    saved.version = REPORT_THRESHOLDS_VERSION;
+    memcpy(saved.thresholds, thresholds, sizeof(thresholds));
+    
+    if (storage_adapter_write(REPORT_THRESHOLDS_KEY, (const uint8_t *)&saved,
+                              sizeof(saved)) != 0) {
+        printf("[Matter] ERROR: Failed to save report thresholds\n");
+        return -1;
+    }
+    return 0;
+}
+
+int matter_attributes_load_report_thresholds(void) {
+    saved_thresholds_t saved;
+    size_t actual_len = 0;
+    
+    // A store list that has changed since saving invalidates the saved
+    // IDs, so only an exact layout match is applied
+    if (storage_adapter_read(REPORT_THRESHOLDS_KEY, (uint8_t *)&saved, sizeof(saved),
+                             &actual_len) != 0 ||
+        actual_len != sizeof(saved) ||
+        saved.version != REPORT_THRESHOLDS_VERSION ||
+        saved.layout != store_layout_hash()) {
+        return -1;
+    }
+    
+    memcpy(thresholds, saved.thresholds, sizeof(thresholds));
+    printf("Matter: Report thresholds loaded from flash\n");
+    return 0;
+}
+
 void matter_attributes_process_reports(void) {
-    if (!initialized) {
+    if (!initialized || (dirty_mask == 0 && held_mask == 0)) {
+        return;
+    }
+    
+    uint32_t now = to_ms_since_boot(get_absolute_time());
+    
+    // Held changes whose quiet time has ended are due now
+    for (attr_mask_t held = held_mask; held; held &= held - 1) {
+        int id = __builtin_ctz(held);
+        if (!in_quiet_time(id, now)) {
+            held_mask &= ~ATTR_BIT(id);
+            dirty_mask |= ATTR_BIT(id);
+        }
+    }
+    if (dirty_mask == 0) {
         return;
     }
     
-    matter_attribute_t dirty_attrs[MAX_ATTRIBUTES];
-    size_t dirty_count = 0;
+    matter_attr_change_t changes[MATTER_ATTR_ID_COUNT];
+    size_t change_count = 0;
     
     matter_subscriber_callback_t active_subscribers[MATTER_MAX_SUBSCRIBERS];
     int active_count = 0;
 
-    // Collect dirty attributes
-    for (size_t i = 0; i < attribute_count; i++) {
-        if (attributes[i].dirty) {
-            dirty_attrs[dirty_count++] = attributes[i];
-            // Clear dirty flag now
-            attributes[i].dirty = false;
-        }
+    // Take the dirty set now; callbacks may mark attributes dirty again
+    attr_mask_t dirty = dirty_mask;
+    dirty_mask = 0;
+    
+    // Build the change set from the set bits, lowest ID first
+    while (dirty) {
+        int id = __builtin_ctz(dirty);
+        dirty &= dirty - 1;
+        
+        matter_attr_change_t *change = &changes[change_count++];
+        change->cluster_id = descriptors[id].cluster_id;
+        change->attribute_id = descriptors[id].attribute_id;
+        change->endpoint = descriptors[id].endpoint;
+        change->type = descriptors[id].type;
+        change->value = values[id];
+        change->changed_ms = changed_ms[id];
+        
+        // New reference for the thresholds
+        reported[id] = values[id];
+        reported_ms[id] = now;
     }
     
     // Collect active subscribers
@@ -229,18 +458,13 @@ void matter_attributes_process_reports(void) {
         }
     }
 
-    for (size_t i = 0; i < dirty_count; i++) {
-        matter_attribute_t *attr = &dirty_attrs[i];
-        
-        for (int s = 0; s < active_count; s++) {
-            active_subscribers[s](attr->endpoint, attr->cluster_id, 
-                                 attr->attribute_id, &attr->value);
-        }
+    for (int s = 0; s < active_count; s++) {
+        active_subscribers[s](changes, change_count);
     }
 }
 
 size_t matter_attributes_count(void) {
-    return attribute_count;
+    return (size_t)__builtin_popcount(registered_mask);
 }
 
 void matter_attributes_clear(void) {
@@ -248,8 +472,11 @@ void matter_attributes_clear(void) {
         return;
     }
     
-    memset(attributes, 0, sizeof(attributes));
-    attribute_count = 0;
+    memset(values, 0, sizeof(values));
+    memset(changed_ms, 0, sizeof(changed_ms));
+    registered_mask = 0;
+    dirty_mask = 0;
+    held_mask = 0;
     
     memset(subscribers, 0, sizeof(subscribers));
     memset(subscriber_active, 0, sizeof(subscriber_active));
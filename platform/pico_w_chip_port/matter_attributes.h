@@ -47,19 +47,65 @@ typedef union {
     uint32_t uint32_val;
 } matter_attr_value_t;
 
+/*
+ * Attributes held in the store, in ID order
+ * X(name, endpoint, cluster_id, attribute_id, type)
+ *
+ * Each entry gets a dense ID (MATTER_ATTR_ID_<name>) that indexes the value
+ * array directly.  Add new attributes here; they cost nothing per access.
+ */
+#define MATTER_ATTRIBUTE_STORE(X) \
+    X(ON_OFF, 1, MATTER_CLUSTER_ON_OFF, MATTER_ATTR_ON_OFF, MATTER_TYPE_BOOL) \
+    X(CURRENT_LEVEL, 1, MATTER_CLUSTER_LEVEL_CONTROL, MATTER_ATTR_CURRENT_LEVEL, MATTER_TYPE_UINT8) \
+    X(MEASURED_VALUE, 1, MATTER_CLUSTER_TEMPERATURE_MEASUREMENT, MATTER_ATTR_MEASURED_VALUE, MATTER_TYPE_INT16) \
+    X(NUMBER_OF_ACTIVE_FAULTS, 1, MATTER_CLUSTER_DIAGNOSTICS, MATTER_ATTR_NUMBER_OF_ACTIVE_FAULTS, MATTER_TYPE_UINT8) \
+    X(TOTAL_OPERATIONAL_HOURS, 1, MATTER_CLUSTER_DIAGNOSTICS, MATTER_ATTR_TOTAL_OPERATIONAL_HOURS, MATTER_TYPE_UINT32) \
+    X(DEVICE_ENABLED_STATE, 1, MATTER_CLUSTER_DIAGNOSTICS, MATTER_ATTR_DEVICE_ENABLED_STATE, MATTER_TYPE_UINT8)
+
+// Dense attribute IDs
+typedef enum {
+#define MATTER_ATTR_ID_ENUM(name, endpoint, cluster, attribute, type) MATTER_ATTR_ID_##name,
+    MATTER_ATTRIBUTE_STORE(MATTER_ATTR_ID_ENUM)
+#undef MATTER_ATTR_ID_ENUM
+    MATTER_ATTR_ID_COUNT
+} matter_attr_id_t;
+
 // Attribute descriptor
 typedef struct {
     uint32_t cluster_id;
     uint32_t attribute_id;
     uint8_t endpoint;
     matter_attr_type_t type;
-    matter_attr_value_t value;
-    bool dirty;  // Attribute has changed since last report
 } matter_attribute_t;
 
+// One changed attribute in a change set
+typedef struct {
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    uint8_t endpoint;
+    matter_attr_type_t type;
+    matter_attr_value_t value;  // Value when the change set was taken
+    uint32_t changed_ms;        // Time of the latest change (ms since boot)
+} matter_attr_change_t;
+
+// Reportable-change threshold of an attribute
+// A change reaches subscribers once it moves the value away from the last
+// reported value by at least abs_delta or by percent of it (both 0 = any
+// change), and at least min_quiet_ms after the attribute's last report.
+// Smaller moves and quiet-time changes are still stored (reads and
+// DataVersion see them); a held change goes out when the quiet time ends.
+// Thresholds apply to numeric attributes; booleans report every change.
+typedef struct {
+    uint32_t abs_delta;         // Absolute change, in attribute units
+    uint32_t min_quiet_ms;      // Minimum time between reports
+    uint8_t percent;            // Relative change, percent of last reported value
+} matter_report_threshold_t;
+
 // Subscriber callback for attribute changes
-typedef void (*matter_subscriber_callback_t)(uint8_t endpoint, uint32_t cluster_id, 
-                                             uint32_t attribute_id, const matter_attr_value_t *value);
+// Receives every attribute that changed since the last report pass, once
+// each and in ID order, however many updates it saw in between.
+typedef void (*matter_subscriber_callback_t)(const matter_attr_change_t *changes,
+                                             size_t count);
 
 /**
  * Initialize the Matter attribute system
@@ -67,8 +113,19 @@ typedef void (*matter_subscriber_callback_t)(uint8_t endpoint, uint32_t cluster_
  */
 int matter_attributes_init(void);
 
+/**
+ * Find the dense ID of an attribute
+ * @param endpoint Endpoint number
+ * @param cluster_id Cluster ID
+ * @param attribute_id Attribute ID
+ * @return Attribute ID, or -1 if the store does not hold the attribute
+ */
+int matter_attributes_lookup(uint8_t endpoint, uint32_t cluster_id, uint32_t attribute_id);
+
 /**
  * Register an attribute with the system
+ * Sets the initial value of an attribute listed in MATTER_ATTRIBUTE_STORE;
+ * updates and reads of unregistered attributes fail.
  * @param endpoint Endpoint number
  * @param cluster_id Cluster ID
  * @param attribute_id Attribute ID
@@ -82,7 +139,8 @@ int matter_attributes_register(uint8_t endpoint, uint32_t cluster_id,
 
 /**
  * Update an attribute value
- * Marks the attribute as dirty if value changed
+ * Marks the attribute as dirty and records the time if value changed;
+ * subscribers hear about it from the next matter_attributes_process_reports()
  * @param endpoint Endpoint number
  * @param cluster_id Cluster ID
  * @param attribute_id Attribute ID
@@ -92,6 +150,23 @@ int matter_attributes_register(uint8_t endpoint, uint32_t cluster_id,
 int matter_attributes_update(uint8_t endpoint, uint32_t cluster_id,
                             uint32_t attribute_id, const matter_attr_value_t *value);
 
+/**
+ * Update an attribute value by dense ID
+ * Same as matter_attributes_update() without the lookup
+ * @param id Attribute ID
+ * @param value New value
+ * @return 0 on success, -1 if attribute not registered
+ */
+int matter_attributes_set(matter_attr_id_t id, const matter_attr_value_t *value);
+
+/**
+ * Get an attribute value by dense ID
+ * @param id Attribute ID
+ * @param value Output value
+ * @return 0 on success, -1 if attribute not registered
+ */
+int matter_attributes_read(matter_attr_id_t id, matter_attr_value_t *value);
+
 /**
  * Get an attribute value
  * @param endpoint Endpoint number
@@ -116,9 +191,42 @@ int matter_attributes_subscribe(matter_subscriber_callback_t callback);
  */
 void matter_attributes_unsubscribe(int subscriber_id);
 
+/**
+ * Set the reportable-change threshold of an attribute
+ * Takes effect from the next update; use
+ * matter_attributes_save_report_thresholds() to keep it across reboots.
+ * @param id Attribute ID
+ * @param threshold Threshold (NULL = report every change)
+ * @return 0 on success, -1 on invalid ID
+ */
+int matter_attributes_set_report_threshold(matter_attr_id_t id,
+                                           const matter_report_threshold_t *threshold);
+
+/**
+ * Get the reportable-change threshold of an attribute
+ * @param id Attribute ID
+ * @param threshold Output threshold
+ * @return 0 on success, -1 on invalid ID
+ */
+int matter_attributes_get_report_threshold(matter_attr_id_t id,
+                                           matter_report_threshold_t *threshold);
+
+/**
+ * Save all reportable-change thresholds to flash
+ * @return 0 on success, -1 on failure
+ */
+int matter_attributes_save_report_thresholds(void);
+
+/**
+ * Load reportable-change thresholds saved in flash
+ * @return 0 on success, -1 if none are stored (thresholds unchanged)
+ */
+int matter_attributes_load_report_thresholds(void);
+
 /**
  * Process dirty attributes and notify subscribers
- * Call this periodically to send attribute reports
+ * Call once per main loop iteration: each subscriber gets one call with
+ * the set of attributes changed since the last pass.
  */
 void matter_attributes_process_reports(void);
 
@@ -8,10 +8,9 @@
 #include "matter_network_transport.h"
 
 // Callback function for attribute changes (sends to network)
-static void network_subscriber_callback(uint8_t endpoint, uint32_t cluster_id, 
-                                       uint32_t attribute_id, const matter_attr_value_t *value) {
-    // Send attribute report to all Matter controllers over WiFi
-    int sent = matter_network_transport_send_report(endpoint, cluster_id, attribute_id, value);
+static void network_subscriber_callback(const matter_attr_change_t *changes, size_t count) {
+    // Send the whole change set to all Matter controllers over WiFi
+    int sent = matter_network_transport_send_reports(changes, count);
     
     if (sent > 0) {
         // Success - report already logged by transport layer
@@ -126,56 +126,48 @@ static matter_attr_type_t get_attribute_type(uint32_t cluster_id, uint32_t attri
     return MATTER_TYPE_UINT32;
 }
 
-int matter_network_transport_send_report(uint8_t endpoint, uint32_t cluster_id,
-                                         uint32_t attribute_id, const matter_attr_value_t *value) {
-    if (!transport_initialized || !udp_pcb || !value) {
-        return -1;
-    }
-    
-    uint32_t now = to_ms_since_boot(get_absolute_time());
-    int sent_count = 0;
-    
-    // Build Matter attribute report message (simplified JSON format)
-    // Buffer size calculated to handle maximum possible message:
-    // - Fixed text: ~100 bytes
-    // - Cluster ID (4 hex digits with 0x prefix): 6 bytes
-    // - Attribute ID (4 hex digits with 0x prefix): 6 bytes
-    // - Value string (max): 64 bytes (generous for numeric values)
-    // - Timestamp (10 digits): 10 bytes
-    // - Overhead/formatting: 20 bytes
-    // Total: ~206 bytes, use 512 for safety margin
-    char message[512];
+// Format one attribute report as a JSON line
+// Returns the line length, or -1 if it does not fit
+static int format_report_line(char *buffer, size_t buffer_len,
+                              uint8_t endpoint, uint32_t cluster_id, uint32_t attribute_id,
+                              const matter_attr_value_t *value, matter_attr_type_t type,
+                              uint32_t timestamp) {
     char value_str[64];  // Generous size for any numeric value
-    matter_attr_type_t type = get_attribute_type(cluster_id, attribute_id);
     format_attribute_value(value, type, value_str, sizeof(value_str));
     
     // Construct JSON message with proper formatting
     // Note: All values are either JSON keywords (true/false/null) or numeric,
     // so no string escaping is needed. Using %04 for 4-digit hex formatting
     // (sufficient for current cluster/attribute IDs, which are 16-bit values)
-    int msg_len = snprintf(message, sizeof(message),
-                          "{\"type\":\"attribute-report\",\"endpoint\":%u,\"cluster\":\"0x%04" PRIx32 "\","
-                          "\"attribute\":\"0x%04" PRIx32 "\",\"value\":%s,\"timestamp\":%" PRIu32 "}\n",
-                          endpoint, cluster_id, attribute_id, value_str, now);
+    int len = snprintf(buffer, buffer_len,
+                       "{\"type\":\"attribute-report\",\"endpoint\":%u,\"cluster\":\"0x%04" PRIx32 "\","
+                       "\"attribute\":\"0x%04" PRIx32 "\",\"value\":%s,\"timestamp\":%" PRIu32 "}\n",
+                       endpoint, cluster_id, attribute_id, value_str, timestamp);
     
-    // Check for truncation
-    if (msg_len >= (int)sizeof(message)) {
-        printf("[Matter Transport] ERROR: Message truncated\n");
-        return -1;
-    }
+    return (len < 0 || len >= (int)buffer_len) ? -1 : len;
+}
+
+// Controllers due a report now (active and past the report interval)
+static int select_controllers(uint32_t now, bool *targets) {
+    int count = 0;
     
-    // Send to all active controllers
     for (int i = 0; i < MAX_MATTER_CONTROLLERS; i++) {
-        if (!controllers[i].active) {
-            continue;
+        targets[i] = controllers[i].active &&
+                     (report_interval_ms == 0 ||
+                      now - controllers[i].last_report_time >= report_interval_ms);
+        if (targets[i]) {
+            count++;
         }
-        
-        // Check throttling
-        if (report_interval_ms > 0) {
-            uint32_t elapsed = now - controllers[i].last_report_time;
-            if (elapsed < report_interval_ms) {
-                continue;  // Skip this controller, too soon
-            }
+    }
+    return count;
+}
+
+// Send one message to the selected controllers
+// Controllers the send fails for are dropped from targets
+static void send_message(const char *message, int msg_len, bool *targets) {
+    for (int i = 0; i < MAX_MATTER_CONTROLLERS; i++) {
+        if (!targets[i]) {
+            continue;
         }
         
         ip6_addr_t dest_addr;
@@ -185,6 +177,7 @@ int matter_network_transport_send_report(uint8_t endpoint, uint32_t cluster_id,
         struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, msg_len, PBUF_RAM);
         if (!p) {
             printf("[Matter Transport] ERROR: Failed to allocate pbuf\n");
+            targets[i] = false;
             continue;
         }
 
@@ -197,11 +190,21 @@ int matter_network_transport_send_report(uint8_t endpoint, uint32_t cluster_id,
         // Free buffer
         pbuf_free(p);
         
-        if (err == ERR_OK) {
+        if (err != ERR_OK) {
+            printf("[Matter Transport] ERROR: Failed to send to controller [%d], error %d\n", i, err);
+            targets[i] = false;
+        }
+    }
+}
+
+// Record a completed report for the controllers that received it
+static int finish_report(uint32_t now, const bool *targets) {
+    int sent_count = 0;
+    
+    for (int i = 0; i < MAX_MATTER_CONTROLLERS; i++) {
+        if (targets[i]) {
             controllers[i].last_report_time = now;
             sent_count++;
-        } else {
-            printf("[Matter Transport] ERROR: Failed to send to controller [%d], error %d\n", i, err);
         }
     }
     
@@ -212,6 +215,78 @@ int matter_network_transport_send_report(uint8_t endpoint, uint32_t cluster_id,
     return sent_count;
 }
 
+int matter_network_transport_send_report(uint8_t endpoint, uint32_t cluster_id,
+                                         uint32_t attribute_id, const matter_attr_value_t *value) {
+    if (!transport_initialized || !udp_pcb || !value) {
+        return -1;
+    }
+    
+    uint32_t now = to_ms_since_boot(get_absolute_time());
+    bool targets[MAX_MATTER_CONTROLLERS];
+    if (select_controllers(now, targets) == 0) {
+        return 0;
+    }
+    
+    // Build Matter attribute report message (simplified JSON format)
+    // ~150 bytes for the largest value; 512 leaves a safety margin
+    char message[512];
+    int msg_len = format_report_line(message, sizeof(message), endpoint, cluster_id,
+                                     attribute_id, value,
+                                     get_attribute_type(cluster_id, attribute_id), now);
+    if (msg_len < 0) {
+        printf("[Matter Transport] ERROR: Message truncated\n");
+        return -1;
+    }
+    
+    send_message(message, msg_len, targets);
+    return finish_report(now, targets);
+}
+
+int matter_network_transport_send_reports(const matter_attr_change_t *changes, size_t count) {
+    // One datagram holds as many report lines as fit; kept static to stay
+    // off the main loop stack
+    static char batch[MATTER_REPORT_BATCH_LEN];
+    
+    if (!transport_initialized || !udp_pcb || (!changes && count > 0)) {
+        return -1;
+    }
+    
+    uint32_t now = to_ms_since_boot(get_absolute_time());
+    bool targets[MAX_MATTER_CONTROLLERS];
+    if (count == 0 || select_controllers(now, targets) == 0) {
+        return 0;
+    }
+    
+    int batch_len = 0;
+    for (size_t i = 0; i < count; i++) {
+        const matter_attr_change_t *change = &changes[i];
+        int line_len;
+        
+        for (;;) {
+            line_len = format_report_line(batch + batch_len, sizeof(batch) - batch_len,
+                                          change->endpoint, change->cluster_id,
+                                          change->attribute_id, &change->value,
+                                          change->type, change->changed_ms);
+            if (line_len >= 0 || batch_len == 0) {
+                break;
+            }
+            
+            // Full: send what we have and start the next datagram
+            send_message(batch, batch_len, targets);
+            batch_len = 0;
+        }
+        
+        if (line_len < 0) {
+            printf("[Matter Transport] ERROR: Message truncated\n");
+            return -1;
+        }
+        batch_len += line_len;
+    }
+    
+    send_message(batch, batch_len, targets);
+    return finish_report(now, targets);
+}
+
 int matter_network_transport_get_controller_count(void) {
     if (!transport_initialized) {
         return 0;
@@ -18,6 +18,11 @@ extern "C" {
 // Maximum number of Matter controllers that can subscribe
 #define MAX_MATTER_CONTROLLERS 4
 
+// Largest datagram of batched attribute reports
+#ifndef MATTER_REPORT_BATCH_LEN
+#define MATTER_REPORT_BATCH_LEN 1024
+#endif
+
 // Matter controller information
 typedef struct {
     uint8_t ip_address[16];     // IPv6 address (16 bytes)
@@ -57,6 +62,16 @@ void matter_network_transport_remove_controller(int controller_id);
 int matter_network_transport_send_report(uint8_t endpoint, uint32_t cluster_id,
                                          uint32_t attribute_id, const matter_attr_value_t *value);
 
+/**
+ * Send a change set to all subscribed controllers
+ * One JSON line per change, packed into as few datagrams as fit
+ * MATTER_REPORT_BATCH_LEN; the report interval applies to the set as a whole.
+ * @param changes Changed attributes
+ * @param count Number of changes
+ * @return Number of controllers notified, or -1 on error
+ */
+int matter_network_transport_send_reports(const matter_attr_change_t *changes, size_t count);
+
 /**
  * Get count of active Matter controllers
  * @return Number of active controllers
@@ -9,20 +9,25 @@
 #include "matter_attributes.h"
 
 // Callback function for attribute changes
-static void attribute_report_callback(uint8_t endpoint, uint32_t cluster_id, 
-                                     uint32_t attribute_id, const matter_attr_value_t *value) {
-    printf("Matter Report Sent:\n");
-    printf("  Endpoint: %u\n", endpoint);
-    printf("  Cluster:  0x%04" PRIx32 "\n", cluster_id);
-    printf("  Attribute: 0x%04" PRIx32 "\n", attribute_id);
+static void attribute_report_callback(const matter_attr_change_t *changes, size_t count) {
+    printf("Matter Report Sent (%u attribute%s):\n", (unsigned)count, count == 1 ? "" : "s");
     
-    // Decode based on known cluster types
-    if (cluster_id == MATTER_CLUSTER_ON_OFF) {
-        printf("  Value: %s (OnOff)\n", value->bool_val ? "ON" : "OFF");
-    } else if (cluster_id == MATTER_CLUSTER_LEVEL_CONTROL) {
-        printf("  Value: %u%% (Level)\n", value->uint8_val);
-    } else if (cluster_id == MATTER_CLUSTER_TEMPERATURE_MEASUREMENT) {
-        printf("  Value: %.2f°C (Temperature)\n", value->int16_val / 100.0);
+    for (size_t i = 0; i < count; i++) {
+        const matter_attr_change_t *change = &changes[i];
+        
+        printf("  Endpoint: %u\n", change->endpoint);
+        printf("  Cluster:  0x%04" PRIx32 "\n", change->cluster_id);
+        printf("  Attribute: 0x%04" PRIx32 "\n", change->attribute_id);
+        
+        // Decode based on known cluster types
+        if (change->cluster_id == MATTER_CLUSTER_ON_OFF) {
+            printf("  Value: %s (OnOff)\n", change->value.bool_val ? "ON" : "OFF");
+        } else if (change->cluster_id == MATTER_CLUSTER_LEVEL_CONTROL) {
+            printf("  Value: %u%% (Level)\n", change->value.uint8_val);
+        } else if (change->cluster_id == MATTER_CLUSTER_TEMPERATURE_MEASUREMENT) {
+            printf("  Value: %.2f°C (Temperature)\n", change->value.int16_val / 100.0);
+        }
+        printf("  Changed: %" PRIu32 " ms\n", change->changed_ms);
     }
     
     printf("\n");
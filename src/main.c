@@ -147,6 +147,7 @@ int main() {
                     if (timeout_triggered) {
                         printf("Viking Bio: Data resumed after timeout\n");
                         timeout_triggered = false;
+                        matter_bridge_update_serial_link(true);
                     }
                     
                     // Update attributes directly on core 0
@@ -186,6 +187,7 @@ int main() {
                 };
                 
                 // Update Matter attributes with cleared state
+                matter_bridge_update_serial_link(false);
                 matter_bridge_update_attributes(&cleared_data);
             }
             
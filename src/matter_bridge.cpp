@@ -11,15 +11,50 @@
 #include "../platform/pico_w_chip_port/ble_adapter.h"
 #include "matter_minimal/interaction/subscription_bridge.h"
 #include "matter_minimal/matter_protocol.h"
+#include "matter_minimal/codec/msg_pool.h"
 #include "matter_minimal/codec/message_codec.h"
+#include "matter_minimal/clusters/diagnostics.h"
 
 // Forward declare storage functions
 extern "C" {
     int storage_adapter_has_wifi_credentials(void);
     int storage_adapter_load_operational_hours(uint32_t *hours);
     int storage_adapter_save_operational_hours(uint32_t hours);
+    int storage_adapter_write(const char *key, const uint8_t *value, size_t value_len);
+    int storage_adapter_read(const char *key, uint8_t *value, size_t max_value_len,
+                             size_t *actual_len);
 }
 
+// Default reporting for a modulating burner, used until thresholds are
+// saved: temperature and fan speed wander by a unit or two between frames
+#ifndef MATTER_BRIDGE_TEMP_REPORT_DELTA
+#define MATTER_BRIDGE_TEMP_REPORT_DELTA 200         // Centidegrees (2 °C)
+#endif
+#ifndef MATTER_BRIDGE_TEMP_REPORT_QUIET_MS
+#define MATTER_BRIDGE_TEMP_REPORT_QUIET_MS 10000
+#endif
+#ifndef MATTER_BRIDGE_FAN_REPORT_DELTA
+#define MATTER_BRIDGE_FAN_REPORT_DELTA 5            // Percent points
+#endif
+#ifndef MATTER_BRIDGE_FAN_REPORT_QUIET_MS
+#define MATTER_BRIDGE_FAN_REPORT_QUIET_MS 5000
+#endif
+#ifndef MATTER_BRIDGE_TEMP_EWMA_SHIFT
+#define MATTER_BRIDGE_TEMP_EWMA_SHIFT 0             // Off
+#endif
+#ifndef MATTER_BRIDGE_FAN_EWMA_SHIFT
+#define MATTER_BRIDGE_FAN_EWMA_SHIFT 0              // Off
+#endif
+
+#define SMOOTHING_KEY "/bridge_smoothing"
+#define SMOOTHING_MAX_SHIFT 8
+
+// Exponentially weighted moving average, state in 1/256 units
+typedef struct {
+    int32_t state;
+    bool seeded;
+} ewma_t;
+
 // Matter attributes storage
 static matter_attributes_t attributes = {
     .flame_state = false,
@@ -36,10 +71,66 @@ static matter_attributes_t attributes = {
 static bool last_flame_state = false;
 static uint32_t flame_on_timestamp = 0;  // Timestamp when flame turned on (milliseconds)
 
+// Burner events: only logged from live serial data
+static bool serial_link_active = true;
+static uint8_t event_error_code = 0;     // Error code of the last FaultChange event
+
+// Reading smoothing
+static matter_bridge_smoothing_t smoothing = {
+    .temperature_shift = MATTER_BRIDGE_TEMP_EWMA_SHIFT,
+    .fan_speed_shift = MATTER_BRIDGE_FAN_EWMA_SHIFT
+};
+static ewma_t temperature_filter;
+static ewma_t fan_speed_filter;
+
+// Burner control requested over Matter (OnOff / LevelControl commands)
+static matter_bridge_burner_request_t burner_request = {
+    .enable = true,
+    .power = 100,
+    .requested_ms = 0
+};
+
 // Matter bridge state
 static bool initialized = false;
 // Bridge attribute state is updated/read from the single-threaded main loop.
 
+// Feed a reading through a filter and return the smoothed value
+static int32_t ewma_update(ewma_t *filter, int32_t sample, uint8_t shift) {
+    if (shift == 0 || !filter->seeded) {
+        filter->state = sample * 256;
+        filter->seeded = true;
+    } else {
+        filter->state += (sample * 256 - filter->state) >> shift;
+    }
+    return (filter->state + 128) >> 8;
+}
+
+// Load saved thresholds and smoothing, or fall back to the defaults
+static void load_report_config(void) {
+    if (matter_attributes_load_report_thresholds() != 0) {
+        matter_report_threshold_t threshold;
+        
+        threshold.abs_delta = MATTER_BRIDGE_TEMP_REPORT_DELTA;
+        threshold.min_quiet_ms = MATTER_BRIDGE_TEMP_REPORT_QUIET_MS;
+        threshold.percent = 0;
+        matter_attributes_set_report_threshold(MATTER_ATTR_ID_MEASURED_VALUE, &threshold);
+        
+        threshold.abs_delta = MATTER_BRIDGE_FAN_REPORT_DELTA;
+        threshold.min_quiet_ms = MATTER_BRIDGE_FAN_REPORT_QUIET_MS;
+        matter_attributes_set_report_threshold(MATTER_ATTR_ID_CURRENT_LEVEL, &threshold);
+    }
+    
+    matter_bridge_smoothing_t stored;
+    size_t actual_len = 0;
+    if (storage_adapter_read(SMOOTHING_KEY, (uint8_t *)&stored, sizeof(stored),
+                             &actual_len) == 0 &&
+        actual_len == sizeof(stored) &&
+        matter_bridge_set_smoothing(&stored) == 0) {
+        printf("Loaded reading smoothing from flash (temperature %u, fan %u)\n",
+               stored.temperature_shift, stored.fan_speed_shift);
+    }
+}
+
 extern "C" {
 
 void matter_bridge_init(void) {
@@ -69,6 +160,9 @@ void matter_bridge_init(void) {
         attributes.total_operational_hours = 0;
     }
     
+    // Reportable-change thresholds and smoothing (storage is mounted now)
+    load_report_config();
+    
     // Check for WiFi credentials in storage
     bool has_credentials = storage_adapter_has_wifi_credentials();
     
@@ -195,6 +289,11 @@ void matter_bridge_update_flame(bool flame_on) {
             // Flame turned OFF - accumulate hours
             if (flame_on_timestamp > 0) {
                 uint32_t elapsed_ms = current_time - flame_on_timestamp;
+                
+                if (serial_link_active) {
+                    cluster_diagnostics_log_flame_out(elapsed_ms / 1000, attributes.error_code,
+                                                      current_time);
+                }
                 uint32_t elapsed_hours = elapsed_ms / (1000 * 60 * 60);  // Convert ms to hours
                 attributes.total_operational_hours += elapsed_hours;
                 
@@ -223,7 +322,7 @@ void matter_bridge_update_flame(bool flame_on) {
         // Update Matter attribute
         matter_attr_value_t value;
         value.bool_val = flame_on;
-        int ret = matter_attributes_update(1, MATTER_CLUSTER_ON_OFF, MATTER_ATTR_ON_OFF, &value);
+        int ret = matter_attributes_set(MATTER_ATTR_ID_ON_OFF, &value);
         if (ret != 0) {
             printf("[Matter] ERROR: Failed to update OnOff attribute (ret=%d)\n", ret);
         } else {
@@ -234,8 +333,7 @@ void matter_bridge_update_flame(bool flame_on) {
         // Update operational hours attribute in Matter system
         matter_attr_value_t hours_value;
         hours_value.uint32_val = attributes.total_operational_hours;
-        matter_attributes_update(1, MATTER_CLUSTER_DIAGNOSTICS, 
-                               MATTER_ATTR_TOTAL_OPERATIONAL_HOURS, &hours_value);
+        matter_attributes_set(MATTER_ATTR_ID_TOTAL_OPERATIONAL_HOURS, &hours_value);
     }
 }
 
@@ -248,21 +346,21 @@ void matter_bridge_update_fan_speed(uint8_t speed) {
     if (changed) {
         attributes.fan_speed = speed;
         attributes.last_update_time = to_ms_since_boot(get_absolute_time());
+        printf("Matter: LevelControl cluster updated - Fan speed %d%%\n", speed);
     }
     
-    if (changed) {
-        printf("Matter: LevelControl cluster updated - Fan speed %d%%\n", speed);
-        
-        // Update Matter attribute
-        matter_attr_value_t value;
-        value.uint8_val = speed;
-        int ret = matter_attributes_update(1, MATTER_CLUSTER_LEVEL_CONTROL, MATTER_ATTR_CURRENT_LEVEL, &value);
-        if (ret != 0) {
+    // Update Matter attribute with the smoothed speed; it keeps converging
+    // while the reading holds, so this runs for every reading
+    matter_attr_value_t value;
+    value.uint8_val = (uint8_t)ewma_update(&fan_speed_filter, speed, smoothing.fan_speed_shift);
+    int ret = matter_attributes_set(MATTER_ATTR_ID_CURRENT_LEVEL, &value);
+    if (ret != 0) {
+        if (changed) {
             printf("[Matter] ERROR: Failed to update LevelControl attribute (ret=%d)\n", ret);
-        } else {
-            // Notify platform of attribute change
-            platform_manager_report_level_change(1);
         }
+    } else if (changed) {
+        // Notify platform of attribute change
+        platform_manager_report_level_change(1);
     }
 }
 
@@ -275,24 +373,29 @@ void matter_bridge_update_temperature(uint16_t temp) {
     if (changed) {
         attributes.temperature = temp;
         attributes.last_update_time = to_ms_since_boot(get_absolute_time());
+        printf("Matter: TemperatureMeasurement cluster updated - %d°C\n", temp);
     }
     
-    if (changed) {
-        printf("Matter: TemperatureMeasurement cluster updated - %d°C\n", temp);
-        
-        // Update Matter attribute (convert to centidegrees for Matter spec)
-        // Matter TemperatureMeasurement is int16_t (max 32767 = 327.67 °C).
-        // Cap at INT16_MAX to avoid overflow for temperatures above 327 °C.
-        matter_attr_value_t value;
-        int32_t centidegrees = (int32_t)temp * 100;
-        value.int16_val = (centidegrees > INT16_MAX) ? INT16_MAX : (int16_t)centidegrees;
-        int ret = matter_attributes_update(1, MATTER_CLUSTER_TEMPERATURE_MEASUREMENT, MATTER_ATTR_MEASURED_VALUE, &value);
-        if (ret != 0) {
+    // Update Matter attribute (convert to centidegrees for Matter spec)
+    // Matter TemperatureMeasurement is int16_t (max 32767 = 327.67 °C).
+    // Cap at INT16_MAX to avoid overflow for temperatures above 327 °C.
+    int32_t centidegrees = (int32_t)temp * 100;
+    if (centidegrees > INT16_MAX) {
+        centidegrees = INT16_MAX;
+    }
+    
+    // Smoothed like the fan speed, so this runs for every reading
+    matter_attr_value_t value;
+    value.int16_val = (int16_t)ewma_update(&temperature_filter, centidegrees,
+                                           smoothing.temperature_shift);
+    int ret = matter_attributes_set(MATTER_ATTR_ID_MEASURED_VALUE, &value);
+    if (ret != 0) {
+        if (changed) {
             printf("[Matter] ERROR: Failed to update Temperature attribute (ret=%d)\n", ret);
-        } else {
-            // Notify platform of attribute change
-            platform_manager_report_temperature_change(1);
         }
+    } else if (changed) {
+        // Notify platform of attribute change
+        platform_manager_report_temperature_change(1);
     }
 }
 
@@ -328,6 +431,14 @@ void matter_bridge_update_diagnostics(uint8_t error_code) {
         attributes.last_update_time = to_ms_since_boot(get_absolute_time());
     }
     
+    // Compared with the last logged code, so data resuming after a timeout
+    // does not log the fault it already had
+    if (serial_link_active && event_error_code != error_code) {
+        cluster_diagnostics_log_fault_change(error_code, event_error_code,
+                                             to_ms_since_boot(get_absolute_time()));
+        event_error_code = error_code;
+    }
+    
     if (changed) {
         printf("Matter: Diagnostics cluster updated - Error code: 0x%02X, State: %s, Faults: %d\n",
                error_code,
@@ -339,16 +450,14 @@ void matter_bridge_update_diagnostics(uint8_t error_code) {
         
         // Update DeviceEnabledState
         value.uint8_val = attributes.device_enabled_state;
-        int ret = matter_attributes_update(1, MATTER_CLUSTER_DIAGNOSTICS, 
-                                          MATTER_ATTR_DEVICE_ENABLED_STATE, &value);
+        int ret = matter_attributes_set(MATTER_ATTR_ID_DEVICE_ENABLED_STATE, &value);
         if (ret != 0) {
             printf("[Matter] ERROR: Failed to update DeviceEnabledState (ret=%d)\n", ret);
         }
         
         // Update NumberOfActiveFaults
         value.uint8_val = attributes.number_of_active_faults;
-        ret = matter_attributes_update(1, MATTER_CLUSTER_DIAGNOSTICS,
-                                      MATTER_ATTR_NUMBER_OF_ACTIVE_FAULTS, &value);
+        ret = matter_attributes_set(MATTER_ATTR_ID_NUMBER_OF_ACTIVE_FAULTS, &value);
         if (ret != 0) {
             printf("[Matter] ERROR: Failed to update NumberOfActiveFaults (ret=%d)\n", ret);
         }
@@ -376,27 +485,29 @@ bool matter_bridge_task(void) {
 
     // Process Matter messages received over BLE (COBLe channel)
     if (ble_adapter_is_connected()) {
-        /* Static buffers are safe because matter_bridge_task() runs on Core 0
-         * only; there is no concurrent or reentrant execution in this firmware. */
-        static uint8_t ble_msg[MATTER_MAX_MESSAGE_SIZE];
-        static uint8_t ble_response[MATTER_MAX_MESSAGE_SIZE];
-        size_t  ble_msg_len = 0;
-
-        if (ble_adapter_receive_message(ble_msg, sizeof(ble_msg), &ble_msg_len) == 0 &&
-            ble_msg_len > 0) {
-            printf("Matter Bridge: Processing BLE message (%zu bytes)\n", ble_msg_len);
-            size_t  ble_response_len = 0;
-
-            int ret = matter_protocol_process_ble_message(
-                ble_msg, ble_msg_len,
-                ble_response, sizeof(ble_response),
-                &ble_response_len);
-
-            if (ret == 0 && ble_response_len > 0) {
-                printf("Matter Bridge: Sending BLE response (%zu bytes)\n",
-                       ble_response_len);
-                ble_adapter_send_data(ble_response, ble_response_len);
+        /* Request and response both live in message pool blocks; the BLE
+         * adapter keeps its own reference to the response until the last
+         * fragment has been indicated. */
+        packet_buffer_t *ble_msg = NULL;
+
+        if (ble_adapter_receive_buffer(&ble_msg) == 0) {
+            if (ble_msg->length > 0) {
+                printf("Matter Bridge: Processing BLE message (%zu bytes)\n",
+                       ble_msg->length);
+                packet_buffer_t *ble_response = NULL;
+
+                int ret = matter_protocol_process_ble_message(
+                    packet_buffer_data(ble_msg), ble_msg->length,
+                    &ble_response);
+
+                if (ret == 0 && ble_response && ble_response->length > 0) {
+                    printf("Matter Bridge: Sending BLE response (%zu bytes)\n",
+                           ble_response->length);
+                    ble_adapter_send_buffer(ble_response);
+                }
+                msg_pool_release(ble_response);
             }
+            msg_pool_release(ble_msg);
             work_done = true;
         }
     }
@@ -413,6 +524,71 @@ void matter_bridge_get_attributes(matter_attributes_t *attrs) {
     }
 }
 
+void matter_bridge_update_serial_link(bool active) {
+    if (!initialized || serial_link_active == active) {
+        return;
+    }
+    
+    serial_link_active = active;
+    cluster_diagnostics_log_data_timeout(!active, to_ms_since_boot(get_absolute_time()));
+}
+
+int matter_bridge_set_smoothing(const matter_bridge_smoothing_t *new_smoothing) {
+    if (!new_smoothing ||
+        new_smoothing->temperature_shift > SMOOTHING_MAX_SHIFT ||
+        new_smoothing->fan_speed_shift > SMOOTHING_MAX_SHIFT) {
+        return -1;
+    }
+    
+    smoothing = *new_smoothing;
+    return 0;
+}
+
+void matter_bridge_get_smoothing(matter_bridge_smoothing_t *out) {
+    if (out) {
+        *out = smoothing;
+    }
+}
+
+int matter_bridge_save_report_config(void) {
+    if (storage_adapter_write(SMOOTHING_KEY, (const uint8_t *)&smoothing,
+                              sizeof(smoothing)) != 0) {
+        printf("[Matter] ERROR: Failed to save reading smoothing\n");
+        return -1;
+    }
+    return matter_attributes_save_report_thresholds();
+}
+
+int matter_bridge_request_burner_enable(bool enable) {
+    if (!initialized) {
+        return -1;
+    }
+    
+    burner_request.enable = enable;
+    burner_request.requested_ms = to_ms_since_boot(get_absolute_time());
+    printf("[Matter] Burner %s requested (no control path on the serial link)\n",
+           enable ? "enable" : "disable");
+    return 0;
+}
+
+int matter_bridge_request_burner_power(uint8_t power) {
+    if (!initialized || power > 100) {
+        return -1;
+    }
+    
+    burner_request.power = power;
+    burner_request.requested_ms = to_ms_since_boot(get_absolute_time());
+    printf("[Matter] Burner power %u%% requested (no control path on the serial link)\n",
+           power);
+    return 0;
+}
+
+void matter_bridge_get_burner_request(matter_bridge_burner_request_t *request) {
+    if (request) {
+        *request = burner_request;
+    }
+}
+
 int matter_bridge_add_controller(const char *ip_address, uint16_t port) {
     if (!initialized) {
         printf("[Matter] ERROR: Bridge not initialized\n");
@@ -7,7 +7,13 @@
  */
 
 #include "basic.h"
+#include "../interaction/event_log.h"
 #include "CHIPDevicePlatformConfig.h"
+#include <string.h>
+
+/* User-configurable strings, written by controllers (NUL-terminated) */
+static char node_label[BASIC_NODE_LABEL_MAX_LEN + 1u];
+static char location[BASIC_LOCATION_MAX_LEN + 1u];
 
 /**
  * Read a Basic Information cluster attribute.
@@ -57,15 +63,15 @@ int cluster_basic_read(uint8_t endpoint, uint32_t attr_id,
             return 0;
 
         case ATTR_BASIC_NODE_LABEL:
-            /* NodeLabel is user-configurable; return empty string. */
-            value->string_val.str = "";
-            value->string_val.len = 0u;
+            /* NodeLabel is user-configurable; empty until written. */
+            value->string_val.str = node_label;
+            value->string_val.len = (uint16_t)strlen(node_label);
             *type = ATTR_TYPE_UTF8_STRING;
             return 0;
 
         case ATTR_BASIC_LOCATION:
-            value->string_val.str = "";
-            value->string_val.len = 0u;
+            value->string_val.str = location;
+            value->string_val.len = (uint16_t)strlen(location);
             *type = ATTR_TYPE_UTF8_STRING;
             return 0;
 
@@ -90,3 +96,52 @@ int cluster_basic_read(uint8_t endpoint, uint32_t attr_id,
             return -1;
     }
 }
+
+/**
+ * Write a Basic Information cluster attribute.
+ */
+im_status_code_t cluster_basic_write(uint8_t endpoint, uint32_t attr_id,
+                                     const attribute_value_t *value) {
+    char *dest;
+    size_t max_len;
+
+    if (!value || endpoint != 0) {
+        return IM_STATUS_UNSUPPORTED_WRITE;
+    }
+
+    switch (attr_id) {
+        case ATTR_BASIC_NODE_LABEL:
+            dest = node_label;
+            max_len = BASIC_NODE_LABEL_MAX_LEN;
+            break;
+
+        case ATTR_BASIC_LOCATION:
+            dest = location;
+            max_len = BASIC_LOCATION_MAX_LEN;
+            break;
+
+        default:
+            return IM_STATUS_UNSUPPORTED_WRITE;
+    }
+
+    /* Embedded NULs would silently shorten the string. */
+    if (value->string_val.len > max_len ||
+        memchr(value->string_val.str, '\0', value->string_val.len) != NULL) {
+        return IM_STATUS_CONSTRAINT_ERROR;
+    }
+
+    memcpy(dest, value->string_val.str, value->string_val.len);
+    dest[value->string_val.len] = '\0';
+    return IM_STATUS_SUCCESS;
+}
+
+/* StartUp ::= { SoftwareVersion [0]: uint32 } */
+static int encode_start_up(tlv_writer_t *writer, const void *arg) {
+    (void)arg;
+    return tlv_encode_uint32(writer, 0, CHIP_DEVICE_CONFIG_DEVICE_SOFTWARE_VERSION);
+}
+
+int cluster_basic_log_start_up(uint32_t now_ms) {
+    return event_log_emit(0, CLUSTER_BASIC_INFORMATION, EVENT_BASIC_START_UP,
+                          EVENT_PRIORITY_CRITICAL, encode_start_up, NULL, now_ms, NULL);
+}
@@ -29,6 +29,13 @@ extern "C" {
 #define ATTR_BASIC_SOFTWARE_VERSION       0x0009u
 #define ATTR_BASIC_SOFTWARE_VERSION_STR   0x000Au
 
+/* Basic Information event IDs */
+#define EVENT_BASIC_START_UP              0x00u
+
+/* Writable string limits (Matter Core Spec §11.1.5) */
+#define BASIC_NODE_LABEL_MAX_LEN          32u
+#define BASIC_LOCATION_MAX_LEN            2u
+
 /**
  * Read a Basic Information cluster attribute.
  *
@@ -41,6 +48,28 @@ extern "C" {
 int cluster_basic_read(uint8_t endpoint, uint32_t attr_id,
                        attribute_value_t *value, attribute_type_t *type);
 
+/**
+ * Write a Basic Information cluster attribute (NodeLabel, Location).
+ * Values are kept in RAM until the next reboot.
+ *
+ * @param endpoint    Endpoint number (0 = root node)
+ * @param attr_id     Attribute identifier
+ * @param value       New value (string, copied)
+ * @return IM_STATUS_SUCCESS, IM_STATUS_CONSTRAINT_ERROR if too long,
+ *         IM_STATUS_UNSUPPORTED_WRITE for other attributes
+ */
+im_status_code_t cluster_basic_write(uint8_t endpoint, uint32_t attr_id,
+                                     const attribute_value_t *value);
+
+/**
+ * Log the StartUp event (critical) with the running SoftwareVersion.
+ * Lets controllers see reboots in the event history.
+ *
+ * @param now_ms      Current time in milliseconds
+ * @return 0 on success, -1 if the event log is not initialized
+ */
+int cluster_basic_log_start_up(uint32_t now_ms);
+
 #ifdef __cplusplus
 }
 #endif
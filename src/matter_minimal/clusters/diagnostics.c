@@ -5,6 +5,7 @@
  */
 
 #include "diagnostics.h"
+#include "../interaction/event_log.h"
 
 // Forward declaration of matter_attributes functions
 extern int matter_attributes_get(uint8_t endpoint, uint32_t cluster_id,
@@ -76,3 +77,52 @@ int cluster_diagnostics_read(uint8_t endpoint, uint32_t attr_id,
             return -1;
     }
 }
+
+/**
+ * Burner event fields: up to two unsigned values, or a bool
+ */
+typedef struct {
+    uint32_t first;
+    uint8_t second;
+} burner_event_fields_t;
+
+static int encode_two_fields(tlv_writer_t *writer, const void *arg) {
+    const burner_event_fields_t *f = (const burner_event_fields_t *)arg;
+    if (tlv_encode_uint32(writer, 0, f->first) < 0 ||
+        tlv_encode_uint8(writer, 1, f->second) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+static int encode_timed_out(tlv_writer_t *writer, const void *arg) {
+    return tlv_encode_bool(writer, 0, *(const bool *)arg);
+}
+
+/**
+ * Log a FlameOut event
+ */
+int cluster_diagnostics_log_flame_out(uint32_t burn_seconds, uint8_t error_code,
+                                      uint32_t now_ms) {
+    burner_event_fields_t fields = { burn_seconds, error_code };
+    return event_log_emit(1, CLUSTER_DIAGNOSTICS, EVENT_BURNER_FLAME_OUT,
+                          EVENT_PRIORITY_INFO, encode_two_fields, &fields, now_ms, NULL);
+}
+
+/**
+ * Log a FaultChange event
+ */
+int cluster_diagnostics_log_fault_change(uint8_t current, uint8_t previous,
+                                         uint32_t now_ms) {
+    burner_event_fields_t fields = { current, previous };
+    return event_log_emit(1, CLUSTER_DIAGNOSTICS, EVENT_BURNER_FAULT_CHANGE,
+                          EVENT_PRIORITY_CRITICAL, encode_two_fields, &fields, now_ms, NULL);
+}
+
+/**
+ * Log a DataTimeoutChange event
+ */
+int cluster_diagnostics_log_data_timeout(bool timed_out, uint32_t now_ms) {
+    return event_log_emit(1, CLUSTER_DIAGNOSTICS, EVENT_BURNER_DATA_TIMEOUT_CHANGE,
+                          EVENT_PRIORITY_INFO, encode_timed_out, &timed_out, now_ms, NULL);
+}
@@ -9,6 +9,7 @@
 
 #include "../interaction/interaction_model.h"
 #include <stdint.h>
+#include <stdbool.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -23,6 +24,22 @@ extern "C" {
 #define ATTR_DEVICE_ENABLED_STATE           0x0005
 #define ATTR_NUMBER_OF_ACTIVE_FAULTS        0x0001
 
+/**
+ * Burner events (manufacturer-specific IDs under the vendor's prefix)
+ * Logged on endpoint 1 from the Viking Bio data:
+ * - FlameOut (info): flame went out { BurnSeconds [0]: uint32, ErrorCode [1]: uint8 }
+ * - FaultChange (critical): error code changed { Current [0]: uint8, Previous [1]: uint8 }
+ * - DataTimeoutChange (info): serial data stopped or resumed { TimedOut [0]: bool }
+ */
+#ifndef DIAGNOSTICS_EVENT_VENDOR_PREFIX
+#define DIAGNOSTICS_EVENT_VENDOR_PREFIX     0xFFF1u     // Test vendor ID
+#endif
+#define DIAGNOSTICS_VENDOR_EVENT(id)        (((uint32_t)DIAGNOSTICS_EVENT_VENDOR_PREFIX << 16) | (id))
+
+#define EVENT_BURNER_FLAME_OUT              DIAGNOSTICS_VENDOR_EVENT(0x00)
+#define EVENT_BURNER_FAULT_CHANGE           DIAGNOSTICS_VENDOR_EVENT(0x01)
+#define EVENT_BURNER_DATA_TIMEOUT_CHANGE    DIAGNOSTICS_VENDOR_EVENT(0x02)
+
 /**
  * Initialize diagnostics cluster
  * Registers attributes with matter_attributes system
@@ -43,6 +60,37 @@ int cluster_diagnostics_init(void);
 int cluster_diagnostics_read(uint8_t endpoint, uint32_t attr_id,
                             attribute_value_t *value, attribute_type_t *type);
 
+/**
+ * Log a FlameOut event
+ * 
+ * @param burn_seconds How long the flame had been on
+ * @param error_code Burner error code when it went out (0 = none)
+ * @param now_ms Current time in milliseconds
+ * @return 0 on success, -1 if the event log is not initialized
+ */
+int cluster_diagnostics_log_flame_out(uint32_t burn_seconds, uint8_t error_code,
+                                      uint32_t now_ms);
+
+/**
+ * Log a FaultChange event
+ * 
+ * @param current New burner error code (0 = fault cleared)
+ * @param previous Previous burner error code
+ * @param now_ms Current time in milliseconds
+ * @return 0 on success, -1 if the event log is not initialized
+ */
+int cluster_diagnostics_log_fault_change(uint8_t current, uint8_t previous,
+                                         uint32_t now_ms);
+
+/**
+ * Log a DataTimeoutChange event
+ * 
+ * @param timed_out true when data stopped, false when it resumed
+ * @param now_ms Current time in milliseconds
+ * @return 0 on success, -1 if the event log is not initialized
+ */
+int cluster_diagnostics_log_data_timeout(bool timed_out, uint32_t now_ms);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,109 @@
+/*
+ * general_commissioning.c
+ * Matter GeneralCommissioning Cluster implementation
+ */
+
+#include "general_commissioning.h"
+#include "operational_credentials.h"
+#include "../codec/tlv.h"
+
+// Fail-safe timer
+static bool fail_safe_armed = false;
+static uint32_t fail_safe_deadline_ms = 0;
+
+/**
+ * End the fail-safe without CommissioningComplete: what it staged is dropped
+ */
+static void fail_safe_end(void) {
+    fail_safe_armed = false;
+    cluster_operational_credentials_discard();
+}
+
+/**
+ * Check whether the fail-safe is armed
+ */
+bool cluster_general_commissioning_fail_safe_armed(uint32_t now_ms) {
+    if (fail_safe_armed && (int32_t)(now_ms - fail_safe_deadline_ms) >= 0) {
+        fail_safe_end();
+    }
+    return fail_safe_armed;
+}
+
+/**
+ * Disarm the fail-safe
+ */
+void cluster_general_commissioning_disarm(void) {
+    fail_safe_end();
+}
+
+/**
+ * Encode ArmFailSafeResponse / CommissioningCompleteResponse
+ * Response ::= { ErrorCode [0]: CommissioningErrorEnum, DebugText [1]: string }
+ */
+static im_status_code_t encode_response(tlv_writer_t *response, uint8_t error_code) {
+    if (tlv_encode_uint8(response, 0, error_code) < 0 ||
+        tlv_encode_string(response, 1, "") < 0) {
+        return IM_STATUS_FAILURE;
+    }
+    return IM_STATUS_SUCCESS;
+}
+
+/**
+ * ArmFailSafe ::= { ExpiryLengthSeconds [0]: uint16, Breadcrumb [1]: uint64 }
+ */
+static im_status_code_t arm_fail_safe(command_context_t *ctx) {
+    tlv_element_t expiry;
+
+    if (command_handler_get_field(ctx, 0, &expiry) < 0 ||
+        expiry.type != TLV_TYPE_UNSIGNED_INT) {
+        return IM_STATUS_INVALID_COMMAND;
+    }
+
+    // An earlier fail-safe that ran out is ended before a new one starts
+    bool armed = cluster_general_commissioning_fail_safe_armed(ctx->now_ms);
+
+    if (expiry.value.u64 == 0) {
+        if (armed) {
+            fail_safe_end();
+        }
+        return encode_response(ctx->response, COMMISSIONING_ERROR_OK);
+    }
+
+    uint32_t seconds = expiry.value.u64 > GENERAL_COMMISSIONING_MAX_FAIL_SAFE_S ?
+                       GENERAL_COMMISSIONING_MAX_FAIL_SAFE_S : (uint32_t)expiry.value.u64;
+    fail_safe_armed = true;
+    fail_safe_deadline_ms = ctx->now_ms + seconds * 1000u;
+    return encode_response(ctx->response, COMMISSIONING_ERROR_OK);
+}
+
+/**
+ * CommissioningComplete ::= {}
+ */
+static im_status_code_t commissioning_complete(command_context_t *ctx) {
+    if (!cluster_general_commissioning_fail_safe_armed(ctx->now_ms)) {
+        return encode_response(ctx->response, COMMISSIONING_ERROR_NO_FAIL_SAFE);
+    }
+
+    if (cluster_operational_credentials_commit() < 0) {
+        return IM_STATUS_FAILURE;
+    }
+
+    fail_safe_armed = false;
+    return encode_response(ctx->response, COMMISSIONING_ERROR_OK);
+}
+
+/**
+ * Invoke a GeneralCommissioning command
+ */
+im_status_code_t cluster_general_commissioning_invoke(command_context_t *ctx) {
+    switch (ctx->command_id) {
+        case CMD_ARM_FAIL_SAFE:
+            return arm_fail_safe(ctx);
+
+        case CMD_COMMISSIONING_COMPLETE:
+            return commissioning_complete(ctx);
+
+        default:
+            return IM_STATUS_UNSUPPORTED_COMMAND;
+    }
+}
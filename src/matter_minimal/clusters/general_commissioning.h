@@ -0,0 +1,77 @@
+/*
+ * general_commissioning.h
+ * Matter GeneralCommissioning Cluster (0x0030)
+ * Based on Matter Core Specification Section 11.10
+ *
+ * Keeps the fail-safe timer: ArmFailSafe arms (or, with an expiry of 0,
+ * disarms) it, CommissioningComplete ends it.  Commands that change the
+ * device's fabric credentials (AddNOC) require it to be armed; the
+ * credentials they stage are saved by CommissioningComplete and dropped
+ * when the fail-safe ends any other way.
+ */
+
+#ifndef CLUSTER_GENERAL_COMMISSIONING_H
+#define CLUSTER_GENERAL_COMMISSIONING_H
+
+#include "../interaction/interaction_model.h"
+#include "../interaction/command_handler.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * GeneralCommissioning Cluster ID and Commands
+ */
+#define CLUSTER_GENERAL_COMMISSIONING           0x0030
+#define CMD_ARM_FAIL_SAFE                       0x00
+#define CMD_ARM_FAIL_SAFE_RESPONSE              0x01
+#define CMD_COMMISSIONING_COMPLETE              0x04
+#define CMD_COMMISSIONING_COMPLETE_RESPONSE     0x05
+
+/**
+ * CommissioningErrorEnum
+ */
+#define COMMISSIONING_ERROR_OK                  0
+#define COMMISSIONING_ERROR_NO_FAIL_SAFE        3
+
+/**
+ * Longest fail-safe a single ArmFailSafe can set (seconds); longer
+ * requests are shortened to it
+ */
+#ifndef GENERAL_COMMISSIONING_MAX_FAIL_SAFE_S
+#define GENERAL_COMMISSIONING_MAX_FAIL_SAFE_S   900
+#endif
+
+/**
+ * Invoke a GeneralCommissioning command (ArmFailSafe, CommissioningComplete)
+ * Both answer with their response command carrying a CommissioningErrorEnum.
+ *
+ * @param ctx Command context
+ * @return IM_STATUS_SUCCESS, IM_STATUS_INVALID_COMMAND if a field is missing,
+ *         or IM_STATUS_FAILURE if the staged credentials cannot be saved
+ */
+im_status_code_t cluster_general_commissioning_invoke(command_context_t *ctx);
+
+/**
+ * Check whether the fail-safe is armed
+ * An expired fail-safe is ended here (staged credentials are dropped), so
+ * call it periodically as well.
+ *
+ * @param now_ms Current time in milliseconds
+ * @return true if armed and not expired
+ */
+bool cluster_general_commissioning_fail_safe_armed(uint32_t now_ms);
+
+/**
+ * Disarm the fail-safe, dropping staged credentials
+ */
+void cluster_general_commissioning_disarm(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CLUSTER_GENERAL_COMMISSIONING_H
@@ -10,6 +10,10 @@
 extern int matter_attributes_get(uint8_t endpoint, uint32_t cluster_id,
                                  uint32_t attribute_id, void *value);
 
+// Burner control requests (implemented in src/matter_bridge.cpp)
+extern int matter_bridge_request_burner_enable(bool enable);
+extern int matter_bridge_request_burner_power(uint8_t level);
+
 /**
  * Initialize LevelControl cluster
  */
@@ -48,13 +52,13 @@ int cluster_level_control_read(uint8_t endpoint, uint32_t attr_id,
         
         case ATTR_MIN_LEVEL:
             // Return minimum level (0%)
-            value->uint8_val = 0;
+            value->uint8_val = LEVEL_CONTROL_MIN_LEVEL;
             *type = ATTR_TYPE_UINT8;
             return 0;
         
         case ATTR_MAX_LEVEL:
             // Return maximum level (100%)
-            value->uint8_val = 100;
+            value->uint8_val = LEVEL_CONTROL_MAX_LEVEL;
             *type = ATTR_TYPE_UINT8;
             return 0;
         
@@ -62,3 +66,34 @@ int cluster_level_control_read(uint8_t endpoint, uint32_t attr_id,
             return -1;
     }
 }
+
+/**
+ * Invoke a LevelControl command
+ */
+im_status_code_t cluster_level_control_invoke(command_context_t *ctx) {
+    tlv_element_t level;
+    
+    if (ctx->command_id != CMD_MOVE_TO_LEVEL &&
+        ctx->command_id != CMD_MOVE_TO_LEVEL_WITH_ON_OFF) {
+        return IM_STATUS_UNSUPPORTED_COMMAND;
+    }
+    
+    // MoveToLevel ::= { Level [0], TransitionTime [1], OptionsMask [2], OptionsOverride [3] }
+    if (command_handler_get_field(ctx, 0, &level) < 0 ||
+        level.type != TLV_TYPE_UNSIGNED_INT) {
+        return IM_STATUS_INVALID_COMMAND;
+    }
+    if (level.value.u64 > LEVEL_CONTROL_MAX_LEVEL) {
+        return IM_STATUS_CONSTRAINT_ERROR;
+    }
+    
+    if (matter_bridge_request_burner_power((uint8_t)level.value.u64) < 0) {
+        return IM_STATUS_FAILURE;
+    }
+    
+    if (ctx->command_id == CMD_MOVE_TO_LEVEL_WITH_ON_OFF &&
+        matter_bridge_request_burner_enable(level.value.u64 > LEVEL_CONTROL_MIN_LEVEL) < 0) {
+        return IM_STATUS_FAILURE;
+    }
+    return IM_STATUS_SUCCESS;
+}
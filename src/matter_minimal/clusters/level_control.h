@@ -8,6 +8,7 @@
 #define CLUSTER_LEVEL_CONTROL_H
 
 #include "../interaction/interaction_model.h"
+#include "../interaction/command_handler.h"
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -22,6 +23,18 @@ extern "C" {
 #define ATTR_MIN_LEVEL              0x0002
 #define ATTR_MAX_LEVEL              0x0003
 
+/**
+ * LevelControl Commands
+ */
+#define CMD_MOVE_TO_LEVEL               0x00
+#define CMD_MOVE_TO_LEVEL_WITH_ON_OFF   0x04
+
+/**
+ * Level limits (MinLevel / MaxLevel, percent of burner power)
+ */
+#define LEVEL_CONTROL_MIN_LEVEL     0
+#define LEVEL_CONTROL_MAX_LEVEL     100
+
 /**
  * Initialize LevelControl cluster
  * Registers attributes with matter_attributes system
@@ -42,6 +55,19 @@ int cluster_level_control_init(void);
 int cluster_level_control_read(uint8_t endpoint, uint32_t attr_id,
                                attribute_value_t *value, attribute_type_t *type);
 
+/**
+ * Invoke a LevelControl command (MoveToLevel, MoveToLevelWithOnOff)
+ * Requests a burner power setpoint; MoveToLevelWithOnOff also requests
+ * the burner on (level above MinLevel) or off.  TransitionTime and the
+ * options fields are accepted and ignored.
+ * 
+ * @param ctx Command context
+ * @return IM_STATUS_SUCCESS, IM_STATUS_INVALID_COMMAND if Level is missing,
+ *         IM_STATUS_CONSTRAINT_ERROR if it is above MaxLevel, or
+ *         IM_STATUS_FAILURE if the request is refused
+ */
+im_status_code_t cluster_level_control_invoke(command_context_t *ctx);
+
 #ifdef __cplusplus
 }
 #endif
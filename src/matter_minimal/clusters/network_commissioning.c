@@ -236,3 +236,38 @@ int cluster_network_commissioning_read(
             return -1;
     }
 }
+
+/**
+ * Read Network Commissioning cluster attribute as a typed value
+ */
+int cluster_network_commissioning_read_attribute(uint8_t endpoint, uint32_t attr_id,
+                                                 attribute_value_t *value,
+                                                 attribute_type_t *type) {
+    if (endpoint != 0 || !value || !type) {
+        return -1;
+    }
+    
+    switch (attr_id) {
+        case NETWORK_COMMISSIONING_ATTR_MAX_NETWORKS:
+        case NETWORK_COMMISSIONING_ATTR_SCAN_MAX_TIME_SECONDS:
+        case NETWORK_COMMISSIONING_ATTR_CONNECT_MAX_TIME_SECONDS:
+        case NETWORK_COMMISSIONING_ATTR_LAST_NETWORKING_STATUS: {
+            uint8_t raw;
+            size_t len;
+            if (cluster_network_commissioning_read(attr_id, &raw, sizeof(raw), &len) < 0) {
+                return -1;
+            }
+            value->uint8_val = raw;
+            *type = ATTR_TYPE_UINT8;
+            return 0;
+        }
+            
+        case NETWORK_COMMISSIONING_ATTR_INTERFACE_ENABLED:
+            value->bool_val = interface_enabled;
+            *type = ATTR_TYPE_BOOL;
+            return 0;
+            
+        default:
+            return -1;
+    }
+}
@@ -7,6 +7,7 @@
 #ifndef CLUSTER_NETWORK_COMMISSIONING_H
 #define CLUSTER_NETWORK_COMMISSIONING_H
 
+#include "../interaction/interaction_model.h"
 #include <stdint.h>
 #include <stddef.h>
 #include <stdbool.h>
@@ -104,6 +105,21 @@ int cluster_network_commissioning_read(
     uint8_t *value_out, size_t max_value_len,
     size_t *actual_value_len);
 
+/**
+ * Read Network Commissioning cluster attribute as a typed value
+ * Same signature as the other cluster read functions, for the attribute
+ * table. LastNetworkID and LastConnectErrorValue are not available this way.
+ * 
+ * @param endpoint Endpoint number (only endpoint 0 has this cluster)
+ * @param attr_id Attribute ID
+ * @param value Output value
+ * @param type Output type
+ * @return 0 on success, -1 if attribute not supported
+ */
+int cluster_network_commissioning_read_attribute(uint8_t endpoint, uint32_t attr_id,
+                                                 attribute_value_t *value,
+                                                 attribute_type_t *type);
+
 /**
  * Initialize Network Commissioning cluster
  * 
@@ -11,6 +11,9 @@
 extern int matter_attributes_get(uint8_t endpoint, uint32_t cluster_id,
                                  uint32_t attribute_id, void *value);
 
+// Burner control request (implemented in src/matter_bridge.cpp)
+extern int matter_bridge_request_burner_enable(bool enable);
+
 /**
  * Initialize OnOff cluster
  */
@@ -50,3 +53,38 @@ int cluster_onoff_read(uint8_t endpoint, uint32_t attr_id,
             return -1;
     }
 }
+
+/**
+ * Invoke an OnOff command
+ */
+im_status_code_t cluster_onoff_invoke(command_context_t *ctx) {
+    bool enable;
+    
+    switch (ctx->command_id) {
+        case CMD_ONOFF_OFF:
+            enable = false;
+            break;
+        
+        case CMD_ONOFF_ON:
+            enable = true;
+            break;
+        
+        case CMD_ONOFF_TOGGLE: {
+            bool onoff_state = false;
+            if (matter_attributes_get(ctx->endpoint, CLUSTER_ONOFF, ATTR_ONOFF,
+                                      &onoff_state) < 0) {
+                return IM_STATUS_FAILURE;
+            }
+            enable = !onoff_state;
+            break;
+        }
+        
+        default:
+            return IM_STATUS_UNSUPPORTED_COMMAND;
+    }
+    
+    if (matter_bridge_request_burner_enable(enable) < 0) {
+        return IM_STATUS_FAILURE;
+    }
+    return IM_STATUS_SUCCESS;
+}
@@ -8,6 +8,7 @@
 #define CLUSTER_ONOFF_H
 
 #include "../interaction/interaction_model.h"
+#include "../interaction/command_handler.h"
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -20,6 +21,13 @@ extern "C" {
 #define CLUSTER_ONOFF               0x0006
 #define ATTR_ONOFF                  0x0000
 
+/**
+ * OnOff Commands
+ */
+#define CMD_ONOFF_OFF               0x00
+#define CMD_ONOFF_ON                0x01
+#define CMD_ONOFF_TOGGLE            0x02
+
 /**
  * Initialize OnOff cluster
  * Registers attributes with matter_attributes system
@@ -40,6 +48,16 @@ int cluster_onoff_init(void);
 int cluster_onoff_read(uint8_t endpoint, uint32_t attr_id,
                       attribute_value_t *value, attribute_type_t *type);
 
+/**
+ * Invoke an OnOff command (Off, On, Toggle)
+ * Requests the burner be enabled or disabled.  Toggle inverts the current
+ * OnOff attribute (flame state).
+ * 
+ * @param ctx Command context
+ * @return IM_STATUS_SUCCESS, or IM_STATUS_FAILURE if the request is refused
+ */
+im_status_code_t cluster_onoff_invoke(command_context_t *ctx);
+
 #ifdef __cplusplus
 }
 #endif
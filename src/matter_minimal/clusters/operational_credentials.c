@@ -0,0 +1,161 @@
+/*
+ * operational_credentials.c
+ * Matter OperationalCredentials Cluster implementation
+ */
+
+#include "operational_credentials.h"
+#include "general_commissioning.h"
+#include "../codec/tlv.h"
+#include "../security/certificate_store.h"
+#include <string.h>
+
+/**
+ * Certificate added under the fail-safe, not yet in the certificate store
+ */
+typedef struct {
+    uint8_t data[CERT_STORE_MAX_CERT_SIZE];
+    uint16_t len;                   // 0 = nothing staged
+} staged_cert_t;
+
+static staged_cert_t staged_noc;
+static staged_cert_t staged_icac;
+static staged_cert_t staged_rcac;
+
+static void stage(staged_cert_t *cert, const uint8_t *data, size_t len) {
+    memcpy(cert->data, data, len);
+    cert->len = (uint16_t)len;
+}
+
+/**
+ * Find a byte string field
+ *
+ * @return 0 if present, -1 if missing or not a byte string
+ */
+static int get_bytes_field(const command_context_t *ctx, uint8_t tag,
+                           tlv_element_t *element) {
+    if (command_handler_get_field(ctx, tag, element) < 0 ||
+        element->type != TLV_TYPE_BYTE_STRING) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Encode NOCResponse ::= { StatusCode [0], FabricIndex [1] }
+ */
+static im_status_code_t encode_noc_response(tlv_writer_t *response, uint8_t status_code) {
+    if (tlv_encode_uint8(response, 0, status_code) < 0) {
+        return IM_STATUS_FAILURE;
+    }
+    if (status_code == NOC_STATUS_OK &&
+        tlv_encode_uint8(response, 1, OPERATIONAL_CREDENTIALS_FABRIC_INDEX) < 0) {
+        return IM_STATUS_FAILURE;
+    }
+    return IM_STATUS_SUCCESS;
+}
+
+/**
+ * AddNOC ::= {
+ *   NOCValue [0]: octstr, ICACValue [1]: octstr (optional), IPKValue [2]: octstr,
+ *   CaseAdminSubject [3]: uint64, AdminVendorId [4]: uint16
+ * }
+ */
+static im_status_code_t add_noc(command_context_t *ctx) {
+    tlv_element_t noc;
+    tlv_element_t icac;
+    tlv_element_t ipk;
+    tlv_element_t field;
+
+    if (get_bytes_field(ctx, 0, &noc) < 0 ||
+        get_bytes_field(ctx, 2, &ipk) < 0 ||
+        command_handler_get_field(ctx, 3, &field) < 0 ||
+        command_handler_get_field(ctx, 4, &field) < 0) {
+        return IM_STATUS_INVALID_COMMAND;
+    }
+    if (ipk.value.bytes.length != OPERATIONAL_CREDENTIALS_IPK_LEN) {
+        return IM_STATUS_CONSTRAINT_ERROR;
+    }
+
+    bool has_icac = get_bytes_field(ctx, 1, &icac) == 0;
+
+    if (noc.value.bytes.length == 0 || noc.value.bytes.length > CERT_STORE_MAX_CERT_SIZE ||
+        (has_icac && (icac.value.bytes.length == 0 ||
+                      icac.value.bytes.length > CERT_STORE_MAX_CERT_SIZE))) {
+        return encode_noc_response(ctx->response, NOC_STATUS_INVALID_NOC);
+    }
+
+    // Saved by CommissioningComplete
+    stage(&staged_noc, noc.value.bytes.data, noc.value.bytes.length);
+    if (has_icac) {
+        stage(&staged_icac, icac.value.bytes.data, icac.value.bytes.length);
+    } else {
+        staged_icac.len = 0;
+    }
+
+    return encode_noc_response(ctx->response, NOC_STATUS_OK);
+}
+
+/**
+ * AddTrustedRootCertificate ::= { RootCACertificate [0]: octstr }
+ */
+static im_status_code_t add_trusted_root(command_context_t *ctx) {
+    tlv_element_t rcac;
+
+    if (get_bytes_field(ctx, 0, &rcac) < 0) {
+        return IM_STATUS_INVALID_COMMAND;
+    }
+    if (rcac.value.bytes.length == 0 || rcac.value.bytes.length > CERT_STORE_MAX_CERT_SIZE) {
+        return IM_STATUS_CONSTRAINT_ERROR;
+    }
+
+    // Saved by CommissioningComplete
+    stage(&staged_rcac, rcac.value.bytes.data, rcac.value.bytes.length);
+    return IM_STATUS_SUCCESS;
+}
+
+/**
+ * Invoke an OperationalCredentials command
+ */
+im_status_code_t cluster_operational_credentials_invoke(command_context_t *ctx) {
+    if (ctx->command_id != CMD_ADD_NOC && ctx->command_id != CMD_ADD_TRUSTED_ROOT_CERTIFICATE) {
+        return IM_STATUS_UNSUPPORTED_COMMAND;
+    }
+
+    // A commissioned device's credentials are only replaced by its fabric
+    if (certificate_store_has_noc() && ctx->auth_mode != IM_AUTH_CASE) {
+        return IM_STATUS_UNSUPPORTED_ACCESS;
+    }
+
+    // Credentials only change while the commissioner holds the fail-safe
+    if (!cluster_general_commissioning_fail_safe_armed(ctx->now_ms)) {
+        return IM_STATUS_FAILSAFE_REQUIRED;
+    }
+
+    return ctx->command_id == CMD_ADD_NOC ? add_noc(ctx) : add_trusted_root(ctx);
+}
+
+/**
+ * Save the staged certificates to the certificate store
+ */
+int cluster_operational_credentials_commit(void) {
+    if ((staged_rcac.len > 0 &&
+         certificate_store_save_rcac(staged_rcac.data, staged_rcac.len) < 0) ||
+        (staged_icac.len > 0 &&
+         certificate_store_save_icac(staged_icac.data, staged_icac.len) < 0) ||
+        (staged_noc.len > 0 &&
+         certificate_store_save_noc(staged_noc.data, staged_noc.len) < 0)) {
+        return -1;
+    }
+
+    cluster_operational_credentials_discard();
+    return 0;
+}
+
+/**
+ * Drop the staged certificates
+ */
+void cluster_operational_credentials_discard(void) {
+    staged_noc.len = 0;
+    staged_icac.len = 0;
+    staged_rcac.len = 0;
+}
@@ -0,0 +1,83 @@
+/*
+ * operational_credentials.h
+ * Matter OperationalCredentials Cluster (0x003E)
+ * Based on Matter Core Specification Section 11.18
+ *
+ * Installs the commissioner's trusted root and the device's operational
+ * certificates.  Both commands need an armed fail-safe (GeneralCommissioning
+ * ArmFailSafe); the certificates they add are staged in RAM and only saved
+ * to the certificate store by CommissioningComplete, so a commissioning
+ * that fails or times out leaves the stored credentials untouched.  Once
+ * the device has a NOC, only a CASE session of its fabric may replace the
+ * credentials.  The device supports a single fabric, always at fabric
+ * index 1.
+ */
+
+#ifndef CLUSTER_OPERATIONAL_CREDENTIALS_H
+#define CLUSTER_OPERATIONAL_CREDENTIALS_H
+
+#include "../interaction/interaction_model.h"
+#include "../interaction/command_handler.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * OperationalCredentials Cluster ID and Commands
+ */
+#define CLUSTER_OPERATIONAL_CREDENTIALS         0x003E
+#define CMD_ADD_NOC                             0x06
+#define CMD_NOC_RESPONSE                        0x08
+#define CMD_ADD_TRUSTED_ROOT_CERTIFICATE        0x0B
+
+/**
+ * NodeOperationalCertStatusEnum
+ */
+#define NOC_STATUS_OK                           0
+#define NOC_STATUS_INVALID_NOC                  3
+
+/**
+ * Fabric index of the device's only fabric
+ */
+#define OPERATIONAL_CREDENTIALS_FABRIC_INDEX    1
+
+/**
+ * IPKValue length (bytes)
+ */
+#define OPERATIONAL_CREDENTIALS_IPK_LEN         16
+
+/**
+ * Invoke an OperationalCredentials command (AddNOC, AddTrustedRootCertificate)
+ * AddNOC answers with NOCResponse; AddTrustedRootCertificate with a status.
+ *
+ * @param ctx Command context
+ * @return IM_STATUS_SUCCESS, IM_STATUS_FAILSAFE_REQUIRED without an armed
+ *         fail-safe, IM_STATUS_UNSUPPORTED_ACCESS on a commissioned device
+ *         unless over CASE, IM_STATUS_INVALID_COMMAND if a field is
+ *         missing, or IM_STATUS_CONSTRAINT_ERROR for an unusable root
+ *         certificate
+ */
+im_status_code_t cluster_operational_credentials_invoke(command_context_t *ctx);
+
+/**
+ * Save the staged certificates to the certificate store
+ * Called by CommissioningComplete.  The NOC is saved last, so an
+ * interrupted commit never leaves a NOC without its root.
+ *
+ * @return 0 on success (also when nothing is staged), -1 if the store fails
+ */
+int cluster_operational_credentials_commit(void);
+
+/**
+ * Drop the staged certificates
+ * Called when the fail-safe ends without CommissioningComplete.
+ */
+void cluster_operational_credentials_discard(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CLUSTER_OPERATIONAL_CREDENTIALS_H
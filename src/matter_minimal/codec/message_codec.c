@@ -5,30 +5,19 @@
  */
 
 #include "message_codec.h"
+#include "msg_counter.h"
 #include <string.h>
 
 // Message counter and exchange ID tracking
 static uint32_t current_message_counter = 0;
 static uint16_t current_exchange_id = 0;
 
-// Replay protection tracking (simple implementation for unsecured messages)
-#define MAX_SESSIONS 8
-static struct {
-    uint16_t session_id;
-    uint32_t last_counter;
-    bool active;
-} session_counters[MAX_SESSIONS];
-
 void matter_message_codec_init(void) {
     current_message_counter = 0;
     current_exchange_id = 0;
     
-    // Initialize session counter tracking
-    for (int i = 0; i < MAX_SESSIONS; i++) {
-        session_counters[i].session_id = 0;
-        session_counters[i].last_counter = 0;
-        session_counters[i].active = false;
-    }
+    // Initialize per-peer replay protection windows
+    msg_counter_init();
 }
 
 uint32_t matter_message_get_next_counter(void) {
@@ -40,36 +29,17 @@ uint16_t matter_message_get_next_exchange_id(void) {
 }
 
 bool matter_message_validate_counter(uint16_t session_id, uint32_t counter) {
-    // For unsecured messages (session_id = 0), accept any counter
-    // This is simplified - production would need proper window checking
+    // For unsecured messages (session_id = 0) there is no peer to key on
     if (session_id == 0) {
         return true;
     }
     
-    // Find session
-    for (int i = 0; i < MAX_SESSIONS; i++) {
-        if (session_counters[i].active && session_counters[i].session_id == session_id) {
-            // Check if counter is greater than last seen
-            if (counter > session_counters[i].last_counter) {
-                session_counters[i].last_counter = counter;
-                return true;
-            }
-            return false; // Replay detected
-        }
-    }
-    
-    // New session - find free slot
-    for (int i = 0; i < MAX_SESSIONS; i++) {
-        if (!session_counters[i].active) {
-            session_counters[i].session_id = session_id;
-            session_counters[i].last_counter = counter;
-            session_counters[i].active = true;
-            return true;
-        }
-    }
-    
-    // No free slots - accept anyway (simplified)
-    return true;
+    matter_message_header_t header = {
+        .session_id = session_id,
+        .security_flags = MATTER_SEC_FLAG_SESSION_UNICAST,
+        .message_counter = counter,
+    };
+    return msg_counter_check(&header) == MSG_COUNTER_OK;
 }
 
 /**
@@ -135,6 +105,108 @@ static inline uint64_t read_le64(const uint8_t *buffer) {
            ((uint64_t)buffer[7] << 56);
 }
 
+/*
+ * Fast-path word access.  On little-endian targets (RP2040, x86 hosts) a
+ * header field is a plain word in memory; memcpy() lets the compiler emit a
+ * single load/store when it can prove alignment and byte accesses otherwise.
+ * Big-endian builds fall back to the byte helpers above.
+ */
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define CODEC_LE_WORDS 1
+#endif
+
+#if defined(__GNUC__)
+#define CODEC_ALWAYS_INLINE         static inline __attribute__((always_inline))
+#define CODEC_ASSUME_ALIGNED4(p)    ((uint8_t *)__builtin_assume_aligned((p), 4))
+#else
+#define CODEC_ALWAYS_INLINE         static inline
+#define CODEC_ASSUME_ALIGNED4(p)    (p)
+#endif
+
+// Security flag bits that force the general path (session type, MX, C, P)
+#define FAST_PATH_SECURITY_MASK     0xE3
+
+// Exchange header length without vendor ID or ack counter
+#define EXCHANGE_HEADER_SIZE        6
+
+static inline void store_le32(uint8_t *p, uint32_t value) {
+#ifdef CODEC_LE_WORDS
+    memcpy(p, &value, sizeof(value));
+#else
+    write_le32(p, value);
+#endif
+}
+
+static inline void store_le16(uint8_t *p, uint16_t value) {
+#ifdef CODEC_LE_WORDS
+    memcpy(p, &value, sizeof(value));
+#else
+    write_le16(p, value);
+#endif
+}
+
+static inline uint32_t load_le32(const uint8_t *p) {
+#ifdef CODEC_LE_WORDS
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+#else
+    return read_le32(p);
+#endif
+}
+
+static inline uint16_t load_le16(const uint8_t *p) {
+#ifdef CODEC_LE_WORDS
+    uint16_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+#else
+    return read_le16(p);
+#endif
+}
+
+static inline uint64_t load_le64(const uint8_t *p) {
+    return (uint64_t)load_le32(p) | ((uint64_t)load_le32(p + 4) << 32);
+}
+
+size_t matter_exchange_header_size(const matter_message_t *msg) {
+    return EXCHANGE_HEADER_SIZE +
+           ((msg->exchange_flags & MATTER_EXCH_FLAG_ACK) ? 4 : 0);
+}
+
+int matter_exchange_header_decode(matter_message_t *msg) {
+    if (!msg || (!msg->payload && msg->payload_length > 0)) {
+        return MATTER_MSG_ERROR_INVALID_INPUT;
+    }
+    if (msg->payload_length < EXCHANGE_HEADER_SIZE) {
+        return MATTER_MSG_ERROR_BUFFER_UNDERFLOW;
+    }
+
+    const uint8_t *p = msg->payload;
+    uint8_t exch_flags = p[0];
+    size_t len = EXCHANGE_HEADER_SIZE;
+    if (exch_flags & MATTER_EXCH_FLAG_VENDOR) {
+        len += 2;
+    }
+    if (exch_flags & MATTER_EXCH_FLAG_ACK) {
+        len += 4;
+    }
+    if (msg->payload_length < len) {
+        return MATTER_MSG_ERROR_BUFFER_UNDERFLOW;
+    }
+
+    msg->exchange_flags  = exch_flags;
+    msg->protocol_opcode = p[1];
+    msg->exchange_id     = read_le16(&p[2]);
+    msg->protocol_id     = read_le16(&p[4]);
+    msg->ack_counter     = (exch_flags & MATTER_EXCH_FLAG_ACK) ?
+                           read_le32(&p[len - 4]) : 0;
+
+    msg->payload += len;
+    msg->payload_length -= len;
+    return MATTER_MSG_SUCCESS;
+}
+
 int matter_message_encode(const matter_message_t *msg, uint8_t *buffer, 
                           size_t buffer_size, size_t *encoded_length) {
     if (!msg || !buffer || !encoded_length) {
@@ -150,8 +222,10 @@ int matter_message_encode(const matter_message_t *msg, uint8_t *buffer,
         header_size += 8;
     }
     
-    // Exchange header: flags(1) + opcode(1) + exchange_id(2) + protocol_id(2) = 6
-    size_t total_size = header_size + 6 + msg->payload_length;
+    // Exchange header: flags(1) + opcode(1) + exchange_id(2) + protocol_id(2)
+    // [+ ack counter(4)]
+    size_t total_size = header_size + matter_exchange_header_size(msg) +
+                        msg->payload_length;
     
     if (total_size > buffer_size) {
         return MATTER_MSG_ERROR_BUFFER_TOO_SMALL;
@@ -201,14 +275,18 @@ int matter_message_encode(const matter_message_t *msg, uint8_t *buffer,
         offset += 8;
     }
     
-    // Encode exchange header (Matter Core Spec §4.5.2)
-    // I=0 (responder), A=0 (no ack), R=0 (no reliability), V=0
-    buffer[offset++] = 0x00;                              // Exchange flags
+    // Encode exchange header (Matter Core Spec §4.5.2), V=0
+    uint8_t exch_flags = msg->exchange_flags & MATTER_EXCH_FLAGS_ENCODED;
+    buffer[offset++] = exch_flags;                        // Exchange flags
     buffer[offset++] = msg->protocol_opcode;              // Protocol opcode
     write_le16(&buffer[offset], msg->exchange_id);        // Exchange ID
     offset += 2;
     write_le16(&buffer[offset], msg->protocol_id);        // Protocol ID
     offset += 2;
+    if (exch_flags & MATTER_EXCH_FLAG_ACK) {
+        write_le32(&buffer[offset], msg->ack_counter);    // Acknowledged counter
+        offset += 4;
+    }
     
     // Copy payload
     if (msg->payload_length > 0 && msg->payload != NULL) {
@@ -301,6 +379,9 @@ int matter_message_decode(const uint8_t *buffer, size_t buffer_size,
      */
     size_t remaining = buffer_size - offset;
 
+    msg->exchange_flags = 0;
+    msg->ack_counter = 0;
+
     if (msg->header.session_id == 0 && remaining >= 6) {
         uint8_t exch_flags   = buffer[offset];
         msg->protocol_opcode = buffer[offset + 1];
@@ -314,6 +395,10 @@ int matter_message_decode(const uint8_t *buffer, size_t buffer_size,
         if (exch_flags & MATTER_EXCH_FLAG_ACK) exch_hdr_len += 4;
 
         if (exch_hdr_len <= remaining) {
+            msg->exchange_flags = exch_flags;
+            if (exch_flags & MATTER_EXCH_FLAG_ACK) {
+                msg->ack_counter = read_le32(&buffer[offset + exch_hdr_len - 4]);
+            }
             offset += exch_hdr_len;
         }
     } else {
@@ -328,3 +413,192 @@ int matter_message_decode(const uint8_t *buffer, size_t buffer_size,
     
     return MATTER_MSG_SUCCESS;
 }
+
+void matter_header_template_init(matter_header_template_t *tmpl,
+                                 uint16_t session_id, uint8_t security_flags,
+                                 uint64_t source_node_id, uint64_t dest_node_id) {
+    if (!tmpl) {
+        return;
+    }
+
+    memset(tmpl, 0, sizeof(*tmpl));
+
+    uint8_t flags = (MATTER_MSG_VERSION << MATTER_MSG_FLAG_VERSION_SHIFT) & MATTER_MSG_FLAG_VERSION_MASK;
+    uint8_t n = 0;
+
+    if (source_node_id != 0) {
+        flags |= MATTER_MSG_FLAG_S;
+        tmpl->node_words[n++] = (uint32_t)source_node_id;
+        tmpl->node_words[n++] = (uint32_t)(source_node_id >> 32);
+    }
+    if (dest_node_id != 0) {
+        flags |= MATTER_MSG_FLAG_DSIZ_8B;
+        tmpl->node_words[n++] = (uint32_t)dest_node_id;
+        tmpl->node_words[n++] = (uint32_t)(dest_node_id >> 32);
+    }
+
+    tmpl->word0 = (uint32_t)flags |
+                  ((uint32_t)session_id << 8) |
+                  ((uint32_t)security_flags << 24);
+    tmpl->node_word_count = n;
+    tmpl->header_len = (uint8_t)(MATTER_MIN_HEADER_SIZE + n * 4);
+    tmpl->fast = (security_flags & FAST_PATH_SECURITY_MASK) == 0;
+
+    tmpl->header.flags = flags;
+    tmpl->header.session_id = session_id;
+    tmpl->header.security_flags = security_flags;
+    tmpl->header.source_node_id = source_node_id;
+    tmpl->header.dest_node_id = dest_node_id;
+}
+
+/**
+ * Store header and exchange header words.  Inlined twice so the aligned
+ * call site compiles to word stores even on Cortex-M0+.
+ */
+CODEC_ALWAYS_INLINE void emit_fast_header(uint8_t *p,
+                                          const matter_header_template_t *tmpl,
+                                          const matter_message_t *msg) {
+    store_le32(p, tmpl->word0);
+    store_le32(p + 4, msg->header.message_counter);
+
+    uint8_t *q = p + MATTER_MIN_HEADER_SIZE;
+    if (tmpl->node_word_count >= 2) {
+        store_le32(q, tmpl->node_words[0]);
+        store_le32(q + 4, tmpl->node_words[1]);
+        q += 8;
+    }
+    if (tmpl->node_word_count == 4) {
+        store_le32(q, tmpl->node_words[2]);
+        store_le32(q + 4, tmpl->node_words[3]);
+        q += 8;
+    }
+
+    // Exchange flags, opcode, exchange ID, protocol ID [, ack counter]
+    uint8_t exch_flags = msg->exchange_flags & MATTER_EXCH_FLAGS_ENCODED;
+    store_le32(q, (uint32_t)exch_flags |
+                  ((uint32_t)msg->protocol_opcode << 8) |
+                  ((uint32_t)msg->exchange_id << 16));
+    store_le16(q + 4, msg->protocol_id);
+    if (exch_flags & MATTER_EXCH_FLAG_ACK) {
+        store_le32(q + 6, msg->ack_counter);
+    }
+}
+
+int matter_message_encode_fast(const matter_header_template_t *tmpl,
+                               const matter_message_t *msg, uint8_t *buffer,
+                               size_t buffer_size, size_t *encoded_length) {
+    if (!tmpl || !msg || !buffer || !encoded_length) {
+        return MATTER_MSG_ERROR_INVALID_INPUT;
+    }
+
+    if (!tmpl->fast) {
+        matter_message_t general = *msg;
+        uint32_t counter = msg->header.message_counter;
+        general.header = tmpl->header;
+        general.header.message_counter = counter;
+        return matter_message_encode(&general, buffer, buffer_size, encoded_length);
+    }
+
+    size_t prefix_len = (size_t)tmpl->header_len + matter_exchange_header_size(msg);
+    size_t total_size = prefix_len + msg->payload_length;
+
+    if (total_size > buffer_size || total_size > MATTER_MAX_MESSAGE_SIZE) {
+        return MATTER_MSG_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    if (((uintptr_t)buffer & 3u) == 0) {
+        emit_fast_header(CODEC_ASSUME_ALIGNED4(buffer), tmpl, msg);
+    } else {
+        emit_fast_header(buffer, tmpl, msg);
+    }
+
+    if (msg->payload_length > 0 && msg->payload != NULL) {
+        memcpy(&buffer[prefix_len], msg->payload, msg->payload_length);
+    }
+
+    *encoded_length = total_size;
+    return MATTER_MSG_SUCCESS;
+}
+
+int matter_message_decode_fast(const uint8_t *buffer, size_t buffer_size,
+                               matter_message_t *msg) {
+    if (!buffer || !msg || buffer_size < MATTER_MIN_HEADER_SIZE) {
+        return MATTER_MSG_ERROR_INVALID_INPUT;
+    }
+
+    uint32_t word0 = load_le32(buffer);
+    uint8_t flags = (uint8_t)word0;
+
+    // Version 0, unicast (no group DSIZ), no reserved bits → fixed layout
+    if ((flags & ~(MATTER_MSG_FLAG_S | MATTER_MSG_FLAG_DSIZ_8B)) != 0) {
+        return matter_message_decode(buffer, buffer_size, msg);
+    }
+
+    size_t offset = MATTER_MIN_HEADER_SIZE;
+    if (flags & MATTER_MSG_FLAG_S) {
+        offset += 8;
+    }
+    if (flags & MATTER_MSG_FLAG_DSIZ_8B) {
+        offset += 8;
+    }
+
+    uint16_t session_id = (uint16_t)(word0 >> 8);
+
+    // Unsecured messages need a complete exchange header without vendor ID
+    size_t exch_len = EXCHANGE_HEADER_SIZE;
+    if (session_id == 0) {
+        if (buffer_size < offset + EXCHANGE_HEADER_SIZE ||
+            (buffer[offset] & MATTER_EXCH_FLAG_VENDOR) != 0) {
+            return matter_message_decode(buffer, buffer_size, msg);
+        }
+        if (buffer[offset] & MATTER_EXCH_FLAG_ACK) {
+            exch_len += 4;
+            if (buffer_size < offset + exch_len) {
+                return matter_message_decode(buffer, buffer_size, msg);
+            }
+        }
+    }
+    if (buffer_size < offset) {
+        return MATTER_MSG_ERROR_BUFFER_UNDERFLOW;
+    }
+
+    msg->header.flags = flags;
+    msg->header.session_id = session_id;
+    msg->header.security_flags = (uint8_t)(word0 >> 24);
+    msg->header.message_counter = load_le32(buffer + 4);
+
+    const uint8_t *p = buffer + MATTER_MIN_HEADER_SIZE;
+    if (flags & MATTER_MSG_FLAG_S) {
+        msg->header.source_node_id = load_le64(p);
+        p += 8;
+    } else {
+        msg->header.source_node_id = 0;
+    }
+    if (flags & MATTER_MSG_FLAG_DSIZ_8B) {
+        msg->header.dest_node_id = load_le64(p);
+    } else {
+        msg->header.dest_node_id = 0;
+    }
+
+    if (session_id == 0) {
+        uint32_t exch = load_le32(buffer + offset);
+        msg->exchange_flags  = (uint8_t)exch;
+        msg->protocol_opcode = (uint8_t)(exch >> 8);
+        msg->exchange_id     = (uint16_t)(exch >> 16);
+        msg->protocol_id     = load_le16(buffer + offset + 4);
+        msg->ack_counter     = (exch_len > EXCHANGE_HEADER_SIZE) ?
+                               load_le32(buffer + offset + 6) : 0;
+        offset += exch_len;
+    } else {
+        msg->protocol_id = 0;
+        msg->protocol_opcode = 0;
+        msg->exchange_id = 0;
+        msg->exchange_flags = 0;
+        msg->ack_counter = 0;
+    }
+
+    msg->payload = &buffer[offset];
+    msg->payload_length = buffer_size - offset;
+
+    return MATTER_MSG_SUCCESS;
+}
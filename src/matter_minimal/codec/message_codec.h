@@ -60,6 +60,11 @@ extern "C" {
 #define MATTER_EXCH_FLAG_RELIABILITY    0x04
 #define MATTER_EXCH_FLAG_VENDOR         0x10
 
+// Exchange flags the encoder emits (vendor protocols are not supported)
+#define MATTER_EXCH_FLAGS_ENCODED       (MATTER_EXCH_FLAG_INITIATOR | \
+                                         MATTER_EXCH_FLAG_ACK | \
+                                         MATTER_EXCH_FLAG_RELIABILITY)
+
 /**
  * Matter Message Header Structure
  * Minimum 8 bytes, up to 24 bytes with optional node IDs
@@ -82,10 +87,33 @@ typedef struct {
     uint16_t protocol_id;           // Protocol ID (e.g., 0x0001 for InteractionModel)
     uint8_t protocol_opcode;        // Protocol-specific opcode
     uint16_t exchange_id;           // Exchange ID for request/response matching
+    uint8_t exchange_flags;         // MATTER_EXCH_FLAG_* (I, A, R)
+    uint32_t ack_counter;           // Acknowledged counter (valid if A flag set)
     const uint8_t *payload;         // Pointer to payload data (TLV-encoded)
     size_t payload_length;          // Length of payload in bytes
 } matter_message_t;
 
+/**
+ * Precomputed header template (fast path)
+ *
+ * Almost all traffic on a given session has the same header shape: version 0,
+ * unicast, fixed session ID/security flags and the same optional node IDs.
+ * A template captures that shape once, as the little-endian words that make
+ * up the header, so matter_message_encode_fast() only has to store the
+ * message counter and exchange header per message.  Every field offset in
+ * that layout is a multiple of 4, so a word-aligned buffer gets aligned
+ * word stores.  Templates for unusual shapes (group sessions, privacy or
+ * extension flags) are marked non-fast and fall back to the general path.
+ */
+typedef struct {
+    uint32_t word0;                 // flags | session_id << 8 | security_flags << 24
+    uint32_t node_words[4];         // Source then destination node ID words
+    uint8_t header_len;             // 8, 16 or 24 bytes
+    uint8_t node_word_count;        // 0, 2 or 4
+    bool fast;                      // false → matter_message_encode() fallback
+    matter_message_header_t header; // Original fields, used by the fallback
+} matter_header_template_t;
+
 /**
  * Matter Protocol IDs
  */
@@ -174,6 +202,73 @@ int matter_message_encode(const matter_message_t *msg, uint8_t *buffer,
 int matter_message_decode(const uint8_t *buffer, size_t buffer_size, 
                           matter_message_t *msg);
 
+/**
+ * Get encoded exchange header length for a message
+ *
+ * @param msg Message (exchange_flags)
+ * @return 6 bytes, plus 4 when the A flag carries an acknowledged counter
+ */
+size_t matter_exchange_header_size(const matter_message_t *msg);
+
+/**
+ * Decode the exchange header at the start of msg->payload
+ *
+ * Secured messages carry the exchange header inside the encrypted payload,
+ * so the decoders leave it in place; call this after decryption.  On
+ * success protocol_id, protocol_opcode, exchange_id, exchange_flags and
+ * ack_counter are set and msg->payload is advanced past the header.
+ *
+ * @param msg Message whose payload starts with an exchange header
+ * @return MATTER_MSG_SUCCESS on success, error code on failure
+ */
+int matter_exchange_header_decode(matter_message_t *msg);
+
+/**
+ * Build a header template for a session
+ *
+ * @param tmpl Template to initialize
+ * @param session_id Session ID (0 = unsecured)
+ * @param security_flags Security flags byte
+ * @param source_node_id Source node ID (0 = not present)
+ * @param dest_node_id Destination node ID (0 = not present)
+ */
+void matter_header_template_init(matter_header_template_t *tmpl,
+                                 uint16_t session_id, uint8_t security_flags,
+                                 uint64_t source_node_id, uint64_t dest_node_id);
+
+/**
+ * Encode a message using a precomputed header template
+ *
+ * Produces output byte-identical to matter_message_encode() with the header
+ * fields taken from the template.  Only msg->header.message_counter is read
+ * from msg->header; the exchange header (including any ack counter) comes
+ * from msg.
+ *
+ * @param tmpl Header template for the session
+ * @param msg Message (counter, exchange header and payload)
+ * @param buffer Output buffer for encoded message
+ * @param buffer_size Size of output buffer
+ * @param encoded_length Pointer to store actual encoded length
+ * @return MATTER_MSG_SUCCESS on success, error code on failure
+ */
+int matter_message_encode_fast(const matter_header_template_t *tmpl,
+                               const matter_message_t *msg, uint8_t *buffer,
+                               size_t buffer_size, size_t *encoded_length);
+
+/**
+ * Decode a message, taking the fixed-layout path for common unicast headers
+ *
+ * Equivalent to matter_message_decode(); falls back to it for any header
+ * shape the fast path does not handle.
+ *
+ * @param buffer Input buffer containing encoded message
+ * @param buffer_size Size of input buffer
+ * @param msg Message structure to populate (payload will point into buffer)
+ * @return MATTER_MSG_SUCCESS on success, error code on failure
+ */
+int matter_message_decode_fast(const uint8_t *buffer, size_t buffer_size,
+                               matter_message_t *msg);
+
 /**
  * Get next message counter value
  * Message counters are used for replay protection
@@ -192,9 +287,11 @@ uint16_t matter_message_get_next_exchange_id(void);
 
 /**
  * Validate message counter for replay protection
- * For unsecured messages, this is a simple incrementing check
+ * Checks a secure unicast session counter against its 32-message sliding
+ * window (see msg_counter.h; use msg_counter_check() for group and
+ * unsecured messages, which need the full header).
  * 
- * @param session_id Session ID (0 for unsecured)
+ * @param session_id Session ID (0 for unsecured, always accepted)
  * @param counter Message counter value
  * @return true if counter is valid, false if replayed
  */
@@ -0,0 +1,288 @@
+/*
+ * msg_counter.c
+ * Message counter replay protection implementation
+ */
+
+#include "msg_counter.h"
+#include <stdio.h>
+#include <string.h>
+
+#if (MSG_COUNTER_UNICAST_SLOTS & (MSG_COUNTER_UNICAST_SLOTS - 1)) != 0
+#error "MSG_COUNTER_UNICAST_SLOTS must be a power of two"
+#endif
+#if (MSG_COUNTER_PEER_SLOTS & (MSG_COUNTER_PEER_SLOTS - 1)) != 0
+#error "MSG_COUNTER_PEER_SLOTS must be a power of two"
+#endif
+
+#define UNICAST_MASK    (MSG_COUNTER_UNICAST_SLOTS - 1)
+#define PEER_MASK       (MSG_COUNTER_PEER_SLOTS - 1)
+
+/**
+ * Message reception state
+ * Bit n of bitmap set → counter (max_counter - n - 1) already received.
+ */
+typedef struct {
+    uint32_t max_counter;
+    uint32_t bitmap;
+} rx_window_t;
+
+typedef struct {
+    rx_window_t window;
+    uint16_t session_id;
+    bool used;
+} unicast_entry_t;
+
+typedef struct {
+    rx_window_t window;
+    uint64_t node_id;           // Source node ID
+    uint32_t last_used;         // LRU tick
+    uint16_t session_id;        // Group session ID (0 = unsecured)
+    bool used;
+} peer_entry_t;
+
+static unicast_entry_t unicast_table[MSG_COUNTER_UNICAST_SLOTS];
+static peer_entry_t peer_table[MSG_COUNTER_PEER_SLOTS];
+static uint32_t peer_tick = 0;
+static msg_counter_stats_t stats;
+
+/**
+ * Fibonacci hash; the high bits of the product are the well-mixed ones
+ */
+static inline size_t hash_index(uint32_t key, size_t mask) {
+    return (size_t)((key * 2654435769u) >> 16) & mask;
+}
+
+static inline size_t unicast_home(uint16_t session_id) {
+    return hash_index(session_id, UNICAST_MASK);
+}
+
+static inline size_t peer_home(uint16_t session_id, uint64_t node_id) {
+    uint32_t key = (uint32_t)node_id ^ (uint32_t)(node_id >> 32) ^
+                   ((uint32_t)session_id << 16);
+    return hash_index(key, PEER_MASK);
+}
+
+/**
+ * Find or create unicast reception state
+ *
+ * @param created Set to true when a new entry was inserted
+ * @return Entry, or NULL if the table is full
+ */
+static unicast_entry_t *unicast_lookup(uint16_t session_id, bool *created) {
+    size_t i = unicast_home(session_id);
+
+    for (size_t probes = 0; probes < MSG_COUNTER_UNICAST_SLOTS; probes++) {
+        unicast_entry_t *e = &unicast_table[i];
+        if (!e->used) {
+            e->used = true;
+            e->session_id = session_id;
+            *created = true;
+            stats.unicast_in_use++;
+            return e;
+        }
+        if (e->session_id == session_id) {
+            *created = false;
+            return e;
+        }
+        i = (i + 1) & UNICAST_MASK;
+    }
+    return NULL;
+}
+
+/**
+ * Find or create group/unsecured peer reception state
+ * When the table is full the least recently used peer is replaced.
+ */
+static peer_entry_t *peer_lookup(uint16_t session_id, uint64_t node_id,
+                                 bool *created) {
+    size_t i = peer_home(session_id, node_id);
+    peer_entry_t *lru = NULL;
+    peer_entry_t *e = NULL;
+
+    for (size_t probes = 0; probes < MSG_COUNTER_PEER_SLOTS; probes++) {
+        e = &peer_table[i];
+        if (!e->used) {
+            stats.peers_in_use++;
+            break;
+        }
+        if (e->session_id == session_id && e->node_id == node_id) {
+            e->last_used = ++peer_tick;
+            *created = false;
+            return e;
+        }
+        if (!lru || (int32_t)(e->last_used - lru->last_used) < 0) {
+            lru = e;
+        }
+        i = (i + 1) & PEER_MASK;
+        e = NULL;
+    }
+
+    // No free slot on a full table: every slot is on every probe path, so
+    // overwriting any entry keeps all remaining keys reachable
+    if (!e) {
+        e = lru;
+        stats.evictions++;
+    }
+
+    e->used = true;
+    e->session_id = session_id;
+    e->node_id = node_id;
+    e->last_used = ++peer_tick;
+    *created = true;
+    return e;
+}
+
+/**
+ * Check a counter against a reception window and record it if new
+ *
+ * @param rollover Compare counters modulo 2^32 (group/unsecured)
+ * @param accept_behind Restart the window on counters older than it
+ *                      (unsecured sessions)
+ */
+static int window_check(rx_window_t *w, uint32_t counter,
+                        bool rollover, bool accept_behind) {
+    uint32_t ahead = counter - w->max_counter;
+    bool is_ahead = rollover ? (ahead != 0 && ahead < 0x80000000u)
+                             : (counter > w->max_counter);
+
+    if (is_ahead) {
+        // The old maximum lands at bit (ahead - 1); older bits slide up
+        if (ahead > MSG_COUNTER_WINDOW_SIZE) {
+            w->bitmap = 0;
+        } else if (ahead == MSG_COUNTER_WINDOW_SIZE) {
+            w->bitmap = 1u << (MSG_COUNTER_WINDOW_SIZE - 1);
+        } else {
+            w->bitmap = (w->bitmap << ahead) | (1u << (ahead - 1));
+        }
+        w->max_counter = counter;
+        return MSG_COUNTER_OK;
+    }
+
+    uint32_t behind = w->max_counter - counter;
+    if (behind == 0) {
+        return MSG_COUNTER_DUPLICATE;
+    }
+
+    if (behind <= MSG_COUNTER_WINDOW_SIZE) {
+        uint32_t bit = 1u << (behind - 1);
+        if (w->bitmap & bit) {
+            return MSG_COUNTER_DUPLICATE;
+        }
+        w->bitmap |= bit;
+        stats.reordered++;
+        return MSG_COUNTER_OK;
+    }
+
+    if (accept_behind) {
+        w->max_counter = counter;
+        w->bitmap = 0;
+        return MSG_COUNTER_OK;
+    }
+
+    return MSG_COUNTER_OUT_OF_WINDOW;
+}
+
+void msg_counter_init(void) {
+    memset(unicast_table, 0, sizeof(unicast_table));
+    memset(peer_table, 0, sizeof(peer_table));
+    memset(&stats, 0, sizeof(stats));
+    peer_tick = 0;
+}
+
+int msg_counter_check(const matter_message_header_t *header) {
+    if (!header) {
+        return MSG_COUNTER_DUPLICATE;
+    }
+
+    rx_window_t *w;
+    bool created;
+    bool rollover = true;
+    bool accept_behind = false;
+
+    if (header->session_id == 0) {
+        // Unsecured: the ephemeral initiator node ID is the only peer key
+        if (header->source_node_id == 0) {
+            stats.accepted++;
+            return MSG_COUNTER_OK;
+        }
+        w = &peer_lookup(0, header->source_node_id, &created)->window;
+        accept_behind = true;
+    } else if ((header->security_flags & MATTER_SEC_FLAG_SESSION_TYPE_MASK) ==
+               MATTER_SEC_FLAG_SESSION_GROUP) {
+        w = &peer_lookup(header->session_id, header->source_node_id,
+                         &created)->window;
+    } else {
+        unicast_entry_t *e = unicast_lookup(header->session_id, &created);
+        if (!e) {
+            printf("Msg Counter: No slot for session %u, dropping message\n",
+                   header->session_id);
+            stats.no_slot++;
+            return MSG_COUNTER_NO_SLOT;
+        }
+        w = &e->window;
+        rollover = false;
+    }
+
+    // Trust-first: the first counter seen synchronizes the window
+    if (created) {
+        w->max_counter = header->message_counter;
+        w->bitmap = 0;
+        stats.accepted++;
+        return MSG_COUNTER_OK;
+    }
+
+    int result = window_check(w, header->message_counter, rollover,
+                              accept_behind);
+    if (result == MSG_COUNTER_OK) {
+        stats.accepted++;
+    } else if (result == MSG_COUNTER_DUPLICATE) {
+        stats.duplicates++;
+    } else {
+        stats.out_of_window++;
+    }
+    return result;
+}
+
+void msg_counter_reset_session(uint16_t session_id) {
+    size_t i = unicast_home(session_id);
+    size_t probes;
+
+    for (probes = 0; probes < MSG_COUNTER_UNICAST_SLOTS; probes++) {
+        if (!unicast_table[i].used) {
+            return;
+        }
+        if (unicast_table[i].session_id == session_id) {
+            break;
+        }
+        i = (i + 1) & UNICAST_MASK;
+    }
+    if (probes == MSG_COUNTER_UNICAST_SLOTS) {
+        return;
+    }
+
+    // Backward-shift deletion keeps probe chains intact without tombstones
+    unicast_table[i].used = false;
+    stats.unicast_in_use--;
+
+    size_t j = i;
+    for (;;) {
+        j = (j + 1) & UNICAST_MASK;
+        if (!unicast_table[j].used) {
+            return;
+        }
+        size_t k = unicast_home(unicast_table[j].session_id);
+        // Entry at j may stay only if its home lies cyclically in (i, j]
+        bool stays = (i <= j) ? (i < k && k <= j) : (i < k || k <= j);
+        if (!stays) {
+            unicast_table[i] = unicast_table[j];
+            unicast_table[j].used = false;
+            i = j;
+        }
+    }
+}
+
+void msg_counter_get_stats(msg_counter_stats_t *out) {
+    if (out) {
+        *out = stats;
+    }
+}
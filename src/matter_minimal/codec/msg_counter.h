@@ -0,0 +1,120 @@
+/*
+ * msg_counter.h
+ * Message counter replay protection (Matter Core Specification Section 4.6.5)
+ *
+ * Each peer's message reception state is the largest counter seen so far plus
+ * a 32-bit bitmap of which of the 32 counters below it have already been
+ * received.  Reordered messages inside the window are accepted exactly once;
+ * anything older is treated as a duplicate.
+ *
+ * Three kinds of reception state are kept:
+ *   - Secure unicast sessions, keyed by local session ID.  Counters never
+ *     roll over.  State is dropped when the session is created/destroyed.
+ *   - Group sessions, keyed by (group session ID, source node ID).  Counters
+ *     roll over and are compared modulo 2^32.
+ *   - Unsecured sessions, keyed by the initiator's ephemeral source node ID.
+ *     Counters roll over and a counter behind the window restarts the state.
+ *
+ * Both tables are open-addressed hash tables, so a lookup is O(1) on average
+ * regardless of how session IDs were allocated.  When the peer table is full
+ * the least recently used group/unsecured peer is replaced; unicast state is
+ * never evicted, since forgetting it would re-open the replay window.
+ */
+
+#ifndef MSG_COUNTER_H
+#define MSG_COUNTER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "message_codec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Number of counters tracked below the maximum received counter
+ */
+#define MSG_COUNTER_WINDOW_SIZE         32
+
+/**
+ * Table sizes (powers of two; override at build time if needed)
+ */
+#ifndef MSG_COUNTER_UNICAST_SLOTS
+#define MSG_COUNTER_UNICAST_SLOTS       16
+#endif
+
+#ifndef MSG_COUNTER_PEER_SLOTS
+#define MSG_COUNTER_PEER_SLOTS          16
+#endif
+
+/**
+ * Security flags session type (Matter Core Spec §4.4.1.3, bits 0-1)
+ */
+#define MATTER_SEC_FLAG_SESSION_TYPE_MASK   0x03
+#define MATTER_SEC_FLAG_SESSION_UNICAST     0x00
+#define MATTER_SEC_FLAG_SESSION_GROUP       0x01
+
+/**
+ * Counter check results
+ */
+#define MSG_COUNTER_OK                  0
+#define MSG_COUNTER_DUPLICATE           -1  // Already received (in window)
+#define MSG_COUNTER_OUT_OF_WINDOW       -2  // Older than the window
+#define MSG_COUNTER_NO_SLOT             -3  // No room to track a new session
+
+/**
+ * Replay protection statistics
+ */
+typedef struct {
+    uint32_t accepted;          // Messages accepted
+    uint32_t reordered;         // Accepted from inside the window (late)
+    uint32_t duplicates;        // Rejected as already received
+    uint32_t out_of_window;     // Rejected as older than the window
+    uint32_t no_slot;           // Rejected because the unicast table was full
+    uint32_t evictions;         // Peer entries replaced (LRU)
+    uint16_t unicast_in_use;    // Unicast sessions currently tracked
+    uint16_t peers_in_use;      // Group/unsecured peers currently tracked
+} msg_counter_stats_t;
+
+/**
+ * Initialize (clear) all reception state and statistics
+ */
+void msg_counter_init(void);
+
+/**
+ * Check a received message counter and record it if new
+ *
+ * The session kind is taken from header->session_id, header->security_flags
+ * and header->source_node_id.  For secured messages call this only after
+ * the payload has been authenticated, so forged messages cannot move the
+ * window.  Unsecured messages without a source node ID have no peer to key
+ * on and are always accepted.
+ *
+ * @param header Decoded message header
+ * @return MSG_COUNTER_OK if the message is new, negative result otherwise
+ */
+int msg_counter_check(const matter_message_header_t *header);
+
+/**
+ * Forget the reception state of a secure unicast session
+ * Called when a session ID is (re)established or destroyed so that the
+ * next message on that ID synchronizes a fresh window.
+ *
+ * @param session_id Local session ID
+ */
+void msg_counter_reset_session(uint16_t session_id);
+
+/**
+ * Get replay protection statistics
+ *
+ * @param stats Output statistics
+ */
+void msg_counter_get_stats(msg_counter_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MSG_COUNTER_H
@@ -0,0 +1,120 @@
+/*
+ * msg_pool.c
+ * Static fixed-block message buffer pool implementation
+ */
+
+#include "msg_pool.h"
+#include <stdio.h>
+#include <string.h>
+
+static packet_buffer_t pool_blocks[MSG_POOL_BLOCK_COUNT];
+static uint8_t pool_refs[MSG_POOL_BLOCK_COUNT];
+
+static bool initialized = false;
+static uint16_t in_use = 0;
+static uint16_t high_water = 0;
+static uint32_t alloc_count = 0;
+static uint32_t alloc_failures = 0;
+static uint32_t release_errors = 0;
+static bool exhausted = false;      // Logged once per exhaustion episode
+
+/**
+ * Map a buffer pointer back to its block index
+ *
+ * @return Block index, or -1 if pb is not a pool block
+ */
+static int block_index(const packet_buffer_t *pb) {
+    if (pb < &pool_blocks[0] || pb >= &pool_blocks[MSG_POOL_BLOCK_COUNT]) {
+        return -1;
+    }
+    return (int)(pb - pool_blocks);
+}
+
+void msg_pool_init(void) {
+    if (initialized) {
+        return;
+    }
+
+    // Blocks may already have been handed out by layers that start before
+    // the protocol stack (e.g. BLE), so only the counters are reset here.
+    high_water = in_use;
+    alloc_count = 0;
+    alloc_failures = 0;
+    release_errors = 0;
+    initialized = true;
+}
+
+packet_buffer_t *msg_pool_alloc(void) {
+    for (size_t i = 0; i < MSG_POOL_BLOCK_COUNT; i++) {
+        if (pool_refs[i] == 0) {
+            pool_refs[i] = 1;
+            in_use++;
+            if (in_use > high_water) {
+                high_water = in_use;
+            }
+            alloc_count++;
+            exhausted = false;
+            packet_buffer_reset(&pool_blocks[i]);
+            return &pool_blocks[i];
+        }
+    }
+
+    alloc_failures++;
+    if (!exhausted) {
+        exhausted = true;
+        printf("Msg Pool: exhausted (%u blocks)\n", (unsigned)MSG_POOL_BLOCK_COUNT);
+    }
+    return NULL;
+}
+
+packet_buffer_t *msg_pool_retain(packet_buffer_t *pb) {
+    int idx = block_index(pb);
+    if (idx < 0 || pool_refs[idx] == 0 || pool_refs[idx] == UINT8_MAX) {
+        release_errors++;
+        return pb;
+    }
+    pool_refs[idx]++;
+    return pb;
+}
+
+void msg_pool_release(packet_buffer_t *pb) {
+    if (pb == NULL) {
+        return;
+    }
+
+    int idx = block_index(pb);
+    if (idx < 0 || pool_refs[idx] == 0) {
+        release_errors++;
+        return;
+    }
+
+    if (--pool_refs[idx] == 0) {
+        in_use--;
+    }
+}
+
+size_t msg_pool_available(void) {
+    return (size_t)(MSG_POOL_BLOCK_COUNT - in_use);
+}
+
+void msg_pool_get_stats(msg_pool_stats_t *stats) {
+    if (!stats) {
+        return;
+    }
+    stats->block_count = MSG_POOL_BLOCK_COUNT;
+    stats->block_size = PACKET_BUFFER_SIZE;
+    stats->in_use = in_use;
+    stats->high_water = high_water;
+    stats->alloc_count = alloc_count;
+    stats->alloc_failures = alloc_failures;
+    stats->release_errors = release_errors;
+}
+
+void msg_pool_print_stats(void) {
+    printf("Msg Pool: %u/%u blocks in use (peak %u, %u bytes each), "
+           "%lu allocs, %lu exhausted, %lu bad releases\n",
+           (unsigned)in_use, (unsigned)MSG_POOL_BLOCK_COUNT,
+           (unsigned)high_water, (unsigned)PACKET_BUFFER_SIZE,
+           (unsigned long)alloc_count, (unsigned long)alloc_failures,
+           (unsigned long)release_errors);
+}
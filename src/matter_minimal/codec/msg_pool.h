@@ -0,0 +1,98 @@
+/*
+ * msg_pool.h
+ * Static fixed-block message buffer pool
+ *
+ * All message-sized buffers (UDP receive queue, BLE reassembly, decrypted
+ * payloads, responses, CASE scratch space) come from one statically
+ * allocated pool of packet_buffer_t blocks.  Blocks are reference counted
+ * so a buffer can be handed from one layer to another (e.g. to the BLE
+ * adapter while fragments are still being indicated) without copying.
+ * Peak usage and exhaustion are tracked so RAM can be sized from field data.
+ */
+
+#ifndef MSG_POOL_H
+#define MSG_POOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "packet_buffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Number of blocks in the pool (override at build time if needed)
+ */
+#ifndef MSG_POOL_BLOCK_COUNT
+#define MSG_POOL_BLOCK_COUNT    10
+#endif
+
+/**
+ * Pool statistics
+ */
+typedef struct {
+    uint16_t block_count;       // Total blocks
+    uint16_t block_size;        // Bytes per block (payload area)
+    uint16_t in_use;            // Blocks currently allocated
+    uint16_t high_water;        // Peak blocks allocated since init
+    uint32_t alloc_count;       // Successful allocations
+    uint32_t alloc_failures;    // Allocations refused (pool exhausted)
+    uint32_t release_errors;    // Releases of foreign or already-free blocks
+} msg_pool_stats_t;
+
+/**
+ * Initialize message pool
+ * Idempotent; statistics are reset on the first call only.
+ */
+void msg_pool_init(void);
+
+/**
+ * Allocate a block
+ * The block is reset (packet_buffer_reset) and has a reference count of 1.
+ *
+ * @return Packet buffer, or NULL if the pool is exhausted
+ */
+packet_buffer_t *msg_pool_alloc(void);
+
+/**
+ * Take an additional reference to a block
+ *
+ * @param pb Block obtained from msg_pool_alloc()
+ * @return pb, for convenience
+ */
+packet_buffer_t *msg_pool_retain(packet_buffer_t *pb);
+
+/**
+ * Drop a reference; the block returns to the pool when the count reaches 0
+ * NULL is accepted and ignored.
+ *
+ * @param pb Block obtained from msg_pool_alloc()
+ */
+void msg_pool_release(packet_buffer_t *pb);
+
+/**
+ * Get number of free blocks
+ *
+ * @return Free block count
+ */
+size_t msg_pool_available(void);
+
+/**
+ * Get pool statistics
+ *
+ * @param stats Output statistics
+ */
+void msg_pool_get_stats(msg_pool_stats_t *stats);
+
+/**
+ * Print pool statistics (high-water mark and exhaustion counters)
+ */
+void msg_pool_print_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MSG_POOL_H
@@ -0,0 +1,84 @@
+/*
+ * packet_buffer.c
+ * Packet buffer with reserved header and MIC headroom
+ */
+
+#include "packet_buffer.h"
+#include <string.h>
+
+void packet_buffer_reset(packet_buffer_t *pb) {
+    if (!pb) {
+        return;
+    }
+    pb->start = PACKET_BUFFER_HEADER_RESERVE;
+    pb->length = 0;
+}
+
+void packet_buffer_reset_rx(packet_buffer_t *pb) {
+    if (!pb) {
+        return;
+    }
+    pb->start = 0;
+    pb->length = 0;
+}
+
+uint8_t *packet_buffer_tail(packet_buffer_t *pb) {
+    return &pb->data[pb->start + pb->length];
+}
+
+size_t packet_buffer_tailroom(const packet_buffer_t *pb) {
+    size_t used = pb->start + pb->length;
+    size_t limit = PACKET_BUFFER_SIZE - PACKET_BUFFER_MIC_RESERVE;
+    return (used < limit) ? (limit - used) : 0;
+}
+
+int packet_buffer_commit(packet_buffer_t *pb, size_t len) {
+    if (!pb || len > packet_buffer_tailroom(pb)) {
+        return -1;
+    }
+    pb->length += len;
+    return 0;
+}
+
+uint8_t *packet_buffer_prepend(packet_buffer_t *pb, size_t len) {
+    if (!pb || len > pb->start) {
+        return NULL;
+    }
+    pb->start -= len;
+    pb->length += len;
+    return &pb->data[pb->start];
+}
+
+int packet_buffer_prepend_header(packet_buffer_t *pb,
+                                 const matter_header_template_t *tmpl,
+                                 const matter_message_t *msg) {
+    if (!pb || !tmpl || !msg) {
+        return MATTER_MSG_ERROR_INVALID_INPUT;
+    }
+
+    size_t prefix_len = (size_t)tmpl->header_len + matter_exchange_header_size(msg);
+    if (prefix_len + pb->length > MATTER_MAX_MESSAGE_SIZE) {
+        return MATTER_MSG_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    uint8_t *dst = packet_buffer_prepend(pb, prefix_len);
+    if (!dst) {
+        return MATTER_MSG_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    // Encode the headers only; the payload is already in place
+    matter_message_t hdr = *msg;
+    hdr.payload = NULL;
+    hdr.payload_length = 0;
+
+    size_t written = 0;
+    int ret = matter_message_encode_fast(tmpl, &hdr, dst, prefix_len, &written);
+    if (ret != MATTER_MSG_SUCCESS || written != prefix_len) {
+        // Roll back so the caller still holds just the payload
+        pb->start += prefix_len;
+        pb->length -= prefix_len;
+        return (ret != MATTER_MSG_SUCCESS) ? ret : MATTER_MSG_ERROR_INVALID_FLAGS;
+    }
+
+    return MATTER_MSG_SUCCESS;
+}
@@ -0,0 +1,130 @@
+/*
+ * packet_buffer.h
+ * Packet buffer with reserved header and MIC headroom
+ *
+ * A packet buffer holds one outgoing Matter message.  It is reset with room
+ * reserved in front for the message and exchange headers and at the end for
+ * the AES-CCM MIC, so handlers encode their TLV payload directly at the
+ * payload offset, the codec prepends the headers in place, and the finished
+ * bytes are handed to the transport without further copies.
+ *
+ * Layout:
+ *   [ headroom | message hdr | exchange hdr | payload | MIC reserve ]
+ *                ^start                                 ^start+length
+ */
+
+#ifndef PACKET_BUFFER_H
+#define PACKET_BUFFER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "message_codec.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Buffer geometry
+ *
+ * Header reserve covers the largest message header (24) plus the largest
+ * exchange header (6 + vendor ID 2 + ack counter 4).  It is 2 mod 4 so that,
+ * for the usual header shapes (which are also 2 mod 4 long), the prepended
+ * message header starts word-aligned for matter_message_encode_fast().
+ */
+#define PACKET_BUFFER_SIZE              MATTER_MAX_MESSAGE_SIZE
+#define PACKET_BUFFER_HEADER_RESERVE    38
+#define PACKET_BUFFER_MIC_RESERVE       16
+
+/**
+ * Packet buffer
+ * data is the first member so it inherits the struct's word alignment.
+ */
+typedef struct {
+    uint8_t data[PACKET_BUFFER_SIZE];
+    size_t start;                   // Offset of the first valid byte
+    size_t length;                  // Number of valid bytes from start
+} packet_buffer_t;
+
+/**
+ * Reset buffer to empty with header headroom and MIC tailroom reserved
+ *
+ * @param pb Packet buffer
+ */
+void packet_buffer_reset(packet_buffer_t *pb);
+
+/**
+ * Reset buffer to empty with no headroom
+ * Used for received packets, which may fill the whole block.
+ *
+ * @param pb Packet buffer
+ */
+void packet_buffer_reset_rx(packet_buffer_t *pb);
+
+/**
+ * Get write pointer for payload bytes (end of current content)
+ *
+ * @param pb Packet buffer
+ * @return Pointer where the next payload byte should be written
+ */
+uint8_t *packet_buffer_tail(packet_buffer_t *pb);
+
+/**
+ * Get number of payload bytes that may still be written
+ * Excludes the MIC reserve.
+ *
+ * @param pb Packet buffer
+ * @return Available tailroom in bytes
+ */
+size_t packet_buffer_tailroom(const packet_buffer_t *pb);
+
+/**
+ * Mark bytes written at packet_buffer_tail() as valid
+ *
+ * @param pb Packet buffer
+ * @param len Number of bytes written
+ * @return 0 on success, -1 if len exceeds tailroom
+ */
+int packet_buffer_commit(packet_buffer_t *pb, size_t len);
+
+/**
+ * Extend valid region towards the front (for header encoding)
+ *
+ * @param pb Packet buffer
+ * @param len Number of bytes to prepend
+ * @return Pointer to the new start, or NULL if headroom is insufficient
+ */
+uint8_t *packet_buffer_prepend(packet_buffer_t *pb, size_t len);
+
+/**
+ * Get pointer to first valid byte
+ *
+ * @param pb Packet buffer
+ * @return Pointer to message start
+ */
+static inline uint8_t *packet_buffer_data(packet_buffer_t *pb) {
+    return &pb->data[pb->start];
+}
+
+/**
+ * Encode message and exchange headers in front of the payload already
+ * committed to the buffer
+ *
+ * msg->payload is ignored; msg->payload_length is taken from the buffer.
+ * Output bytes are identical to matter_message_encode_fast().
+ *
+ * @param pb Packet buffer holding the payload
+ * @param tmpl Header template for the session
+ * @param msg Message (counter and exchange header fields)
+ * @return MATTER_MSG_SUCCESS on success, error code on failure
+ */
+int packet_buffer_prepend_header(packet_buffer_t *pb,
+                                 const matter_header_template_t *tmpl,
+                                 const matter_message_t *msg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PACKET_BUFFER_H
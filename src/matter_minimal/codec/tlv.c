@@ -229,6 +229,22 @@ int tlv_encode_uint32(tlv_writer_t *writer, uint8_t tag, uint32_t value) {
     }
 }
 
+int tlv_encode_uint64(tlv_writer_t *writer, uint8_t tag, uint64_t value) {
+    if (writer == NULL) {
+        return -1;
+    }
+    
+    if (value <= 0xFFFFFFFF) {
+        return tlv_encode_uint32(writer, tag, (uint32_t)value);
+    }
+    
+    if (write_control_and_tag(writer, TLV_ELEMENT_TYPE_UINT, TLV_LENGTH_8_BYTE, tag) < 0) {
+        return -1;
+    }
+    
+    return write_bytes(writer, &value, 8);
+}
+
 int tlv_encode_int8(tlv_writer_t *writer, uint8_t tag, int8_t value) {
     if (writer == NULL) {
         return -1;
@@ -382,6 +398,17 @@ int tlv_encode_bytes(tlv_writer_t *writer, uint8_t tag, const uint8_t *data, siz
     return write_bytes(writer, data, length);
 }
 
+int tlv_encode_raw(tlv_writer_t *writer, const uint8_t *data, size_t length) {
+    if (writer == NULL || (data == NULL && length > 0)) {
+        return -1;
+    }
+    if (length == 0) {
+        return 0;
+    }
+    
+    return write_bytes(writer, data, length);
+}
+
 // Container Functions
 
 int tlv_encode_structure_start(tlv_writer_t *writer, uint8_t tag) {
@@ -539,6 +566,10 @@ int tlv_reader_next(tlv_reader_t *reader, tlv_element_t *element) {
         }
     }
     
+    // Integers shorter than 8 bytes fill only the low bytes of the union,
+    // and callers read whichever member fits the field (value.u32 for IDs)
+    memset(&element->value, 0, sizeof(element->value));
+    
     // Parse value based on type
     switch (element->type) {
         case TLV_TYPE_SIGNED_INT: {
@@ -664,6 +695,25 @@ int tlv_reader_skip(tlv_reader_t *reader) {
     return tlv_reader_next(reader, &element);
 }
 
+int tlv_reader_exit_container(tlv_reader_t *reader) {
+    tlv_element_t element;
+    int depth = 1;
+
+    while (depth > 0) {
+        if (tlv_reader_next(reader, &element) < 0) {
+            return -1;
+        }
+        if (element.type == TLV_TYPE_END_OF_CONTAINER) {
+            depth--;
+        } else if (element.type == TLV_TYPE_STRUCTURE ||
+                   element.type == TLV_TYPE_ARRAY ||
+                   element.type == TLV_TYPE_LIST) {
+            depth++;
+        }
+    }
+    return 0;
+}
+
 bool tlv_reader_is_end(const tlv_reader_t *reader) {
     if (reader == NULL) {
         return true;
@@ -55,6 +55,15 @@ int tlv_encode_uint16(tlv_writer_t *writer, uint8_t tag, uint16_t value);
  */
 int tlv_encode_uint32(tlv_writer_t *writer, uint8_t tag, uint32_t value);
 
+/**
+ * Encode an unsigned 64-bit integer
+ * @param writer Pointer to writer structure
+ * @param tag Context-specific tag (0-255)
+ * @param value Value to encode
+ * @return 0 on success, -1 on error
+ */
+int tlv_encode_uint64(tlv_writer_t *writer, uint8_t tag, uint64_t value);
+
 /**
  * Encode a signed 8-bit integer
  * @param writer Pointer to writer structure
@@ -118,6 +127,15 @@ int tlv_encode_string(tlv_writer_t *writer, uint8_t tag, const char *str);
  */
 int tlv_encode_bytes(tlv_writer_t *writer, uint8_t tag, const uint8_t *data, size_t length);
 
+/**
+ * Append elements that were TLV-encoded earlier
+ * @param writer Pointer to writer structure
+ * @param data Encoded elements
+ * @param length Length of data
+ * @return 0 on success, -1 if it does not fit
+ */
+int tlv_encode_raw(tlv_writer_t *writer, const uint8_t *data, size_t length);
+
 /**
  * TLV Container Functions
  * Encode structures, arrays, and lists
@@ -190,6 +208,15 @@ int tlv_reader_peek(tlv_reader_t *reader, tlv_element_t *element);
  */
 int tlv_reader_skip(tlv_reader_t *reader);
 
+/**
+ * Skip the rest of the container the reader is inside
+ * Nested containers are skipped whole; the reader is left just past the
+ * container's end.
+ * @param reader Pointer to reader structure
+ * @return 0 on success, -1 if the container is not terminated
+ */
+int tlv_reader_exit_container(tlv_reader_t *reader);
+
 /**
  * Check if reader is at the end of the buffer
  * @param reader Pointer to reader structure
@@ -5,7 +5,9 @@
 
 #include "network_commissioning.h"
 #include "../security/pase.h"
+#include "../security/pase_verifier.h"
 #include "../security/session_mgr.h"
+#include "../security/crypto_stats.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -133,6 +135,7 @@ int commissioning_handle_pase_message(uint8_t opcode,
                     // Add session to session manager
                     if (session_create(session_id, session_key, sizeof(session_key)) == 0) {
                         printf("Commissioning: PASE completed, session ID %u established\n", session_id);
+                        crypto_stats_handshake_done();
                         g_commissioning_ctx.state = COMMISSIONING_STATE_COMMISSIONED;
                         
                         if (session_id_out) {
@@ -417,8 +420,10 @@ void commissioning_reset(void) {
     // Clear from storage
     commissioning_save_fabrics();
     
-    // Clean up PASE context
+    // Clean up PASE context; the verifier is derived again from the PIN
+    // on the next commissioning_start()
     pase_deinit(&g_pase_ctx);
+    pase_verifier_clear();
     
     printf("Commissioning: Reset to factory defaults\n");
 }
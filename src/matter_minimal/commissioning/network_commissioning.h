@@ -172,7 +172,7 @@ int commissioning_load_fabrics(void);
 
 /**
  * Reset commissioning state
- * Clears all fabrics and returns to idle state
+ * Clears all fabrics and the stored PASE verifier, and returns to idle state
  */
 void commissioning_reset(void);
 
@@ -0,0 +1,373 @@
+/*
+ * attribute_table.c
+ * Sorted index of every attribute the device serves
+ */
+
+#include "attribute_table.h"
+#include <string.h>
+
+// Cluster read functions (clusters/)
+extern int cluster_descriptor_read(uint8_t endpoint, uint32_t attr_id,
+                                   attribute_value_t *value, attribute_type_t *type);
+extern int cluster_basic_read(uint8_t endpoint, uint32_t attr_id,
+                              attribute_value_t *value, attribute_type_t *type);
+extern im_status_code_t cluster_basic_write(uint8_t endpoint, uint32_t attr_id,
+                                            const attribute_value_t *value);
+extern int cluster_network_commissioning_read_attribute(uint8_t endpoint, uint32_t attr_id,
+                                                        attribute_value_t *value,
+                                                        attribute_type_t *type);
+extern int cluster_onoff_read(uint8_t endpoint, uint32_t attr_id,
+                             attribute_value_t *value, attribute_type_t *type);
+extern int cluster_level_control_read(uint8_t endpoint, uint32_t attr_id,
+                                      attribute_value_t *value, attribute_type_t *type);
+extern int cluster_diagnostics_read(uint8_t endpoint, uint32_t attr_id,
+                                   attribute_value_t *value, attribute_type_t *type);
+extern int cluster_temperature_read(uint8_t endpoint, uint32_t attr_id,
+                                   attribute_value_t *value, attribute_type_t *type);
+
+#define R   ATTR_QUALITY_REPORTABLE
+#define F   ATTR_QUALITY_FIXED
+#define N   ATTR_QUALITY_NULLABLE
+#define L   ATTR_QUALITY_LIST
+#define W   ATTR_QUALITY_WRITABLE
+
+/*
+ * Sorted by endpoint, then cluster, then attribute.
+ * Endpoint 0: Root Node.  Endpoint 1: Viking Bio burner.
+ */
+static const attribute_entry_t attribute_table[] = {
+    // Endpoint 0 - Descriptor (0x001D)
+    { 0, R | F | L, ATTR_TYPE_ARRAY,       0x001D, 0x0000, cluster_descriptor_read, NULL }, // DeviceTypeList
+    { 0, R | F | L, ATTR_TYPE_ARRAY,       0x001D, 0x0001, cluster_descriptor_read, NULL }, // ServerList
+    { 0, R | F | L, ATTR_TYPE_ARRAY,       0x001D, 0x0002, cluster_descriptor_read, NULL }, // ClientList
+    { 0, R | F | L, ATTR_TYPE_ARRAY,       0x001D, 0x0003, cluster_descriptor_read, NULL }, // PartsList
+
+    // Endpoint 0 - BasicInformation (0x0028)
+    { 0, R | F,     ATTR_TYPE_UINT16,      0x0028, 0x0000, cluster_basic_read, NULL }, // DataModelRevision
+    { 0, R | F,     ATTR_TYPE_UTF8_STRING, 0x0028, 0x0001, cluster_basic_read, NULL }, // VendorName
+    { 0, R | F,     ATTR_TYPE_UINT16,      0x0028, 0x0002, cluster_basic_read, NULL }, // VendorID
+    { 0, R | F,     ATTR_TYPE_UTF8_STRING, 0x0028, 0x0003, cluster_basic_read, NULL }, // ProductName
+    { 0, R | F,     ATTR_TYPE_UINT16,      0x0028, 0x0004, cluster_basic_read, NULL }, // ProductID
+    { 0, R | W,     ATTR_TYPE_UTF8_STRING, 0x0028, 0x0005, cluster_basic_read, cluster_basic_write }, // NodeLabel
+    { 0, R | W,     ATTR_TYPE_UTF8_STRING, 0x0028, 0x0006, cluster_basic_read, cluster_basic_write }, // Location
+    { 0, R | F,     ATTR_TYPE_UINT16,      0x0028, 0x0007, cluster_basic_read, NULL }, // HardwareVersion
+    { 0, R | F,     ATTR_TYPE_UINT32,      0x0028, 0x0009, cluster_basic_read, NULL }, // SoftwareVersion
+    { 0, R | F,     ATTR_TYPE_UTF8_STRING, 0x0028, 0x000A, cluster_basic_read, NULL }, // SoftwareVersionString
+
+    // Endpoint 0 - NetworkCommissioning (0x0031); Networks, LastNetworkID and
+    // LastConnectErrorValue have no value encoding yet
+    { 0, R | F,     ATTR_TYPE_UINT8,       0x0031, 0x0000, cluster_network_commissioning_read_attribute, NULL }, // MaxNetworks
+    { 0, R | F,     ATTR_TYPE_UINT8,       0x0031, 0x0002, cluster_network_commissioning_read_attribute, NULL }, // ScanMaxTimeSeconds
+    { 0, R | F,     ATTR_TYPE_UINT8,       0x0031, 0x0003, cluster_network_commissioning_read_attribute, NULL }, // ConnectMaxTimeSeconds
+    { 0, R,         ATTR_TYPE_BOOL,        0x0031, 0x0004, cluster_network_commissioning_read_attribute, NULL }, // InterfaceEnabled
+    { 0, R | N,     ATTR_TYPE_UINT8,       0x0031, 0x0005, cluster_network_commissioning_read_attribute, NULL }, // LastNetworkingStatus
+
+    // Endpoint 1 - OnOff (0x0006)
+    { 1, R,         ATTR_TYPE_BOOL,        0x0006, 0x0000, cluster_onoff_read, NULL }, // OnOff (flame)
+
+    // Endpoint 1 - LevelControl (0x0008)
+    { 1, R | N,     ATTR_TYPE_UINT8,       0x0008, 0x0000, cluster_level_control_read, NULL }, // CurrentLevel (fan)
+    { 1, R | F,     ATTR_TYPE_UINT8,       0x0008, 0x0002, cluster_level_control_read, NULL }, // MinLevel
+    { 1, R | F,     ATTR_TYPE_UINT8,       0x0008, 0x0003, cluster_level_control_read, NULL }, // MaxLevel
+
+    // Endpoint 1 - GeneralDiagnostics (0x0033)
+    { 1, R,         ATTR_TYPE_UINT8,       0x0033, 0x0001, cluster_diagnostics_read, NULL }, // NumberOfActiveFaults
+    { 1, 0,         ATTR_TYPE_UINT32,      0x0033, 0x0003, cluster_diagnostics_read, NULL }, // TotalOperationalHours (changes omitted)
+    { 1, R,         ATTR_TYPE_UINT8,       0x0033, 0x0005, cluster_diagnostics_read, NULL }, // DeviceEnabledState
+
+    // Endpoint 1 - TemperatureMeasurement (0x0402)
+    { 1, R | N,     ATTR_TYPE_INT16,       0x0402, 0x0000, cluster_temperature_read, NULL }, // MeasuredValue
+    { 1, R | F | N, ATTR_TYPE_INT16,       0x0402, 0x0001, cluster_temperature_read, NULL }, // MinMeasuredValue
+    { 1, R | F | N, ATTR_TYPE_INT16,       0x0402, 0x0002, cluster_temperature_read, NULL }, // MaxMeasuredValue
+    { 1, R | F,     ATTR_TYPE_UINT16,      0x0402, 0x0003, cluster_temperature_read, NULL }, // Tolerance
+};
+
+#undef R
+#undef F
+#undef N
+#undef L
+#undef W
+
+#define ATTRIBUTE_TABLE_COUNT (sizeof(attribute_table) / sizeof(attribute_table[0]))
+
+_Static_assert(ATTRIBUTE_TABLE_COUNT <= ATTRIBUTE_TABLE_MAX,
+               "attribute table exceeds attribute_mask_t");
+
+// Cluster instances: table index of each one's first attribute, and its
+// DataVersion.  Built from the table on first use.
+static uint8_t cluster_first[ATTRIBUTE_TABLE_MAX_CLUSTERS];
+static uint32_t cluster_version[ATTRIBUTE_TABLE_MAX_CLUSTERS];
+static uint8_t cluster_count = 0;
+
+/**
+ * Compare a table entry with (endpoint, cluster, attribute)
+ */
+static int compare_entry(const attribute_entry_t *e, uint8_t endpoint,
+                         uint32_t cluster_id, uint32_t attribute_id) {
+    if (e->endpoint != endpoint) {
+        return e->endpoint < endpoint ? -1 : 1;
+    }
+    if (e->cluster_id != cluster_id) {
+        return e->cluster_id < cluster_id ? -1 : 1;
+    }
+    if (e->attribute_id != attribute_id) {
+        return e->attribute_id < attribute_id ? -1 : 1;
+    }
+    return 0;
+}
+
+/**
+ * First index whose entry is >= (or, if upper, >) the given key
+ */
+static size_t table_bound(uint8_t endpoint, uint32_t cluster_id,
+                          uint32_t attribute_id, bool upper) {
+    size_t lo = 0;
+    size_t hi = ATTRIBUTE_TABLE_COUNT;
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int cmp = compare_entry(&attribute_table[mid], endpoint, cluster_id, attribute_id);
+        if (cmp < 0 || (upper && cmp == 0)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ * Index the cluster instances in the table
+ */
+static void index_clusters(void) {
+    cluster_count = 0;
+    for (size_t i = 0; i < ATTRIBUTE_TABLE_COUNT; i++) {
+        if (i == 0 || attribute_table[i].endpoint != attribute_table[i - 1].endpoint ||
+            attribute_table[i].cluster_id != attribute_table[i - 1].cluster_id) {
+            if (cluster_count >= ATTRIBUTE_TABLE_MAX_CLUSTERS) {
+                break;
+            }
+            cluster_first[cluster_count++] = (uint8_t)i;
+        }
+    }
+}
+
+/**
+ * Slot of a cluster instance, or -1
+ */
+static int cluster_slot(uint8_t endpoint, uint32_t cluster_id) {
+    if (cluster_count == 0) {
+        index_clusters();
+    }
+    
+    size_t first = table_bound(endpoint, cluster_id, 0, false);
+    if (first >= ATTRIBUTE_TABLE_COUNT || attribute_table[first].endpoint != endpoint ||
+        attribute_table[first].cluster_id != cluster_id) {
+        return -1;
+    }
+    
+    // cluster_first is sorted too
+    int lo = 0;
+    int hi = (int)cluster_count - 1;
+    while (lo <= hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (cluster_first[mid] == first) {
+            return mid;
+        }
+        if (cluster_first[mid] < first) {
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Initialize cluster DataVersions
+ */
+void attribute_table_init(uint32_t seed) {
+    index_clusters();
+    
+    // xorshift32 so every cluster starts somewhere different
+    uint32_t x = seed ? seed : 0x9E3779B9u;
+    for (uint8_t i = 0; i < cluster_count; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        cluster_version[i] = x;
+    }
+}
+
+/**
+ * Number of table entries
+ */
+size_t attribute_table_count(void) {
+    return ATTRIBUTE_TABLE_COUNT;
+}
+
+/**
+ * Get a table entry by index
+ */
+const attribute_entry_t *attribute_table_get(size_t index) {
+    if (index >= ATTRIBUTE_TABLE_COUNT) {
+        return NULL;
+    }
+    return &attribute_table[index];
+}
+
+/**
+ * Find a concrete attribute
+ */
+const attribute_entry_t *attribute_table_find(uint8_t endpoint, uint32_t cluster_id,
+                                              uint32_t attribute_id, size_t *index) {
+    size_t i = table_bound(endpoint, cluster_id, attribute_id, false);
+
+    if (i >= ATTRIBUTE_TABLE_COUNT ||
+        compare_entry(&attribute_table[i], endpoint, cluster_id, attribute_id) != 0) {
+        return NULL;
+    }
+    if (index) {
+        *index = i;
+    }
+    return &attribute_table[i];
+}
+
+/**
+ * Start expanding a path
+ */
+void attribute_table_iter_init(attribute_iter_t *it, const attribute_path_t *path) {
+    it->path = *path;
+    it->next = 0;
+    it->end = ATTRIBUTE_TABLE_COUNT;
+
+    if (path->wildcard & ATTR_PATH_WILDCARD_ENDPOINT) {
+        return; // Whole table
+    }
+
+    if (path->wildcard & ATTR_PATH_WILDCARD_CLUSTER) {
+        // All clusters of one endpoint
+        it->next = table_bound(path->endpoint, 0, 0, false);
+        it->end = table_bound(path->endpoint, UINT32_MAX, UINT32_MAX, true);
+    } else {
+        // One cluster (a concrete path is a single-attribute range)
+        it->next = table_bound(path->endpoint, path->cluster_id, 0, false);
+        it->end = table_bound(path->endpoint, path->cluster_id, UINT32_MAX, true);
+    }
+}
+
+/**
+ * Next attribute covered by the path
+ */
+const attribute_entry_t *attribute_table_iter_next(attribute_iter_t *it, size_t *index) {
+    while (it->next < it->end) {
+        size_t i = it->next++;
+        const attribute_entry_t *e = &attribute_table[i];
+
+        if (attribute_path_matches(&it->path, e->endpoint, e->cluster_id,
+                                   e->attribute_id)) {
+            if (index) {
+                *index = i;
+            }
+            return e;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Set of all attributes covered by a path
+ */
+attribute_mask_t attribute_table_match_mask(const attribute_path_t *path) {
+    attribute_iter_t it;
+    attribute_mask_t mask = 0;
+    size_t index;
+
+    attribute_table_iter_init(&it, path);
+    while (attribute_table_iter_next(&it, &index)) {
+        mask |= ATTRIBUTE_MASK_BIT(index);
+    }
+    return mask;
+}
+
+/**
+ * Look up a concrete attribute path
+ */
+im_status_code_t attribute_table_lookup(const attribute_path_t *path,
+                                        const attribute_entry_t **entry) {
+    *entry = attribute_table_find(path->endpoint, path->cluster_id,
+                                  path->attribute_id, NULL);
+    if (*entry) {
+        return IM_STATUS_SUCCESS;
+    }
+
+    // Say which part of the path the device does not have
+    size_t i = table_bound(path->endpoint, 0, 0, false);
+    if (i >= ATTRIBUTE_TABLE_COUNT || attribute_table[i].endpoint != path->endpoint) {
+        return IM_STATUS_UNSUPPORTED_ENDPOINT;
+    }
+    i = table_bound(path->endpoint, path->cluster_id, 0, false);
+    if (i >= ATTRIBUTE_TABLE_COUNT || attribute_table[i].endpoint != path->endpoint ||
+        attribute_table[i].cluster_id != path->cluster_id) {
+        return IM_STATUS_UNSUPPORTED_CLUSTER;
+    }
+    return IM_STATUS_UNSUPPORTED_ATTRIBUTE;
+}
+
+/**
+ * Read a concrete attribute through the table
+ */
+int attribute_table_read(const attribute_path_t *path,
+                         attribute_value_t *value, attribute_type_t *type,
+                         im_status_code_t *status) {
+    const attribute_entry_t *e;
+
+    *status = attribute_table_lookup(path, &e);
+    if (!e) {
+        return -1;
+    }
+
+    // List attributes only return their length so far, which cannot be
+    // encoded as the value
+    if (e->quality & ATTR_QUALITY_LIST) {
+        *status = IM_STATUS_FAILURE;
+        return -1;
+    }
+
+    if (e->read(path->endpoint, path->attribute_id, value, type) < 0) {
+        *status = IM_STATUS_FAILURE;
+        return -1;
+    }
+
+    *status = IM_STATUS_SUCCESS;
+    return 0;
+}
+
+/**
+ * Get the DataVersion of a cluster instance
+ */
+int attribute_table_get_data_version(uint8_t endpoint, uint32_t cluster_id,
+                                     uint32_t *version) {
+    int slot = cluster_slot(endpoint, cluster_id);
+    
+    if (slot < 0) {
+        return -1;
+    }
+    if (version) {
+        *version = cluster_version[slot];
+    }
+    return 0;
+}
+
+/**
+ * Bump the DataVersion of a cluster instance
+ */
+int attribute_table_bump_data_version(uint8_t endpoint, uint32_t cluster_id) {
+    int slot = cluster_slot(endpoint, cluster_id);
+    
+    if (slot < 0) {
+        return -1;
+    }
+    cluster_version[slot]++;
+    return 0;
+}
@@ -0,0 +1,191 @@
+/*
+ * attribute_table.h
+ * Sorted index of every attribute the device serves
+ *
+ * One const table (in flash) lists each endpoint / cluster / attribute
+ * with its type, quality flags and the cluster read function, sorted by
+ * (endpoint, cluster, attribute).  Concrete paths are found by binary
+ * search; wildcard paths expand by walking the matching range.  The table
+ * index doubles as a compact attribute ID: subscriptions keep their
+ * interest and dirty sets as attribute_mask_t bitmaps over it.
+ *
+ * Each endpoint / cluster also has a DataVersion, started at a random
+ * value on boot and bumped whenever one of its attribute values changes,
+ * so a controller can skip clusters it already has (DataVersionFilter).
+ *
+ * Add new attributes to the table in attribute_table.c, keeping it sorted
+ * (tests/interaction/test_attribute_table.c checks the order).
+ */
+
+#ifndef ATTRIBUTE_TABLE_H
+#define ATTRIBUTE_TABLE_H
+
+#include "interaction_model.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Attribute quality flags
+ */
+#define ATTR_QUALITY_REPORTABLE     0x01    // Changes are reported to subscribers
+#define ATTR_QUALITY_FIXED          0x02    // Value never changes at runtime
+#define ATTR_QUALITY_NULLABLE       0x04    // Value may be null
+#define ATTR_QUALITY_LIST           0x08    // List value
+#define ATTR_QUALITY_WRITABLE       0x10    // Accepts WriteRequests (has a write function)
+
+/**
+ * Maximum number of table entries (one bit each in attribute_mask_t)
+ */
+#define ATTRIBUTE_TABLE_MAX         64
+
+/**
+ * Maximum number of distinct endpoint / cluster pairs in the table
+ */
+#define ATTRIBUTE_TABLE_MAX_CLUSTERS 16
+
+/**
+ * Set of attributes, one bit per table index
+ */
+typedef uint64_t attribute_mask_t;
+
+#define ATTRIBUTE_MASK_BIT(index)   ((attribute_mask_t)1 << (index))
+
+/**
+ * Cluster attribute read function
+ *
+ * @return 0 on success, -1 if the attribute cannot be read
+ */
+typedef int (*attribute_read_fn)(uint8_t endpoint, uint32_t attr_id,
+                                 attribute_value_t *value, attribute_type_t *type);
+
+/**
+ * Cluster attribute write function
+ * String values point into the request and must be copied.
+ *
+ * @return IM_STATUS_SUCCESS, or why the value was refused
+ *         (e.g. IM_STATUS_CONSTRAINT_ERROR)
+ */
+typedef im_status_code_t (*attribute_write_fn)(uint8_t endpoint, uint32_t attr_id,
+                                               const attribute_value_t *value);
+
+/**
+ * Attribute table entry
+ */
+typedef struct {
+    uint8_t endpoint;
+    uint8_t quality;                // ATTR_QUALITY_* flags
+    uint8_t type;                   // attribute_type_t
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    attribute_read_fn read;
+    attribute_write_fn write;       // ATTR_QUALITY_WRITABLE entries only
+} attribute_entry_t;
+
+/**
+ * Wildcard expansion state
+ */
+typedef struct {
+    attribute_path_t path;
+    size_t next;                    // Next table index to examine
+    size_t end;                     // One past the last candidate
+} attribute_iter_t;
+
+/**
+ * Initialize cluster DataVersions
+ * Versions start from values derived from seed (a random number on the
+ * device), so a controller's cached version from before a reboot does not
+ * match by accident.
+ * 
+ * @param seed Random seed
+ */
+void attribute_table_init(uint32_t seed);
+
+/**
+ * Number of table entries
+ */
+size_t attribute_table_count(void);
+
+/**
+ * Get a table entry by index
+ *
+ * @return Entry, or NULL if index is out of range
+ */
+const attribute_entry_t *attribute_table_get(size_t index);
+
+/**
+ * Find a concrete attribute (binary search)
+ *
+ * @param index Set to the entry's table index if found (may be NULL)
+ * @return Entry, or NULL if the device has no such attribute
+ */
+const attribute_entry_t *attribute_table_find(uint8_t endpoint, uint32_t cluster_id,
+                                              uint32_t attribute_id, size_t *index);
+
+/**
+ * Start expanding a (possibly wildcard) path
+ * A concrete endpoint, or endpoint and cluster, narrows the walk to that
+ * range of the table.
+ */
+void attribute_table_iter_init(attribute_iter_t *it, const attribute_path_t *path);
+
+/**
+ * Next attribute covered by the path, in table order
+ *
+ * @param index Set to the entry's table index (may be NULL)
+ * @return Entry, or NULL when the expansion is complete
+ */
+const attribute_entry_t *attribute_table_iter_next(attribute_iter_t *it, size_t *index);
+
+/**
+ * Set of all attributes covered by a (possibly wildcard) path
+ */
+attribute_mask_t attribute_table_match_mask(const attribute_path_t *path);
+
+/**
+ * Look up a concrete attribute path
+ *
+ * @param entry Set to the entry, or NULL if the device has no such attribute
+ * @return IM_STATUS_SUCCESS, or which part of the path is missing:
+ *         unsupported endpoint, cluster or attribute
+ */
+im_status_code_t attribute_table_lookup(const attribute_path_t *path,
+                                        const attribute_entry_t **entry);
+
+/**
+ * Read a concrete attribute through the table
+ * On failure status says why: unsupported endpoint, cluster or attribute,
+ * or FAILURE if the value cannot be encoded (lists).
+ *
+ * @return 0 on success, -1 on failure
+ */
+int attribute_table_read(const attribute_path_t *path,
+                         attribute_value_t *value, attribute_type_t *type,
+                         im_status_code_t *status);
+
+/**
+ * Get the DataVersion of a cluster instance
+ * 
+ * @param version Set to the current DataVersion
+ * @return 0 on success, -1 if the endpoint has no such cluster
+ */
+int attribute_table_get_data_version(uint8_t endpoint, uint32_t cluster_id,
+                                     uint32_t *version);
+
+/**
+ * Bump the DataVersion of a cluster instance
+ * Called when one of the cluster's attribute values changes.
+ * 
+ * @return 0 on success, -1 if the endpoint has no such cluster
+ */
+int attribute_table_bump_data_version(uint8_t endpoint, uint32_t cluster_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ATTRIBUTE_TABLE_H
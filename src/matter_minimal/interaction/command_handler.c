@@ -0,0 +1,548 @@
+/*
+ * command_handler.c
+ * Matter InvokeRequest/InvokeResponse interaction handler implementation
+ */
+
+#include "command_handler.h"
+#include "attribute_table.h"
+#include "../codec/tlv.h"
+#include <string.h>
+
+// Cluster invoke functions (clusters/)
+extern im_status_code_t cluster_general_commissioning_invoke(command_context_t *ctx);
+extern im_status_code_t cluster_operational_credentials_invoke(command_context_t *ctx);
+extern im_status_code_t cluster_onoff_invoke(command_context_t *ctx);
+extern im_status_code_t cluster_level_control_invoke(command_context_t *ctx);
+
+#define NONE    COMMAND_NO_RESPONSE
+#define CASE    COMMAND_FLAG_CASE
+
+/*
+ * Sorted by endpoint, then cluster, then command.
+ * Endpoint 0: Root Node.  Endpoint 1: Viking Bio burner.
+ */
+static const command_entry_t command_table[] = {
+    // Endpoint 0 - GeneralCommissioning (0x0030)
+    { 0, 0, 0x0030, 0x0000, 0x0001, cluster_general_commissioning_invoke },  // ArmFailSafe
+    { 0, 0, 0x0030, 0x0004, 0x0005, cluster_general_commissioning_invoke },  // CommissioningComplete
+
+    // Endpoint 0 - OperationalCredentials (0x003E)
+    { 0, 0, 0x003E, 0x0006, 0x0008, cluster_operational_credentials_invoke }, // AddNOC -> NOCResponse
+    { 0, 0, 0x003E, 0x000B, NONE,   cluster_operational_credentials_invoke }, // AddTrustedRootCertificate
+
+    // Endpoint 1 - OnOff (0x0006): burner enable, operational nodes only
+    { 1, CASE, 0x0006, 0x0000, NONE, cluster_onoff_invoke },                  // Off
+    { 1, CASE, 0x0006, 0x0001, NONE, cluster_onoff_invoke },                  // On
+    { 1, CASE, 0x0006, 0x0002, NONE, cluster_onoff_invoke },                  // Toggle
+
+    // Endpoint 1 - LevelControl (0x0008): burner power setpoint, operational nodes only
+    { 1, CASE, 0x0008, 0x0000, NONE, cluster_level_control_invoke },          // MoveToLevel
+    { 1, CASE, 0x0008, 0x0004, NONE, cluster_level_control_invoke },          // MoveToLevelWithOnOff
+};
+
+#undef NONE
+#undef CASE
+
+#define COMMAND_TABLE_COUNT (sizeof(command_table) / sizeof(command_table[0]))
+
+/*
+ * Command of an InvokeRequest, collected before any is invoked so that the
+ * request's flags are known first
+ */
+typedef struct {
+    uint8_t endpoint;
+    bool wildcard_endpoint;         // Endpoint omitted: every endpoint with the command
+    uint32_t cluster_id;
+    uint32_t command_id;
+    tlv_reader_t fields;
+    bool has_fields;
+} invoke_command_t;
+
+/**
+ * Compare a table entry with (endpoint, cluster, command)
+ */
+static int compare_entry(const command_entry_t *e, uint8_t endpoint,
+                         uint32_t cluster_id, uint32_t command_id) {
+    if (e->endpoint != endpoint) {
+        return e->endpoint < endpoint ? -1 : 1;
+    }
+    if (e->cluster_id != cluster_id) {
+        return e->cluster_id < cluster_id ? -1 : 1;
+    }
+    if (e->command_id != command_id) {
+        return e->command_id < command_id ? -1 : 1;
+    }
+    return 0;
+}
+
+/**
+ * First index whose entry is >= the given key
+ */
+static size_t table_lower_bound(uint8_t endpoint, uint32_t cluster_id, uint32_t command_id) {
+    size_t lo = 0;
+    size_t hi = COMMAND_TABLE_COUNT;
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (compare_entry(&command_table[mid], endpoint, cluster_id, command_id) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/**
+ * Check whether the device has an endpoint, or a cluster on it, in either
+ * the command table or the attribute table
+ */
+static bool has_instance(uint8_t endpoint, uint32_t cluster_id, bool any_cluster) {
+    size_t i = table_lower_bound(endpoint, any_cluster ? 0 : cluster_id, 0);
+    if (i < COMMAND_TABLE_COUNT && command_table[i].endpoint == endpoint &&
+        (any_cluster || command_table[i].cluster_id == cluster_id)) {
+        return true;
+    }
+
+    attribute_path_t path = { endpoint, cluster_id, 0, ATTR_PATH_WILDCARD_ATTRIBUTE };
+    attribute_iter_t it;
+    if (any_cluster) {
+        path.wildcard |= ATTR_PATH_WILDCARD_CLUSTER;
+    }
+    attribute_table_iter_init(&it, &path);
+    return attribute_table_iter_next(&it, NULL) != NULL;
+}
+
+size_t command_handler_count(void) {
+    return COMMAND_TABLE_COUNT;
+}
+
+const command_entry_t *command_handler_get(size_t index) {
+    return index < COMMAND_TABLE_COUNT ? &command_table[index] : NULL;
+}
+
+const command_entry_t *command_handler_find(uint8_t endpoint, uint32_t cluster_id,
+                                            uint32_t command_id, im_status_code_t *status) {
+    size_t i = table_lower_bound(endpoint, cluster_id, command_id);
+
+    if (i < COMMAND_TABLE_COUNT &&
+        compare_entry(&command_table[i], endpoint, cluster_id, command_id) == 0) {
+        return &command_table[i];
+    }
+
+    if (status) {
+        // Say which part of the path the device does not have
+        if (!has_instance(endpoint, 0, true)) {
+            *status = IM_STATUS_UNSUPPORTED_ENDPOINT;
+        } else if (!has_instance(endpoint, cluster_id, false)) {
+            *status = IM_STATUS_UNSUPPORTED_CLUSTER;
+        } else {
+            *status = IM_STATUS_UNSUPPORTED_COMMAND;
+        }
+    }
+    return NULL;
+}
+
+static bool is_container(const tlv_element_t *element) {
+    return element->type == TLV_TYPE_STRUCTURE || element->type == TLV_TYPE_ARRAY ||
+           element->type == TLV_TYPE_LIST;
+}
+
+/**
+ * Find a field of the command being invoked
+ */
+int command_handler_get_field(const command_context_t *ctx, uint8_t tag,
+                              tlv_element_t *element) {
+    if (!ctx || !element || !ctx->has_fields) {
+        return -1;
+    }
+
+    // Fields are read from a copy, so handlers can look them up in any order
+    tlv_reader_t reader = ctx->fields;
+    while (tlv_reader_next(&reader, element) == 0) {
+        if (element->type == TLV_TYPE_END_OF_CONTAINER) {
+            return -1;
+        }
+        if (element->tag_type == TLV_TAG_CONTEXT_SPECIFIC && element->tag == tag) {
+            return 0;
+        }
+        if (is_container(element) && tlv_reader_exit_container(&reader) < 0) {
+            return -1;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Parse a CommandDataIB
+ * CommandDataIB ::= {
+ *   CommandPath [0]: { Endpoint [0], Cluster [1], Command [2] }
+ *   CommandFields [1]: structure (optional)
+ * }
+ */
+static int parse_command_data(tlv_reader_t *reader, invoke_command_t *cmd) {
+    tlv_element_t element;
+    uint8_t found = 0;  // bit 0 cluster, bit 1 command
+
+    memset(cmd, 0, sizeof(*cmd));
+    cmd->wildcard_endpoint = true;
+
+    while (tlv_reader_next(reader, &element) == 0) {
+        if (element.type == TLV_TYPE_END_OF_CONTAINER) {
+            return found == 0x03 ? 0 : -1;
+        }
+
+        if (element.tag == 0 && (element.type == TLV_TYPE_LIST ||
+                                 element.type == TLV_TYPE_STRUCTURE)) {
+            while (tlv_reader_next(reader, &element) == 0 &&
+                   element.type != TLV_TYPE_END_OF_CONTAINER) {
+                if (is_container(&element)) {
+                    return -1;
+                }
+                switch (element.tag) {
+                    case 0: // Endpoint
+                        cmd->endpoint = tlv_read_uint8(&element);
+                        cmd->wildcard_endpoint = false;
+                        break;
+                    case 1: // Cluster ID
+                        cmd->cluster_id = element.value.u32;
+                        found |= 0x01;
+                        break;
+                    case 2: // Command ID
+                        cmd->command_id = element.value.u32;
+                        found |= 0x02;
+                        break;
+                    default:
+                        break;
+                }
+            }
+        } else if (element.tag == 1 && element.type == TLV_TYPE_STRUCTURE) {
+            // Handlers read the fields later from here
+            cmd->fields = *reader;
+            cmd->has_fields = true;
+            if (tlv_reader_exit_container(reader) < 0) {
+                return -1;
+            }
+        } else if (is_container(&element) && tlv_reader_exit_container(reader) < 0) {
+            return -1;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Encode a CommandPath
+ */
+static int encode_command_path(tlv_writer_t *writer, uint8_t endpoint,
+                               uint32_t cluster_id, uint32_t command_id) {
+    if (tlv_encode_list_start(writer, 0) < 0 ||
+        tlv_encode_uint8(writer, 0, endpoint) < 0 ||
+        tlv_encode_uint32(writer, 1, cluster_id) < 0 ||
+        tlv_encode_uint32(writer, 2, command_id) < 0 ||
+        tlv_encode_container_end(writer) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Encode an InvokeResponseIB holding a CommandStatus
+ * InvokeResponseIB ::= { Status [1]: { CommandPath [0], Status [1]: { Status [0] } } }
+ */
+static int encode_command_status(tlv_writer_t *writer, uint8_t endpoint,
+                                 uint32_t cluster_id, uint32_t command_id,
+                                 im_status_code_t status) {
+    if (tlv_encode_structure_start(writer, 0xFF) < 0 ||
+        tlv_encode_structure_start(writer, 1) < 0 ||
+        encode_command_path(writer, endpoint, cluster_id, command_id) < 0 ||
+        tlv_encode_structure_start(writer, 1) < 0 ||
+        tlv_encode_uint8(writer, 0, (uint8_t)status) < 0 ||
+        tlv_encode_container_end(writer) < 0 ||
+        tlv_encode_container_end(writer) < 0 ||
+        tlv_encode_container_end(writer) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Encode the start of an InvokeResponseIB holding a response command, up to
+ * its CommandFields
+ * InvokeResponseIB ::= { Command [0]: { CommandPath [0], CommandFields [1] } }
+ */
+static int encode_response_start(tlv_writer_t *writer, uint8_t endpoint,
+                                 uint32_t cluster_id, uint32_t response_id) {
+    if (tlv_encode_structure_start(writer, 0xFF) < 0 ||
+        tlv_encode_structure_start(writer, 0) < 0 ||
+        encode_command_path(writer, endpoint, cluster_id, response_id) < 0 ||
+        tlv_encode_structure_start(writer, 1) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Space the InvokeResponseIB of one concrete command may take: its
+ * CommandStatus, or its response command with COMMAND_RESPONSE_FIELDS_MAX
+ * bytes of fields, whichever is larger
+ */
+static size_t response_reserve(const invoke_command_t *cmd, uint8_t endpoint) {
+    uint8_t scratch[64];
+    tlv_writer_t writer;
+    size_t reserve;
+    const command_entry_t *entry = command_handler_find(endpoint, cmd->cluster_id,
+                                                        cmd->command_id, NULL);
+
+    tlv_writer_init(&writer, scratch, sizeof(scratch));
+    encode_command_status(&writer, endpoint, cmd->cluster_id, cmd->command_id,
+                          IM_STATUS_SUCCESS);
+    reserve = writer.offset;
+
+    if (entry && entry->response_id != COMMAND_NO_RESPONSE) {
+        tlv_writer_init(&writer, scratch, sizeof(scratch));
+        encode_response_start(&writer, endpoint, cmd->cluster_id, entry->response_id);
+        // Fields, then the ends of CommandFields, Command and InvokeResponseIB
+        size_t response = writer.offset + COMMAND_RESPONSE_FIELDS_MAX + 3;
+        if (response > reserve) {
+            reserve = response;
+        }
+    }
+    return reserve;
+}
+
+/**
+ * Space all InvokeResponseIBs of a command may take (every endpoint with it
+ * if the endpoint was omitted)
+ */
+static size_t command_reserve(const invoke_command_t *cmd) {
+    size_t reserve = 0;
+
+    if (!cmd->wildcard_endpoint) {
+        return response_reserve(cmd, cmd->endpoint);
+    }
+    for (size_t i = 0; i < COMMAND_TABLE_COUNT; i++) {
+        const command_entry_t *e = &command_table[i];
+        if (e->cluster_id == cmd->cluster_id && e->command_id == cmd->command_id) {
+            reserve += response_reserve(cmd, e->endpoint);
+        }
+    }
+    return reserve;
+}
+
+/**
+ * Invoke one concrete command and encode its InvokeResponseIB
+ * InvokeResponseIB ::= { Command [0]: { CommandPath [0], CommandFields [1] } }
+ * for a response command, otherwise a CommandStatus.
+ */
+static int invoke_command_in(tlv_writer_t *writer, const invoke_command_t *cmd,
+                             uint8_t endpoint, bool timed, uint8_t auth_mode,
+                             uint32_t now_ms) {
+    im_status_code_t status = IM_STATUS_SUCCESS;
+    const command_entry_t *entry = command_handler_find(endpoint, cmd->cluster_id,
+                                                        cmd->command_id, &status);
+
+    if (entry && (entry->flags & COMMAND_FLAG_CASE) && auth_mode != IM_AUTH_CASE) {
+        status = IM_STATUS_UNSUPPORTED_ACCESS;
+    } else if (entry && (entry->flags & COMMAND_FLAG_TIMED) && !timed) {
+        status = IM_STATUS_NEEDS_TIMED_INTERACTION;
+    } else if (entry) {
+        command_context_t ctx;
+        size_t start = writer->offset;
+
+        ctx.endpoint = endpoint;
+        ctx.cluster_id = cmd->cluster_id;
+        ctx.command_id = cmd->command_id;
+        ctx.fields = cmd->fields;
+        ctx.has_fields = cmd->has_fields;
+        ctx.response = NULL;
+        ctx.auth_mode = auth_mode;
+        ctx.now_ms = now_ms;
+
+        if (entry->response_id == COMMAND_NO_RESPONSE) {
+            status = entry->invoke(&ctx);
+        } else {
+            if (encode_response_start(writer, endpoint, cmd->cluster_id,
+                                      entry->response_id) < 0) {
+                return -1;
+            }
+
+            ctx.response = writer;
+            status = entry->invoke(&ctx);
+            if (status == IM_STATUS_SUCCESS) {
+                // End CommandFields, Command and InvokeResponseIB
+                if (tlv_encode_container_end(writer) < 0 ||
+                    tlv_encode_container_end(writer) < 0 ||
+                    tlv_encode_container_end(writer) < 0) {
+                    return -1;
+                }
+                return 0;
+            }
+
+            // Drop the partial response command, answer with the status
+            writer->offset = start;
+        }
+    }
+
+    return encode_command_status(writer, endpoint, cmd->cluster_id, cmd->command_id, status);
+}
+
+/**
+ * Invoke one concrete command within the space reserved for it
+ * A response that outgrows the reserve fails on its own and is answered
+ * with a status, leaving the space of later commands untouched.
+ */
+static int invoke_command(tlv_writer_t *writer, const invoke_command_t *cmd,
+                          uint8_t endpoint, bool timed, uint8_t auth_mode,
+                          uint32_t now_ms) {
+    size_t buffer_size = writer->buffer_size;
+    size_t limit = writer->offset + response_reserve(cmd, endpoint);
+
+    if (limit < buffer_size) {
+        writer->buffer_size = limit;
+    }
+    int ret = invoke_command_in(writer, cmd, endpoint, timed, auth_mode, now_ms);
+    writer->buffer_size = buffer_size;
+    return ret;
+}
+
+/**
+ * Invoke a command on every endpoint that has it (endpoint omitted)
+ * Paths without the command are left out, as for wildcard reads.
+ */
+static int invoke_wildcard(tlv_writer_t *writer, const invoke_command_t *cmd,
+                           bool timed, uint8_t auth_mode, uint32_t now_ms) {
+    for (size_t i = 0; i < COMMAND_TABLE_COUNT; i++) {
+        const command_entry_t *e = &command_table[i];
+        if (e->cluster_id == cmd->cluster_id && e->command_id == cmd->command_id &&
+            invoke_command(writer, cmd, e->endpoint, timed, auth_mode, now_ms) < 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Process an InvokeRequest message
+ */
+int command_handler_process_request(const uint8_t *request_tlv, size_t request_len,
+                                    bool timed, uint8_t auth_mode, uint32_t now_ms,
+                                    uint8_t *response_tlv, size_t max_response_len,
+                                    size_t *actual_len, bool *suppress,
+                                    im_status_code_t *status) {
+    invoke_command_t commands[MAX_INVOKE_COMMANDS];
+    size_t command_count = 0;
+    bool timed_request = false;
+    tlv_reader_t reader;
+    tlv_writer_t writer;
+    tlv_element_t element;
+
+    if (!request_tlv || !response_tlv || !actual_len || !suppress || !status ||
+        max_response_len < 1) {
+        return -1;
+    }
+
+    *suppress = false;
+    if (auth_mode == IM_AUTH_NONE) {
+        *status = IM_STATUS_UNSUPPORTED_ACCESS;
+        return -1;
+    }
+    *status = IM_STATUS_INVALID_ACTION;
+
+    // InvokeRequest ::= {
+    //   SuppressResponse [0]: bool
+    //   TimedRequest [1]: bool
+    //   InvokeRequests [2]: Array of CommandDataIB
+    // }
+    tlv_reader_init(&reader, request_tlv, request_len);
+    if (tlv_reader_peek(&reader, &element) == 0 &&
+        element.type == TLV_TYPE_STRUCTURE &&
+        (element.tag_type == TLV_TAG_ANONYMOUS || element.tag == 0xFF)) {
+        tlv_reader_skip(&reader);
+    }
+
+    while (tlv_reader_next(&reader, &element) == 0) {
+        if (element.type == TLV_TYPE_END_OF_CONTAINER) {
+            break;
+        }
+
+        if (element.tag == 0 && element.type == TLV_TYPE_BOOL) {
+            *suppress = element.value.boolean;
+        } else if (element.tag == 1 && element.type == TLV_TYPE_BOOL) {
+            timed_request = element.value.boolean;
+        } else if (element.tag == 2 && element.type == TLV_TYPE_ARRAY) {
+            while (tlv_reader_next(&reader, &element) == 0 &&
+                   element.type != TLV_TYPE_END_OF_CONTAINER) {
+                if (element.type != TLV_TYPE_STRUCTURE) {
+                    if (is_container(&element) && tlv_reader_exit_container(&reader) < 0) {
+                        return -1;
+                    }
+                    continue;
+                }
+                if (command_count >= MAX_INVOKE_COMMANDS) {
+                    *status = IM_STATUS_RESOURCE_EXHAUSTED;
+                    return -1;
+                }
+                if (parse_command_data(&reader, &commands[command_count]) < 0) {
+                    return -1;
+                }
+                command_count++;
+            }
+        } else if (is_container(&element) && tlv_reader_exit_container(&reader) < 0) {
+            return -1;
+        }
+    }
+
+    if (command_count == 0) {
+        return -1;
+    }
+
+    // The TimedRequest flag must say whether a TimedRequest came first
+    if (timed_request != timed) {
+        *status = IM_STATUS_TIMED_REQUEST_MISMATCH;
+        return -1;
+    }
+
+    // InvokeResponse ::= {
+    //   SuppressResponse [0]: bool
+    //   InvokeResponses [1]: Array of InvokeResponseIB
+    // }
+    // The end of the array is kept free while commands are encoded
+    tlv_writer_init(&writer, response_tlv, max_response_len - 1);
+    if (tlv_encode_bool(&writer, 0, false) < 0 ||
+        tlv_encode_array_start(&writer, 1) < 0) {
+        *status = IM_STATUS_RESOURCE_EXHAUSTED;
+        return -1;
+    }
+
+    // Every response is given room before any command runs, so a request
+    // whose responses cannot fit is refused with nothing invoked
+    size_t reserve = 0;
+    for (size_t i = 0; i < command_count; i++) {
+        reserve += command_reserve(&commands[i]);
+    }
+    if (writer.offset + reserve > writer.buffer_size) {
+        *status = IM_STATUS_RESOURCE_EXHAUSTED;
+        return -1;
+    }
+
+    for (size_t i = 0; i < command_count; i++) {
+        const invoke_command_t *cmd = &commands[i];
+        int ret = cmd->wildcard_endpoint ?
+                  invoke_wildcard(&writer, cmd, timed, auth_mode, now_ms) :
+                  invoke_command(&writer, cmd, cmd->endpoint, timed, auth_mode, now_ms);
+        if (ret < 0) {
+            *status = IM_STATUS_RESOURCE_EXHAUSTED;
+            return -1;
+        }
+    }
+
+    writer.buffer_size = max_response_len;
+    if (tlv_encode_container_end(&writer) < 0) {
+        *status = IM_STATUS_RESOURCE_EXHAUSTED;
+        return -1;
+    }
+
+    *actual_len = tlv_writer_get_length(&writer);
+    *status = IM_STATUS_SUCCESS;
+    return 0;
+}
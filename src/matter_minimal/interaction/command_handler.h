@@ -0,0 +1,158 @@
+/*
+ * command_handler.h
+ * Matter InvokeRequest/InvokeResponse interaction handler
+ * Based on Matter Core Specification Section 8.8
+ *
+ * One const table (in flash) maps each endpoint / cluster / command the
+ * device accepts to the cluster's invoke function, sorted by
+ * (endpoint, cluster, command) and searched like the attribute table.
+ * The dispatcher parses the InvokeRequest, calls the handler for each
+ * CommandDataIB and encodes an InvokeResponseIB for it: the response
+ * command's fields when the handler succeeds and the command has one,
+ * otherwise a CommandStatus.
+ *
+ * Add new commands to the table in command_handler.c, keeping it sorted
+ * (tests/interaction/test_command_handler.c checks the order).
+ */
+
+#ifndef COMMAND_HANDLER_H
+#define COMMAND_HANDLER_H
+
+#include "interaction_model.h"
+#include "../codec/tlv_types.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Command flags
+ */
+#define COMMAND_FLAG_TIMED          0x01    // Only accepted in a timed interaction
+#define COMMAND_FLAG_CASE           0x02    // Only accepted over a CASE session
+
+/**
+ * Response command ID of commands answered with a status only
+ */
+#define COMMAND_NO_RESPONSE         0xFFFFFFFFu
+
+/**
+ * Maximum number of commands in a single InvokeRequest
+ */
+#ifndef MAX_INVOKE_COMMANDS
+#define MAX_INVOKE_COMMANDS 4
+#endif
+
+/**
+ * Room kept for the fields of each response command
+ * Cluster invoke functions must encode their response fields within it.
+ */
+#ifndef COMMAND_RESPONSE_FIELDS_MAX
+#define COMMAND_RESPONSE_FIELDS_MAX 16
+#endif
+
+/**
+ * Command being invoked
+ */
+typedef struct {
+    uint8_t endpoint;
+    uint32_t cluster_id;
+    uint32_t command_id;
+    tlv_reader_t fields;            // Positioned inside CommandFields
+    bool has_fields;                // False if the request had no CommandFields
+    tlv_writer_t *response;         // Response command's fields (inside its CommandFields)
+    uint8_t auth_mode;              // IM_AUTH_* of the request's session
+    uint32_t now_ms;                // Current time in milliseconds
+} command_context_t;
+
+/**
+ * Cluster invoke function
+ * Reads the command's fields from ctx->fields (command_handler_get_field())
+ * and, for commands with a response command, encodes the response fields
+ * into ctx->response.  Response fields are discarded unless it returns
+ * IM_STATUS_SUCCESS.
+ *
+ * @return Status of the command
+ */
+typedef im_status_code_t (*command_invoke_fn)(command_context_t *ctx);
+
+/**
+ * Command table entry
+ */
+typedef struct {
+    uint8_t endpoint;
+    uint8_t flags;                  // COMMAND_FLAG_* flags
+    uint32_t cluster_id;
+    uint32_t command_id;
+    uint32_t response_id;           // Response command, or COMMAND_NO_RESPONSE
+    command_invoke_fn invoke;
+} command_entry_t;
+
+/**
+ * Number of table entries
+ */
+size_t command_handler_count(void);
+
+/**
+ * Get a table entry by index
+ *
+ * @return Entry, or NULL if index is out of range
+ */
+const command_entry_t *command_handler_get(size_t index);
+
+/**
+ * Find a command (binary search)
+ *
+ * @param status Set to why the command was not found (may be NULL):
+ *               unsupported endpoint, cluster or command
+ * @return Entry, or NULL if the device has no such command
+ */
+const command_entry_t *command_handler_find(uint8_t endpoint, uint32_t cluster_id,
+                                            uint32_t command_id, im_status_code_t *status);
+
+/**
+ * Find a field of the command being invoked
+ *
+ * @param ctx Command context
+ * @param tag Context tag of the field
+ * @param element Set to the field; containers are returned as their start
+ * @return 0 if found, -1 if the command has no such field
+ */
+int command_handler_get_field(const command_context_t *ctx, uint8_t tag,
+                              tlv_element_t *element);
+
+/**
+ * Process an InvokeRequest message
+ * A request whose TimedRequest flag does not match timed, that cannot be
+ * parsed, or that arrived on the unsecured session is answered with a
+ * StatusResponse instead (status is set and -1 returned), as is one whose
+ * responses would not fit in max_response_len (RESOURCE_EXHAUSTED); both are
+ * detected before any command is invoked.  Commands flagged
+ * COMMAND_FLAG_CASE get UNSUPPORTED_ACCESS unless auth_mode is IM_AUTH_CASE.
+ *
+ * @param request_tlv Input TLV-encoded InvokeRequest
+ * @param request_len Length of request
+ * @param timed True if the request follows a TimedRequest on its exchange
+ * @param auth_mode IM_AUTH_* of the session the request arrived on
+ * @param now_ms Current time in milliseconds
+ * @param response_tlv Output buffer for TLV-encoded InvokeResponse
+ * @param max_response_len Maximum size of response buffer
+ * @param actual_len Pointer to store actual response length
+ * @param suppress Set when the request asked for no response
+ * @param status Set to the StatusResponse status on failure
+ * @return 0 on success, -1 on failure
+ */
+int command_handler_process_request(const uint8_t *request_tlv, size_t request_len,
+                                    bool timed, uint8_t auth_mode, uint32_t now_ms,
+                                    uint8_t *response_tlv, size_t max_response_len,
+                                    size_t *actual_len, bool *suppress,
+                                    im_status_code_t *status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // COMMAND_HANDLER_H
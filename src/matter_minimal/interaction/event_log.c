@@ -0,0 +1,347 @@
+/*
+ * event_log.c
+ * Matter event log implementation
+ */
+
+#include "event_log.h"
+#include "subscribe_handler.h"
+#include <string.h>
+#include <stdio.h>
+
+/* Platform storage functions */
+extern int storage_adapter_write(const char *key, const uint8_t *value, size_t value_len);
+extern int storage_adapter_read(const char *key, uint8_t *value, size_t max_value_len, size_t *actual_len);
+
+/* Persisted critical log layout version */
+#define EVENT_LOG_VERSION   2
+
+/**
+ * One logged event: what reports filter on, and its encoded EventDataIB
+ */
+typedef struct {
+    uint64_t number;
+    uint32_t cluster_id;
+    uint32_t event_id;
+    uint8_t endpoint;
+    uint8_t len;                            // Encoded length
+    uint8_t data[EVENT_LOG_MAX_EVENT_LEN];  // EventData [1] structure
+} event_record_t;
+
+/**
+ * Ring of one priority's events
+ */
+typedef struct {
+    event_record_t *records;
+    uint8_t capacity;
+    uint8_t head;                           // Oldest event
+    uint8_t count;
+} event_ring_t;
+
+/**
+ * Critical events, kept in the layout they are saved in
+ */
+typedef struct {
+    uint32_t version;
+    uint8_t head;
+    uint8_t count;
+    event_record_t records[EVENT_LOG_CRITICAL_SLOTS];
+} critical_store_t;
+
+static event_record_t debug_records[EVENT_LOG_DEBUG_SLOTS];
+static event_record_t info_records[EVENT_LOG_INFO_SLOTS];
+static critical_store_t critical_store;
+
+static event_ring_t rings[EVENT_PRIORITY_COUNT] = {
+    { debug_records, EVENT_LOG_DEBUG_SLOTS, 0, 0 },
+    { info_records, EVENT_LOG_INFO_SLOTS, 0, 0 },
+    { critical_store.records, EVENT_LOG_CRITICAL_SLOTS, 0, 0 },
+};
+
+// Event being encoded; copied into its ring once it is complete
+static event_record_t scratch;
+
+static uint64_t next_number = 0;
+static uint64_t number_limit = 0;          // End of the reserved number block
+static bool initialized = false;
+
+// SystemTimestamp: milliseconds since boot, extended past the 32-bit wrap
+static uint64_t system_time_ms = 0;
+static uint32_t last_now_ms = 0;
+
+static inline const event_record_t *ring_at(const event_ring_t *ring, uint8_t i) {
+    return &ring->records[(ring->head + i) % ring->capacity];
+}
+
+static void persist_critical(void) {
+#ifdef EVENT_LOG_PERSIST
+    critical_store.version = EVENT_LOG_VERSION;
+    critical_store.head = rings[EVENT_PRIORITY_CRITICAL].head;
+    critical_store.count = rings[EVENT_PRIORITY_CRITICAL].count;
+    if (storage_adapter_write(EVENT_LOG_PATH, (const uint8_t *)&critical_store,
+                              sizeof(critical_store)) != 0) {
+        printf("[Events] WARNING: failed to persist critical events\n");
+    }
+#endif
+}
+
+static void load_critical(void) {
+#ifdef EVENT_LOG_PERSIST
+    size_t len = 0;
+
+    if (storage_adapter_read(EVENT_LOG_PATH, (uint8_t *)&critical_store,
+                             sizeof(critical_store), &len) != 0 ||
+        len != sizeof(critical_store) ||
+        critical_store.version != EVENT_LOG_VERSION ||
+        critical_store.head >= EVENT_LOG_CRITICAL_SLOTS ||
+        critical_store.count > EVENT_LOG_CRITICAL_SLOTS) {
+        memset(&critical_store, 0, sizeof(critical_store));
+        return;
+    }
+
+    rings[EVENT_PRIORITY_CRITICAL].head = critical_store.head;
+    rings[EVENT_PRIORITY_CRITICAL].count = critical_store.count;
+
+    // Numbering continues past the reloaded events even without an epoch
+    for (uint8_t i = 0; i < critical_store.count; i++) {
+        const event_record_t *rec = ring_at(&rings[EVENT_PRIORITY_CRITICAL], i);
+        if (rec->number >= next_number) {
+            next_number = rec->number + 1;
+        }
+    }
+#endif
+}
+
+/**
+ * Start numbering at the saved epoch: the end of the block reserved
+ * before the reset, past any number the last boot handed out
+ */
+static void load_number_epoch(void) {
+    uint64_t epoch;
+    size_t len = 0;
+
+    if (storage_adapter_read(EVENT_LOG_NUMBER_PATH, (uint8_t *)&epoch, sizeof(epoch),
+                             &len) == 0 &&
+        len == sizeof(epoch) && epoch > next_number) {
+        next_number = epoch;
+    }
+}
+
+/**
+ * Reserve the next EVENT_LOG_NUMBER_BLOCK numbers by saving the block's end
+ */
+static void reserve_numbers(void) {
+    uint64_t limit = next_number + EVENT_LOG_NUMBER_BLOCK;
+
+    if (storage_adapter_write(EVENT_LOG_NUMBER_PATH, (const uint8_t *)&limit,
+                              sizeof(limit)) != 0) {
+        printf("[Events] WARNING: failed to save event number epoch\n");
+    }
+    number_limit = limit;
+}
+
+/**
+ * Check whether an event matches any of the paths
+ */
+static bool record_matches(const event_record_t *rec, const event_path_t *paths,
+                           size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (event_path_matches(&paths[i], rec->endpoint, rec->cluster_id, rec->event_id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Lowest-numbered matching event numbered event_min or higher
+ */
+static const event_record_t *find_next(const event_path_t *paths, size_t count,
+                                       uint64_t event_min) {
+    const event_record_t *next = NULL;
+
+    for (int p = 0; p < EVENT_PRIORITY_COUNT; p++) {
+        for (uint8_t i = 0; i < rings[p].count; i++) {
+            const event_record_t *rec = ring_at(&rings[p], i);
+            if (rec->number >= event_min && (!next || rec->number < next->number) &&
+                record_matches(rec, paths, count)) {
+                next = rec;
+            }
+        }
+    }
+    return next;
+}
+
+/**
+ * Encode EventDataIB ::= {
+ *   Path [0]: { Endpoint [1], Cluster [2], Event [3] }
+ *   EventNumber [1], Priority [2], SystemTimestamp [4], Data [7]
+ * }
+ */
+static int encode_event(tlv_writer_t *writer, uint8_t endpoint, uint32_t cluster_id,
+                        uint32_t event_id, uint8_t priority, event_fields_fn fields,
+                        const void *arg) {
+    if (tlv_encode_structure_start(writer, 1) < 0 ||
+        tlv_encode_list_start(writer, 0) < 0 ||
+        tlv_encode_uint8(writer, 1, endpoint) < 0 ||
+        tlv_encode_uint32(writer, 2, cluster_id) < 0 ||
+        tlv_encode_uint32(writer, 3, event_id) < 0 ||
+        tlv_encode_container_end(writer) < 0 ||
+        tlv_encode_uint64(writer, 1, next_number) < 0 ||
+        tlv_encode_uint8(writer, 2, priority) < 0 ||
+        tlv_encode_uint64(writer, 4, system_time_ms) < 0 ||
+        tlv_encode_structure_start(writer, 7) < 0) {
+        return -1;
+    }
+    if (fields && fields(writer, arg) < 0) {
+        return -1;
+    }
+    if (tlv_encode_container_end(writer) < 0 ||
+        tlv_encode_container_end(writer) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Initialize the event log
+ */
+int event_log_init(void) {
+    if (initialized) {
+        return 0;
+    }
+
+    for (int p = 0; p < EVENT_PRIORITY_COUNT; p++) {
+        rings[p].head = 0;
+        rings[p].count = 0;
+    }
+    next_number = 0;
+    system_time_ms = 0;
+    last_now_ms = 0;
+
+    load_critical();
+    load_number_epoch();
+    reserve_numbers();
+
+    initialized = true;
+    return 0;
+}
+
+/**
+ * Log an event
+ */
+int event_log_emit(uint8_t endpoint, uint32_t cluster_id, uint32_t event_id,
+                   uint8_t priority, event_fields_fn fields, const void *arg,
+                   uint32_t now_ms, uint64_t *event_number) {
+    tlv_writer_t writer;
+
+    if (!initialized || priority >= EVENT_PRIORITY_COUNT) {
+        return -1;
+    }
+
+    system_time_ms += (uint32_t)(now_ms - last_now_ms);
+    last_now_ms = now_ms;
+
+    if (next_number >= number_limit) {
+        reserve_numbers();
+    }
+
+    tlv_writer_init(&writer, scratch.data, sizeof(scratch.data));
+    if (encode_event(&writer, endpoint, cluster_id, event_id, priority, fields, arg) < 0) {
+        return -1;
+    }
+    scratch.number = next_number;
+    scratch.cluster_id = cluster_id;
+    scratch.event_id = event_id;
+    scratch.endpoint = endpoint;
+    scratch.len = (uint8_t)tlv_writer_get_length(&writer);
+
+    // A full ring drops its oldest event
+    event_ring_t *ring = &rings[priority];
+    if (ring->count == ring->capacity) {
+        ring->head = (uint8_t)((ring->head + 1) % ring->capacity);
+        ring->count--;
+    }
+    ring->records[(ring->head + ring->count) % ring->capacity] = scratch;
+    ring->count++;
+
+    if (event_number) {
+        *event_number = next_number;
+    }
+    next_number++;
+
+    if (priority == EVENT_PRIORITY_CRITICAL) {
+        persist_critical();
+    }
+
+    subscribe_handler_notify_event(endpoint, cluster_id, event_id, now_ms);
+    return 0;
+}
+
+/**
+ * Number the next event will get
+ */
+uint64_t event_log_next_number(void) {
+    return next_number;
+}
+
+/**
+ * Number of events held for a priority
+ */
+size_t event_log_count(uint8_t priority) {
+    return priority < EVENT_PRIORITY_COUNT ? rings[priority].count : 0;
+}
+
+/**
+ * Check for events to report
+ */
+bool event_log_pending(const event_path_t *paths, size_t count, uint64_t event_min) {
+    return paths && count > 0 && find_next(paths, count, event_min) != NULL;
+}
+
+/**
+ * Encode EventReportIBs
+ */
+size_t event_log_encode_reports(tlv_writer_t *writer, const event_path_t *paths,
+                                size_t count, uint64_t *event_min, bool *more) {
+    const event_record_t *rec;
+    size_t written = 0;
+
+    *more = false;
+    if (!writer || !paths || count == 0) {
+        return 0;
+    }
+
+    // EventReportIB ::= { EventStatus [0] | EventData [1] }
+    while ((rec = find_next(paths, count, *event_min)) != NULL) {
+        size_t offset = writer->offset;
+
+        if (tlv_encode_structure_start(writer, 0xFF) < 0 ||
+            tlv_encode_raw(writer, rec->data, rec->len) < 0 ||
+            tlv_encode_container_end(writer) < 0) {
+            writer->offset = offset;
+            *more = true;
+            break;
+        }
+        *event_min = rec->number + 1;
+        written++;
+    }
+    return written;
+}
+
+/**
+ * Drop every event (for testing)
+ */
+void event_log_clear(void) {
+    for (int p = 0; p < EVENT_PRIORITY_COUNT; p++) {
+        rings[p].head = 0;
+        rings[p].count = 0;
+    }
+}
+
+/**
+ * Forget the log as a reset would (for testing)
+ */
+void event_log_deinit(void) {
+    event_log_clear();
+    initialized = false;
+}
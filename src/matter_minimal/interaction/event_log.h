@@ -0,0 +1,173 @@
+/*
+ * event_log.h
+ * Matter event log
+ * Based on Matter Core Specification Sections 7.14 and 8.9
+ *
+ * Events are kept in one ring buffer per priority (debug, info, critical),
+ * so a burst of debug events never pushes out a critical one.  Every event
+ * gets the next number of a counter shared by all priorities and is
+ * TLV-encoded as an EventDataIB once, when it is logged; reports copy the
+ * stored bytes.  Readers ask for the events from an EventMin on, so a
+ * controller can fetch the history incrementally.
+ *
+ * Event numbers never go backwards across a reset: the counter is saved
+ * to flash once per EVENT_LOG_NUMBER_BLOCK numbers, as the end of the
+ * block about to be used, and event_log_init() starts from the saved value.
+ *
+ * With EVENT_LOG_PERSIST defined the critical ring is written to flash
+ * after each critical event and reloaded by event_log_init().
+ */
+
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include "interaction_model.h"
+#include "../codec/tlv.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Event priorities (PriorityEnum)
+ */
+#define EVENT_PRIORITY_DEBUG        0
+#define EVENT_PRIORITY_INFO         1
+#define EVENT_PRIORITY_CRITICAL     2
+#define EVENT_PRIORITY_COUNT        3
+
+/**
+ * Events kept per priority; the oldest event of a priority is dropped
+ * when its ring is full
+ */
+#ifndef EVENT_LOG_DEBUG_SLOTS
+#define EVENT_LOG_DEBUG_SLOTS       4
+#endif
+#ifndef EVENT_LOG_INFO_SLOTS
+#define EVENT_LOG_INFO_SLOTS        8
+#endif
+#ifndef EVENT_LOG_CRITICAL_SLOTS
+#define EVENT_LOG_CRITICAL_SLOTS    8
+#endif
+
+/**
+ * Largest encoded EventDataIB (path, number, priority, timestamp, fields)
+ */
+#ifndef EVENT_LOG_MAX_EVENT_LEN
+#define EVENT_LOG_MAX_EVENT_LEN     64
+#endif
+
+/**
+ * Event numbers reserved per flash write of the number epoch.  A reset
+ * skips the rest of the current block, so controllers that remember an
+ * EventMin never see a number reused.
+ */
+#ifndef EVENT_LOG_NUMBER_BLOCK
+#define EVENT_LOG_NUMBER_BLOCK      0x10000u
+#endif
+
+/**
+ * LittleFS path of the persisted critical events (EVENT_LOG_PERSIST)
+ */
+#define EVENT_LOG_PATH              "/matter_events"
+
+/**
+ * LittleFS path of the event number epoch
+ */
+#define EVENT_LOG_NUMBER_PATH       "/matter_event_number"
+
+/**
+ * Event fields encoder
+ * Encodes the event's fields (context tags) into its Data structure.
+ *
+ * @param writer Writer positioned inside the Data structure
+ * @param arg Caller's argument to event_log_emit()
+ * @return 0 on success, -1 if the fields do not fit
+ */
+typedef int (*event_fields_fn)(tlv_writer_t *writer, const void *arg);
+
+/**
+ * Initialize the event log
+ * Clears the rings; with EVENT_LOG_PERSIST, reloads the saved critical
+ * events.  Numbering continues from the saved epoch (and past any reloaded
+ * event), and the next block of numbers is reserved.
+ *
+ * @return 0 on success, -1 on failure
+ */
+int event_log_init(void);
+
+/**
+ * Log an event
+ * Encodes the EventDataIB, stores it in its priority's ring and marks it
+ * pending for subscriptions with a matching event path.
+ *
+ * @param endpoint Endpoint the event happened on
+ * @param cluster_id Cluster ID
+ * @param event_id Event ID
+ * @param priority EVENT_PRIORITY_*
+ * @param fields Fields encoder, NULL for an event without fields
+ * @param arg Argument passed to fields
+ * @param now_ms Current time in milliseconds (SystemTimestamp)
+ * @param event_number Set to the event's number (may be NULL)
+ * @return 0 on success, -1 if not initialized, the priority is unknown or
+ *         the event does not fit EVENT_LOG_MAX_EVENT_LEN
+ */
+int event_log_emit(uint8_t endpoint, uint32_t cluster_id, uint32_t event_id,
+                   uint8_t priority, event_fields_fn fields, const void *arg,
+                   uint32_t now_ms, uint64_t *event_number);
+
+/**
+ * Number the next event will get
+ */
+uint64_t event_log_next_number(void);
+
+/**
+ * Number of events held for a priority
+ */
+size_t event_log_count(uint8_t priority);
+
+/**
+ * Check for events to report
+ *
+ * @param paths Event paths (wildcards allowed)
+ * @param count Number of paths
+ * @param event_min Lowest event number wanted
+ * @return true if a held event numbered event_min or higher matches a path
+ */
+bool event_log_pending(const event_path_t *paths, size_t count, uint64_t event_min);
+
+/**
+ * Encode EventReportIBs into an open EventReports list
+ * Encodes the matching events numbered event_min or higher, oldest first,
+ * until the next one does not fit, and advances event_min past them.
+ *
+ * @param writer Writer positioned inside the EventReports list
+ * @param paths Event paths (wildcards allowed)
+ * @param count Number of paths
+ * @param event_min Lowest event number wanted; updated
+ * @param more Set when a matching event did not fit
+ * @return Number of events encoded
+ */
+size_t event_log_encode_reports(tlv_writer_t *writer, const event_path_t *paths,
+                                size_t count, uint64_t *event_min, bool *more);
+
+/**
+ * Drop every event (for testing)
+ * Numbering continues.
+ */
+void event_log_clear(void);
+
+/**
+ * Forget the log as a reset would (for testing)
+ * The next event_log_init() starts over from what is in flash.
+ */
+void event_log_deinit(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EVENT_LOG_H
@@ -35,6 +35,15 @@ extern "C" {
 #define OP_INVOKE_RESPONSE      0x09
 #define OP_TIMED_REQUEST        0x0A
 
+/**
+ * Session a request arrived on, for access checks
+ * Writes and commands are refused on the unsecured session; commands that
+ * act on the burner also need an operational (CASE) session.
+ */
+#define IM_AUTH_NONE            0   // Unsecured session (session ID 0)
+#define IM_AUTH_PASE            1   // Commissioning session (setup passcode)
+#define IM_AUTH_CASE            2   // Operational session (fabric certificates)
+
 /**
  * Interaction Model Status Codes
  * Based on Matter Core Specification Section 8.10
@@ -68,6 +77,13 @@ typedef enum {
     IM_STATUS_FAILSAFE_REQUIRED       = 0xCA
 } im_status_code_t;
 
+/**
+ * Attribute path wildcard flags (tag omitted from the AttributePath)
+ */
+#define ATTR_PATH_WILDCARD_ENDPOINT     0x01
+#define ATTR_PATH_WILDCARD_CLUSTER      0x02
+#define ATTR_PATH_WILDCARD_ATTRIBUTE    0x04
+
 /**
  * Attribute Path Structure
  * Identifies a specific attribute in the data model
@@ -76,9 +92,66 @@ typedef struct {
     uint8_t endpoint;           // Endpoint number
     uint32_t cluster_id;        // Cluster ID
     uint32_t attribute_id;      // Attribute ID
-    bool wildcard;              // True if this is a wildcard path
+    uint8_t wildcard;           // ATTR_PATH_WILDCARD_* flags, 0 = concrete path
 } attribute_path_t;
 
+/**
+ * DataVersionFilter
+ * The controller already has this version of the cluster's attributes
+ */
+typedef struct {
+    uint8_t endpoint;           // Endpoint number
+    uint32_t cluster_id;        // Cluster ID
+    uint32_t data_version;      // DataVersion the controller holds
+} data_version_filter_t;
+
+/**
+ * Check whether a (possibly wildcard) path covers a concrete attribute
+ */
+static inline bool attribute_path_matches(const attribute_path_t *path,
+                                          uint8_t endpoint, uint32_t cluster_id,
+                                          uint32_t attribute_id) {
+    return ((path->wildcard & ATTR_PATH_WILDCARD_ENDPOINT) ||
+            path->endpoint == endpoint) &&
+           ((path->wildcard & ATTR_PATH_WILDCARD_CLUSTER) ||
+            path->cluster_id == cluster_id) &&
+           ((path->wildcard & ATTR_PATH_WILDCARD_ATTRIBUTE) ||
+            path->attribute_id == attribute_id);
+}
+
+/**
+ * Event path wildcard flags (tag omitted from the EventPath)
+ */
+#define EVENT_PATH_WILDCARD_ENDPOINT    0x01
+#define EVENT_PATH_WILDCARD_CLUSTER     0x02
+#define EVENT_PATH_WILDCARD_EVENT       0x04
+
+/**
+ * Event Path Structure
+ * Identifies an event (or, with wildcards, a set of events) to report
+ */
+typedef struct {
+    uint8_t endpoint;           // Endpoint number
+    uint32_t cluster_id;        // Cluster ID
+    uint32_t event_id;          // Event ID
+    uint8_t wildcard;           // EVENT_PATH_WILDCARD_* flags, 0 = concrete path
+    bool urgent;                // Report without waiting for the min interval
+} event_path_t;
+
+/**
+ * Check whether a (possibly wildcard) path covers a concrete event
+ */
+static inline bool event_path_matches(const event_path_t *path,
+                                      uint8_t endpoint, uint32_t cluster_id,
+                                      uint32_t event_id) {
+    return ((path->wildcard & EVENT_PATH_WILDCARD_ENDPOINT) ||
+            path->endpoint == endpoint) &&
+           ((path->wildcard & EVENT_PATH_WILDCARD_CLUSTER) ||
+            path->cluster_id == cluster_id) &&
+           ((path->wildcard & EVENT_PATH_WILDCARD_EVENT) ||
+            path->event_id == event_id);
+}
+
 /**
  * Attribute Data Value
  * Generic container for attribute values
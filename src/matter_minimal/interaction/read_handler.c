@@ -4,21 +4,23 @@
  */
 
 #include "read_handler.h"
+#include "attribute_table.h"
+#include "event_log.h"
 #include "../codec/tlv.h"
 #include "../codec/tlv_types.h"
 #include <string.h>
 
-// Forward declarations of cluster read functions
-extern int cluster_descriptor_read(uint8_t endpoint, uint32_t attr_id, 
-                                   attribute_value_t *value, attribute_type_t *type);
-extern int cluster_onoff_read(uint8_t endpoint, uint32_t attr_id,
-                             attribute_value_t *value, attribute_type_t *type);
-extern int cluster_level_control_read(uint8_t endpoint, uint32_t attr_id,
-                                      attribute_value_t *value, attribute_type_t *type);
-extern int cluster_temperature_read(uint8_t endpoint, uint32_t attr_id,
-                                   attribute_value_t *value, attribute_type_t *type);
-extern int cluster_basic_read(uint8_t endpoint, uint32_t attr_id,
-                              attribute_value_t *value, attribute_type_t *type);
+/**
+ * Bytes kept free after the reports of a chunk: end of the
+ * AttributeReports list (1) and MoreChunkedMessages (3)
+ */
+#define READ_CHUNK_TRAILER_LEN 4
+
+/**
+ * Bytes kept free for the EventReports list of a read with event paths:
+ * its start (2) and end (1)
+ */
+#define READ_EVENT_LIST_LEN 3
 
 /**
  * Initialize read handler
@@ -31,11 +33,14 @@ int read_handler_init(void) {
 /**
  * Parse AttributePath from TLV structure
  */
-static int parse_attribute_path(tlv_reader_t *reader, attribute_path_t *path) {
+int read_handler_parse_attribute_path(tlv_reader_t *reader, attribute_path_t *path) {
     tlv_element_t element;
     
-    // AttributePath is a list with tags 0-4
+    // AttributePath is a list with tags 0-4; an omitted endpoint, cluster
+    // or attribute is a wildcard
     memset(path, 0, sizeof(attribute_path_t));
+    path->wildcard = ATTR_PATH_WILDCARD_ENDPOINT | ATTR_PATH_WILDCARD_CLUSTER |
+                     ATTR_PATH_WILDCARD_ATTRIBUTE;
     
     // Read elements until we hit the end of the structure
     while (!tlv_reader_is_end(reader)) {
@@ -55,12 +60,15 @@ static int parse_attribute_path(tlv_reader_t *reader, attribute_path_t *path) {
         switch (element.tag) {
             case 0: // Endpoint
                 path->endpoint = tlv_read_uint8(&element);
+                path->wildcard &= (uint8_t)~ATTR_PATH_WILDCARD_ENDPOINT;
                 break;
             case 2: // Cluster ID
                 path->cluster_id = element.value.u32;
+                path->wildcard &= (uint8_t)~ATTR_PATH_WILDCARD_CLUSTER;
                 break;
             case 3: // Attribute ID
                 path->attribute_id = element.value.u32;
+                path->wildcard &= (uint8_t)~ATTR_PATH_WILDCARD_ATTRIBUTE;
                 break;
             default:
                 // Ignore unknown tags
@@ -72,87 +80,428 @@ static int parse_attribute_path(tlv_reader_t *reader, attribute_path_t *path) {
 }
 
 /**
- * Route attribute read to appropriate cluster handler
+ * Parse a DataVersionFilters list
  */
-static int route_attribute_read(const attribute_path_t *path,
-                               attribute_value_t *value,
-                               attribute_type_t *type,
-                               im_status_code_t *status) {
-    int result;
-    
-    // Route to appropriate cluster
-    switch (path->cluster_id) {
-        case 0x001D: // Descriptor
-            result = cluster_descriptor_read(path->endpoint, path->attribute_id, value, type);
-            break;
-            
-        case 0x0006: // OnOff
-            result = cluster_onoff_read(path->endpoint, path->attribute_id, value, type);
-            break;
-            
-        case 0x0008: // LevelControl
-            result = cluster_level_control_read(path->endpoint, path->attribute_id, value, type);
-            break;
-            
-        case 0x0402: // TemperatureMeasurement
-            result = cluster_temperature_read(path->endpoint, path->attribute_id, value, type);
-            break;
+int read_handler_parse_data_version_filters(tlv_reader_t *reader,
+                                            data_version_filter_t *filters,
+                                            size_t max_filters, size_t *count) {
+    tlv_element_t element;
+    
+    *count = 0;
+    
+    // DataVersionFilter ::= {
+    //   Path [0]: { Node [0], Endpoint [1], Cluster [2] }
+    //   DataVersion [1]: uint32
+    // }
+    while (tlv_reader_next(reader, &element) == 0) {
+        if (element.type == TLV_TYPE_END_OF_CONTAINER) {
+            return 0; // End of list
+        }
+        if (element.type != TLV_TYPE_STRUCTURE && element.type != TLV_TYPE_LIST) {
+            continue;
+        }
+        
+        data_version_filter_t filter;
+        uint8_t found = 0;  // bit 0 endpoint, bit 1 cluster, bit 2 version
+        bool in_path = false;
+        int depth = 1;
+        
+        memset(&filter, 0, sizeof(filter));
+        while (depth > 0) {
+            if (tlv_reader_next(reader, &element) < 0) {
+                return -1;
+            }
             
-        case 0x0028: // BasicInformation
-            result = cluster_basic_read(path->endpoint, path->attribute_id, value, type);
-            break;
+            if (element.type == TLV_TYPE_END_OF_CONTAINER) {
+                depth--;
+                if (depth == 1) {
+                    in_path = false;
+                }
+            } else if (element.type == TLV_TYPE_STRUCTURE ||
+                       element.type == TLV_TYPE_LIST ||
+                       element.type == TLV_TYPE_ARRAY) {
+                in_path = (depth == 1 && element.tag == 0);
+                depth++;
+            } else if (depth == 2 && in_path && element.tag == 1) {
+                filter.endpoint = tlv_read_uint8(&element);
+                found |= 0x01;
+            } else if (depth == 2 && in_path && element.tag == 2) {
+                filter.cluster_id = element.value.u32;
+                found |= 0x02;
+            } else if (depth == 1 && element.tag == 1) {
+                filter.data_version = element.value.u32;
+                found |= 0x04;
+            }
+        }
+        
+        if (found == 0x07 && *count < max_filters) {
+            filters[(*count)++] = filter;
+        }
+    }
+    
+    return -1; // Unterminated list
+}
+
+/**
+ * Parse an EventRequests list
+ */
+int read_handler_parse_event_paths(tlv_reader_t *reader, event_path_t *paths,
+                                   size_t max_paths, size_t *count) {
+    tlv_element_t element;
+    
+    *count = 0;
+    
+    // EventPath ::= [
+    //   Node [0], Endpoint [1], Cluster [2], Event [3], IsUrgent [4]
+    // ]
+    while (tlv_reader_next(reader, &element) == 0) {
+        if (element.type == TLV_TYPE_END_OF_CONTAINER) {
+            return 0; // End of list
+        }
+        if (element.type != TLV_TYPE_STRUCTURE && element.type != TLV_TYPE_LIST) {
+            continue;
+        }
+        
+        event_path_t path;
+        int depth = 1;
+        
+        memset(&path, 0, sizeof(path));
+        path.wildcard = EVENT_PATH_WILDCARD_ENDPOINT | EVENT_PATH_WILDCARD_CLUSTER |
+                        EVENT_PATH_WILDCARD_EVENT;
+        while (depth > 0) {
+            if (tlv_reader_next(reader, &element) < 0) {
+                return -1;
+            }
             
-        default:
-            *status = IM_STATUS_UNSUPPORTED_CLUSTER;
+            if (element.type == TLV_TYPE_END_OF_CONTAINER) {
+                depth--;
+            } else if (element.type == TLV_TYPE_STRUCTURE ||
+                       element.type == TLV_TYPE_LIST ||
+                       element.type == TLV_TYPE_ARRAY) {
+                depth++;
+            } else if (depth == 1 && element.tag == 1) {
+                path.endpoint = tlv_read_uint8(&element);
+                path.wildcard &= (uint8_t)~EVENT_PATH_WILDCARD_ENDPOINT;
+            } else if (depth == 1 && element.tag == 2) {
+                path.cluster_id = element.value.u32;
+                path.wildcard &= (uint8_t)~EVENT_PATH_WILDCARD_CLUSTER;
+            } else if (depth == 1 && element.tag == 3) {
+                path.event_id = element.value.u32;
+                path.wildcard &= (uint8_t)~EVENT_PATH_WILDCARD_EVENT;
+            } else if (depth == 1 && element.tag == 4) {
+                path.urgent = tlv_read_bool(&element);
+            }
+        }
+        
+        if (*count < max_paths) {
+            paths[(*count)++] = path;
+        }
+    }
+    
+    return -1; // Unterminated list
+}
+
+/**
+ * Parse an EventFilters list
+ */
+int read_handler_parse_event_filters(tlv_reader_t *reader, uint64_t *event_min) {
+    tlv_element_t element;
+    int depth = 1;
+    
+    // EventFilter ::= { Node [0], EventMin [1] }
+    while (depth > 0) {
+        if (tlv_reader_next(reader, &element) < 0) {
+            return -1; // Unterminated list
+        }
+        
+        if (element.type == TLV_TYPE_END_OF_CONTAINER) {
+            depth--;
+        } else if (element.type == TLV_TYPE_STRUCTURE ||
+                   element.type == TLV_TYPE_LIST ||
+                   element.type == TLV_TYPE_ARRAY) {
+            depth++;
+        } else if (depth == 2 && element.tag == 1 &&
+                   element.type == TLV_TYPE_UNSIGNED_INT &&
+                   element.value.u64 > *event_min) {
+            *event_min = element.value.u64;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * Check whether a cluster can be left out of a report
+ */
+bool read_handler_cluster_filtered(const data_version_filter_t *filters, size_t count,
+                                   uint8_t endpoint, uint32_t cluster_id) {
+    uint32_t version;
+    
+    for (size_t i = 0; i < count; i++) {
+        if (filters[i].endpoint == endpoint && filters[i].cluster_id == cluster_id) {
+            return attribute_table_get_data_version(endpoint, cluster_id, &version) == 0 &&
+                   version == filters[i].data_version;
+        }
+    }
+    return false;
+}
+
+/**
+ * Read one concrete attribute into a report
+ */
+static int read_report(attribute_report_t *report) {
+    report->data_version = 0;
+    attribute_table_get_data_version(report->path.endpoint, report->path.cluster_id,
+                                     &report->data_version);
+    return attribute_table_read(&report->path, &report->value,
+                                &report->type, &report->status);
+}
+
+/**
+ * Encode one AttributeReport into the AttributeReports list
+ */
+static int encode_attribute_report(tlv_writer_t *writer, const attribute_report_t *report) {
+    // Start AttributeReport structure (anonymous tag in array)
+    if (tlv_encode_structure_start(writer, 0xFF) < 0) {
+        return -1;
+    }
+    
+    // Start AttributeStatus (tag 0) or AttributeData (tag 1)
+    if (report->status != IM_STATUS_SUCCESS) {
+        // Encode AttributeStatus for errors
+        if (tlv_encode_structure_start(writer, 0) < 0) {
             return -1;
+        }
+        
+        // AttributePath (tag 0)
+        if (tlv_encode_structure_start(writer, 0) < 0) {
+            return -1;
+        }
+        if (tlv_encode_uint8(writer, 0, report->path.endpoint) < 0) {
+            return -1;
+        }
+        if (tlv_encode_uint32(writer, 2, report->path.cluster_id) < 0) {
+            return -1;
+        }
+        if (tlv_encode_uint32(writer, 3, report->path.attribute_id) < 0) {
+            return -1;
+        }
+        if (tlv_encode_container_end(writer) < 0) {
+            return -1;
+        }
+        
+        // Status (tag 1)
+        if (tlv_encode_structure_start(writer, 1) < 0) {
+            return -1;
+        }
+        if (tlv_encode_uint8(writer, 0, (uint8_t)report->status) < 0) {
+            return -1;
+        }
+        if (tlv_encode_container_end(writer) < 0) {
+            return -1;
+        }
+        
+        if (tlv_encode_container_end(writer) < 0) {
+            return -1;
+        }
+    } else {
+        // Encode AttributeData for success
+        if (tlv_encode_structure_start(writer, 1) < 0) {
+            return -1;
+        }
+        
+        // DataVersion (tag 0)
+        if (tlv_encode_uint32(writer, 0, report->data_version) < 0) {
+            return -1;
+        }
+        
+        // AttributePath (tag 1)
+        if (tlv_encode_structure_start(writer, 1) < 0) {
+            return -1;
+        }
+        if (tlv_encode_uint8(writer, 0, report->path.endpoint) < 0) {
+            return -1;
+        }
+        if (tlv_encode_uint32(writer, 2, report->path.cluster_id) < 0) {
+            return -1;
+        }
+        if (tlv_encode_uint32(writer, 3, report->path.attribute_id) < 0) {
+            return -1;
+        }
+        if (tlv_encode_container_end(writer) < 0) {
+            return -1;
+        }
+        
+        // Data (tag 2) - encode attribute value
+        switch (report->type) {
+            case ATTR_TYPE_BOOL:
+                if (tlv_encode_bool(writer, 2, report->value.bool_val) < 0) {
+                    return -1;
+                }
+                break;
+            case ATTR_TYPE_UINT8:
+                if (tlv_encode_uint8(writer, 2, report->value.uint8_val) < 0) {
+                    return -1;
+                }
+                break;
+            case ATTR_TYPE_INT16:
+                if (tlv_encode_int16(writer, 2, report->value.int16_val) < 0) {
+                    return -1;
+                }
+                break;
+            case ATTR_TYPE_UINT16:
+                if (tlv_encode_uint16(writer, 2, report->value.uint16_val) < 0) {
+                    return -1;
+                }
+                break;
+            case ATTR_TYPE_UINT32:
+                if (tlv_encode_uint32(writer, 2, report->value.uint32_val) < 0) {
+                    return -1;
+                }
+                break;
+            case ATTR_TYPE_UTF8_STRING:
+                if (tlv_encode_string(writer, 2, report->value.string_val.str) < 0) {
+                    return -1;
+                }
+                break;
+            default:
+                // Unsupported type
+                return -1;
+        }
+        
+        if (tlv_encode_container_end(writer) < 0) {
+            return -1;
+        }
     }
     
-    if (result < 0) {
-        *status = IM_STATUS_UNSUPPORTED_ATTRIBUTE;
+    // End AttributeReport structure
+    if (tlv_encode_container_end(writer) < 0) {
         return -1;
     }
     
-    *status = IM_STATUS_SUCCESS;
     return 0;
 }
 
 /**
- * Process ReadRequest and generate reports
+ * Next report of a read, advancing the cursor past it
+ * A concrete path always gets a report (AttributeStatus if it cannot be
+ * read).  A wildcard path expands to every attribute it covers; ones that
+ * cannot be read are left out, as the spec requires.  Clusters the
+ * controller already has (DataVersionFilter) are left out either way.
+ * 
+ * @return true if report was filled, false when the read is complete
  */
-int read_handler_process_request(const uint8_t *request_tlv, size_t request_len,
-                                 uint8_t *response_tlv, size_t max_response_len,
-                                 size_t *actual_len) {
+static bool next_report(read_cursor_t *cursor, attribute_report_t *report) {
+    while (cursor->path_index < cursor->path_count) {
+        const attribute_path_t *path = &cursor->paths[cursor->path_index];
+        
+        if (path->wildcard == 0) {
+            cursor->path_index++;
+            if (!read_handler_cluster_filtered(cursor->filters, cursor->filter_count,
+                                               path->endpoint, path->cluster_id)) {
+                report->path = *path;
+                read_report(report);
+                return true;
+            }
+            continue;
+        }
+        
+        if (!cursor->expanding) {
+            attribute_table_iter_init(&cursor->iter, path);
+            cursor->expanding = true;
+        }
+        
+        const attribute_entry_t *entry;
+        while ((entry = attribute_table_iter_next(&cursor->iter, NULL)) != NULL) {
+            if (read_handler_cluster_filtered(cursor->filters, cursor->filter_count,
+                                              entry->endpoint, entry->cluster_id)) {
+                continue;
+            }
+            
+            memset(&report->path, 0, sizeof(report->path));
+            report->path.endpoint = entry->endpoint;
+            report->path.cluster_id = entry->cluster_id;
+            report->path.attribute_id = entry->attribute_id;
+            
+            if (read_report(report) == 0) {
+                return true;
+            }
+        }
+        
+        cursor->expanding = false;
+        cursor->path_index++;
+    }
+    
+    return false;
+}
+
+/**
+ * Parse ReadRequest paths and filters into a cursor
+ */
+int read_handler_parse_request(const uint8_t *request_tlv, size_t request_len,
+                               read_cursor_t *cursor) {
     tlv_reader_t reader;
     tlv_element_t element;
-    attribute_report_t reports[MAX_READ_PATHS];
-    size_t report_count = 0;
+    size_t filter_count = 0;
     
-    if (!request_tlv || !response_tlv || !actual_len) {
+    if (!request_tlv || !cursor) {
         return -1;
     }
     
+    memset(cursor, 0, sizeof(*cursor));
+    
     // Initialize reader
     tlv_reader_init(&reader, request_tlv, request_len);
     
     // Parse ReadRequest structure
     // ReadRequest ::= {
     //   AttributeRequests [0]: List of AttributePath
-    //   EventRequests [1]: (optional, skip)
-    //   EventFilters [2]: (optional, skip)
+    //   EventRequests [1]: List of EventPath (optional)
+    //   EventFilters [2]: List of EventFilter (optional)
     //   FabricFiltered [3]: bool (optional, default false)
-    //   DataVersionFilters [4]: (optional, skip)
+    //   DataVersionFilters [4]: List of DataVersionFilter (optional)
     // }
     
-    while (!tlv_reader_is_end(&reader) && report_count < MAX_READ_PATHS) {
+    while (!tlv_reader_is_end(&reader)) {
         if (tlv_reader_next(&reader, &element) < 0) {
             break;
         }
         
+        if ((element.tag == 1 || element.tag == 2) &&
+            (element.type == TLV_TYPE_LIST || element.type == TLV_TYPE_ARRAY)) {
+            size_t event_path_count = 0;
+            
+            if (element.tag == 1) {
+                if (read_handler_parse_event_paths(&reader, cursor->event_paths,
+                                                   MAX_EVENT_PATHS,
+                                                   &event_path_count) < 0) {
+                    return -1;
+                }
+                cursor->event_path_count = (uint8_t)event_path_count;
+            } else if (read_handler_parse_event_filters(&reader, &cursor->event_min) < 0) {
+                return -1;
+            }
+            continue;
+        }
+        
+        // DataVersionFilters (tag 4) may follow the paths, so the paths are
+        // collected first and read once the whole request is parsed
+        if (element.tag == 4 && (element.type == TLV_TYPE_LIST ||
+                                 element.type == TLV_TYPE_ARRAY)) {
+            if (read_handler_parse_data_version_filters(&reader, cursor->filters,
+                                                        MAX_DATA_VERSION_FILTERS,
+                                                        &filter_count) < 0) {
+                return -1;
+            }
+            cursor->filter_count = (uint8_t)filter_count;
+            continue;
+        }
+        
         // Look for AttributeRequests (tag 0)
         if (element.tag == 0 && (element.type == TLV_TYPE_LIST || 
                                  element.type == TLV_TYPE_ARRAY)) {
             // Parse each AttributePath in the list
-            while (!tlv_reader_is_end(&reader) && report_count < MAX_READ_PATHS) {
+            while (!tlv_reader_is_end(&reader)) {
                 if (tlv_reader_peek(&reader, &element) < 0) {
                     break;
                 }
@@ -167,19 +516,10 @@ int read_handler_process_request(const uint8_t *request_tlv, size_t request_len,
                     tlv_reader_skip(&reader); // Skip container start
                     
                     // Parse attribute path
-                    attribute_path_t path;
-                    if (parse_attribute_path(&reader, &path) == 0) {
-                        // Read attribute value
-                        attribute_report_t *report = &reports[report_count];
-                        report->path = path;
-                        
-                        if (route_attribute_read(&path, &report->value, 
-                                                &report->type, &report->status) == 0) {
-                            report_count++;
-                        } else {
-                            // Add error report
-                            report_count++;
-                        }
+                    if (cursor->path_count < MAX_READ_PATHS &&
+                        read_handler_parse_attribute_path(
+                            &reader, &cursor->paths[cursor->path_count]) == 0) {
+                        cursor->path_count++;
                     }
                     
                     // Skip to end of structure
@@ -198,154 +538,203 @@ int read_handler_process_request(const uint8_t *request_tlv, size_t request_len,
         }
     }
     
-    // Encode response
-    return read_handler_encode_response(reports, report_count, 
-                                       response_tlv, max_response_len, actual_len);
+    return (cursor->path_count > 0 || cursor->event_path_count > 0) ? 0 : -1;
 }
 
 /**
- * Encode ReadResponse with attribute reports
+ * Encode the next ReadResponse chunk
  */
-int read_handler_encode_response(const attribute_report_t *reports, size_t count,
-                                 uint8_t *response_tlv, size_t max_len,
-                                 size_t *actual_len) {
+int read_handler_encode_chunk(read_cursor_t *cursor,
+                              uint8_t *response_tlv, size_t max_len,
+                              size_t *actual_len, bool *more) {
     tlv_writer_t writer;
+    attribute_report_t report;
+    size_t written = 0;
     
-    if (!reports || !response_tlv || !actual_len || count == 0) {
+    if (!cursor || !response_tlv || !actual_len || !more) {
         return -1;
     }
     
-    // Initialize writer
-    tlv_writer_init(&writer, response_tlv, max_len);
+    size_t event_list_len = cursor->event_path_count > 0 ? READ_EVENT_LIST_LEN : 0;
+    if (max_len < READ_CHUNK_TRAILER_LEN + event_list_len) {
+        return -1;
+    }
     
-    // Start AttributeReports list (tag 0)
+    *more = false;
+    
+    // Reports stop short of the trailer (end of list, MoreChunkedMessages)
+    // and of the EventReports list
+    tlv_writer_init(&writer, response_tlv,
+                    max_len - READ_CHUNK_TRAILER_LEN - event_list_len);
+    
+    // Start AttributeReports list (tag 0); empty when every requested
+    // cluster was filtered out
     if (tlv_encode_array_start(&writer, 0) < 0) {
         return -1;
     }
     
-    // Encode each attribute report
-    for (size_t i = 0; i < count; i++) {
-        const attribute_report_t *report = &reports[i];
+    for (;;) {
+        // Where to resume if this report does not fit
+        size_t offset = writer.offset;
+        uint8_t path_index = cursor->path_index;
+        bool expanding = cursor->expanding;
+        attribute_iter_t iter = cursor->iter;
         
-        // Start AttributeReport structure (anonymous tag in array)
-        if (tlv_encode_structure_start(&writer, 0xFF) < 0) {
-            return -1;
+        if (!next_report(cursor, &report)) {
+            break;
         }
         
-        // Start AttributeStatus (tag 0) or AttributeData (tag 1)
-        if (report->status != IM_STATUS_SUCCESS) {
-            // Encode AttributeStatus for errors
-            if (tlv_encode_structure_start(&writer, 0) < 0) {
-                return -1;
-            }
-            
-            // AttributePath (tag 0)
-            if (tlv_encode_structure_start(&writer, 0) < 0) {
-                return -1;
-            }
-            if (tlv_encode_uint8(&writer, 0, report->path.endpoint) < 0) {
-                return -1;
-            }
-            if (tlv_encode_uint32(&writer, 2, report->path.cluster_id) < 0) {
-                return -1;
-            }
-            if (tlv_encode_uint32(&writer, 3, report->path.attribute_id) < 0) {
-                return -1;
-            }
-            if (tlv_encode_container_end(&writer) < 0) {
-                return -1;
-            }
+        if (encode_attribute_report(&writer, &report) < 0) {
+            writer.offset = offset;
+            cursor->path_index = path_index;
+            cursor->expanding = expanding;
+            cursor->iter = iter;
             
-            // Status (tag 1)
-            if (tlv_encode_structure_start(&writer, 1) < 0) {
-                return -1;
-            }
-            if (tlv_encode_uint8(&writer, 0, (uint8_t)report->status) < 0) {
-                return -1;
-            }
-            if (tlv_encode_container_end(&writer) < 0) {
-                return -1;
-            }
-            
-            if (tlv_encode_container_end(&writer) < 0) {
-                return -1;
-            }
-        } else {
-            // Encode AttributeData for success
-            if (tlv_encode_structure_start(&writer, 1) < 0) {
-                return -1;
-            }
-            
-            // DataVersion (tag 0) - optional, use 0
-            if (tlv_encode_uint32(&writer, 0, 0) < 0) {
-                return -1;
-            }
-            
-            // AttributePath (tag 1)
-            if (tlv_encode_structure_start(&writer, 1) < 0) {
-                return -1;
-            }
-            if (tlv_encode_uint8(&writer, 0, report->path.endpoint) < 0) {
-                return -1;
-            }
-            if (tlv_encode_uint32(&writer, 2, report->path.cluster_id) < 0) {
-                return -1;
-            }
-            if (tlv_encode_uint32(&writer, 3, report->path.attribute_id) < 0) {
-                return -1;
-            }
-            if (tlv_encode_container_end(&writer) < 0) {
+            // A report larger than a whole chunk can never be sent
+            if (written == 0) {
                 return -1;
             }
-            
-            // Data (tag 2) - encode attribute value
-            switch (report->type) {
-                case ATTR_TYPE_BOOL:
-                    if (tlv_encode_bool(&writer, 2, report->value.bool_val) < 0) {
-                        return -1;
-                    }
-                    break;
-                case ATTR_TYPE_UINT8:
-                    if (tlv_encode_uint8(&writer, 2, report->value.uint8_val) < 0) {
-                        return -1;
-                    }
-                    break;
-                case ATTR_TYPE_INT16:
-                    if (tlv_encode_int16(&writer, 2, report->value.int16_val) < 0) {
-                        return -1;
-                    }
-                    break;
-                case ATTR_TYPE_UINT16:
-                    if (tlv_encode_uint16(&writer, 2, report->value.uint16_val) < 0) {
-                        return -1;
-                    }
-                    break;
-                case ATTR_TYPE_UINT32:
-                    if (tlv_encode_uint32(&writer, 2, report->value.uint32_val) < 0) {
-                        return -1;
-                    }
-                    break;
-                case ATTR_TYPE_UTF8_STRING:
-                    if (tlv_encode_string(&writer, 2, report->value.string_val.str) < 0) {
-                        return -1;
-                    }
-                    break;
-                default:
-                    // Unsupported type
-                    return -1;
-            }
-            
-            if (tlv_encode_container_end(&writer) < 0) {
+            *more = true;
+            break;
+        }
+        written++;
+    }
+    
+    // End AttributeReports list
+    writer.buffer_size = max_len - (READ_CHUNK_TRAILER_LEN - 1) - event_list_len;
+    if (tlv_encode_container_end(&writer) < 0) {
+        return -1;
+    }
+    
+    // EventReports (tag 2) once every attribute report has been sent
+    if (event_list_len > 0 && !*more) {
+        bool events_more;
+        
+        writer.buffer_size = max_len - (READ_CHUNK_TRAILER_LEN - 1) - 1;
+        if (tlv_encode_array_start(&writer, 2) < 0) {
+            return -1;
+        }
+        written += event_log_encode_reports(&writer, cursor->event_paths,
+                                            cursor->event_path_count,
+                                            &cursor->event_min, &events_more);
+        if (events_more) {
+            if (written == 0) {
                 return -1;
             }
+            *more = true;
         }
         
-        // End AttributeReport structure
+        writer.buffer_size = max_len - (READ_CHUNK_TRAILER_LEN - 1);
         if (tlv_encode_container_end(&writer) < 0) {
             return -1;
         }
     }
     
+    // MoreChunkedMessages (tag 3): the controller answers with a
+    // StatusResponse, then the next chunk follows
+    writer.buffer_size = max_len;
+    if (*more && tlv_encode_bool(&writer, 3, true) < 0) {
+        return -1;
+    }
+    
+    *actual_len = tlv_writer_get_length(&writer);
+    return 0;
+}
+
+/**
+ * Parse a StatusResponse
+ */
+int read_handler_parse_status_response(const uint8_t *payload, size_t len,
+                                       im_status_code_t *status) {
+    tlv_reader_t reader;
+    tlv_element_t element;
+    
+    if (!payload || !status) {
+        return -1;
+    }
+    
+    // StatusResponse ::= { Status [0]: uint8 }
+    tlv_reader_init(&reader, payload, len);
+    while (tlv_reader_next(&reader, &element) == 0) {
+        if (element.tag == 0 && element.type == TLV_TYPE_UNSIGNED_INT) {
+            *status = (im_status_code_t)tlv_read_uint8(&element);
+            return 0;
+        }
+    }
+    
+    return -1;
+}
+
+/**
+ * Encode a StatusResponse
+ */
+int read_handler_encode_status_response(im_status_code_t status, uint8_t *payload,
+                                        size_t max_len, size_t *actual_len) {
+    tlv_writer_t writer;
+    
+    if (!payload || !actual_len) {
+        return -1;
+    }
+    
+    // StatusResponse ::= { Status [0]: uint8 }
+    tlv_writer_init(&writer, payload, max_len);
+    if (tlv_encode_uint8(&writer, 0, (uint8_t)status) < 0) {
+        return -1;
+    }
+    
+    *actual_len = tlv_writer_get_length(&writer);
+    return 0;
+}
+
+/**
+ * Process ReadRequest and encode its first chunk
+ */
+int read_handler_process_request(const uint8_t *request_tlv, size_t request_len,
+                                 uint8_t *response_tlv, size_t max_response_len,
+                                 size_t *actual_len) {
+    read_cursor_t cursor;
+    bool more;
+    
+    if (!request_tlv || !response_tlv || !actual_len) {
+        return -1;
+    }
+    
+    if (read_handler_parse_request(request_tlv, request_len, &cursor) < 0) {
+        return -1;
+    }
+    
+    return read_handler_encode_chunk(&cursor, response_tlv, max_response_len,
+                                     actual_len, &more);
+}
+
+/**
+ * Encode ReadResponse with attribute reports
+ */
+int read_handler_encode_response(const attribute_report_t *reports, size_t count,
+                                 uint8_t *response_tlv, size_t max_len,
+                                 size_t *actual_len) {
+    tlv_writer_t writer;
+    
+    if ((!reports && count > 0) || !response_tlv || !actual_len) {
+        return -1;
+    }
+    
+    // Initialize writer
+    tlv_writer_init(&writer, response_tlv, max_len);
+    
+    // Start AttributeReports list (tag 0); empty when every requested
+    // cluster was filtered out
+    if (tlv_encode_array_start(&writer, 0) < 0) {
+        return -1;
+    }
+    
+    // Encode each attribute report
+    for (size_t i = 0; i < count; i++) {
+        if (encode_attribute_report(&writer, &reports[i]) < 0) {
+            return -1;
+        }
+    }
+    
     // End AttributeReports list
     if (tlv_encode_container_end(&writer) < 0) {
         return -1;
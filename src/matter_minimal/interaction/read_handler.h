@@ -8,8 +8,11 @@
 #define READ_HANDLER_H
 
 #include "interaction_model.h"
+#include "attribute_table.h"
+#include "../codec/tlv_types.h"
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -20,6 +23,20 @@ extern "C" {
  */
 #define MAX_READ_PATHS 16
 
+/**
+ * Maximum number of event paths kept from one request
+ */
+#ifndef MAX_EVENT_PATHS
+#define MAX_EVENT_PATHS 4
+#endif
+
+/**
+ * Maximum number of DataVersionFilters kept from one request
+ */
+#ifndef MAX_DATA_VERSION_FILTERS
+#define MAX_DATA_VERSION_FILTERS 8
+#endif
+
 /**
  * Attribute Report Structure
  * Contains attribute path, data, and status for response
@@ -29,8 +46,30 @@ typedef struct {
     attribute_value_t value;
     attribute_type_t type;
     im_status_code_t status;
+    uint32_t data_version;      // DataVersion of the attribute's cluster
 } attribute_report_t;
 
+/**
+ * Read in progress
+ * A parsed ReadRequest and how far its reports have been encoded.  A
+ * response too large for one packet is sent as several ReadResponse chunks
+ * (MoreChunkedMessages set on all but the last); each chunk continues from
+ * the cursor instead of reading and encoding the request again.  Event
+ * reports follow the attribute reports.
+ */
+typedef struct {
+    attribute_path_t paths[MAX_READ_PATHS];
+    data_version_filter_t filters[MAX_DATA_VERSION_FILTERS];
+    event_path_t event_paths[MAX_EVENT_PATHS];
+    uint8_t path_count;
+    uint8_t filter_count;
+    uint8_t event_path_count;
+    uint8_t path_index;         // Path being reported
+    bool expanding;             // iter holds the expansion of paths[path_index]
+    attribute_iter_t iter;
+    uint64_t event_min;         // Next event number to report
+} read_cursor_t;
+
 /**
  * Initialize read handler
  * Sets up internal state for processing read requests
@@ -39,9 +78,130 @@ typedef struct {
  */
 int read_handler_init(void);
 
+/**
+ * Parse an AttributePath
+ * Reads the path's elements up to (not including) its end of container.
+ * Omitted endpoint, cluster or attribute tags set the matching
+ * ATTR_PATH_WILDCARD_* flag.
+ * 
+ * @param reader TLV reader positioned after the path's container start
+ * @param path Output path
+ * @return 0 on success, -1 on error
+ */
+int read_handler_parse_attribute_path(tlv_reader_t *reader, attribute_path_t *path);
+
+/**
+ * Parse a DataVersionFilters list
+ * Reads DataVersionFilter structures up to and including the list's end of
+ * container.  Filters beyond max_filters are skipped.
+ * 
+ * @param reader TLV reader positioned after the list's container start
+ * @param filters Output filters
+ * @param max_filters Capacity of filters
+ * @param count Set to the number of filters stored
+ * @return 0 on success, -1 on error
+ */
+int read_handler_parse_data_version_filters(tlv_reader_t *reader,
+                                            data_version_filter_t *filters,
+                                            size_t max_filters, size_t *count);
+
+/**
+ * Parse an EventRequests list
+ * Reads EventPath lists up to and including the list's end of container.
+ * Omitted endpoint, cluster or event tags set the matching
+ * EVENT_PATH_WILDCARD_* flag.  Paths beyond max_paths are skipped.
+ * 
+ * @param reader TLV reader positioned after the list's container start
+ * @param paths Output paths
+ * @param max_paths Capacity of paths
+ * @param count Set to the number of paths stored
+ * @return 0 on success, -1 on error
+ */
+int read_handler_parse_event_paths(tlv_reader_t *reader, event_path_t *paths,
+                                   size_t max_paths, size_t *count);
+
+/**
+ * Parse an EventFilters list
+ * Reads EventFilter structures up to and including the list's end of
+ * container.
+ * 
+ * @param reader TLV reader positioned after the list's container start
+ * @param event_min Set to the highest EventMin found (unchanged if none)
+ * @return 0 on success, -1 on error
+ */
+int read_handler_parse_event_filters(tlv_reader_t *reader, uint64_t *event_min);
+
+/**
+ * Check whether a cluster can be left out of a report
+ * True if a filter names the cluster with its current DataVersion.
+ */
+bool read_handler_cluster_filtered(const data_version_filter_t *filters, size_t count,
+                                   uint8_t endpoint, uint32_t cluster_id);
+
+/**
+ * Parse a ReadRequest into a cursor positioned at its first report
+ * 
+ * @param request_tlv Input TLV-encoded ReadRequest
+ * @param request_len Length of request
+ * @param cursor Output read state
+ * @return 0 on success, -1 on error or if the request has neither
+ *         attribute nor event paths
+ */
+int read_handler_parse_request(const uint8_t *request_tlv, size_t request_len,
+                               read_cursor_t *cursor);
+
+/**
+ * Encode the next ReadResponse chunk of a read
+ * Reads and encodes reports from the cursor until the next one does not
+ * fit in max_len, then advances the cursor past the reports written.
+ * Wildcard paths expand to every attribute in the attribute table they
+ * cover; attributes of clusters matching a DataVersionFilter are left out.
+ * Once every attribute report is out, the events matching the event paths
+ * from EventMin on follow in an EventReports list.
+ * 
+ * @param cursor Read state from read_handler_parse_request()
+ * @param response_tlv Output buffer for TLV-encoded ReadResponse
+ * @param max_len Maximum size of response buffer
+ * @param actual_len Pointer to store actual response length
+ * @param more Set when reports remain for another chunk
+ *             (MoreChunkedMessages is set in this one)
+ * @return 0 on success, -1 on error or if a single report does not fit
+ */
+int read_handler_encode_chunk(read_cursor_t *cursor,
+                              uint8_t *response_tlv, size_t max_len,
+                              size_t *actual_len, bool *more);
+
+/**
+ * Parse a StatusResponse
+ * The controller's answer to a chunk sent with MoreChunkedMessages.
+ * 
+ * @param payload Input TLV-encoded StatusResponse
+ * @param len Length of payload
+ * @param status Set to the reported status
+ * @return 0 on success, -1 if the message has no status
+ */
+int read_handler_parse_status_response(const uint8_t *payload, size_t len,
+                                       im_status_code_t *status);
+
+/**
+ * Encode a StatusResponse
+ * Answers a chunk the controller sent, or replaces the response of a
+ * TimedRequest, WriteRequest or InvokeRequest that failed as a whole.
+ * 
+ * @param status Status to report
+ * @param payload Output buffer for TLV-encoded StatusResponse
+ * @param max_len Maximum size of payload
+ * @param actual_len Pointer to store actual length
+ * @return 0 on success, -1 if the buffer is too small
+ */
+int read_handler_encode_status_response(im_status_code_t status, uint8_t *payload,
+                                        size_t max_len, size_t *actual_len);
+
 /**
  * Process a ReadRequest message
- * Parses the request TLV, reads requested attributes, and encodes response
+ * Parses the request TLV and encodes its first ReadResponse chunk
+ * (everything, if it fits).  Callers that send the remaining chunks use
+ * read_handler_parse_request() and read_handler_encode_chunk() instead.
  * 
  * @param request_tlv Input TLV-encoded ReadRequest
  * @param request_len Length of request
@@ -56,7 +216,7 @@ int read_handler_process_request(const uint8_t *request_tlv, size_t request_len,
 
 /**
  * Encode a ReadResponse message
- * Encodes attribute reports into TLV format
+ * Encodes attribute reports into TLV format (count may be 0)
  * 
  * @param reports Array of attribute reports
  * @param count Number of reports
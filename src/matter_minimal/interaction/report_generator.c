@@ -5,25 +5,21 @@
 
 #include "report_generator.h"
 #include "read_handler.h"
+#include "attribute_table.h"
+#include "event_log.h"
 #include "../codec/tlv.h"
 #include "../codec/tlv_types.h"
+#include "../codec/msg_pool.h"
 #include <string.h>
 
-// Forward declarations of cluster read functions
-extern int cluster_descriptor_read(uint8_t endpoint, uint32_t attr_id, 
-                                   attribute_value_t *value, attribute_type_t *type);
-extern int cluster_onoff_read(uint8_t endpoint, uint32_t attr_id,
-                             attribute_value_t *value, attribute_type_t *type);
-extern int cluster_level_control_read(uint8_t endpoint, uint32_t attr_id,
-                                      attribute_value_t *value, attribute_type_t *type);
-extern int cluster_temperature_read(uint8_t endpoint, uint32_t attr_id,
-                                   attribute_value_t *value, attribute_type_t *type);
-extern int cluster_diagnostics_read(uint8_t endpoint, uint32_t attr_id,
-                                   attribute_value_t *value, attribute_type_t *type);
-extern int cluster_basic_read(uint8_t endpoint, uint32_t attr_id,
-                              attribute_value_t *value, attribute_type_t *type);
+/**
+ * Room kept for MoreChunkedMessages (control, tag, value) in a report
+ * that may be followed by another chunk
+ */
+#define REPORT_MORE_CHUNKS_LEN 3
 
 static bool initialized = false;
+static report_send_fn report_sender = NULL;
 
 /**
  * Initialize report generator
@@ -38,52 +34,10 @@ int report_generator_init(void) {
 }
 
 /**
- * Route attribute read to appropriate cluster handler
+ * Set the ReportData transport
  */
-static int route_attribute_read(const attribute_path_t *path,
-                               attribute_value_t *value,
-                               attribute_type_t *type,
-                               im_status_code_t *status) {
-    int result;
-    
-    // Route to appropriate cluster
-    switch (path->cluster_id) {
-        case 0x001D: // Descriptor
-            result = cluster_descriptor_read(path->endpoint, path->attribute_id, value, type);
-            break;
-            
-        case 0x0006: // OnOff
-            result = cluster_onoff_read(path->endpoint, path->attribute_id, value, type);
-            break;
-            
-        case 0x0008: // LevelControl
-            result = cluster_level_control_read(path->endpoint, path->attribute_id, value, type);
-            break;
-            
-        case 0x0402: // TemperatureMeasurement
-            result = cluster_temperature_read(path->endpoint, path->attribute_id, value, type);
-            break;
-            
-        case 0x0033: // GeneralDiagnostics
-            result = cluster_diagnostics_read(path->endpoint, path->attribute_id, value, type);
-            break;
-            
-        case 0x0028: // BasicInformation
-            result = cluster_basic_read(path->endpoint, path->attribute_id, value, type);
-            break;
-            
-        default:
-            *status = IM_STATUS_UNSUPPORTED_CLUSTER;
-            return -1;
-    }
-    
-    if (result < 0) {
-        *status = IM_STATUS_UNSUPPORTED_ATTRIBUTE;
-        return -1;
-    }
-    
-    *status = IM_STATUS_SUCCESS;
-    return 0;
+void report_generator_set_sender(report_send_fn send) {
+    report_sender = send;
 }
 
 /**
@@ -160,8 +114,8 @@ int report_generator_encode_attribute_reports(const attribute_report_t *reports,
                 return -1;
             }
             
-            // DataVersion (tag 0) - optional, use 0
-            if (tlv_encode_uint32(&writer, 0, 0) < 0) {
+            // DataVersion (tag 0)
+            if (tlv_encode_uint32(&writer, 0, report->data_version) < 0) {
                 return -1;
             }
             
@@ -248,7 +202,7 @@ int report_generator_encode_report(uint32_t subscription_id,
                                    size_t *actual_len) {
     tlv_writer_t writer;
     
-    if (!reports || !tlv_out || !actual_len || count == 0 || !initialized) {
+    if ((!reports && count > 0) || !tlv_out || !actual_len || !initialized) {
         return -1;
     }
     
@@ -259,7 +213,7 @@ int report_generator_encode_report(uint32_t subscription_id,
     // {
     //   SubscriptionId [0]: uint32
     //   AttributeReports [1]: Array of AttributeReport
-    //   EventReports [2]: (optional, skip)
+    //   EventReports [2]: Array of EventReport (appended by send_report)
     //   MoreChunkedMessages [3]: bool (optional)
     //   SuppressResponse [4]: bool (optional)
     // }
@@ -269,6 +223,12 @@ int report_generator_encode_report(uint32_t subscription_id,
         return -1;
     }
     
+    // A keep-alive report carries only the SubscriptionId
+    if (count == 0) {
+        *actual_len = tlv_writer_get_length(&writer);
+        return 0;
+    }
+    
     // Encode AttributeReports inline (same format as report_generator_encode_attribute_reports)
     // Start AttributeReports list (tag 1)
     if (tlv_encode_array_start(&writer, 1) < 0) {
@@ -328,8 +288,8 @@ int report_generator_encode_report(uint32_t subscription_id,
                 return -1;
             }
             
-            // DataVersion (tag 0) - optional, use 0
-            if (tlv_encode_uint32(&writer, 0, 0) < 0) {
+            // DataVersion (tag 0)
+            if (tlv_encode_uint32(&writer, 0, report->data_version) < 0) {
                 return -1;
             }
             
@@ -407,13 +367,47 @@ int report_generator_encode_report(uint32_t subscription_id,
     return 0;
 }
 
+/**
+ * Append EventReports [2] to an encoded ReportData
+ * Events that do not fit stay for the next report (*more set).
+ */
+static int append_event_reports(uint8_t *tlv_out, size_t max_len, size_t *len,
+                                const event_path_t *event_paths, size_t event_count,
+                                uint64_t *event_min, bool *more) {
+    tlv_writer_t writer;
+    
+    *more = true;
+    if (max_len <= *len) {
+        return 0;
+    }
+    
+    // The end of the list is kept free while events are encoded
+    tlv_writer_init(&writer, tlv_out, max_len - 1);
+    writer.offset = *len;
+    if (tlv_encode_array_start(&writer, 2) < 0) {
+        return 0;
+    }
+    event_log_encode_reports(&writer, event_paths, event_count, event_min, more);
+    
+    writer.buffer_size = max_len;
+    if (tlv_encode_container_end(&writer) < 0) {
+        return -1;
+    }
+    
+    *len = tlv_writer_get_length(&writer);
+    return 0;
+}
+
 /**
  * Send a ReportData message
  */
 int report_generator_send_report(uint16_t session_id, uint32_t subscription_id,
-                                 const attribute_path_t *paths, size_t count) {
-    if (!initialized || !paths || count == 0) {
-        return -1;
+                                 const attribute_path_t *paths, size_t count,
+                                 const event_path_t *event_paths, size_t event_count,
+                                 uint64_t *event_min, bool *more) {
+    if (!initialized || (!paths && count > 0) ||
+        ((!event_paths || !event_min) && event_count > 0)) {
+        return REPORT_SEND_RETRY;
     }
     
     // Build attribute reports by reading current values
@@ -424,31 +418,67 @@ int report_generator_send_report(uint16_t session_id, uint32_t subscription_id,
         attribute_report_t *report = &reports[report_count];
         report->path = paths[i];
         
-        if (route_attribute_read(&paths[i], &report->value, 
-                               &report->type, &report->status) == 0) {
-            report_count++;
-        } else {
-            // Add error report
-            report_count++;
-        }
+        // Failed reads are reported as AttributeStatus
+        report->data_version = 0;
+        attribute_table_get_data_version(paths[i].endpoint, paths[i].cluster_id,
+                                         &report->data_version);
+        attribute_table_read(&paths[i], &report->value,
+                             &report->type, &report->status);
+        report_count++;
     }
     
-    // Encode ReportData
-    uint8_t report_tlv[1024];
+    // Encode ReportData at the payload offset of a message pool block
+    packet_buffer_t *pb = msg_pool_alloc();
     size_t report_len;
+    bool events_more = false;
+    
+    if (!pb) {
+        return REPORT_SEND_RETRY;
+    }
+    
+    // A chunk keeps room for MoreChunkedMessages after its reports
+    size_t room = packet_buffer_tailroom(pb);
+    if (more) {
+        room = room > REPORT_MORE_CHUNKS_LEN ? room - REPORT_MORE_CHUNKS_LEN : 0;
+    }
     
     if (report_generator_encode_report(subscription_id, reports, report_count,
-                                       report_tlv, sizeof(report_tlv),
-                                       &report_len) < 0) {
-        return -1;
+                                       packet_buffer_tail(pb), room,
+                                       &report_len) < 0 ||
+        (event_count > 0 &&
+         append_event_reports(packet_buffer_tail(pb), room, &report_len,
+                              event_paths, event_count, event_min,
+                              &events_more) < 0)) {
+        msg_pool_release(pb);
+        return REPORT_SEND_RETRY;
+    }
+    
+    // MoreChunkedMessages (tag 3): the subscriber answers with a
+    // StatusResponse, then the next chunk follows
+    if (more) {
+        *more = *more || events_more;
+        
+        tlv_writer_t writer;
+        tlv_writer_init(&writer, packet_buffer_tail(pb), packet_buffer_tailroom(pb));
+        writer.offset = report_len;
+        if (*more && tlv_encode_bool(&writer, 3, true) < 0) {
+            msg_pool_release(pb);
+            return REPORT_SEND_RETRY;
+        }
+        report_len = tlv_writer_get_length(&writer);
     }
     
-    // Note: In a full implementation, this would:
-    // 1. Encrypt the payload using session_encrypt(session_id, ...)
-    // 2. Send via matter_protocol_send() or matter_transport_send()
-    // For now, we just return success
+    if (packet_buffer_commit(pb, report_len) < 0) {
+        msg_pool_release(pb);
+        return REPORT_SEND_RETRY;
+    }
     
-    (void)session_id; // Suppress unused warning
+    // No transport (host tests): the report is encoded and dropped
+    if (!report_sender) {
+        msg_pool_release(pb);
+        return REPORT_SEND_OK;
+    }
     
-    return 0;
+    // The transport encrypts in place on the subscriber's session
+    return report_sender(session_id, pb);
 }
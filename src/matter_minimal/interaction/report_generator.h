@@ -9,6 +9,7 @@
 
 #include "interaction_model.h"
 #include "read_handler.h"
+#include "../codec/packet_buffer.h"
 #include <stdint.h>
 #include <stddef.h>
 
@@ -16,6 +17,24 @@
 extern "C" {
 #endif
 
+/**
+ * Report transmit results
+ */
+#define REPORT_SEND_OK              0
+#define REPORT_SEND_RETRY           -1      // Transient failure, try again later
+#define REPORT_SEND_NO_SESSION      -2      // Session is gone, drop the subscription
+
+/**
+ * Report transmit callback
+ * Sends the ReportData payload committed in pb as an Interaction Model
+ * ReportData message on a secure session.  Takes ownership of pb.
+ *
+ * @param session_id Local session ID of the subscriber
+ * @param pb Message pool block holding the encoded ReportData payload
+ * @return REPORT_SEND_OK, REPORT_SEND_RETRY or REPORT_SEND_NO_SESSION
+ */
+typedef int (*report_send_fn)(uint16_t session_id, packet_buffer_t *pb);
+
 /**
  * Initialize report generator
  * Sets up internal state for generating reports
@@ -24,26 +43,48 @@ extern "C" {
  */
 int report_generator_init(void);
 
+/**
+ * Set the transport for ReportData messages
+ * Without one (host tests) reports are encoded and dropped.
+ *
+ * @param send Transmit callback, NULL to clear
+ */
+void report_generator_set_sender(report_send_fn send);
+
 /**
  * Send a ReportData message for a subscription
- * Reads current attribute values and generates a report
+ * Reads current attribute values and generates a report, followed by the
+ * logged events matching event_paths from *event_min on (as many as fit).
+ * With no attributes and no events the report carries only the
+ * SubscriptionId (max-interval keep-alive).
  * 
  * @param session_id Session ID
  * @param subscription_id Subscription ID triggering this report
- * @param paths Array of attribute paths to report
+ * @param paths Array of attribute paths to report (may be NULL if count is 0)
  * @param count Number of paths
- * @return 0 on success, negative on error
+ * @param event_paths Event paths to report (may be NULL if event_count is 0)
+ * @param event_count Number of event paths
+ * @param event_min Next event number to report; advanced past the events
+ *                  encoded (may be NULL if event_count is 0)
+ * @param more NULL for a report on its own.  For a chunk of a chunked
+ *             report: set on entry if attributes are left for a following
+ *             chunk, set on return if MoreChunkedMessages was encoded
+ *             (attributes or events left)
+ * @return REPORT_SEND_OK, REPORT_SEND_RETRY or REPORT_SEND_NO_SESSION
  */
 int report_generator_send_report(uint16_t session_id, uint32_t subscription_id,
-                                 const attribute_path_t *paths, size_t count);
+                                 const attribute_path_t *paths, size_t count,
+                                 const event_path_t *event_paths, size_t event_count,
+                                 uint64_t *event_min, bool *more);
 
 /**
  * Encode a ReportData message
  * Encodes subscription ID and attribute reports into TLV format
+ * AttributeReports is omitted when count is 0 (keep-alive report).
  * 
  * @param subscription_id Subscription ID
  * @param reports Array of attribute reports (same format as ReadResponse)
- * @param count Number of reports
+ * @param count Number of reports (may be 0)
  * @param tlv_out Output buffer for TLV-encoded ReportData
  * @param max_len Maximum size of output buffer
  * @param actual_len Pointer to store actual output length
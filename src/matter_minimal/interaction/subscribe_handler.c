@@ -5,6 +5,7 @@
 
 #include "subscribe_handler.h"
 #include "report_generator.h"
+#include "event_log.h"
 #include "../codec/tlv.h"
 #include "../codec/tlv_types.h"
 #include <string.h>
@@ -14,6 +15,95 @@ static subscription_t subscriptions[MAX_SUBSCRIPTIONS];
 static uint32_t next_subscription_id = 1;
 static bool initialized = false;
 
+// Report deadlines: min-heap of subscription indices on next_report_time
+static uint8_t report_queue[MAX_SUBSCRIPTIONS];
+static uint8_t report_queue_len = 0;
+
+// Latest time seen by the engine, used to schedule new subscriptions
+static uint32_t engine_now = 0;
+
+/**
+ * Wraparound-safe "a is earlier than b" for millisecond timestamps
+ */
+static inline bool time_before(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) < 0;
+}
+
+static inline uint32_t queue_deadline(uint8_t pos) {
+    return subscriptions[report_queue[pos]].next_report_time;
+}
+
+static void queue_swap(uint8_t a, uint8_t b) {
+    uint8_t tmp = report_queue[a];
+    report_queue[a] = report_queue[b];
+    report_queue[b] = tmp;
+    subscriptions[report_queue[a]].queue_index = a;
+    subscriptions[report_queue[b]].queue_index = b;
+}
+
+static void queue_sift_up(uint8_t pos) {
+    while (pos > 0) {
+        uint8_t parent = (uint8_t)((pos - 1) / 2);
+        if (!time_before(queue_deadline(pos), queue_deadline(parent))) {
+            break;
+        }
+        queue_swap(pos, parent);
+        pos = parent;
+    }
+}
+
+static void queue_sift_down(uint8_t pos) {
+    for (;;) {
+        uint8_t smallest = pos;
+        uint8_t left = (uint8_t)(2 * pos + 1);
+        uint8_t right = (uint8_t)(2 * pos + 2);
+        
+        if (left < report_queue_len &&
+            time_before(queue_deadline(left), queue_deadline(smallest))) {
+            smallest = left;
+        }
+        if (right < report_queue_len &&
+            time_before(queue_deadline(right), queue_deadline(smallest))) {
+            smallest = right;
+        }
+        if (smallest == pos) {
+            break;
+        }
+        queue_swap(pos, smallest);
+        pos = smallest;
+    }
+}
+
+static void queue_push(subscription_t *sub) {
+    uint8_t pos = report_queue_len++;
+    report_queue[pos] = (uint8_t)(sub - subscriptions);
+    sub->queue_index = pos;
+    queue_sift_up(pos);
+}
+
+static void queue_remove(subscription_t *sub) {
+    uint8_t pos = sub->queue_index;
+    uint8_t last = --report_queue_len;
+    
+    // Move the last entry into the hole and restore heap order around it
+    if (pos != last) {
+        queue_swap(pos, last);
+        subscription_t *moved = &subscriptions[report_queue[pos]];
+        queue_sift_up(pos);
+        queue_sift_down(moved->queue_index);
+    }
+}
+
+/**
+ * Deactivate a subscription and drop its deadline
+ */
+static void release_subscription(subscription_t *sub) {
+    if (!sub->priming) {
+        queue_remove(sub);
+    }
+    sub->active = false;
+}
+
 /**
  * Initialize subscription handler
  */
@@ -25,6 +115,7 @@ int subscribe_handler_init(void) {
     // Clear all subscriptions
     memset(subscriptions, 0, sizeof(subscriptions));
     next_subscription_id = 1;
+    report_queue_len = 0;
     
     // Initialize report generator
     if (report_generator_init() < 0) {
@@ -61,54 +152,71 @@ static subscription_t* find_subscription_by_id(uint32_t subscription_id) {
 }
 
 /**
- * Parse AttributePath from TLV structure
+ * Table entries a path covers whose value can be reported
+ * List attributes cannot be encoded yet and are left out.
  */
-static int parse_attribute_path(tlv_reader_t *reader, attribute_path_t *path) {
-    tlv_element_t element;
-    
-    // AttributePath is a list with tags 0-4
-    memset(path, 0, sizeof(attribute_path_t));
-    
-    // Read elements until we hit the end of the structure
-    while (!tlv_reader_is_end(reader)) {
-        if (tlv_reader_peek(reader, &element) < 0) {
-            break;
-        }
-        
-        // Check if we've hit a container end
-        if (element.type == TLV_TYPE_END_OF_CONTAINER) {
-            break;
+static attribute_mask_t path_interest(const attribute_path_t *path) {
+    attribute_iter_t it;
+    const attribute_entry_t *entry;
+    attribute_mask_t mask = 0;
+    size_t index;
+    
+    attribute_table_iter_init(&it, path);
+    while ((entry = attribute_table_iter_next(&it, &index)) != NULL) {
+        if (!(entry->quality & ATTR_QUALITY_LIST)) {
+            mask |= ATTRIBUTE_MASK_BIT(index);
         }
-        
-        if (tlv_reader_next(reader, &element) < 0) {
-            return -1;
+    }
+    return mask;
+}
+
+/**
+ * Concrete path the first report answers with a status
+ */
+static bool path_needs_status(const attribute_path_t *path) {
+    if (path->wildcard != 0) {
+        return false;
+    }
+    const attribute_entry_t *entry = attribute_table_find(path->endpoint, path->cluster_id,
+                                                          path->attribute_id, NULL);
+    return !entry || (entry->quality & ATTR_QUALITY_LIST);
+}
+
+/**
+ * Leave clusters the controller already has out of the first report
+ */
+static void apply_data_version_filters(subscription_t *sub,
+                                       const data_version_filter_t *filters,
+                                       size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (!read_handler_cluster_filtered(&filters[i], 1, filters[i].endpoint,
+                                           filters[i].cluster_id)) {
+            continue;
         }
         
-        switch (element.tag) {
-            case 0: // Endpoint
-                path->endpoint = tlv_read_uint8(&element);
-                break;
-            case 2: // Cluster ID
-                path->cluster_id = element.value.u32;
-                break;
-            case 3: // Attribute ID
-                path->attribute_id = element.value.u32;
-                break;
-            default:
-                // Ignore unknown tags
-                break;
-        }
+        attribute_path_t cluster_path = {
+            .endpoint = filters[i].endpoint,
+            .cluster_id = filters[i].cluster_id,
+            .wildcard = ATTR_PATH_WILDCARD_ATTRIBUTE,
+        };
+        sub->dirty &= ~attribute_table_match_mask(&cluster_path);
     }
-    
-    return 0;
 }
 
 /**
- * Add a new subscription
+ * Create a subscription for attribute and event paths (either may be empty)
+ * A priming subscription stays out of the deadline heap until
+ * subscribe_handler_activate().
  */
-uint32_t subscribe_handler_add(uint16_t session_id, const attribute_path_t *path,
-                               uint16_t min_interval, uint16_t max_interval) {
-    if (!initialized || !path) {
+static uint32_t add_subscription(uint16_t session_id,
+                                 const attribute_path_t *paths, size_t count,
+                                 const event_path_t *event_paths, size_t event_count,
+                                 uint64_t event_min,
+                                 uint16_t min_interval, uint16_t max_interval,
+                                 bool priming) {
+    if (!initialized || (!paths && count > 0) || (!event_paths && event_count > 0) ||
+        count + event_count == 0 || count > SUBSCRIPTION_MAX_PATHS ||
+        event_count > SUBSCRIPTION_MAX_EVENT_PATHS) {
         return 0;
     }
     
@@ -118,20 +226,71 @@ uint32_t subscribe_handler_add(uint16_t session_id, const attribute_path_t *path
         return 0; // No free slots
     }
     
+    // Keep-alives at least every min_interval, and never back to back
+    if (max_interval < min_interval) {
+        max_interval = min_interval;
+    }
+    if (max_interval == 0) {
+        max_interval = 1;
+    }
+    
     // Initialize subscription
     sub->session_id = session_id;
     sub->subscription_id = next_subscription_id++;
-    sub->endpoint = path->endpoint;
-    sub->cluster_id = path->cluster_id;
-    sub->attribute_id = path->attribute_id;
+    if (count > 0) {
+        memcpy(sub->paths, paths, count * sizeof(attribute_path_t));
+    }
+    sub->path_count = (uint8_t)count;
+    if (event_count > 0) {
+        memcpy(sub->event_paths, event_paths, event_count * sizeof(event_path_t));
+    }
+    sub->event_path_count = (uint8_t)event_count;
+    sub->event_min = event_min;
     sub->min_interval = min_interval;
     sub->max_interval = max_interval;
-    sub->last_report_time = 0;
     sub->active = true;
     
+    // First report (current values of everything covered) goes out on
+    // the next pass, or as the priming reports
+    sub->interest = 0;
+    for (size_t i = 0; i < count; i++) {
+        sub->interest |= path_interest(&paths[i]);
+    }
+    sub->dirty = sub->interest;
+    sub->events_pending = event_log_pending(event_paths, event_count, event_min);
+    sub->primed = false;
+    sub->priming = priming;
+    sub->last_report_time = engine_now;
+    sub->next_report_time = engine_now;
+    if (!priming) {
+        queue_push(sub);
+    }
+    
     return sub->subscription_id;
 }
 
+/**
+ * Add a new subscription
+ */
+uint32_t subscribe_handler_add_paths(uint16_t session_id,
+                                     const attribute_path_t *paths, size_t count,
+                                     uint16_t min_interval, uint16_t max_interval) {
+    if (!paths || count == 0) {
+        return 0;
+    }
+    return add_subscription(session_id, paths, count, NULL, 0, 0,
+                            min_interval, max_interval, false);
+}
+
+/**
+ * Add a new single-path subscription
+ */
+uint32_t subscribe_handler_add(uint16_t session_id, const attribute_path_t *path,
+                               uint16_t min_interval, uint16_t max_interval) {
+    return subscribe_handler_add_paths(session_id, path, 1,
+                                       min_interval, max_interval);
+}
+
 /**
  * Remove a subscription
  */
@@ -142,10 +301,22 @@ int subscribe_handler_remove(uint16_t session_id, uint32_t subscription_id) {
         return -1;
     }
     
-    sub->active = false;
+    release_subscription(sub);
     return 0;
 }
 
+/**
+ * Check whether a session has any subscription
+ */
+static bool has_session_subscription(uint16_t session_id) {
+    for (int i = 0; i < MAX_SUBSCRIPTIONS; i++) {
+        if (subscriptions[i].active && subscriptions[i].session_id == session_id) {
+            return true;
+        }
+    }
+    return false;
+}
+
 /**
  * Remove all subscriptions for a session
  */
@@ -155,7 +326,7 @@ int subscribe_handler_remove_all_for_session(uint16_t session_id) {
     for (int i = 0; i < MAX_SUBSCRIPTIONS; i++) {
         if (subscriptions[i].active && 
             subscriptions[i].session_id == session_id) {
-            subscriptions[i].active = false;
+            release_subscription(&subscriptions[i]);
             count++;
         }
     }
@@ -168,18 +339,28 @@ int subscribe_handler_remove_all_for_session(uint16_t session_id) {
  */
 int subscribe_handler_process_request(const uint8_t *request_tlv, size_t request_len,
                                       uint8_t *response_tlv, size_t max_response_len,
-                                      size_t *actual_len, uint16_t session_id) {
+                                      size_t *actual_len, uint16_t session_id,
+                                      uint32_t *subscription_id_out,
+                                      im_status_code_t *status) {
     tlv_reader_t reader;
     tlv_element_t element;
-    attribute_path_t paths[MAX_READ_PATHS];
+    // One path more than a subscription holds, to tell a request that has
+    // too many apart from one that fits exactly
+    attribute_path_t paths[SUBSCRIPTION_MAX_PATHS + 1];
     size_t path_count = 0;
     uint16_t min_interval = 1;  // Default 1 second
     uint16_t max_interval = 10; // Default 10 seconds
     bool keep_subscriptions = false;
+    data_version_filter_t filters[MAX_DATA_VERSION_FILTERS];
+    size_t filter_count = 0;
+    event_path_t event_paths[SUBSCRIPTION_MAX_EVENT_PATHS + 1];
+    size_t event_path_count = 0;
+    uint64_t event_min = 0;
     
-    if (!request_tlv || !response_tlv || !actual_len || !initialized) {
+    if (!request_tlv || !response_tlv || !actual_len || !status || !initialized) {
         return -1;
     }
+    *status = IM_STATUS_INVALID_ACTION;
     
     // Initialize reader
     tlv_reader_init(&reader, request_tlv, request_len);
@@ -187,10 +368,12 @@ int subscribe_handler_process_request(const uint8_t *request_tlv, size_t request
     // Parse SubscribeRequest structure
     // SubscribeRequest ::= {
     //   AttributeRequests [0]: List of AttributePath (optional)
-    //   EventRequests [1]: (optional, skip)
+    //   EventRequests [1]: List of EventPath (optional)
     //   MinIntervalFloor [2]: uint16
     //   MaxIntervalCeiling [3]: uint16
     //   KeepSubscriptions [4]: bool (optional, default false)
+    //   EventFilters [5]: List of EventFilter (optional)
+    //   DataVersionFilters [8]: List of DataVersionFilter (optional)
     // }
     
     while (!tlv_reader_is_end(&reader)) {
@@ -202,7 +385,7 @@ int subscribe_handler_process_request(const uint8_t *request_tlv, size_t request
             case 0: // AttributeRequests (tag 0)
                 if (element.type == TLV_TYPE_LIST || element.type == TLV_TYPE_ARRAY) {
                     // Parse each AttributePath in the list
-                    while (!tlv_reader_is_end(&reader) && path_count < MAX_READ_PATHS) {
+                    while (!tlv_reader_is_end(&reader)) {
                         if (tlv_reader_peek(&reader, &element) < 0) {
                             break;
                         }
@@ -216,9 +399,12 @@ int subscribe_handler_process_request(const uint8_t *request_tlv, size_t request
                             element.type == TLV_TYPE_STRUCTURE) {
                             tlv_reader_skip(&reader); // Skip container start
                             
-                            // Parse attribute path
-                            if (parse_attribute_path(&reader, &paths[path_count]) == 0) {
-                                path_count++;
+                            // Parse attribute path; the count stops one
+                            // past the limit
+                            attribute_path_t path;
+                            if (read_handler_parse_attribute_path(&reader, &path) == 0 &&
+                                path_count <= SUBSCRIPTION_MAX_PATHS) {
+                                paths[path_count++] = path;
                             }
                             
                             // Skip to end of structure
@@ -237,6 +423,16 @@ int subscribe_handler_process_request(const uint8_t *request_tlv, size_t request
                 }
                 break;
                 
+            case 1: // EventRequests (tag 1)
+                if (element.type == TLV_TYPE_LIST || element.type == TLV_TYPE_ARRAY) {
+                    if (read_handler_parse_event_paths(&reader, event_paths,
+                                                       SUBSCRIPTION_MAX_EVENT_PATHS + 1,
+                                                       &event_path_count) < 0) {
+                        return -1;
+                    }
+                }
+                break;
+                
             case 2: // MinIntervalFloor (tag 2)
                 min_interval = element.value.u16;
                 break;
@@ -249,30 +445,63 @@ int subscribe_handler_process_request(const uint8_t *request_tlv, size_t request
                 keep_subscriptions = element.value.boolean;
                 break;
                 
+            case 5: // EventFilters (tag 5)
+                if (element.type == TLV_TYPE_LIST || element.type == TLV_TYPE_ARRAY) {
+                    if (read_handler_parse_event_filters(&reader, &event_min) < 0) {
+                        return -1;
+                    }
+                }
+                break;
+                
+            case 8: // DataVersionFilters (tag 8)
+                if (element.type == TLV_TYPE_LIST || element.type == TLV_TYPE_ARRAY) {
+                    if (read_handler_parse_data_version_filters(&reader, filters,
+                                                                MAX_DATA_VERSION_FILTERS,
+                                                                &filter_count) < 0) {
+                        return -1;
+                    }
+                }
+                break;
+                
             default:
                 // Skip unknown tags
                 break;
         }
     }
     
+    if (path_count + event_path_count == 0) {
+        return -1;
+    }
+    
+    // Check the request fits before the session's subscriptions are dropped:
+    // within the path limits, and a slot free or about to be freed
+    if (path_count > SUBSCRIPTION_MAX_PATHS ||
+        event_path_count > SUBSCRIPTION_MAX_EVENT_PATHS ||
+        (!find_free_slot() &&
+         (keep_subscriptions || !has_session_subscription(session_id)))) {
+        *status = IM_STATUS_RESOURCE_EXHAUSTED;
+        return -1;
+    }
+    
     // Clear existing subscriptions if KeepSubscriptions is false
     if (!keep_subscriptions) {
         subscribe_handler_remove_all_for_session(session_id);
     }
     
-    // Create subscriptions for each path
-    uint32_t first_subscription_id = 0;
-    for (size_t i = 0; i < path_count; i++) {
-        uint32_t sub_id = subscribe_handler_add(session_id, &paths[i], 
-                                                min_interval, max_interval);
-        if (sub_id > 0 && first_subscription_id == 0) {
-            first_subscription_id = sub_id;
-        }
+    // One subscription for all paths
+    uint32_t subscription_id = add_subscription(session_id, paths, path_count,
+                                                event_paths, event_path_count, event_min,
+                                                min_interval, max_interval, true);
+    if (subscription_id == 0) {
+        *status = IM_STATUS_RESOURCE_EXHAUSTED;
+        return -1;
     }
     
-    if (first_subscription_id == 0) {
-        return -1; // Failed to create any subscriptions
-    }
+    subscription_t *sub = find_subscription_by_id(subscription_id);
+    apply_data_version_filters(sub, filters, filter_count);
+    
+    // Report the interval actually granted
+    max_interval = sub->max_interval;
     
     // Encode SubscribeResponse
     // SubscribeResponse ::= {
@@ -283,7 +512,7 @@ int subscribe_handler_process_request(const uint8_t *request_tlv, size_t request
     tlv_writer_t writer;
     tlv_writer_init(&writer, response_tlv, max_response_len);
     
-    if (tlv_encode_uint32(&writer, 0, first_subscription_id) < 0) {
+    if (tlv_encode_uint32(&writer, 0, subscription_id) < 0) {
         return -1;
     }
     
@@ -292,42 +521,193 @@ int subscribe_handler_process_request(const uint8_t *request_tlv, size_t request
     }
     
     *actual_len = tlv_writer_get_length(&writer);
+    if (subscription_id_out) {
+        *subscription_id_out = subscription_id;
+    }
     return 0;
 }
 
 /**
- * Check if any subscriptions need interval-based reports
+ * Send one subscription's report: its dirty attributes in table order and
+ * pending events, or a keep-alive.  The first report also carries a status
+ * for each concrete path the device cannot report.
+ *
+ * @param sent Set to the dirty attributes included
+ * @param event_min Set past the events included
+ * @param more NULL, or set if the report is a chunk with more to follow
+ *             (see report_generator_send_report())
+ */
+static int send_subscription_report(const subscription_t *sub, attribute_mask_t *sent,
+                                    uint64_t *event_min, bool *more) {
+    attribute_path_t paths[MAX_READ_PATHS];
+    size_t count = 0;
+    
+    *sent = 0;
+    
+    if (!sub->primed) {
+        for (uint8_t p = 0; p < sub->path_count && count < MAX_READ_PATHS; p++) {
+            if (path_needs_status(&sub->paths[p])) {
+                paths[count++] = sub->paths[p];
+            }
+        }
+    }
+    
+    attribute_mask_t pending = sub->dirty;
+    while (pending != 0 && count < MAX_READ_PATHS) {
+        size_t index = (size_t)__builtin_ctzll(pending);
+        const attribute_entry_t *entry = attribute_table_get(index);
+        attribute_path_t *path = &paths[count++];
+        
+        memset(path, 0, sizeof(*path));
+        path->endpoint = entry->endpoint;
+        path->cluster_id = entry->cluster_id;
+        path->attribute_id = entry->attribute_id;
+        
+        pending &= pending - 1;
+        *sent |= ATTRIBUTE_MASK_BIT(index);
+    }
+    
+    *event_min = sub->event_min;
+    if (more) {
+        *more = (sub->dirty & ~*sent) != 0;
+    }
+    return report_generator_send_report(sub->session_id, sub->subscription_id,
+                                        paths, count,
+                                        sub->events_pending ? sub->event_paths : NULL,
+                                        sub->events_pending ? sub->event_path_count : 0,
+                                        event_min, more);
+}
+
+/**
+ * Record a report that went out
+ */
+static void report_done(subscription_t *sub, attribute_mask_t sent,
+                        uint64_t event_min, uint32_t current_time) {
+    sub->last_report_time = current_time;
+    sub->dirty &= ~sent;
+    sub->event_min = event_min;
+    sub->events_pending = event_log_pending(sub->event_paths, sub->event_path_count,
+                                            sub->event_min);
+    sub->primed = true;
+}
+
+/**
+ * Send the next priming report of a new subscription
+ */
+int subscribe_handler_send_priming(uint32_t subscription_id, uint32_t current_time,
+                                   bool *more) {
+    subscription_t *sub = find_subscription_by_id(subscription_id);
+    attribute_mask_t sent;
+    uint64_t event_min;
+    
+    if (!initialized || !sub || !sub->priming || !more) {
+        return REPORT_SEND_RETRY;
+    }
+    
+    engine_now = current_time;
+    int rc = send_subscription_report(sub, &sent, &event_min, more);
+    if (rc == REPORT_SEND_OK) {
+        report_done(sub, sent, event_min, current_time);
+    }
+    return rc;
+}
+
+/**
+ * Send the reports that are due
  */
 int subscribe_handler_check_intervals(uint32_t current_time) {
     if (!initialized) {
         return -1;
     }
     
-    int reports_generated = 0;
-    
-    for (int i = 0; i < MAX_SUBSCRIPTIONS; i++) {
-        subscription_t *sub = &subscriptions[i];
+    int reports_sent = 0;
+    engine_now = current_time;
+    
+    // Rescheduled deadlines are in the future, except for a subscription
+    // with more dirty attributes than fit one report, which goes again
+    // until they are all sent
+    while (report_queue_len > 0 &&
+           !time_before(current_time, queue_deadline(0))) {
+        subscription_t *sub = &subscriptions[report_queue[0]];
+        attribute_mask_t sent;
+        uint64_t event_min;
+        int rc = send_subscription_report(sub, &sent, &event_min, NULL);
         
-        if (!sub->active) {
+        if (rc == REPORT_SEND_NO_SESSION) {
+            release_subscription(sub);
             continue;
         }
         
-        // Check if max_interval has elapsed
-        // Handle wraparound by computing difference (works for wraparound up to 2^31 ms)
-        uint32_t time_diff = current_time - sub->last_report_time;
-        uint32_t max_interval_ms = (uint32_t)sub->max_interval * 1000;
-        
-        if (time_diff >= max_interval_ms) {
-            // Note: Full report generation would be implemented here
-            // For now, we just track that a report is due
-            // In production, this would call report_generator_send_report()
-            
-            sub->last_report_time = current_time;
-            reports_generated++;
+        if (rc == REPORT_SEND_OK) {
+            report_done(sub, sent, event_min, current_time);
+            sub->next_report_time = (sub->dirty || sub->events_pending) ? current_time :
+                current_time + (uint32_t)sub->max_interval * 1000;
+            reports_sent++;
+        } else {
+            // Keep the dirty paths and try again shortly
+            sub->next_report_time = current_time + SUBSCRIPTION_RETRY_MS;
         }
+        queue_sift_down(0);
+    }
+    
+    return reports_sent;
+}
+
+/**
+ * Get the earliest report deadline
+ */
+bool subscribe_handler_next_deadline(uint32_t *deadline) {
+    if (report_queue_len == 0) {
+        return false;
+    }
+    if (deadline) {
+        *deadline = queue_deadline(0);
+    }
+    return true;
+}
+
+/**
+ * Move a subscription's deadline forward for a change
+ * Reports at the end of the min-interval window, or now if it has passed
+ * (or the change is urgent).  Min interval <= max interval, so this only
+ * moves the deadline forward.
+ */
+static void schedule_change(subscription_t *sub, uint32_t current_time, bool urgent) {
+    // Priming subscriptions are not scheduled yet
+    if (sub->priming) {
+        return;
     }
     
-    return reports_generated;
+    uint32_t due = sub->last_report_time + (uint32_t)sub->min_interval * 1000;
+    if (urgent || time_before(due, current_time)) {
+        due = current_time;
+    }
+    if (time_before(due, sub->next_report_time)) {
+        sub->next_report_time = due;
+        queue_sift_up(sub->queue_index);
+    }
+}
+
+/**
+ * Schedule a primed subscription's reports
+ */
+int subscribe_handler_activate(uint32_t subscription_id, uint32_t current_time) {
+    subscription_t *sub = find_subscription_by_id(subscription_id);
+    
+    if (!initialized || !sub || !sub->priming) {
+        return -1;
+    }
+    
+    // Changes during priming not yet reported wait for the min interval
+    engine_now = current_time;
+    sub->priming = false;
+    sub->last_report_time = current_time;
+    sub->next_report_time = current_time + (uint32_t)sub->max_interval * 1000;
+    queue_push(sub);
+    if (sub->dirty || sub->events_pending) {
+        schedule_change(sub, current_time, false);
+    }
+    return 0;
 }
 
 /**
@@ -339,38 +719,68 @@ int subscribe_handler_notify_change(uint8_t endpoint, uint32_t cluster_id,
         return -1;
     }
     
-    int reports_generated = 0;
+    int queued = 0;
+    engine_now = current_time;
+    
+    size_t index;
+    const attribute_entry_t *entry = attribute_table_find(endpoint, cluster_id,
+                                                          attribute_id, &index);
+    if (!entry || !(entry->quality & ATTR_QUALITY_REPORTABLE)) {
+        return 0;
+    }
+    attribute_mask_t bit = ATTRIBUTE_MASK_BIT(index);
     
     for (int i = 0; i < MAX_SUBSCRIPTIONS; i++) {
         subscription_t *sub = &subscriptions[i];
         
-        if (!sub->active) {
+        if (!sub->active || !(sub->interest & bit)) {
             continue;
         }
         
-        // Check if subscription matches this attribute
-        if (sub->endpoint != endpoint ||
-            sub->cluster_id != cluster_id ||
-            sub->attribute_id != attribute_id) {
+        sub->dirty |= bit;
+        queued++;
+        schedule_change(sub, current_time, false);
+    }
+    
+    return queued;
+}
+
+/**
+ * Notify subscription handler of a logged event
+ */
+int subscribe_handler_notify_event(uint8_t endpoint, uint32_t cluster_id,
+                                   uint32_t event_id, uint32_t current_time) {
+    if (!initialized) {
+        return -1;
+    }
+    
+    int queued = 0;
+    engine_now = current_time;
+    
+    for (int i = 0; i < MAX_SUBSCRIPTIONS; i++) {
+        subscription_t *sub = &subscriptions[i];
+        bool matched = false;
+        bool urgent = false;
+        
+        if (!sub->active) {
             continue;
         }
-        
-        // Check if min_interval has elapsed
-        // Handle wraparound by computing difference (works for wraparound up to 2^31 ms)
-        uint32_t time_diff = current_time - sub->last_report_time;
-        uint32_t min_interval_ms = (uint32_t)sub->min_interval * 1000;
-        
-        if (time_diff >= min_interval_ms) {
-            // Note: Full report generation would be implemented here
-            // For now, we just track that a report is due
-            // In production, this would call report_generator_send_report()
-            
-            sub->last_report_time = current_time;
-            reports_generated++;
+        for (uint8_t p = 0; p < sub->event_path_count; p++) {
+            if (event_path_matches(&sub->event_paths[p], endpoint, cluster_id, event_id)) {
+                matched = true;
+                urgent = urgent || sub->event_paths[p].urgent;
+            }
         }
+        if (!matched) {
+            continue;
+        }
+        
+        sub->events_pending = true;
+        queued++;
+        schedule_change(sub, current_time, urgent);
     }
     
-    return reports_generated;
+    return queued;
 }
 
 /**
@@ -407,6 +817,7 @@ int subscribe_handler_clear_all(void) {
             count++;
         }
     }
+    report_queue_len = 0;
     
     return count;
 }
@@ -2,6 +2,26 @@
  * subscribe_handler.h
  * Matter SubscribeRequest/SubscribeResponse interaction handler
  * Based on Matter Core Specification Section 8.5
+ *
+ * A SubscribeRequest becomes one subscription holding all its paths
+ * (concrete or wildcard).  The paths are resolved against the attribute
+ * table once, into an interest set with one bit per table entry.
+ *
+ * Also the report engine: an attribute change only sets the attribute's
+ * bit in the dirty set of the subscriptions interested in it and moves
+ * their report deadline forward; the next report carries every dirty
+ * attribute.
+ * subscribe_handler_check_intervals() sends the reports that are due, with
+ * deadlines kept in a min-heap so a pass with nothing due looks at one
+ * entry:
+ * - dirty: last report + min_interval (changes inside the window coalesce
+ *   into one ReportData), but not earlier than the change
+ * - clean: last report + max_interval (empty keep-alive ReportData)
+ *
+ * Event paths work the same way: a logged event matching them marks the
+ * subscription's events pending (urgent paths report without waiting for
+ * the min interval), and the report carries the events from the
+ * subscription's next event number on.
  */
 
 #ifndef SUBSCRIBE_HANDLER_H
@@ -9,6 +29,7 @@
 
 #include "interaction_model.h"
 #include "read_handler.h"
+#include "attribute_table.h"
 #include <stdint.h>
 #include <stddef.h>
 #include <stdbool.h>
@@ -22,19 +43,49 @@ extern "C" {
  */
 #define MAX_SUBSCRIPTIONS 10
 
+/**
+ * Maximum number of attribute paths in one subscription
+ */
+#ifndef SUBSCRIPTION_MAX_PATHS
+#define SUBSCRIPTION_MAX_PATHS 8
+#endif
+
+/**
+ * Maximum number of event paths in one subscription
+ */
+#ifndef SUBSCRIPTION_MAX_EVENT_PATHS
+#define SUBSCRIPTION_MAX_EVENT_PATHS 2
+#endif
+
+/**
+ * Delay before retrying a report that could not be sent (milliseconds)
+ */
+#ifndef SUBSCRIPTION_RETRY_MS
+#define SUBSCRIPTION_RETRY_MS 1000
+#endif
+
 /**
  * Subscription Structure
- * Stores state for a single attribute subscription
+ * Stores state for one SubscribeRequest
  */
 typedef struct {
     uint16_t session_id;         // Session ID for this subscription
     uint32_t subscription_id;    // Unique subscription ID
-    uint8_t endpoint;            // Endpoint number
-    uint32_t cluster_id;         // Cluster ID
-    uint32_t attribute_id;       // Attribute ID
+    attribute_path_t paths[SUBSCRIPTION_MAX_PATHS]; // Requested paths
+    uint8_t path_count;          // Number of paths
+    attribute_mask_t interest;   // Table entries covered by the paths
+    attribute_mask_t dirty;      // Table entries to report
+    event_path_t event_paths[SUBSCRIPTION_MAX_EVENT_PATHS]; // Requested events
+    uint8_t event_path_count;    // Number of event paths
+    bool events_pending;         // Logged events to report
+    uint64_t event_min;          // Next event number to report
+    bool primed;                 // First report has been sent
+    bool priming;                // Awaiting SubscribeResponse, not scheduled
     uint16_t min_interval;       // Minimum interval in seconds
     uint16_t max_interval;       // Maximum interval in seconds
     uint32_t last_report_time;   // Last report time (milliseconds)
+    uint32_t next_report_time;   // Report deadline (milliseconds)
+    uint8_t queue_index;         // Position in the deadline heap
     bool active;                 // Subscription is active
 } subscription_t;
 
@@ -48,7 +99,20 @@ int subscribe_handler_init(void);
 
 /**
  * Process a SubscribeRequest message
- * Parses the request TLV, creates subscriptions, and encodes response
+ * Parses the request TLV, creates one subscription for all its attribute
+ * and event paths, and encodes response.  Clusters matching a
+ * DataVersionFilter are left out of the first report; the first report
+ * carries the logged events from the request's EventMin on.
+ * 
+ * The subscription starts out priming: the caller sends its first reports
+ * on the SubscribeRequest's exchange with subscribe_handler_send_priming(),
+ * then the SubscribeResponse, and hands it to the report schedule with
+ * subscribe_handler_activate().  Until then it sends nothing on its own.
+ * 
+ * The request is checked before the session's subscriptions are replaced:
+ * one with more than SUBSCRIPTION_MAX_PATHS attribute paths or
+ * SUBSCRIPTION_MAX_EVENT_PATHS event paths, or with no free subscription,
+ * fails with RESOURCE_EXHAUSTED and leaves the existing ones in place.
  * 
  * @param request_tlv Input TLV-encoded SubscribeRequest
  * @param request_len Length of request
@@ -56,15 +120,66 @@ int subscribe_handler_init(void);
  * @param max_response_len Maximum size of response buffer
  * @param actual_len Pointer to store actual response length
  * @param session_id Session ID for this subscription
+ * @param subscription_id Set to the new subscription's ID (may be NULL)
+ * @param status Set to the StatusResponse status on failure
  * @return 0 on success, negative on error
  */
 int subscribe_handler_process_request(const uint8_t *request_tlv, size_t request_len,
                                       uint8_t *response_tlv, size_t max_response_len,
-                                      size_t *actual_len, uint16_t session_id);
+                                      size_t *actual_len, uint16_t session_id,
+                                      uint32_t *subscription_id,
+                                      im_status_code_t *status);
+
+/**
+ * Send the next priming report of a subscription from
+ * subscribe_handler_process_request()
+ * Same content as the first report the schedule would send, as chunks:
+ * a chunk leaving attributes or events for the next one carries
+ * MoreChunkedMessages and sets *more.  The subscriber answers each with a
+ * StatusResponse before the next chunk (or the SubscribeResponse) goes out.
+ * 
+ * @param subscription_id Priming subscription
+ * @param current_time Current time in milliseconds
+ * @param more Set if another priming report follows
+ * @return REPORT_SEND_OK, REPORT_SEND_RETRY (also for a subscription that
+ *         is not priming) or REPORT_SEND_NO_SESSION
+ */
+int subscribe_handler_send_priming(uint32_t subscription_id, uint32_t current_time,
+                                   bool *more);
+
+/**
+ * Schedule a primed subscription's reports
+ * Called once the SubscribeResponse is sent.  The next report is a
+ * keep-alive after max_interval, or earlier for changes since priming.
+ * 
+ * @param subscription_id Priming subscription
+ * @param current_time Current time in milliseconds
+ * @return 0 on success, -1 if the subscription is not priming
+ */
+int subscribe_handler_activate(uint32_t subscription_id, uint32_t current_time);
 
 /**
  * Add a new subscription
- * Creates a subscription for the specified attribute path
+ * Creates a subscription for the specified attribute paths.  Its first
+ * report (current values of every attribute the paths cover, and a status
+ * for concrete paths the device cannot report) is due on the next
+ * subscribe_handler_check_intervals().  max_interval is raised to
+ * min_interval (and to 1 second) if lower.
+ * 
+ * @param session_id Session ID
+ * @param paths Attribute paths to subscribe to (wildcards allowed)
+ * @param count Number of paths (1..SUBSCRIPTION_MAX_PATHS)
+ * @param min_interval Minimum reporting interval in seconds
+ * @param max_interval Maximum reporting interval in seconds
+ * @return Subscription ID on success, 0 on failure
+ */
+uint32_t subscribe_handler_add_paths(uint16_t session_id,
+                                     const attribute_path_t *paths, size_t count,
+                                     uint16_t min_interval, uint16_t max_interval);
+
+/**
+ * Add a new single-path subscription
+ * Same as subscribe_handler_add_paths() with one path.
  * 
  * @param session_id Session ID
  * @param path Attribute path to subscribe to
@@ -94,27 +209,59 @@ int subscribe_handler_remove(uint16_t session_id, uint32_t subscription_id);
 int subscribe_handler_remove_all_for_session(uint16_t session_id);
 
 /**
- * Check if any subscriptions need interval-based reports
- * Should be called periodically from main protocol task
+ * Send the reports that are due
+ * Should be called periodically from main protocol task.  Sends each due
+ * subscription's dirty attributes and pending events in one ReportData
+ * (MAX_READ_PATHS attributes and what events fit at a time; any rest
+ * follows in further reports), or an empty keep-alive report, through
+ * report_generator_send_report().  Subscriptions whose session is gone are
+ * removed; other send failures are retried after SUBSCRIPTION_RETRY_MS.
+ * Priming subscriptions are left alone.
  * 
  * @param current_time Current time in milliseconds
- * @return Number of reports generated, -1 on error
+ * @return Number of reports sent, -1 on error
  */
 int subscribe_handler_check_intervals(uint32_t current_time);
 
+/**
+ * Get the earliest report deadline
+ * 
+ * @param deadline Set to the deadline (milliseconds) if there is one
+ * @return true if any subscription is active
+ */
+bool subscribe_handler_next_deadline(uint32_t *deadline);
+
 /**
  * Notify subscription handler of attribute change
- * Checks if any subscriptions match and generates reports if needed
+ * Marks the attribute dirty in subscriptions with a path covering it and
+ * schedules their reports; nothing is sent until
+ * subscribe_handler_check_intervals().  Attributes that are not in the
+ * attribute table, or not reportable, are ignored.
  * 
  * @param endpoint Endpoint that changed
  * @param cluster_id Cluster ID that changed
  * @param attribute_id Attribute ID that changed
  * @param current_time Current time in milliseconds
- * @return Number of reports generated, -1 on error
+ * @return Number of subscriptions the change was queued for, -1 on error
  */
 int subscribe_handler_notify_change(uint8_t endpoint, uint32_t cluster_id,
                                     uint32_t attribute_id, uint32_t current_time);
 
+/**
+ * Notify subscription handler of a logged event
+ * Marks events pending in subscriptions with an event path covering it and
+ * schedules their reports (at once for an urgent path, otherwise like an
+ * attribute change).  Called by event_log_emit().
+ * 
+ * @param endpoint Endpoint of the event
+ * @param cluster_id Cluster ID of the event
+ * @param event_id Event ID
+ * @param current_time Current time in milliseconds
+ * @return Number of subscriptions the event was queued for, -1 on error
+ */
+int subscribe_handler_notify_event(uint8_t endpoint, uint32_t cluster_id,
+                                   uint32_t event_id, uint32_t current_time);
+
 /**
  * Get subscription by ID
  * Internal function for testing/debugging
@@ -8,15 +8,20 @@
 #include "subscribe_handler.h"
 #include "pico/stdlib.h"
 
-// Forward declaration - this is called when attribute changes occur
-static void subscription_attribute_callback(uint8_t endpoint, uint32_t cluster_id,
-                                           uint32_t attribute_id, const matter_attr_value_t *value) {
+// Called once per report pass with every attribute that changed
+static void subscription_attribute_callback(const matter_attr_change_t *changes,
+                                           size_t count) {
     // Get current time in milliseconds
     uint32_t current_time = to_ms_since_boot(get_absolute_time());
     
-    // Notify subscribe_handler of the change
-    // This will check active subscriptions and generate reports if needed
-    subscribe_handler_notify_change(endpoint, cluster_id, attribute_id, current_time);
+    // Notify subscribe_handler of the changes
+    // Marks the attributes dirty in matching subscriptions; the reports go
+    // out from matter_protocol_task() once their min interval allows, one
+    // report per subscription for the whole change set
+    for (size_t i = 0; i < count; i++) {
+        subscribe_handler_notify_change(changes[i].endpoint, changes[i].cluster_id,
+                                        changes[i].attribute_id, current_time);
+    }
 }
 
 // Initialize subscription bridge
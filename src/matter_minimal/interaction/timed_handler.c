@@ -0,0 +1,78 @@
+/*
+ * timed_handler.c
+ * Matter TimedRequest handling implementation
+ */
+
+#include "timed_handler.h"
+#include "../codec/tlv.h"
+#include "../codec/tlv_types.h"
+
+// Open timed window
+static struct {
+    bool active;
+    uint16_t session_id;
+    uint16_t exchange_id;
+    uint32_t deadline_ms;
+} timed_window;
+
+/**
+ * Parse a TimedRequest
+ */
+int timed_handler_parse_request(const uint8_t *payload, size_t len, uint16_t *timeout_ms) {
+    tlv_reader_t reader;
+    tlv_element_t element;
+
+    if (!payload || !timeout_ms) {
+        return -1;
+    }
+
+    tlv_reader_init(&reader, payload, len);
+    while (tlv_reader_next(&reader, &element) == 0) {
+        if (element.tag == 0 && element.type == TLV_TYPE_UNSIGNED_INT) {
+            *timeout_ms = tlv_read_uint16(&element);
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * Open a timed window on an exchange
+ */
+void timed_handler_begin(uint16_t session_id, uint16_t exchange_id,
+                         uint16_t timeout_ms, uint32_t now_ms) {
+    timed_window.active = true;
+    timed_window.session_id = session_id;
+    timed_window.exchange_id = exchange_id;
+    timed_window.deadline_ms = now_ms + timeout_ms;
+}
+
+/**
+ * Close the timed window for a WriteRequest or InvokeRequest
+ */
+int timed_handler_end(uint16_t session_id, uint16_t exchange_id, uint32_t now_ms,
+                      bool *timed) {
+    *timed = false;
+
+    // Windows on other exchanges stay open
+    if (!timed_window.active || timed_window.session_id != session_id ||
+        timed_window.exchange_id != exchange_id) {
+        return 0;
+    }
+
+    timed_window.active = false;
+    if ((int32_t)(now_ms - timed_window.deadline_ms) > 0) {
+        return -1;
+    }
+
+    *timed = true;
+    return 0;
+}
+
+/**
+ * Drop any open window
+ */
+void timed_handler_reset(void) {
+    timed_window.active = false;
+}
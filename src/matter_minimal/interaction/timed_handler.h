@@ -0,0 +1,69 @@
+/*
+ * timed_handler.h
+ * Matter TimedRequest handling
+ * Based on Matter Core Specification Section 8.6
+ *
+ * A TimedRequest opens a short window on its exchange in which the
+ * following WriteRequest or InvokeRequest must arrive; that request is
+ * then a timed interaction (its TimedRequest flag must be set).  One
+ * window at a time: a new TimedRequest replaces the previous one.
+ */
+
+#ifndef TIMED_HANDLER_H
+#define TIMED_HANDLER_H
+
+#include "interaction_model.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Parse a TimedRequest
+ * TimedRequest ::= { Timeout [0]: uint16 (milliseconds) }
+ *
+ * @param payload Input TLV-encoded TimedRequest
+ * @param len Length of payload
+ * @param timeout_ms Set to the requested window
+ * @return 0 on success, -1 if the message has no timeout
+ */
+int timed_handler_parse_request(const uint8_t *payload, size_t len, uint16_t *timeout_ms);
+
+/**
+ * Open a timed window on an exchange
+ *
+ * @param session_id Session the TimedRequest arrived on
+ * @param exchange_id Exchange of the TimedRequest
+ * @param timeout_ms Window length from the TimedRequest
+ * @param now_ms Current time in milliseconds
+ */
+void timed_handler_begin(uint16_t session_id, uint16_t exchange_id,
+                         uint16_t timeout_ms, uint32_t now_ms);
+
+/**
+ * Close the timed window for a WriteRequest or InvokeRequest
+ * The window is used up whether or not it was still open.
+ *
+ * @param session_id Session the action arrived on
+ * @param exchange_id Exchange of the action
+ * @param now_ms Current time in milliseconds
+ * @param timed Set when the action follows a TimedRequest on its exchange
+ * @return 0 on success, -1 if the exchange's window has expired
+ *         (answer with IM_STATUS_TIMEOUT)
+ */
+int timed_handler_end(uint16_t session_id, uint16_t exchange_id, uint32_t now_ms,
+                      bool *timed);
+
+/**
+ * Drop any open window
+ */
+void timed_handler_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TIMED_HANDLER_H
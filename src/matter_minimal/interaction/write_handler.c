@@ -0,0 +1,344 @@
+/*
+ * write_handler.c
+ * Matter WriteRequest/WriteResponse interaction handler implementation
+ */
+
+#include "write_handler.h"
+#include "attribute_table.h"
+#include "read_handler.h"
+#include "subscribe_handler.h"
+#include "../codec/tlv.h"
+#include <string.h>
+
+static bool is_container(const tlv_element_t *element) {
+    return element->type == TLV_TYPE_STRUCTURE || element->type == TLV_TYPE_ARRAY ||
+           element->type == TLV_TYPE_LIST;
+}
+
+/**
+ * Decode a Data element as an attribute of the given type
+ */
+static im_status_code_t decode_value(const tlv_element_t *data, attribute_type_t type,
+                                     attribute_value_t *value) {
+    switch (type) {
+        case ATTR_TYPE_BOOL:
+            if (data->type != TLV_TYPE_BOOL) {
+                return IM_STATUS_INVALID_DATA_TYPE;
+            }
+            value->bool_val = data->value.boolean;
+            return IM_STATUS_SUCCESS;
+
+        case ATTR_TYPE_UINT8:
+        case ATTR_TYPE_UINT16:
+        case ATTR_TYPE_UINT32: {
+            if (data->type != TLV_TYPE_UNSIGNED_INT) {
+                return IM_STATUS_INVALID_DATA_TYPE;
+            }
+            uint64_t max = type == ATTR_TYPE_UINT8 ? UINT8_MAX :
+                           type == ATTR_TYPE_UINT16 ? UINT16_MAX : UINT32_MAX;
+            if (data->value.u64 > max) {
+                return IM_STATUS_CONSTRAINT_ERROR;
+            }
+            value->uint8_val = (uint8_t)data->value.u64;
+            if (type == ATTR_TYPE_UINT16) {
+                value->uint16_val = (uint16_t)data->value.u64;
+            } else if (type == ATTR_TYPE_UINT32) {
+                value->uint32_val = (uint32_t)data->value.u64;
+            }
+            return IM_STATUS_SUCCESS;
+        }
+
+        case ATTR_TYPE_INT16:
+            if (data->type != TLV_TYPE_SIGNED_INT) {
+                return IM_STATUS_INVALID_DATA_TYPE;
+            }
+            value->int16_val = data->value.i16;
+            return IM_STATUS_SUCCESS;
+
+        case ATTR_TYPE_UTF8_STRING:
+            if (data->type != TLV_TYPE_UTF8_STRING) {
+                return IM_STATUS_INVALID_DATA_TYPE;
+            }
+            if (data->value.string.length > UINT16_MAX) {
+                return IM_STATUS_CONSTRAINT_ERROR;
+            }
+            value->string_val.str = data->value.string.data;
+            value->string_val.len = (uint16_t)data->value.string.length;
+            return IM_STATUS_SUCCESS;
+
+        default:
+            // Lists are not writable
+            return IM_STATUS_INVALID_DATA_TYPE;
+    }
+}
+
+/**
+ * Write one attribute from its TLV-encoded value
+ */
+im_status_code_t write_handler_write_attribute(const attribute_path_t *path,
+                                               const tlv_element_t *data,
+                                               const uint32_t *data_version,
+                                               uint32_t now_ms) {
+    const attribute_entry_t *entry;
+    attribute_value_t value;
+    uint32_t version;
+
+    im_status_code_t status = attribute_table_lookup(path, &entry);
+    if (!entry) {
+        return status;
+    }
+    if (!(entry->quality & ATTR_QUALITY_WRITABLE) || !entry->write) {
+        return IM_STATUS_UNSUPPORTED_WRITE;
+    }
+
+    // Conditional write: the controller's copy of the cluster must be current
+    if (data_version &&
+        (attribute_table_get_data_version(path->endpoint, path->cluster_id, &version) < 0 ||
+         version != *data_version)) {
+        return IM_STATUS_DATA_VERSION_MISMATCH;
+    }
+
+    memset(&value, 0, sizeof(value));
+    status = decode_value(data, (attribute_type_t)entry->type, &value);
+    if (status != IM_STATUS_SUCCESS) {
+        return status;
+    }
+
+    status = entry->write(path->endpoint, path->attribute_id, &value);
+    if (status != IM_STATUS_SUCCESS) {
+        return status;
+    }
+
+    attribute_table_bump_data_version(path->endpoint, path->cluster_id);
+    subscribe_handler_notify_change(path->endpoint, path->cluster_id,
+                                    path->attribute_id, now_ms);
+    return IM_STATUS_SUCCESS;
+}
+
+/**
+ * Parse and write one AttributeDataIB
+ * AttributeDataIB ::= {
+ *   DataVersion [0]: uint32 (optional)
+ *   Path [1]: AttributePath
+ *   Data [2]: value
+ * }
+ *
+ * With apply false the element is only checked and status is left as
+ * SUCCESS, so a whole request can be validated before anything is written.
+ *
+ * @return 0 with path and status set, -1 if the element is malformed or
+ *         the path has wildcards
+ */
+static int write_attribute_data(tlv_reader_t *reader, bool apply, uint32_t now_ms,
+                                attribute_path_t *path, im_status_code_t *status) {
+    tlv_element_t element;
+    tlv_element_t data;
+    uint32_t data_version = 0;
+    bool has_version = false;
+    bool has_path = false;
+    bool has_data = false;
+
+    while (tlv_reader_next(reader, &element) == 0) {
+        if (element.type == TLV_TYPE_END_OF_CONTAINER) {
+            if (!has_path || !has_data) {
+                return -1;
+            }
+            // Wildcard writes are only allowed for group messages
+            if (path->wildcard != 0) {
+                return -1;
+            }
+            *status = IM_STATUS_SUCCESS;
+            if (apply) {
+                *status = write_handler_write_attribute(path, &data,
+                                                        has_version ? &data_version : NULL,
+                                                        now_ms);
+            }
+            return 0;
+        }
+
+        if (element.tag == 0 && element.type == TLV_TYPE_UNSIGNED_INT) {
+            data_version = element.value.u32;
+            has_version = true;
+        } else if (element.tag == 1 && (element.type == TLV_TYPE_LIST ||
+                                        element.type == TLV_TYPE_STRUCTURE)) {
+            if (read_handler_parse_attribute_path(reader, path) < 0 ||
+                tlv_reader_exit_container(reader) < 0) {
+                return -1;
+            }
+            has_path = true;
+        } else if (element.tag == 2) {
+            // List values are skipped; no list attribute is writable
+            data = element;
+            has_data = true;
+            if (is_container(&element) && tlv_reader_exit_container(reader) < 0) {
+                return -1;
+            }
+        } else if (is_container(&element) && tlv_reader_exit_container(reader) < 0) {
+            return -1;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Encode an AttributeStatusIB
+ * AttributeStatusIB ::= { Path [0]: AttributePath, Status [1]: { Status [0] } }
+ */
+static int encode_attribute_status(tlv_writer_t *writer, const attribute_path_t *path,
+                                   im_status_code_t status) {
+    if (tlv_encode_structure_start(writer, 0xFF) < 0 ||
+        tlv_encode_structure_start(writer, 0) < 0 ||
+        tlv_encode_uint8(writer, 0, path->endpoint) < 0 ||
+        tlv_encode_uint32(writer, 2, path->cluster_id) < 0 ||
+        tlv_encode_uint32(writer, 3, path->attribute_id) < 0 ||
+        tlv_encode_container_end(writer) < 0 ||
+        tlv_encode_structure_start(writer, 1) < 0 ||
+        tlv_encode_uint8(writer, 0, (uint8_t)status) < 0 ||
+        tlv_encode_container_end(writer) < 0 ||
+        tlv_encode_container_end(writer) < 0) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Parse the AttributeDataIBs of a WriteRequest and encode a status for each
+ * The status of a path always takes the same space, so a check pass
+ * (apply false) that fits guarantees that the writing pass fits too.
+ *
+ * @param writes Reader positioned in the WriteRequests array (not advanced)
+ * @return 0 on success, -1 if an element is malformed or the statuses do
+ *         not fit (status set to RESOURCE_EXHAUSTED)
+ */
+static int write_attributes(const tlv_reader_t *writes, bool apply, uint32_t now_ms,
+                            tlv_writer_t *writer, im_status_code_t *status) {
+    tlv_reader_t reader = *writes;
+    tlv_element_t element;
+
+    while (tlv_reader_next(&reader, &element) == 0 &&
+           element.type != TLV_TYPE_END_OF_CONTAINER) {
+        attribute_path_t path;
+        im_status_code_t write_status;
+
+        if (element.type != TLV_TYPE_STRUCTURE) {
+            if (is_container(&element) && tlv_reader_exit_container(&reader) < 0) {
+                return -1;
+            }
+            continue;
+        }
+
+        memset(&path, 0, sizeof(path));
+        if (write_attribute_data(&reader, apply, now_ms, &path, &write_status) < 0) {
+            return -1;
+        }
+        if (encode_attribute_status(writer, &path, write_status) < 0) {
+            *status = IM_STATUS_RESOURCE_EXHAUSTED;
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Process a WriteRequest message
+ */
+int write_handler_process_request(const uint8_t *request_tlv, size_t request_len,
+                                  bool timed, uint8_t auth_mode, uint32_t now_ms,
+                                  uint8_t *response_tlv, size_t max_response_len,
+                                  size_t *actual_len, bool *suppress,
+                                  im_status_code_t *status) {
+    tlv_reader_t reader;
+    tlv_reader_t writes;
+    tlv_writer_t writer;
+    tlv_element_t element;
+    bool timed_request = false;
+    bool has_writes = false;
+
+    if (!request_tlv || !response_tlv || !actual_len || !suppress || !status ||
+        max_response_len < 1) {
+        return -1;
+    }
+
+    *suppress = false;
+    if (auth_mode == IM_AUTH_NONE) {
+        *status = IM_STATUS_UNSUPPORTED_ACCESS;
+        return -1;
+    }
+    *status = IM_STATUS_INVALID_ACTION;
+
+    // WriteRequest ::= {
+    //   SuppressResponse [0]: bool
+    //   TimedRequest [1]: bool
+    //   WriteRequests [2]: Array of AttributeDataIB
+    //   MoreChunkedMessages [3]: bool (chunked writes are not supported)
+    // }
+    // The flags are read first so nothing is written if they are wrong
+    tlv_reader_init(&reader, request_tlv, request_len);
+    if (tlv_reader_peek(&reader, &element) == 0 &&
+        element.type == TLV_TYPE_STRUCTURE &&
+        (element.tag_type == TLV_TAG_ANONYMOUS || element.tag == 0xFF)) {
+        tlv_reader_skip(&reader);
+    }
+
+    while (tlv_reader_next(&reader, &element) == 0) {
+        if (element.type == TLV_TYPE_END_OF_CONTAINER) {
+            break;
+        }
+
+        if (element.tag == 0 && element.type == TLV_TYPE_BOOL) {
+            *suppress = element.value.boolean;
+        } else if (element.tag == 1 && element.type == TLV_TYPE_BOOL) {
+            timed_request = element.value.boolean;
+        } else if (element.tag == 3 && element.type == TLV_TYPE_BOOL &&
+                   element.value.boolean) {
+            return -1;
+        } else if (element.tag == 2 && element.type == TLV_TYPE_ARRAY) {
+            writes = reader;
+            has_writes = true;
+            if (tlv_reader_exit_container(&reader) < 0) {
+                return -1;
+            }
+        } else if (is_container(&element) && tlv_reader_exit_container(&reader) < 0) {
+            return -1;
+        }
+    }
+
+    if (!has_writes) {
+        return -1;
+    }
+
+    // The TimedRequest flag must say whether a TimedRequest came first
+    if (timed_request != timed) {
+        *status = IM_STATUS_TIMED_REQUEST_MISMATCH;
+        return -1;
+    }
+
+    // WriteResponse ::= { WriteResponses [0]: Array of AttributeStatusIB }
+    // The end of the array is kept free while statuses are encoded
+    tlv_writer_init(&writer, response_tlv, max_response_len - 1);
+    if (tlv_encode_array_start(&writer, 0) < 0) {
+        *status = IM_STATUS_RESOURCE_EXHAUSTED;
+        return -1;
+    }
+
+    // Every AttributeDataIB is parsed and its status given room first, so a
+    // malformed or oversized request is refused before any attribute changes
+    size_t statuses_start = writer.offset;
+    if (write_attributes(&writes, false, now_ms, &writer, status) < 0) {
+        return -1;
+    }
+    writer.offset = statuses_start;
+    if (write_attributes(&writes, true, now_ms, &writer, status) < 0) {
+        return -1;
+    }
+
+    writer.buffer_size = max_response_len;
+    if (tlv_encode_container_end(&writer) < 0) {
+        *status = IM_STATUS_RESOURCE_EXHAUSTED;
+        return -1;
+    }
+
+    *actual_len = tlv_writer_get_length(&writer);
+    *status = IM_STATUS_SUCCESS;
+    return 0;
+}
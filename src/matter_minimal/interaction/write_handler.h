@@ -0,0 +1,71 @@
+/*
+ * write_handler.h
+ * Matter WriteRequest/WriteResponse interaction handler
+ * Based on Matter Core Specification Section 8.7
+ *
+ * Each AttributeDataIB of a WriteRequest is written through the attribute
+ * table (entries flagged ATTR_QUALITY_WRITABLE) and answered with an
+ * AttributeStatusIB.  A successful write bumps the cluster's DataVersion
+ * and is reported to subscribers like any other change.
+ */
+
+#ifndef WRITE_HANDLER_H
+#define WRITE_HANDLER_H
+
+#include "interaction_model.h"
+#include "../codec/tlv_types.h"
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Write one attribute from its TLV-encoded value
+ * The value must match the attribute's type; integers out of the type's
+ * range are refused with IM_STATUS_CONSTRAINT_ERROR.
+ *
+ * @param path Concrete attribute path
+ * @param data Data element of the AttributeDataIB
+ * @param data_version DataVersion the write is conditional on (may be NULL)
+ * @param now_ms Current time in milliseconds
+ * @return Status for the attribute's AttributeStatusIB
+ */
+im_status_code_t write_handler_write_attribute(const attribute_path_t *path,
+                                               const tlv_element_t *data,
+                                               const uint32_t *data_version,
+                                               uint32_t now_ms);
+
+/**
+ * Process a WriteRequest message
+ * A request whose TimedRequest flag does not match timed, that cannot be
+ * parsed, or that arrived on the unsecured session is answered with a
+ * StatusResponse instead (status is set and -1 returned), as is one whose
+ * statuses would not fit in max_response_len (RESOURCE_EXHAUSTED); both are
+ * detected before any attribute is written.
+ *
+ * @param request_tlv Input TLV-encoded WriteRequest
+ * @param request_len Length of request
+ * @param timed True if the request follows a TimedRequest on its exchange
+ * @param auth_mode IM_AUTH_* of the session the request arrived on
+ * @param now_ms Current time in milliseconds
+ * @param response_tlv Output buffer for TLV-encoded WriteResponse
+ * @param max_response_len Maximum size of response buffer
+ * @param actual_len Pointer to store actual response length
+ * @param suppress Set when the request asked for no response
+ * @param status Set to the StatusResponse status on failure
+ * @return 0 on success, -1 on failure
+ */
+int write_handler_process_request(const uint8_t *request_tlv, size_t request_len,
+                                  bool timed, uint8_t auth_mode, uint32_t now_ms,
+                                  uint8_t *response_tlv, size_t max_response_len,
+                                  size_t *actual_len, bool *suppress,
+                                  im_status_code_t *status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WRITE_HANDLER_H
@@ -5,33 +5,134 @@
 
 #include "matter_protocol.h"
 #include "codec/message_codec.h"
+#include "codec/packet_buffer.h"
+#include "codec/msg_pool.h"
+#include "codec/msg_counter.h"
 #include "transport/udp_transport.h"
+#include "transport/exchange_mgr.h"
 #include "security/session_mgr.h"
 #include "security/pase.h"
 #include "security/attestation.h"
 #include "security/case.h"
+#include "security/ephemeral_pool.h"
 #include "commissioning/network_commissioning.h"
 #include "interaction/interaction_model.h"
 #include "interaction/read_handler.h"
 #include "interaction/subscribe_handler.h"
+#include "interaction/report_generator.h"
+#include "interaction/attribute_table.h"
+#include "interaction/command_handler.h"
+#include "interaction/write_handler.h"
+#include "interaction/timed_handler.h"
+#include "interaction/event_log.h"
 #include "clusters/descriptor.h"
+#include "clusters/basic.h"
+#include "clusters/general_commissioning.h"
 #include "clusters/onoff.h"
 #include "clusters/level_control.h"
 #include "clusters/temperature.h"
 #include <string.h>
 #include <stdio.h>
 
+// Pico SDK
+#include "pico/time.h"
+#include "pico/rand.h"
+
 // Internal state
 static bool initialized = false;
 
 /*
  * BLE session state – set to true while matter_protocol_process_ble_message()
- * is executing so that matter_protocol_send() stores the encoded response in
- * g_ble_response_buf instead of sending it over UDP.
+ * is executing so that send_tx_buffer() hands the encoded response (a message
+ * pool block) to the BLE path instead of sending it over UDP.
+ */
+static bool             g_ble_session_active  = false;
+static packet_buffer_t *g_ble_response        = NULL;
+
+// Header template for outgoing unsecured (session 0) messages
+static matter_header_template_t g_unsecured_header;
+
+/*
+ * Exchange of the UDP message currently being routed.  Responses sent with
+ * its exchange ID piggyback the pending ACK and are sent reliably (MRP).
+ */
+static exchange_ctx_t *g_rx_exchange = NULL;
+
+/*
+ * Address each secure session last received from, so that subscription
+ * reports (which open their own exchange) can reach the subscriber.
+ */
+typedef struct {
+    uint16_t session_id;                        // 0 = unused
+    uint16_t port;
+    char ip[EXCHANGE_PEER_ADDR_LEN];
+} session_peer_t;
+
+static session_peer_t g_session_peers[MAX_SESSIONS];
+
+/**
+ * Chunked reads in progress at once
+ */
+#ifndef MAX_PENDING_READS
+#define MAX_PENDING_READS 2
+#endif
+
+/*
+ * Read whose ReadResponse did not fit one packet.  The controller answers
+ * each chunk with a StatusResponse on the read's exchange; that sends the
+ * next chunk from the cursor.  One per session: a new ReadRequest replaces
+ * the session's own read, and is answered BUSY while every slot holds
+ * another session's read.
+ */
+typedef struct {
+    bool active;
+    uint16_t session_id;
+    uint16_t exchange_id;
+    uint16_t port;
+    char ip[EXCHANGE_PEER_ADDR_LEN];
+    read_cursor_t cursor;
+} pending_read_t;
+
+static pending_read_t g_pending_reads[MAX_PENDING_READS];
+
+/**
+ * Room for an encoded SubscribeResponse (SubscriptionId, MaxInterval)
  */
-static bool    g_ble_session_active  = false;
-static uint8_t g_ble_response_buf[MATTER_MAX_MESSAGE_SIZE];
-static size_t  g_ble_response_len    = 0;
+#define SUBSCRIBE_RESPONSE_MAX_LEN 16
+
+/*
+ * SubscribeRequest being primed.  Its priming reports go out on the
+ * request's exchange, each answered by a StatusResponse; the answer to the
+ * last one sends the SubscribeResponse and starts the subscription's
+ * reports.  One at a time: a new SubscribeRequest drops it.
+ */
+typedef struct {
+    bool active;
+    bool more;                                  // Another priming report follows
+    uint16_t session_id;
+    uint16_t exchange_id;
+    uint16_t port;
+    char ip[EXCHANGE_PEER_ADDR_LEN];
+    uint32_t subscription_id;
+    uint8_t response[SUBSCRIBE_RESPONSE_MAX_LEN];
+    size_t response_len;
+} pending_subscribe_t;
+
+static pending_subscribe_t g_pending_subscribe;
+
+/*
+ * Set while a priming report is encoded, so that send_subscription_report()
+ * sends it on the SubscribeRequest's exchange instead of opening one.
+ */
+static const pending_subscribe_t *g_priming = NULL;
+
+static inline uint32_t protocol_now_ms(void) {
+    return to_ms_since_boot(get_absolute_time());
+}
+
+static int exchange_transmit(const exchange_ctx_t *ex, const packet_buffer_t *pb);
+static int exchange_send_ack(const exchange_ctx_t *ex, uint32_t ack_counter);
+static int send_subscription_report(uint16_t session_id, packet_buffer_t *pb);
 
 /**
  * Initialize Matter protocol stack
@@ -43,18 +144,24 @@ int matter_protocol_init(void) {
     
     // Initialize layers from bottom to top
     
+    // 0. Message buffer pool (shared by all layers)
+    msg_pool_init();
+    
     // 1. Transport layer (UDP)
     if (matter_transport_init() < 0) {
         return -1;
     }
     
-    // 2. Message codec
+    // 2. Message codec and exchange layer (MRP)
     matter_message_codec_init();
+    matter_header_template_init(&g_unsecured_header, 0, 0, 0, 0);
+    exchange_mgr_init(exchange_transmit, exchange_send_ack);
     
     // 3. Security layer
     if (session_mgr_init() < 0) {
         return -1;
     }
+    ephemeral_pool_init();
 
     // 3b. Attestation (test-mode)
     if (attestation_init() < 0) {
@@ -74,6 +181,8 @@ int matter_protocol_init(void) {
     }
     
     // 5. Interaction layer
+    attribute_table_init(get_rand_32());
+    
     if (read_handler_init() < 0) {
         return -1;
     }
@@ -81,6 +190,13 @@ int matter_protocol_init(void) {
     if (subscribe_handler_init() < 0) {
         return -1;
     }
+    memset(g_session_peers, 0, sizeof(g_session_peers));
+    report_generator_set_sender(send_subscription_report);
+    timed_handler_reset();
+    
+    if (event_log_init() < 0) {
+        return -1;
+    }
     
     // 5. Cluster implementations
     if (cluster_descriptor_init() < 0) {
@@ -99,55 +215,214 @@ int matter_protocol_init(void) {
         return -1;
     }
     
+    cluster_basic_log_start_up(protocol_now_ms());
+    
     initialized = true;
+    msg_pool_print_stats();
     return 0;
 }
 
+/**
+ * Get an empty transmit buffer for the current response
+ * Payload is encoded at packet_buffer_tail() with headroom for the headers.
+ * The caller owns the returned pool block until it passes it to
+ * send_tx_buffer() or releases it.
+ */
+static packet_buffer_t *tx_buffer_begin(void) {
+    packet_buffer_t *pb = msg_pool_alloc();
+    if (!pb) {
+        printf("Matter Protocol: Message pool exhausted, dropping response\n");
+    }
+    return pb;
+}
+
+/**
+ * Encode headers in front of the payload in pb, encrypting on secure sessions
+ *
+ * Session 0 uses the unsecured header template and the global counter.
+ * Otherwise the session encrypts exchange header and payload in place, with
+ * the message header as AAD and the MIC appended (session_encrypt_packet()).
+ * Sets msg->header.message_counter.
+ */
+static int encode_message(uint16_t session_id, packet_buffer_t *pb,
+                          matter_message_t *msg) {
+    if (session_id == 0) {
+        msg->header.message_counter = matter_message_get_next_counter();
+        return packet_buffer_prepend_header(pb, &g_unsecured_header, msg);
+    }
+    return session_encrypt_packet(session_id, pb, msg);
+}
+
+/**
+ * Prepend headers to the payload in pb and transmit it without copying
+ * Consumes the caller's reference to pb.
+ *
+ * Messages on a secure session (session_id != 0, the local session ID the
+ * request arrived on) are encrypted in place.
+ *
+ * Over UDP the message belongs to an exchange: the one being routed when
+ * exchange_id matches it (a response, carrying the piggybacked ACK), or a
+ * newly opened one.  It is sent reliably; the exchange manager keeps a
+ * reference to pb for retransmission until the peer acknowledges it.
+ */
+static int send_tx_buffer(const char *dest_ip, uint16_t dest_port,
+                          uint16_t session_id,
+                          uint16_t protocol_id, uint8_t opcode,
+                          uint16_t exchange_id, packet_buffer_t *pb) {
+    matter_message_t msg;
+    memset(&msg, 0, sizeof(msg));
+    
+    msg.protocol_id = protocol_id;
+    msg.protocol_opcode = opcode;
+    msg.exchange_id = exchange_id;
+    
+    // BLE (BTP) is reliable itself, so MRP only runs over UDP
+    exchange_ctx_t *ex = NULL;
+    bool opened = false;
+    if (!g_ble_session_active) {
+        if (g_rx_exchange && g_rx_exchange->exchange_id == exchange_id) {
+            ex = g_rx_exchange;
+        } else {
+            ex = exchange_mgr_open(session_id, dest_ip, dest_port);
+            if (!ex) {
+                msg_pool_release(pb);
+                return -1;
+            }
+            opened = true;
+        }
+        exchange_mgr_prepare(ex, &msg, true);
+    }
+    
+    // Encode headers (and encrypt) in place
+    if (encode_message(session_id, pb, &msg) < 0) {
+        exchange_mgr_close(opened ? ex : NULL);
+        msg_pool_release(pb);
+        return -1;
+    }
+
+    // If currently processing a BLE message, hand the buffer to the BLE path
+    if (g_ble_session_active) {
+        msg_pool_release(g_ble_response);
+        g_ble_response = pb;
+        return 0;
+    }
+
+    // Send via transport (lwIP references the buffer, no copy).  A failed
+    // first transmission is left to MRP to retry.
+    int ret = udp_transport_send(dest_ip, dest_port, packet_buffer_data(pb), pb->length);
+    exchange_mgr_sent(ex, &msg, pb, protocol_now_ms());
+    if (opened) {
+        exchange_mgr_close(ex);
+    }
+    msg_pool_release(pb);
+    return ret;
+}
+
+/**
+ * MRP retransmission: resend the encoded message unchanged
+ */
+static int exchange_transmit(const exchange_ctx_t *ex, const packet_buffer_t *pb) {
+    return udp_transport_send(ex->peer_ip, ex->peer_port,
+                              pb->data + pb->start, pb->length);
+}
+
+/**
+ * MRP standalone acknowledgement (empty Secure Channel message, not reliable)
+ */
+static int exchange_send_ack(const exchange_ctx_t *ex, uint32_t ack_counter) {
+    packet_buffer_t *pb = tx_buffer_begin();
+    if (!pb) {
+        return -1;
+    }
+    
+    matter_message_t msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.protocol_id = PROTOCOL_SECURE_CHANNEL;
+    msg.protocol_opcode = MATTER_SC_OPCODE_MRP_STANDALONE_ACK;
+    msg.exchange_id = ex->exchange_id;
+    msg.exchange_flags = MATTER_EXCH_FLAG_ACK |
+                         (ex->initiator ? MATTER_EXCH_FLAG_INITIATOR : 0);
+    msg.ack_counter = ack_counter;
+    
+    int ret = -1;
+    if (encode_message(ex->session_id, pb, &msg) == 0) {
+        ret = udp_transport_send(ex->peer_ip, ex->peer_port,
+                                 packet_buffer_data(pb), pb->length);
+    }
+    msg_pool_release(pb);
+    return ret;
+}
+
 /**
  * Process CASE message (CASE / Sigma protocol on Secure Channel)
  */
 static int process_case_message(const matter_message_t *msg,
                                 const char *source_ip, uint16_t source_port) {
-    uint8_t response_payload[CASE_SIGMA2_MAX_SIZE];
+    packet_buffer_t *pb = tx_buffer_begin();
+    if (!pb) {
+        return -1;
+    }
+    uint8_t *response_payload = packet_buffer_tail(pb);
+    size_t  response_size = packet_buffer_tailroom(pb);
     size_t  response_len = 0;
     int     ret = -1;
     uint8_t response_opcode = 0;
 
     switch (msg->protocol_opcode) {
         case MATTER_SC_OPCODE_CASE_SIGMA1:
+            /* Resumption skips ECDH, signing and certificates entirely */
+            ret = case_handle_sigma1_resume(msg->payload, msg->payload_length,
+                                            response_payload, response_size,
+                                            &response_len);
+            if (ret == 0) {
+                printf("Matter Protocol: CASE session resumed\n");
+                response_opcode = MATTER_SC_OPCODE_CASE_SIGMA2_RESUME;
+                break;
+            }
+            if (ret != CASE_RESUME_NOT_APPLICABLE) {
+                break;
+            }
             ret = case_handle_sigma1(msg->payload, msg->payload_length,
-                                     response_payload, sizeof(response_payload),
+                                     response_payload, response_size,
                                      &response_len);
             response_opcode = MATTER_SC_OPCODE_CASE_SIGMA2;
             break;
 
         case MATTER_SC_OPCODE_CASE_SIGMA3:
             ret = case_handle_sigma3(msg->payload, msg->payload_length,
-                                     response_payload, sizeof(response_payload),
+                                     response_payload, response_size,
                                      &response_len);
             if (ret == 0) {
                 printf("Matter Protocol: CASE session established\n");
             }
             /* No Sigma4 – session is now active; return success */
+            msg_pool_release(pb);
             return (ret == 0) ? 0 : -1;
 
         default:
             printf("Matter Protocol: Unknown CASE opcode 0x%02x\n",
                    msg->protocol_opcode);
+            msg_pool_release(pb);
             return -1;
     }
 
     if (ret < 0) {
+        msg_pool_release(pb);
         return -1;
     }
 
     if (response_len > 0) {
-        return matter_protocol_send(source_ip, source_port,
-                                    PROTOCOL_SECURE_CHANNEL,
-                                    response_opcode,
-                                    msg->exchange_id,
-                                    response_payload, response_len);
+        if (packet_buffer_commit(pb, response_len) < 0) {
+            msg_pool_release(pb);
+            return -1;
+        }
+        return send_tx_buffer(source_ip, source_port,
+                              msg->header.session_id,
+                              PROTOCOL_SECURE_CHANNEL,
+                              response_opcode,
+                              msg->exchange_id, pb);
     }
+    msg_pool_release(pb);
     return 0;
 }
 
@@ -156,17 +431,23 @@ static int process_case_message(const matter_message_t *msg,
  */
 static int process_pase_message(const matter_message_t *msg,
                                const char *source_ip, uint16_t source_port) {
-    uint8_t response_payload[1024];
+    packet_buffer_t *pb = tx_buffer_begin();
     size_t response_len;
     uint8_t session_id;
     
+    if (!pb) {
+        return -1;
+    }
+    
     // Handle PASE message through commissioning system
     int result = commissioning_handle_pase_message(msg->protocol_opcode,
                                                    msg->payload, msg->payload_length,
-                                                   response_payload, sizeof(response_payload),
+                                                   packet_buffer_tail(pb),
+                                                   packet_buffer_tailroom(pb),
                                                    &response_len, &session_id);
     
     if (result < 0) {
+        msg_pool_release(pb);
         return -1; // Error
     }
     
@@ -180,60 +461,431 @@ static int process_pase_message(const matter_message_t *msg,
         // Determine response opcode based on request
         uint8_t response_opcode = msg->protocol_opcode + 1; // Response is typically request + 1
         
-        return matter_protocol_send(source_ip, source_port,
-                                   PROTOCOL_SECURE_CHANNEL,
-                                   response_opcode,
-                                   msg->exchange_id,
-                                   response_payload, response_len);
+        if (packet_buffer_commit(pb, response_len) < 0) {
+            msg_pool_release(pb);
+            return -1;
+        }
+        return send_tx_buffer(source_ip, source_port,
+                              msg->header.session_id,
+                              PROTOCOL_SECURE_CHANNEL,
+                              response_opcode,
+                              msg->exchange_id, pb);
     }
     
+    msg_pool_release(pb);
     return 0;
 }
 
+/**
+ * Record the address a secure session's message arrived from
+ * Sessions without an active entry give up their slot.
+ */
+static void remember_session_peer(uint16_t session_id,
+                                  const char *ip, uint16_t port) {
+    session_peer_t *slot = NULL;
+    
+    for (int i = 0; i < MAX_SESSIONS; i++) {
+        session_peer_t *peer = &g_session_peers[i];
+        if (peer->session_id == session_id) {
+            slot = peer;
+            break;
+        }
+        if (!slot && (peer->session_id == 0 || !session_is_active(peer->session_id))) {
+            slot = peer;
+        }
+    }
+    if (!slot) {
+        return;
+    }
+    
+    slot->session_id = session_id;
+    slot->port = port;
+    strncpy(slot->ip, ip, sizeof(slot->ip) - 1);
+    slot->ip[sizeof(slot->ip) - 1] = '\0';
+}
+
+/**
+ * Send a subscription's ReportData on a new exchange to the subscriber, or
+ * a priming report on the SubscribeRequest's exchange
+ * (report_send_fn for the report generator)
+ */
+static int send_subscription_report(uint16_t session_id, packet_buffer_t *pb) {
+    const session_peer_t *peer = NULL;
+    
+    if (g_priming && g_priming->session_id == session_id) {
+        if (send_tx_buffer(g_priming->ip, g_priming->port, session_id,
+                           PROTOCOL_INTERACTION_MODEL, OP_REPORT_DATA,
+                           g_priming->exchange_id, pb) < 0) {
+            return REPORT_SEND_RETRY;
+        }
+        return REPORT_SEND_OK;
+    }
+    
+    for (int i = 0; i < MAX_SESSIONS; i++) {
+        if (g_session_peers[i].session_id == session_id) {
+            peer = &g_session_peers[i];
+            break;
+        }
+    }
+    if (!peer || !session_is_active(session_id)) {
+        msg_pool_release(pb);
+        return REPORT_SEND_NO_SESSION;
+    }
+    
+    // Exchange ID 0 never matches a routed request: opens a new exchange
+    if (send_tx_buffer(peer->ip, peer->port, session_id,
+                       PROTOCOL_INTERACTION_MODEL, OP_REPORT_DATA,
+                       0, pb) < 0) {
+        return REPORT_SEND_RETRY;
+    }
+    return REPORT_SEND_OK;
+}
+
+/**
+ * Send the next ReadResponse chunk of a read
+ * Only the one packet buffer holding the chunk is in use; the read stays
+ * pending while MoreChunkedMessages is set.
+ */
+static int send_read_chunk(pending_read_t *read) {
+    packet_buffer_t *pb = tx_buffer_begin();
+    size_t response_len;
+    bool more;
+    
+    read->active = false;
+    if (!pb) {
+        return -1;
+    }
+    
+    // Encode the chunk straight into the packet
+    if (read_handler_encode_chunk(&read->cursor,
+                                  packet_buffer_tail(pb),
+                                  packet_buffer_tailroom(pb),
+                                  &response_len, &more) < 0 ||
+        packet_buffer_commit(pb, response_len) < 0) {
+        msg_pool_release(pb);
+        return -1;
+    }
+    
+    read->active = more;
+    
+    // Send on the read's exchange
+    return send_tx_buffer(read->ip, read->port,
+                          read->session_id,
+                          PROTOCOL_INTERACTION_MODEL,
+                          OP_REPORT_DATA,
+                          read->exchange_id, pb);
+}
+
+/**
+ * Answer the request being routed with a StatusResponse
+ */
+static int send_status_response(const matter_message_t *msg,
+                                const char *source_ip, uint16_t source_port,
+                                im_status_code_t status) {
+    packet_buffer_t *pb = tx_buffer_begin();
+    size_t response_len;
+    
+    if (!pb) {
+        return -1;
+    }
+    
+    if (read_handler_encode_status_response(status, packet_buffer_tail(pb),
+                                            packet_buffer_tailroom(pb),
+                                            &response_len) < 0 ||
+        packet_buffer_commit(pb, response_len) < 0) {
+        msg_pool_release(pb);
+        return -1;
+    }
+    
+    return send_tx_buffer(source_ip, source_port,
+                          msg->header.session_id,
+                          PROTOCOL_INTERACTION_MODEL,
+                          OP_STATUS_RESPONSE,
+                          msg->exchange_id, pb);
+}
+
+/**
+ * Slot for a new read on a session
+ * The session's own read, else a free slot or one whose session is gone;
+ * NULL if every slot holds another session's read.
+ */
+static pending_read_t *pending_read_slot(uint16_t session_id) {
+    pending_read_t *slot = NULL;
+    
+    for (int i = 0; i < MAX_PENDING_READS; i++) {
+        pending_read_t *read = &g_pending_reads[i];
+        if (read->active && read->session_id == session_id) {
+            return read;
+        }
+        if (!slot && (!read->active || !session_is_active(read->session_id))) {
+            slot = read;
+        }
+    }
+    return slot;
+}
+
+/**
+ * Find the read a StatusResponse continues
+ */
+static pending_read_t *find_pending_read(const matter_message_t *msg) {
+    for (int i = 0; i < MAX_PENDING_READS; i++) {
+        pending_read_t *read = &g_pending_reads[i];
+        if (read->active &&
+            read->session_id == msg->header.session_id &&
+            read->exchange_id == msg->exchange_id) {
+            return read;
+        }
+    }
+    return NULL;
+}
+
 /**
  * Process ReadRequest (Interaction Model Protocol)
  */
 static int process_read_request(const matter_message_t *msg,
                                const char *source_ip, uint16_t source_port) {
-    uint8_t response_payload[1024];
-    size_t response_len;
+    pending_read_t *read = pending_read_slot(msg->header.session_id);
+    
+    if (!read) {
+        return send_status_response(msg, source_ip, source_port, IM_STATUS_BUSY);
+    }
+    
+    read->active = false;
+    if (read_handler_parse_request(msg->payload, msg->payload_length,
+                                   &read->cursor) < 0) {
+        return send_status_response(msg, source_ip, source_port,
+                                    IM_STATUS_INVALID_ACTION);
+    }
+    
+    read->session_id = msg->header.session_id;
+    read->exchange_id = msg->exchange_id;
+    read->port = source_port;
+    strncpy(read->ip, source_ip, sizeof(read->ip) - 1);
+    read->ip[sizeof(read->ip) - 1] = '\0';
+    
+    return send_read_chunk(read);
+}
+
+/**
+ * Send the next priming report of the pending SubscribeRequest
+ * A report that cannot be sent abandons the subscription.
+ */
+static int send_priming_report(pending_subscribe_t *sub) {
+    int rc;
+    
+    g_priming = sub;
+    rc = subscribe_handler_send_priming(sub->subscription_id, protocol_now_ms(),
+                                        &sub->more);
+    g_priming = NULL;
+    
+    if (rc != REPORT_SEND_OK) {
+        sub->active = false;
+        subscribe_handler_remove(sub->session_id, sub->subscription_id);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Finish priming: send the SubscribeResponse and start the subscription's
+ * reports
+ */
+static int send_subscribe_response(pending_subscribe_t *sub) {
+    packet_buffer_t *pb = tx_buffer_begin();
+    
+    sub->active = false;
+    if (!pb) {
+        subscribe_handler_remove(sub->session_id, sub->subscription_id);
+        return -1;
+    }
     
-    // Process the ReadRequest and generate ReadResponse
-    if (read_handler_process_request(msg->payload, msg->payload_length,
-                                     response_payload, sizeof(response_payload),
-                                     &response_len) < 0) {
+    memcpy(packet_buffer_tail(pb), sub->response, sub->response_len);
+    if (packet_buffer_commit(pb, sub->response_len) < 0 ||
+        subscribe_handler_activate(sub->subscription_id, protocol_now_ms()) < 0) {
+        msg_pool_release(pb);
         return -1;
     }
     
-    // Send response back to controller
-    return matter_protocol_send(source_ip, source_port,
-                               PROTOCOL_INTERACTION_MODEL,
-                               OP_REPORT_DATA,
-                               msg->exchange_id,
-                               response_payload, response_len);
+    return send_tx_buffer(sub->ip, sub->port,
+                          sub->session_id,
+                          PROTOCOL_INTERACTION_MODEL,
+                          OP_SUBSCRIBE_RESPONSE,
+                          sub->exchange_id, pb);
+}
+
+/**
+ * Continue a priming subscription or a chunked read once the controller
+ * acknowledged the last report
+ */
+static int process_status_response(const matter_message_t *msg) {
+    pending_subscribe_t *sub = &g_pending_subscribe;
+    pending_read_t *read = find_pending_read(msg);
+    im_status_code_t status;
+    
+    if (sub->active &&
+        sub->session_id == msg->header.session_id &&
+        sub->exchange_id == msg->exchange_id) {
+        // The controller can refuse the subscription with a failure status
+        if (read_handler_parse_status_response(msg->payload, msg->payload_length,
+                                               &status) < 0 ||
+            status != IM_STATUS_SUCCESS) {
+            sub->active = false;
+            subscribe_handler_remove(sub->session_id, sub->subscription_id);
+            return 0;
+        }
+        return sub->more ? send_priming_report(sub) : send_subscribe_response(sub);
+    }
+    
+    if (!read) {
+        // Subscriber's answer to a ReportData; MRP acknowledges it
+        return 0;
+    }
+    
+    // The controller can abandon the read with a failure status
+    if (read_handler_parse_status_response(msg->payload, msg->payload_length,
+                                           &status) < 0 ||
+        status != IM_STATUS_SUCCESS) {
+        read->active = false;
+        return 0;
+    }
+    
+    return send_read_chunk(read);
 }
 
 /**
  * Process SubscribeRequest (Interaction Model Protocol)
+ * Answers with the first priming report; the SubscribeResponse follows
+ * once the controller acknowledged the last one.
  */
 static int process_subscribe_request(const matter_message_t *msg,
                                      const char *source_ip, uint16_t source_port) {
-    uint8_t response_payload[1024];
-    size_t response_len;
+    pending_subscribe_t *sub = &g_pending_subscribe;
+    im_status_code_t status = IM_STATUS_FAILURE;
     
-    // Process the SubscribeRequest and generate SubscribeResponse
+    // An unfinished SubscribeRequest is dropped with its subscription
+    if (sub->active) {
+        sub->active = false;
+        subscribe_handler_remove(sub->session_id, sub->subscription_id);
+    }
+    
+    // Process the SubscribeRequest and keep the SubscribeResponse for later
     if (subscribe_handler_process_request(msg->payload, msg->payload_length,
-                                         response_payload, sizeof(response_payload),
-                                         &response_len, msg->header.session_id) < 0) {
+                                         sub->response, sizeof(sub->response),
+                                         &sub->response_len, msg->header.session_id,
+                                         &sub->subscription_id, &status) < 0) {
+        return send_status_response(msg, source_ip, source_port, status);
+    }
+    
+    sub->active = true;
+    sub->session_id = msg->header.session_id;
+    sub->exchange_id = msg->exchange_id;
+    sub->port = source_port;
+    strncpy(sub->ip, source_ip, sizeof(sub->ip) - 1);
+    sub->ip[sizeof(sub->ip) - 1] = '\0';
+    
+    return send_priming_report(sub);
+}
+
+/**
+ * Session type of a request, for interaction model access checks
+ */
+static uint8_t request_auth_mode(const matter_message_t *msg) {
+    uint8_t mode;
+    
+    if (msg->header.session_id == 0 ||
+        session_get_auth_mode(msg->header.session_id, &mode) < 0) {
+        return IM_AUTH_NONE;
+    }
+    return mode == SESSION_AUTH_CASE ? IM_AUTH_CASE : IM_AUTH_PASE;
+}
+
+/**
+ * Process TimedRequest (Interaction Model Protocol)
+ * Opens the window for the WriteRequest or InvokeRequest that follows on
+ * the same exchange.
+ */
+static int process_timed_request(const matter_message_t *msg,
+                                 const char *source_ip, uint16_t source_port) {
+    uint16_t timeout_ms;
+    
+    // Timed interactions only precede writes and commands
+    if (request_auth_mode(msg) == IM_AUTH_NONE) {
+        return send_status_response(msg, source_ip, source_port,
+                                    IM_STATUS_UNSUPPORTED_ACCESS);
+    }
+    
+    if (timed_handler_parse_request(msg->payload, msg->payload_length, &timeout_ms) < 0) {
+        return send_status_response(msg, source_ip, source_port, IM_STATUS_INVALID_ACTION);
+    }
+    
+    timed_handler_begin(msg->header.session_id, msg->exchange_id, timeout_ms,
+                        protocol_now_ms());
+    return send_status_response(msg, source_ip, source_port, IM_STATUS_SUCCESS);
+}
+
+/**
+ * WriteRequest / InvokeRequest handler (same signature)
+ */
+typedef int (*im_action_fn)(const uint8_t *request_tlv, size_t request_len,
+                            bool timed, uint8_t auth_mode, uint32_t now_ms,
+                            uint8_t *response_tlv, size_t max_response_len,
+                            size_t *actual_len, bool *suppress,
+                            im_status_code_t *status);
+
+/**
+ * Process WriteRequest or InvokeRequest (Interaction Model Protocol)
+ * The response is a WriteResponse / InvokeResponse, a StatusResponse if
+ * the request failed as a whole, or nothing if the request suppressed it
+ * (MRP still acknowledges the request).  Only secure (PASE or CASE)
+ * sessions may write or invoke.
+ */
+static int process_action_request(const matter_message_t *msg,
+                                  const char *source_ip, uint16_t source_port,
+                                  im_action_fn handler, uint8_t response_opcode) {
+    uint32_t now = protocol_now_ms();
+    im_status_code_t status;
+    size_t response_len;
+    bool suppress;
+    bool timed;
+    uint8_t auth_mode = request_auth_mode(msg);
+    
+    if (auth_mode == IM_AUTH_NONE) {
+        return send_status_response(msg, source_ip, source_port,
+                                    IM_STATUS_UNSUPPORTED_ACCESS);
+    }
+    
+    if (timed_handler_end(msg->header.session_id, msg->exchange_id, now, &timed) < 0) {
+        return send_status_response(msg, source_ip, source_port, IM_STATUS_TIMEOUT);
+    }
+    
+    packet_buffer_t *pb = tx_buffer_begin();
+    if (!pb) {
+        return -1;
+    }
+    
+    // Encode the response straight into the packet
+    if (handler(msg->payload, msg->payload_length, timed, auth_mode, now,
+                packet_buffer_tail(pb), packet_buffer_tailroom(pb),
+                &response_len, &suppress, &status) < 0) {
+        msg_pool_release(pb);
+        return send_status_response(msg, source_ip, source_port, status);
+    }
+    
+    if (suppress) {
+        msg_pool_release(pb);
+        return 0;
+    }
+    
+    if (packet_buffer_commit(pb, response_len) < 0) {
+        msg_pool_release(pb);
         return -1;
     }
     
-    // Send response back to controller
-    return matter_protocol_send(source_ip, source_port,
-                               PROTOCOL_INTERACTION_MODEL,
-                               OP_SUBSCRIBE_RESPONSE,
-                               msg->exchange_id,
-                               response_payload, response_len);
+    return send_tx_buffer(source_ip, source_port,
+                          msg->header.session_id,
+                          PROTOCOL_INTERACTION_MODEL,
+                          response_opcode,
+                          msg->exchange_id, pb);
 }
 
 /**
@@ -259,10 +911,21 @@ static int route_message(const matter_message_t *msg,
                 case OP_SUBSCRIBE_REQUEST:
                     return process_subscribe_request(msg, source_ip, source_port);
                 
+                case OP_STATUS_RESPONSE:
+                    return process_status_response(msg);
+                
+                case OP_TIMED_REQUEST:
+                    return process_timed_request(msg, source_ip, source_port);
+                
                 case OP_WRITE_REQUEST:
+                    return process_action_request(msg, source_ip, source_port,
+                                                  write_handler_process_request,
+                                                  OP_WRITE_RESPONSE);
+                
                 case OP_INVOKE_REQUEST:
-                    // Not implemented yet
-                    return 0;
+                    return process_action_request(msg, source_ip, source_port,
+                                                  command_handler_process_request,
+                                                  OP_INVOKE_RESPONSE);
                 
                 default:
                     return -1;
@@ -274,6 +937,43 @@ static int route_message(const matter_message_t *msg,
     }
 }
 
+/**
+ * Decrypt a secured message in place in its receive buffer
+ * The message header authenticates as AAD; on success msg->payload points
+ * at the plaintext application payload inside message.
+ */
+static int decrypt_payload(uint8_t *message, matter_message_t *msg) {
+    if (session_decrypt_message(message, msg) != 0) {
+        return -1;
+    }
+    
+    // The exchange header is part of the encrypted payload
+    if (matter_exchange_header_decode(msg) != MATTER_MSG_SUCCESS) {
+        return -1;
+    }
+    
+    return 0;
+}
+
+/**
+ * Replay protection: drop duplicate or out-of-window message counters
+ * Secured messages must already be decrypted (authenticated) so that a
+ * forged counter cannot advance the window.
+ *
+ * @return true if the message should be dropped
+ */
+static bool is_replayed(const matter_message_t *msg) {
+    int rc = msg_counter_check(&msg->header);
+    if (rc == MSG_COUNTER_OK) {
+        return false;
+    }
+    
+    printf("Matter Protocol: Dropping %s message (session %u, counter %lu)\n",
+           rc == MSG_COUNTER_DUPLICATE ? "duplicate" : "stale",
+           msg->header.session_id, (unsigned long)msg->header.message_counter);
+    return true;
+}
+
 /**
  * Process incoming Matter messages
  */
@@ -282,56 +982,75 @@ int matter_protocol_task(void) {
         return -1;
     }
     
-    uint8_t buffer[MATTER_MAX_MESSAGE_SIZE];
     char source_ip[40];
     uint16_t source_port;
-    size_t recv_len;
     int messages_processed = 0;
+    packet_buffer_t *rx;
     
-    // Static buffer for decrypted payloads to avoid use-after-free concerns
-    // While the stack-local buffer was technically safe (in scope during route_message),
-    // using a static buffer is more robust and eliminates any potential lifetime issues
-    static uint8_t plaintext_buffer[MATTER_MAX_PAYLOAD_SIZE];
+    // MRP timers: retransmissions and standalone ACKs that are due
+    uint32_t now_ms = protocol_now_ms();
+    exchange_mgr_poll(now_ms);
     
-    // Check subscription intervals for periodic reporting
-    // Note: In production, this would use actual time from pico SDK
-    // For now, we pass 0 to indicate time checking is not active
-    subscribe_handler_check_intervals(0);
+    // Idle session expiry (only looks at the least recently used session)
+    session_mgr_poll();
     
-    // Process all available messages
-    while (udp_transport_recv(buffer, sizeof(buffer), &recv_len,
-                             source_ip, sizeof(source_ip), &source_port) == 0) {
+    // Process all available messages; each arrives in a message pool block
+    while (udp_transport_recv_buffer(&rx, source_ip, sizeof(source_ip),
+                                     &source_port) == 0) {
         matter_message_t msg;
         
         // Decode Matter message header
-        if (matter_message_decode(buffer, recv_len, &msg) < 0) {
+        if (matter_message_decode_fast(packet_buffer_data(rx), rx->length, &msg) < 0) {
+            msg_pool_release(rx);
+            continue;
+        }
+        
+        // Secured message - decrypt in place
+        if (msg.header.session_id != 0 &&
+            decrypt_payload(packet_buffer_data(rx), &msg) < 0) {
+            msg_pool_release(rx);
+            continue;
+        }
+        
+        // Exchange layer: ACKs and duplicates stop here (duplicates of
+        // reliable messages are re-acknowledged), the rest get a context
+        exchange_ctx_t *ex = NULL;
+        if (exchange_mgr_on_message(&msg, is_replayed(&msg), source_ip,
+                                    source_port, now_ms, &ex) != EXCHANGE_RX_DELIVER) {
+            msg_pool_release(rx);
             continue;
         }
         
-        // Check if message needs decryption
         if (msg.header.session_id != 0) {
-            // Secured message - decrypt payload into persistent buffer
-            size_t plaintext_len;
-            
-            if (session_decrypt(msg.header.session_id,
-                              msg.payload, msg.payload_length,
-                              plaintext_buffer, sizeof(plaintext_buffer),
-                              &plaintext_len) == 0) {
-                // Update message with decrypted payload
-                // Safe to use plaintext_buffer as it's static and persists
-                msg.payload = plaintext_buffer;
-                msg.payload_length = plaintext_len;
-            } else {
-                // Decryption failed
-                continue;
-            }
+            remember_session_peer(msg.header.session_id, source_ip, source_port);
         }
         
         // Route message to appropriate handler
-        // msg.payload is now either the original buffer (unsecured) or plaintext_buffer (secured)
+        // msg.payload points into rx, which stays allocated until routing
+        // returns
+        g_rx_exchange = ex;
         if (route_message(&msg, source_ip, source_port) == 0) {
             messages_processed++;
         }
+        g_rx_exchange = NULL;
+        
+        // An ACK the handler did not piggyback goes out standalone after
+        // MRP_STANDALONE_ACK_TIMEOUT_MS
+        exchange_mgr_close(ex);
+        msg_pool_release(rx);
+    }
+    
+    // Subscription reports that are due (changes past their min interval,
+    // max-interval keep-alives, first reports of new subscriptions)
+    subscribe_handler_check_intervals(protocol_now_ms());
+    
+    // End an expired fail-safe, dropping credentials it staged
+    cluster_general_commissioning_fail_safe_armed(protocol_now_ms());
+    
+    // Idle pass: precompute an ephemeral key pair for the next PASE/CASE
+    // handshake (one per pass to keep the loop responsive)
+    if (messages_processed == 0) {
+        ephemeral_pool_poll();
     }
     
     return messages_processed;
@@ -341,6 +1060,7 @@ int matter_protocol_task(void) {
  * Send a Matter message
  */
 int matter_protocol_send(const char *dest_ip, uint16_t dest_port,
+                        uint16_t session_id,
                         uint16_t protocol_id, uint8_t opcode,
                         uint16_t exchange_id,
                         const uint8_t *payload, size_t payload_len) {
@@ -348,39 +1068,20 @@ int matter_protocol_send(const char *dest_ip, uint16_t dest_port,
         return -1;
     }
     
-    uint8_t buffer[MATTER_MAX_MESSAGE_SIZE];
-    size_t encoded_len;
-    
-    // Build Matter message
-    matter_message_t msg;
-    memset(&msg, 0, sizeof(msg));
-    
-    msg.header.flags = MATTER_MSG_VERSION;
-    msg.header.session_id = 0;  // Unsecured for now
-    msg.header.security_flags = 0;
-    msg.header.message_counter = matter_message_get_next_counter();
-    msg.protocol_id = protocol_id;
-    msg.protocol_opcode = opcode;
-    msg.exchange_id = exchange_id;
-    msg.payload = payload;
-    msg.payload_length = payload_len;
-    
-    // Encode message
-    if (matter_message_encode(&msg, buffer, sizeof(buffer), &encoded_len) < 0) {
+    // Callers holding a separate payload pay a single copy into the packet
+    packet_buffer_t *pb = tx_buffer_begin();
+    if (!pb) {
         return -1;
     }
-
-    // If currently processing a BLE message, capture response for BLE delivery
-    if (g_ble_session_active) {
-        if (encoded_len <= sizeof(g_ble_response_buf)) {
-            memcpy(g_ble_response_buf, buffer, encoded_len);
-            g_ble_response_len = encoded_len;
-        }
-        return 0;
+    if (payload_len > packet_buffer_tailroom(pb)) {
+        msg_pool_release(pb);
+        return -1;
     }
+    memcpy(packet_buffer_tail(pb), payload, payload_len);
+    packet_buffer_commit(pb, payload_len);
 
-    // Send via transport
-    return udp_transport_send(dest_ip, dest_port, buffer, encoded_len);
+    return send_tx_buffer(dest_ip, dest_port, session_id,
+                          protocol_id, opcode, exchange_id, pb);
 }
 
 /**
@@ -407,66 +1108,49 @@ bool matter_protocol_is_commissioned(void) {
  * Matter message received over the BLE COBLe channel and return the encoded
  * response (if any) that must be sent back to the controller via BLE notify.
  *
- * @param input        Raw bytes of the received Matter message
+ * @param input        Raw bytes of the received Matter message (secured
+ *                     messages are decrypted in place)
  * @param input_len    Length of input
- * @param output       Buffer to receive the encoded response
- * @param output_size  Size of output buffer
- * @param output_len   Set to the actual response length (0 = no response)
+ * @param response     Set to the message pool block holding the encoded
+ *                     response (NULL = no response); caller must release it
  * @return 0 on success, -1 on decode/route failure
  */
-int matter_protocol_process_ble_message(const uint8_t *input, size_t input_len,
-                                         uint8_t *output, size_t output_size,
-                                         size_t *output_len) {
-    if (!initialized || !input || !output_len) {
+int matter_protocol_process_ble_message(uint8_t *input, size_t input_len,
+                                         packet_buffer_t **response) {
+    if (!initialized || !input || !response) {
         return -1;
     }
 
-    static uint8_t plaintext_ble[MATTER_MAX_PAYLOAD_SIZE];
-    /* NOTE: static is safe here because the entire firmware runs on a single
-     * cooperative thread (Core 0); matter_protocol_process_ble_message() is
-     * never called concurrently.  This avoids 1280-byte stack allocation.  */
+    *response = NULL;
 
     matter_message_t msg;
-    if (matter_message_decode(input, input_len, &msg) < 0) {
+    if (matter_message_decode_fast(input, input_len, &msg) < 0) {
         printf("BLE Matter: Failed to decode message\n");
         return -1;
     }
 
-    /* Decrypt if secured */
-    if (msg.header.session_id != 0) {
-        size_t plaintext_len;
-        if (session_decrypt(msg.header.session_id,
-                            msg.payload, msg.payload_length,
-                            plaintext_ble, sizeof(plaintext_ble),
-                            &plaintext_len) == 0) {
-            msg.payload        = plaintext_ble;
-            msg.payload_length = plaintext_len;
-        } else {
-            printf("BLE Matter: Decryption failed\n");
-            return -1;
-        }
+    /* Decrypt in place if secured */
+    if (msg.header.session_id != 0 && decrypt_payload(input, &msg) < 0) {
+        printf("BLE Matter: Decryption failed\n");
+        return -1;
     }
 
-    /* Activate BLE session so matter_protocol_send() captures the response */
+    if (is_replayed(&msg)) {
+        return -1;
+    }
+
+    /* Activate BLE session so send_tx_buffer() hands over the response */
     g_ble_session_active = true;
-    g_ble_response_len   = 0;
+    g_ble_response       = NULL;
 
     /* Route through existing handlers (PASE, IM, etc.) */
     route_message(&msg, "ble", 0);
 
     g_ble_session_active = false;
 
-    /* Return captured response to caller */
-    if (g_ble_response_len > 0 && output) {
-        size_t copy_len = g_ble_response_len;
-        if (copy_len > output_size) {
-            copy_len = output_size;
-        }
-        memcpy(output, g_ble_response_buf, copy_len);
-        *output_len = copy_len;
-    } else {
-        *output_len = 0;
-    }
+    /* Transfer ownership of the captured response to the caller */
+    *response      = g_ble_response;
+    g_ble_response = NULL;
 
     return 0;
 }
@@ -480,9 +1164,14 @@ void matter_protocol_deinit(void) {
     }
     
     // Clean up in reverse order
+    report_generator_set_sender(NULL);
+    g_pending_subscribe.active = false;
+    subscribe_handler_clear_all();
+    timed_handler_reset();
     case_deinit();
     attestation_deinit();
     commissioning_deinit();
+    exchange_mgr_init(NULL, NULL);  // Drops retained retransmissions
     udp_transport_deinit();
     
     initialized = false;
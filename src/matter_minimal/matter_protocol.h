@@ -10,6 +10,7 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <stdbool.h>
+#include "codec/packet_buffer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -53,20 +54,18 @@ int matter_protocol_task(void);
  * Process a raw Matter message received over BLE (COBLe channel).
  *
  * Decodes, decrypts (if secured) and routes the message through the same
- * handlers as UDP messages.  The encoded response (if any) is placed in
- * *output and should be sent back to the BLE controller via
- * ble_adapter_send_data().
+ * handlers as UDP messages.  The encoded response (if any) is returned as a
+ * message pool block owned by the caller; pass it to
+ * ble_adapter_send_buffer() and then release it with msg_pool_release().
  *
- * @param input       Raw bytes of the received Matter message
- * @param input_len   Length of input
- * @param output      Buffer to receive the encoded response
- * @param output_size Size of output buffer
- * @param output_len  Set to the actual response length (0 = no response)
+ * @param input     Raw bytes of the received Matter message (secured
+ *                  messages are decrypted in place)
+ * @param input_len Length of input
+ * @param response  Set to the response block (NULL = no response)
  * @return 0 on success, -1 on failure
  */
-int matter_protocol_process_ble_message(const uint8_t *input, size_t input_len,
-                                         uint8_t *output, size_t output_size,
-                                         size_t *output_len);
+int matter_protocol_process_ble_message(uint8_t *input, size_t input_len,
+                                         packet_buffer_t **response);
 
 /**
  * Deinitialize Matter protocol stack
@@ -80,6 +79,8 @@ void matter_protocol_deinit(void);
  * 
  * @param dest_ip Destination IP address
  * @param dest_port Destination port
+ * @param session_id Local secure session ID (0 = unsecured); secured
+ *                   messages are encrypted with the session's keys
  * @param protocol_id Protocol ID
  * @param opcode Protocol opcode
  * @param exchange_id Exchange ID (should match request for responses)
@@ -88,6 +89,7 @@ void matter_protocol_deinit(void);
  * @return 0 on success, -1 on failure
  */
 int matter_protocol_send(const char *dest_ip, uint16_t dest_port,
+                        uint16_t session_id,
                         uint16_t protocol_id, uint8_t opcode,
                         uint16_t exchange_id,
                         const uint8_t *payload, size_t payload_len);
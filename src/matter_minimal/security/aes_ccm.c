@@ -0,0 +1,598 @@
+/*
+ * aes_ccm.c
+ * AES-128 block cipher backend and fused AES-128-CCM (RFC 3610)
+ *
+ * Bitsliced layout (constant-time backend): the 32 bytes of two blocks
+ * are held in eight words q[0..7], where q[b] holds bit b of every byte.
+ * Bit position 16 * block + 4 * row + col holds state byte (row, col), so
+ * ShiftRows rotates each 4-bit row group and MixColumns rotates rows by
+ * whole nibbles; both are a few shifts and masks per word.
+ */
+
+#include "aes_ccm.h"
+#include "secure_zero.h"
+#include <string.h>
+#include <stdbool.h>
+
+#ifdef AES_CCM_USE_MBEDTLS
+
+/* ------------------------------------------------------------------ */
+/* mbedTLS backend                                                      */
+/* ------------------------------------------------------------------ */
+
+int aes_ccm_setkey(aes_ccm_ctx_t *ctx, const uint8_t *key, size_t key_len) {
+    if (!ctx || !key || key_len != AES_CCM_KEY_LENGTH) {
+        return AES_CCM_ERR_INVALID;
+    }
+    mbedtls_aes_init(&ctx->aes);
+    if (mbedtls_aes_setkey_enc(&ctx->aes, key, AES_CCM_KEY_LENGTH * 8) != 0) {
+        mbedtls_aes_free(&ctx->aes);
+        return AES_CCM_ERR_INVALID;
+    }
+    return 0;
+}
+
+void aes_ccm_free(aes_ccm_ctx_t *ctx) {
+    if (ctx) {
+        mbedtls_aes_free(&ctx->aes);
+    }
+}
+
+void aes_ccm_block_encrypt_x2(const aes_ccm_ctx_t *ctx,
+                              const uint8_t in0[AES_CCM_BLOCK_SIZE],
+                              const uint8_t in1[AES_CCM_BLOCK_SIZE],
+                              uint8_t out0[AES_CCM_BLOCK_SIZE],
+                              uint8_t out1[AES_CCM_BLOCK_SIZE]) {
+    uint8_t second[AES_CCM_BLOCK_SIZE];
+    memcpy(second, in1, AES_CCM_BLOCK_SIZE);    // in1 may alias out0
+    mbedtls_aes_crypt_ecb((mbedtls_aes_context *)&ctx->aes, MBEDTLS_AES_ENCRYPT,
+                          in0, out0);
+    mbedtls_aes_crypt_ecb((mbedtls_aes_context *)&ctx->aes, MBEDTLS_AES_ENCRYPT,
+                          second, out1);
+}
+
+static void block_encrypt(const aes_ccm_ctx_t *ctx,
+                          const uint8_t in[AES_CCM_BLOCK_SIZE],
+                          uint8_t out[AES_CCM_BLOCK_SIZE]) {
+    mbedtls_aes_crypt_ecb((mbedtls_aes_context *)&ctx->aes, MBEDTLS_AES_ENCRYPT,
+                          in, out);
+}
+
+#else
+
+/* ------------------------------------------------------------------ */
+/* Constant-time bitsliced backend                                      */
+/* ------------------------------------------------------------------ */
+
+static inline void swapmove(uint32_t *a, uint32_t *b, uint32_t mask, int n) {
+    uint32_t t = ((*a >> n) ^ *b) & mask;
+    *b ^= t;
+    *a ^= t << n;
+}
+
+/**
+ * Transpose between byte-lane and bit-plane form (an involution)
+ * Byte lane l, bit b of word i  <->  bit 8 * l + i of word b.
+ */
+static void ortho(uint32_t q[8]) {
+    swapmove(&q[0], &q[1], 0x55555555, 1);
+    swapmove(&q[2], &q[3], 0x55555555, 1);
+    swapmove(&q[4], &q[5], 0x55555555, 1);
+    swapmove(&q[6], &q[7], 0x55555555, 1);
+
+    swapmove(&q[0], &q[2], 0x33333333, 2);
+    swapmove(&q[1], &q[3], 0x33333333, 2);
+    swapmove(&q[4], &q[6], 0x33333333, 2);
+    swapmove(&q[5], &q[7], 0x33333333, 2);
+
+    swapmove(&q[0], &q[4], 0x0F0F0F0F, 4);
+    swapmove(&q[1], &q[5], 0x0F0F0F0F, 4);
+    swapmove(&q[2], &q[6], 0x0F0F0F0F, 4);
+    swapmove(&q[3], &q[7], 0x0F0F0F0F, 4);
+}
+
+/**
+ * Load two blocks (column-major bytes) into bitsliced form
+ * Rows 0/2 go to words 0-3 and rows 1/3 to words 4-7 so that after the
+ * transpose byte (row, col) of block k sits at bit 16k + 4 row + col.
+ */
+static void load_blocks(uint32_t q[8], const uint8_t *in0, const uint8_t *in1) {
+    for (int col = 0; col < 4; col++) {
+        const uint8_t *a = in0 + 4 * col;
+        const uint8_t *b = in1 + 4 * col;
+        q[col] = (uint32_t)a[0] | ((uint32_t)a[2] << 8) |
+                 ((uint32_t)b[0] << 16) | ((uint32_t)b[2] << 24);
+        q[4 + col] = (uint32_t)a[1] | ((uint32_t)a[3] << 8) |
+                     ((uint32_t)b[1] << 16) | ((uint32_t)b[3] << 24);
+    }
+    ortho(q);
+}
+
+/**
+ * Inverse of load_blocks() (destroys q)
+ */
+static void store_blocks(uint32_t q[8], uint8_t *out0, uint8_t *out1) {
+    ortho(q);
+    for (int col = 0; col < 4; col++) {
+        uint8_t *a = out0 + 4 * col;
+        uint8_t *b = out1 + 4 * col;
+        a[0] = (uint8_t)q[col];
+        a[2] = (uint8_t)(q[col] >> 8);
+        b[0] = (uint8_t)(q[col] >> 16);
+        b[2] = (uint8_t)(q[col] >> 24);
+        a[1] = (uint8_t)q[4 + col];
+        a[3] = (uint8_t)(q[4 + col] >> 8);
+        b[1] = (uint8_t)(q[4 + col] >> 16);
+        b[3] = (uint8_t)(q[4 + col] >> 24);
+    }
+}
+
+/**
+ * AES S-box on all 32 bytes at once
+ * Boyar-Peralta circuit: GF(2^8) inversion plus affine map in 113 XOR/AND/
+ * XNOR gates.  q[7] is the most significant bit.
+ */
+static void sub_bytes(uint32_t q[8]) {
+    uint32_t x0, x1, x2, x3, x4, x5, x6, x7;
+    uint32_t y1, y2, y3, y4, y5, y6, y7, y8, y9, y10, y11;
+    uint32_t y12, y13, y14, y15, y16, y17, y18, y19, y20, y21;
+    uint32_t z0, z1, z2, z3, z4, z5, z6, z7, z8, z9;
+    uint32_t z10, z11, z12, z13, z14, z15, z16, z17;
+    uint32_t t0, t1, t2, t3, t4, t5, t6, t7, t8, t9;
+    uint32_t t10, t11, t12, t13, t14, t15, t16, t17, t18, t19;
+    uint32_t t20, t21, t22, t23, t24, t25, t26, t27, t28, t29;
+    uint32_t t30, t31, t32, t33, t34, t35, t36, t37, t38, t39;
+    uint32_t t40, t41, t42, t43, t44, t45, t46, t47, t48, t49;
+    uint32_t t50, t51, t52, t53, t54, t55, t56, t57, t58, t59;
+    uint32_t t60, t61, t62, t63, t64, t65, t66, t67;
+    uint32_t s0, s1, s2, s3, s4, s5, s6, s7;
+
+    x0 = q[7];
+    x1 = q[6];
+    x2 = q[5];
+    x3 = q[4];
+    x4 = q[3];
+    x5 = q[2];
+    x6 = q[1];
+    x7 = q[0];
+
+    // Top linear transformation
+    y14 = x3 ^ x5;
+    y13 = x0 ^ x6;
+    y9 = x0 ^ x3;
+    y8 = x0 ^ x5;
+    t0 = x1 ^ x2;
+    y1 = t0 ^ x7;
+    y4 = y1 ^ x3;
+    y12 = y13 ^ y14;
+    y2 = y1 ^ x0;
+    y5 = y1 ^ x6;
+    y3 = y5 ^ y8;
+    t1 = x4 ^ y12;
+    y15 = t1 ^ x5;
+    y20 = t1 ^ x1;
+    y6 = y15 ^ x7;
+    y10 = y15 ^ t0;
+    y11 = y20 ^ y9;
+    y7 = x7 ^ y11;
+    y17 = y10 ^ y11;
+    y19 = y10 ^ y8;
+    y16 = t0 ^ y11;
+    y21 = y13 ^ y16;
+    y18 = x0 ^ y16;
+
+    // Non-linear section (GF(2^4) inversion)
+    t2 = y12 & y15;
+    t3 = y3 & y6;
+    t4 = t3 ^ t2;
+    t5 = y4 & x7;
+    t6 = t5 ^ t2;
+    t7 = y13 & y16;
+    t8 = y5 & y1;
+    t9 = t8 ^ t7;
+    t10 = y2 & y7;
+    t11 = t10 ^ t7;
+    t12 = y9 & y11;
+    t13 = y14 & y17;
+    t14 = t13 ^ t12;
+    t15 = y8 & y10;
+    t16 = t15 ^ t12;
+    t17 = t4 ^ t14;
+    t18 = t6 ^ t16;
+    t19 = t9 ^ t14;
+    t20 = t11 ^ t16;
+    t21 = t17 ^ y20;
+    t22 = t18 ^ y19;
+    t23 = t19 ^ y21;
+    t24 = t20 ^ y18;
+
+    t25 = t21 ^ t22;
+    t26 = t21 & t23;
+    t27 = t24 ^ t26;
+    t28 = t25 & t27;
+    t29 = t28 ^ t22;
+    t30 = t23 ^ t24;
+    t31 = t22 ^ t26;
+    t32 = t31 & t30;
+    t33 = t32 ^ t24;
+    t34 = t23 ^ t33;
+    t35 = t27 ^ t33;
+    t36 = t24 & t35;
+    t37 = t36 ^ t34;
+    t38 = t27 ^ t36;
+    t39 = t29 & t38;
+    t40 = t25 ^ t39;
+
+    t41 = t40 ^ t37;
+    t42 = t29 ^ t33;
+    t43 = t29 ^ t40;
+    t44 = t33 ^ t37;
+    t45 = t42 ^ t41;
+    z0 = t44 & y15;
+    z1 = t37 & y6;
+    z2 = t33 & x7;
+    z3 = t43 & y16;
+    z4 = t40 & y1;
+    z5 = t29 & y7;
+    z6 = t42 & y11;
+    z7 = t45 & y17;
+    z8 = t41 & y10;
+    z9 = t44 & y12;
+    z10 = t37 & y3;
+    z11 = t33 & y4;
+    z12 = t43 & y13;
+    z13 = t40 & y5;
+    z14 = t29 & y2;
+    z15 = t42 & y9;
+    z16 = t45 & y14;
+    z17 = t41 & y8;
+
+    // Bottom linear transformation
+    t46 = z15 ^ z16;
+    t47 = z10 ^ z11;
+    t48 = z5 ^ z13;
+    t49 = z9 ^ z10;
+    t50 = z2 ^ z12;
+    t51 = z2 ^ z5;
+    t52 = z7 ^ z8;
+    t53 = z0 ^ z3;
+    t54 = z6 ^ z7;
+    t55 = z16 ^ z17;
+    t56 = z12 ^ t48;
+    t57 = t50 ^ t53;
+    t58 = z4 ^ t46;
+    t59 = z3 ^ t54;
+    t60 = t46 ^ t57;
+    t61 = z14 ^ t57;
+    t62 = t52 ^ t58;
+    t63 = t49 ^ t58;
+    t64 = z4 ^ t59;
+    t65 = t61 ^ t62;
+    t66 = z1 ^ t63;
+    s0 = t59 ^ t63;
+    s6 = t56 ^ ~t62;
+    s7 = t48 ^ ~t60;
+    t67 = t64 ^ t65;
+    s3 = t53 ^ t66;
+    s4 = t51 ^ t66;
+    s5 = t47 ^ t65;
+    s1 = t64 ^ ~s3;
+    s2 = t55 ^ ~t67;
+
+    q[7] = s0;
+    q[6] = s1;
+    q[5] = s2;
+    q[4] = s3;
+    q[3] = s4;
+    q[2] = s5;
+    q[1] = s6;
+    q[0] = s7;
+}
+
+/**
+ * ShiftRows: row r (bits 4r..4r+3 of each half) rotates left by r columns
+ */
+static void shift_rows(uint32_t q[8]) {
+    for (int i = 0; i < 8; i++) {
+        uint32_t x = q[i];
+        q[i] = (x & 0x000F000F)
+             | ((x & 0x00E000E0) >> 1) | ((x & 0x00100010) << 3)
+             | ((x & 0x0C000C00) >> 2) | ((x & 0x03000300) << 2)
+             | ((x & 0x80008000) >> 3) | ((x & 0x70007000) << 1);
+    }
+}
+
+/**
+ * Row r of each column takes row r + 1 (mod 4)
+ */
+static inline uint32_t rotate_rows1(uint32_t x) {
+    return ((x >> 4) & 0x0FFF0FFF) | ((x << 12) & 0xF000F000);
+}
+
+/**
+ * Row r of each column takes row r + 2 (mod 4)
+ */
+static inline uint32_t rotate_rows2(uint32_t x) {
+    return ((x >> 8) & 0x00FF00FF) | ((x << 8) & 0xFF00FF00);
+}
+
+/**
+ * MixColumns: out = 2(a ^ a1) ^ a1 ^ (a2 ^ a3), where ak is row r + k.
+ * Multiplication by 2 (xtime) is a rewiring of the bit planes.
+ */
+static void mix_columns(uint32_t q[8]) {
+    uint32_t r[8];
+    uint32_t t[8];
+
+    for (int i = 0; i < 8; i++) {
+        r[i] = rotate_rows1(q[i]);
+        t[i] = q[i] ^ r[i];
+    }
+
+    q[0] = t[7] ^ r[0] ^ rotate_rows2(t[0]);
+    q[1] = t[0] ^ t[7] ^ r[1] ^ rotate_rows2(t[1]);
+    q[2] = t[1] ^ r[2] ^ rotate_rows2(t[2]);
+    q[3] = t[2] ^ t[7] ^ r[3] ^ rotate_rows2(t[3]);
+    q[4] = t[3] ^ t[7] ^ r[4] ^ rotate_rows2(t[4]);
+    q[5] = t[4] ^ r[5] ^ rotate_rows2(t[5]);
+    q[6] = t[5] ^ r[6] ^ rotate_rows2(t[6]);
+    q[7] = t[6] ^ r[7] ^ rotate_rows2(t[7]);
+}
+
+static inline void add_round_key(uint32_t q[8], const uint32_t rk[8]) {
+    for (int i = 0; i < 8; i++) {
+        q[i] ^= rk[i];
+    }
+}
+
+/**
+ * SubWord for the key schedule, through the same S-box circuit
+ */
+static uint32_t sub_word(uint32_t w) {
+    uint32_t q[8] = { w, 0, 0, 0, 0, 0, 0, 0 };
+
+    ortho(q);
+    sub_bytes(q);
+    ortho(q);
+    return q[0];
+}
+
+int aes_ccm_setkey(aes_ccm_ctx_t *ctx, const uint8_t *key, size_t key_len) {
+    if (!ctx || !key || key_len != AES_CCM_KEY_LENGTH) {
+        return AES_CCM_ERR_INVALID;
+    }
+
+    // Byte-wise key expansion (FIPS-197 §5.2), words little-endian
+    uint32_t w[4 * (AES_CCM_ROUNDS + 1)];
+    uint8_t round_key[AES_CCM_BLOCK_SIZE];
+    uint32_t rcon = 0x01;
+
+    for (int i = 0; i < 4; i++) {
+        w[i] = (uint32_t)key[4 * i] | ((uint32_t)key[4 * i + 1] << 8) |
+               ((uint32_t)key[4 * i + 2] << 16) | ((uint32_t)key[4 * i + 3] << 24);
+    }
+    for (int i = 4; i < 4 * (AES_CCM_ROUNDS + 1); i++) {
+        uint32_t t = w[i - 1];
+        if ((i & 3) == 0) {
+            t = sub_word((t >> 8) | (t << 24)) ^ rcon;
+            rcon = ((rcon << 1) ^ ((rcon >> 7) * 0x1B)) & 0xFF;
+        }
+        w[i] = w[i - 4] ^ t;
+    }
+
+    // Bitslice each round key into both block lanes
+    for (int r = 0; r <= AES_CCM_ROUNDS; r++) {
+        for (int i = 0; i < 16; i++) {
+            round_key[i] = (uint8_t)(w[4 * r + (i >> 2)] >> (8 * (i & 3)));
+        }
+        load_blocks(ctx->rk[r], round_key, round_key);
+    }
+
+    secure_zero(w, sizeof(w));
+    secure_zero(round_key, sizeof(round_key));
+    return 0;
+}
+
+void aes_ccm_free(aes_ccm_ctx_t *ctx) {
+    if (ctx) {
+        secure_zero(ctx, sizeof(*ctx));
+    }
+}
+
+void aes_ccm_block_encrypt_x2(const aes_ccm_ctx_t *ctx,
+                              const uint8_t in0[AES_CCM_BLOCK_SIZE],
+                              const uint8_t in1[AES_CCM_BLOCK_SIZE],
+                              uint8_t out0[AES_CCM_BLOCK_SIZE],
+                              uint8_t out1[AES_CCM_BLOCK_SIZE]) {
+    uint32_t q[8];
+
+    load_blocks(q, in0, in1);
+    add_round_key(q, ctx->rk[0]);
+    for (int r = 1; r < AES_CCM_ROUNDS; r++) {
+        sub_bytes(q);
+        shift_rows(q);
+        mix_columns(q);
+        add_round_key(q, ctx->rk[r]);
+    }
+    sub_bytes(q);
+    shift_rows(q);
+    add_round_key(q, ctx->rk[AES_CCM_ROUNDS]);
+    store_blocks(q, out0, out1);
+}
+
+/**
+ * Single block: the second lane is free, so duplicate the input
+ */
+static void block_encrypt(const aes_ccm_ctx_t *ctx,
+                          const uint8_t in[AES_CCM_BLOCK_SIZE],
+                          uint8_t out[AES_CCM_BLOCK_SIZE]) {
+    uint8_t unused[AES_CCM_BLOCK_SIZE];
+    aes_ccm_block_encrypt_x2(ctx, in, in, out, unused);
+}
+
+#endif // AES_CCM_USE_MBEDTLS
+
+/* ------------------------------------------------------------------ */
+/* Fused CCM                                                            */
+/* ------------------------------------------------------------------ */
+
+/**
+ * Write value big-endian into the last len bytes of a block
+ */
+static void put_be(uint8_t *p, size_t len, size_t value) {
+    for (size_t i = len; i > 0; i--) {
+        p[i - 1] = (uint8_t)value;
+        value >>= 8;
+    }
+}
+
+static int ccm_check_params(const uint8_t *nonce, size_t nonce_len,
+                            const uint8_t *aad, size_t aad_len,
+                            size_t len, size_t tag_len) {
+    if (!nonce || nonce_len < AES_CCM_MIN_NONCE_LENGTH ||
+        nonce_len > AES_CCM_MAX_NONCE_LENGTH) {
+        return AES_CCM_ERR_INVALID;
+    }
+    if (tag_len < 4 || tag_len > AES_CCM_BLOCK_SIZE || (tag_len & 1)) {
+        return AES_CCM_ERR_INVALID;
+    }
+    if ((aad_len && !aad) || aad_len > AES_CCM_MAX_AAD_LENGTH) {
+        return AES_CCM_ERR_INVALID;
+    }
+    // Length must fit in the L = 15 - nonce_len byte length field
+    size_t l = 15 - nonce_len;
+    if (l < sizeof(size_t) && (len >> (8 * l)) != 0) {
+        return AES_CCM_ERR_INVALID;
+    }
+    return 0;
+}
+
+/**
+ * One pass of CCM over the payload
+ *
+ * Step i encrypts the CBC-MAC input for payload block i together with
+ * counter block A(i + 1) (A0 after the last block), so the keystream for
+ * the next block is ready when it is reached.  This ordering also works
+ * for decryption, where the MAC input is only known after decrypting.
+ */
+static void ccm_crypt(const aes_ccm_ctx_t *ctx, bool decrypt,
+                      const uint8_t *nonce, size_t nonce_len,
+                      const uint8_t *aad, size_t aad_len,
+                      const uint8_t *in, size_t len, uint8_t *out,
+                      uint8_t mac[AES_CCM_BLOCK_SIZE], size_t tag_len) {
+    uint8_t b[AES_CCM_BLOCK_SIZE];          // CBC-MAC input
+    uint8_t ctr[AES_CCM_BLOCK_SIZE];        // Counter block
+    uint8_t x[AES_CCM_BLOCK_SIZE];          // CBC-MAC state
+    uint8_t s[AES_CCM_BLOCK_SIZE];          // Keystream
+    size_t l = 15 - nonce_len;
+    size_t counter = (len > 0) ? 1 : 0;
+
+    // B0 and the first counter block
+    b[0] = (uint8_t)((aad_len ? 0x40 : 0) | (((tag_len - 2) / 2) << 3) | (l - 1));
+    memcpy(b + 1, nonce, nonce_len);
+    put_be(b + 1 + nonce_len, l, len);
+
+    ctr[0] = (uint8_t)(l - 1);
+    memcpy(ctr + 1, nonce, nonce_len);
+    put_be(ctr + 1 + nonce_len, l, counter);
+
+    aes_ccm_block_encrypt_x2(ctx, b, ctr, x, s);
+
+    // AAD, prefixed with its two-byte length and zero padded
+    if (aad_len > 0) {
+        size_t pos = 2;
+        size_t done = 0;
+
+        x[0] ^= (uint8_t)(aad_len >> 8);
+        x[1] ^= (uint8_t)aad_len;
+        while (done < aad_len) {
+            size_t n = AES_CCM_BLOCK_SIZE - pos;
+            if (n > aad_len - done) {
+                n = aad_len - done;
+            }
+            for (size_t i = 0; i < n; i++) {
+                x[pos + i] ^= aad[done + i];
+            }
+            done += n;
+            block_encrypt(ctx, x, x);
+            pos = 0;
+        }
+    }
+
+    // Payload: keystream XOR and CBC-MAC update in the same step
+    for (size_t off = 0; off < len; off += AES_CCM_BLOCK_SIZE) {
+        size_t n = len - off;
+        if (n > AES_CCM_BLOCK_SIZE) {
+            n = AES_CCM_BLOCK_SIZE;
+        }
+
+        memcpy(b, x, AES_CCM_BLOCK_SIZE);
+        for (size_t i = 0; i < n; i++) {
+            uint8_t c = in[off + i];
+            uint8_t p = decrypt ? (uint8_t)(c ^ s[i]) : c;
+            out[off + i] = (uint8_t)(c ^ s[i]);
+            b[i] ^= p;
+        }
+
+        counter = (off + AES_CCM_BLOCK_SIZE < len) ? counter + 1 : 0;
+        put_be(ctr + 1 + nonce_len, l, counter);
+        aes_ccm_block_encrypt_x2(ctx, b, ctr, x, s);
+    }
+
+    // s now holds S0 = E(A0)
+    for (size_t i = 0; i < AES_CCM_BLOCK_SIZE; i++) {
+        mac[i] = x[i] ^ s[i];
+    }
+
+    secure_zero(b, sizeof(b));
+    secure_zero(x, sizeof(x));
+    secure_zero(s, sizeof(s));
+}
+
+int aes_ccm_encrypt(const aes_ccm_ctx_t *ctx,
+                    const uint8_t *nonce, size_t nonce_len,
+                    const uint8_t *aad, size_t aad_len,
+                    const uint8_t *in, size_t len, uint8_t *out,
+                    uint8_t *tag, size_t tag_len) {
+    uint8_t mac[AES_CCM_BLOCK_SIZE];
+
+    if (!ctx || (len && (!in || !out)) || !tag ||
+        ccm_check_params(nonce, nonce_len, aad, aad_len, len, tag_len) != 0) {
+        return AES_CCM_ERR_INVALID;
+    }
+
+    ccm_crypt(ctx, false, nonce, nonce_len, aad, aad_len, in, len, out,
+              mac, tag_len);
+    memcpy(tag, mac, tag_len);
+    secure_zero(mac, sizeof(mac));
+    return 0;
+}
+
+int aes_ccm_decrypt(const aes_ccm_ctx_t *ctx,
+                    const uint8_t *nonce, size_t nonce_len,
+                    const uint8_t *aad, size_t aad_len,
+                    const uint8_t *in, size_t len, uint8_t *out,
+                    const uint8_t *tag, size_t tag_len) {
+    uint8_t mac[AES_CCM_BLOCK_SIZE];
+    uint8_t diff = 0;
+
+    if (!ctx || (len && (!in || !out)) || !tag ||
+        ccm_check_params(nonce, nonce_len, aad, aad_len, len, tag_len) != 0) {
+        return AES_CCM_ERR_INVALID;
+    }
+
+    ccm_crypt(ctx, true, nonce, nonce_len, aad, aad_len, in, len, out,
+              mac, tag_len);
+
+    // Constant-time tag comparison
+    for (size_t i = 0; i < tag_len; i++) {
+        diff |= (uint8_t)(mac[i] ^ tag[i]);
+    }
+    secure_zero(mac, sizeof(mac));
+
+    if (diff != 0) {
+        secure_zero(out, len);
+        return AES_CCM_ERR_AUTH;
+    }
+    return 0;
+}
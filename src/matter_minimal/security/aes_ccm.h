@@ -0,0 +1,145 @@
+/*
+ * aes_ccm.h
+ * AES-128 block cipher backend and fused AES-128-CCM (RFC 3610)
+ *
+ * All symmetric message crypto (session_mgr, CASE TBE payloads) goes
+ * through this module.  Two block cipher backends are available:
+ *
+ *   - Default: portable constant-time AES-128.  Two blocks are processed
+ *     at once in bitsliced form (8 x 32-bit words), the S-box is computed
+ *     as a Boolean circuit, and there are no lookup tables, so timing and
+ *     memory access do not depend on key or data.  It needs only 32-bit
+ *     shifts, masks and XOR/AND, which suits the Cortex-M0+ (no AES
+ *     hardware, flash T-tables stall on XIP cache misses).
+ *   - AES_CCM_USE_MBEDTLS: mbedTLS AES (table based), one block per call.
+ *
+ * CCM is fused: each step encrypts the CBC-MAC block and the next CTR
+ * block in the same two-block call, so MAC and encryption share one pass
+ * over the data and one cipher invocation per 16 bytes.
+ */
+
+#ifndef AES_CCM_H
+#define AES_CCM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef AES_CCM_USE_MBEDTLS
+#include "mbedtls/aes.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Constants
+ */
+#define AES_CCM_KEY_LENGTH          16      // AES-128 only
+#define AES_CCM_BLOCK_SIZE          16
+#define AES_CCM_ROUNDS              10
+#define AES_CCM_MIN_NONCE_LENGTH    7
+#define AES_CCM_MAX_NONCE_LENGTH    13
+#define AES_CCM_MAX_AAD_LENGTH      0xFEFF  // Two-byte AAD length encoding
+
+/**
+ * Error codes
+ */
+#define AES_CCM_ERR_INVALID         -1      // Bad key, nonce, tag or length
+#define AES_CCM_ERR_AUTH            -2      // Tag mismatch (output wiped)
+
+/**
+ * Keyed context (expanded key schedule)
+ */
+typedef struct {
+#ifdef AES_CCM_USE_MBEDTLS
+    mbedtls_aes_context aes;
+#else
+    uint32_t rk[AES_CCM_ROUNDS + 1][8];     // Bitsliced round keys
+#endif
+} aes_ccm_ctx_t;
+
+/**
+ * Expand an AES-128 key into a context
+ *
+ * @param ctx Context to key
+ * @param key Key bytes
+ * @param key_len Key length (must be 16)
+ * @return 0 on success, AES_CCM_ERR_INVALID on error
+ */
+int aes_ccm_setkey(aes_ccm_ctx_t *ctx, const uint8_t *key, size_t key_len);
+
+/**
+ * Wipe a context's key schedule
+ *
+ * @param ctx Context (NULL is ignored)
+ */
+void aes_ccm_free(aes_ccm_ctx_t *ctx);
+
+/**
+ * Encrypt two independent blocks (ECB) with the backend cipher
+ * in and out may overlap; out0 and out1 must not.
+ *
+ * @param ctx Keyed context
+ * @param in0 First input block
+ * @param in1 Second input block
+ * @param out0 First output block
+ * @param out1 Second output block
+ */
+void aes_ccm_block_encrypt_x2(const aes_ccm_ctx_t *ctx,
+                              const uint8_t in0[AES_CCM_BLOCK_SIZE],
+                              const uint8_t in1[AES_CCM_BLOCK_SIZE],
+                              uint8_t out0[AES_CCM_BLOCK_SIZE],
+                              uint8_t out1[AES_CCM_BLOCK_SIZE]);
+
+/**
+ * CCM encrypt and authenticate
+ * Works in place (out == in).
+ *
+ * @param ctx Keyed context
+ * @param nonce Nonce (7-13 bytes)
+ * @param nonce_len Nonce length
+ * @param aad Additional authenticated data (may be NULL if aad_len is 0)
+ * @param aad_len AAD length (at most AES_CCM_MAX_AAD_LENGTH)
+ * @param in Plaintext
+ * @param len Plaintext length
+ * @param out Ciphertext output (len bytes)
+ * @param tag Tag output
+ * @param tag_len Tag length (4-16, even)
+ * @return 0 on success, AES_CCM_ERR_INVALID on bad parameters
+ */
+int aes_ccm_encrypt(const aes_ccm_ctx_t *ctx,
+                    const uint8_t *nonce, size_t nonce_len,
+                    const uint8_t *aad, size_t aad_len,
+                    const uint8_t *in, size_t len, uint8_t *out,
+                    uint8_t *tag, size_t tag_len);
+
+/**
+ * CCM decrypt and verify
+ * Works in place (out == in).  The tag is compared in constant time and
+ * the output is wiped on mismatch.
+ *
+ * @param ctx Keyed context
+ * @param nonce Nonce (7-13 bytes)
+ * @param nonce_len Nonce length
+ * @param aad Additional authenticated data (may be NULL if aad_len is 0)
+ * @param aad_len AAD length (at most AES_CCM_MAX_AAD_LENGTH)
+ * @param in Ciphertext
+ * @param len Ciphertext length
+ * @param out Plaintext output (len bytes)
+ * @param tag Received tag
+ * @param tag_len Tag length (4-16, even)
+ * @return 0 on success, AES_CCM_ERR_AUTH on tag mismatch,
+ *         AES_CCM_ERR_INVALID on bad parameters
+ */
+int aes_ccm_decrypt(const aes_ccm_ctx_t *ctx,
+                    const uint8_t *nonce, size_t nonce_len,
+                    const uint8_t *aad, size_t aad_len,
+                    const uint8_t *in, size_t len, uint8_t *out,
+                    const uint8_t *tag, size_t tag_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // AES_CCM_H
@@ -15,6 +15,7 @@
  */
 
 #include "attestation.h"
+#include "crypto_stats.h"
 #include "../codec/tlv.h"
 #include <string.h>
 #include <stdio.h>
@@ -24,6 +25,8 @@
 
 /* mbedTLS */
 #include "mbedtls/pk.h"
+#include "mbedtls/ecp.h"
+#include "mbedtls/hkdf.h"
 #include "mbedtls/md.h"
 #include "mbedtls/sha256.h"
 #include "mbedtls/platform_util.h"
@@ -201,11 +204,13 @@ int attestation_sign_challenge(const uint8_t *challenge, size_t challenge_len,
     mbedtls_sha256_free(&sha_ctx);
 
     size_t out_len = *sig_len;
+    uint64_t t0 = crypto_stats_begin();
     int ret = mbedtls_pk_sign(&g_pk_ctx,
                                MBEDTLS_MD_SHA256,
                                hash, sizeof(hash),
                                sig, out_len, &out_len,
                                pico_rng_callback, NULL);
+    crypto_stats_end(CRYPTO_OP_ECDSA_SIGN, t0, challenge_len);
     mbedtls_platform_zeroize(hash, sizeof(hash));
 
     if (ret != 0) {
@@ -256,6 +261,28 @@ int attestation_generate_attestation_tlv(const uint8_t *nonce, size_t nonce_len,
     return 0;
 }
 
+int attestation_derive_key(const uint8_t *info, size_t info_len,
+                           uint8_t *out, size_t out_len) {
+    if (!info || !out || out_len == 0) return -1;
+    if (!g_att_initialized || !g_pk_loaded ||
+        mbedtls_pk_get_type(&g_pk_ctx) != MBEDTLS_PK_ECKEY) {
+        return -1;
+    }
+
+    const mbedtls_md_info_t *md = mbedtls_md_info_from_type(MBEDTLS_MD_SHA256);
+    uint8_t scalar[32];
+    int ret = mbedtls_mpi_write_binary(&mbedtls_pk_ec(g_pk_ctx)->MBEDTLS_PRIVATE(d),
+                                       scalar, sizeof(scalar));
+    if (ret == 0 && md) {
+        ret = mbedtls_hkdf(md, NULL, 0, scalar, sizeof(scalar),
+                           info, info_len, out, out_len);
+    } else if (ret == 0) {
+        ret = -1;
+    }
+    mbedtls_platform_zeroize(scalar, sizeof(scalar));
+    return ret == 0 ? 0 : -1;
+}
+
 int attestation_is_ready(void) {
     return (g_att_initialized &&
             g_dac_der_len > 0 &&
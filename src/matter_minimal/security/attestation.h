@@ -85,6 +85,20 @@ int attestation_generate_attestation_tlv(const uint8_t *nonce, size_t nonce_len,
                                          uint8_t *out, size_t out_size,
                                          size_t *out_len);
 
+/*
+ * Derive a device-bound key from the attestation private key
+ * (HKDF-SHA256 with the private scalar as input keying material).  The
+ * private key itself never leaves this module.
+ *
+ * @param info      Context string; each use of a derived key has its own.
+ * @param info_len  Length of info.
+ * @param out       Output key.
+ * @param out_len   Length of the key to derive.
+ * @return 0 on success, -1 if the private key is not loaded.
+ */
+int attestation_derive_key(const uint8_t *info, size_t info_len,
+                           uint8_t *out, size_t out_len);
+
 /*
  * Check whether attestation credentials are loaded and ready.
  *
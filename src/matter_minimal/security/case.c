@@ -4,24 +4,33 @@
  *
  * Implements Matter CASE §4.13:
  *   Sigma1 → derive shared secret → build Sigma2
- *   Sigma3 → verify credentials → create CASE session
+ *   Sigma3 → verify initiator NOC chain and signature → create CASE session
+ *   Sigma1 with resumption ID → verify MIC → Sigma2_Resume + session
+ *     (HKDF only, using the shared secret kept by case_resumption)
  *
  * Cryptographic primitives (all in the project's mbedTLS config):
- *   mbedtls_ecp_gen_keypair – ephemeral P-256 keypair generation
+ *   ephemeral_pool          – precomputed ephemeral P-256 keypairs
  *   mbedtls_ecp_mul         – ECDH shared-secret computation
  *   mbedtls_hkdf            – HKDF-SHA256 key derivation
  *   mbedtls_pk_sign         – ECDSA-P256 attestation signing
- *   mbedtls_ccm             – AES-128-CCM TBE encryption/decryption
+ *   mbedtls_ecdsa_verify    – Sigma3 and initiator certificate signatures
+ *   aes_ccm                 – AES-128-CCM TBE encryption/decryption
  *   mbedtls_sha256          – transcript hashing
  *
  * WARNING – TEST-MODE ONLY.  See PRODUCTION_README.md.
  */
 
 #include "case.h"
+#include "case_resumption.h"
 #include "attestation.h"
 #include "certificate_store.h"
+#include "matter_cert.h"
 #include "session_mgr.h"
+#include "aes_ccm.h"
+#include "ephemeral_pool.h"
+#include "crypto_stats.h"
 #include "../codec/tlv.h"
+#include "../codec/msg_pool.h"
 #include <string.h>
 #include <stdio.h>
 #include <stdbool.h>
@@ -31,10 +40,10 @@
 /* mbedTLS */
 #include "mbedtls/hkdf.h"
 #include "mbedtls/sha256.h"
-#include "mbedtls/ccm.h"
 #include "mbedtls/pk.h"
 #include "mbedtls/md.h"
 #include "mbedtls/ecp.h"
+#include "mbedtls/ecdsa.h"
 #include "mbedtls/bignum.h"
 #include "mbedtls/platform_util.h"
 /* mbedtls/error.h not included (MBEDTLS_ERROR_C not enabled) */
@@ -64,6 +73,28 @@ static const uint8_t HKDF_INFO_TBE3[] = {
     'S','i','g','m','a','3','T','B','E','K','e','y'
 }; /* "Sigma3TBEKey" */
 
+/* Session resumption labels (Matter spec §4.13.2.2) */
+static const uint8_t HKDF_INFO_S1RK[] = {
+    'S','i','g','m','a','1','_','R','e','s','u','m','e'
+}; /* "Sigma1_Resume" */
+
+static const uint8_t HKDF_INFO_S2RK[] = {
+    'S','i','g','m','a','2','_','R','e','s','u','m','e'
+}; /* "Sigma2_Resume" */
+
+static const uint8_t HKDF_INFO_RESUME_KEYS[] = {
+    'S','e','s','s','i','o','n','R','e','s','u','m','p','t','i','o','n',
+    'K','e','y','s'
+}; /* "SessionResumptionKeys" */
+
+static const uint8_t NONCE_SIGMA1_RESUME[] = {
+    'N','C','A','S','E','_','S','i','g','m','a','S','1'
+}; /* "NCASE_SigmaS1" */
+
+static const uint8_t NONCE_SIGMA2_RESUME[] = {
+    'N','C','A','S','E','_','S','i','g','m','a','S','2'
+}; /* "NCASE_SigmaS2" */
+
 #define CCM_NONCE_SIZE   13
 #define CCM_TAG_SIZE     16
 
@@ -97,6 +128,8 @@ typedef struct {
     uint8_t  t1_hash[SHA256_SIZE]; /* Hash(Sigma1) */
     uint8_t  t2_hash[SHA256_SIZE]; /* Hash(Sigma1 || Sigma2) */
 
+    uint8_t  resumption_id[CASE_RESUMPTION_ID_LEN]; /* Issued in TBE2 */
+
     uint16_t established_session_id;
     bool     session_established;
 } case_ctx_t;
@@ -123,7 +156,10 @@ static int pico_rng_cb(void *ctx, unsigned char *buf, size_t len) {
 
 static uint16_t random_session_id(void) {
     uint16_t id;
-    do { pico_rng_cb(NULL, (uint8_t *)&id, sizeof(id)); } while (id == 0);
+    /* Must not re-key a live session */
+    do {
+        pico_rng_cb(NULL, (uint8_t *)&id, sizeof(id));
+    } while (id == 0 || session_is_active(id));
     return id;
 }
 
@@ -137,8 +173,11 @@ static int hkdf_derive(const uint8_t *salt, size_t salt_len,
                        uint8_t *out, size_t out_len) {
     const mbedtls_md_info_t *md = mbedtls_md_info_from_type(MBEDTLS_MD_SHA256);
     if (!md) return -1;
-    return mbedtls_hkdf(md, salt, salt_len, ikm, ikm_len,
-                        info, info_len, out, out_len);
+    uint64_t t0 = crypto_stats_begin();
+    int ret = mbedtls_hkdf(md, salt, salt_len, ikm, ikm_len,
+                           info, info_len, out, out_len);
+    crypto_stats_end(CRYPTO_OP_HKDF, t0, out_len);
+    return ret;
 }
 
 /* TLV: find first element with given context tag, return byte string */
@@ -163,6 +202,26 @@ static int tlv_find_bytes(const uint8_t *buf, size_t len, uint8_t tag,
     return -1;
 }
 
+/* TLV: find byte string with given context tag, without copying */
+static int tlv_find_bytes_ref(const uint8_t *buf, size_t len, uint8_t tag,
+                              const uint8_t **out, size_t *out_len) {
+    tlv_reader_t r;
+    tlv_element_t el;
+    tlv_reader_init(&r, buf, len);
+    if (tlv_reader_peek(&r, &el) == 0 && el.type == TLV_TYPE_STRUCTURE)
+        tlv_reader_next(&r, &el);
+    while (tlv_reader_next(&r, &el) == 0) {
+        if (el.type == TLV_TYPE_END_OF_CONTAINER) break;
+        if (el.tag_type == TLV_TAG_CONTEXT_SPECIFIC && el.tag == tag
+                && el.type == TLV_TYPE_BYTE_STRING) {
+            *out = el.value.bytes.data;
+            *out_len = el.value.bytes.length;
+            return 0;
+        }
+    }
+    return -1;
+}
+
 /* TLV: find uint16 element with given context tag */
 static int tlv_find_uint16(const uint8_t *buf, size_t len, uint8_t tag,
                            uint16_t *out) {
@@ -182,6 +241,7 @@ static int tlv_find_uint16(const uint8_t *buf, size_t len, uint8_t tag,
     return -1;
 }
 
+
 /* ------------------------------------------------------------------ */
 /* AES-128-CCM helpers                                                  */
 /* ------------------------------------------------------------------ */
@@ -193,18 +253,17 @@ static int ccm_encrypt(const uint8_t *key,
     uint8_t nonce[CCM_NONCE_SIZE];
     memset(nonce, 0, sizeof(nonce));
 
-    mbedtls_ccm_context ccm;
-    mbedtls_ccm_init(&ccm);
-    int ret = mbedtls_ccm_setkey(&ccm, MBEDTLS_CIPHER_ID_AES,
-                                  key, CASE_SESSION_KEY_LEN * 8);
+    uint64_t t0 = crypto_stats_begin();
+    aes_ccm_ctx_t ccm;
+    int ret = aes_ccm_setkey(&ccm, key, CASE_SESSION_KEY_LEN);
     if (ret == 0) {
-        ret = mbedtls_ccm_encrypt_and_tag(&ccm, plain_len,
-                                           nonce, CCM_NONCE_SIZE,
-                                           NULL, 0,
-                                           plain, enc_out,
-                                           enc_out + plain_len, CCM_TAG_SIZE);
+        ret = aes_ccm_encrypt(&ccm, nonce, CCM_NONCE_SIZE,
+                              NULL, 0,
+                              plain, plain_len, enc_out,
+                              enc_out + plain_len, CCM_TAG_SIZE);
     }
-    mbedtls_ccm_free(&ccm);
+    aes_ccm_free(&ccm);
+    crypto_stats_end(CRYPTO_OP_CCM_ENCRYPT, t0, plain_len);
     return ret;
 }
 
@@ -217,22 +276,167 @@ static int ccm_decrypt(const uint8_t *key,
     uint8_t nonce[CCM_NONCE_SIZE];
     memset(nonce, 0, sizeof(nonce));
 
-    mbedtls_ccm_context ccm;
-    mbedtls_ccm_init(&ccm);
-    int ret = mbedtls_ccm_setkey(&ccm, MBEDTLS_CIPHER_ID_AES,
-                                  key, CASE_SESSION_KEY_LEN * 8);
+    uint64_t t0 = crypto_stats_begin();
+    aes_ccm_ctx_t ccm;
+    int ret = aes_ccm_setkey(&ccm, key, CASE_SESSION_KEY_LEN);
     if (ret == 0) {
-        ret = mbedtls_ccm_auth_decrypt(&ccm, plen,
-                                        nonce, CCM_NONCE_SIZE,
-                                        NULL, 0,
-                                        enc, plain_out,
-                                        enc + plen, CCM_TAG_SIZE);
+        ret = aes_ccm_decrypt(&ccm, nonce, CCM_NONCE_SIZE,
+                              NULL, 0,
+                              enc, plen, plain_out,
+                              enc + plen, CCM_TAG_SIZE);
     }
-    mbedtls_ccm_free(&ccm);
+    aes_ccm_free(&ccm);
+    crypto_stats_end(CRYPTO_OP_CCM_DECRYPT, t0, plen);
     if (ret == 0 && plain_len_out) *plain_len_out = plen;
     return ret;
 }
 
+/* ------------------------------------------------------------------ */
+/* Initiator verification                                               */
+/* ------------------------------------------------------------------ */
+
+/* ECDSA-P256-SHA256 over msg; sig is r || s */
+static int verify_p256_signature(const uint8_t *pubkey,
+                                 const uint8_t *msg, size_t msg_len,
+                                 const uint8_t *sig) {
+    uint8_t hash[SHA256_SIZE];
+    mbedtls_sha256(msg, msg_len, hash, 0);
+
+    mbedtls_ecp_group grp;
+    mbedtls_ecp_point q;
+    mbedtls_mpi r, s;
+    mbedtls_ecp_group_init(&grp);
+    mbedtls_ecp_point_init(&q);
+    mbedtls_mpi_init(&r);
+    mbedtls_mpi_init(&s);
+
+    uint64_t t0 = crypto_stats_begin();
+    int ret = mbedtls_ecp_group_load(&grp, MBEDTLS_ECP_DP_SECP256R1);
+    if (ret == 0) {
+        ret = mbedtls_ecp_point_read_binary(&grp, &q, pubkey, P256_PUBKEY_SIZE);
+    }
+    if (ret == 0) ret = mbedtls_mpi_read_binary(&r, sig, P256_PRIVKEY_SIZE);
+    if (ret == 0) {
+        ret = mbedtls_mpi_read_binary(&s, sig + P256_PRIVKEY_SIZE,
+                                      P256_PRIVKEY_SIZE);
+    }
+    if (ret == 0) ret = mbedtls_ecdsa_verify(&grp, hash, sizeof(hash), &q, &r, &s);
+    crypto_stats_end(CRYPTO_OP_ECDSA_VERIFY, t0, msg_len);
+
+    mbedtls_mpi_free(&s);
+    mbedtls_mpi_free(&r);
+    mbedtls_ecp_point_free(&q);
+    mbedtls_ecp_group_free(&grp);
+    return ret;
+}
+
+/* Check that issuer_pubkey signed cert (over its rebuilt DER TBS) */
+static int verify_cert_signature(const uint8_t *cert, size_t cert_len,
+                                 const matter_cert_t *parsed,
+                                 const uint8_t *issuer_pubkey,
+                                 packet_buffer_t *scratch) {
+    size_t tbs_len = 0;
+    if (matter_cert_encode_tbs(cert, cert_len, scratch->data,
+                               sizeof(scratch->data), &tbs_len) != 0) {
+        return -1;
+    }
+    return verify_p256_signature(issuer_pubkey, scratch->data, tbs_len,
+                                 parsed->signature);
+}
+
+/*
+ * Authenticate the initiator from the decrypted TBE3 (Matter §4.13.2.4):
+ *   Tag 1: InitiatorNOC, Tag 2: InitiatorICAC (optional), Tag 3: Signature
+ * The signature must be the NOC key's over
+ *   TBS3 = { 1: NOC, 2: ICAC, 3: Ieph_pub, 4: Reph_pub }
+ * and the NOC must chain (through the ICAC, if any) to our stored RCAC on
+ * our fabric.
+ */
+static int verify_initiator(const uint8_t *tbe3, size_t tbe3_len,
+                            uint64_t *peer_node_id) {
+    const uint8_t *noc = NULL, *icac = NULL, *sig = NULL;
+    size_t noc_len = 0, icac_len = 0, sig_len = 0;
+    if (tlv_find_bytes_ref(tbe3, tbe3_len, 1, &noc, &noc_len) != 0
+            || tlv_find_bytes_ref(tbe3, tbe3_len, 3, &sig, &sig_len) != 0
+            || sig_len != MATTER_CERT_SIGNATURE_LEN) {
+        printf("[CASE] Sigma3: TBE3 lacks NOC or signature\n");
+        return -1;
+    }
+    if (tlv_find_bytes_ref(tbe3, tbe3_len, 2, &icac, &icac_len) != 0) {
+        icac = NULL;
+    }
+
+    const uint8_t *rcac = NULL, *own_noc = NULL;
+    size_t rcac_len = 0, own_noc_len = 0;
+    matter_cert_t peer, root, own, ica;
+    if (certificate_store_get_rcac(&rcac, &rcac_len) != 0
+            || certificate_store_get_noc(&own_noc, &own_noc_len) != 0
+            || matter_cert_parse(rcac, rcac_len, &root) != 0
+            || matter_cert_parse(own_noc, own_noc_len, &own) != 0) {
+        printf("[CASE] Sigma3: no trusted root or own NOC\n");
+        return -1;
+    }
+    if (matter_cert_parse(noc, noc_len, &peer) != 0 || peer.is_ca
+            || !peer.has_node_id || !peer.has_fabric_id
+            || !own.has_fabric_id || peer.fabric_id != own.fabric_id
+            || (root.has_fabric_id && root.fabric_id != peer.fabric_id)) {
+        printf("[CASE] Sigma3: initiator NOC invalid or on another fabric\n");
+        return -1;
+    }
+
+    packet_buffer_t *scratch = msg_pool_alloc();
+    if (!scratch) {
+        printf("[CASE] Sigma3: message pool exhausted\n");
+        return -1;
+    }
+    int ret = -1;
+
+    /* Sigma3 signature */
+    tlv_writer_t w;
+    tlv_writer_init(&w, scratch->data, sizeof(scratch->data));
+    if (tlv_encode_structure_start(&w, 0) != 0
+            || tlv_encode_bytes(&w, 1, noc, noc_len) != 0
+            || (icac && tlv_encode_bytes(&w, 2, icac, icac_len) != 0)
+            || tlv_encode_bytes(&w, 3, g_case_ctx.ieph_pub, P256_PUBKEY_SIZE) != 0
+            || tlv_encode_bytes(&w, 4, g_case_ctx.reph_pub, P256_PUBKEY_SIZE) != 0
+            || tlv_encode_container_end(&w) != 0) {
+        printf("[CASE] Sigma3: TBS3 too large\n");
+        goto done;
+    }
+    if (verify_p256_signature(peer.public_key, scratch->data,
+                              tlv_writer_get_length(&w), sig) != 0) {
+        printf("[CASE] Sigma3: signature check failed\n");
+        goto done;
+    }
+
+    /* Certificate chain up to the trusted root */
+    const matter_cert_t *signer = &root;
+    if (icac) {
+        if (matter_cert_parse(icac, icac_len, &ica) != 0 || !ica.is_ca
+                || (ica.has_fabric_id && ica.fabric_id != peer.fabric_id)
+                || !matter_cert_issued_by(&ica, &root)
+                || verify_cert_signature(icac, icac_len, &ica,
+                                         root.public_key, scratch) != 0) {
+            printf("[CASE] Sigma3: ICAC not issued by our root\n");
+            goto done;
+        }
+        signer = &ica;
+    }
+    if (!matter_cert_issued_by(&peer, signer)
+            || verify_cert_signature(noc, noc_len, &peer,
+                                     signer->public_key, scratch) != 0) {
+        printf("[CASE] Sigma3: NOC not issued by our root\n");
+        goto done;
+    }
+
+    *peer_node_id = peer.node_id;
+    ret = 0;
+
+done:
+    msg_pool_release(scratch);
+    return ret;
+}
+
 /* ------------------------------------------------------------------ */
 /* Public API                                                           */
 /* ------------------------------------------------------------------ */
@@ -242,6 +446,8 @@ int case_init(void) {
     printf("[CASE] Initializing CASE subsystem\n");
     memset(&g_case_ctx, 0, sizeof(g_case_ctx));
     g_case_ctx.state = CASE_STATE_IDLE;
+    case_resumption_init();
+    certificate_store_init();
     g_case_initialized = true;
     return 0;
 }
@@ -286,8 +492,14 @@ int case_handle_sigma1(const uint8_t *in, size_t in_len,
     mbedtls_sha256((const unsigned char *)in, in_len, g_case_ctx.t1_hash, 0);
 
     /* ----------------------------------------------------------
-     * Generate responder ephemeral P-256 keypair
+     * Responder ephemeral P-256 keypair, precomputed in idle time
+     * (ephemeral_pool; generated here only if the pool is empty)
      * ---------------------------------------------------------- */
+    if (ephemeral_pool_take(g_case_ctx.reph_priv, g_case_ctx.reph_pub) != 0) {
+        printf("[CASE] Sigma1: ephemeral key generation failed\n");
+        return -1;
+    }
+
     mbedtls_ecp_group grp;
     mbedtls_ecp_group_init(&grp);
     int ret = mbedtls_ecp_group_load(&grp, MBEDTLS_ECP_DP_SECP256R1);
@@ -295,39 +507,13 @@ int case_handle_sigma1(const uint8_t *in, size_t in_len,
 
     {
         mbedtls_mpi    d;       /* private scalar */
-        mbedtls_ecp_point Q;   /* public point */
         mbedtls_mpi_init(&d);
-        mbedtls_ecp_point_init(&Q);
 
-        ret = mbedtls_ecp_gen_keypair(&grp, &d, &Q, pico_rng_cb, NULL);
+        ret = mbedtls_mpi_read_binary(&d, g_case_ctx.reph_priv,
+                                      P256_PRIVKEY_SIZE);
         if (ret != 0) {
-            log_mbedtls_err("ecp_gen_keypair", ret);
+            log_mbedtls_err("mpi_read_binary(Reph_priv)", ret);
             mbedtls_mpi_free(&d);
-            mbedtls_ecp_point_free(&Q);
-            goto err_grp;
-        }
-
-        /* Export Reph public key (uncompressed) */
-        size_t pub_len = P256_PUBKEY_SIZE;
-        ret = mbedtls_ecp_point_write_binary(&grp, &Q,
-                                              MBEDTLS_ECP_PF_UNCOMPRESSED,
-                                              &pub_len,
-                                              g_case_ctx.reph_pub,
-                                              P256_PUBKEY_SIZE);
-        if (ret != 0 || pub_len != P256_PUBKEY_SIZE) {
-            log_mbedtls_err("ecp_point_write_binary(Reph)", ret);
-            mbedtls_mpi_free(&d);
-            mbedtls_ecp_point_free(&Q);
-            goto err_grp;
-        }
-
-        /* Export Reph private key (raw scalar, 32 bytes) */
-        ret = mbedtls_mpi_write_binary(&d,
-                                        g_case_ctx.reph_priv, P256_PRIVKEY_SIZE);
-        if (ret != 0) {
-            log_mbedtls_err("mpi_write_binary(Reph_priv)", ret);
-            mbedtls_mpi_free(&d);
-            mbedtls_ecp_point_free(&Q);
             goto err_grp;
         }
 
@@ -340,14 +526,15 @@ int case_handle_sigma1(const uint8_t *in, size_t in_len,
         if (ret != 0) {
             log_mbedtls_err("ecp_point_read_binary(Ieph)", ret);
             mbedtls_mpi_free(&d);
-            mbedtls_ecp_point_free(&Q);
             mbedtls_ecp_point_free(&I_pub);
             goto err_grp;
         }
 
         mbedtls_ecp_point Z;
         mbedtls_ecp_point_init(&Z);
+        uint64_t t0 = crypto_stats_begin();
         ret = mbedtls_ecp_mul(&grp, &Z, &d, &I_pub, pico_rng_cb, NULL);
+        crypto_stats_end(CRYPTO_OP_ECDH, t0, 0);
         if (ret == 0) {
             ret = mbedtls_mpi_write_binary(
                       &Z.MBEDTLS_PRIVATE(X),
@@ -357,7 +544,6 @@ int case_handle_sigma1(const uint8_t *in, size_t in_len,
         mbedtls_ecp_point_free(&Z);
         mbedtls_ecp_point_free(&I_pub);
         mbedtls_mpi_free(&d);
-        mbedtls_ecp_point_free(&Q);
 
         if (ret != 0) { log_mbedtls_err("ecdh_shared_secret", ret); goto err_grp; }
     }
@@ -385,22 +571,33 @@ int case_handle_sigma1(const uint8_t *in, size_t in_len,
         mbedtls_platform_zeroize(keys, sizeof(keys));
     }
 
-    /* Generate responder random and session ID */
+    /* Generate responder random, session ID and resumption ID */
     pico_rng_cb(NULL, g_case_ctx.responder_random, 32);
     g_case_ctx.responder_session_id = random_session_id();
+    pico_rng_cb(NULL, g_case_ctx.resumption_id, CASE_RESUMPTION_ID_LEN);
 
     /* ----------------------------------------------------------
      * Build Sigma2-TBE plaintext
-     *   { Tag1: ResponderNOC, Tag3: Signature(TBS2) }
+     *   { Tag1: ResponderNOC, Tag3: Signature(TBS2),
+     *     Tag4: ResumptionID }
      *   TBS2 = T1 || Reph_pub || Ieph_pub
      *   Signature = ECDSA-P256-SHA256(DAC_key, TBS2)
+     *
+     * TBE2 is built in a message pool block and encrypted in place,
+     * so the block holds ciphertext||tag afterwards.
      * ---------------------------------------------------------- */
-    static uint8_t tbe2_plain[768];
+    packet_buffer_t *tbe2 = msg_pool_alloc();
+    if (!tbe2) {
+        printf("[CASE] Sigma1: message pool exhausted\n");
+        return -1;
+    }
+    uint8_t       *tbe2_buf = tbe2->data;
     size_t         tbe2_plain_len = 0;
     {
-        uint8_t noc[CERT_STORE_MAX_CERT_SIZE];
-        size_t  noc_len = 0;
-        certificate_store_load_noc(noc, sizeof(noc), &noc_len);
+        /* Cached NOC: no flash read or copy per handshake */
+        const uint8_t *noc = NULL;
+        size_t         noc_len = 0;
+        certificate_store_get_noc(&noc, &noc_len);
 
         /* Compute TBS2 = T1 || Reph_pub || Ieph_pub */
         uint8_t tbs2[SHA256_SIZE + P256_PUBKEY_SIZE * 2];
@@ -413,10 +610,11 @@ int case_handle_sigma1(const uint8_t *in, size_t in_len,
         int sign_ok = attestation_sign_challenge(tbs2, sizeof(tbs2), sig, &sig_len);
 
         tlv_writer_t w;
-        tlv_writer_init(&w, tbe2_plain, sizeof(tbe2_plain));
+        tlv_writer_init(&w, tbe2_buf, sizeof(tbe2->data) - CCM_TAG_SIZE);
         tlv_encode_structure_start(&w, 0);
         if (noc_len > 0)  tlv_encode_bytes(&w, 1, noc, noc_len);
         if (sign_ok == 0) tlv_encode_bytes(&w, 3, sig, sig_len);
+        tlv_encode_bytes(&w, 4, g_case_ctx.resumption_id, CASE_RESUMPTION_ID_LEN);
         tlv_encode_container_end(&w);
         tbe2_plain_len = tlv_writer_get_length(&w);
         mbedtls_platform_zeroize(sig, sizeof(sig));
@@ -425,7 +623,6 @@ int case_handle_sigma1(const uint8_t *in, size_t in_len,
     /* ----------------------------------------------------------
      * Derive TBE2 key via HKDF, then AES-128-CCM encrypt
      * ---------------------------------------------------------- */
-    static uint8_t tbe2_enc[768 + CCM_TAG_SIZE];
     size_t         tbe2_enc_len = tbe2_plain_len + CCM_TAG_SIZE;
     {
         uint8_t tbe2_key[CASE_SESSION_KEY_LEN];
@@ -436,12 +633,18 @@ int case_handle_sigma1(const uint8_t *in, size_t in_len,
         if (ret != 0) {
             log_mbedtls_err("hkdf TBE2", ret);
             mbedtls_platform_zeroize(tbe2_key, sizeof(tbe2_key));
+            mbedtls_platform_zeroize(tbe2_buf, tbe2_plain_len);
+            msg_pool_release(tbe2);
             return -1;
         }
-        ret = ccm_encrypt(tbe2_key, tbe2_plain, tbe2_plain_len, tbe2_enc);
+        ret = ccm_encrypt(tbe2_key, tbe2_buf, tbe2_plain_len, tbe2_buf);
         mbedtls_platform_zeroize(tbe2_key, sizeof(tbe2_key));
-        mbedtls_platform_zeroize(tbe2_plain, tbe2_plain_len);
-        if (ret != 0) { log_mbedtls_err("ccm_encrypt TBE2", ret); return -1; }
+        if (ret != 0) {
+            log_mbedtls_err("ccm_encrypt TBE2", ret);
+            mbedtls_platform_zeroize(tbe2_buf, tbe2_plain_len);
+            msg_pool_release(tbe2);
+            return -1;
+        }
     }
 
     /* ----------------------------------------------------------
@@ -458,10 +661,11 @@ int case_handle_sigma1(const uint8_t *in, size_t in_len,
         tlv_encode_bytes(&w, 1, g_case_ctx.responder_random, 32);
         tlv_encode_uint16(&w, 2, g_case_ctx.responder_session_id);
         tlv_encode_bytes(&w, 3, g_case_ctx.reph_pub, P256_PUBKEY_SIZE);
-        tlv_encode_bytes(&w, 4, tbe2_enc, tbe2_enc_len);
+        tlv_encode_bytes(&w, 4, tbe2_buf, tbe2_enc_len);
         tlv_encode_container_end(&w);
         *out_len = tlv_writer_get_length(&w);
     }
+    msg_pool_release(tbe2);
 
     /* Transcript T2 = SHA-256(Sigma1 || Sigma2) */
     {
@@ -483,6 +687,166 @@ err_grp:
     return -1;
 }
 
+/* Resumption key: HKDF(salt = InitiatorRandom || ResumptionID, IKM = Z) */
+static int resume_derive(const uint8_t *initiator_random,
+                         const uint8_t *resumption_id,
+                         const uint8_t *shared_secret,
+                         const uint8_t *info, size_t info_len,
+                         uint8_t *out, size_t out_len) {
+    uint8_t salt[32 + CASE_RESUMPTION_ID_LEN];
+    memcpy(salt, initiator_random, 32);
+    memcpy(salt + 32, resumption_id, CASE_RESUMPTION_ID_LEN);
+    return hkdf_derive(salt, sizeof(salt),
+                       shared_secret, CASE_RESUMPTION_SECRET_LEN,
+                       info, info_len, out, out_len);
+}
+
+int case_handle_sigma1_resume(const uint8_t *in, size_t in_len,
+                              uint8_t *out, size_t out_size, size_t *out_len) {
+    if (!g_case_initialized || !in || !out || !out_len) return -1;
+
+    /* ----------------------------------------------------------
+     * Sigma1 resumption fields (Matter §4.13.2.1)
+     *   Tag 6: ResumptionID        ByteString(16)
+     *   Tag 7: InitiatorResumeMIC  ByteString(16)
+     * ---------------------------------------------------------- */
+    uint8_t  initiator_random[32];
+    uint16_t initiator_session_id = 0;
+    uint8_t  resumption_id[CASE_RESUMPTION_ID_LEN];
+    uint8_t  resume_mic[CCM_TAG_SIZE];
+    size_t   tmp_len = 0;
+
+    if (tlv_find_bytes(in, in_len, 6, resumption_id,
+                       sizeof(resumption_id), &tmp_len) != 0
+            || tmp_len != CASE_RESUMPTION_ID_LEN
+            || tlv_find_bytes(in, in_len, 7, resume_mic,
+                              sizeof(resume_mic), &tmp_len) != 0
+            || tmp_len != CCM_TAG_SIZE) {
+        return CASE_RESUME_NOT_APPLICABLE;
+    }
+    if (tlv_find_bytes(in, in_len, 1, initiator_random,
+                       sizeof(initiator_random), &tmp_len) != 0
+            || tmp_len != sizeof(initiator_random)
+            || tlv_find_uint16(in, in_len, 2, &initiator_session_id) != 0) {
+        printf("[CASE] Sigma1 resume: missing InitiatorRandom/SessionId\n");
+        return -1;
+    }
+
+    case_resumption_ticket_t ticket;
+    if (case_resumption_find(resumption_id, &ticket) != 0) {
+        printf("[CASE] Sigma1 resume: unknown resumption ID, full CASE\n");
+        return CASE_RESUME_NOT_APPLICABLE;
+    }
+
+    /* Verify InitiatorResumeMIC: CCM tag over empty plaintext under S1RK */
+    uint8_t key[CASE_SESSION_KEY_LEN];
+    aes_ccm_ctx_t ccm;
+    int ret = resume_derive(initiator_random, resumption_id,
+                            ticket.shared_secret,
+                            HKDF_INFO_S1RK, sizeof(HKDF_INFO_S1RK),
+                            key, sizeof(key));
+    if (ret == 0) ret = aes_ccm_setkey(&ccm, key, sizeof(key));
+    if (ret == 0) {
+        ret = aes_ccm_decrypt(&ccm, NONCE_SIGMA1_RESUME, CCM_NONCE_SIZE,
+                              NULL, 0, NULL, 0, NULL,
+                              resume_mic, CCM_TAG_SIZE);
+        aes_ccm_free(&ccm);
+    }
+    if (ret != 0) {
+        /* Leave the ticket alone: a forged attempt must not revoke it */
+        printf("[CASE] Sigma1 resume: MIC check failed, full CASE\n");
+        mbedtls_platform_zeroize(key, sizeof(key));
+        mbedtls_platform_zeroize(&ticket, sizeof(ticket));
+        return CASE_RESUME_NOT_APPLICABLE;
+    }
+
+    mbedtls_platform_zeroize(&g_case_ctx, sizeof(g_case_ctx));
+    g_case_ctx.state = CASE_STATE_IDLE;
+    pico_rng_cb(NULL, ticket.resumption_id, CASE_RESUMPTION_ID_LEN);
+    g_case_ctx.initiator_session_id = initiator_session_id;
+    g_case_ctx.responder_session_id = random_session_id();
+
+    /* Sigma2ResumeMIC under S2RK (bound to the new resumption ID) */
+    uint8_t sigma2_mic[CCM_TAG_SIZE];
+    ret = resume_derive(initiator_random, ticket.resumption_id,
+                        ticket.shared_secret,
+                        HKDF_INFO_S2RK, sizeof(HKDF_INFO_S2RK),
+                        key, sizeof(key));
+    if (ret == 0) ret = aes_ccm_setkey(&ccm, key, sizeof(key));
+    if (ret == 0) {
+        ret = aes_ccm_encrypt(&ccm, NONCE_SIGMA2_RESUME, CCM_NONCE_SIZE,
+                              NULL, 0, NULL, 0, NULL,
+                              sigma2_mic, CCM_TAG_SIZE);
+        aes_ccm_free(&ccm);
+    }
+    mbedtls_platform_zeroize(key, sizeof(key));
+
+    /* Session keys: I2R(16) || R2I(16) || AttestationChallenge(16) */
+    uint8_t keys[48];
+    if (ret == 0) {
+        ret = resume_derive(initiator_random, ticket.resumption_id,
+                            ticket.shared_secret,
+                            HKDF_INFO_RESUME_KEYS, sizeof(HKDF_INFO_RESUME_KEYS),
+                            keys, sizeof(keys));
+    }
+    if (ret != 0) {
+        log_mbedtls_err("resume key derivation", ret);
+        mbedtls_platform_zeroize(keys, sizeof(keys));
+        mbedtls_platform_zeroize(&ticket, sizeof(ticket));
+        return -1;
+    }
+
+    session_params_t params = {
+        .local_session_id = g_case_ctx.responder_session_id,
+        .peer_session_id  = initiator_session_id,
+        .tx_key           = keys + CASE_SESSION_KEY_LEN,   /* R2I */
+        .rx_key           = keys,                          /* I2R */
+        .local_node_id    = ticket.local_node_id,
+        .peer_node_id     = ticket.peer_node_id,
+        .auth_mode        = SESSION_AUTH_CASE,
+    };
+    ret = session_create_secure(&params);
+    mbedtls_platform_zeroize(keys, sizeof(keys));
+    if (ret != 0) {
+        /* The old ticket stays usable for another attempt */
+        printf("[CASE] Sigma1 resume: session_create failed\n");
+        mbedtls_platform_zeroize(&ticket, sizeof(ticket));
+        return -1;
+    }
+
+    /* Resumption IDs are single use; the new one replaces the old ticket
+     * now that the resumed session exists */
+    case_resumption_remove(resumption_id);
+
+    /* ----------------------------------------------------------
+     * Build Sigma2_Resume TLV
+     *   Tag 1: ResumptionID        ByteString(16)
+     *   Tag 2: Sigma2ResumeMIC     ByteString(16)
+     *   Tag 3: ResponderSessionId  UInt16
+     * ---------------------------------------------------------- */
+    {
+        tlv_writer_t w;
+        tlv_writer_init(&w, out, out_size);
+        tlv_encode_structure_start(&w, 0);
+        tlv_encode_bytes(&w, 1, ticket.resumption_id, CASE_RESUMPTION_ID_LEN);
+        tlv_encode_bytes(&w, 2, sigma2_mic, CCM_TAG_SIZE);
+        tlv_encode_uint16(&w, 3, g_case_ctx.responder_session_id);
+        tlv_encode_container_end(&w);
+        *out_len = tlv_writer_get_length(&w);
+    }
+
+    case_resumption_save(&ticket);
+    mbedtls_platform_zeroize(&ticket, sizeof(ticket));
+
+    g_case_ctx.established_session_id = g_case_ctx.responder_session_id;
+    g_case_ctx.state               = CASE_STATE_ESTABLISHED;
+    g_case_ctx.session_established = true;
+    printf("[CASE] Session %u resumed (Sigma2_Resume, %zu bytes)\n",
+           g_case_ctx.established_session_id, *out_len);
+    crypto_stats_handshake_done();
+    return 0;
+}
+
 int case_handle_sigma2(const uint8_t *in, size_t in_len,
                        uint8_t *out, size_t out_size, size_t *out_len) {
     /* Sigma2 is sent by the responder; on device side this is a no-op. */
@@ -500,12 +864,19 @@ int case_handle_sigma3(const uint8_t *in, size_t in_len,
     }
     printf("[CASE] Handling Sigma3 (%zu bytes)\n", in_len);
 
-    /* Extract Encrypted3 blob (Tag 1) */
-    static uint8_t enc3[CASE_SIGMA3_MAX_SIZE];
+    /* Extract Encrypted3 blob (Tag 1) into a message pool block; it is
+     * decrypted in place below. */
+    packet_buffer_t *tbe3 = msg_pool_alloc();
+    if (!tbe3) {
+        printf("[CASE] Sigma3: message pool exhausted\n");
+        return -1;
+    }
+    uint8_t       *enc3 = tbe3->data;
     size_t         enc3_len = 0;
-    if (tlv_find_bytes(in, in_len, 1, enc3, sizeof(enc3), &enc3_len) != 0
+    if (tlv_find_bytes(in, in_len, 1, enc3, sizeof(tbe3->data), &enc3_len) != 0
             || enc3_len <= CCM_TAG_SIZE) {
         printf("[CASE] Sigma3: missing or short Encrypted3\n");
+        msg_pool_release(tbe3);
         return -1;
     }
 
@@ -518,47 +889,89 @@ int case_handle_sigma3(const uint8_t *in, size_t in_len,
     if (ret != 0) {
         log_mbedtls_err("hkdf TBE3", ret);
         mbedtls_platform_zeroize(tbe3_key, sizeof(tbe3_key));
+        msg_pool_release(tbe3);
         return -1;
     }
 
-    /* Decrypt TBE3 */
-    static uint8_t tbe3_plain[CASE_SIGMA3_MAX_SIZE];
+    /* Decrypt TBE3 in place */
+    uint8_t       *tbe3_plain = enc3;
     size_t         tbe3_plain_len = 0;
     ret = ccm_decrypt(tbe3_key, enc3, enc3_len, tbe3_plain, &tbe3_plain_len);
     mbedtls_platform_zeroize(tbe3_key, sizeof(tbe3_key));
     if (ret != 0) {
         log_mbedtls_err("ccm_auth_decrypt TBE3", ret);
+        mbedtls_platform_zeroize(tbe3_plain, enc3_len);
+        msg_pool_release(tbe3);
         return -1;
     }
 
     /*
-     * TEST-MODE: Accept any TBE3 that decrypts + authenticates correctly.
-     * Production TODO: parse initiator NOC (TBE3 Tag 1), verify against RCAC,
-     * extract public key, verify Sigma3 signature (TBE3 Tag 3) over T2.
+     * TEST-MODE: an initiator that fails verification still gets its
+     * session (see PRODUCTION_README.md), but never a resumption ticket,
+     * since a ticket lets its holder skip this check next time.
      */
-    printf("[CASE] TBE3 decrypted (%zu bytes) "
-           "[test-mode: NOC chain verify skipped]\n", tbe3_plain_len);
-
-    /* Store initiator NOC if present (TBE3 Tag 1) */
-    {
-        uint8_t noc[CERT_STORE_MAX_CERT_SIZE];
-        size_t  noc_len = 0;
-        if (tlv_find_bytes(tbe3_plain, tbe3_plain_len, 1,
-                           noc, sizeof(noc), &noc_len) == 0 && noc_len > 0) {
-            certificate_store_save_noc(noc, noc_len);
+    uint64_t peer_node_id = 0;
+    bool peer_verified =
+        (verify_initiator(tbe3_plain, tbe3_plain_len, &peer_node_id) == 0);
+    printf("[CASE] TBE3 decrypted (%zu bytes), initiator %s\n",
+           tbe3_plain_len, peer_verified ? "verified" : "NOT verified");
+
+    /* Our own node ID (source node in the nonce of messages we send),
+     * parsed once when the NOC was stored */
+    uint64_t local_node_id = 0;
+    certificate_store_get_node_id(&local_node_id);
+
+    /* An unverified initiator's node ID is still taken from its NOC, as
+     * the source node of its messages (nonce).  Parsed in place; the
+     * initiator's NOC is not persisted (it would overwrite ours in the
+     * certificate store). */
+    if (!peer_verified) {
+        const uint8_t *peer_noc = NULL;
+        size_t         peer_noc_len = 0;
+        if (tlv_find_bytes_ref(tbe3_plain, tbe3_plain_len, 1,
+                               &peer_noc, &peer_noc_len) == 0) {
+            certificate_store_parse_node_id(peer_noc, peer_noc_len,
+                                            &peer_node_id);
         }
-        mbedtls_platform_zeroize(noc, sizeof(noc));
     }
     mbedtls_platform_zeroize(tbe3_plain, tbe3_plain_len);
+    msg_pool_release(tbe3);
 
-    /* Register CASE session in session manager (use I2R key) */
+    /* Register CASE session: we are the responder, so we receive with I2R
+     * and send with R2I, and the initiator addresses us by our session ID */
     g_case_ctx.established_session_id = g_case_ctx.responder_session_id;
-    if (session_create(g_case_ctx.established_session_id,
-                       g_case_ctx.i2r_key, CASE_SESSION_KEY_LEN) != 0) {
+    session_params_t params = {
+        .local_session_id = g_case_ctx.responder_session_id,
+        .peer_session_id  = g_case_ctx.initiator_session_id,
+        .tx_key           = g_case_ctx.r2i_key,
+        .rx_key           = g_case_ctx.i2r_key,
+        .local_node_id    = local_node_id,
+        .peer_node_id     = peer_node_id,
+        .auth_mode        = SESSION_AUTH_CASE,
+    };
+    if (session_create_secure(&params) != 0) {
         printf("[CASE] WARNING: session_create failed\n");
     } else {
         printf("[CASE] Session %u established\n",
                g_case_ctx.established_session_id);
+        crypto_stats_handshake_done();
+
+        if (!peer_verified) {
+            /* A ticket lets its holder skip authentication later, so an
+             * unverified peer must not get one */
+            printf("[CASE] No resumption ticket: initiator not verified\n");
+        } else {
+            /* Keep the shared secret under the resumption ID sent in TBE2 */
+            case_resumption_ticket_t ticket;
+            memcpy(ticket.resumption_id, g_case_ctx.resumption_id,
+                   CASE_RESUMPTION_ID_LEN);
+            memcpy(ticket.shared_secret, g_case_ctx.shared_secret,
+                   CASE_RESUMPTION_SECRET_LEN);
+            ticket.peer_node_id  = peer_node_id;
+            ticket.local_node_id = local_node_id;
+            case_resumption_save(&ticket);
+            mbedtls_platform_zeroize(&ticket, sizeof(ticket));
+        }
     }
 
     g_case_ctx.state             = CASE_STATE_ESTABLISHED;
@@ -3,8 +3,9 @@
  * Certificate-Authenticated Session Establishment (CASE / Sigma) for Matter.
  *
  * Implements the responder side of Matter CASE (§4.13):
- *   Sigma1 → Sigma2 (Sigma2 resume not yet supported)
+ *   Sigma1 → Sigma2
  *   Sigma3 → Session established
+ *   Sigma1 with a known resumption ID → Sigma2_Resume, session established
  *
  * TEST-MODE ONLY – uses test NOC stored in LittleFS.
  * See PRODUCTION_README.md for production hardening.
@@ -32,6 +33,9 @@ extern "C" {
 /* CASE resumption ID length */
 #define CASE_RESUMPTION_ID_LEN 16
 
+/* case_handle_sigma1_resume(): Sigma1 must go through the full handshake */
+#define CASE_RESUME_NOT_APPLICABLE  1
+
 /*
  * Initialize the CASE subsystem.
  * Loads the device NOC from certificate_store and sets up internal state.
@@ -56,6 +60,23 @@ int case_init(void);
 int case_handle_sigma1(const uint8_t *in, size_t in_len,
                        uint8_t *out, size_t out_size, size_t *out_len);
 
+/*
+ * Try to resume a session from an incoming Sigma1.
+ * If Sigma1 carries a resumption ID that matches a stored ticket and a
+ * valid InitiatorResumeMIC, the session is re-established from the stored
+ * shared secret (HKDF only) and Sigma2_Resume is written to out.
+ *
+ * @param in        Raw Sigma1 TLV bytes.
+ * @param in_len    Length of in.
+ * @param out       Buffer to receive encoded Sigma2_Resume bytes.
+ * @param out_size  Size of out buffer.
+ * @param out_len   Set to the actual length written.
+ * @return 0 on success, CASE_RESUME_NOT_APPLICABLE if the caller should
+ *         continue with case_handle_sigma1(), -1 on error.
+ */
+int case_handle_sigma1_resume(const uint8_t *in, size_t in_len,
+                              uint8_t *out, size_t out_size, size_t *out_len);
+
 /*
  * Process an incoming Sigma2 message (not expected on the responder side;
  * provided for symmetry and potential host-side initiator use).
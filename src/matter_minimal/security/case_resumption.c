@@ -0,0 +1,235 @@
+/*
+ * case_resumption.c
+ * CASE session resumption ticket store.
+ */
+
+#include "case_resumption.h"
+#include <string.h>
+#include <stdio.h>
+
+#ifdef CASE_RESUMPTION_PERSIST
+#include "aes_ccm.h"
+#include "attestation.h"
+#include "pico/rand.h"
+
+/* Platform storage functions */
+extern int storage_adapter_write(const char *key, const uint8_t *value, size_t value_len);
+extern int storage_adapter_read(const char *key, uint8_t *value, size_t max_value_len, size_t *actual_len);
+extern int storage_adapter_delete(const char *key);
+#endif
+
+/* Persisted table layout version (2: sealed) */
+#define CASE_RESUMPTION_VERSION     2
+
+/* Sealing of the persisted table: AES-CCM nonce and tag sizes */
+#define SEAL_NONCE_LEN              13
+#define SEAL_TAG_LEN                16
+
+typedef struct {
+    case_resumption_ticket_t ticket;
+    uint32_t stored;            /* Store order (oldest is replaced) */
+    bool     used;
+} ticket_slot_t;
+
+typedef struct {
+    uint32_t      version;
+    uint32_t      tick;
+    ticket_slot_t slots[CASE_RESUMPTION_SLOTS];
+} ticket_table_t;
+
+static ticket_table_t g_table;
+
+#ifdef CASE_RESUMPTION_PERSIST
+/*
+ * Flash copy of the table.  The table (shared secrets included) is
+ * encrypted under a key derived from the attestation private key, so the
+ * secrets are never written in the clear and a copied file is of no use
+ * on another device.
+ */
+typedef struct {
+    uint32_t       version;
+    uint8_t        nonce[SEAL_NONCE_LEN];
+    uint8_t        tag[SEAL_TAG_LEN];
+    ticket_table_t table;       /* Encrypted */
+} sealed_table_t;
+
+static const uint8_t SEAL_KEY_INFO[] = "CASE Resumption Seal";
+
+static sealed_table_t g_sealed;
+static uint8_t        g_seal_key[AES_CCM_KEY_LENGTH];
+static bool           g_seal_ready = false;
+#endif
+
+/* ------------------------------------------------------------------ */
+/* Helpers                                                              */
+/* ------------------------------------------------------------------ */
+
+/* Zeroize without the compiler eliding the stores */
+static void wipe(void *p, size_t len) {
+    volatile uint8_t *v = (volatile uint8_t *)p;
+    while (len--) *v++ = 0;
+}
+
+#ifdef CASE_RESUMPTION_PERSIST
+/* Encrypt g_table into g_sealed, or decrypt g_sealed back into g_table */
+static int seal(bool encrypt) {
+    aes_ccm_ctx_t ccm;
+    const uint8_t *aad = (const uint8_t *)&g_sealed.version;
+    int ret = aes_ccm_setkey(&ccm, g_seal_key, sizeof(g_seal_key));
+
+    if (ret == 0 && encrypt) {
+        ret = aes_ccm_encrypt(&ccm, g_sealed.nonce, SEAL_NONCE_LEN,
+                              aad, sizeof(g_sealed.version),
+                              (const uint8_t *)&g_table, sizeof(g_table),
+                              (uint8_t *)&g_sealed.table,
+                              g_sealed.tag, SEAL_TAG_LEN);
+    } else if (ret == 0) {
+        ret = aes_ccm_decrypt(&ccm, g_sealed.nonce, SEAL_NONCE_LEN,
+                              aad, sizeof(g_sealed.version),
+                              (const uint8_t *)&g_sealed.table, sizeof(g_table),
+                              (uint8_t *)&g_table,
+                              g_sealed.tag, SEAL_TAG_LEN);
+    }
+    aes_ccm_free(&ccm);
+    return ret == 0 ? 0 : -1;
+}
+#endif
+
+static void persist(void) {
+#ifdef CASE_RESUMPTION_PERSIST
+    if (!g_seal_ready) {
+        return;     /* No sealing key: tickets stay in RAM */
+    }
+
+    /* Fresh random nonce for every write */
+    g_sealed.version = CASE_RESUMPTION_VERSION;
+    for (size_t i = 0; i < SEAL_NONCE_LEN; i += sizeof(uint32_t)) {
+        uint32_t r = get_rand_32();
+        size_t n = SEAL_NONCE_LEN - i < sizeof(r) ? SEAL_NONCE_LEN - i : sizeof(r);
+        memcpy(g_sealed.nonce + i, &r, n);
+    }
+
+    if (seal(true) != 0 ||
+        storage_adapter_write(CASE_RESUMPTION_PATH,
+                              (const uint8_t *)&g_sealed, sizeof(g_sealed)) != 0) {
+        printf("[CASE-Resume] WARNING: failed to persist tickets\n");
+    }
+#endif
+}
+
+static ticket_slot_t *find_slot(const uint8_t *resumption_id) {
+    for (int i = 0; i < CASE_RESUMPTION_SLOTS; i++) {
+        ticket_slot_t *s = &g_table.slots[i];
+        if (s->used && memcmp(s->ticket.resumption_id, resumption_id,
+                              CASE_RESUMPTION_ID_LEN) == 0) {
+            return s;
+        }
+    }
+    return NULL;
+}
+
+static void free_slot(ticket_slot_t *s) {
+    wipe(s, sizeof(*s));
+}
+
+/* ------------------------------------------------------------------ */
+/* Public API                                                           */
+/* ------------------------------------------------------------------ */
+
+void case_resumption_init(void) {
+    wipe(&g_table, sizeof(g_table));
+    g_table.version = CASE_RESUMPTION_VERSION;
+
+#ifdef CASE_RESUMPTION_PERSIST
+    /* Needs attestation_init() first; without the key nothing is persisted */
+    g_seal_ready = attestation_derive_key(SEAL_KEY_INFO, sizeof(SEAL_KEY_INFO) - 1,
+                                          g_seal_key, sizeof(g_seal_key)) == 0;
+    if (!g_seal_ready) {
+        printf("[CASE-Resume] No sealing key: tickets kept in RAM only\n");
+    }
+
+    size_t len = 0;
+    if (storage_adapter_read(CASE_RESUMPTION_PATH, (uint8_t *)&g_sealed,
+                             sizeof(g_sealed), &len) == 0) {
+        if (!g_seal_ready || len != sizeof(g_sealed)
+                || g_sealed.version != CASE_RESUMPTION_VERSION
+                || seal(false) != 0
+                || g_table.version != CASE_RESUMPTION_VERSION) {
+            /* Another layout (older builds wrote it unsealed), another
+             * device key, or tampered: drop it */
+            wipe(&g_table, sizeof(g_table));
+            g_table.version = CASE_RESUMPTION_VERSION;
+            storage_adapter_delete(CASE_RESUMPTION_PATH);
+        }
+    }
+#endif
+
+    printf("[CASE-Resume] Ticket store ready (%d/%d tickets)\n",
+           case_resumption_count(), CASE_RESUMPTION_SLOTS);
+}
+
+int case_resumption_save(const case_resumption_ticket_t *ticket) {
+    if (!ticket) return -1;
+
+    ticket_slot_t *slot = NULL;
+    ticket_slot_t *oldest = NULL;
+    ticket_slot_t *free_s = NULL;
+
+    for (int i = 0; i < CASE_RESUMPTION_SLOTS; i++) {
+        ticket_slot_t *s = &g_table.slots[i];
+        if (!s->used) {
+            if (!free_s) free_s = s;
+            continue;
+        }
+        /* One ticket per peer: a new handshake supersedes the old one */
+        if (ticket->peer_node_id != 0 &&
+            s->ticket.peer_node_id == ticket->peer_node_id) {
+            slot = s;
+            break;
+        }
+        if (!oldest || (int32_t)(s->stored - oldest->stored) < 0) {
+            oldest = s;
+        }
+    }
+    if (!slot) slot = free_s ? free_s : oldest;
+
+    slot->ticket = *ticket;
+    slot->stored = ++g_table.tick;
+    slot->used   = true;
+    persist();
+    return 0;
+}
+
+int case_resumption_find(const uint8_t *resumption_id,
+                         case_resumption_ticket_t *ticket) {
+    if (!resumption_id || !ticket) return -1;
+    ticket_slot_t *s = find_slot(resumption_id);
+    if (!s) return -1;
+    *ticket = s->ticket;
+    return 0;
+}
+
+int case_resumption_remove(const uint8_t *resumption_id) {
+    if (!resumption_id) return -1;
+    ticket_slot_t *s = find_slot(resumption_id);
+    if (!s) return -1;
+    free_slot(s);
+    persist();
+    return 0;
+}
+
+void case_resumption_clear(void) {
+    wipe(&g_table, sizeof(g_table));
+    g_table.version = CASE_RESUMPTION_VERSION;
+#ifdef CASE_RESUMPTION_PERSIST
+    storage_adapter_delete(CASE_RESUMPTION_PATH);
+#endif
+}
+
+int case_resumption_count(void) {
+    int n = 0;
+    for (int i = 0; i < CASE_RESUMPTION_SLOTS; i++) {
+        if (g_table.slots[i].used) n++;
+    }
+    return n;
+}
@@ -0,0 +1,102 @@
+/*
+ * case_resumption.h
+ * CASE session resumption ticket store (Matter §4.13.2.2).
+ *
+ * After a full CASE handshake the responder keeps the ECDH shared secret
+ * under a random resumption ID together with the peer's identity.  A
+ * later Sigma1 carrying that ID (and a MIC proving knowledge of the
+ * secret) is answered with Sigma2_Resume, skipping the P-256 ECDH, the
+ * ECDSA signature and certificate handling.
+ *
+ * Tickets live in a small static table; when it is full the least
+ * recently stored ticket is replaced, and a peer only ever holds one
+ * ticket.  With CASE_RESUMPTION_PERSIST defined the table is also written
+ * to flash (storage_adapter) on every change, so controllers can resume
+ * across device reboots.  The flash copy is sealed (AES-CCM) under a key
+ * derived from the attestation private key; without that key tickets stay
+ * in RAM.
+ */
+
+#ifndef CASE_RESUMPTION_H
+#define CASE_RESUMPTION_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "case.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of tickets kept (override at build time if needed) */
+#ifndef CASE_RESUMPTION_SLOTS
+#define CASE_RESUMPTION_SLOTS       4
+#endif
+
+/* ECDH shared secret length (P-256 X coordinate) */
+#define CASE_RESUMPTION_SECRET_LEN  32
+
+/* LittleFS path of the persisted table (CASE_RESUMPTION_PERSIST) */
+#define CASE_RESUMPTION_PATH        "/case_resume"
+
+/*
+ * Resumption ticket
+ */
+typedef struct {
+    uint8_t  resumption_id[CASE_RESUMPTION_ID_LEN];
+    uint8_t  shared_secret[CASE_RESUMPTION_SECRET_LEN];
+    uint64_t peer_node_id;      /* Initiator node ID (0 = unknown) */
+    uint64_t local_node_id;     /* Our node ID in the session */
+} case_resumption_ticket_t;
+
+/*
+ * Initialize the ticket store.
+ * Clears the table, then loads persisted tickets if enabled (call after
+ * attestation_init(), which provides the sealing key).
+ */
+void case_resumption_init(void);
+
+/*
+ * Store a ticket.
+ * Replaces the ticket of the same peer node, else takes a free slot, else
+ * the oldest ticket.
+ *
+ * @param ticket Ticket to store (copied).
+ * @return 0 on success, -1 on invalid params.
+ */
+int case_resumption_save(const case_resumption_ticket_t *ticket);
+
+/*
+ * Look up a ticket by resumption ID.
+ *
+ * @param resumption_id Resumption ID (CASE_RESUMPTION_ID_LEN bytes).
+ * @param ticket        Receives a copy of the ticket.
+ * @return 0 if found, -1 otherwise.
+ */
+int case_resumption_find(const uint8_t *resumption_id,
+                         case_resumption_ticket_t *ticket);
+
+/*
+ * Remove a ticket (resumption IDs are single use).
+ *
+ * @param resumption_id Resumption ID.
+ * @return 0 if removed, -1 if not found.
+ */
+int case_resumption_remove(const uint8_t *resumption_id);
+
+/*
+ * Wipe all tickets (RAM and, if enabled, flash).  Call on factory reset.
+ */
+void case_resumption_clear(void);
+
+/*
+ * Number of tickets currently stored.
+ */
+int case_resumption_count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CASE_RESUMPTION_H */
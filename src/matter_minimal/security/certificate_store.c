@@ -1,10 +1,12 @@
 /*
  * certificate_store.c
  * Persistent storage for Matter operational certificates (NOC / ICAC / RCAC).
- * Uses storage_adapter_read/write (LittleFS on Pico W flash).
+ * Uses storage_adapter_read/write (LittleFS on Pico W flash), with a RAM
+ * copy of each certificate so CASE handshakes do no filesystem I/O.
  */
 
 #include "certificate_store.h"
+#include "../codec/tlv.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -13,34 +15,104 @@ extern int storage_adapter_write(const char *key, const uint8_t *value, size_t v
 extern int storage_adapter_read(const char *key, uint8_t *value, size_t max_value_len, size_t *actual_len);
 extern int storage_adapter_delete(const char *key);
 
+/* ------------------------------------------------------------------ */
+/* RAM cache                                                            */
+/* ------------------------------------------------------------------ */
+
+/*
+ * Each certificate is read from flash once (certificate_store_init() at
+ * boot, or the first load) and served from RAM afterwards; saves and
+ * clear_all refresh the cached copy, so it never goes stale.
+ */
+typedef struct {
+    const char *path;
+    uint8_t     der[CERT_STORE_MAX_CERT_SIZE];
+    size_t      len;        /* 0 = not stored */
+    bool        loaded;     /* Cache reflects flash */
+} cert_cache_t;
+
+enum { CACHE_NOC = 0, CACHE_ICAC, CACHE_RCAC, CACHE_COUNT };
+
+static cert_cache_t g_cache[CACHE_COUNT] = {
+    [CACHE_NOC]  = { .path = CERT_STORE_NOC_PATH },
+    [CACHE_ICAC] = { .path = CERT_STORE_ICAC_PATH },
+    [CACHE_RCAC] = { .path = CERT_STORE_RCAC_PATH },
+};
+
+/* Node ID parsed from the cached NOC */
+static uint64_t g_noc_node_id;
+static bool     g_noc_node_id_valid;
+
+/* Matter TLV certificate: subject DN list (tag 6) and its
+ * matter-node-id attribute (tag 17) */
+#define CERT_TAG_SUBJECT        6
+#define CERT_DN_TAG_NODE_ID     17
+
 /* ------------------------------------------------------------------ */
 /* Helpers                                                              */
 /* ------------------------------------------------------------------ */
 
-static int cert_save(const char *path, const uint8_t *der, size_t len) {
-    if (!path || !der || len == 0 || len > CERT_STORE_MAX_CERT_SIZE) {
-        printf("[CertStore] ERROR: invalid params for %s\n", path ? path : "?");
+static void cache_set(cert_cache_t *c, const uint8_t *der, size_t len) {
+    if (len > 0) memcpy(c->der, der, len);
+    if (len < c->len) memset(c->der + len, 0, c->len - len);
+    c->len    = len;
+    c->loaded = true;
+    if (c == &g_cache[CACHE_NOC]) {
+        g_noc_node_id_valid = (len > 0 &&
+            certificate_store_parse_node_id(c->der, len, &g_noc_node_id) == 0);
+    }
+}
+
+static void cache_invalidate(cert_cache_t *c) {
+    memset(c->der, 0, sizeof(c->der));
+    c->len    = 0;
+    c->loaded = false;
+    if (c == &g_cache[CACHE_NOC]) g_noc_node_id_valid = false;
+}
+
+/* Fill the cache entry from flash if needed; returns it */
+static cert_cache_t *cache_get(int which) {
+    cert_cache_t *c = &g_cache[which];
+    if (!c->loaded) {
+        size_t actual = 0;
+        int ret = storage_adapter_read(c->path, c->der, sizeof(c->der), &actual);
+        if (ret != 0 || actual > sizeof(c->der)) {
+            /* Absent (or unreadable): cache as "not stored" */
+            memset(c->der, 0, sizeof(c->der));
+            actual = 0;
+        }
+        cache_set(c, c->der, actual);
+    }
+    return c;
+}
+
+static int cert_save(int which, const uint8_t *der, size_t len) {
+    const char *path = g_cache[which].path;
+    if (!der || len == 0 || len > CERT_STORE_MAX_CERT_SIZE) {
+        printf("[CertStore] ERROR: invalid params for %s\n", path);
         return -1;
     }
     int ret = storage_adapter_write(path, der, len);
     if (ret == 0) {
+        cache_set(&g_cache[which], der, len);
         printf("[CertStore] Saved %zu bytes to %s\n", len, path);
     } else {
+        /* Flash state unknown - re-read on next use */
+        cache_invalidate(&g_cache[which]);
         printf("[CertStore] ERROR: Failed to save %s\n", path);
     }
     return ret;
 }
 
-static int cert_load(const char *path,
-                     uint8_t *buf, size_t buf_size, size_t *out_len) {
-    if (!path || !buf || !out_len) return -1;
+static int cert_load(int which, uint8_t *buf, size_t buf_size, size_t *out_len) {
+    if (!buf || !out_len) return -1;
     *out_len = 0;
-    size_t actual = 0;
-    int ret = storage_adapter_read(path, buf, buf_size, &actual);
-    if (ret != 0 || actual == 0) {
+    const cert_cache_t *c = cache_get(which);
+    if (c->len == 0 || c->len > buf_size) {
         return -1;
     }
-    *out_len = actual;
+    memcpy(buf, c->der, c->len);
+    *out_len = c->len;
     return 0;
 }
 
@@ -48,45 +120,115 @@ static int cert_load(const char *path,
 /* Public API                                                           */
 /* ------------------------------------------------------------------ */
 
+void certificate_store_init(void) {
+    for (int i = 0; i < CACHE_COUNT; i++) {
+        cache_get(i);
+    }
+    printf("[CertStore] Cached NOC %zu / ICAC %zu / RCAC %zu bytes\n",
+           g_cache[CACHE_NOC].len, g_cache[CACHE_ICAC].len,
+           g_cache[CACHE_RCAC].len);
+}
+
 int certificate_store_save_noc(const uint8_t *noc, size_t noc_len) {
-    return cert_save(CERT_STORE_NOC_PATH, noc, noc_len);
+    return cert_save(CACHE_NOC, noc, noc_len);
 }
 
 int certificate_store_load_noc(uint8_t *buf, size_t buf_size, size_t *out_len) {
-    return cert_load(CERT_STORE_NOC_PATH, buf, buf_size, out_len);
+    return cert_load(CACHE_NOC, buf, buf_size, out_len);
+}
+
+int certificate_store_get_noc(const uint8_t **noc, size_t *noc_len) {
+    if (!noc || !noc_len) return -1;
+    const cert_cache_t *c = cache_get(CACHE_NOC);
+    if (c->len == 0) return -1;
+    *noc     = c->der;
+    *noc_len = c->len;
+    return 0;
+}
+
+int certificate_store_get_node_id(uint64_t *node_id) {
+    if (!node_id) return -1;
+    cache_get(CACHE_NOC);
+    if (!g_noc_node_id_valid) return -1;
+    *node_id = g_noc_node_id;
+    return 0;
 }
 
 int certificate_store_has_noc(void) {
-    uint8_t tmp[CERT_STORE_MAX_CERT_SIZE];
-    size_t  len = 0;
-    return (certificate_store_load_noc(tmp, sizeof(tmp), &len) == 0 &&
-            len > 0) ? 1 : 0;
+    return (cache_get(CACHE_NOC)->len > 0) ? 1 : 0;
 }
 
 int certificate_store_save_icac(const uint8_t *icac, size_t icac_len) {
-    return cert_save(CERT_STORE_ICAC_PATH, icac, icac_len);
+    return cert_save(CACHE_ICAC, icac, icac_len);
 }
 
 int certificate_store_load_icac(uint8_t *buf, size_t buf_size, size_t *out_len) {
-    return cert_load(CERT_STORE_ICAC_PATH, buf, buf_size, out_len);
+    return cert_load(CACHE_ICAC, buf, buf_size, out_len);
 }
 
 int certificate_store_save_rcac(const uint8_t *rcac, size_t rcac_len) {
-    return cert_save(CERT_STORE_RCAC_PATH, rcac, rcac_len);
+    return cert_save(CACHE_RCAC, rcac, rcac_len);
 }
 
 int certificate_store_load_rcac(uint8_t *buf, size_t buf_size, size_t *out_len) {
-    return cert_load(CERT_STORE_RCAC_PATH, buf, buf_size, out_len);
+    return cert_load(CACHE_RCAC, buf, buf_size, out_len);
+}
+
+int certificate_store_get_rcac(const uint8_t **rcac, size_t *rcac_len) {
+    if (!rcac || !rcac_len) return -1;
+    const cert_cache_t *c = cache_get(CACHE_RCAC);
+    if (c->len == 0) return -1;
+    *rcac     = c->der;
+    *rcac_len = c->len;
+    return 0;
 }
 
 int certificate_store_clear_all(void) {
     int err = 0;
     /* storage_adapter_delete returns 0 even if file is absent */
-    if (storage_adapter_delete(CERT_STORE_NOC_PATH)  != 0) err = -1;
-    if (storage_adapter_delete(CERT_STORE_ICAC_PATH) != 0) err = -1;
-    if (storage_adapter_delete(CERT_STORE_RCAC_PATH) != 0) err = -1;
+    for (int i = 0; i < CACHE_COUNT; i++) {
+        if (storage_adapter_delete(g_cache[i].path) != 0) {
+            err = -1;
+            cache_invalidate(&g_cache[i]);
+        } else {
+            cache_set(&g_cache[i], NULL, 0);
+        }
+    }
     if (err == 0) {
         printf("[CertStore] All operational certs cleared\n");
     }
     return err;
 }
+
+int certificate_store_parse_node_id(const uint8_t *noc, size_t noc_len,
+                                    uint64_t *node_id) {
+    if (!noc || !node_id) return -1;
+
+    tlv_reader_t r;
+    tlv_element_t el;
+    int depth = 0;
+    int subject_depth = -1;
+    tlv_reader_init(&r, noc, noc_len);
+    memset(&el, 0, sizeof(el));
+    while (tlv_reader_next(&r, &el) == 0) {
+        if (el.type == TLV_TYPE_END_OF_CONTAINER) {
+            if (--depth <= 0) break;
+            if (depth < subject_depth) subject_depth = -1;
+        } else if (el.type == TLV_TYPE_STRUCTURE || el.type == TLV_TYPE_ARRAY
+                || el.type == TLV_TYPE_LIST) {
+            depth++;
+            if (depth == 2 && el.tag_type == TLV_TAG_CONTEXT_SPECIFIC
+                    && el.tag == CERT_TAG_SUBJECT)
+                subject_depth = depth;
+        } else if (depth == subject_depth
+                && el.tag_type == TLV_TAG_CONTEXT_SPECIFIC
+                && el.tag == CERT_DN_TAG_NODE_ID
+                && el.type == TLV_TYPE_UNSIGNED_INT) {
+            *node_id = el.value.u64;
+            return 0;
+        }
+        /* The reader only writes the bytes of the encoded width */
+        memset(&el, 0, sizeof(el));
+    }
+    return -1;
+}
@@ -7,6 +7,11 @@
  *   /certs/noc.der   – Node Operational Certificate (DER)
  *   /certs/icac.der  – Intermediate CA cert (optional, DER)
  *   /certs/rcac.der  – Root CA cert (optional, DER)
+ *
+ * Each certificate is read from flash once and kept in RAM (~1.8 KB for
+ * all three); the save and clear functions update the RAM copy along with
+ * flash, so loads never touch the filesystem after boot.  The device node
+ * ID is parsed from the NOC once per NOC change.
  */
 
 #ifndef CERTIFICATE_STORE_H
@@ -30,6 +35,13 @@ extern "C" {
 /* Maximum DER certificate size */
 #define CERT_STORE_MAX_CERT_SIZE  600
 
+/*
+ * Load all stored certificates into the RAM cache.
+ * Call at boot after storage_adapter_init(); otherwise each certificate is
+ * cached on first use.
+ */
+void certificate_store_init(void);
+
 /*
  * Save the Node Operational Certificate (received during AddNOC).
  *
@@ -49,6 +61,35 @@ int certificate_store_save_noc(const uint8_t *noc, size_t noc_len);
  */
 int certificate_store_load_noc(uint8_t *buf, size_t buf_size, size_t *out_len);
 
+/*
+ * Get the cached NOC without copying.
+ * The pointer stays valid until the next save/clear call.
+ *
+ * @param noc      Set to the cached NOC bytes.
+ * @param noc_len  Set to the NOC length.
+ * @return 0 on success, -1 if no NOC is stored.
+ */
+int certificate_store_get_noc(const uint8_t **noc, size_t *noc_len);
+
+/*
+ * Get the device's operational node ID (parsed from the cached NOC).
+ *
+ * @param node_id  Receives the node ID.
+ * @return 0 on success, -1 if no NOC is stored or it has no node ID.
+ */
+int certificate_store_get_node_id(uint64_t *node_id);
+
+/*
+ * Extract the node ID (subject DN, matter-node-id) from a Matter TLV NOC.
+ *
+ * @param noc      NOC bytes.
+ * @param noc_len  Length of noc.
+ * @param node_id  Receives the node ID.
+ * @return 0 on success, -1 if not found.
+ */
+int certificate_store_parse_node_id(const uint8_t *noc, size_t noc_len,
+                                    uint64_t *node_id);
+
 /*
  * Check whether a NOC has been stored.
  *
@@ -76,6 +117,16 @@ int certificate_store_save_rcac(const uint8_t *rcac, size_t rcac_len);
  */
 int certificate_store_load_rcac(uint8_t *buf, size_t buf_size, size_t *out_len);
 
+/*
+ * Get the cached RCAC (trust anchor for peer NOCs) without copying.
+ * The pointer stays valid until the next save/clear call.
+ *
+ * @param rcac      Set to the cached RCAC bytes.
+ * @param rcac_len  Set to the RCAC length.
+ * @return 0 on success, -1 if no RCAC is stored.
+ */
+int certificate_store_get_rcac(const uint8_t **rcac, size_t *rcac_len);
+
 /*
  * Delete all stored operational certificates (NOC, ICAC, RCAC).
  * Call during factory reset.
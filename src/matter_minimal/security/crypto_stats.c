@@ -0,0 +1,91 @@
+/*
+ * crypto_stats.c
+ * Per-operation counters and timing for the security layer's crypto
+ */
+
+#include "crypto_stats.h"
+#include <string.h>
+#include <stdio.h>
+#include "pico/time.h"
+
+static crypto_op_stats_t op_stats[CRYPTO_OP_COUNT];
+
+static const char *const op_names[CRYPTO_OP_COUNT] = {
+    [CRYPTO_OP_PBKDF2]       = "PBKDF2",
+    [CRYPTO_OP_KEYGEN]       = "P256 keygen",
+    [CRYPTO_OP_P256_FIXED]   = "P256 fixed",
+    [CRYPTO_OP_ECDH]         = "ECDH",
+    [CRYPTO_OP_ECDSA_SIGN]   = "ECDSA sign",
+    [CRYPTO_OP_ECDSA_VERIFY] = "ECDSA verify",
+    [CRYPTO_OP_HKDF]         = "HKDF",
+    [CRYPTO_OP_CCM_ENCRYPT]  = "CCM encrypt",
+    [CRYPTO_OP_CCM_DECRYPT]  = "CCM decrypt",
+    [CRYPTO_OP_SHA256]       = "SHA-256",
+    [CRYPTO_OP_AES]          = "AES",
+};
+
+#if CRYPTO_STATS_ENABLED
+
+uint64_t crypto_stats_begin(void) {
+    return time_us_64();
+}
+
+void crypto_stats_end(crypto_op_t op, uint64_t start, size_t bytes) {
+    if ((unsigned)op >= CRYPTO_OP_COUNT) {
+        return;
+    }
+
+    uint64_t elapsed = time_us_64() - start;
+    uint32_t us = elapsed > UINT32_MAX ? UINT32_MAX : (uint32_t)elapsed;
+    crypto_op_stats_t *s = &op_stats[op];
+
+    if (s->count == 0 || us < s->min_us) {
+        s->min_us = us;
+    }
+    if (us > s->max_us) {
+        s->max_us = us;
+    }
+    s->count++;
+    s->total_us += us;
+    s->bytes += bytes;
+}
+
+#endif // CRYPTO_STATS_ENABLED
+
+void crypto_stats_get(crypto_op_t op, crypto_op_stats_t *stats) {
+    if (!stats) {
+        return;
+    }
+    if ((unsigned)op >= CRYPTO_OP_COUNT) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+    *stats = op_stats[op];
+}
+
+void crypto_stats_reset(void) {
+    memset(op_stats, 0, sizeof(op_stats));
+}
+
+const char *crypto_stats_op_name(crypto_op_t op) {
+    if ((unsigned)op >= CRYPTO_OP_COUNT) {
+        return "?";
+    }
+    return op_names[op];
+}
+
+void crypto_stats_print(void) {
+    printf("Crypto: %-12s %8s %10s %10s %10s %10s\n",
+           "op", "count", "avg us", "min us", "max us", "bytes");
+    for (int i = 0; i < CRYPTO_OP_COUNT; i++) {
+        const crypto_op_stats_t *s = &op_stats[i];
+        if (s->count == 0) {
+            continue;
+        }
+        printf("Crypto: %-12s %8lu %10lu %10lu %10lu %10llu\n",
+               op_names[i], (unsigned long)s->count,
+               (unsigned long)(s->total_us / s->count),
+               (unsigned long)s->min_us, (unsigned long)s->max_us,
+               (unsigned long long)s->bytes);
+    }
+}
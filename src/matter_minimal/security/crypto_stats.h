@@ -0,0 +1,135 @@
+/*
+ * crypto_stats.h
+ * Per-operation counters and timing for the security layer's crypto
+ *
+ * PASE, CASE and session encryption record each crypto primitive they run
+ * (count, total / min / max microseconds, bytes processed), so the cost
+ * of a handshake or of steady-state traffic can be read off a running
+ * device.  crypto_stats_print() dumps the table to the console; with
+ * CRYPTO_STATS_PRINT_HANDSHAKE=1 (CMake MATTER_CRYPTO_STATS_PRINT=ON) it
+ * is also printed after each PASE and CASE handshake.
+ * tests/security/bench_crypto.c
+ * drives the same counters with synthetic workloads on host or RP2040.
+ *
+ * Timing uses time_us_64(), so an operation interrupted by an IRQ is
+ * charged the IRQ time too.  Build with CRYPTO_STATS_ENABLED=0 (CMake
+ * MATTER_CRYPTO_STATS=OFF) to compile the hooks out.
+ */
+
+#ifndef CRYPTO_STATS_H
+#define CRYPTO_STATS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef CRYPTO_STATS_ENABLED
+#define CRYPTO_STATS_ENABLED        1
+#endif
+
+#ifndef CRYPTO_STATS_PRINT_HANDSHAKE
+#define CRYPTO_STATS_PRINT_HANDSHAKE 0
+#endif
+
+/**
+ * Instrumented operations
+ */
+typedef enum {
+    CRYPTO_OP_PBKDF2 = 0,           // PBKDF2-HMAC-SHA256 (PASE verifier)
+    CRYPTO_OP_KEYGEN,               // P-256 d*G: key pairs, PASE L (fixed-base comb)
+    CRYPTO_OP_P256_FIXED,           // SPAKE2+ P +/- k*M/N (fixed-base comb)
+    CRYPTO_OP_ECDH,                 // Variable-base P-256 multiplication
+    CRYPTO_OP_ECDSA_SIGN,           // ECDSA-P256-SHA256 sign
+    CRYPTO_OP_ECDSA_VERIFY,         // ECDSA-P256-SHA256 verify
+    CRYPTO_OP_HKDF,                 // HKDF-SHA256 (bytes = output length)
+    CRYPTO_OP_CCM_ENCRYPT,          // AES-128-CCM encrypt (bytes = payload)
+    CRYPTO_OP_CCM_DECRYPT,          // AES-128-CCM decrypt (bytes = payload)
+    CRYPTO_OP_SHA256,               // SHA-256 (bytes = input length)
+    CRYPTO_OP_AES,                  // Raw AES (crypto adapter)
+    CRYPTO_OP_COUNT
+} crypto_op_t;
+
+/**
+ * Statistics for one operation
+ */
+typedef struct {
+    uint32_t count;                 // Completed operations
+    uint32_t min_us;                // Fastest (0 if count == 0)
+    uint32_t max_us;                // Slowest
+    uint64_t total_us;              // Sum of durations
+    uint64_t bytes;                 // Sum of data lengths
+} crypto_op_stats_t;
+
+#if CRYPTO_STATS_ENABLED
+
+/**
+ * Start timing an operation
+ *
+ * @return Start timestamp to pass to crypto_stats_end()
+ */
+uint64_t crypto_stats_begin(void);
+
+/**
+ * Record a completed operation
+ *
+ * @param op Operation
+ * @param start Value returned by crypto_stats_begin()
+ * @param bytes Data length processed (0 if not meaningful)
+ */
+void crypto_stats_end(crypto_op_t op, uint64_t start, size_t bytes);
+
+#else
+
+static inline uint64_t crypto_stats_begin(void) {
+    return 0;
+}
+
+static inline void crypto_stats_end(crypto_op_t op, uint64_t start, size_t bytes) {
+    (void)op;
+    (void)start;
+    (void)bytes;
+}
+
+#endif // CRYPTO_STATS_ENABLED
+
+/**
+ * Get statistics for one operation
+ *
+ * @param op Operation
+ * @param stats Receives the statistics (zeroed if op is out of range)
+ */
+void crypto_stats_get(crypto_op_t op, crypto_op_stats_t *stats);
+
+/**
+ * Reset all counters
+ */
+void crypto_stats_reset(void);
+
+/**
+ * Short operation name, e.g. "ECDH"
+ */
+const char *crypto_stats_op_name(crypto_op_t op);
+
+/**
+ * Print one line per operation that has run at least once
+ */
+void crypto_stats_print(void);
+
+/**
+ * Called when a PASE or CASE handshake completes: prints the table if
+ * CRYPTO_STATS_PRINT_HANDSHAKE is set
+ */
+static inline void crypto_stats_handshake_done(void) {
+#if CRYPTO_STATS_ENABLED && CRYPTO_STATS_PRINT_HANDSHAKE
+    crypto_stats_print();
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CRYPTO_STATS_H
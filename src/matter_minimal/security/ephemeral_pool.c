@@ -0,0 +1,96 @@
+/*
+ * ephemeral_pool.c
+ * Pool of precomputed ephemeral P-256 key pairs
+ */
+
+#include "ephemeral_pool.h"
+#include "secure_zero.h"
+#include <string.h>
+#include <stdbool.h>
+#include "pico/rand.h"
+#include "crypto_stats.h"
+
+/**
+ * Key pair slot
+ */
+typedef struct {
+    uint8_t priv[P256_SCALAR_LENGTH];
+    uint8_t pub[P256_POINT_LENGTH];
+    bool ready;
+} key_slot_t;
+
+static key_slot_t pool[EPHEMERAL_POOL_SIZE];
+static ephemeral_pool_stats_t pool_stats;
+
+/**
+ * Generate a key pair: uniform 1 <= d < n (rejection sampling), pub = d*G
+ */
+static int generate_key_pair(uint8_t priv[P256_SCALAR_LENGTH],
+                             uint8_t pub[P256_POINT_LENGTH]) {
+    do {
+        for (size_t i = 0; i < P256_SCALAR_LENGTH; i += 4) {
+            uint32_t w = get_rand_32();
+            memcpy(priv + i, &w, sizeof(w));
+        }
+    } while (p256_scalar_check(priv) != 0);
+
+    uint64_t t0 = crypto_stats_begin();
+    if (p256_fixed_mul(P256_BASE_G, priv, pub) != 0) {
+        secure_zero(priv, P256_SCALAR_LENGTH);
+        return -1;
+    }
+    crypto_stats_end(CRYPTO_OP_KEYGEN, t0, 0);
+    return 0;
+}
+
+void ephemeral_pool_init(void) {
+    secure_zero(pool, sizeof(pool));
+    memset(&pool_stats, 0, sizeof(pool_stats));
+}
+
+int ephemeral_pool_poll(void) {
+    for (int i = 0; i < EPHEMERAL_POOL_SIZE; i++) {
+        key_slot_t *slot = &pool[i];
+        if (slot->ready) {
+            continue;
+        }
+        if (generate_key_pair(slot->priv, slot->pub) != 0) {
+            return -1;
+        }
+        slot->ready = true;
+        pool_stats.ready++;
+        pool_stats.generated++;
+        return 1;
+    }
+    return 0;
+}
+
+int ephemeral_pool_take(uint8_t priv[P256_SCALAR_LENGTH],
+                        uint8_t pub[P256_POINT_LENGTH]) {
+    if (!priv || !pub) {
+        return -1;
+    }
+
+    for (int i = 0; i < EPHEMERAL_POOL_SIZE; i++) {
+        key_slot_t *slot = &pool[i];
+        if (!slot->ready) {
+            continue;
+        }
+        memcpy(priv, slot->priv, P256_SCALAR_LENGTH);
+        memcpy(pub, slot->pub, P256_POINT_LENGTH);
+        secure_zero(slot, sizeof(*slot));
+        pool_stats.ready--;
+        pool_stats.hits++;
+        return 0;
+    }
+
+    // Pool drained: generate on the critical path
+    pool_stats.misses++;
+    return generate_key_pair(priv, pub);
+}
+
+void ephemeral_pool_get_stats(ephemeral_pool_stats_t *stats) {
+    if (stats) {
+        *stats = pool_stats;
+    }
+}
@@ -0,0 +1,80 @@
+/*
+ * ephemeral_pool.h
+ * Pool of precomputed ephemeral P-256 key pairs
+ *
+ * CASE Sigma1 (responder ephemeral key) and PASE PAKE1 (verifier scalar y
+ * and y*G) each need a fresh key pair, and the scalar multiplication that
+ * produces the public half is the most expensive step before the reply can
+ * be sent.  This pool generates key pairs ahead of time: the main loop
+ * calls ephemeral_pool_poll() on idle iterations, which adds at most one
+ * key pair per call so a single loop pass stays short.  Handshakes take a
+ * ready pair; if the pool is empty (e.g. back-to-back handshakes right
+ * after boot) the pair is generated inline instead.
+ *
+ * Each key pair is handed out once and wiped from the pool when taken.
+ */
+
+#ifndef EPHEMERAL_POOL_H
+#define EPHEMERAL_POOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "p256_fixed.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Number of precomputed key pairs (97 bytes of RAM each).  Two covers a
+ * PASE and a CASE handshake, or two controllers connecting together.
+ */
+#ifndef EPHEMERAL_POOL_SIZE
+#define EPHEMERAL_POOL_SIZE         2
+#endif
+
+/**
+ * Pool statistics
+ */
+typedef struct {
+    uint32_t ready;                 // Key pairs currently available
+    uint32_t generated;             // Key pairs generated in the background
+    uint32_t hits;                  // Takes served from the pool
+    uint32_t misses;                // Takes that generated inline
+} ephemeral_pool_stats_t;
+
+/**
+ * Initialize (empty) the pool; it fills via ephemeral_pool_poll()
+ */
+void ephemeral_pool_init(void);
+
+/**
+ * Generate one key pair if the pool is not full.
+ * Call from the main loop when there is no other work.
+ *
+ * @return 1 if a key pair was added, 0 if the pool is full, -1 on error
+ */
+int ephemeral_pool_poll(void);
+
+/**
+ * Take a key pair (precomputed if available, otherwise generated now)
+ *
+ * @param priv Private scalar (32 bytes, big-endian, 1 <= d < n)
+ * @param pub Public key d * G (65 bytes, uncompressed)
+ * @return 0 on success, -1 on error
+ */
+int ephemeral_pool_take(uint8_t priv[P256_SCALAR_LENGTH],
+                        uint8_t pub[P256_POINT_LENGTH]);
+
+/**
+ * Get pool statistics
+ *
+ * @param stats Receives the statistics
+ */
+void ephemeral_pool_get_stats(ephemeral_pool_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EPHEMERAL_POOL_H
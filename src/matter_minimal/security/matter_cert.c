@@ -0,0 +1,697 @@
+/*
+ * matter_cert.c
+ * Matter TLV certificate parsing and DER TBSCertificate reconstruction
+ */
+
+#include "matter_cert.h"
+#include "../codec/tlv.h"
+#include <string.h>
+
+/* ------------------------------------------------------------------ */
+/* TLV certificate tags (Matter spec §6.5.2)                            */
+/* ------------------------------------------------------------------ */
+
+#define TAG_SERIAL          1
+#define TAG_SIG_ALGO        2
+#define TAG_ISSUER          3
+#define TAG_NOT_BEFORE      4
+#define TAG_NOT_AFTER       5
+#define TAG_SUBJECT         6
+#define TAG_PUBKEY_ALGO     7
+#define TAG_CURVE           8
+#define TAG_PUBKEY          9
+#define TAG_EXTENSIONS      10
+#define TAG_SIGNATURE       11
+
+/* Extensions list */
+#define EXT_BASIC_CONSTRAINTS   1
+#define EXT_KEY_USAGE           2
+#define EXT_EXT_KEY_USAGE       3
+#define EXT_SUBJECT_KEY_ID      4
+#define EXT_AUTHORITY_KEY_ID    5
+#define EXT_FUTURE              6
+
+/* Basic constraints structure */
+#define BC_IS_CA            1
+#define BC_PATH_LEN         2
+
+/* Enumerated values; only ECDSA-SHA256 / EC / prime256v1 exist */
+#define SIG_ALGO_ECDSA_SHA256   1
+#define PUBKEY_ALGO_EC          1
+#define CURVE_PRIME256V1        1
+
+/* DN attribute tags: 1-16 standard (tag | 0x80 = PrintableString),
+ * 17-22 Matter-specific integers rendered as hex */
+#define DN_PRINTABLE_FLAG       0x80
+#define DN_DOMAIN_COMPONENT     16
+#define DN_MATTER_NODE_ID       17
+#define DN_MATTER_FABRIC_ID     21
+#define DN_MATTER_NOC_CAT       22
+
+/* ------------------------------------------------------------------ */
+/* DER constants                                                        */
+/* ------------------------------------------------------------------ */
+
+#define DER_BOOLEAN         0x01
+#define DER_INTEGER         0x02
+#define DER_BIT_STRING      0x03
+#define DER_OCTET_STRING    0x04
+#define DER_OID             0x06
+#define DER_UTF8_STRING     0x0C
+#define DER_PRINTABLE       0x13
+#define DER_IA5_STRING      0x16
+#define DER_UTC_TIME        0x17
+#define DER_GENERALIZED     0x18
+#define DER_SEQUENCE        0x30
+#define DER_SET             0x31
+
+static const uint8_t DER_VERSION_V3[] = { 0xA0, 0x03, 0x02, 0x01, 0x02 };
+
+/* ecdsa-with-SHA256 (1.2.840.10045.4.3.2) */
+static const uint8_t OID_ECDSA_SHA256[] = {
+    0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x04, 0x03, 0x02
+};
+/* id-ecPublicKey (1.2.840.10045.2.1) */
+static const uint8_t OID_EC_PUBKEY[] = {
+    0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x02, 0x01
+};
+/* prime256v1 (1.2.840.10045.3.1.7) */
+static const uint8_t OID_PRIME256V1[] = {
+    0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x03, 0x01, 0x07
+};
+/* id-ce-* (2.5.29.x) */
+#define OID_CE_SUBJECT_KEY_ID       0x0E
+#define OID_CE_KEY_USAGE            0x0F
+#define OID_CE_BASIC_CONSTRAINTS    0x13
+#define OID_CE_AUTHORITY_KEY_ID     0x23
+#define OID_CE_EXT_KEY_USAGE        0x25
+
+/* id-at-* (2.5.4.x) for DN tags 1-15 */
+static const uint8_t DN_AT_ARC[15] = {
+    3, 4, 5, 6, 7, 8, 10, 11, 12, 41, 42, 43, 44, 46, 65
+};
+/* domainComponent (0.9.2342.19200300.100.1.25) */
+static const uint8_t OID_DOMAIN_COMPONENT[] = {
+    0x09, 0x92, 0x26, 0x89, 0x93, 0xF2, 0x2C, 0x64, 0x01, 0x19
+};
+/* Matter DN attributes (1.3.6.1.4.1.37244.1.x), x = tag - 16 */
+static const uint8_t OID_MATTER_DN_PREFIX[] = {
+    0x2B, 0x06, 0x01, 0x04, 0x01, 0x82, 0xA2, 0x7C, 0x01
+};
+/* id-kp-* (1.3.6.1.5.5.7.3.x), indexed by the Matter key purpose ID */
+static const uint8_t OID_KP_PREFIX[] = {
+    0x2B, 0x06, 0x01, 0x05, 0x05, 0x07, 0x03
+};
+static const uint8_t KP_ARC[7] = { 0, 1, 2, 3, 4, 8, 9 };
+
+/* ------------------------------------------------------------------ */
+/* DER writer                                                           */
+/* ------------------------------------------------------------------ */
+
+/*
+ * Constructed elements reserve a three-byte length (0x82 hi lo, enough
+ * for any certificate) and are shrunk to the minimal DER length when
+ * closed.
+ */
+typedef struct {
+    uint8_t *buf;
+    size_t   size;
+    size_t   len;
+    bool     overflow;
+} der_writer_t;
+
+static void der_put(der_writer_t *w, const uint8_t *data, size_t n) {
+    if (w->overflow || n > w->size - w->len) {
+        w->overflow = true;
+        return;
+    }
+    memcpy(w->buf + w->len, data, n);
+    w->len += n;
+}
+
+static void der_byte(der_writer_t *w, uint8_t b) {
+    der_put(w, &b, 1);
+}
+
+static void der_length(der_writer_t *w, size_t n) {
+    if (n < 0x80) {
+        der_byte(w, (uint8_t)n);
+    } else if (n < 0x100) {
+        der_byte(w, 0x81);
+        der_byte(w, (uint8_t)n);
+    } else {
+        der_byte(w, 0x82);
+        der_byte(w, (uint8_t)(n >> 8));
+        der_byte(w, (uint8_t)n);
+    }
+}
+
+static void der_prim(der_writer_t *w, uint8_t tag,
+                     const uint8_t *data, size_t n) {
+    der_byte(w, tag);
+    der_length(w, n);
+    der_put(w, data, n);
+}
+
+/* Open a constructed element; returns the mark for der_end() */
+static size_t der_begin(der_writer_t *w, uint8_t tag) {
+    der_byte(w, tag);
+    size_t mark = w->len;
+    static const uint8_t reserve[3] = { 0x82, 0, 0 };
+    der_put(w, reserve, sizeof(reserve));
+    return mark;
+}
+
+static void der_end(der_writer_t *w, size_t mark) {
+    if (w->overflow) return;
+    size_t content = w->len - (mark + 3);
+    if (content > 0xFFFF) {
+        w->overflow = true;
+        return;
+    }
+    size_t hdr = (content < 0x80) ? 1 : (content < 0x100) ? 2 : 3;
+    memmove(w->buf + mark + hdr, w->buf + mark + 3, content);
+    w->len = mark;
+    der_length(w, content);
+    w->len = mark + hdr + content;
+}
+
+static void der_oid(der_writer_t *w, const uint8_t *oid, size_t n) {
+    der_prim(w, DER_OID, oid, n);
+}
+
+/* OID made of a prefix and one final arc (< 128) */
+static void der_oid_arc(der_writer_t *w, const uint8_t *prefix, size_t n,
+                        uint8_t arc) {
+    der_byte(w, DER_OID);
+    der_length(w, n + 1);
+    der_put(w, prefix, n);
+    der_byte(w, arc);
+}
+
+static void der_oid_ce(der_writer_t *w, uint8_t arc) {
+    static const uint8_t ce[] = { 0x55, 0x1D };
+    der_oid_arc(w, ce, sizeof(ce), arc);
+}
+
+/* ------------------------------------------------------------------ */
+/* Field encoders                                                       */
+/* ------------------------------------------------------------------ */
+
+static const char HEX_DIGITS[] = "0123456789ABCDEF";
+
+/* One AttributeTypeAndValue in its own RDN set */
+static int der_dn_attribute(der_writer_t *w, const tlv_element_t *el) {
+    uint8_t tag = el->tag & (uint8_t)~DN_PRINTABLE_FLAG;
+    bool printable = (el->tag & DN_PRINTABLE_FLAG) != 0;
+
+    size_t set = der_begin(w, DER_SET);
+    size_t seq = der_begin(w, DER_SEQUENCE);
+
+    if (tag >= DN_MATTER_NODE_ID && tag <= DN_MATTER_NOC_CAT) {
+        if (printable || el->type != TLV_TYPE_UNSIGNED_INT) return -1;
+        der_oid_arc(w, OID_MATTER_DN_PREFIX, sizeof(OID_MATTER_DN_PREFIX),
+                    (uint8_t)(tag - DN_MATTER_NODE_ID + 1));
+        /* 64-bit IDs as 16 hex digits, CASE Authenticated Tags as 8 */
+        int digits = (tag == DN_MATTER_NOC_CAT) ? 8 : 16;
+        uint64_t v = el->value.u64;
+        char hex[16];
+        for (int i = digits - 1; i >= 0; i--) {
+            hex[i] = HEX_DIGITS[v & 0xF];
+            v >>= 4;
+        }
+        der_prim(w, DER_UTF8_STRING, (const uint8_t *)hex, (size_t)digits);
+    } else if (tag >= 1 && tag <= DN_DOMAIN_COMPONENT) {
+        if (el->type != TLV_TYPE_UTF8_STRING) return -1;
+        uint8_t str_tag = printable ? DER_PRINTABLE : DER_UTF8_STRING;
+        if (tag == DN_DOMAIN_COMPONENT) {
+            der_oid(w, OID_DOMAIN_COMPONENT, sizeof(OID_DOMAIN_COMPONENT));
+            str_tag = DER_IA5_STRING;
+        } else {
+            static const uint8_t at[] = { 0x55, 0x04 };
+            der_oid_arc(w, at, sizeof(at), DN_AT_ARC[tag - 1]);
+        }
+        der_prim(w, str_tag, (const uint8_t *)el->value.string.data,
+                 el->value.string.length);
+    } else {
+        return -1;
+    }
+
+    der_end(w, seq);
+    der_end(w, set);
+    return 0;
+}
+
+/* Name: reads the DN list the reader is positioned in */
+static int der_dn(der_writer_t *w, tlv_reader_t *r) {
+    tlv_element_t el;
+    size_t name = der_begin(w, DER_SEQUENCE);
+    for (;;) {
+        if (tlv_reader_next(r, &el) != 0) return -1;
+        if (el.type == TLV_TYPE_END_OF_CONTAINER) break;
+        if (el.tag_type != TLV_TAG_CONTEXT_SPECIFIC
+                || der_dn_attribute(w, &el) != 0) {
+            return -1;
+        }
+    }
+    der_end(w, name);
+    return 0;
+}
+
+/*
+ * Matter epoch seconds (from 2000-01-01) as UTCTime for 1950-2049 and
+ * GeneralizedTime after; 0 as not-after means "no expiry"
+ */
+static void der_time(der_writer_t *w, uint32_t matter_secs, bool not_after) {
+    if (not_after && matter_secs == 0) {
+        static const char no_expiry[] = "99991231235959Z";
+        der_prim(w, DER_GENERALIZED, (const uint8_t *)no_expiry,
+                 sizeof(no_expiry) - 1);
+        return;
+    }
+
+    uint32_t secs = matter_secs % 86400u;
+    /* Civil date from days since 1970-01-01 (proleptic Gregorian) */
+    int64_t z = (int64_t)(matter_secs / 86400u) + 10957 + 719468;
+    int64_t era = z / 146097;
+    int64_t doe = z - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+    unsigned day = (unsigned)(doy - (153 * mp + 2) / 5 + 1);
+    unsigned month = (unsigned)(mp < 10 ? mp + 3 : mp - 9);
+    unsigned year = (unsigned)(yoe + era * 400 + (month <= 2));
+
+    unsigned fields[6] = { year, month, day, secs / 3600u,
+                           (secs / 60u) % 60u, secs % 60u };
+    char text[16];
+    size_t n = 0;
+    bool utc = (year < 2050);
+    if (!utc) {
+        text[n++] = (char)('0' + (year / 1000) % 10);
+        text[n++] = (char)('0' + (year / 100) % 10);
+    }
+    for (int i = 0; i < 6; i++) {
+        text[n++] = (char)('0' + (fields[i] / 10) % 10);
+        text[n++] = (char)('0' + fields[i] % 10);
+    }
+    text[n++] = 'Z';
+    der_prim(w, utc ? DER_UTC_TIME : DER_GENERALIZED, (const uint8_t *)text, n);
+}
+
+static void der_spki(der_writer_t *w, const uint8_t *pubkey) {
+    size_t spki = der_begin(w, DER_SEQUENCE);
+    size_t algo = der_begin(w, DER_SEQUENCE);
+    der_oid(w, OID_EC_PUBKEY, sizeof(OID_EC_PUBKEY));
+    der_oid(w, OID_PRIME256V1, sizeof(OID_PRIME256V1));
+    der_end(w, algo);
+    der_byte(w, DER_BIT_STRING);
+    der_length(w, MATTER_CERT_PUBKEY_LEN + 1);
+    der_byte(w, 0);     /* No unused bits */
+    der_put(w, pubkey, MATTER_CERT_PUBKEY_LEN);
+    der_end(w, spki);
+}
+
+/* Extension header; the caller fills the OCTET STRING and closes both */
+static void der_ext_begin(der_writer_t *w, uint8_t ce_arc, bool critical,
+                          size_t *ext, size_t *value) {
+    static const uint8_t true_bool[] = { DER_BOOLEAN, 0x01, 0xFF };
+    *ext = der_begin(w, DER_SEQUENCE);
+    der_oid_ce(w, ce_arc);
+    if (critical) der_put(w, true_bool, sizeof(true_bool));
+    *value = der_begin(w, DER_OCTET_STRING);
+}
+
+static void der_ext_end(der_writer_t *w, size_t ext, size_t value) {
+    der_end(w, value);
+    der_end(w, ext);
+}
+
+static int der_basic_constraints(der_writer_t *w, tlv_reader_t *r) {
+    tlv_element_t el;
+    bool is_ca = false;
+    bool has_path_len = false;
+    uint8_t path_len = 0;
+    for (;;) {
+        if (tlv_reader_next(r, &el) != 0) return -1;
+        if (el.type == TLV_TYPE_END_OF_CONTAINER) break;
+        if (el.tag == BC_IS_CA && el.type == TLV_TYPE_BOOL) {
+            is_ca = el.value.boolean;
+        } else if (el.tag == BC_PATH_LEN && el.type == TLV_TYPE_UNSIGNED_INT) {
+            has_path_len = true;
+            path_len = el.value.u8;
+        } else {
+            return -1;
+        }
+    }
+
+    size_t ext, value;
+    der_ext_begin(w, OID_CE_BASIC_CONSTRAINTS, true, &ext, &value);
+    size_t seq = der_begin(w, DER_SEQUENCE);
+    if (is_ca) {
+        /* cA is DEFAULT FALSE, so only TRUE is encoded */
+        static const uint8_t ca_true[] = { DER_BOOLEAN, 0x01, 0xFF };
+        der_put(w, ca_true, sizeof(ca_true));
+    }
+    if (has_path_len) {
+        der_byte(w, DER_INTEGER);
+        if (path_len & 0x80) {
+            der_byte(w, 2);
+            der_byte(w, 0);
+        } else {
+            der_byte(w, 1);
+        }
+        der_byte(w, path_len);
+    }
+    der_end(w, seq);
+    der_ext_end(w, ext, value);
+    return 0;
+}
+
+/* Matter key usage bit n is X.509 KeyUsage bit n (MSB first in DER) */
+static void der_key_usage(der_writer_t *w, uint16_t usage) {
+    uint8_t bits[2] = { 0, 0 };
+    int highest = -1;
+    for (int i = 0; i < 9; i++) {
+        if (usage & (1u << i)) {
+            bits[i / 8] |= (uint8_t)(0x80 >> (i % 8));
+            highest = i;
+        }
+    }
+    size_t n = (highest < 0) ? 0 : (size_t)(highest / 8 + 1);
+
+    size_t ext, value;
+    der_ext_begin(w, OID_CE_KEY_USAGE, true, &ext, &value);
+    der_byte(w, DER_BIT_STRING);
+    der_length(w, n + 1);
+    der_byte(w, (highest < 0) ? 0 : (uint8_t)(7 - highest % 8));
+    der_put(w, bits, n);
+    der_ext_end(w, ext, value);
+}
+
+static int der_ext_key_usage(der_writer_t *w, tlv_reader_t *r) {
+    tlv_element_t el;
+    size_t ext, value;
+    der_ext_begin(w, OID_CE_EXT_KEY_USAGE, true, &ext, &value);
+    size_t seq = der_begin(w, DER_SEQUENCE);
+    for (;;) {
+        if (tlv_reader_next(r, &el) != 0) return -1;
+        if (el.type == TLV_TYPE_END_OF_CONTAINER) break;
+        if (el.type != TLV_TYPE_UNSIGNED_INT
+                || el.value.u8 == 0 || el.value.u8 >= sizeof(KP_ARC)) {
+            return -1;
+        }
+        der_oid_arc(w, OID_KP_PREFIX, sizeof(OID_KP_PREFIX),
+                    KP_ARC[el.value.u8]);
+    }
+    der_end(w, seq);
+    der_ext_end(w, ext, value);
+    return 0;
+}
+
+static void der_key_id(der_writer_t *w, bool authority, const uint8_t *id,
+                       size_t len) {
+    size_t ext, value;
+    der_ext_begin(w, authority ? OID_CE_AUTHORITY_KEY_ID
+                               : OID_CE_SUBJECT_KEY_ID,
+                  false, &ext, &value);
+    if (authority) {
+        /* AuthorityKeyIdentifier ::= SEQUENCE { [0] keyIdentifier } */
+        size_t seq = der_begin(w, DER_SEQUENCE);
+        der_prim(w, 0x80, id, len);
+        der_end(w, seq);
+    } else {
+        der_prim(w, DER_OCTET_STRING, id, len);
+    }
+    der_ext_end(w, ext, value);
+}
+
+/* [3] Extensions: reads the extensions list the reader is positioned in */
+static int der_extensions(der_writer_t *w, tlv_reader_t *r) {
+    tlv_element_t el;
+    size_t explicit3 = der_begin(w, 0xA3);
+    size_t seq = der_begin(w, DER_SEQUENCE);
+    for (;;) {
+        if (tlv_reader_next(r, &el) != 0) return -1;
+        if (el.type == TLV_TYPE_END_OF_CONTAINER) break;
+        if (el.tag_type != TLV_TAG_CONTEXT_SPECIFIC) return -1;
+        int ret = 0;
+        switch (el.tag) {
+        case EXT_BASIC_CONSTRAINTS:
+            ret = (el.type == TLV_TYPE_STRUCTURE)
+                ? der_basic_constraints(w, r) : -1;
+            break;
+        case EXT_KEY_USAGE:
+            if (el.type != TLV_TYPE_UNSIGNED_INT) return -1;
+            der_key_usage(w, el.value.u16);
+            break;
+        case EXT_EXT_KEY_USAGE:
+            ret = (el.type == TLV_TYPE_ARRAY) ? der_ext_key_usage(w, r) : -1;
+            break;
+        case EXT_SUBJECT_KEY_ID:
+        case EXT_AUTHORITY_KEY_ID:
+            if (el.type != TLV_TYPE_BYTE_STRING
+                    || el.value.bytes.length != MATTER_CERT_KEY_ID_LEN) {
+                return -1;
+            }
+            der_key_id(w, el.tag == EXT_AUTHORITY_KEY_ID,
+                       el.value.bytes.data, el.value.bytes.length);
+            break;
+        case EXT_FUTURE:
+            /* Already a DER Extension */
+            if (el.type != TLV_TYPE_BYTE_STRING) return -1;
+            der_put(w, el.value.bytes.data, el.value.bytes.length);
+            break;
+        default:
+            return -1;
+        }
+        if (ret != 0) return -1;
+    }
+    der_end(w, seq);
+    der_end(w, explicit3);
+    return 0;
+}
+
+/* ------------------------------------------------------------------ */
+/* Public API                                                           */
+/* ------------------------------------------------------------------ */
+
+int matter_cert_encode_tbs(const uint8_t *cert, size_t cert_len,
+                           uint8_t *out, size_t out_size, size_t *out_len) {
+    if (!cert || !out || !out_len) return -1;
+
+    der_writer_t w = { .buf = out, .size = out_size };
+    tlv_reader_t r;
+    tlv_element_t el;
+    tlv_reader_init(&r, cert, cert_len);
+    if (tlv_reader_next(&r, &el) != 0 || el.type != TLV_TYPE_STRUCTURE) {
+        return -1;
+    }
+
+    size_t tbs = der_begin(&w, DER_SEQUENCE);
+    der_put(&w, DER_VERSION_V3, sizeof(DER_VERSION_V3));
+
+    /* Fields must appear in tag order; each maps to the next DER field */
+    uint8_t last_tag = 0;
+    size_t validity = 0;
+    size_t spki_fields = 0;
+    const uint8_t *pubkey = NULL;
+    for (;;) {
+        if (tlv_reader_next(&r, &el) != 0) return -1;
+        if (el.type == TLV_TYPE_END_OF_CONTAINER) break;
+        if (el.tag_type != TLV_TAG_CONTEXT_SPECIFIC || el.tag <= last_tag) {
+            return -1;
+        }
+        last_tag = el.tag;
+
+        int ret = 0;
+        switch (el.tag) {
+        case TAG_SERIAL:
+            if (el.type != TLV_TYPE_BYTE_STRING) return -1;
+            der_prim(&w, DER_INTEGER, el.value.bytes.data,
+                     el.value.bytes.length);
+            break;
+        case TAG_SIG_ALGO: {
+            if (el.type != TLV_TYPE_UNSIGNED_INT
+                    || el.value.u8 != SIG_ALGO_ECDSA_SHA256) {
+                return -1;
+            }
+            size_t algo = der_begin(&w, DER_SEQUENCE);
+            der_oid(&w, OID_ECDSA_SHA256, sizeof(OID_ECDSA_SHA256));
+            der_end(&w, algo);
+            break;
+        }
+        case TAG_ISSUER:
+        case TAG_SUBJECT:
+            ret = (el.type == TLV_TYPE_LIST) ? der_dn(&w, &r) : -1;
+            break;
+        case TAG_NOT_BEFORE:
+            if (el.type != TLV_TYPE_UNSIGNED_INT) return -1;
+            validity = der_begin(&w, DER_SEQUENCE);
+            der_time(&w, el.value.u32, false);
+            break;
+        case TAG_NOT_AFTER:
+            if (el.type != TLV_TYPE_UNSIGNED_INT || validity == 0) {
+                return -1;
+            }
+            der_time(&w, el.value.u32, true);
+            der_end(&w, validity);
+            break;
+        case TAG_PUBKEY_ALGO:
+            if (el.type != TLV_TYPE_UNSIGNED_INT
+                    || el.value.u8 != PUBKEY_ALGO_EC) {
+                return -1;
+            }
+            spki_fields++;
+            break;
+        case TAG_CURVE:
+            if (el.type != TLV_TYPE_UNSIGNED_INT
+                    || el.value.u8 != CURVE_PRIME256V1) {
+                return -1;
+            }
+            spki_fields++;
+            break;
+        case TAG_PUBKEY:
+            if (el.type != TLV_TYPE_BYTE_STRING || spki_fields != 2
+                    || el.value.bytes.length != MATTER_CERT_PUBKEY_LEN) {
+                return -1;
+            }
+            pubkey = el.value.bytes.data;
+            der_spki(&w, pubkey);
+            break;
+        case TAG_EXTENSIONS:
+            ret = (el.type == TLV_TYPE_LIST) ? der_extensions(&w, &r) : -1;
+            break;
+        case TAG_SIGNATURE:
+            /* Not part of the TBSCertificate */
+            if (el.type != TLV_TYPE_BYTE_STRING) return -1;
+            break;
+        default:
+            return -1;
+        }
+        if (ret != 0) return -1;
+    }
+    if (!pubkey || last_tag < TAG_NOT_AFTER) return -1;
+
+    der_end(&w, tbs);
+    if (w.overflow) return -1;
+    *out_len = w.len;
+    return 0;
+}
+
+/* Record the span of a DN list's contents and pick out the Matter IDs */
+static int parse_dn(tlv_reader_t *r, const uint8_t **start, size_t *len,
+                    matter_cert_t *out, bool subject) {
+    tlv_element_t el;
+    *start = r->buffer + r->offset;
+    for (;;) {
+        size_t at = r->offset;
+        if (tlv_reader_next(r, &el) != 0) return -1;
+        if (el.type == TLV_TYPE_END_OF_CONTAINER) {
+            *len = at - (size_t)(*start - r->buffer);
+            return 0;
+        }
+        if (el.type == TLV_TYPE_STRUCTURE || el.type == TLV_TYPE_ARRAY
+                || el.type == TLV_TYPE_LIST) {
+            return -1;
+        }
+        if (subject && el.tag_type == TLV_TAG_CONTEXT_SPECIFIC
+                && el.type == TLV_TYPE_UNSIGNED_INT) {
+            if (el.tag == DN_MATTER_NODE_ID) {
+                out->node_id = el.value.u64;
+                out->has_node_id = true;
+            } else if (el.tag == DN_MATTER_FABRIC_ID) {
+                out->fabric_id = el.value.u64;
+                out->has_fabric_id = true;
+            }
+        }
+    }
+}
+
+static int parse_extensions(tlv_reader_t *r, matter_cert_t *out) {
+    tlv_element_t el;
+    for (;;) {
+        if (tlv_reader_next(r, &el) != 0) return -1;
+        if (el.type == TLV_TYPE_END_OF_CONTAINER) return 0;
+        if (el.type == TLV_TYPE_STRUCTURE && el.tag == EXT_BASIC_CONSTRAINTS) {
+            for (;;) {
+                if (tlv_reader_next(r, &el) != 0) return -1;
+                if (el.type == TLV_TYPE_END_OF_CONTAINER) break;
+                if (el.tag == BC_IS_CA && el.type == TLV_TYPE_BOOL) {
+                    out->is_ca = el.value.boolean;
+                }
+            }
+        } else if (el.type == TLV_TYPE_STRUCTURE || el.type == TLV_TYPE_ARRAY
+                || el.type == TLV_TYPE_LIST) {
+            if (tlv_reader_exit_container(r) != 0) return -1;
+        } else if (el.type == TLV_TYPE_BYTE_STRING
+                && el.value.bytes.length == MATTER_CERT_KEY_ID_LEN) {
+            if (el.tag == EXT_SUBJECT_KEY_ID) {
+                out->subject_key_id = el.value.bytes.data;
+            } else if (el.tag == EXT_AUTHORITY_KEY_ID) {
+                out->authority_key_id = el.value.bytes.data;
+            }
+        }
+    }
+}
+
+int matter_cert_parse(const uint8_t *cert, size_t cert_len, matter_cert_t *out) {
+    if (!cert || !out) return -1;
+    memset(out, 0, sizeof(*out));
+
+    tlv_reader_t r;
+    tlv_element_t el;
+    tlv_reader_init(&r, cert, cert_len);
+    if (tlv_reader_next(&r, &el) != 0 || el.type != TLV_TYPE_STRUCTURE) {
+        return -1;
+    }
+
+    bool ecdsa = false;
+    for (;;) {
+        if (tlv_reader_next(&r, &el) != 0) return -1;
+        if (el.type == TLV_TYPE_END_OF_CONTAINER) break;
+        if (el.tag_type != TLV_TAG_CONTEXT_SPECIFIC) return -1;
+
+        int ret = 0;
+        if (el.tag == TAG_ISSUER && el.type == TLV_TYPE_LIST) {
+            ret = parse_dn(&r, &out->issuer, &out->issuer_len, out, false);
+        } else if (el.tag == TAG_SUBJECT && el.type == TLV_TYPE_LIST) {
+            ret = parse_dn(&r, &out->subject, &out->subject_len, out, true);
+        } else if (el.tag == TAG_EXTENSIONS && el.type == TLV_TYPE_LIST) {
+            ret = parse_extensions(&r, out);
+        } else if (el.type == TLV_TYPE_STRUCTURE || el.type == TLV_TYPE_ARRAY
+                || el.type == TLV_TYPE_LIST) {
+            ret = tlv_reader_exit_container(&r);
+        } else if (el.tag == TAG_SIG_ALGO && el.type == TLV_TYPE_UNSIGNED_INT) {
+            ecdsa = (el.value.u8 == SIG_ALGO_ECDSA_SHA256);
+        } else if (el.tag == TAG_PUBKEY && el.type == TLV_TYPE_BYTE_STRING
+                && el.value.bytes.length == MATTER_CERT_PUBKEY_LEN) {
+            out->public_key = el.value.bytes.data;
+        } else if (el.tag == TAG_SIGNATURE && el.type == TLV_TYPE_BYTE_STRING
+                && el.value.bytes.length == MATTER_CERT_SIGNATURE_LEN) {
+            out->signature = el.value.bytes.data;
+        }
+        if (ret != 0) return -1;
+    }
+
+    if (!ecdsa || !out->public_key || !out->signature
+            || !out->issuer || !out->subject) {
+        return -1;
+    }
+    return 0;
+}
+
+bool matter_cert_issued_by(const matter_cert_t *child,
+                           const matter_cert_t *parent) {
+    if (!child || !parent) return false;
+    if (child->issuer_len != parent->subject_len
+            || memcmp(child->issuer, parent->subject, child->issuer_len) != 0) {
+        return false;
+    }
+    if (child->authority_key_id && parent->subject_key_id
+            && memcmp(child->authority_key_id, parent->subject_key_id,
+                      MATTER_CERT_KEY_ID_LEN) != 0) {
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,93 @@
+/*
+ * matter_cert.h
+ * Matter operational certificates (NOC / ICAC / RCAC) in TLV form
+ *
+ * Parses the fields CASE needs to check a peer's certificate chain, and
+ * rebuilds the X.509 DER TBSCertificate that the certificate's signature
+ * covers (Matter spec §6.5): the TLV form drops the DER framing, so a
+ * signature can only be checked against the reconstructed DER.
+ *
+ * Only what Matter operational certificates use is supported: ECDSA with
+ * SHA-256 over P-256 keys, the standard and Matter-specific DN attributes,
+ * and the basic-constraints, key-usage, extended-key-usage, subject and
+ * authority key identifier and future extensions.  Validity dates are
+ * encoded but not checked (no trusted wall clock on the device).
+ *
+ * No crypto here; signatures are verified by the caller.
+ */
+
+#ifndef MATTER_CERT_H
+#define MATTER_CERT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MATTER_CERT_PUBKEY_LEN      65      /* 0x04 || X || Y */
+#define MATTER_CERT_SIGNATURE_LEN   64      /* r || s */
+#define MATTER_CERT_KEY_ID_LEN      20
+
+/* Largest TBSCertificate rebuilt from a CERT_STORE_MAX_CERT_SIZE cert */
+#define MATTER_CERT_MAX_TBS_SIZE    700
+
+/*
+ * Fields of a parsed certificate; pointers refer into the TLV buffer
+ */
+typedef struct {
+    const uint8_t *issuer;          /* Issuer DN list contents */
+    size_t         issuer_len;
+    const uint8_t *subject;         /* Subject DN list contents */
+    size_t         subject_len;
+    const uint8_t *public_key;      /* MATTER_CERT_PUBKEY_LEN bytes */
+    const uint8_t *signature;       /* MATTER_CERT_SIGNATURE_LEN bytes */
+    const uint8_t *subject_key_id;  /* NULL if absent */
+    const uint8_t *authority_key_id;/* NULL if absent */
+    uint64_t       node_id;         /* Subject matter-node-id */
+    uint64_t       fabric_id;       /* Subject matter-fabric-id */
+    bool           has_node_id;
+    bool           has_fabric_id;
+    bool           is_ca;           /* basic-constraints cA */
+} matter_cert_t;
+
+/*
+ * Parse a Matter TLV certificate.
+ *
+ * @param cert     Certificate bytes.
+ * @param cert_len Length of cert.
+ * @param out      Receives the fields.
+ * @return 0 on success, -1 if malformed or not an ECDSA/P-256 certificate.
+ */
+int matter_cert_parse(const uint8_t *cert, size_t cert_len, matter_cert_t *out);
+
+/*
+ * Rebuild the DER TBSCertificate covered by the certificate's signature.
+ *
+ * @param cert     Certificate bytes.
+ * @param cert_len Length of cert.
+ * @param out      Output buffer (MATTER_CERT_MAX_TBS_SIZE is enough).
+ * @param out_size Size of out.
+ * @param out_len  Set to the DER length.
+ * @return 0 on success, -1 if malformed or out is too small.
+ */
+int matter_cert_encode_tbs(const uint8_t *cert, size_t cert_len,
+                           uint8_t *out, size_t out_size, size_t *out_len);
+
+/*
+ * Check that child names parent as its issuer: the issuer DN equals the
+ * parent's subject DN and, when both are present, the authority key ID
+ * equals the parent's subject key ID.  Signatures are not checked.
+ *
+ * @return true if parent is child's issuer.
+ */
+bool matter_cert_issued_by(const matter_cert_t *child,
+                           const matter_cert_t *parent);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MATTER_CERT_H */
@@ -0,0 +1,560 @@
+/*
+ * p256_fixed.c
+ * Fixed-base P-256 scalar multiplication with precomputed comb tables
+ *
+ * Field elements are eight little-endian 32-bit limbs in Montgomery form
+ * (a * 2^256 mod p).  Since p = -1 mod 2^32, the Montgomery reduction
+ * factor is simply the low limb.  Points are Jacobian (X, Y, Z) with
+ * x = X / Z^2, y = Y / Z^3; table points are affine, so every comb step
+ * is one doubling plus one mixed addition per base.
+ *
+ * Comb (Lim-Lee): with T teeth spaced D bits apart, table entry j holds
+ * sum_{bit i of j} 2^(i * D) * B.  Column c of the scalar selects
+ * digit = sum_i bit(k, i * D + c) << i, and
+ *
+ *     R = sum_{c = D-1 .. 0} 2^c * table[digit(c)]
+ *
+ * is evaluated MSB-first with D - 1 doublings.
+ */
+
+#include "p256_fixed.h"
+#include "secure_zero.h"
+#include <string.h>
+
+typedef uint32_t fe_t[8];
+
+typedef struct {
+    fe_t x, y, z;
+} jac_t;
+
+/* p = 2^256 - 2^224 + 2^192 + 2^96 - 1 */
+static const fe_t P256_P = {
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000,
+    0x00000000, 0x00000000, 0x00000001, 0xFFFFFFFF
+};
+
+/* p - 2 (inversion exponent) */
+static const fe_t P256_P_MINUS_2 = {
+    0xFFFFFFFD, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000,
+    0x00000000, 0x00000000, 0x00000001, 0xFFFFFFFF
+};
+
+/* Group order n */
+static const fe_t P256_N = {
+    0xFC632551, 0xF3B9CAC2, 0xA7179E84, 0xBCE6FAAD,
+    0xFFFFFFFF, 0xFFFFFFFF, 0x00000000, 0xFFFFFFFF
+};
+
+/* 2^512 mod p (converts into Montgomery form) */
+static const fe_t P256_R2 = {
+    0x00000003, 0x00000000, 0xFFFFFFFF, 0xFFFFFFFB,
+    0xFFFFFFFE, 0xFFFFFFFF, 0xFFFFFFFD, 0x00000004
+};
+
+/* 1 in Montgomery form (2^256 mod p) */
+static const fe_t P256_ONE = {
+    0x00000001, 0x00000000, 0x00000000, 0xFFFFFFFF,
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFE, 0x00000000
+};
+
+static const fe_t P256_ZERO = {0};
+
+/* Curve coefficient b in Montgomery form */
+static const fe_t P256_B = {
+    0x29C4BDDF, 0xD89CDF62, 0x78843090, 0xACF005CD,
+    0xF7212ED6, 0xE5A220AB, 0x04874834, 0xDC30061D
+};
+
+/* ------------------------------------------------------------------ */
+/* Constant-time helpers                                                */
+/* ------------------------------------------------------------------ */
+
+/**
+ * All ones if a == b, else zero
+ */
+static uint32_t ct_eq(uint32_t a, uint32_t b) {
+    uint32_t d = a ^ b;
+    return ((d | (0u - d)) >> 31) - 1u;
+}
+
+/**
+ * r = mask ? a : b (mask is all ones or zero)
+ */
+static void fe_select(fe_t r, uint32_t mask, const fe_t a, const fe_t b) {
+    for (int i = 0; i < 8; i++) {
+        r[i] = (a[i] & mask) | (b[i] & ~mask);
+    }
+}
+
+/**
+ * r = a - b over 8 limbs, returns the borrow (0 or 1)
+ */
+static uint32_t limbs_sub(fe_t r, const fe_t a, const fe_t b) {
+    uint64_t d = 0;
+    for (int i = 0; i < 8; i++) {
+        d = (uint64_t)a[i] - b[i] - (uint32_t)(d >> 63);
+        r[i] = (uint32_t)d;
+    }
+    return (uint32_t)(d >> 63);
+}
+
+/**
+ * 1 if a == 0, else 0
+ */
+static uint32_t fe_is_zero(const fe_t a) {
+    uint32_t acc = 0;
+    for (int i = 0; i < 8; i++) {
+        acc |= a[i];
+    }
+    return ct_eq(acc, 0) & 1u;
+}
+
+/* ------------------------------------------------------------------ */
+/* Field arithmetic mod p (Montgomery form, inputs and outputs < p)     */
+/* ------------------------------------------------------------------ */
+
+/**
+ * r = (hi:t) - p if that does not underflow, else t; (hi:t) < 2p
+ */
+static void fe_reduce_once(fe_t r, const fe_t t, uint32_t hi) {
+    fe_t s;
+    uint32_t borrow = limbs_sub(s, t, P256_P);
+    fe_select(r, 0u - (hi | (borrow ^ 1u)), s, t);
+}
+
+static void fe_add(fe_t r, const fe_t a, const fe_t b) {
+    fe_t t;
+    uint64_t c = 0;
+    for (int i = 0; i < 8; i++) {
+        c += (uint64_t)a[i] + b[i];
+        t[i] = (uint32_t)c;
+        c >>= 32;
+    }
+    fe_reduce_once(r, t, (uint32_t)c);
+}
+
+static void fe_sub(fe_t r, const fe_t a, const fe_t b) {
+    fe_t t;
+    uint32_t mask = 0u - limbs_sub(t, a, b);
+    uint64_t c = 0;
+    for (int i = 0; i < 8; i++) {
+        c += (uint64_t)t[i] + (P256_P[i] & mask);
+        r[i] = (uint32_t)c;
+        c >>= 32;
+    }
+}
+
+/**
+ * Montgomery multiplication r = a * b / 2^256 mod p (CIOS)
+ */
+static void fe_mul(fe_t r, const fe_t a, const fe_t b) {
+    uint32_t t[10] = {0};
+
+    for (int i = 0; i < 8; i++) {
+        uint64_t c = 0;
+        for (int j = 0; j < 8; j++) {
+            c += (uint64_t)t[j] + (uint64_t)a[j] * b[i];
+            t[j] = (uint32_t)c;
+            c >>= 32;
+        }
+        c += t[8];
+        t[8] = (uint32_t)c;
+        t[9] = (uint32_t)(c >> 32);
+
+        /* m = t[0] * (-p^-1 mod 2^32), and -p^-1 = 1 */
+        uint32_t m = t[0];
+        c = ((uint64_t)t[0] + (uint64_t)m * P256_P[0]) >> 32;
+        for (int j = 1; j < 8; j++) {
+            c += (uint64_t)t[j] + (uint64_t)m * P256_P[j];
+            t[j - 1] = (uint32_t)c;
+            c >>= 32;
+        }
+        c += t[8];
+        t[7] = (uint32_t)c;
+        t[8] = t[9] + (uint32_t)(c >> 32);
+    }
+    fe_reduce_once(r, t, t[8]);
+}
+
+static void fe_sqr(fe_t r, const fe_t a) {
+    fe_mul(r, a, a);
+}
+
+/**
+ * r = a^-1 (Fermat: a^(p-2)); a = 0 gives 0
+ */
+static void fe_inv(fe_t r, const fe_t a) {
+    fe_t acc;
+    memcpy(acc, P256_ONE, sizeof(acc));
+    for (int i = 255; i >= 0; i--) {
+        fe_sqr(acc, acc);
+        if ((P256_P_MINUS_2[i >> 5] >> (i & 31)) & 1u) {    // Public exponent
+            fe_mul(acc, acc, a);
+        }
+    }
+    memcpy(r, acc, sizeof(acc));
+}
+
+static void fe_to_mont(fe_t r, const fe_t a) {
+    fe_mul(r, a, P256_R2);
+}
+
+static void fe_from_mont(fe_t r, const fe_t a) {
+    static const fe_t one = {1, 0, 0, 0, 0, 0, 0, 0};
+    fe_mul(r, a, one);
+}
+
+/**
+ * Big-endian 32 bytes -> limbs
+ */
+static void limbs_from_bytes(fe_t r, const uint8_t *in) {
+    for (int i = 0; i < 8; i++) {
+        const uint8_t *b = in + 28 - 4 * i;
+        r[i] = ((uint32_t)b[0] << 24) | ((uint32_t)b[1] << 16) |
+               ((uint32_t)b[2] << 8) | b[3];
+    }
+}
+
+static void limbs_to_bytes(uint8_t *out, const fe_t a) {
+    for (int i = 0; i < 8; i++) {
+        uint8_t *b = out + 28 - 4 * i;
+        b[0] = (uint8_t)(a[i] >> 24);
+        b[1] = (uint8_t)(a[i] >> 16);
+        b[2] = (uint8_t)(a[i] >> 8);
+        b[3] = (uint8_t)a[i];
+    }
+}
+
+/**
+ * Load a scalar and reduce it mod n (k < 2^256 < 2n, so one subtraction)
+ */
+static void scalar_load(fe_t k, const uint8_t *in) {
+    fe_t s;
+    limbs_from_bytes(k, in);
+    uint32_t borrow = limbs_sub(s, k, P256_N);
+    fe_select(k, borrow - 1u, s, k);
+    secure_zero(s, sizeof(s));
+}
+
+/* ------------------------------------------------------------------ */
+/* Point arithmetic (a = -3)                                            */
+/* ------------------------------------------------------------------ */
+
+/**
+ * r = 2 * p (dbl-2001-b); r may alias p
+ */
+static void point_double(jac_t *r, const jac_t *p) {
+    fe_t delta, gamma, beta, alpha, t0, t1;
+
+    fe_sqr(delta, p->z);
+    fe_sqr(gamma, p->y);
+    fe_mul(beta, p->x, gamma);
+
+    fe_sub(t0, p->x, delta);
+    fe_add(t1, p->x, delta);
+    fe_mul(alpha, t0, t1);
+    fe_add(t0, alpha, alpha);
+    fe_add(alpha, t0, alpha);               // alpha = 3 (X - delta)(X + delta)
+
+    fe_add(t0, p->y, p->z);
+    fe_sqr(t0, t0);
+    fe_sub(t0, t0, gamma);
+    fe_sub(r->z, t0, delta);                // Z3 = (Y + Z)^2 - gamma - delta
+
+    fe_add(beta, beta, beta);
+    fe_add(beta, beta, beta);               // 4 beta
+    fe_sqr(t0, alpha);
+    fe_add(t1, beta, beta);
+    fe_sub(r->x, t0, t1);                   // X3 = alpha^2 - 8 beta
+
+    fe_sub(t0, beta, r->x);
+    fe_mul(t0, alpha, t0);
+    fe_sqr(gamma, gamma);
+    fe_add(gamma, gamma, gamma);
+    fe_add(gamma, gamma, gamma);
+    fe_add(gamma, gamma, gamma);            // 8 gamma^2
+    fe_sub(r->y, t0, gamma);                // Y3 = alpha (4 beta - X3) - 8 gamma^2
+}
+
+/**
+ * r = p + (x2, y2) (madd-2007-bl); r must not alias p.
+ * Sets *h_zero when the x coordinates match (p = +/-(x2, y2)) and
+ * *s_zero when the y coordinates match too (p = (x2, y2)); the formula
+ * does not cover those cases.
+ */
+static void point_add_affine(jac_t *r, const jac_t *p,
+                             const fe_t x2, const fe_t y2,
+                             uint32_t *h_zero, uint32_t *s_zero) {
+    fe_t z1z1, u2, s2, h, hh, i, j, rr, v, t0;
+
+    fe_sqr(z1z1, p->z);
+    fe_mul(u2, x2, z1z1);
+    fe_mul(s2, y2, p->z);
+    fe_mul(s2, s2, z1z1);
+    fe_sub(h, u2, p->x);
+    fe_sqr(hh, h);
+    fe_add(i, hh, hh);
+    fe_add(i, i, i);                        // I = 4 HH
+    fe_mul(j, h, i);
+    fe_sub(rr, s2, p->y);
+    *h_zero = fe_is_zero(h);
+    *s_zero = fe_is_zero(rr);
+    fe_add(rr, rr, rr);                     // r = 2 (S2 - Y1)
+    fe_mul(v, p->x, i);
+
+    fe_sqr(t0, rr);
+    fe_sub(t0, t0, j);
+    fe_sub(t0, t0, v);
+    fe_sub(r->x, t0, v);                    // X3 = r^2 - J - 2V
+
+    fe_sub(t0, v, r->x);
+    fe_mul(t0, rr, t0);
+    fe_mul(u2, p->y, j);
+    fe_add(u2, u2, u2);
+    fe_sub(r->y, t0, u2);                   // Y3 = r (V - X3) - 2 Y1 J
+
+    fe_add(t0, p->z, h);
+    fe_sqr(t0, t0);
+    fe_sub(t0, t0, z1z1);
+    fe_sub(r->z, t0, hh);                   // Z3 = (Z1 + H)^2 - Z1Z1 - HH
+}
+
+/**
+ * r += (x2, y2) if add is set, tracking the point at infinity in *r_inf.
+ * Everything is computed unconditionally and selected with masks; only
+ * the exceptional p = +/-(x2, y2) case (negligible for honest scalars)
+ * branches.
+ */
+static void point_accumulate(jac_t *r, uint32_t *r_inf,
+                             const fe_t x2, const fe_t y2, uint32_t add) {
+    jac_t sum;
+    uint32_t h_zero, s_zero;
+    uint32_t sum_inf = 0;
+
+    point_add_affine(&sum, r, x2, y2, &h_zero, &s_zero);
+    if (h_zero & (*r_inf ^ 1u) & add) {
+        if (s_zero) {
+            point_double(&sum, r);          // r == (x2, y2)
+        } else {
+            sum_inf = 1;                    // r == -(x2, y2)
+        }
+    }
+
+    /* Accumulator still at infinity: the result is the added point */
+    uint32_t inf_mask = 0u - *r_inf;
+    fe_select(sum.x, inf_mask, x2, sum.x);
+    fe_select(sum.y, inf_mask, y2, sum.y);
+    fe_select(sum.z, inf_mask, P256_ONE, sum.z);
+    sum_inf &= ~*r_inf;
+
+    uint32_t add_mask = 0u - add;
+    fe_select(r->x, add_mask, sum.x, r->x);
+    fe_select(r->y, add_mask, sum.y, r->y);
+    fe_select(r->z, add_mask, sum.z, r->z);
+    *r_inf = (sum_inf & add) | (*r_inf & (add ^ 1u));
+}
+
+/**
+ * Read every table entry, keeping the one at index digit (1-based)
+ */
+static void table_select(uint32_t out[16], p256_base_t base, uint32_t digit) {
+    const uint32_t (*table)[16] = p256_comb_tables[base];
+    memset(out, 0, 16 * sizeof(uint32_t));
+    for (uint32_t i = 0; i < P256_COMB_POINTS; i++) {
+        uint32_t mask = ct_eq(i + 1, digit);
+        for (int j = 0; j < 16; j++) {
+            out[j] |= table[i][j] & mask;
+        }
+    }
+}
+
+/**
+ * Comb digit for column c: bit i is scalar bit i * D + c
+ */
+static uint32_t comb_digit(const fe_t k, int c) {
+    uint32_t digit = 0;
+    for (int i = 0; i < P256_COMB_TEETH; i++) {
+        int bit = i * P256_COMB_SPACING + c;
+        if (bit < 256) {                    // Public index
+            digit |= ((k[bit >> 5] >> (bit & 31)) & 1u) << i;
+        }
+    }
+    return digit;
+}
+
+/**
+ * r = sum of k[i] * B[i], all combs sharing one doubling chain
+ */
+static void comb_mul(jac_t *r, uint32_t *r_inf,
+                     const p256_base_t *bases, const fe_t *k, int count) {
+    uint32_t entry[16];
+
+    memset(r, 0, sizeof(*r));
+    *r_inf = 1;
+    for (int c = P256_COMB_SPACING - 1; c >= 0; c--) {
+        if (c != P256_COMB_SPACING - 1) {
+            point_double(r, r);
+        }
+        for (int n = 0; n < count; n++) {
+            uint32_t digit = comb_digit(k[n], c);
+            table_select(entry, bases[n], digit);
+            point_accumulate(r, r_inf, entry, entry + 8,
+                             (ct_eq(digit, 0) & 1u) ^ 1u);
+        }
+    }
+    secure_zero(entry, sizeof(entry));
+}
+
+/**
+ * Encode a Jacobian point as 0x04 || x || y
+ */
+static int point_to_bytes(uint8_t out[P256_POINT_LENGTH],
+                          const jac_t *p, uint32_t inf) {
+    if (inf) {
+        return -1;
+    }
+    fe_t zi, zi2, x, y;
+    fe_inv(zi, p->z);
+    fe_sqr(zi2, zi);
+    fe_mul(x, p->x, zi2);
+    fe_mul(y, p->y, zi2);
+    fe_mul(y, y, zi);
+    fe_from_mont(x, x);
+    fe_from_mont(y, y);
+
+    out[0] = 0x04;
+    limbs_to_bytes(out + 1, x);
+    limbs_to_bytes(out + 33, y);
+    return 0;
+}
+
+/**
+ * Decode 0x04 || x || y into Montgomery form and check it is on the curve
+ */
+static int point_from_bytes(fe_t x, fe_t y, const uint8_t in[P256_POINT_LENGTH]) {
+    fe_t t, lhs, rhs;
+
+    if (in[0] != 0x04) {
+        return -1;
+    }
+    limbs_from_bytes(x, in + 1);
+    limbs_from_bytes(y, in + 33);
+    if (!limbs_sub(t, x, P256_P) || !limbs_sub(t, y, P256_P)) {
+        return -1;                          // Coordinate >= p
+    }
+    fe_to_mont(x, x);
+    fe_to_mont(y, y);
+
+    /* y^2 == x^3 - 3x + b */
+    fe_sqr(lhs, y);
+    fe_sqr(rhs, x);
+    fe_mul(rhs, rhs, x);
+    fe_add(t, x, x);
+    fe_add(t, t, x);
+    fe_sub(rhs, rhs, t);
+    fe_add(rhs, rhs, P256_B);
+    return (memcmp(lhs, rhs, sizeof(lhs)) == 0) ? 0 : -1;
+}
+
+/* ------------------------------------------------------------------ */
+/* Public API                                                           */
+/* ------------------------------------------------------------------ */
+
+int p256_scalar_check(const uint8_t k[P256_SCALAR_LENGTH]) {
+    fe_t v, t;
+    if (!k) {
+        return -1;
+    }
+    limbs_from_bytes(v, k);
+    int ok = limbs_sub(t, v, P256_N) && !fe_is_zero(v);
+    secure_zero(v, sizeof(v));
+    secure_zero(t, sizeof(t));
+    return ok ? 0 : -1;
+}
+
+int p256_fixed_mul(p256_base_t base, const uint8_t k[P256_SCALAR_LENGTH],
+                   uint8_t out[P256_POINT_LENGTH]) {
+    if (base >= P256_BASE_COUNT || !k || !out) {
+        return -1;
+    }
+    fe_t scalar[1];
+    jac_t r;
+    uint32_t inf;
+
+    scalar_load(scalar[0], k);
+    comb_mul(&r, &inf, &base, (const fe_t *)scalar, 1);
+    int ret = point_to_bytes(out, &r, inf);
+
+    secure_zero(scalar, sizeof(scalar));
+    secure_zero(&r, sizeof(r));
+    return ret;
+}
+
+int p256_fixed_muladd(p256_base_t base1, const uint8_t k1[P256_SCALAR_LENGTH],
+                      p256_base_t base2, const uint8_t k2[P256_SCALAR_LENGTH],
+                      uint8_t out[P256_POINT_LENGTH]) {
+    if (base1 >= P256_BASE_COUNT || base2 >= P256_BASE_COUNT ||
+        !k1 || !k2 || !out) {
+        return -1;
+    }
+    const p256_base_t bases[2] = { base1, base2 };
+    fe_t scalars[2];
+    jac_t r;
+    uint32_t inf;
+
+    scalar_load(scalars[0], k1);
+    scalar_load(scalars[1], k2);
+    comb_mul(&r, &inf, bases, (const fe_t *)scalars, 2);
+    int ret = point_to_bytes(out, &r, inf);
+
+    secure_zero(scalars, sizeof(scalars));
+    secure_zero(&r, sizeof(r));
+    return ret;
+}
+
+/**
+ * out = P + k * B, or P - k * B when subtract is set
+ */
+static int point_combine(const uint8_t point[P256_POINT_LENGTH],
+                         p256_base_t base, const uint8_t k[P256_SCALAR_LENGTH],
+                         int subtract, uint8_t out[P256_POINT_LENGTH]) {
+    if (!point || base >= P256_BASE_COUNT || !k || !out) {
+        return -1;
+    }
+    fe_t px, py;
+    if (point_from_bytes(px, py, point) != 0) {
+        return -1;
+    }
+
+    fe_t scalar[1];
+    jac_t r;
+    uint32_t inf;
+
+    /* P - kB = -(kB + (-P)) */
+    scalar_load(scalar[0], k);
+    comb_mul(&r, &inf, &base, (const fe_t *)scalar, 1);
+    if (subtract) {
+        fe_sub(py, P256_ZERO, py);
+    }
+    point_accumulate(&r, &inf, px, py, 1);
+    if (subtract) {
+        fe_sub(r.y, P256_ZERO, r.y);
+    }
+    int ret = point_to_bytes(out, &r, inf);
+
+    secure_zero(scalar, sizeof(scalar));
+    secure_zero(&r, sizeof(r));
+    return ret;
+}
+
+int p256_fixed_add(const uint8_t point[P256_POINT_LENGTH],
+                   p256_base_t base, const uint8_t k[P256_SCALAR_LENGTH],
+                   uint8_t out[P256_POINT_LENGTH]) {
+    return point_combine(point, base, k, 0, out);
+}
+
+int p256_fixed_sub(const uint8_t point[P256_POINT_LENGTH],
+                   p256_base_t base, const uint8_t k[P256_SCALAR_LENGTH],
+                   uint8_t out[P256_POINT_LENGTH]) {
+    return point_combine(point, base, k, 1, out);
+}
@@ -0,0 +1,134 @@
+/*
+ * p256_fixed.h
+ * Fixed-base P-256 scalar multiplication with precomputed comb tables
+ *
+ * PASE (SPAKE2+) and CASE multiply by three points that never change: the
+ * generator G and the SPAKE2+ points M and N.  Instead of going through
+ * generic mbedtls_ecp_mul (which rebuilds its comb table for G in RAM on
+ * every call, since each handshake loads a fresh group, and uses a
+ * sliding window for M and N), this module multiplies using comb tables
+ * generated at build time by tools/gen_p256_comb.py and stored in flash
+ * as const data.
+ *
+ * With T teeth a multiplication is ceil(256 / T) - 1 doublings and
+ * ceil(256 / T) mixed additions, and two fixed-base products share the
+ * doublings.  Field arithmetic is Montgomery-form 8 x 32-bit and
+ * constant-time; table lookups read every entry of the row, so timing and
+ * memory access do not depend on the (secret) scalar.
+ *
+ * Points are passed as 65-byte uncompressed SEC1 encodings (0x04 || X || Y)
+ * and scalars as 32-byte big-endian integers, reduced modulo the group
+ * order n.
+ */
+
+#ifndef P256_FIXED_H
+#define P256_FIXED_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Comb size: 2^T - 1 table points (64 bytes each) per base point.
+ * 6 teeth = 63 points, 4 KB of flash per base, 12 KB in total.
+ * Must match the --teeth passed to tools/gen_p256_comb.py (CMake keeps
+ * both in sync via MATTER_P256_COMB_TEETH).
+ */
+#ifndef P256_COMB_TEETH
+#define P256_COMB_TEETH             6
+#endif
+
+#define P256_COMB_SPACING           ((256 + P256_COMB_TEETH - 1) / P256_COMB_TEETH)
+#define P256_COMB_POINTS            ((1 << P256_COMB_TEETH) - 1)
+
+#define P256_SCALAR_LENGTH          32
+#define P256_POINT_LENGTH           65      // 0x04 || X || Y
+
+/**
+ * Fixed base points with a comb table
+ */
+typedef enum {
+    P256_BASE_G = 0,                // Curve generator
+    P256_BASE_M,                    // SPAKE2+ M
+    P256_BASE_N,                    // SPAKE2+ N
+    P256_BASE_COUNT
+} p256_base_t;
+
+/**
+ * Generated tables (p256_comb_tables.c): affine points in Montgomery
+ * form, x then y, little-endian 32-bit limbs
+ */
+extern const uint32_t p256_comb_tables[P256_BASE_COUNT][P256_COMB_POINTS][16];
+
+/**
+ * Check that a scalar is a valid private key (1 <= k < n)
+ *
+ * @param k Scalar (32 bytes, big-endian)
+ * @return 0 if valid, -1 otherwise
+ */
+int p256_scalar_check(const uint8_t k[P256_SCALAR_LENGTH]);
+
+/**
+ * Compute out = k * B
+ *
+ * @param base Fixed base point
+ * @param k Scalar (32 bytes, big-endian; reduced mod n)
+ * @param out Result point (65 bytes, uncompressed)
+ * @return 0 on success, -1 on invalid params or if the result is the
+ *         point at infinity
+ */
+int p256_fixed_mul(p256_base_t base, const uint8_t k[P256_SCALAR_LENGTH],
+                   uint8_t out[P256_POINT_LENGTH]);
+
+/**
+ * Compute out = k1 * B1 + k2 * B2 (doublings shared between both combs)
+ *
+ * @param base1 First fixed base point
+ * @param k1 First scalar
+ * @param base2 Second fixed base point
+ * @param k2 Second scalar
+ * @param out Result point (65 bytes, uncompressed)
+ * @return 0 on success, -1 on invalid params or if the result is the
+ *         point at infinity
+ */
+int p256_fixed_muladd(p256_base_t base1, const uint8_t k1[P256_SCALAR_LENGTH],
+                      p256_base_t base2, const uint8_t k2[P256_SCALAR_LENGTH],
+                      uint8_t out[P256_POINT_LENGTH]);
+
+/**
+ * Compute out = P + k * B, e.g. pB = (y * G) + w0 * N in SPAKE2+ when
+ * y * G was precomputed
+ *
+ * @param point Point P (65 bytes, uncompressed); must lie on the curve
+ * @param base Fixed base point
+ * @param k Scalar
+ * @param out Result point (65 bytes, uncompressed; may alias point)
+ * @return 0 on success, -1 if P is not a valid curve point, on invalid
+ *         params, or if the result is the point at infinity
+ */
+int p256_fixed_add(const uint8_t point[P256_POINT_LENGTH],
+                   p256_base_t base, const uint8_t k[P256_SCALAR_LENGTH],
+                   uint8_t out[P256_POINT_LENGTH]);
+
+/**
+ * Compute out = P - k * B, e.g. pA - w0 * M in SPAKE2+
+ *
+ * @param point Point P (65 bytes, uncompressed); must lie on the curve
+ * @param base Fixed base point
+ * @param k Scalar
+ * @param out Result point (65 bytes, uncompressed; may alias point)
+ * @return 0 on success, -1 if P is not a valid curve point, on invalid
+ *         params, or if the result is the point at infinity
+ */
+int p256_fixed_sub(const uint8_t point[P256_POINT_LENGTH],
+                   p256_base_t base, const uint8_t k[P256_SCALAR_LENGTH],
+                   uint8_t out[P256_POINT_LENGTH]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* P256_FIXED_H */
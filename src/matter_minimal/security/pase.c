@@ -5,11 +5,16 @@
  */
 
 #include "pase.h"
+#include "p256_fixed.h"
+#include "ephemeral_pool.h"
+#include "pase_verifier.h"
+#include "crypto_stats.h"
 #include <string.h>
 #include <stdio.h>
 
 // mbedTLS headers
 #include "mbedtls/md.h"
+#include "mbedtls/sha256.h"
 #include "mbedtls/pkcs5.h"
 #include "mbedtls/hkdf.h"
 #include "mbedtls/ecp.h"
@@ -23,37 +28,13 @@
 
 /**
  * SPAKE2+ Constants per Matter spec
- * These are the standard Matter M and N points for P-256 curve
- * Defined in Matter Core Specification Section 3.9.1 (SPAKE2+ Parameters)
- * These values MUST match the official Matter specification for interoperability
+ * The Matter M and N points for P-256 (Matter Core Specification Section
+ * 3.9.1, SPAKE2+ Parameters):
+ *   M = 02886e2f97ace46e55ba9dd7242579f2993b64e16ef3dcab95afd497333d8fa12f
+ *   N = 03d8bbd6c639c62937b04d997f38c3770719c629d7014d49a24b4f98baa1292b49
+ * They are only used as fixed bases, through the comb tables generated from
+ * these values by tools/gen_p256_comb.py (P256_BASE_M / P256_BASE_N).
  */
-static const uint8_t SPAKE2_M_P256[65] = {
-    0x04, // Uncompressed point
-    // X coordinate (32 bytes)
-    0x88, 0x6e, 0x2f, 0x97, 0xac, 0xe4, 0x6e, 0x55,
-    0xba, 0x9d, 0xd7, 0x24, 0x25, 0x79, 0xf2, 0x99,
-    0x3b, 0x64, 0xe1, 0x6e, 0xf3, 0xdc, 0xab, 0x95,
-    0xaf, 0xd4, 0x97, 0x33, 0x3d, 0x8f, 0xa1, 0x2f,
-    // Y coordinate (32 bytes)
-    0x5f, 0xf3, 0x55, 0x16, 0x3e, 0x43, 0xce, 0x22,
-    0x4e, 0x0b, 0x0e, 0x65, 0xff, 0x02, 0xac, 0x8e,
-    0x5c, 0x7b, 0xe0, 0x94, 0x19, 0xc7, 0x85, 0xe0,
-    0xca, 0x54, 0x7d, 0x55, 0xa1, 0x2e, 0x2d, 0x20
-};
-
-static const uint8_t SPAKE2_N_P256[65] = {
-    0x04, // Uncompressed point
-    // X coordinate (32 bytes)
-    0xd8, 0xbb, 0xd6, 0xc6, 0x39, 0xc6, 0x29, 0x37,
-    0xb0, 0x4d, 0x99, 0x7f, 0x38, 0xc3, 0x77, 0x07,
-    0x19, 0xc6, 0x29, 0xd7, 0x01, 0x4d, 0x49, 0xa2,
-    0x4b, 0x4f, 0x98, 0xba, 0xa1, 0x29, 0x2b, 0x49,
-    // Y coordinate (32 bytes)
-    0x07, 0xd3, 0x2c, 0x1f, 0xa7, 0xc9, 0xfd, 0xdf,
-    0x7d, 0xa0, 0x2d, 0x5a, 0xf9, 0x6a, 0x91, 0x12,
-    0xf3, 0x6c, 0x4d, 0x17, 0xdc, 0x33, 0x50, 0x12,
-    0xb8, 0x4e, 0x89, 0xfc, 0xe5, 0x44, 0xb6, 0x8e
-};
 
 /**
  * Generate random bytes using Pico's hardware RNG
@@ -101,6 +82,7 @@ static int derive_w0_w1_from_pin(const uint8_t *pin, size_t pin_len,
         return -1;
     }
     
+    uint64_t t0 = crypto_stats_begin();
     ret = mbedtls_pkcs5_pbkdf2_hmac(
         &md_ctx,
         pin, pin_len,
@@ -108,6 +90,7 @@ static int derive_w0_w1_from_pin(const uint8_t *pin, size_t pin_len,
         iterations,
         64, derived
     );
+    crypto_stats_end(CRYPTO_OP_PBKDF2, t0, 0);
     
     mbedtls_md_free(&md_ctx);
     
@@ -134,49 +117,66 @@ static int compute_L(const uint8_t *w1, uint8_t *L) {
         return -1;
     }
     
-    mbedtls_ecp_group grp;
-    mbedtls_ecp_point point_L;
-    mbedtls_mpi scalar_w1;
+    // L = w1 * G via the fixed-base comb table
+    uint64_t t0 = crypto_stats_begin();
+    if (p256_fixed_mul(P256_BASE_G, w1, L) != 0) {
+        printf("PASE: Failed to compute L\n");
+        return -1;
+    }
+    crypto_stats_end(CRYPTO_OP_KEYGEN, t0, 0);
     
-    mbedtls_ecp_group_init(&grp);
-    mbedtls_ecp_point_init(&point_L);
-    mbedtls_mpi_init(&scalar_w1);
+    return 0;
+}
+
+/**
+ * Generation tag of a verifier: SHA-256(salt || iterations || generation),
+ * integers little-endian (see pase_verifier.h)
+ */
+static int verifier_generation_tag(const pase_verifier_t *verifier,
+                                   uint8_t tag[PASE_VERIFIER_TAG_LENGTH]) {
+    uint8_t input[PASE_SALT_LENGTH + 8];
+    uint32_t generation = PASE_PROVISIONING_GENERATION;
     
+    memcpy(input, verifier->salt, PASE_SALT_LENGTH);
+    for (int i = 0; i < 4; i++) {
+        input[PASE_SALT_LENGTH + i] = (uint8_t)(verifier->iterations >> (8 * i));
+        input[PASE_SALT_LENGTH + 4 + i] = (uint8_t)(generation >> (8 * i));
+    }
+    return mbedtls_sha256(input, sizeof(input), tag, 0) == 0 ? 0 : -1;
+}
+
+/**
+ * Derive a new verifier from the PIN: random salt, PBKDF2, L = w1 * G.
+ * w1 is wiped before returning.
+ */
+static int derive_verifier(const char *setup_pin, pase_verifier_t *verifier) {
+    uint8_t w1[32];
     int ret = -1;
     
-    // Load P-256 curve
-    if (mbedtls_ecp_group_load(&grp, MBEDTLS_ECP_DP_SECP256R1) != 0) {
-        printf("PASE: Failed to load P-256 curve\n");
-        goto cleanup;
-    }
+    verifier->iterations = PASE_PBKDF2_ITERATIONS;
     
-    // Load w1 as MPI
-    if (mbedtls_mpi_read_binary(&scalar_w1, w1, 32) != 0) {
-        printf("PASE: Failed to load w1\n");
-        goto cleanup;
+    if (generate_random_bytes(verifier->salt, PASE_SALT_LENGTH) != 0) {
+        printf("PASE: Failed to generate salt\n");
+        goto derive_cleanup;
     }
     
-    // Compute L = w1 * G (generator point)
-    if (mbedtls_ecp_mul(&grp, &point_L, &scalar_w1, &grp.G, NULL, NULL) != 0) {
-        printf("PASE: Failed to compute L\n");
-        goto cleanup;
+    if (derive_w0_w1_from_pin((const uint8_t *)setup_pin, PASE_PIN_LENGTH,
+                              verifier->salt, PASE_SALT_LENGTH,
+                              verifier->iterations,
+                              verifier->w0, w1) != 0) {
+        printf("PASE: Failed to derive w0/w1\n");
+        goto derive_cleanup;
     }
     
-    // Export L as uncompressed point
-    size_t olen;
-    if (mbedtls_ecp_point_write_binary(&grp, &point_L, MBEDTLS_ECP_PF_UNCOMPRESSED,
-                                       &olen, L, PASE_SPAKE2_POINT_LENGTH) != 0) {
-        printf("PASE: Failed to export L\n");
-        goto cleanup;
+    if (compute_L(w1, verifier->L) != 0 ||
+        verifier_generation_tag(verifier, verifier->generation_tag) != 0) {
+        goto derive_cleanup;
     }
     
     ret = 0;
     
-cleanup:
-    mbedtls_ecp_group_free(&grp);
-    mbedtls_ecp_point_free(&point_L);
-    mbedtls_mpi_free(&scalar_w1);
-    
+derive_cleanup:
+    mbedtls_platform_zeroize(w1, sizeof(w1));
     return ret;
 }
 
@@ -203,13 +203,42 @@ int pase_init(pase_context_t *ctx, const char *setup_pin) {
     // Clear context
     memset(ctx, 0, sizeof(pase_context_t));
     
-    // Store PIN
-    memcpy(ctx->setup_pin, setup_pin, PASE_PIN_LENGTH);
-    ctx->setup_pin[PASE_PIN_LENGTH] = '\0';
+    // Load the verifier; derive and store it only if none is stored yet,
+    // or the stored one is from another provisioning generation
+    pase_verifier_t verifier;
+    uint8_t tag[PASE_VERIFIER_TAG_LENGTH];
+    bool loaded = pase_verifier_load(&verifier) == 0;
+    if (loaded && (verifier_generation_tag(&verifier, tag) != 0 ||
+                   memcmp(tag, verifier.generation_tag, sizeof(tag)) != 0)) {
+        printf("PASE: Stored verifier is stale (provisioning generation %u), clearing\n",
+               (unsigned)PASE_PROVISIONING_GENERATION);
+        pase_verifier_clear();
+        loaded = false;
+    }
+    
+    if (loaded) {
+        printf("PASE: Loaded stored verifier\n");
+    } else {
+        printf("PASE: No stored verifier, deriving from PIN (%u iterations)\n",
+               PASE_PBKDF2_ITERATIONS);
+        if (derive_verifier(setup_pin, &verifier) != 0) {
+            mbedtls_platform_zeroize(&verifier, sizeof(verifier));
+            return -1;
+        }
+        if (pase_verifier_store(&verifier) != 0) {
+            // Still usable for this boot; derived again on the next one
+            printf("PASE: WARNING - verifier not persisted\n");
+        }
+    }
+    
+    memcpy(ctx->salt, verifier.salt, PASE_SALT_LENGTH);
+    memcpy(ctx->w0, verifier.w0, sizeof(ctx->w0));
+    memcpy(ctx->L, verifier.L, PASE_SPAKE2_POINT_LENGTH);
+    ctx->pbkdf2_iterations = verifier.iterations;
+    mbedtls_platform_zeroize(&verifier, sizeof(verifier));
     
     // Set initial state
     ctx->state = PASE_STATE_INITIALIZED;
-    ctx->pbkdf2_iterations = PASE_PBKDF2_ITERATIONS;
     
     printf("PASE: Initialized with PIN: ********\n");
     
@@ -229,32 +258,11 @@ int pase_handle_pbkdf_request(pase_context_t *ctx,
         return -1;
     }
     
-    // Generate random salt
-    if (generate_random_bytes(ctx->salt, PASE_SALT_LENGTH) != 0) {
-        printf("PASE: Failed to generate salt\n");
-        ctx->state = PASE_STATE_ERROR;
-        return -1;
-    }
-    
-    // Derive w0 and w1 from PIN
-    if (derive_w0_w1_from_pin((uint8_t*)ctx->setup_pin, PASE_PIN_LENGTH,
-                              ctx->salt, PASE_SALT_LENGTH,
-                              ctx->pbkdf2_iterations,
-                              ctx->w0, ctx->w1) != 0) {
-        printf("PASE: Failed to derive w0/w1\n");
-        ctx->state = PASE_STATE_ERROR;
-        return -1;
-    }
-    
-    // Compute L = w1 * G
-    if (compute_L(ctx->w1, ctx->L) != 0) {
-        printf("PASE: Failed to compute L\n");
-        ctx->state = PASE_STATE_ERROR;
-        return -1;
-    }
+    // Salt, iterations, w0 and L come from the verifier loaded by pase_init
+    // (no PBKDF2 per attempt)
     
     // Encode PBKDFParamResponse as TLV
-    // Simple encoding: [iterations (4), salt (32), L is computed but not sent yet]
+    // Simple encoding: [iterations (4), salt (32)]
     tlv_writer_t writer;
     tlv_writer_init(&writer, response, max_response_len);
     
@@ -301,215 +309,66 @@ int pase_handle_pake1(pase_context_t *ctx,
     
     memcpy(ctx->pA, request, PASE_SPAKE2_POINT_LENGTH);
     
-    // Generate random y (verifier's secret)
+    // Verifier's secret y and y*G, precomputed in idle time
     uint8_t y[32];
-    if (generate_random_bytes(y, 32) != 0) {
+    uint8_t yG[PASE_SPAKE2_POINT_LENGTH];
+    if (ephemeral_pool_take(y, yG) != 0) {
         printf("PASE: Failed to generate y\n");
         ctx->state = PASE_STATE_ERROR;
         return -1;
     }
     
-    // Compute pB = y*G + w0*N
     mbedtls_ecp_group grp;
-    mbedtls_ecp_point point_pB, point_yG, point_N;
-    mbedtls_mpi scalar_y, scalar_w0;
+    mbedtls_ecp_point point_temp, point_Z;
+    mbedtls_mpi scalar_y;
     
     mbedtls_ecp_group_init(&grp);
-    mbedtls_ecp_point_init(&point_pB);
-    mbedtls_ecp_point_init(&point_yG);
-    mbedtls_ecp_point_init(&point_N);
+    mbedtls_ecp_point_init(&point_temp);
+    mbedtls_ecp_point_init(&point_Z);
     mbedtls_mpi_init(&scalar_y);
-    mbedtls_mpi_init(&scalar_w0);
     
     int ret = -1;
+    uint8_t temp[PASE_SPAKE2_POINT_LENGTH];
+    uint64_t t0;
     
-    // Load P-256 curve
-    if (mbedtls_ecp_group_load(&grp, MBEDTLS_ECP_DP_SECP256R1) != 0) {
+    // Compute pB = y*G + w0*N (fixed base N: comb table)
+    t0 = crypto_stats_begin();
+    if (p256_fixed_add(yG, P256_BASE_N, ctx->w0, ctx->pB) != 0) {
         goto pake1_cleanup;
     }
+    crypto_stats_end(CRYPTO_OP_P256_FIXED, t0, 0);
     
-    // Load scalars
-    if (mbedtls_mpi_read_binary(&scalar_y, y, 32) != 0) {
-        goto pake1_cleanup;
-    }
-    if (mbedtls_mpi_read_binary(&scalar_w0, ctx->w0, 32) != 0) {
+    // Compute pA - w0*M (fixed base M; also validates pA is on the curve)
+    t0 = crypto_stats_begin();
+    if (p256_fixed_sub(ctx->pA, P256_BASE_M, ctx->w0, temp) != 0) {
+        printf("PASE: Invalid pA\n");
         goto pake1_cleanup;
     }
+    crypto_stats_end(CRYPTO_OP_P256_FIXED, t0, 0);
     
-    // Load N point
-    if (mbedtls_ecp_point_read_binary(&grp, &point_N, SPAKE2_N_P256, 
-                                      sizeof(SPAKE2_N_P256)) != 0) {
-        goto pake1_cleanup;
-    }
-    
-    // Compute y*G
-    if (mbedtls_ecp_mul(&grp, &point_yG, &scalar_y, &grp.G, NULL, NULL) != 0) {
-        goto pake1_cleanup;
-    }
-    
-    // Compute w0*N
-    mbedtls_ecp_point point_w0N;
-    mbedtls_ecp_point_init(&point_w0N);
-    if (mbedtls_ecp_mul(&grp, &point_w0N, &scalar_w0, &point_N, NULL, NULL) != 0) {
-        mbedtls_ecp_point_free(&point_w0N);
-        goto pake1_cleanup;
-    }
-    
-    // Compute pB = y*G + w0*N
-    if (mbedtls_ecp_muladd(&grp, &point_pB, &scalar_y, &grp.G, 
-                          &scalar_w0, &point_N) != 0) {
-        mbedtls_ecp_point_free(&point_w0N);
-        goto pake1_cleanup;
-    }
-    
-    mbedtls_ecp_point_free(&point_w0N);
-    
-    // Export pB
-    size_t olen;
-    if (mbedtls_ecp_point_write_binary(&grp, &point_pB, MBEDTLS_ECP_PF_UNCOMPRESSED,
-                                       &olen, ctx->pB, PASE_SPAKE2_POINT_LENGTH) != 0) {
-        goto pake1_cleanup;
-    }
-    
-    // Compute Z = y*(pA - w0*M)
-    mbedtls_ecp_point point_pA, point_M, point_w0M, point_neg_w0M, point_temp;
-    mbedtls_ecp_point_init(&point_pA);
-    mbedtls_ecp_point_init(&point_M);
-    mbedtls_ecp_point_init(&point_w0M);
-    mbedtls_ecp_point_init(&point_neg_w0M);
-    mbedtls_ecp_point_init(&point_temp);
-    
-    // Load pA
-    if (mbedtls_ecp_point_read_binary(&grp, &point_pA, ctx->pA, 
-                                      PASE_SPAKE2_POINT_LENGTH) != 0) {
-        mbedtls_ecp_point_free(&point_pA);
-        mbedtls_ecp_point_free(&point_M);
-        mbedtls_ecp_point_free(&point_w0M);
-        mbedtls_ecp_point_free(&point_neg_w0M);
-        mbedtls_ecp_point_free(&point_temp);
-        goto pake1_cleanup;
-    }
-    
-    // Load M
-    if (mbedtls_ecp_point_read_binary(&grp, &point_M, SPAKE2_M_P256, 
-                                      sizeof(SPAKE2_M_P256)) != 0) {
-        mbedtls_ecp_point_free(&point_pA);
-        mbedtls_ecp_point_free(&point_M);
-        mbedtls_ecp_point_free(&point_w0M);
-        mbedtls_ecp_point_free(&point_neg_w0M);
-        mbedtls_ecp_point_free(&point_temp);
-        goto pake1_cleanup;
-    }
-    
-    // Compute w0*M
-    if (mbedtls_ecp_mul(&grp, &point_w0M, &scalar_w0, &point_M, NULL, NULL) != 0) {
-        mbedtls_ecp_point_free(&point_pA);
-        mbedtls_ecp_point_free(&point_M);
-        mbedtls_ecp_point_free(&point_w0M);
-        mbedtls_ecp_point_free(&point_neg_w0M);
-        mbedtls_ecp_point_free(&point_temp);
-        goto pake1_cleanup;
-    }
-    
-    // Compute pA - w0*M (proper elliptic curve point subtraction)
-    // Step 1: Create negated point -w0*M by copying w0*M and negating Y coordinate
-    if (mbedtls_ecp_copy(&point_neg_w0M, &point_w0M) != 0) {
-        mbedtls_ecp_point_free(&point_pA);
-        mbedtls_ecp_point_free(&point_M);
-        mbedtls_ecp_point_free(&point_w0M);
-        mbedtls_ecp_point_free(&point_neg_w0M);
-        mbedtls_ecp_point_free(&point_temp);
-        goto pake1_cleanup;
-    }
-    
-    // Negate Y coordinate: Y_neg = (p - Y) mod p
-    mbedtls_mpi neg_y;
-    mbedtls_mpi_init(&neg_y);
-    
-    // Compute neg_y = grp.P - point_w0M.Y (modular negation on the curve)
-    if (mbedtls_mpi_sub_mpi(&neg_y, &grp.P, &point_w0M.Y) != 0) {
-        mbedtls_ecp_point_free(&point_pA);
-        mbedtls_ecp_point_free(&point_M);
-        mbedtls_ecp_point_free(&point_w0M);
-        mbedtls_ecp_point_free(&point_neg_w0M);
-        mbedtls_ecp_point_free(&point_temp);
-        mbedtls_mpi_free(&neg_y);
-        goto pake1_cleanup;
-    }
-    
-    // Set negated Y coordinate in point_neg_w0M
-    if (mbedtls_mpi_copy(&point_neg_w0M.Y, &neg_y) != 0) {
-        mbedtls_ecp_point_free(&point_pA);
-        mbedtls_ecp_point_free(&point_M);
-        mbedtls_ecp_point_free(&point_w0M);
-        mbedtls_ecp_point_free(&point_neg_w0M);
-        mbedtls_ecp_point_free(&point_temp);
-        mbedtls_mpi_free(&neg_y);
+    // Compute Z = y * (pA - w0*M) (variable base)
+    if (mbedtls_ecp_group_load(&grp, MBEDTLS_ECP_DP_SECP256R1) != 0) {
         goto pake1_cleanup;
     }
-    
-    mbedtls_mpi_free(&neg_y);
-    
-    // Step 2: Add pA + (-w0*M) using proper elliptic curve point addition
-    // mbedtls_ecp_muladd(grp, R, m1, P1, m2, P2) computes R = m1*P1 + m2*P2
-    // With m1=1, P1=point_pA, m2=1, P2=point_neg_w0M, this computes:
-    // point_temp = 1*point_pA + 1*point_neg_w0M = pA + (-w0*M) = pA - w0*M
-    mbedtls_mpi one;
-    mbedtls_mpi_init(&one);
-    if (mbedtls_mpi_lset(&one, 1) != 0) {
-        mbedtls_ecp_point_free(&point_pA);
-        mbedtls_ecp_point_free(&point_M);
-        mbedtls_ecp_point_free(&point_w0M);
-        mbedtls_ecp_point_free(&point_neg_w0M);
-        mbedtls_ecp_point_free(&point_temp);
-        mbedtls_mpi_free(&one);
+    if (mbedtls_mpi_read_binary(&scalar_y, y, 32) != 0) {
         goto pake1_cleanup;
     }
-    
-    if (mbedtls_ecp_muladd(&grp, &point_temp, &one, &point_pA, &one, &point_neg_w0M) != 0) {
-        mbedtls_ecp_point_free(&point_pA);
-        mbedtls_ecp_point_free(&point_M);
-        mbedtls_ecp_point_free(&point_w0M);
-        mbedtls_ecp_point_free(&point_neg_w0M);
-        mbedtls_ecp_point_free(&point_temp);
-        mbedtls_mpi_free(&one);
+    if (mbedtls_ecp_point_read_binary(&grp, &point_temp, temp, sizeof(temp)) != 0) {
         goto pake1_cleanup;
     }
-    
-    mbedtls_mpi_free(&one);
-    
-    // Compute Z = y * (pA - w0*M)
-    mbedtls_ecp_point point_Z;
-    mbedtls_ecp_point_init(&point_Z);
+    t0 = crypto_stats_begin();
     if (mbedtls_ecp_mul(&grp, &point_Z, &scalar_y, &point_temp, NULL, NULL) != 0) {
-        mbedtls_ecp_point_free(&point_pA);
-        mbedtls_ecp_point_free(&point_M);
-        mbedtls_ecp_point_free(&point_w0M);
-        mbedtls_ecp_point_free(&point_neg_w0M);
-        mbedtls_ecp_point_free(&point_temp);
-        mbedtls_ecp_point_free(&point_Z);
         goto pake1_cleanup;
     }
+    crypto_stats_end(CRYPTO_OP_ECDH, t0, 0);
     
     // Export Z
+    size_t olen;
     if (mbedtls_ecp_point_write_binary(&grp, &point_Z, MBEDTLS_ECP_PF_UNCOMPRESSED,
                                        &olen, ctx->Z, PASE_SPAKE2_POINT_LENGTH) != 0) {
-        mbedtls_ecp_point_free(&point_pA);
-        mbedtls_ecp_point_free(&point_M);
-        mbedtls_ecp_point_free(&point_w0M);
-        mbedtls_ecp_point_free(&point_neg_w0M);
-        mbedtls_ecp_point_free(&point_temp);
-        mbedtls_ecp_point_free(&point_Z);
         goto pake1_cleanup;
     }
     
-    mbedtls_ecp_point_free(&point_pA);
-    mbedtls_ecp_point_free(&point_M);
-    mbedtls_ecp_point_free(&point_w0M);
-    mbedtls_ecp_point_free(&point_neg_w0M);
-    mbedtls_ecp_point_free(&point_temp);
-    mbedtls_ecp_point_free(&point_Z);
-    
     // Encode pB in response
     memcpy(response, ctx->pB, PASE_SPAKE2_POINT_LENGTH);
     *actual_response_len = PASE_SPAKE2_POINT_LENGTH;
@@ -522,11 +381,9 @@ pake1_cleanup:
     // Zeroize sensitive data
     mbedtls_platform_zeroize(y, sizeof(y));
     mbedtls_ecp_group_free(&grp);
-    mbedtls_ecp_point_free(&point_pB);
-    mbedtls_ecp_point_free(&point_yG);
-    mbedtls_ecp_point_free(&point_N);
+    mbedtls_ecp_point_free(&point_temp);
+    mbedtls_ecp_point_free(&point_Z);
     mbedtls_mpi_free(&scalar_y);
-    mbedtls_mpi_free(&scalar_w0);
     
     if (ret != 0) {
         ctx->state = PASE_STATE_ERROR;
@@ -600,11 +457,13 @@ int pase_derive_session_key(pase_context_t *ctx, uint8_t session_id,
         return -1;
     }
     
+    uint64_t t0 = crypto_stats_begin();
     int ret = mbedtls_hkdf(md,
                            (const uint8_t*)hkdf_salt, strlen(hkdf_salt),
                            z_x, 32,
                            info, sizeof(info),
                            key_out, key_len);
+    crypto_stats_end(CRYPTO_OP_HKDF, t0, key_len);
     
     if (ret != 0) {
         printf("PASE: HKDF failed: %d\n", ret);
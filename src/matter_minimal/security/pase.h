@@ -46,11 +46,9 @@ typedef enum {
  */
 typedef struct {
     pase_state_t state;             // Current state
-    uint8_t setup_pin[PASE_PIN_LENGTH + 1];  // Setup PIN (8 digits + null terminator)
-    uint8_t salt[PASE_SALT_LENGTH]; // Random salt for PBKDF2
+    uint8_t salt[PASE_SALT_LENGTH]; // PBKDF2 salt (from the stored verifier)
     uint8_t w0[32];                 // PBKDF2 derived key (w0)
-    uint8_t w1[32];                 // PBKDF2 derived key (w1)
-    uint8_t L[PASE_SPAKE2_POINT_LENGTH];  // Verifier point L
+    uint8_t L[PASE_SPAKE2_POINT_LENGTH];  // Verifier point L = w1 * G
     uint8_t pA[PASE_SPAKE2_POINT_LENGTH]; // Prover's public point
     uint8_t pB[PASE_SPAKE2_POINT_LENGTH]; // Verifier's public point
     uint8_t Z[PASE_SPAKE2_POINT_LENGTH];  // Shared secret point
@@ -63,6 +61,9 @@ typedef struct {
 
 /**
  * Initialize PASE protocol with setup PIN
+ * Loads the stored verifier (w0, L, salt, iterations); if none is stored,
+ * derives it from the PIN with PBKDF2 and stores it for later boots.
+ * Neither the PIN nor w1 is kept in the context.
  * 
  * @param ctx PASE context to initialize
  * @param setup_pin 8-digit setup PIN (null-terminated string)
@@ -72,7 +73,7 @@ int pase_init(pase_context_t *ctx, const char *setup_pin);
 
 /**
  * Handle PBKDFParamRequest message
- * Generates salt and sends PBKDFParamResponse
+ * Sends PBKDFParamResponse with the verifier's salt and iterations
  * 
  * @param ctx PASE context
  * @param request Input request buffer
@@ -0,0 +1,107 @@
+/*
+ * pase_verifier.c
+ * Persistent SPAKE2+ verifier (w0, L) for PASE
+ */
+
+#include "pase_verifier.h"
+#include "secure_zero.h"
+#include <string.h>
+#include <stdio.h>
+
+// Storage adapter (LittleFS on Pico W flash)
+extern int storage_adapter_write(const char *key, const uint8_t *value, size_t value_len);
+extern int storage_adapter_read(const char *key, uint8_t *value, size_t max_value_len, size_t *actual_len);
+extern int storage_adapter_delete(const char *key);
+
+#define OFFSET_VERSION      0
+#define OFFSET_ITERATIONS   1
+#define OFFSET_SALT         5
+#define OFFSET_W0           (OFFSET_SALT + PASE_SALT_LENGTH)
+#define OFFSET_L            (OFFSET_W0 + 32)
+#define OFFSET_TAG          (OFFSET_L + PASE_SPAKE2_POINT_LENGTH)
+
+int pase_verifier_load(pase_verifier_t *verifier) {
+    if (!verifier) {
+        return -1;
+    }
+
+    // One spare byte so an oversized record is detected
+    uint8_t record[PASE_VERIFIER_RECORD_LENGTH + 1];
+    size_t len = 0;
+    int ret = -1;
+
+    if (storage_adapter_read(PASE_VERIFIER_PATH, record, sizeof(record), &len) != 0) {
+        return -1;
+    }
+
+    if (len != PASE_VERIFIER_RECORD_LENGTH) {
+        printf("PASE: Stored verifier has bad length %zu\n", len);
+        goto load_cleanup;
+    }
+    if (record[OFFSET_VERSION] != PASE_VERIFIER_VERSION) {
+        printf("PASE: Stored verifier has unknown version %u\n", record[OFFSET_VERSION]);
+        goto load_cleanup;
+    }
+
+    uint32_t iterations = (uint32_t)record[OFFSET_ITERATIONS] |
+                          ((uint32_t)record[OFFSET_ITERATIONS + 1] << 8) |
+                          ((uint32_t)record[OFFSET_ITERATIONS + 2] << 16) |
+                          ((uint32_t)record[OFFSET_ITERATIONS + 3] << 24);
+    if (iterations < PASE_PBKDF2_ITERATIONS_MIN ||
+        iterations > PASE_PBKDF2_ITERATIONS_MAX) {
+        printf("PASE: Stored verifier has bad iteration count %u\n", (unsigned)iterations);
+        goto load_cleanup;
+    }
+    if (record[OFFSET_L] != 0x04) {
+        printf("PASE: Stored verifier has bad L encoding\n");
+        goto load_cleanup;
+    }
+
+    verifier->iterations = iterations;
+    memcpy(verifier->salt, record + OFFSET_SALT, PASE_SALT_LENGTH);
+    memcpy(verifier->w0, record + OFFSET_W0, sizeof(verifier->w0));
+    memcpy(verifier->L, record + OFFSET_L, PASE_SPAKE2_POINT_LENGTH);
+    memcpy(verifier->generation_tag, record + OFFSET_TAG,
+           PASE_VERIFIER_TAG_LENGTH);
+    ret = 0;
+
+load_cleanup:
+    secure_zero(record, sizeof(record));
+    return ret;
+}
+
+int pase_verifier_store(const pase_verifier_t *verifier) {
+    if (!verifier) {
+        return -1;
+    }
+
+    uint8_t record[PASE_VERIFIER_RECORD_LENGTH];
+    record[OFFSET_VERSION] = PASE_VERIFIER_VERSION;
+    record[OFFSET_ITERATIONS] = (uint8_t)(verifier->iterations);
+    record[OFFSET_ITERATIONS + 1] = (uint8_t)(verifier->iterations >> 8);
+    record[OFFSET_ITERATIONS + 2] = (uint8_t)(verifier->iterations >> 16);
+    record[OFFSET_ITERATIONS + 3] = (uint8_t)(verifier->iterations >> 24);
+    memcpy(record + OFFSET_SALT, verifier->salt, PASE_SALT_LENGTH);
+    memcpy(record + OFFSET_W0, verifier->w0, sizeof(verifier->w0));
+    memcpy(record + OFFSET_L, verifier->L, PASE_SPAKE2_POINT_LENGTH);
+    memcpy(record + OFFSET_TAG, verifier->generation_tag,
+           PASE_VERIFIER_TAG_LENGTH);
+
+    int ret = storage_adapter_write(PASE_VERIFIER_PATH, record, sizeof(record));
+    secure_zero(record, sizeof(record));
+
+    if (ret != 0) {
+        printf("PASE: Failed to store verifier\n");
+        return -1;
+    }
+    return 0;
+}
+
+int pase_verifier_clear(void) {
+    // storage_adapter_delete returns 0 even if the file is absent
+    if (storage_adapter_delete(PASE_VERIFIER_PATH) != 0) {
+        printf("PASE: Failed to delete stored verifier\n");
+        return -1;
+    }
+    return 0;
+}
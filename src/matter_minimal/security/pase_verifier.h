@@ -0,0 +1,108 @@
+/*
+ * pase_verifier.h
+ * Persistent SPAKE2+ verifier (w0, L) for PASE
+ *
+ * The PASE verifier only needs w0 and L = w1 * G, both derived from the
+ * setup PIN with PBKDF2-HMAC-SHA256 (PASE_PBKDF2_ITERATIONS rounds), which
+ * takes far longer on the RP2040 than the rest of the handshake.  The
+ * verifier is therefore derived once - by tools/provision_attestation.py
+ * --mac, from the PIN the device derives from its MAC address, or by
+ * pase_init() on first boot - and stored in flash together with its salt
+ * and iteration count.  Later boots load it, and the PIN and w1 are never
+ * kept on the device.
+ *
+ * Each record carries a generation tag, SHA-256(salt || iterations (LE32)
+ * || PASE_PROVISIONING_GENERATION (LE32)), checked by pase_init().  It
+ * catches a corrupted salt or iteration count and a record from another
+ * provisioning generation (bump the generation when the PIN derivation
+ * changes, and the old verifier is cleared and derived again).  It does not
+ * depend on the PIN, so it cannot tell whether w0 and L match the PIN; the
+ * provisioning tool derives the PIN the same way the device does instead.
+ *
+ * Record layout (PASE_VERIFIER_RECORD_LENGTH bytes, must match
+ * tools/provision_attestation.py):
+ *   [0]        version (PASE_VERIFIER_VERSION)
+ *   [1..4]     PBKDF2 iterations (little-endian)
+ *   [5..36]    salt
+ *   [37..68]   w0
+ *   [69..133]  L (uncompressed point)
+ *   [134..165] generation tag
+ */
+
+#ifndef PASE_VERIFIER_H
+#define PASE_VERIFIER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "pase.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * LittleFS path (flat: storage_adapter does not create directories)
+ */
+#ifndef PASE_VERIFIER_PATH
+#define PASE_VERIFIER_PATH          "/pase_verifier"
+#endif
+
+#define PASE_VERIFIER_VERSION       2
+#define PASE_VERIFIER_TAG_LENGTH    32
+#define PASE_VERIFIER_RECORD_LENGTH (1 + 4 + PASE_SALT_LENGTH + 32 + PASE_SPAKE2_POINT_LENGTH + \
+                                     PASE_VERIFIER_TAG_LENGTH)
+
+/**
+ * Provisioning generation, part of the verifier generation tag.  Bump it
+ * (and pass the same --generation to tools/provision_attestation.py)
+ * whenever the setup PIN derivation changes.
+ */
+#ifndef PASE_PROVISIONING_GENERATION
+#define PASE_PROVISIONING_GENERATION 1
+#endif
+
+/**
+ * Iteration bounds accepted from a stored record (Matter spec range)
+ */
+#define PASE_PBKDF2_ITERATIONS_MIN  1000
+#define PASE_PBKDF2_ITERATIONS_MAX  100000
+
+/**
+ * SPAKE2+ verifier
+ */
+typedef struct {
+    uint32_t iterations;                    // PBKDF2 iterations
+    uint8_t salt[PASE_SALT_LENGTH];         // PBKDF2 salt
+    uint8_t w0[32];                         // PBKDF2 derived key (w0)
+    uint8_t L[PASE_SPAKE2_POINT_LENGTH];    // L = w1 * G
+    uint8_t generation_tag[PASE_VERIFIER_TAG_LENGTH]; // See above
+} pase_verifier_t;
+
+/**
+ * Load the stored verifier
+ *
+ * @param verifier Receives the verifier
+ * @return 0 on success, -1 if no valid record is stored
+ */
+int pase_verifier_load(pase_verifier_t *verifier);
+
+/**
+ * Store the verifier
+ *
+ * @param verifier Verifier to store
+ * @return 0 on success, -1 on error
+ */
+int pase_verifier_store(const pase_verifier_t *verifier);
+
+/**
+ * Delete the stored verifier (factory reset, or when the setup PIN changes)
+ *
+ * @return 0 on success (including when nothing is stored), -1 on error
+ */
+int pase_verifier_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PASE_VERIFIER_H
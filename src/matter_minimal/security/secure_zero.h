@@ -0,0 +1,26 @@
+/*
+ * secure_zero.h
+ * Wipe key material in modules that also build without mbedTLS
+ *
+ * aes_ccm, p256_fixed, ephemeral_pool and pase_verifier are host-tested
+ * without mbedTLS, so they cannot use mbedtls_platform_zeroize(); code that
+ * links mbedTLS (pase.c, case.c) uses that instead.
+ */
+
+#ifndef SECURE_ZERO_H
+#define SECURE_ZERO_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * Wipe memory the compiler may not optimise away
+ */
+static inline void secure_zero(void *buf, size_t len) {
+    volatile uint8_t *p = (volatile uint8_t *)buf;
+    while (len--) {
+        *p++ = 0;
+    }
+}
+
+#endif // SECURE_ZERO_H
@@ -4,69 +4,266 @@
  */
 
 #include "session_mgr.h"
+#include "msg_counter.h"
+#include "crypto_stats.h"
 #include <string.h>
 #include <stdio.h>
 
-// mbedTLS headers
-#include "mbedtls/ccm.h"
-#include "mbedtls/platform_util.h"
-
 // Pico SDK
 #include "pico/time.h"
+#include "pico/rand.h"
+
+#if MAX_SESSIONS < 1 || MAX_SESSIONS > 254
+#error "MAX_SESSIONS must be between 1 and 254"
+#endif
+#if MAX_SESSIONS > MSG_COUNTER_UNICAST_SLOTS
+#error "MSG_COUNTER_UNICAST_SLOTS must be at least MAX_SESSIONS"
+#endif
+
+/**
+ * Index size: power of two, at least twice the capacity (load <= 50%)
+ */
+#if MAX_SESSIONS <= 8
+#define SESSION_INDEX_SLOTS     16
+#elif MAX_SESSIONS <= 16
+#define SESSION_INDEX_SLOTS     32
+#elif MAX_SESSIONS <= 32
+#define SESSION_INDEX_SLOTS     64
+#elif MAX_SESSIONS <= 64
+#define SESSION_INDEX_SLOTS     128
+#elif MAX_SESSIONS <= 128
+#define SESSION_INDEX_SLOTS     256
+#else
+#define SESSION_INDEX_SLOTS     512
+#endif
+
+#define SESSION_INDEX_MASK      (SESSION_INDEX_SLOTS - 1)
+#define SLOT_NONE               0xFF
 
 /**
  * Session storage (static allocation)
+ *
+ * Index entries hold slot + 1 (0 = empty); deletion shifts later entries
+ * of the probe run back, so there are no tombstones.  lru_prev/lru_next
+ * link active sessions from most (lru_head) to least (lru_tail) recently
+ * used; lru_next also chains the free slots.
  */
 static session_t sessions[MAX_SESSIONS];
+static uint8_t id_index[SESSION_INDEX_SLOTS];
+static uint8_t node_index[SESSION_INDEX_SLOTS];
+static uint8_t lru_prev[MAX_SESSIONS];
+static uint8_t lru_next[MAX_SESSIONS];
+static uint8_t lru_head = SLOT_NONE;
+static uint8_t lru_tail = SLOT_NONE;
+static uint8_t free_head = SLOT_NONE;
+static session_mgr_stats_t stats;
 static bool session_mgr_initialized = false;
 
 /**
- * Helper function to get current time in seconds
- * Inline to avoid function call overhead
+ * Helper function to get current time in seconds since boot
+ * 64-bit microseconds, so the value does not wrap after 71 minutes
  */
 static inline uint32_t get_current_time_sec(void) {
-    return time_us_32() / 1000000;  // Convert microseconds to seconds
+    return (uint32_t)(time_us_64() / 1000000);
+}
+
+/**
+ * Fibonacci hash; the high bits of the product are the well-mixed ones
+ */
+static inline size_t hash_index(uint32_t key) {
+    return (size_t)((key * 2654435769u) >> 16) & SESSION_INDEX_MASK;
+}
+
+static inline size_t node_key_home(uint64_t node_id) {
+    return hash_index((uint32_t)node_id ^ (uint32_t)(node_id >> 32));
+}
+
+/**
+ * Home position of a slot's key in the given index
+ */
+static size_t index_home(const uint8_t *index, uint8_t slot) {
+    if (index == id_index) {
+        return hash_index(sessions[slot].session_id);
+    }
+    return node_key_home(sessions[slot].peer_node_id);
+}
+
+static void index_insert(uint8_t *index, uint8_t slot) {
+    size_t i = index_home(index, slot);
+    while (index[i] != 0) {
+        i = (i + 1) & SESSION_INDEX_MASK;
+    }
+    index[i] = (uint8_t)(slot + 1);
+}
+
+/**
+ * Remove a slot from an index (its key must still be in place)
+ */
+static void index_remove(uint8_t *index, uint8_t slot) {
+    size_t i = index_home(index, slot);
+    while (index[i] != (uint8_t)(slot + 1)) {
+        if (index[i] == 0) {
+            return;
+        }
+        i = (i + 1) & SESSION_INDEX_MASK;
+    }
+    
+    // Backward-shift: move up entries whose home is not in (i, j]
+    size_t j = i;
+    for (;;) {
+        j = (j + 1) & SESSION_INDEX_MASK;
+        if (index[j] == 0) {
+            break;
+        }
+        size_t home = index_home(index, (uint8_t)(index[j] - 1));
+        if (((j - home) & SESSION_INDEX_MASK) >= ((j - i) & SESSION_INDEX_MASK)) {
+            index[i] = index[j];
+            i = j;
+        }
+    }
+    index[i] = 0;
+}
+
+static void lru_unlink(uint8_t slot) {
+    uint8_t prev = lru_prev[slot];
+    uint8_t next = lru_next[slot];
+    if (prev != SLOT_NONE) {
+        lru_next[prev] = next;
+    } else {
+        lru_head = next;
+    }
+    if (next != SLOT_NONE) {
+        lru_prev[next] = prev;
+    } else {
+        lru_tail = prev;
+    }
+}
+
+static void lru_push_front(uint8_t slot) {
+    lru_prev[slot] = SLOT_NONE;
+    lru_next[slot] = lru_head;
+    if (lru_head != SLOT_NONE) {
+        lru_prev[lru_head] = slot;
+    } else {
+        lru_tail = slot;
+    }
+    lru_head = slot;
+}
+
+static inline uint8_t slot_of(const session_t *session) {
+    return (uint8_t)(session - sessions);
+}
+
+/**
+ * Record use of a session (moves it to the LRU head)
+ * Use times are monotonic, so the LRU tail is the next session to expire.
+ */
+static void session_touch(session_t *session) {
+    uint8_t slot = slot_of(session);
+    session->last_used_time = get_current_time_sec();
+    if (lru_head != slot) {
+        lru_unlink(slot);
+        lru_push_front(slot);
+    }
 }
 
 /**
  * Find session by ID
  */
 static session_t* find_session(uint16_t session_id) {
-    for (int i = 0; i < MAX_SESSIONS; i++) {
-        if (sessions[i].active && sessions[i].session_id == session_id) {
-            return &sessions[i];
+    size_t i = hash_index(session_id);
+    while (id_index[i] != 0) {
+        session_t *session = &sessions[id_index[i] - 1];
+        if (session->session_id == session_id) {
+            return session;
         }
+        i = (i + 1) & SESSION_INDEX_MASK;
     }
     return NULL;
 }
 
 /**
- * Find free session slot
+ * Key a session's CCM contexts (expands the AES key schedules once)
  */
-static session_t* find_free_slot(void) {
-    for (int i = 0; i < MAX_SESSIONS; i++) {
-        if (!sessions[i].active) {
-            return &sessions[i];
-        }
+static int session_set_keys(session_t *session, const uint8_t *tx_key,
+                            const uint8_t *rx_key) {
+    int ret = aes_ccm_setkey(&session->tx_ccm, tx_key, SESSION_KEY_LENGTH);
+    if (ret == 0) {
+        ret = aes_ccm_setkey(&session->rx_ccm, rx_key, SESSION_KEY_LENGTH);
     }
-    return NULL;
+    if (ret != 0) {
+        printf("Session Manager: Failed to set CCM key: %d\n", ret);
+        aes_ccm_free(&session->tx_ccm);
+        aes_ccm_free(&session->rx_ccm);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Wipe a session's key schedules
+ */
+static void session_clear_keys(session_t *session) {
+    aes_ccm_free(&session->tx_ccm);
+    aes_ccm_free(&session->rx_ccm);
+}
+
+/**
+ * Build the message nonce (Matter Core Spec §4.8.1.1)
+ * [security flags (1)] [message counter (4, LE)] [source node ID (8, LE)]
+ */
+static void build_nonce(uint8_t security_flags, uint32_t message_counter,
+                        uint64_t source_node_id, uint8_t *nonce) {
+    nonce[0] = security_flags;
+    for (int i = 0; i < 4; i++) {
+        nonce[1 + i] = (uint8_t)(message_counter >> (8 * i));
+    }
+    for (int i = 0; i < 8; i++) {
+        nonce[5 + i] = (uint8_t)(source_node_id >> (8 * i));
+    }
+}
+
+/**
+ * Release a session's slot: wipe keys, unindex, return it to the free list
+ */
+static void session_release(session_t *session) {
+    uint8_t slot = slot_of(session);
+    
+    session_clear_keys(session);
+    index_remove(id_index, slot);
+    if (session->peer_node_id != 0) {
+        index_remove(node_index, slot);
+    }
+    lru_unlink(slot);
+    
+    session->active = false;
+    lru_next[slot] = free_head;
+    free_head = slot;
+    stats.active--;
+    
+    // Drop the session's replay window
+    msg_counter_reset_session(session->session_id);
 }
 
 /**
- * Generate nonce from session ID and message counter
+ * Take a slot for a new session, evicting the LRU session if it is idle
  */
-static void generate_nonce(uint16_t session_id, uint32_t message_counter, 
-                          uint8_t *nonce) {
-    // Nonce format: [session_id (2 bytes)] [message_counter (4 bytes)] [padding (7 bytes)]
-    nonce[0] = (session_id >> 8) & 0xFF;
-    nonce[1] = session_id & 0xFF;
-    nonce[2] = (message_counter >> 24) & 0xFF;
-    nonce[3] = (message_counter >> 16) & 0xFF;
-    nonce[4] = (message_counter >> 8) & 0xFF;
-    nonce[5] = message_counter & 0xFF;
+static session_t* alloc_slot(void) {
+    if (free_head == SLOT_NONE) {
+        session_t *victim = &sessions[lru_tail];
+        uint32_t idle = get_current_time_sec() - victim->last_used_time;
+        if (idle < SESSION_EVICT_MIN_IDLE_SECONDS) {
+            return NULL;
+        }
+        printf("Session Manager: Evicting session %u (idle %u sec)\n",
+               victim->session_id, idle);
+        session_release(victim);
+        stats.evictions++;
+    }
     
-    // Padding (zero)
-    memset(nonce + 6, 0, 7);
+    uint8_t slot = free_head;
+    free_head = lru_next[slot];
+    return &sessions[slot];
 }
 
 int session_mgr_init(void) {
@@ -77,10 +274,18 @@ int session_mgr_init(void) {
     
     // Clear all sessions
     memset(sessions, 0, sizeof(sessions));
+    memset(id_index, 0, sizeof(id_index));
+    memset(node_index, 0, sizeof(node_index));
+    memset(&stats, 0, sizeof(stats));
+    stats.capacity = MAX_SESSIONS;
     
+    lru_head = SLOT_NONE;
+    lru_tail = SLOT_NONE;
     for (int i = 0; i < MAX_SESSIONS; i++) {
         sessions[i].active = false;
+        lru_next[i] = (i + 1 < MAX_SESSIONS) ? (uint8_t)(i + 1) : SLOT_NONE;
     }
+    free_head = 0;
     
     session_mgr_initialized = true;
     printf("Session Manager: Initialized (max sessions: %d)\n", MAX_SESSIONS);
@@ -89,43 +294,95 @@ int session_mgr_init(void) {
 }
 
 int session_create(uint16_t session_id, const uint8_t *key, size_t key_len) {
+    if (!key || key_len != SESSION_KEY_LENGTH) {
+        printf("Session Manager: Invalid key (len=%zu, expected=%d)\n", 
+               key_len, SESSION_KEY_LENGTH);
+        return -1;
+    }
+    
+    // Symmetric session: same ID and key in both directions
+    session_params_t params = {
+        .local_session_id = session_id,
+        .peer_session_id = session_id,
+        .tx_key = key,
+        .rx_key = key,
+    };
+    return session_create_secure(&params);
+}
+
+int session_create_secure(const session_params_t *params) {
     if (!session_mgr_initialized) {
         printf("Session Manager: Not initialized\n");
         return -1;
     }
     
-    if (!key || key_len != SESSION_KEY_LENGTH) {
-        printf("Session Manager: Invalid key (len=%zu, expected=%d)\n", 
-               key_len, SESSION_KEY_LENGTH);
+    if (!params || !params->tx_key || !params->rx_key) {
+        printf("Session Manager: Invalid session parameters\n");
         return -1;
     }
     
+    uint16_t session_id = params->local_session_id;
+    
     // Check if session already exists
-    session_t *existing = find_session(session_id);
-    if (existing) {
+    session_t *session = find_session(session_id);
+    if (session) {
         printf("Session Manager: Session %u already exists, updating key\n", 
                session_id);
-        memcpy(existing->encryption_key, key, SESSION_KEY_LENGTH);
-        existing->message_counter = 0;
-        existing->last_used_time = get_current_time_sec();
-        return 0;
+        session_clear_keys(session);
+        if (session_set_keys(session, params->tx_key, params->rx_key) != 0) {
+            session_release(session);
+            return -1;
+        }
+        if (session->peer_node_id != 0) {
+            index_remove(node_index, slot_of(session));
+        }
+    } else {
+        // Take a free slot, evicting the least recently used idle session
+        session = alloc_slot();
+        if (!session) {
+            printf("Session Manager: No free slots (max %d reached, none idle)\n",
+                   MAX_SESSIONS);
+            stats.create_failures++;
+            return -1;
+        }
+        if (session_set_keys(session, params->tx_key, params->rx_key) != 0) {
+            uint8_t slot = slot_of(session);
+            lru_next[slot] = free_head;
+            free_head = slot;
+            return -1;
+        }
+        session->session_id = session_id;
+        session->active = true;
+        index_insert(id_index, slot_of(session));
+        lru_push_front(slot_of(session));
+        
+        stats.created++;
+        stats.active++;
+        if (stats.active > stats.high_water) {
+            stats.high_water = stats.active;
+        }
+        printf("Session Manager: Created session %u (peer session %u)\n",
+               session_id, params->peer_session_id);
     }
     
-    // Find free slot
-    session_t *slot = find_free_slot();
-    if (!slot) {
-        printf("Session Manager: No free slots (max %d reached)\n", MAX_SESSIONS);
-        return -1;
+    session->peer_session_id = params->peer_session_id;
+    session->local_node_id = params->local_node_id;
+    session->peer_node_id = params->peer_node_id;
+    session->auth_mode = params->auth_mode;
+    // Spec 4.6.1.1: a new session's counter starts at Crypto.DRBG(28) + 1,
+    // so counters are not predictable or reused across sessions
+    session->message_counter = (get_rand_32() & SESSION_COUNTER_INIT_MASK) + 1;
+    if (session->peer_node_id != 0) {
+        index_insert(node_index, slot_of(session));
     }
+    session_touch(session);
     
-    // Initialize session
-    slot->session_id = session_id;
-    memcpy(slot->encryption_key, key, SESSION_KEY_LENGTH);
-    slot->message_counter = 0;
-    slot->last_used_time = get_current_time_sec();
-    slot->active = true;
+    // Unicast secure session header; no node IDs on the wire
+    matter_header_template_init(&session->tx_header, params->peer_session_id,
+                                MATTER_SEC_FLAG_SESSION_UNICAST, 0, 0);
     
-    printf("Session Manager: Created session %u\n", session_id);
+    // Peer counters of any earlier session with this ID no longer apply
+    msg_counter_reset_session(session_id);
     
     return 0;
 }
@@ -155,36 +412,22 @@ int session_encrypt(uint16_t session_id,
     
     // Generate nonce
     uint8_t nonce[SESSION_NONCE_LENGTH];
-    generate_nonce(session_id, session->message_counter, nonce);
-    
-    // Initialize CCM context
-    mbedtls_ccm_context ccm;
-    mbedtls_ccm_init(&ccm);
-    
-    int ret = mbedtls_ccm_setkey(&ccm, MBEDTLS_CIPHER_ID_AES,
-                                 session->encryption_key, 
-                                 SESSION_KEY_LENGTH * 8);
-    if (ret != 0) {
-        printf("Session Manager: Failed to set CCM key: %d\n", ret);
-        mbedtls_ccm_free(&ccm);
-        return -1;
-    }
+    build_nonce(0, session->message_counter, session->local_node_id, nonce);
     
     // Encrypt: [nonce || ciphertext || tag]
     // First, copy nonce
     memcpy(ciphertext, nonce, SESSION_NONCE_LENGTH);
     
-    // Encrypt and authenticate
-    ret = mbedtls_ccm_encrypt_and_tag(&ccm,
-                                      plaintext_len,
-                                      nonce, SESSION_NONCE_LENGTH,
-                                      NULL, 0,  // No additional data
-                                      plaintext,
-                                      ciphertext + SESSION_NONCE_LENGTH,
-                                      ciphertext + SESSION_NONCE_LENGTH + plaintext_len,
-                                      SESSION_TAG_LENGTH);
-    
-    mbedtls_ccm_free(&ccm);
+    // Encrypt and authenticate with the session's keyed context
+    uint64_t t0 = crypto_stats_begin();
+    int ret = aes_ccm_encrypt(&session->tx_ccm,
+                              nonce, SESSION_NONCE_LENGTH,
+                              NULL, 0,  // No additional data
+                              plaintext, plaintext_len,
+                              ciphertext + SESSION_NONCE_LENGTH,
+                              ciphertext + SESSION_NONCE_LENGTH + plaintext_len,
+                              SESSION_TAG_LENGTH);
+    crypto_stats_end(CRYPTO_OP_CCM_ENCRYPT, t0, plaintext_len);
     
     if (ret != 0) {
         printf("Session Manager: CCM encryption failed: %d\n", ret);
@@ -195,7 +438,7 @@ int session_encrypt(uint16_t session_id,
     
     // Increment message counter
     session->message_counter++;
-    session->last_used_time = get_current_time_sec();
+    session_touch(session);
     
     return 0;
 }
@@ -233,43 +476,154 @@ int session_decrypt(uint16_t session_id,
         return -1;
     }
     
-    // Initialize CCM context
-    mbedtls_ccm_context ccm;
-    mbedtls_ccm_init(&ccm);
+    // Decrypt and verify with the session's keyed context
+    const uint8_t *encrypted_data = ciphertext + SESSION_NONCE_LENGTH;
+    const uint8_t *tag = ciphertext + SESSION_NONCE_LENGTH + encrypted_len;
+    
+    uint64_t t0 = crypto_stats_begin();
+    int ret = aes_ccm_decrypt(&session->rx_ccm,
+                              nonce, SESSION_NONCE_LENGTH,
+                              NULL, 0,  // No additional data
+                              encrypted_data, encrypted_len,
+                              plaintext,
+                              tag, SESSION_TAG_LENGTH);
+    crypto_stats_end(CRYPTO_OP_CCM_DECRYPT, t0, encrypted_len);
     
-    int ret = mbedtls_ccm_setkey(&ccm, MBEDTLS_CIPHER_ID_AES,
-                                 session->encryption_key,
-                                 SESSION_KEY_LENGTH * 8);
+
     if (ret != 0) {
-        printf("Session Manager: Failed to set CCM key: %d\n", ret);
-        mbedtls_ccm_free(&ccm);
+        printf("Session Manager: CCM decryption/auth failed: %d\n", ret);
         return -1;
     }
     
-    // Decrypt and verify
-    const uint8_t *encrypted_data = ciphertext + SESSION_NONCE_LENGTH;
-    const uint8_t *tag = ciphertext + SESSION_NONCE_LENGTH + encrypted_len;
+    *actual_plaintext_len = encrypted_len;
+    
+    // Update last used time
+    session_touch(session);
+    
+    return 0;
+}
+
+int session_encrypt_packet(uint16_t session_id, packet_buffer_t *pb,
+                           matter_message_t *msg) {
+    if (!session_mgr_initialized || !pb || !msg) {
+        return -1;
+    }
+    
+    session_t *session = find_session(session_id);
+    if (!session) {
+        printf("Session Manager: Session %u not found\n", session_id);
+        return -1;
+    }
+    
+    // The MIC goes into the tailroom reserved behind the payload
+    if (pb->start + pb->length + SESSION_TAG_LENGTH > PACKET_BUFFER_SIZE) {
+        printf("Session Manager: No room for MIC\n");
+        return -1;
+    }
+    
+    msg->header.message_counter = session->message_counter;
+    if (packet_buffer_prepend_header(pb, &session->tx_header, msg) != MATTER_MSG_SUCCESS) {
+        return -1;
+    }
+    
+    // Message header is the AAD; exchange header and payload are encrypted
+    uint8_t *aad = packet_buffer_data(pb);
+    size_t aad_len = session->tx_header.header_len;
+    uint8_t *payload = aad + aad_len;
+    size_t payload_len = pb->length - aad_len;
+    
+    uint8_t nonce[SESSION_NONCE_LENGTH];
+    build_nonce(session->tx_header.header.security_flags,
+                session->message_counter, session->local_node_id, nonce);
+    
+    uint64_t t0 = crypto_stats_begin();
+    int ret = aes_ccm_encrypt(&session->tx_ccm,
+                              nonce, SESSION_NONCE_LENGTH,
+                              aad, aad_len,
+                              payload, payload_len, payload,
+                              payload + payload_len, SESSION_TAG_LENGTH);
+    crypto_stats_end(CRYPTO_OP_CCM_ENCRYPT, t0, payload_len);
+    if (ret != 0) {
+        printf("Session Manager: CCM encryption failed: %d\n", ret);
+        return -1;
+    }
+    
+    pb->length += SESSION_TAG_LENGTH;
+    session->message_counter++;
+    session_touch(session);
+    
+    return 0;
+}
+
+int session_decrypt_message(uint8_t *message, matter_message_t *msg) {
+    if (!session_mgr_initialized || !message || !msg || !msg->payload ||
+        msg->payload < message) {
+        return -1;
+    }
+    
+    session_t *session = find_session(msg->header.session_id);
+    if (!session) {
+        printf("Session Manager: Session %u not found\n", msg->header.session_id);
+        return -1;
+    }
+    
+    if (msg->payload_length < SESSION_TAG_LENGTH) {
+        printf("Session Manager: Ciphertext too short\n");
+        return -1;
+    }
     
-    ret = mbedtls_ccm_auth_decrypt(&ccm,
-                                   encrypted_len,
-                                   nonce, SESSION_NONCE_LENGTH,
-                                   NULL, 0,  // No additional data
-                                   encrypted_data,
-                                   plaintext,
-                                   tag, SESSION_TAG_LENGTH);
+    // Header bytes in front of the payload are the AAD
+    size_t aad_len = (size_t)(msg->payload - message);
+    uint8_t *payload = message + aad_len;
+    size_t payload_len = msg->payload_length - SESSION_TAG_LENGTH;
     
-    mbedtls_ccm_free(&ccm);
+    // Source node ID: from the header when present, else the session peer
+    uint64_t source_node_id = (msg->header.flags & MATTER_MSG_FLAG_S) ?
+                              msg->header.source_node_id : session->peer_node_id;
     
+    uint8_t nonce[SESSION_NONCE_LENGTH];
+    build_nonce(msg->header.security_flags, msg->header.message_counter,
+                source_node_id, nonce);
+    
+    uint64_t t0 = crypto_stats_begin();
+    int ret = aes_ccm_decrypt(&session->rx_ccm,
+                              nonce, SESSION_NONCE_LENGTH,
+                              message, aad_len,
+                              payload, payload_len, payload,
+                              payload + payload_len, SESSION_TAG_LENGTH);
+    crypto_stats_end(CRYPTO_OP_CCM_DECRYPT, t0, payload_len);
     if (ret != 0) {
         printf("Session Manager: CCM decryption/auth failed: %d\n", ret);
         return -1;
     }
     
-    *actual_plaintext_len = encrypted_len;
+    msg->payload_length = payload_len;
+    session_touch(session);
     
-    // Update last used time
-    session->last_used_time = get_current_time_sec();
+    return 0;
+}
+
+int session_find_by_peer_node(uint64_t peer_node_id, uint16_t *session_id) {
+    if (!session_mgr_initialized || peer_node_id == 0 || !session_id) {
+        return -1;
+    }
+    
+    // A peer may hold several sessions; prefer the most recently used
+    session_t *best = NULL;
+    size_t i = node_key_home(peer_node_id);
+    while (node_index[i] != 0) {
+        session_t *session = &sessions[node_index[i] - 1];
+        if (session->peer_node_id == peer_node_id &&
+            (!best || (int32_t)(session->last_used_time - best->last_used_time) > 0)) {
+            best = session;
+        }
+        i = (i + 1) & SESSION_INDEX_MASK;
+    }
     
+    if (!best) {
+        return -1;
+    }
+    *session_id = best->session_id;
     return 0;
 }
 
@@ -281,6 +635,20 @@ bool session_is_active(uint16_t session_id) {
     return find_session(session_id) != NULL;
 }
 
+int session_get_auth_mode(uint16_t session_id, uint8_t *auth_mode) {
+    if (!session_mgr_initialized || !auth_mode) {
+        return -1;
+    }
+    
+    session_t *session = find_session(session_id);
+    if (!session) {
+        return -1;
+    }
+    
+    *auth_mode = session->auth_mode;
+    return 0;
+}
+
 int session_destroy(uint16_t session_id) {
     if (!session_mgr_initialized) {
         return -1;
@@ -292,11 +660,8 @@ int session_destroy(uint16_t session_id) {
         return -1;
     }
     
-    // Zeroize sensitive data
-    mbedtls_platform_zeroize(session->encryption_key, SESSION_KEY_LENGTH);
-    
-    // Mark as inactive
-    session->active = false;
+    // Zeroize the key schedules, drop the replay window, free the slot
+    session_release(session);
     
     printf("Session Manager: Destroyed session %u\n", session_id);
     
@@ -310,21 +675,30 @@ int session_cleanup_expired(uint32_t current_time) {
     
     int cleaned = 0;
     
-    for (int i = 0; i < MAX_SESSIONS; i++) {
-        if (sessions[i].active) {
-            uint32_t age = current_time - sessions[i].last_used_time;
-            if (age > SESSION_TIMEOUT_SECONDS) {
-                printf("Session Manager: Cleaning up expired session %u (age=%u sec)\n",
-                       sessions[i].session_id, age);
-                session_destroy(sessions[i].session_id);
-                cleaned++;
-            }
+    // Oldest first: stop at the first session that has not expired
+    while (lru_tail != SLOT_NONE) {
+        session_t *session = &sessions[lru_tail];
+        uint32_t age = current_time - session->last_used_time;
+        if ((int32_t)age <= SESSION_TIMEOUT_SECONDS) {
+            break;
         }
+        printf("Session Manager: Cleaning up expired session %u (age=%u sec)\n",
+               session->session_id, age);
+        session_release(session);
+        stats.expirations++;
+        cleaned++;
     }
     
     return cleaned;
 }
 
+int session_mgr_poll(void) {
+    if (!session_mgr_initialized || lru_tail == SLOT_NONE) {
+        return 0;
+    }
+    return session_cleanup_expired(get_current_time_sec());
+}
+
 uint32_t session_get_message_counter(uint16_t session_id) {
     if (!session_mgr_initialized) {
         return 0;
@@ -343,12 +717,11 @@ int session_get_active_count(void) {
         return 0;
     }
     
-    int count = 0;
-    for (int i = 0; i < MAX_SESSIONS; i++) {
-        if (sessions[i].active) {
-            count++;
-        }
+    return stats.active;
+}
+
+void session_mgr_get_stats(session_mgr_stats_t *out) {
+    if (out) {
+        *out = stats;
     }
-    
-    return count;
 }
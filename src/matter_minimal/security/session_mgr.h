@@ -1,6 +1,18 @@
 /*
  * session_mgr.h
  * Matter session management with AES-128-CCM encryption
+ *
+ * The session table is statically sized (MAX_SESSIONS) and indexed by two
+ * open-addressed hash tables, one keyed by local session ID (every secured
+ * message) and one by peer node ID, so lookups do not scan the table.
+ * Sessions are also kept in least-recently-used order: when the table is
+ * full the least recently used session is evicted if it has been idle for
+ * SESSION_EVICT_MIN_IDLE_SECONDS, and since the LRU tail is always the
+ * session that expires next, session_mgr_poll() only has to look at it.
+ *
+ * RAM is roughly 0.8 KB per session (two expanded AES key schedules plus
+ * the header template); size MAX_SESSIONS for the number of controllers
+ * (hubs, phones, Home Assistant instances) expected at a site.
  */
 
 #ifndef SESSION_MGR_H
@@ -10,30 +22,98 @@
 #include <stddef.h>
 #include <stdbool.h>
 
+#include "aes_ccm.h"
+#include "message_codec.h"
+#include "packet_buffer.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * Session table capacity (override at build time; at most 254)
+ */
+#ifndef MAX_SESSIONS
+#define MAX_SESSIONS                8
+#endif
+
+/**
+ * Minimum idle time before a session may be evicted to make room for a
+ * new one; shorter-idle sessions are assumed to have exchanges in flight
+ */
+#ifndef SESSION_EVICT_MIN_IDLE_SECONDS
+#define SESSION_EVICT_MIN_IDLE_SECONDS  30
+#endif
+
 /**
  * Session Manager Constants
  */
-#define MAX_SESSIONS                5       // Maximum concurrent sessions
 #define SESSION_KEY_LENGTH          16      // AES-128 key length
 #define SESSION_TIMEOUT_SECONDS     3600    // 1 hour timeout
 #define SESSION_NONCE_LENGTH        13      // CCM nonce length
-#define SESSION_TAG_LENGTH          16      // CCM authentication tag length
+#define SESSION_TAG_LENGTH          16      // CCM authentication tag (MIC) length
+#define SESSION_COUNTER_INIT_MASK   0x0FFFFFFF  // Random 28-bit counter start
+
+/**
+ * How a session was established
+ * PASE sessions come from the setup passcode and exist for commissioning;
+ * CASE sessions authenticate an operational node of a fabric.
+ */
+#define SESSION_AUTH_PASE           0
+#define SESSION_AUTH_CASE           1
 
 /**
  * Session Structure
+ * The CCM contexts hold the expanded AES key schedules for the session's
+ * lifetime, so per-message encrypt/decrypt skips key expansion.
+ *
+ * Matter sessions have two IDs: the local one, which the peer puts in the
+ * headers it sends to us (and which sessions are looked up by), and the
+ * peer's, which goes in the headers we send.  Each direction has its own
+ * key (for a CASE responder: I2R to receive, R2I to send).
  */
 typedef struct {
-    uint16_t session_id;                    // Session identifier
-    uint8_t encryption_key[SESSION_KEY_LENGTH];  // AES-128 key
+    uint16_t session_id;                    // Local session ID
+    uint16_t peer_session_id;               // Session ID used in sent headers
+    aes_ccm_ctx_t tx_ccm;                   // Keyed context, messages we send
+    aes_ccm_ctx_t rx_ccm;                   // Keyed context, messages we receive
+    matter_header_template_t tx_header;     // Header template for sent messages
+    uint64_t local_node_id;                 // Nonce source node, sent messages
+    uint64_t peer_node_id;                  // Nonce source node, received messages
     uint32_t message_counter;               // Message counter for nonce generation
-    uint32_t last_used_time;                // Last message time (for timeout)
+    uint32_t last_used_time;                // Last use, seconds since boot
+    uint8_t auth_mode;                      // SESSION_AUTH_*
     bool active;                            // Session is active
 } session_t;
 
+/**
+ * Secure session parameters
+ * Node IDs are the operational node IDs for CASE and 0 (unspecified) for
+ * PASE; they only enter the nonce.
+ */
+typedef struct {
+    uint16_t local_session_id;              // Session ID the peer sends to
+    uint16_t peer_session_id;               // Session ID we send to
+    const uint8_t *tx_key;                  // Encrypts our messages (16 bytes)
+    const uint8_t *rx_key;                  // Decrypts peer messages (16 bytes)
+    uint64_t local_node_id;
+    uint64_t peer_node_id;
+    uint8_t auth_mode;                      // SESSION_AUTH_* (default PASE)
+} session_params_t;
+
+/**
+ * Session table statistics
+ */
+typedef struct {
+    uint16_t capacity;          // MAX_SESSIONS
+    uint16_t active;            // Sessions currently established
+    uint16_t high_water;        // Peak active sessions since init
+    uint32_t created;           // Sessions established
+    uint32_t evictions;         // Idle sessions evicted for new ones
+    uint32_t expirations;       // Sessions removed by the idle timeout
+    uint32_t create_failures;   // Creations refused (table full, none idle)
+} session_mgr_stats_t;
+
 /**
  * Initialize session manager
  * Clears all sessions and prepares for use
@@ -52,9 +132,55 @@ int session_mgr_init(void);
  */
 int session_create(uint16_t session_id, const uint8_t *key, size_t key_len);
 
+/**
+ * Create a secure session with per-direction keys and peer session ID
+ * An existing session with the same local ID is re-keyed.  When the table
+ * is full the least recently used session is evicted, provided it has been
+ * idle for at least SESSION_EVICT_MIN_IDLE_SECONDS.
+ *
+ * @param params Session parameters
+ * @return 0 on success, -1 on error (no idle session to evict or invalid
+ *         params)
+ */
+int session_create_secure(const session_params_t *params);
+
+/**
+ * Encode and encrypt an outgoing message in place
+ *
+ * Assigns the session's next message counter, prepends the message header
+ * (peer session ID) and exchange header in front of the payload already in
+ * pb, encrypts exchange header and payload with the message header as
+ * additional authenticated data, and appends the MIC into the buffer's MIC
+ * reserve.  Nonce: security flags, counter, local node ID (Matter Core
+ * Spec §4.8.1.1).
+ *
+ * @param session_id Local session ID
+ * @param pb Packet buffer holding the plaintext payload
+ * @param msg Message (exchange header fields); header.message_counter is set
+ * @return 0 on success, -1 on error (pb is left holding the payload only
+ *         if header encoding failed)
+ */
+int session_encrypt_packet(uint16_t session_id, packet_buffer_t *pb,
+                           matter_message_t *msg);
+
+/**
+ * Decrypt and authenticate a received secured message in place
+ *
+ * msg must be decoded from message (its payload, ciphertext followed by the
+ * MIC, directly follows the message header, which is the AAD).  On success
+ * payload_length excludes the MIC and the payload is plaintext, starting
+ * with the exchange header.
+ *
+ * @param message Start of the received message (writable)
+ * @param msg Decoded message; header.session_id selects the session
+ * @return 0 on success, -1 on error (including authentication failure)
+ */
+int session_decrypt_message(uint8_t *message, matter_message_t *msg);
+
 /**
  * Encrypt data using session key
- * Uses AES-128-CCM with automatically generated nonce
+ * Uses AES-128-CCM with automatically generated nonce.  Output is
+ * [nonce || ciphertext || tag]; Matter messages use session_encrypt_packet().
  * 
  * @param session_id Session to use for encryption
  * @param plaintext Input plaintext data
@@ -86,6 +212,15 @@ int session_decrypt(uint16_t session_id,
                    uint8_t *plaintext, size_t max_plaintext_len,
                    size_t *actual_plaintext_len);
 
+/**
+ * Find the most recently used session with a peer node
+ *
+ * @param peer_node_id Peer operational node ID (0 never matches)
+ * @param session_id Set to the session's local ID when found
+ * @return 0 if found, -1 otherwise
+ */
+int session_find_by_peer_node(uint64_t peer_node_id, uint16_t *session_id);
+
 /**
  * Check if a session exists and is active
  * 
@@ -94,6 +229,15 @@ int session_decrypt(uint16_t session_id,
  */
 bool session_is_active(uint16_t session_id);
 
+/**
+ * Get how a session was established
+ * 
+ * @param session_id Session to query
+ * @param auth_mode Set to SESSION_AUTH_PASE or SESSION_AUTH_CASE
+ * @return 0 on success, -1 if session not found
+ */
+int session_get_auth_mode(uint16_t session_id, uint8_t *auth_mode);
+
 /**
  * Destroy a session
  * Zeroizes key material and marks session as inactive
@@ -105,13 +249,23 @@ int session_destroy(uint16_t session_id);
 
 /**
  * Clean up expired sessions
- * Removes sessions that have been inactive for more than SESSION_TIMEOUT_SECONDS
+ * Removes sessions that have been inactive for more than SESSION_TIMEOUT_SECONDS.
+ * Only sessions from the LRU tail are examined, so this is O(1) when
+ * nothing has expired.
  * 
- * @param current_time Current time in seconds (e.g., from time_us_32())
+ * @param current_time Current time in seconds since boot
  * @return Number of sessions cleaned up
  */
 int session_cleanup_expired(uint32_t current_time);
 
+/**
+ * Expire idle sessions that are due
+ * Call from the main loop; cheap when nothing is due.
+ *
+ * @return Number of sessions expired
+ */
+int session_mgr_poll(void);
+
 /**
  * Get current message counter for a session
  * Used for replay protection
@@ -128,6 +282,13 @@ uint32_t session_get_message_counter(uint16_t session_id);
  */
 int session_get_active_count(void);
 
+/**
+ * Get session table statistics
+ *
+ * @param stats Filled with current statistics
+ */
+void session_mgr_get_stats(session_mgr_stats_t *stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,343 @@
+/*
+ * exchange_mgr.c
+ * Exchange manager with Message Reliability Protocol (MRP) implementation
+ */
+
+#include "exchange_mgr.h"
+#include "msg_pool.h"
+#include <stdio.h>
+#include <string.h>
+
+static exchange_ctx_t exchanges[EXCHANGE_MAX_CONTEXTS];
+static exchange_transmit_fn transmit_cb = NULL;
+static exchange_ack_fn ack_cb = NULL;
+static exchange_stats_t stats;
+static uint32_t jitter_state = 0x2545F491u;
+
+/**
+ * True once now_ms has reached deadline_ms (wrap-safe)
+ */
+static inline bool time_reached(uint32_t now_ms, uint32_t deadline_ms) {
+    return (int32_t)(now_ms - deadline_ms) >= 0;
+}
+
+/**
+ * xorshift32 for retransmission jitter
+ */
+static uint32_t next_jitter(void) {
+    uint32_t x = jitter_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    jitter_state = x;
+    return x;
+}
+
+/**
+ * MRP backoff (Matter Core Spec §4.12.2.1), integer form:
+ *   t = i * 1.1 * 1.6^max(0, n - THRESHOLD) * (1 + jitter[0, 0.25))
+ *
+ * @param n Transmissions so far minus one
+ */
+static uint32_t backoff_ms(const exchange_ctx_t *ex, uint8_t n, uint32_t now_ms) {
+    bool active = ex->peer_heard &&
+                  (now_ms - ex->last_rx_ms) < MRP_ACTIVE_THRESHOLD_MS;
+    uint32_t t = active ? MRP_ACTIVE_RETRANS_TIMEOUT_MS : MRP_IDLE_RETRANS_TIMEOUT_MS;
+
+    t = t * 11 / 10;
+    for (int k = (int)n - MRP_BACKOFF_THRESHOLD; k > 0; k--) {
+        t = t * 8 / 5;
+    }
+    return t + ((t * (next_jitter() & 0xFF)) >> 10);
+}
+
+static bool peer_matches(const exchange_ctx_t *ex, const char *peer_ip,
+                         uint16_t peer_port) {
+    return ex->peer_port == peer_port &&
+           strncmp(ex->peer_ip, peer_ip, sizeof(ex->peer_ip)) == 0;
+}
+
+/**
+ * Find the context a received message belongs to
+ * The peer's I flag is the opposite of our role on the exchange.  Unsecured
+ * sessions have no session ID to tell peers apart, so the address is used.
+ */
+static exchange_ctx_t *find_exchange(const matter_message_t *msg,
+                                     const char *peer_ip, uint16_t peer_port) {
+    bool we_initiated = (msg->exchange_flags & MATTER_EXCH_FLAG_INITIATOR) == 0;
+
+    for (size_t i = 0; i < EXCHANGE_MAX_CONTEXTS; i++) {
+        exchange_ctx_t *ex = &exchanges[i];
+        if (ex->in_use &&
+            ex->exchange_id == msg->exchange_id &&
+            ex->session_id == msg->header.session_id &&
+            ex->initiator == we_initiated &&
+            (msg->header.session_id != 0 || peer_matches(ex, peer_ip, peer_port))) {
+            return ex;
+        }
+    }
+    return NULL;
+}
+
+static exchange_ctx_t *alloc_exchange(uint16_t exchange_id, uint16_t session_id,
+                                      bool initiator, const char *peer_ip,
+                                      uint16_t peer_port) {
+    for (size_t i = 0; i < EXCHANGE_MAX_CONTEXTS; i++) {
+        exchange_ctx_t *ex = &exchanges[i];
+        if (!ex->in_use) {
+            memset(ex, 0, sizeof(*ex));
+            ex->in_use = true;
+            ex->initiator = initiator;
+            ex->exchange_id = exchange_id;
+            ex->session_id = session_id;
+            strncpy(ex->peer_ip, peer_ip, sizeof(ex->peer_ip) - 1);
+            ex->peer_port = peer_port;
+            stats.active++;
+            return ex;
+        }
+    }
+    printf("Exchange: No free context (max %d)\n", EXCHANGE_MAX_CONTEXTS);
+    return NULL;
+}
+
+/**
+ * Free a closing context once it neither owes nor awaits an ACK
+ */
+static void try_free(exchange_ctx_t *ex) {
+    if (ex->in_use && ex->closing && !ex->ack_pending && !ex->retrans_pb) {
+        ex->in_use = false;
+        stats.active--;
+    }
+}
+
+static void drop_retransmission(exchange_ctx_t *ex) {
+    msg_pool_release(ex->retrans_pb);
+    ex->retrans_pb = NULL;
+}
+
+static void send_standalone_ack(const exchange_ctx_t *ex, uint32_t ack_counter) {
+    if (ack_cb && ack_cb(ex, ack_counter) == 0) {
+        stats.standalone_acks++;
+    }
+}
+
+/**
+ * Acknowledge a message that has no (or no longer a) context
+ */
+static void ack_without_context(const matter_message_t *msg,
+                                const char *peer_ip, uint16_t peer_port) {
+    exchange_ctx_t tmp;
+    memset(&tmp, 0, sizeof(tmp));
+    tmp.initiator = (msg->exchange_flags & MATTER_EXCH_FLAG_INITIATOR) == 0;
+    tmp.exchange_id = msg->exchange_id;
+    tmp.session_id = msg->header.session_id;
+    strncpy(tmp.peer_ip, peer_ip, sizeof(tmp.peer_ip) - 1);
+    tmp.peer_port = peer_port;
+    send_standalone_ack(&tmp, msg->header.message_counter);
+}
+
+void exchange_mgr_init(exchange_transmit_fn transmit, exchange_ack_fn send_ack) {
+    for (size_t i = 0; i < EXCHANGE_MAX_CONTEXTS; i++) {
+        if (exchanges[i].in_use) {
+            drop_retransmission(&exchanges[i]);
+        }
+    }
+    memset(exchanges, 0, sizeof(exchanges));
+    memset(&stats, 0, sizeof(stats));
+    transmit_cb = transmit;
+    ack_cb = send_ack;
+}
+
+int exchange_mgr_on_message(const matter_message_t *msg, bool duplicate,
+                            const char *peer_ip, uint16_t peer_port,
+                            uint32_t now_ms, exchange_ctx_t **ex_out) {
+    if (!msg || !peer_ip || !ex_out) {
+        return EXCHANGE_RX_ERROR;
+    }
+    *ex_out = NULL;
+
+    bool reliable = (msg->exchange_flags & MATTER_EXCH_FLAG_RELIABILITY) != 0;
+    exchange_ctx_t *ex = find_exchange(msg, peer_ip, peer_port);
+
+    if (ex) {
+        ex->last_rx_ms = now_ms;
+        ex->peer_heard = true;
+
+        // Piggybacked or standalone ACK for our outstanding message
+        if ((msg->exchange_flags & MATTER_EXCH_FLAG_ACK) && ex->retrans_pb &&
+            msg->ack_counter == ex->retrans_counter) {
+            drop_retransmission(ex);
+        }
+    }
+
+    if (msg->protocol_id == MATTER_PROTOCOL_SECURE_CHANNEL &&
+        msg->protocol_opcode == MATTER_SC_OPCODE_MRP_STANDALONE_ACK) {
+        if (ex) {
+            try_free(ex);
+        }
+        return EXCHANGE_RX_DROP;
+    }
+
+    // Retransmitted request: re-acknowledge it, never re-run the handler.
+    // The exchange also remembers the last reliable counter, which catches
+    // retransmissions on sessions the replay window cannot key (unsecured
+    // messages without a source node ID).
+    if (ex && reliable && ex->ack_seen &&
+        msg->header.message_counter == ex->ack_counter) {
+        duplicate = true;
+    }
+    if (duplicate) {
+        stats.duplicates++;
+        if (reliable) {
+            if (ex) {
+                if (ex->ack_counter == msg->header.message_counter) {
+                    ex->ack_pending = false;
+                }
+                send_standalone_ack(ex, msg->header.message_counter);
+            } else {
+                ack_without_context(msg, peer_ip, peer_port);
+            }
+        }
+        if (ex) {
+            try_free(ex);
+        }
+        return EXCHANGE_RX_DROP;
+    }
+
+    if (!ex) {
+        // Only the peer can open an exchange with an inbound message
+        if (!(msg->exchange_flags & MATTER_EXCH_FLAG_INITIATOR)) {
+            if (reliable) {
+                ack_without_context(msg, peer_ip, peer_port);
+            }
+            return EXCHANGE_RX_DROP;
+        }
+        ex = alloc_exchange(msg->exchange_id, msg->header.session_id, false,
+                            peer_ip, peer_port);
+        if (!ex) {
+            return EXCHANGE_RX_ERROR;
+        }
+        ex->last_rx_ms = now_ms;
+        ex->peer_heard = true;
+    }
+
+    ex->closing = false;
+
+    if (reliable) {
+        // A newer reliable message supersedes an ACK still owed
+        if (ex->ack_pending && ex->ack_counter != msg->header.message_counter) {
+            send_standalone_ack(ex, ex->ack_counter);
+        }
+        ex->ack_pending = true;
+        ex->ack_seen = true;
+        ex->ack_counter = msg->header.message_counter;
+        ex->ack_deadline_ms = now_ms + MRP_STANDALONE_ACK_TIMEOUT_MS;
+    }
+
+    *ex_out = ex;
+    return EXCHANGE_RX_DELIVER;
+}
+
+exchange_ctx_t *exchange_mgr_open(uint16_t session_id,
+                                  const char *peer_ip, uint16_t peer_port) {
+    if (!peer_ip) {
+        return NULL;
+    }
+    return alloc_exchange(matter_message_get_next_exchange_id(), session_id,
+                          true, peer_ip, peer_port);
+}
+
+void exchange_mgr_prepare(exchange_ctx_t *ex, matter_message_t *msg,
+                          bool reliable) {
+    if (!ex || !msg) {
+        return;
+    }
+
+    msg->exchange_id = ex->exchange_id;
+    msg->exchange_flags = ex->initiator ? MATTER_EXCH_FLAG_INITIATOR : 0;
+    msg->ack_counter = 0;
+
+    if (ex->ack_pending) {
+        msg->exchange_flags |= MATTER_EXCH_FLAG_ACK;
+        msg->ack_counter = ex->ack_counter;
+    }
+    if (reliable) {
+        msg->exchange_flags |= MATTER_EXCH_FLAG_RELIABILITY;
+    }
+}
+
+void exchange_mgr_sent(exchange_ctx_t *ex, const matter_message_t *msg,
+                       packet_buffer_t *pb, uint32_t now_ms) {
+    if (!ex || !msg) {
+        return;
+    }
+
+    if ((msg->exchange_flags & MATTER_EXCH_FLAG_ACK) && ex->ack_pending &&
+        msg->ack_counter == ex->ack_counter) {
+        ex->ack_pending = false;
+        stats.piggybacked_acks++;
+    }
+
+    if ((msg->exchange_flags & MATTER_EXCH_FLAG_RELIABILITY) && pb) {
+        // One outstanding reliable message per exchange
+        drop_retransmission(ex);
+        ex->retrans_pb = msg_pool_retain(pb);
+        ex->retrans_counter = msg->header.message_counter;
+        ex->send_count = 1;
+        ex->retrans_due_ms = now_ms + backoff_ms(ex, 0, now_ms);
+    }
+}
+
+void exchange_mgr_close(exchange_ctx_t *ex) {
+    if (!ex || !ex->in_use) {
+        return;
+    }
+    ex->closing = true;
+    try_free(ex);
+}
+
+int exchange_mgr_poll(uint32_t now_ms) {
+    int sent = 0;
+
+    for (size_t i = 0; i < EXCHANGE_MAX_CONTEXTS; i++) {
+        exchange_ctx_t *ex = &exchanges[i];
+        if (!ex->in_use) {
+            continue;
+        }
+
+        if (ex->retrans_pb && time_reached(now_ms, ex->retrans_due_ms)) {
+            if (ex->send_count >= MRP_MAX_TRANSMISSIONS) {
+                printf("Exchange: No ACK for counter %lu on exchange %u after %d "
+                       "transmissions, closing\n",
+                       (unsigned long)ex->retrans_counter, ex->exchange_id,
+                       MRP_MAX_TRANSMISSIONS);
+                drop_retransmission(ex);
+                ex->closing = true;
+                stats.delivery_failures++;
+            } else {
+                if (transmit_cb && transmit_cb(ex, ex->retrans_pb) == 0) {
+                    sent++;
+                }
+                stats.retransmissions++;
+                ex->retrans_due_ms = now_ms + backoff_ms(ex, ex->send_count, now_ms);
+                ex->send_count++;
+            }
+        }
+
+        if (ex->ack_pending && time_reached(now_ms, ex->ack_deadline_ms)) {
+            ex->ack_pending = false;
+            send_standalone_ack(ex, ex->ack_counter);
+            sent++;
+        }
+
+        try_free(ex);
+    }
+
+    return sent;
+}
+
+void exchange_mgr_get_stats(exchange_stats_t *out) {
+    if (out) {
+        *out = stats;
+    }
+}
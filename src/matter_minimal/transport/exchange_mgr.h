@@ -0,0 +1,203 @@
+/*
+ * exchange_mgr.h
+ * Exchange manager with Message Reliability Protocol (MRP)
+ * Per Matter Core Specification Sections 4.10 (exchanges) and 4.12 (MRP)
+ *
+ * Tracks one context per active exchange so that:
+ *   - A reliable (R flag) request is acknowledged exactly once, piggybacked
+ *     on the response when the handler answers within the standalone-ACK
+ *     timeout, or with a standalone ACK otherwise.
+ *   - A retransmitted request is recognised as a duplicate and only
+ *     re-acknowledged; the handler does not run again.
+ *   - Reliable messages we send are kept (by message pool reference) and
+ *     retransmitted with exponential backoff until acknowledged or until
+ *     MRP_MAX_TRANSMISSIONS is reached.
+ *
+ * MRP only applies to UDP; BLE (BTP) is already reliable and bypasses this
+ * module.  Timers are driven by exchange_mgr_poll() from the main loop.
+ */
+
+#ifndef EXCHANGE_MGR_H
+#define EXCHANGE_MGR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "message_codec.h"
+#include "packet_buffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Configuration
+ */
+#ifndef EXCHANGE_MAX_CONTEXTS
+#define EXCHANGE_MAX_CONTEXTS               8
+#endif
+
+#define EXCHANGE_PEER_ADDR_LEN              40      // IPv6 string + NUL
+
+/**
+ * MRP parameters (Matter Core Spec §4.12.8, default values)
+ */
+#define MRP_MAX_TRANSMISSIONS               5       // Initial send + 4 retries
+#define MRP_IDLE_RETRANS_TIMEOUT_MS         500     // SESSION_IDLE_INTERVAL
+#define MRP_ACTIVE_RETRANS_TIMEOUT_MS       300     // SESSION_ACTIVE_INTERVAL
+#define MRP_ACTIVE_THRESHOLD_MS             4000    // Peer active if heard within
+#define MRP_STANDALONE_ACK_TIMEOUT_MS       200
+#define MRP_BACKOFF_THRESHOLD               1       // Sends before backoff grows
+
+/**
+ * exchange_mgr_on_message() results
+ */
+#define EXCHANGE_RX_DELIVER                 0       // Route to handler
+#define EXCHANGE_RX_DROP                    1       // Consumed (ACK/duplicate)
+#define EXCHANGE_RX_ERROR                   -1      // No free context
+
+/**
+ * Exchange context
+ */
+typedef struct {
+    bool in_use;
+    bool initiator;                         // We initiated the exchange
+    bool closing;                           // Free once ACKs are settled
+    uint16_t exchange_id;
+    uint16_t session_id;
+    char peer_ip[EXCHANGE_PEER_ADDR_LEN];
+    uint16_t peer_port;
+    uint32_t last_rx_ms;                    // Last message from the peer
+    bool peer_heard;                        // last_rx_ms is valid
+
+    // Received reliable message still to be acknowledged
+    bool ack_pending;
+    bool ack_seen;                          // ack_counter holds a counter
+    uint32_t ack_counter;
+    uint32_t ack_deadline_ms;
+
+    // Reliable message sent and not yet acknowledged
+    packet_buffer_t *retrans_pb;            // Pool reference, encoded bytes
+    uint32_t retrans_counter;
+    uint32_t retrans_due_ms;
+    uint8_t send_count;
+} exchange_ctx_t;
+
+/**
+ * Transmit encoded bytes for an exchange (retransmissions)
+ * Must not consume the caller's reference to pb.
+ */
+typedef int (*exchange_transmit_fn)(const exchange_ctx_t *ex,
+                                    const packet_buffer_t *pb);
+
+/**
+ * Send a standalone ACK for ack_counter on an exchange
+ */
+typedef int (*exchange_ack_fn)(const exchange_ctx_t *ex, uint32_t ack_counter);
+
+/**
+ * Exchange manager statistics
+ */
+typedef struct {
+    uint32_t retransmissions;               // Reliable messages re-sent
+    uint32_t delivery_failures;             // Gave up after max transmissions
+    uint32_t piggybacked_acks;              // ACKs carried on responses
+    uint32_t standalone_acks;               // Standalone ACK messages sent
+    uint32_t duplicates;                    // Retransmitted requests absorbed
+    uint16_t active;                        // Contexts in use
+} exchange_stats_t;
+
+/**
+ * Initialize exchange manager
+ * Releases any retained messages and clears all contexts.
+ *
+ * @param transmit Retransmission callback
+ * @param send_ack Standalone ACK callback
+ */
+void exchange_mgr_init(exchange_transmit_fn transmit, exchange_ack_fn send_ack);
+
+/**
+ * Process the exchange layer of a received (decoded, decrypted) message
+ *
+ * Consumes piggybacked and standalone ACKs, schedules an ACK for reliable
+ * messages, and absorbs duplicates (re-acknowledging them if reliable).
+ *
+ * @param msg Received message (exchange header fields populated)
+ * @param duplicate Message counter was already seen (replay check)
+ * @param peer_ip Source address
+ * @param peer_port Source port
+ * @param now_ms Current time in milliseconds
+ * @param ex Set to the exchange context when EXCHANGE_RX_DELIVER
+ * @return EXCHANGE_RX_DELIVER, EXCHANGE_RX_DROP or EXCHANGE_RX_ERROR
+ */
+int exchange_mgr_on_message(const matter_message_t *msg, bool duplicate,
+                            const char *peer_ip, uint16_t peer_port,
+                            uint32_t now_ms, exchange_ctx_t **ex);
+
+/**
+ * Open a new exchange initiated by us
+ *
+ * @param session_id Session to send on
+ * @param peer_ip Destination address
+ * @param peer_port Destination port
+ * @return Exchange context, or NULL if none is free
+ */
+exchange_ctx_t *exchange_mgr_open(uint16_t session_id,
+                                  const char *peer_ip, uint16_t peer_port);
+
+/**
+ * Fill the exchange header of an outgoing message
+ *
+ * Sets exchange_id and the I flag, piggybacks a pending ACK (A flag and
+ * ack_counter) and sets the R flag when reliable.
+ *
+ * @param ex Exchange context
+ * @param msg Outgoing message
+ * @param reliable Request acknowledgement (retransmit until ACKed)
+ */
+void exchange_mgr_prepare(exchange_ctx_t *ex, matter_message_t *msg,
+                          bool reliable);
+
+/**
+ * Record that an outgoing message was transmitted
+ *
+ * Call after the first transmission of a message prepared with
+ * exchange_mgr_prepare().  Reliable messages keep a reference to pb for
+ * retransmission.
+ *
+ * @param ex Exchange context
+ * @param msg Message as sent (header counter, exchange flags)
+ * @param pb Encoded message (retained if reliable)
+ * @param now_ms Current time in milliseconds
+ */
+void exchange_mgr_sent(exchange_ctx_t *ex, const matter_message_t *msg,
+                       packet_buffer_t *pb, uint32_t now_ms);
+
+/**
+ * Mark an exchange as finished by its handler
+ * The context is freed as soon as no ACK is owed and none is awaited.
+ *
+ * @param ex Exchange context (NULL is ignored)
+ */
+void exchange_mgr_close(exchange_ctx_t *ex);
+
+/**
+ * Drive MRP timers: retransmissions and standalone ACKs
+ *
+ * @param now_ms Current time in milliseconds
+ * @return Number of messages sent
+ */
+int exchange_mgr_poll(uint32_t now_ms);
+
+/**
+ * Get exchange manager statistics
+ *
+ * @param stats Output statistics
+ */
+void exchange_mgr_get_stats(exchange_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // EXCHANGE_MGR_H
@@ -5,6 +5,7 @@
  */
 
 #include "udp_transport.h"
+#include "msg_pool.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -16,12 +17,11 @@
 
 /**
  * Receive Queue Entry
+ * Packet data lives in a message pool block (NULL = entry free).
  */
 typedef struct {
-    uint8_t data[MATTER_TRANSPORT_MAX_PACKET];
-    size_t length;
+    packet_buffer_t *pb;
     matter_transport_addr_t source_addr;
-    bool in_use;
 } rx_queue_entry_t;
 
 /**
@@ -120,14 +120,25 @@ static void udp_recv_callback(void *arg, struct udp_pcb *pcb, struct pbuf *p,
         return;
     }
     
-    // Copy packet data
-    entry->length = p->tot_len;
-    pbuf_copy_partial(p, entry->data, p->tot_len, 0);
+    // Keep enough pool blocks free to decrypt and answer what is queued
+    packet_buffer_t *pb = NULL;
+    if (msg_pool_available() > MATTER_TRANSPORT_RX_POOL_RESERVE) {
+        pb = msg_pool_alloc();
+    }
+    if (pb == NULL) {
+        printf("UDP transport: Message pool low, dropping packet\n");
+        pbuf_free(p);
+        return;
+    }
+    
+    // Copy packet data (the only copy on the receive path)
+    packet_buffer_reset_rx(pb);
+    pb->length = pbuf_copy_partial(p, pb->data, p->tot_len, 0);
     
     // Store source address
     lwip_addr_to_transport_addr(addr, port, &entry->source_addr);
     
-    entry->in_use = true;
+    entry->pb = pb;
     
     // Update queue
     transport_state.rx_queue_head = (transport_state.rx_queue_head + 1) % MATTER_TRANSPORT_RX_QUEUE_SIZE;
@@ -145,9 +156,9 @@ int matter_transport_init(void) {
     printf("Initializing Matter UDP transport...\n");
     
     // Initialize receive queue
+    msg_pool_init();
     for (size_t i = 0; i < MATTER_TRANSPORT_RX_QUEUE_SIZE; i++) {
-        transport_state.rx_queue[i].in_use = false;
-        transport_state.rx_queue[i].length = 0;
+        transport_state.rx_queue[i].pb = NULL;
     }
     transport_state.rx_queue_head = 0;
     transport_state.rx_queue_tail = 0;
@@ -220,10 +231,10 @@ void matter_transport_deinit(void) {
         transport_state.commissioning_pcb = NULL;
     }
     
-    // Clear receive queue
+    // Clear receive queue, returning queued packets to the pool
     for (size_t i = 0; i < MATTER_TRANSPORT_RX_QUEUE_SIZE; i++) {
-        transport_state.rx_queue[i].in_use = false;
-        transport_state.rx_queue[i].length = 0;
+        msg_pool_release(transport_state.rx_queue[i].pb);
+        transport_state.rx_queue[i].pb = NULL;
     }
     transport_state.rx_queue_head = 0;
     transport_state.rx_queue_tail = 0;
@@ -253,15 +264,16 @@ int matter_transport_send(const uint8_t *data, size_t length,
     ip_addr_t dest_ip;
     transport_addr_to_lwip_addr(dest_addr, &dest_ip);
     
-    // Allocate pbuf
-    struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, length, PBUF_RAM);
+    // Reference the caller's buffer instead of copying it.  udp_sendto()
+    // prepends the UDP/IP headers in a separate pbuf, and lwIP copies
+    // PBUF_REF data itself if it has to queue the packet (ARP/ND pending),
+    // so the buffer only needs to stay valid for the duration of this call.
+    struct pbuf *p = pbuf_alloc(PBUF_TRANSPORT, length, PBUF_REF);
     if (p == NULL) {
         printf("[UDPTransport] ERROR: Failed to allocate pbuf for send\n");
         return MATTER_TRANSPORT_ERROR_NO_MEMORY;
     }
-    
-    // Copy data into pbuf
-    memcpy(p->payload, data, length);
+    p->payload = (void *)data;
     
     // Send via operational PCB (use operational for all sends in this phase)
     err_t err = udp_sendto(transport_state.operational_pcb, p, &dest_ip, dest_addr->port);
@@ -277,22 +289,16 @@ int matter_transport_send(const uint8_t *data, size_t length,
     return MATTER_TRANSPORT_SUCCESS;
 }
 
-int matter_transport_receive(uint8_t *buffer, size_t buffer_size, 
-                             size_t *actual_length, 
-                             matter_transport_addr_t *source_addr,
-                             int timeout_ms) {
+int matter_transport_receive_buffer(packet_buffer_t **pb,
+                                    matter_transport_addr_t *source_addr) {
     if (!transport_state.initialized) {
         return MATTER_TRANSPORT_ERROR_INIT;
     }
     
-    if (buffer == NULL || actual_length == NULL || buffer_size == 0) {
+    if (pb == NULL) {
         return MATTER_TRANSPORT_ERROR_INVALID_PARAM;
     }
     
-    // For now, ignore timeout and implement non-blocking receive
-    // Full timeout support would require integration with FreeRTOS or polling loop
-    (void)timeout_ms;
-    
     // Check if we have data in queue
     if (transport_state.rx_queue_count == 0) {
         // Process lwIP (allow callbacks to run)
@@ -307,29 +313,19 @@ int matter_transport_receive(uint8_t *buffer, size_t buffer_size,
     // Get next entry from queue
     rx_queue_entry_t *entry = &transport_state.rx_queue[transport_state.rx_queue_tail];
     
-    if (!entry->in_use) {
+    if (entry->pb == NULL) {
         return MATTER_TRANSPORT_ERROR_WOULD_BLOCK;
     }
     
-    // Check buffer size
-    if (entry->length > buffer_size) {
-        printf("[UDPTransport] ERROR: Buffer too small for received packet (%zu bytes needed, %zu available)\n",
-               entry->length, buffer_size);
-        return MATTER_TRANSPORT_ERROR_INVALID_PARAM;
-    }
-    
-    // Copy data to output buffer
-    memcpy(buffer, entry->data, entry->length);
-    *actual_length = entry->length;
+    // Hand the pool block to the caller
+    *pb = entry->pb;
+    entry->pb = NULL;
     
     // Copy source address if requested
     if (source_addr != NULL) {
         memcpy(source_addr, &entry->source_addr, sizeof(matter_transport_addr_t));
     }
     
-    // Mark entry as free
-    entry->in_use = false;
-    
     // Update queue
     transport_state.rx_queue_tail = (transport_state.rx_queue_tail + 1) % MATTER_TRANSPORT_RX_QUEUE_SIZE;
     transport_state.rx_queue_count--;
@@ -337,6 +333,43 @@ int matter_transport_receive(uint8_t *buffer, size_t buffer_size,
     return MATTER_TRANSPORT_SUCCESS;
 }
 
+int matter_transport_receive(uint8_t *buffer, size_t buffer_size, 
+                             size_t *actual_length, 
+                             matter_transport_addr_t *source_addr,
+                             int timeout_ms) {
+    if (!transport_state.initialized) {
+        return MATTER_TRANSPORT_ERROR_INIT;
+    }
+    
+    if (buffer == NULL || actual_length == NULL || buffer_size == 0) {
+        return MATTER_TRANSPORT_ERROR_INVALID_PARAM;
+    }
+    
+    // For now, ignore timeout and implement non-blocking receive
+    // Full timeout support would require integration with FreeRTOS or polling loop
+    (void)timeout_ms;
+    
+    packet_buffer_t *pb = NULL;
+    int result = matter_transport_receive_buffer(&pb, source_addr);
+    if (result != MATTER_TRANSPORT_SUCCESS) {
+        return result;
+    }
+    
+    if (pb->length > buffer_size) {
+        printf("[UDPTransport] ERROR: Buffer too small for received packet (%zu bytes needed, %zu available), dropping\n",
+               pb->length, buffer_size);
+        msg_pool_release(pb);
+        return MATTER_TRANSPORT_ERROR_INVALID_PARAM;
+    }
+    
+    // Copy data to output buffer
+    memcpy(buffer, packet_buffer_data(pb), pb->length);
+    *actual_length = pb->length;
+    msg_pool_release(pb);
+    
+    return MATTER_TRANSPORT_SUCCESS;
+}
+
 bool matter_transport_has_data(void) {
     if (!transport_state.initialized) {
         return false;
@@ -469,6 +502,26 @@ int udp_transport_send(const char *dest_ip, uint16_t dest_port,
     return matter_transport_send(data, length, &addr);
 }
 
+/**
+ * Format a transport address as a bare IP string (legacy API)
+ */
+static void transport_addr_to_ip_string(const matter_transport_addr_t *addr,
+                                        char *source_ip, size_t source_ip_size) {
+    if (addr->is_ipv6) {
+        ip6_addr_t ipv6_addr;
+        memcpy(ipv6_addr.addr, addr->addr, 16);
+        snprintf(source_ip, source_ip_size, "%s", ip6addr_ntoa(&ipv6_addr));
+    }
+#if LWIP_IPV4
+    else {
+        // Extract IPv4 from IPv4-mapped IPv6
+        ip4_addr_t ipv4_addr;
+        memcpy(&ipv4_addr.addr, &addr->addr[12], 4);
+        snprintf(source_ip, source_ip_size, "%s", ip4addr_ntoa(&ipv4_addr));
+    }
+#endif
+}
+
 int udp_transport_recv(uint8_t *buffer, size_t buffer_size, size_t *actual_length,
                       char *source_ip, size_t source_ip_size, uint16_t *source_port) {
     if (!buffer || !actual_length) {
@@ -480,20 +533,24 @@ int udp_transport_recv(uint8_t *buffer, size_t buffer_size, size_t *actual_lengt
                                          &source_addr, 0);  // 0 ms timeout = non-blocking
     
     if (result == MATTER_TRANSPORT_SUCCESS && source_ip && source_port) {
-        // Convert address to string
-        if (source_addr.is_ipv6) {
-            ip6_addr_t ipv6_addr;
-            memcpy(ipv6_addr.addr, source_addr.addr, 16);
-            snprintf(source_ip, source_ip_size, "%s", ip6addr_ntoa(&ipv6_addr));
-        }
-#if LWIP_IPV4
-        else {
-            // Extract IPv4 from IPv4-mapped IPv6
-            ip4_addr_t ipv4_addr;
-            memcpy(&ipv4_addr.addr, &source_addr.addr[12], 4);
-            snprintf(source_ip, source_ip_size, "%s", ip4addr_ntoa(&ipv4_addr));
-        }
-#endif
+        transport_addr_to_ip_string(&source_addr, source_ip, source_ip_size);
+        *source_port = source_addr.port;
+    }
+    
+    return result;
+}
+
+int udp_transport_recv_buffer(packet_buffer_t **pb,
+                             char *source_ip, size_t source_ip_size, uint16_t *source_port) {
+    if (!pb) {
+        return MATTER_TRANSPORT_ERROR_INVALID_PARAM;
+    }
+    
+    matter_transport_addr_t source_addr;
+    int result = matter_transport_receive_buffer(pb, &source_addr);
+    
+    if (result == MATTER_TRANSPORT_SUCCESS && source_ip && source_port) {
+        transport_addr_to_ip_string(&source_addr, source_ip, source_ip_size);
         *source_port = source_addr.port;
     }
     
@@ -4,6 +4,7 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <stdbool.h>
+#include "packet_buffer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -18,8 +19,9 @@ extern "C" {
 /**
  * Transport Configuration
  */
-#define MATTER_TRANSPORT_RX_QUEUE_SIZE  4   // Number of receive buffers
+#define MATTER_TRANSPORT_RX_QUEUE_SIZE  4   // Number of queued receive buffers
 #define MATTER_TRANSPORT_MAX_PACKET     1280 // Maximum UDP packet size (IPv6 MTU)
+#define MATTER_TRANSPORT_RX_POOL_RESERVE 4  // Pool blocks left free for processing
 
 /**
  * Transport Error Codes
@@ -59,6 +61,8 @@ void matter_transport_deinit(void);
 
 /**
  * Send a Matter message via UDP
+ * The buffer is passed to lwIP by reference (PBUF_REF) and is not copied;
+ * it only has to remain valid until this call returns.
  * 
  * @param data Buffer containing message data
  * @param length Length of message in bytes
@@ -83,6 +87,18 @@ int matter_transport_receive(uint8_t *buffer, size_t buffer_size,
                              matter_transport_addr_t *source_addr,
                              int timeout_ms);
 
+/**
+ * Receive a Matter message via UDP without copying (non-blocking)
+ * The received packet stays in the message pool block it was queued in;
+ * ownership passes to the caller, which must call msg_pool_release().
+ * 
+ * @param pb Pointer to store the received packet buffer
+ * @param source_addr Pointer to store source address (can be NULL)
+ * @return MATTER_TRANSPORT_SUCCESS on success, error code on failure
+ */
+int matter_transport_receive_buffer(packet_buffer_t **pb,
+                                    matter_transport_addr_t *source_addr);
+
 /**
  * Check if transport has pending received data
  * 
@@ -137,6 +153,8 @@ int udp_transport_send(const char *dest_ip, uint16_t dest_port,
                       const uint8_t *data, size_t length);
 int udp_transport_recv(uint8_t *buffer, size_t buffer_size, size_t *actual_length,
                       char *source_ip, size_t source_ip_size, uint16_t *source_port);
+int udp_transport_recv_buffer(packet_buffer_t **pb,
+                             char *source_ip, size_t source_ip_size, uint16_t *source_port);
 
 #ifdef __cplusplus
 }
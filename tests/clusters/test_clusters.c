@@ -12,6 +12,14 @@
 #include "../../src/matter_minimal/clusters/level_control.h"
 #include "../../src/matter_minimal/clusters/temperature.h"
 #include "../../src/matter_minimal/clusters/diagnostics.h"
+#include "../../src/matter_minimal/clusters/basic.h"
+#include "../../src/matter_minimal/clusters/network_commissioning.h"
+#include "../../src/matter_minimal/clusters/general_commissioning.h"
+#include "../../src/matter_minimal/clusters/operational_credentials.h"
+#include "../../src/matter_minimal/interaction/attribute_table.h"
+#include "../../src/matter_minimal/interaction/command_handler.h"
+#include "../../src/matter_minimal/interaction/event_log.h"
+#include "../../src/matter_minimal/codec/tlv.h"
 
 // Test counter
 static int tests_passed = 0;
@@ -57,6 +65,109 @@ int matter_attributes_get(uint8_t endpoint, uint32_t cluster_id,
     return -1;
 }
 
+// Platform network functions used by Network Commissioning
+int storage_adapter_save_wifi_credentials(const char *ssid, const char *password) {
+    (void)ssid; (void)password;
+    return 0;
+}
+
+int network_adapter_save_and_connect(const char *ssid, const char *password) {
+    (void)ssid; (void)password;
+    return 0;
+}
+
+bool network_adapter_is_connected(void) {
+    return true;
+}
+
+// Bridge burner requests made by OnOff and LevelControl commands
+static int burner_enable = -1;
+static int burner_power = -1;
+
+int matter_bridge_request_burner_enable(bool enable) {
+    burner_enable = enable ? 1 : 0;
+    return 0;
+}
+
+int matter_bridge_request_burner_power(uint8_t level) {
+    burner_power = level;
+    return 0;
+}
+
+// Certificate store used by OperationalCredentials
+static size_t saved_noc_len = 0;
+
+int certificate_store_has_noc(void) {
+    return saved_noc_len > 0;
+}
+
+int certificate_store_save_noc(const uint8_t *noc, size_t noc_len) {
+    (void)noc;
+    saved_noc_len = noc_len;
+    return 0;
+}
+
+int certificate_store_save_icac(const uint8_t *icac, size_t icac_len) {
+    (void)icac; (void)icac_len;
+    return 0;
+}
+
+int certificate_store_save_rcac(const uint8_t *rcac, size_t rcac_len) {
+    (void)rcac; (void)rcac_len;
+    return 0;
+}
+
+// InvokeRequest builder: start, one or more commands, then invoke_finish
+static void invoke_start(tlv_writer_t *w, uint8_t *buf, size_t len) {
+    tlv_writer_init(w, buf, len);
+    tlv_encode_structure_start(w, 0xFF);
+    tlv_encode_bool(w, 0, false);
+    tlv_encode_bool(w, 1, false);
+    tlv_encode_array_start(w, 2);
+}
+
+static void command_start(tlv_writer_t *w, uint8_t endpoint, uint32_t cluster_id,
+                          uint32_t command_id) {
+    tlv_encode_structure_start(w, 0xFF);
+    tlv_encode_list_start(w, 0);
+    tlv_encode_uint8(w, 0, endpoint);
+    tlv_encode_uint32(w, 1, cluster_id);
+    tlv_encode_uint32(w, 2, command_id);
+    tlv_encode_container_end(w);
+    tlv_encode_structure_start(w, 1);
+}
+
+static void command_end(tlv_writer_t *w) {
+    tlv_encode_container_end(w);
+    tlv_encode_container_end(w);
+}
+
+static int invoke_finish(tlv_writer_t *w, uint8_t auth_mode, uint32_t now_ms,
+                         uint8_t *response, size_t *response_len) {
+    bool suppress;
+    im_status_code_t status;
+
+    tlv_encode_container_end(w);
+    tlv_encode_container_end(w);
+    return command_handler_process_request(w->buffer, tlv_writer_get_length(w), false,
+                                           auth_mode, now_ms, response, 256, response_len,
+                                           &suppress, &status);
+}
+
+// Check for an unsigned field anywhere in a response
+static bool response_has_uint(const uint8_t *buf, size_t len, uint8_t tag, uint32_t value) {
+    tlv_reader_t r;
+    tlv_element_t e;
+
+    tlv_reader_init(&r, buf, len);
+    while (tlv_reader_next(&r, &e) == 0) {
+        if (e.type == TLV_TYPE_UNSIGNED_INT && e.tag == tag && e.value.u32 == value) {
+            return true;
+        }
+    }
+    return false;
+}
+
 // Test: Descriptor DeviceTypeList
 void test_descriptor_device_type_list(void) {
     printf("Test: Descriptor DeviceTypeList attribute...\n");
@@ -325,6 +436,263 @@ void test_diagnostics_read_attributes(void) {
     }
 }
 
+// Test: Every attribute table entry reads with its declared type
+void test_attribute_table_types(void) {
+    printf("Test: Attribute table entries match the clusters...\n");
+    
+    size_t checked = 0;
+    
+    for (size_t i = 0; i < attribute_table_count(); i++) {
+        const attribute_entry_t *e = attribute_table_get(i);
+        attribute_value_t value;
+        attribute_type_t type;
+        
+        if (e->read(e->endpoint, e->attribute_id, &value, &type) < 0 ||
+            type != (attribute_type_t)e->type) {
+            printf("  ✗ %u/0x%04X/0x%04X does not read as type %u\n",
+                   e->endpoint, (unsigned)e->cluster_id,
+                   (unsigned)e->attribute_id, e->type);
+            tests_failed++;
+            return;
+        }
+        checked++;
+    }
+    
+    printf("  ✓ %zu attributes read with their declared type\n", checked);
+    tests_passed++;
+}
+
+// Test: OnOff and LevelControl commands become burner requests
+void test_burner_commands(void) {
+    printf("Test: OnOff and LevelControl commands...\n");
+    
+    uint8_t request[256];
+    uint8_t response[256];
+    size_t response_len;
+    tlv_writer_t w;
+    
+    // Toggle with the flame on (mock OnOff = true) turns the burner off
+    invoke_start(&w, request, sizeof(request));
+    command_start(&w, 1, CLUSTER_ONOFF, CMD_ONOFF_TOGGLE);
+    command_end(&w);
+    if (invoke_finish(&w, IM_AUTH_CASE, 0, response, &response_len) == 0 && burner_enable == 0) {
+        printf("  ✓ Toggle requests burner off\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ Toggle should request burner off (got %d)\n", burner_enable);
+        tests_failed++;
+    }
+    
+    // MoveToLevelWithOnOff sets the power and enables the burner
+    invoke_start(&w, request, sizeof(request));
+    command_start(&w, 1, CLUSTER_LEVEL_CONTROL, CMD_MOVE_TO_LEVEL_WITH_ON_OFF);
+    tlv_encode_uint8(&w, 0, 60);
+    command_end(&w);
+    if (invoke_finish(&w, IM_AUTH_CASE, 0, response, &response_len) == 0 &&
+        burner_power == 60 && burner_enable == 1) {
+        printf("  ✓ MoveToLevelWithOnOff requests 60%% and burner on\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ MoveToLevelWithOnOff wrong (power %d, enable %d)\n",
+               burner_power, burner_enable);
+        tests_failed++;
+    }
+    
+    // Levels above 100% are refused without a request
+    invoke_start(&w, request, sizeof(request));
+    command_start(&w, 1, CLUSTER_LEVEL_CONTROL, CMD_MOVE_TO_LEVEL);
+    tlv_encode_uint8(&w, 0, 150);
+    command_end(&w);
+    if (invoke_finish(&w, IM_AUTH_CASE, 0, response, &response_len) == 0 && burner_power == 60 &&
+        response_has_uint(response, response_len, 0, IM_STATUS_CONSTRAINT_ERROR)) {
+        printf("  ✓ MoveToLevel 150 refused with CONSTRAINT_ERROR\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ MoveToLevel 150 should be refused\n");
+        tests_failed++;
+    }
+}
+
+// Test: Credentials need an armed fail-safe; CommissioningComplete ends it
+static void add_noc_command(tlv_writer_t *w, const uint8_t *noc, size_t noc_len) {
+    uint8_t ipk[OPERATIONAL_CREDENTIALS_IPK_LEN] = { 0 };
+
+    command_start(w, 0, CLUSTER_OPERATIONAL_CREDENTIALS, CMD_ADD_NOC);
+    tlv_encode_bytes(w, 0, noc, noc_len);
+    tlv_encode_bytes(w, 2, ipk, sizeof(ipk));
+    tlv_encode_uint32(w, 3, 0x11223344);
+    tlv_encode_uint16(w, 4, 0xFFF1);
+    command_end(w);
+}
+
+static void arm_fail_safe_command(tlv_writer_t *w, uint16_t seconds) {
+    command_start(w, 0, CLUSTER_GENERAL_COMMISSIONING, CMD_ARM_FAIL_SAFE);
+    tlv_encode_uint16(w, 0, seconds);
+    tlv_encode_uint8(w, 1, 1);
+    command_end(w);
+}
+
+static void commissioning_complete_command(tlv_writer_t *w) {
+    command_start(w, 0, CLUSTER_GENERAL_COMMISSIONING, CMD_COMMISSIONING_COMPLETE);
+    command_end(w);
+}
+
+void test_commissioning_commands(void) {
+    printf("Test: Commissioning commands...\n");
+    
+    uint8_t request[256];
+    uint8_t response[256];
+    uint8_t noc[40] = { 0x15 };
+    size_t response_len;
+    tlv_writer_t w;
+    
+    // AddNOC before ArmFailSafe
+    invoke_start(&w, request, sizeof(request));
+    add_noc_command(&w, noc, sizeof(noc));
+    if (invoke_finish(&w, IM_AUTH_PASE, 1000, response, &response_len) == 0 &&
+        saved_noc_len == 0 &&
+        response_has_uint(response, response_len, 0, IM_STATUS_FAILSAFE_REQUIRED)) {
+        printf("  ✓ AddNOC refused without a fail-safe\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ AddNOC should need a fail-safe\n");
+        tests_failed++;
+    }
+    
+    // ArmFailSafe for 60 s, then AddNOC in the same request: staged only,
+    // and dropped when the fail-safe runs out
+    invoke_start(&w, request, sizeof(request));
+    arm_fail_safe_command(&w, 60);
+    add_noc_command(&w, noc, sizeof(noc));
+    bool ok = invoke_finish(&w, IM_AUTH_PASE, 1000, response, &response_len) == 0 &&
+              saved_noc_len == 0 &&
+              cluster_general_commissioning_fail_safe_armed(60000) &&
+              response_has_uint(response, response_len, 2, CMD_NOC_RESPONSE) &&
+              response_has_uint(response, response_len, 1,
+                                OPERATIONAL_CREDENTIALS_FABRIC_INDEX) &&
+              !cluster_general_commissioning_fail_safe_armed(61001);
+    
+    invoke_start(&w, request, sizeof(request));
+    arm_fail_safe_command(&w, 60);
+    commissioning_complete_command(&w);
+    ok = ok && invoke_finish(&w, IM_AUTH_PASE, 62000, response, &response_len) == 0 &&
+         saved_noc_len == 0;
+    
+    if (ok) {
+        printf("  ✓ AddNOC staged, dropped when the fail-safe expires\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ Staged NOC saved without CommissioningComplete (%zu bytes)\n",
+               saved_noc_len);
+        tests_failed++;
+    }
+    
+    // CommissioningComplete saves the NOC and disarms; a second one finds
+    // no fail-safe
+    invoke_start(&w, request, sizeof(request));
+    arm_fail_safe_command(&w, 60);
+    add_noc_command(&w, noc, sizeof(noc));
+    commissioning_complete_command(&w);
+    commissioning_complete_command(&w);
+    if (invoke_finish(&w, IM_AUTH_PASE, 63000, response, &response_len) == 0 &&
+        saved_noc_len == sizeof(noc) &&
+        !cluster_general_commissioning_fail_safe_armed(63000) &&
+        response_has_uint(response, response_len, 2, CMD_COMMISSIONING_COMPLETE_RESPONSE) &&
+        response_has_uint(response, response_len, 0, COMMISSIONING_ERROR_NO_FAIL_SAFE)) {
+        printf("  ✓ CommissioningComplete saves the NOC and disarms the fail-safe\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ CommissioningComplete wrong (NOC %zu bytes)\n", saved_noc_len);
+        tests_failed++;
+    }
+    
+    // Commissioned: only the fabric (CASE) may replace the NOC
+    invoke_start(&w, request, sizeof(request));
+    arm_fail_safe_command(&w, 60);
+    add_noc_command(&w, noc, 20);
+    commissioning_complete_command(&w);
+    ok = invoke_finish(&w, IM_AUTH_PASE, 64000, response, &response_len) == 0 &&
+         saved_noc_len == sizeof(noc) &&
+         response_has_uint(response, response_len, 0, IM_STATUS_UNSUPPORTED_ACCESS);
+    
+    invoke_start(&w, request, sizeof(request));
+    arm_fail_safe_command(&w, 60);
+    add_noc_command(&w, noc, 20);
+    commissioning_complete_command(&w);
+    ok = ok && invoke_finish(&w, IM_AUTH_CASE, 65000, response, &response_len) == 0 &&
+         saved_noc_len == 20;
+    
+    if (ok) {
+        printf("  ✓ Commissioned device refuses AddNOC over PASE, accepts it over CASE\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ Wrong AddNOC access on a commissioned device (NOC %zu bytes)\n",
+               saved_noc_len);
+        tests_failed++;
+    }
+}
+
+// Test: NodeLabel is writable and read back
+void test_basic_node_label_write(void) {
+    printf("Test: Basic Information NodeLabel write...\n");
+    
+    attribute_value_t value;
+    attribute_type_t type;
+    
+    value.string_val.str = "Boiler room";
+    value.string_val.len = strlen("Boiler room");
+    if (cluster_basic_write(0, ATTR_BASIC_NODE_LABEL, &value) == IM_STATUS_SUCCESS &&
+        cluster_basic_read(0, ATTR_BASIC_NODE_LABEL, &value, &type) == 0 &&
+        strcmp(value.string_val.str, "Boiler room") == 0) {
+        printf("  ✓ NodeLabel written and read back\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ NodeLabel write failed\n");
+        tests_failed++;
+    }
+    
+    value.string_val.str = "0123456789012345678901234567890123";
+    value.string_val.len = strlen(value.string_val.str);
+    if (cluster_basic_write(0, ATTR_BASIC_NODE_LABEL, &value) == IM_STATUS_CONSTRAINT_ERROR &&
+        cluster_basic_write(0, 0x0001, &value) == IM_STATUS_UNSUPPORTED_WRITE) {
+        printf("  ✓ Long labels and read-only attributes refused\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ Long label or read-only write accepted\n");
+        tests_failed++;
+    }
+}
+
+void test_cluster_events(void) {
+    printf("Test: StartUp and burner events...\n");
+    
+    event_path_t flame_out = { 1, CLUSTER_DIAGNOSTICS, EVENT_BURNER_FLAME_OUT, 0, false };
+    event_path_t burner = { 1, CLUSTER_DIAGNOSTICS, 0, EVENT_PATH_WILDCARD_EVENT, false };
+    uint64_t first = event_log_next_number();
+    
+    event_log_clear();
+    bool ok = cluster_basic_log_start_up(1000) == 0 &&
+              cluster_diagnostics_log_flame_out(3600, 0, 2000) == 0 &&
+              cluster_diagnostics_log_fault_change(5, 0, 3000) == 0 &&
+              cluster_diagnostics_log_data_timeout(true, 4000) == 0 &&
+              event_log_count(EVENT_PRIORITY_CRITICAL) == 2 &&
+              event_log_count(EVENT_PRIORITY_INFO) == 2 &&
+              event_log_next_number() == first + 4;
+    
+    // FlameOut is the first burner event; nothing of it past its number
+    ok = ok && event_log_pending(&flame_out, 1, first + 1) &&
+         !event_log_pending(&flame_out, 1, first + 2) &&
+         event_log_pending(&burner, 1, first + 3);
+    
+    if (ok) {
+        printf("  ✓ Events logged with their priorities\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ Cluster events not logged as expected\n");
+        tests_failed++;
+    }
+}
+
 int main(void) {
     printf("\n========================================\n");
     printf("  Matter Cluster Tests\n");
@@ -335,7 +703,9 @@ int main(void) {
         cluster_onoff_init() < 0 ||
         cluster_level_control_init() < 0 ||
         cluster_temperature_init() < 0 ||
-        cluster_diagnostics_init() < 0) {
+        cluster_diagnostics_init() < 0 ||
+        cluster_network_commissioning_init() < 0 ||
+        event_log_init() < 0) {
         printf("ERROR: Failed to initialize clusters\n");
         return 1;
     }
@@ -348,6 +718,11 @@ int main(void) {
     test_temperature_read_value();
     test_diagnostics_read_attributes();
     test_unsupported_attribute_handling();
+    test_attribute_table_types();
+    test_burner_commands();
+    test_commissioning_commands();
+    test_basic_node_label_write();
+    test_cluster_events();
     
     // Print results
     printf("\n========================================\n");
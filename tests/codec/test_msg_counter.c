@@ -0,0 +1,226 @@
+/*
+ * test_msg_counter.c
+ * Unit tests for sliding-window message counter replay protection
+ */
+
+#include "msg_counter.h"
+#include <stdio.h>
+#include <string.h>
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(cond, msg) do { \
+    if (!(cond)) { \
+        printf("FAIL: %s - %s\n", __func__, msg); \
+        tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define TEST_PASS() do { \
+    printf("PASS: %s\n", __func__); \
+    tests_passed++; \
+} while(0)
+
+static int check_unicast(uint16_t session_id, uint32_t counter) {
+    matter_message_header_t h = {
+        .session_id = session_id,
+        .security_flags = MATTER_SEC_FLAG_SESSION_UNICAST,
+        .message_counter = counter,
+    };
+    return msg_counter_check(&h);
+}
+
+static int check_group(uint16_t session_id, uint64_t node_id, uint32_t counter) {
+    matter_message_header_t h = {
+        .session_id = session_id,
+        .security_flags = MATTER_SEC_FLAG_SESSION_GROUP,
+        .message_counter = counter,
+        .source_node_id = node_id,
+    };
+    return msg_counter_check(&h);
+}
+
+static int check_unsecured(uint64_t node_id, uint32_t counter) {
+    matter_message_header_t h = {
+        .message_counter = counter,
+        .source_node_id = node_id,
+    };
+    return msg_counter_check(&h);
+}
+
+/**
+ * Test reordered delivery inside the window is accepted exactly once
+ */
+void test_unicast_window(void) {
+    msg_counter_init();
+
+    TEST_ASSERT(check_unicast(0x1234, 1000) == MSG_COUNTER_OK, "First message (trust-first)");
+    TEST_ASSERT(check_unicast(0x1234, 1000) == MSG_COUNTER_DUPLICATE, "Repeat of max");
+    TEST_ASSERT(check_unicast(0x1234, 1003) == MSG_COUNTER_OK, "Gap ahead");
+    TEST_ASSERT(check_unicast(0x1234, 1001) == MSG_COUNTER_OK, "Late but in window");
+    TEST_ASSERT(check_unicast(0x1234, 1002) == MSG_COUNTER_OK, "Late but in window");
+    TEST_ASSERT(check_unicast(0x1234, 1001) == MSG_COUNTER_DUPLICATE, "Late duplicate");
+    TEST_ASSERT(check_unicast(0x1234, 1003) == MSG_COUNTER_DUPLICATE, "Duplicate of max");
+
+    // Jump exactly one window ahead: the old max becomes the oldest bit
+    TEST_ASSERT(check_unicast(0x1234, 1003 + MSG_COUNTER_WINDOW_SIZE) == MSG_COUNTER_OK,
+                "Jump by window size");
+    TEST_ASSERT(check_unicast(0x1234, 1003) == MSG_COUNTER_DUPLICATE,
+                "Old max should be marked at the window edge");
+    TEST_ASSERT(check_unicast(0x1234, 1004) == MSG_COUNTER_OK, "Unseen counter in window");
+    TEST_ASSERT(check_unicast(0x1234, 1002) == MSG_COUNTER_OUT_OF_WINDOW, "Behind window");
+
+    // Unicast counters do not roll over
+    TEST_ASSERT(check_unicast(0x0042, 0xFFFFFFF0u) == MSG_COUNTER_OK, "Near wrap");
+    TEST_ASSERT(check_unicast(0x0042, 5) == MSG_COUNTER_OUT_OF_WINDOW,
+                "Unicast wrap must be rejected");
+
+    TEST_PASS();
+}
+
+/**
+ * Test that a shuffled burst (Wi-Fi retry reordering) loses nothing
+ */
+void test_reordered_burst(void) {
+    // Each group of 8 delivered in reverse order
+    msg_counter_init();
+    TEST_ASSERT(check_unicast(7, 0) == MSG_COUNTER_OK, "Sync");
+    for (uint32_t base = 1; base < 257; base += 8) {
+        for (int k = 7; k >= 0; k--) {
+            TEST_ASSERT(check_unicast(7, base + (uint32_t)k) == MSG_COUNTER_OK,
+                        "Reordered message dropped");
+        }
+    }
+    for (uint32_t c = 257 - MSG_COUNTER_WINDOW_SIZE; c < 257; c++) {
+        TEST_ASSERT(check_unicast(7, c) == MSG_COUNTER_DUPLICATE, "Retransmit accepted");
+    }
+
+    msg_counter_stats_t stats;
+    msg_counter_get_stats(&stats);
+    TEST_ASSERT(stats.accepted == 257, "Accepted count mismatch");
+    TEST_ASSERT(stats.reordered == 32 * 7, "Reordered count mismatch");
+    TEST_ASSERT(stats.duplicates == MSG_COUNTER_WINDOW_SIZE, "Duplicate count mismatch");
+
+    TEST_PASS();
+}
+
+/**
+ * Test group counters: per source node, modulo-2^32 comparison
+ */
+void test_group_rollover(void) {
+    msg_counter_init();
+
+    TEST_ASSERT(check_group(0x0100, 0xAAAA, 0xFFFFFFFEu) == MSG_COUNTER_OK, "Sync node A");
+    TEST_ASSERT(check_group(0x0100, 0xAAAA, 2) == MSG_COUNTER_OK, "Rollover ahead");
+    TEST_ASSERT(check_group(0x0100, 0xAAAA, 0xFFFFFFFFu) == MSG_COUNTER_OK,
+                "Late message across the wrap");
+    TEST_ASSERT(check_group(0x0100, 0xAAAA, 0xFFFFFFFFu) == MSG_COUNTER_DUPLICATE,
+                "Duplicate across the wrap");
+    TEST_ASSERT(check_group(0x0100, 0xAAAA, 0xFFFFFF00u) == MSG_COUNTER_OUT_OF_WINDOW,
+                "Behind window");
+
+    // A different sender in the same group has its own window
+    TEST_ASSERT(check_group(0x0100, 0xBBBB, 2) == MSG_COUNTER_OK, "Sync node B");
+    TEST_ASSERT(check_group(0x0100, 0xBBBB, 2) == MSG_COUNTER_DUPLICATE, "Node B duplicate");
+
+    TEST_PASS();
+}
+
+/**
+ * Test unsecured sessions restart on counters behind the window
+ */
+void test_unsecured(void) {
+    msg_counter_init();
+
+    TEST_ASSERT(check_unsecured(0, 5) == MSG_COUNTER_OK, "No source node: accept");
+    TEST_ASSERT(check_unsecured(0, 5) == MSG_COUNTER_OK, "No source node: accept again");
+
+    TEST_ASSERT(check_unsecured(0x77, 500) == MSG_COUNTER_OK, "Sync");
+    TEST_ASSERT(check_unsecured(0x77, 500) == MSG_COUNTER_DUPLICATE, "Retransmit");
+    TEST_ASSERT(check_unsecured(0x77, 10) == MSG_COUNTER_OK, "New session behind window");
+    TEST_ASSERT(check_unsecured(0x77, 10) == MSG_COUNTER_DUPLICATE, "Window restarted");
+
+    TEST_PASS();
+}
+
+/**
+ * Test the unicast table: collisions, deletion, and full-table rejection
+ */
+void test_unicast_table(void) {
+    msg_counter_init();
+
+    // Fill every slot; consecutive IDs exercise collisions and wrap-around
+    for (uint16_t i = 0; i < MSG_COUNTER_UNICAST_SLOTS; i++) {
+        TEST_ASSERT(check_unicast((uint16_t)(0x8000 + i * 16), 100) == MSG_COUNTER_OK,
+                    "Insert failed");
+    }
+    TEST_ASSERT(check_unicast(0x0001, 100) == MSG_COUNTER_NO_SLOT, "Full table must reject");
+
+    // Remove every other session; the rest must keep their windows
+    for (uint16_t i = 0; i < MSG_COUNTER_UNICAST_SLOTS; i += 2) {
+        msg_counter_reset_session((uint16_t)(0x8000 + i * 16));
+    }
+    for (uint16_t i = 1; i < MSG_COUNTER_UNICAST_SLOTS; i += 2) {
+        TEST_ASSERT(check_unicast((uint16_t)(0x8000 + i * 16), 100) == MSG_COUNTER_DUPLICATE,
+                    "State lost after neighbour deletion");
+    }
+
+    // Removed sessions resynchronize from scratch
+    TEST_ASSERT(check_unicast(0x8000, 5) == MSG_COUNTER_OK, "Reset session should resync");
+    msg_counter_reset_session(0x9999);  // Unknown ID is a no-op
+
+    msg_counter_stats_t stats;
+    msg_counter_get_stats(&stats);
+    TEST_ASSERT(stats.unicast_in_use == MSG_COUNTER_UNICAST_SLOTS / 2 + 1, "In-use mismatch");
+    TEST_ASSERT(stats.no_slot == 1, "No-slot counter mismatch");
+
+    TEST_PASS();
+}
+
+/**
+ * Test least-recently-used replacement in the peer table
+ */
+void test_peer_eviction(void) {
+    msg_counter_init();
+
+    for (uint64_t n = 1; n <= MSG_COUNTER_PEER_SLOTS; n++) {
+        TEST_ASSERT(check_unsecured(n, 50) == MSG_COUNTER_OK, "Insert peer");
+    }
+    // Touch peer 1 so peer 2 becomes the least recently used
+    TEST_ASSERT(check_unsecured(1, 51) == MSG_COUNTER_OK, "Touch peer 1");
+    TEST_ASSERT(check_unsecured(1000, 50) == MSG_COUNTER_OK, "Insert into full table");
+
+    TEST_ASSERT(check_unsecured(1, 51) == MSG_COUNTER_DUPLICATE, "Peer 1 should be kept");
+    TEST_ASSERT(check_unsecured(1000, 50) == MSG_COUNTER_DUPLICATE, "New peer tracked");
+    TEST_ASSERT(check_unsecured(2, 50) == MSG_COUNTER_OK, "Peer 2 should be evicted");
+
+    msg_counter_stats_t stats;
+    msg_counter_get_stats(&stats);
+    TEST_ASSERT(stats.evictions == 2, "Eviction count mismatch");
+    TEST_ASSERT(stats.peers_in_use == MSG_COUNTER_PEER_SLOTS, "Peer in-use mismatch");
+
+    TEST_PASS();
+}
+
+/**
+ * Main test runner
+ */
+int main(void) {
+    printf("=== Message Counter Tests ===\n\n");
+
+    test_unicast_window();
+    test_reordered_burst();
+    test_group_rollover();
+    test_unsecured();
+    test_unicast_table();
+    test_peer_eviction();
+
+    printf("\n=== Test Results ===\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return (tests_failed == 0) ? 0 : 1;
+}
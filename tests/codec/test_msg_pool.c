@@ -0,0 +1,125 @@
+/*
+ * test_msg_pool.c
+ * Unit tests for the static message buffer pool
+ */
+
+#include "msg_pool.h"
+#include <stdio.h>
+#include <string.h>
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(cond, msg) do { \
+    if (!(cond)) { \
+        printf("FAIL: %s - %s\n", __func__, msg); \
+        tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define TEST_PASS() do { \
+    printf("PASS: %s\n", __func__); \
+    tests_passed++; \
+} while(0)
+
+/**
+ * Test allocation until exhaustion and the statistics that go with it
+ */
+void test_alloc_exhaustion(void) {
+    packet_buffer_t *blocks[MSG_POOL_BLOCK_COUNT];
+    msg_pool_stats_t stats;
+
+    TEST_ASSERT(msg_pool_available() == MSG_POOL_BLOCK_COUNT, "Pool should start empty");
+
+    for (size_t i = 0; i < MSG_POOL_BLOCK_COUNT; i++) {
+        blocks[i] = msg_pool_alloc();
+        TEST_ASSERT(blocks[i] != NULL, "Allocation failed before pool was full");
+        TEST_ASSERT(blocks[i]->length == 0 &&
+                    blocks[i]->start == PACKET_BUFFER_HEADER_RESERVE,
+                    "Allocated block should be reset");
+    }
+
+    TEST_ASSERT(msg_pool_available() == 0, "Pool should be full");
+    TEST_ASSERT(msg_pool_alloc() == NULL, "Allocation should fail when exhausted");
+    TEST_ASSERT(msg_pool_alloc() == NULL, "Allocation should keep failing");
+
+    msg_pool_get_stats(&stats);
+    TEST_ASSERT(stats.in_use == MSG_POOL_BLOCK_COUNT, "In-use count mismatch");
+    TEST_ASSERT(stats.high_water == MSG_POOL_BLOCK_COUNT, "High-water mark mismatch");
+    TEST_ASSERT(stats.alloc_failures == 2, "Exhaustion counter mismatch");
+
+    for (size_t i = 0; i < MSG_POOL_BLOCK_COUNT; i++) {
+        msg_pool_release(blocks[i]);
+    }
+
+    msg_pool_get_stats(&stats);
+    TEST_ASSERT(stats.in_use == 0, "All blocks should be free");
+    TEST_ASSERT(stats.high_water == MSG_POOL_BLOCK_COUNT, "High-water mark should persist");
+
+    TEST_PASS();
+}
+
+/**
+ * Test reference counting keeps a block alive until the last release
+ */
+void test_refcount(void) {
+    packet_buffer_t *pb = msg_pool_alloc();
+    TEST_ASSERT(pb != NULL, "Allocation failed");
+    size_t free_before = msg_pool_available();
+
+    TEST_ASSERT(msg_pool_retain(pb) == pb, "Retain should return block");
+    msg_pool_release(pb);
+    TEST_ASSERT(msg_pool_available() == free_before, "Block freed while still referenced");
+
+    msg_pool_release(pb);
+    TEST_ASSERT(msg_pool_available() == free_before + 1, "Block not freed on last release");
+
+    TEST_PASS();
+}
+
+/**
+ * Test that bad releases are counted and do not corrupt the pool
+ */
+void test_bad_release(void) {
+    packet_buffer_t foreign;
+    msg_pool_stats_t before, after;
+
+    msg_pool_get_stats(&before);
+    msg_pool_release(NULL);
+    msg_pool_release(&foreign);
+
+    packet_buffer_t *pb = msg_pool_alloc();
+    TEST_ASSERT(pb != NULL, "Allocation failed");
+    msg_pool_release(pb);
+    msg_pool_release(pb);   // Double release
+
+    msg_pool_get_stats(&after);
+    TEST_ASSERT(after.release_errors == before.release_errors + 2,
+                "Foreign and double releases should be counted");
+    TEST_ASSERT(after.in_use == before.in_use, "In-use count corrupted");
+
+    TEST_PASS();
+}
+
+/**
+ * Main test runner
+ */
+int main(void) {
+    printf("=== Message Pool Tests ===\n\n");
+
+    msg_pool_init();
+
+    test_alloc_exhaustion();
+    test_refcount();
+    test_bad_release();
+
+    msg_pool_print_stats();
+
+    printf("\n=== Test Results ===\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -52,6 +52,49 @@ void test_encode_uint32(void) {
     PASS();
 }
 
+// Test: Encode uint64 (8 bytes only when the value needs them)
+void test_encode_uint64(void) {
+    TEST("test_encode_uint64");
+    
+    uint8_t buffer[128];
+    tlv_writer_t writer;
+    tlv_reader_t reader;
+    tlv_element_t element;
+    tlv_writer_init(&writer, buffer, sizeof(buffer));
+    
+    assert(tlv_encode_uint64(&writer, 1, 7) == 0);
+    size_t small_len = tlv_writer_get_length(&writer);
+    assert(tlv_encode_uint64(&writer, 2, 0x100000002ull) == 0);
+    assert(tlv_writer_get_length(&writer) - small_len == 3 + 8);
+    
+    tlv_reader_init(&reader, buffer, tlv_writer_get_length(&writer));
+    assert(tlv_reader_next(&reader, &element) == 0 && element.value.u64 == 7);
+    assert(tlv_reader_next(&reader, &element) == 0 && element.tag == 2);
+    assert(element.value.u64 == 0x100000002ull);
+    
+    PASS();
+}
+
+// Test: Copy pre-encoded elements
+void test_encode_raw(void) {
+    TEST("test_encode_raw");
+    
+    uint8_t encoded[16];
+    uint8_t buffer[16];
+    tlv_writer_t writer;
+    tlv_writer_init(&writer, encoded, sizeof(encoded));
+    tlv_encode_uint8(&writer, 1, 42);
+    size_t len = tlv_writer_get_length(&writer);
+    
+    tlv_writer_init(&writer, buffer, len);
+    assert(tlv_encode_raw(&writer, encoded, 0) == 0);
+    assert(tlv_encode_raw(&writer, encoded, len) == 0);
+    assert(memcmp(buffer, encoded, len) == 0);
+    assert(tlv_encode_raw(&writer, encoded, 1) < 0);
+    
+    PASS();
+}
+
 // Test: Encode int8
 void test_encode_int8(void) {
     TEST("test_encode_int8");
@@ -284,6 +327,45 @@ void test_reader_find_tag(void) {
     PASS();
 }
 
+// Test: Skipping the rest of a container
+void test_reader_exit_container(void) {
+    TEST("test_reader_exit_container");
+    
+    uint8_t buffer[64];
+    tlv_writer_t writer;
+    tlv_writer_init(&writer, buffer, sizeof(buffer));
+    
+    // { 1: 10, 2: [ { 0: 1 } ], 3: 30 }, 4: 40
+    tlv_encode_structure_start(&writer, 0);
+    tlv_encode_uint8(&writer, 1, 10);
+    tlv_encode_array_start(&writer, 2);
+    tlv_encode_structure_start(&writer, 0xFF);
+    tlv_encode_uint8(&writer, 0, 1);
+    tlv_encode_container_end(&writer);
+    tlv_encode_container_end(&writer);
+    tlv_encode_uint8(&writer, 3, 30);
+    tlv_encode_container_end(&writer);
+    tlv_encode_uint8(&writer, 4, 40);
+    
+    tlv_reader_t reader;
+    tlv_element_t element;
+    tlv_reader_init(&reader, buffer, tlv_writer_get_length(&writer));
+    
+    // Enter the structure, read one field, then skip the rest
+    assert(tlv_reader_next(&reader, &element) == 0);
+    assert(tlv_reader_next(&reader, &element) == 0 && element.tag == 1);
+    assert(tlv_reader_exit_container(&reader) == 0);
+    assert(tlv_reader_next(&reader, &element) == 0);
+    assert(element.tag == 4 && tlv_read_uint8(&element) == 40);
+    
+    // Unterminated container
+    tlv_reader_init(&reader, buffer, 4);
+    assert(tlv_reader_next(&reader, &element) == 0);
+    assert(tlv_reader_exit_container(&reader) == -1);
+    
+    PASS();
+}
+
 // Test: Buffer overflow handling
 void test_buffer_overflow_handling(void) {
     TEST("test_buffer_overflow_handling");
@@ -326,6 +408,8 @@ int main(void) {
     test_encode_uint8();
     test_encode_uint16();
     test_encode_uint32();
+    test_encode_uint64();
+    test_encode_raw();
     test_encode_int8();
     test_encode_int16();
     test_encode_int32();
@@ -335,6 +419,7 @@ int main(void) {
     test_encode_array();
     test_decode_all_types();
     test_reader_find_tag();
+    test_reader_exit_container();
     test_buffer_overflow_handling();
     test_null_buffer_handling();
     
@@ -0,0 +1,72 @@
+/*
+ * fake_storage.c
+ * In-memory storage adapter for host tests of code that saves to flash
+ * (the event log's number epoch)
+ */
+
+#include "fake_storage.h"
+#include <string.h>
+#include <stdbool.h>
+
+#define FAKE_STORAGE_ENTRIES    4
+#define FAKE_STORAGE_KEY_LEN    32
+#define FAKE_STORAGE_VALUE_LEN  64
+
+typedef struct {
+    bool used;
+    char key[FAKE_STORAGE_KEY_LEN];
+    uint8_t value[FAKE_STORAGE_VALUE_LEN];
+    size_t len;
+} fake_storage_entry_t;
+
+static fake_storage_entry_t entries[FAKE_STORAGE_ENTRIES];
+
+int fake_storage_writes = 0;
+
+static fake_storage_entry_t *find_entry(const char *key) {
+    for (int i = 0; i < FAKE_STORAGE_ENTRIES; i++) {
+        if (entries[i].used && strcmp(entries[i].key, key) == 0) {
+            return &entries[i];
+        }
+    }
+    return NULL;
+}
+
+int storage_adapter_write(const char *key, const uint8_t *value, size_t value_len) {
+    fake_storage_entry_t *entry = find_entry(key);
+
+    if (value_len > FAKE_STORAGE_VALUE_LEN || strlen(key) >= FAKE_STORAGE_KEY_LEN) {
+        return -1;
+    }
+    for (int i = 0; !entry && i < FAKE_STORAGE_ENTRIES; i++) {
+        if (!entries[i].used) {
+            entry = &entries[i];
+        }
+    }
+    if (!entry) {
+        return -1;
+    }
+
+    entry->used = true;
+    strcpy(entry->key, key);
+    memcpy(entry->value, value, value_len);
+    entry->len = value_len;
+    fake_storage_writes++;
+    return 0;
+}
+
+int storage_adapter_read(const char *key, uint8_t *value, size_t max_value_len,
+                         size_t *actual_len) {
+    const fake_storage_entry_t *entry = find_entry(key);
+
+    if (!entry || entry->len > max_value_len) {
+        return -1;
+    }
+    memcpy(value, entry->value, entry->len);
+    *actual_len = entry->len;
+    return 0;
+}
+
+void fake_storage_clear(void) {
+    memset(entries, 0, sizeof(entries));
+}
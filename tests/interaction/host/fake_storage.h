@@ -0,0 +1,26 @@
+/*
+ * fake_storage.h
+ * In-memory storage adapter for host tests
+ */
+
+#ifndef FAKE_STORAGE_H
+#define FAKE_STORAGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * Successful writes so far
+ */
+extern int fake_storage_writes;
+
+int storage_adapter_write(const char *key, const uint8_t *value, size_t value_len);
+int storage_adapter_read(const char *key, uint8_t *value, size_t max_value_len,
+                         size_t *actual_len);
+
+/**
+ * Forget everything stored
+ */
+void fake_storage_clear(void);
+
+#endif // FAKE_STORAGE_H
@@ -0,0 +1,277 @@
+/*
+ * test_attribute_table.c
+ * Unit tests for the sorted attribute table and wildcard expansion
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "../../src/matter_minimal/interaction/attribute_table.h"
+
+// Test counter
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Mock cluster read functions: OnOff is readable, everything else fails
+int cluster_onoff_read(uint8_t endpoint, uint32_t attr_id,
+                      attribute_value_t *value, attribute_type_t *type) {
+    if (endpoint != 1 || attr_id != 0x0000) return -1;
+    *type = ATTR_TYPE_BOOL;
+    value->bool_val = true;
+    return 0;
+}
+
+#define MOCK_UNREADABLE(name) \
+    int name(uint8_t endpoint, uint32_t attr_id, \
+             attribute_value_t *value, attribute_type_t *type) { \
+        (void)endpoint; (void)attr_id; (void)value; (void)type; \
+        return -1; \
+    }
+
+MOCK_UNREADABLE(cluster_descriptor_read)
+MOCK_UNREADABLE(cluster_basic_read)
+MOCK_UNREADABLE(cluster_network_commissioning_read_attribute)
+MOCK_UNREADABLE(cluster_level_control_read)
+MOCK_UNREADABLE(cluster_diagnostics_read)
+MOCK_UNREADABLE(cluster_temperature_read)
+
+im_status_code_t cluster_basic_write(uint8_t endpoint, uint32_t attr_id,
+                                     const attribute_value_t *value) {
+    (void)endpoint; (void)attr_id; (void)value;
+    return IM_STATUS_UNSUPPORTED_WRITE;
+}
+
+static size_t count_matches(const attribute_path_t *path) {
+    attribute_iter_t it;
+    size_t count = 0;
+
+    attribute_table_iter_init(&it, path);
+    while (attribute_table_iter_next(&it, NULL)) {
+        count++;
+    }
+    return count;
+}
+
+static size_t mask_bits(attribute_mask_t mask) {
+    size_t count = 0;
+    while (mask) {
+        mask &= mask - 1;
+        count++;
+    }
+    return count;
+}
+
+// Test: Entries strictly increasing by (endpoint, cluster, attribute)
+void test_table_sorted(void) {
+    printf("Test: Attribute table sorted and unique...\n");
+
+    size_t count = attribute_table_count();
+    bool ok = count > 0 && count <= ATTRIBUTE_TABLE_MAX &&
+              attribute_table_get(count) == NULL;
+
+    for (size_t i = 1; ok && i < count; i++) {
+        const attribute_entry_t *a = attribute_table_get(i - 1);
+        const attribute_entry_t *b = attribute_table_get(i);
+
+        ok = a->endpoint < b->endpoint ||
+             (a->endpoint == b->endpoint &&
+              (a->cluster_id < b->cluster_id ||
+               (a->cluster_id == b->cluster_id && a->attribute_id < b->attribute_id)));
+        if (!ok) {
+            printf("  ✗ Entry %zu (%u/0x%04X/0x%04X) out of order\n", i,
+                   b->endpoint, (unsigned)b->cluster_id, (unsigned)b->attribute_id);
+        }
+    }
+
+    if (ok) {
+        printf("  ✓ %zu entries in order\n", count);
+        tests_passed++;
+    } else {
+        tests_failed++;
+    }
+}
+
+// Test: Binary search finds every entry at its own index, and nothing else
+void test_table_find(void) {
+    printf("Test: Attribute table lookup...\n");
+
+    bool ok = true;
+    for (size_t i = 0; ok && i < attribute_table_count(); i++) {
+        const attribute_entry_t *e = attribute_table_get(i);
+        size_t index = (size_t)-1;
+        ok = attribute_table_find(e->endpoint, e->cluster_id, e->attribute_id,
+                                  &index) == e && index == i;
+    }
+
+    ok = ok && attribute_table_find(1, 0x0006, 0x0001, NULL) == NULL &&
+         attribute_table_find(0, 0x0006, 0x0000, NULL) == NULL &&
+         attribute_table_find(2, 0x0006, 0x0000, NULL) == NULL &&
+         attribute_table_find(1, 0xFFFFFFFF, 0xFFFFFFFF, NULL) == NULL;
+
+    if (ok) {
+        printf("  ✓ Every entry found, misses rejected\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ Lookup wrong\n");
+        tests_failed++;
+    }
+}
+
+// Test: Concrete reads report which part of the path is missing
+void test_table_read_status(void) {
+    printf("Test: Attribute table read status...\n");
+
+    attribute_value_t value;
+    attribute_type_t type;
+    im_status_code_t status;
+
+    attribute_path_t onoff = {1, 0x0006, 0x0000, 0};
+    attribute_path_t no_endpoint = {9, 0x0006, 0x0000, 0};
+    attribute_path_t no_cluster = {1, 0x0028, 0x0000, 0};
+    attribute_path_t no_attribute = {1, 0x0006, 0x4000, 0};
+    attribute_path_t list = {0, 0x001D, 0x0001, 0};
+    attribute_path_t unreadable = {1, 0x0402, 0x0000, 0};
+
+    bool ok = attribute_table_read(&onoff, &value, &type, &status) == 0 &&
+              status == IM_STATUS_SUCCESS && type == ATTR_TYPE_BOOL && value.bool_val;
+    ok = ok && attribute_table_read(&no_endpoint, &value, &type, &status) < 0 &&
+         status == IM_STATUS_UNSUPPORTED_ENDPOINT;
+    ok = ok && attribute_table_read(&no_cluster, &value, &type, &status) < 0 &&
+         status == IM_STATUS_UNSUPPORTED_CLUSTER;
+    ok = ok && attribute_table_read(&no_attribute, &value, &type, &status) < 0 &&
+         status == IM_STATUS_UNSUPPORTED_ATTRIBUTE;
+    ok = ok && attribute_table_read(&list, &value, &type, &status) < 0 &&
+         status == IM_STATUS_FAILURE;
+    ok = ok && attribute_table_read(&unreadable, &value, &type, &status) < 0 &&
+         status == IM_STATUS_FAILURE;
+
+    if (ok) {
+        printf("  ✓ Status codes match the missing path element\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ Wrong read status\n");
+        tests_failed++;
+    }
+}
+
+// Test: Wildcard expansion and match masks
+void test_table_wildcards(void) {
+    printf("Test: Attribute table wildcard expansion...\n");
+
+    const uint8_t all = ATTR_PATH_WILDCARD_ENDPOINT | ATTR_PATH_WILDCARD_CLUSTER |
+                        ATTR_PATH_WILDCARD_ATTRIBUTE;
+    attribute_path_t everything = {0, 0, 0, all};
+    attribute_path_t endpoint1 = {1, 0, 0,
+        ATTR_PATH_WILDCARD_CLUSTER | ATTR_PATH_WILDCARD_ATTRIBUTE};
+    attribute_path_t basic = {0, 0x0028, 0, ATTR_PATH_WILDCARD_ATTRIBUTE};
+    attribute_path_t attr0_any_cluster = {1, 0, 0x0000, ATTR_PATH_WILDCARD_CLUSTER};
+    attribute_path_t onoff_any_endpoint = {0, 0x0006, 0x0000, ATTR_PATH_WILDCARD_ENDPOINT};
+    attribute_path_t concrete = {1, 0x0402, 0x0003, 0};
+    attribute_path_t missing = {4, 0, 0,
+        ATTR_PATH_WILDCARD_CLUSTER | ATTR_PATH_WILDCARD_ATTRIBUTE};
+
+    size_t n_everything = count_matches(&everything);
+    size_t n_endpoint1 = count_matches(&endpoint1);
+    size_t n_basic = count_matches(&basic);
+    size_t n_attr0 = count_matches(&attr0_any_cluster);
+
+    bool ok = n_everything == attribute_table_count() &&
+              n_endpoint1 == 11 &&                  // OnOff 1, Level 3, Diag 3, Temp 4
+              n_basic == 10 &&
+              n_attr0 == 3 &&                       // OnOff, CurrentLevel, MeasuredValue
+              count_matches(&onoff_any_endpoint) == 1 &&
+              count_matches(&concrete) == 1 &&
+              count_matches(&missing) == 0;
+
+    // Masks agree with the iterator
+    ok = ok && mask_bits(attribute_table_match_mask(&everything)) == n_everything &&
+         mask_bits(attribute_table_match_mask(&basic)) == n_basic &&
+         attribute_table_match_mask(&missing) == 0;
+
+    size_t index;
+    attribute_table_find(1, 0x0402, 0x0003, &index);
+    ok = ok && attribute_table_match_mask(&concrete) == ATTRIBUTE_MASK_BIT(index);
+
+    if (ok) {
+        printf("  ✓ Wildcards expand to the covered entries\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ Expansion wrong (all %zu, ep1 %zu, basic %zu, attr0 %zu)\n",
+               n_everything, n_endpoint1, n_basic, n_attr0);
+        tests_failed++;
+    }
+}
+
+// Test: Quality flags
+void test_table_qualities(void) {
+    printf("Test: Attribute table quality flags...\n");
+
+    const attribute_entry_t *hours = attribute_table_find(1, 0x0033, 0x0003, NULL);
+    const attribute_entry_t *onoff = attribute_table_find(1, 0x0006, 0x0000, NULL);
+    const attribute_entry_t *parts = attribute_table_find(0, 0x001D, 0x0003, NULL);
+
+    bool ok = hours && !(hours->quality & ATTR_QUALITY_REPORTABLE) &&
+              onoff && (onoff->quality & ATTR_QUALITY_REPORTABLE) &&
+              !(onoff->quality & ATTR_QUALITY_FIXED) &&
+              parts && (parts->quality & ATTR_QUALITY_LIST) &&
+              parts->type == ATTR_TYPE_ARRAY;
+
+    if (ok) {
+        printf("  ✓ Reportable, fixed and list flags set\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ Wrong quality flags\n");
+        tests_failed++;
+    }
+}
+
+// Test: Per-cluster DataVersions
+void test_table_data_versions(void) {
+    printf("Test: Attribute table DataVersions...\n");
+
+    uint32_t onoff_v, level_v, temp_v, after;
+
+    attribute_table_init(0x12345678);
+    bool ok = attribute_table_get_data_version(1, 0x0006, &onoff_v) == 0 &&
+              attribute_table_get_data_version(1, 0x0008, &level_v) == 0 &&
+              attribute_table_get_data_version(1, 0x0402, &temp_v) == 0 &&
+              onoff_v != level_v && level_v != temp_v;
+
+    // Bumping one cluster leaves the others alone
+    ok = ok && attribute_table_bump_data_version(1, 0x0006) == 0 &&
+         attribute_table_get_data_version(1, 0x0006, &after) == 0 && after == onoff_v + 1 &&
+         attribute_table_get_data_version(1, 0x0008, &after) == 0 && after == level_v;
+
+    // Unknown clusters have no version
+    ok = ok && attribute_table_get_data_version(1, 0x0028, &after) < 0 &&
+         attribute_table_bump_data_version(7, 0x0006) < 0;
+
+    // A different seed (reboot) starts elsewhere
+    attribute_table_init(0x0BADF00D);
+    ok = ok && attribute_table_get_data_version(1, 0x0006, &after) == 0 &&
+         after != onoff_v && after != onoff_v + 1;
+
+    if (ok) {
+        printf("  ✓ Versions per cluster, bumped independently\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ DataVersion handling wrong\n");
+        tests_failed++;
+    }
+}
+
+int main(void) {
+    printf("=== Matter Attribute Table Tests ===\n\n");
+
+    test_table_sorted();
+    test_table_find();
+    test_table_read_status();
+    test_table_wildcards();
+    test_table_qualities();
+    test_table_data_versions();
+
+    printf("\n=== Test Summary ===\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,464 @@
+/*
+ * test_command_handler.c
+ * Unit tests for the InvokeRequest dispatcher and TimedRequest handling
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "../../src/matter_minimal/interaction/command_handler.h"
+#include "../../src/matter_minimal/interaction/timed_handler.h"
+#include "../../src/matter_minimal/interaction/attribute_table.h"
+#include "../../src/matter_minimal/codec/tlv.h"
+
+// Test counter
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Mock cluster read functions: the attribute table is only used to tell
+// unsupported endpoints and clusters apart
+#define MOCK_UNREADABLE(name) \
+    int name(uint8_t endpoint, uint32_t attr_id, \
+             attribute_value_t *value, attribute_type_t *type) { \
+        (void)endpoint; (void)attr_id; (void)value; (void)type; \
+        return -1; \
+    }
+
+MOCK_UNREADABLE(cluster_descriptor_read)
+MOCK_UNREADABLE(cluster_basic_read)
+MOCK_UNREADABLE(cluster_network_commissioning_read_attribute)
+MOCK_UNREADABLE(cluster_onoff_read)
+MOCK_UNREADABLE(cluster_level_control_read)
+MOCK_UNREADABLE(cluster_diagnostics_read)
+MOCK_UNREADABLE(cluster_temperature_read)
+
+im_status_code_t cluster_basic_write(uint8_t endpoint, uint32_t attr_id,
+                                     const attribute_value_t *value) {
+    (void)endpoint; (void)attr_id; (void)value;
+    return IM_STATUS_UNSUPPORTED_WRITE;
+}
+
+// Mock cluster invoke functions: record the last call
+static int invoke_calls = 0;
+static uint8_t last_endpoint;
+static uint32_t last_command;
+static int last_level = -1;
+
+static void record(const command_context_t *ctx) {
+    tlv_element_t level;
+
+    invoke_calls++;
+    last_endpoint = ctx->endpoint;
+    last_command = ctx->command_id;
+    last_level = command_handler_get_field(ctx, 0, &level) == 0 ?
+                 (int)level.value.u8 : -1;
+}
+
+// ArmFailSafe answers { ErrorCode [0]: 0 }; CommissioningComplete fails
+im_status_code_t cluster_general_commissioning_invoke(command_context_t *ctx) {
+    record(ctx);
+    if (ctx->command_id == 0x04) {
+        tlv_encode_uint8(ctx->response, 0, 7);  // Discarded
+        return IM_STATUS_FAILURE;
+    }
+    return tlv_encode_uint8(ctx->response, 0, 0) == 0 ? IM_STATUS_SUCCESS
+                                                      : IM_STATUS_FAILURE;
+}
+
+im_status_code_t cluster_operational_credentials_invoke(command_context_t *ctx) {
+    record(ctx);
+    return IM_STATUS_FAILSAFE_REQUIRED;
+}
+
+im_status_code_t cluster_onoff_invoke(command_context_t *ctx) {
+    record(ctx);
+    return IM_STATUS_SUCCESS;
+}
+
+im_status_code_t cluster_level_control_invoke(command_context_t *ctx) {
+    record(ctx);
+    return last_level > 100 ? IM_STATUS_CONSTRAINT_ERROR : IM_STATUS_SUCCESS;
+}
+
+/**
+ * Command of a test InvokeRequest
+ */
+typedef struct {
+    int endpoint;                   // -1 = omitted (wildcard)
+    uint32_t cluster_id;
+    uint32_t command_id;
+    int level;                      // CommandFields { 0: level }, -1 = no fields
+} test_command_t;
+
+static size_t build_invoke(uint8_t *buf, size_t len, bool suppress, bool timed,
+                           const test_command_t *cmds, size_t count) {
+    tlv_writer_t w;
+    tlv_writer_init(&w, buf, len);
+    tlv_encode_structure_start(&w, 0xFF);
+    tlv_encode_bool(&w, 0, suppress);
+    tlv_encode_bool(&w, 1, timed);
+    tlv_encode_array_start(&w, 2);
+    for (size_t i = 0; i < count; i++) {
+        tlv_encode_structure_start(&w, 0xFF);
+        tlv_encode_list_start(&w, 0);
+        if (cmds[i].endpoint >= 0) {
+            tlv_encode_uint8(&w, 0, (uint8_t)cmds[i].endpoint);
+        }
+        tlv_encode_uint32(&w, 1, cmds[i].cluster_id);
+        tlv_encode_uint32(&w, 2, cmds[i].command_id);
+        tlv_encode_container_end(&w);
+        if (cmds[i].level >= 0) {
+            tlv_encode_structure_start(&w, 1);
+            tlv_encode_uint16(&w, 1, 0);        // TransitionTime, skipped
+            tlv_encode_uint8(&w, 0, (uint8_t)cmds[i].level);
+            tlv_encode_container_end(&w);
+        }
+        tlv_encode_container_end(&w);
+    }
+    tlv_encode_container_end(&w);
+    tlv_encode_container_end(&w);
+    return tlv_writer_get_length(&w);
+}
+
+/**
+ * Count unsigned fields with the given tag and value whose enclosing
+ * containers have exactly the given tags (anonymous ones are encoded as 0xFF)
+ */
+static int count_uint(const uint8_t *buf, size_t len, const uint8_t *tags, size_t depth,
+                      uint8_t tag, uint32_t value) {
+    tlv_reader_t r;
+    tlv_element_t e;
+    uint8_t stack[8];
+    size_t d = 0;
+    int count = 0;
+
+    tlv_reader_init(&r, buf, len);
+    while (tlv_reader_next(&r, &e) == 0) {
+        if (e.type == TLV_TYPE_END_OF_CONTAINER) {
+            d--;
+        } else if (e.type == TLV_TYPE_STRUCTURE || e.type == TLV_TYPE_ARRAY ||
+                   e.type == TLV_TYPE_LIST) {
+            stack[d++] = e.tag;
+        } else if (e.type == TLV_TYPE_UNSIGNED_INT && d == depth && e.tag == tag &&
+                   memcmp(stack, tags, depth) == 0 && e.value.u32 == value) {
+            count++;
+        }
+    }
+    return count;
+}
+
+// Containers of an InvokeResponseIB's fields
+static const uint8_t STATUS_PATH[] = { 1, 0xFF, 1, 0 };     // CommandStatus path
+static const uint8_t STATUS_CODE[] = { 1, 0xFF, 1, 1 };     // CommandStatus status
+static const uint8_t COMMAND_PATH[] = { 1, 0xFF, 0, 0 };    // Response command path
+static const uint8_t COMMAND_FIELDS[] = { 1, 0xFF, 0, 1 };  // Response command fields
+
+// Test: Entries strictly increasing by (endpoint, cluster, command)
+void test_command_table_sorted(void) {
+    printf("Test: Command table sorted and searchable...\n");
+
+    size_t count = command_handler_count();
+    bool ok = count > 0 && command_handler_get(count) == NULL;
+
+    for (size_t i = 0; ok && i < count; i++) {
+        const command_entry_t *e = command_handler_get(i);
+        ok = e->invoke != NULL &&
+             command_handler_find(e->endpoint, e->cluster_id, e->command_id, NULL) == e;
+        if (ok && i > 0) {
+            const command_entry_t *a = command_handler_get(i - 1);
+            ok = a->endpoint < e->endpoint ||
+                 (a->endpoint == e->endpoint &&
+                  (a->cluster_id < e->cluster_id ||
+                   (a->cluster_id == e->cluster_id && a->command_id < e->command_id)));
+        }
+        if (!ok) {
+            printf("  ✗ Entry %zu (%u/0x%04X/0x%02X) out of order or not found\n", i,
+                   e->endpoint, (unsigned)e->cluster_id, (unsigned)e->command_id);
+        }
+    }
+
+    if (ok) {
+        printf("  ✓ %zu entries in order\n", count);
+        tests_passed++;
+    } else {
+        tests_failed++;
+    }
+}
+
+// Test: Missing commands say which part of the path is missing
+void test_command_find_status(void) {
+    printf("Test: Command lookup status...\n");
+
+    im_status_code_t status;
+    bool ok = command_handler_find(9, 0x0006, 0x01, &status) == NULL &&
+              status == IM_STATUS_UNSUPPORTED_ENDPOINT;
+    ok = ok && command_handler_find(1, 0x0300, 0x00, &status) == NULL &&
+         status == IM_STATUS_UNSUPPORTED_CLUSTER;
+    // Cluster with attributes but no commands
+    ok = ok && command_handler_find(1, 0x0402, 0x00, &status) == NULL &&
+         status == IM_STATUS_UNSUPPORTED_COMMAND;
+    // Cluster with commands only
+    ok = ok && command_handler_find(0, 0x0030, 0x02, &status) == NULL &&
+         status == IM_STATUS_UNSUPPORTED_COMMAND;
+    ok = ok && command_handler_find(1, 0x0006, 0x02, &status) != NULL;
+
+    if (ok) {
+        printf("  ✓ Endpoint, cluster and command misses reported\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ Wrong lookup status\n");
+        tests_failed++;
+    }
+}
+
+// Test: Status-only commands, response commands and failures
+void test_invoke_responses(void) {
+    printf("Test: InvokeResponse encoding...\n");
+
+    uint8_t request[256];
+    uint8_t response[256];
+    size_t response_len = 0;
+    bool suppress = true;
+    im_status_code_t status;
+    const test_command_t cmds[] = {
+        { 1, 0x0008, 0x00, 40 },    // MoveToLevel -> SUCCESS status
+        { 0, 0x0030, 0x00, -1 },    // ArmFailSafe -> ArmFailSafeResponse
+        { 0, 0x0030, 0x04, -1 },    // CommissioningComplete fails -> status
+        { 1, 0x0008, 0x00, 200 },   // Level out of range
+    };
+    size_t len = build_invoke(request, sizeof(request), false, false, cmds, 4);
+
+    invoke_calls = 0;
+    int ret = command_handler_process_request(request, len, false, IM_AUTH_CASE, 1000,
+                                              response, sizeof(response),
+                                              &response_len, &suppress, &status);
+
+    bool ok = ret == 0 && status == IM_STATUS_SUCCESS && !suppress && invoke_calls == 4;
+    // MoveToLevel: Level read past the TransitionTime field
+    ok = ok && count_uint(response, response_len, STATUS_PATH, 4, 2, 0x00) == 2 &&
+         count_uint(response, response_len, STATUS_CODE, 4, 0, IM_STATUS_SUCCESS) == 1 &&
+         count_uint(response, response_len, STATUS_CODE, 4, 0,
+                    IM_STATUS_CONSTRAINT_ERROR) == 1;
+    // ArmFailSafe answered with its response command (0x01) and fields
+    ok = ok && count_uint(response, response_len, COMMAND_PATH, 4, 2, 0x01) == 1 &&
+         count_uint(response, response_len, COMMAND_FIELDS, 4, 0, 0) == 1;
+    // CommissioningComplete's partial response dropped for its status
+    ok = ok && count_uint(response, response_len, COMMAND_PATH, 4, 2, 0x05) == 0 &&
+         count_uint(response, response_len, COMMAND_FIELDS, 4, 0, 7) == 0 &&
+         count_uint(response, response_len, STATUS_PATH, 4, 2, 0x04) == 1 &&
+         count_uint(response, response_len, STATUS_CODE, 4, 0, IM_STATUS_FAILURE) == 1;
+
+    if (ok) {
+        printf("  ✓ Statuses and response command encoded (%zu bytes)\n", response_len);
+        tests_passed++;
+    } else {
+        printf("  ✗ Wrong InvokeResponse (ret %d, status 0x%02X, %d calls)\n",
+               ret, status, invoke_calls);
+        tests_failed++;
+    }
+}
+
+// Test: Unsupported paths, wildcard endpoints and field lookup
+void test_invoke_paths(void) {
+    printf("Test: InvokeRequest paths...\n");
+
+    uint8_t request[256];
+    uint8_t response[256];
+    size_t response_len = 0;
+    bool suppress;
+    im_status_code_t status;
+    const test_command_t cmds[] = {
+        { 5, 0x0006, 0x01, -1 },    // No endpoint 5
+        { -1, 0x0006, 0x02, -1 },   // Toggle on every endpoint with OnOff
+    };
+    size_t len = build_invoke(request, sizeof(request), false, false, cmds, 2);
+
+    invoke_calls = 0;
+    last_level = 0;
+    int ret = command_handler_process_request(request, len, false, IM_AUTH_CASE, 0,
+                                              response, sizeof(response),
+                                              &response_len, &suppress, &status);
+
+    bool ok = ret == 0 && invoke_calls == 1 && last_endpoint == 1 &&
+              last_command == 0x02 && last_level == -1 &&
+              count_uint(response, response_len, STATUS_CODE, 4, 0,
+                         IM_STATUS_UNSUPPORTED_ENDPOINT) == 1 &&
+              count_uint(response, response_len, STATUS_PATH, 4, 0, 1) == 1;
+
+    if (ok) {
+        printf("  ✓ Missing endpoint reported, wildcard invoked on endpoint 1\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ Wrong path handling (ret %d, %d calls)\n", ret, invoke_calls);
+        tests_failed++;
+    }
+}
+
+// Test: Request-level failures: timed mismatch, no commands, no room
+void test_invoke_request_errors(void) {
+    printf("Test: InvokeRequest errors...\n");
+
+    uint8_t request[128];
+    uint8_t response[256];
+    size_t response_len;
+    bool suppress = false;
+    im_status_code_t status;
+    const test_command_t on = { 1, 0x0006, 0x01, -1 };
+    size_t len;
+
+    // TimedRequest flag set without a TimedRequest: nothing invoked
+    invoke_calls = 0;
+    len = build_invoke(request, sizeof(request), true, true, &on, 1);
+    bool ok = command_handler_process_request(request, len, false, IM_AUTH_CASE, 0,
+                                              response, sizeof(response),
+                                              &response_len, &suppress, &status) < 0 &&
+              status == IM_STATUS_TIMED_REQUEST_MISMATCH && suppress && invoke_calls == 0;
+
+    // And the other way round
+    len = build_invoke(request, sizeof(request), false, false, &on, 1);
+    ok = ok && command_handler_process_request(request, len, true, IM_AUTH_CASE, 0,
+                                               response, sizeof(response),
+                                               &response_len, &suppress, &status) < 0 &&
+         status == IM_STATUS_TIMED_REQUEST_MISMATCH;
+
+    // Timed and flagged: accepted
+    len = build_invoke(request, sizeof(request), false, true, &on, 1);
+    ok = ok && command_handler_process_request(request, len, true, IM_AUTH_CASE, 0,
+                                               response, sizeof(response),
+                                               &response_len, &suppress, &status) == 0 &&
+         invoke_calls == 1;
+
+    // No commands
+    len = build_invoke(request, sizeof(request), false, false, &on, 0);
+    ok = ok && command_handler_process_request(request, len, false, IM_AUTH_CASE, 0,
+                                               response, sizeof(response),
+                                               &response_len, &suppress, &status) < 0 &&
+         status == IM_STATUS_INVALID_ACTION;
+
+    // Response does not fit
+    invoke_calls = 0;
+    len = build_invoke(request, sizeof(request), false, false, &on, 1);
+    ok = ok && command_handler_process_request(request, len, false, IM_AUTH_CASE, 0,
+                                               response, 12,
+                                               &response_len, &suppress, &status) < 0 &&
+         status == IM_STATUS_RESOURCE_EXHAUSTED && invoke_calls == 0;
+
+    // Room for the first command's status only: neither command runs
+    const test_command_t twice[] = { on, on };
+    len = build_invoke(request, sizeof(request), false, false, twice, 2);
+    ok = ok && command_handler_process_request(request, len, false, IM_AUTH_CASE, 0,
+                                               response, 45,
+                                               &response_len, &suppress, &status) < 0 &&
+         status == IM_STATUS_RESOURCE_EXHAUSTED && invoke_calls == 0;
+    ok = ok && command_handler_process_request(request, len, false, IM_AUTH_CASE, 0,
+                                               response, 70,
+                                               &response_len, &suppress, &status) == 0 &&
+         invoke_calls == 2;
+
+    if (ok) {
+        printf("  ✓ Mismatch, empty and oversized requests refused\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ Wrong request error handling\n");
+        tests_failed++;
+    }
+}
+
+// Test: Session checks: unsecured refused, burner commands need CASE
+void test_invoke_access(void) {
+    printf("Test: InvokeRequest access...\n");
+
+    uint8_t request[128];
+    uint8_t response[256];
+    size_t response_len;
+    bool suppress;
+    im_status_code_t status;
+    const test_command_t cmds[] = {
+        { 1, 0x0006, 0x01, -1 },    // On: CASE only
+        { 0, 0x0030, 0x00, -1 },    // ArmFailSafe: commissioning, PASE allowed
+    };
+    size_t len = build_invoke(request, sizeof(request), false, false, cmds, 2);
+
+    // Unsecured session: nothing invoked
+    invoke_calls = 0;
+    bool ok = command_handler_process_request(request, len, false, IM_AUTH_NONE, 0,
+                                              response, sizeof(response),
+                                              &response_len, &suppress, &status) < 0 &&
+              status == IM_STATUS_UNSUPPORTED_ACCESS && invoke_calls == 0;
+
+    // PASE session: only the commissioning command runs
+    ok = ok && command_handler_process_request(request, len, false, IM_AUTH_PASE, 0,
+                                               response, sizeof(response),
+                                               &response_len, &suppress, &status) == 0 &&
+         invoke_calls == 1 && last_command == 0x00 &&
+         count_uint(response, response_len, STATUS_CODE, 4, 0,
+                    IM_STATUS_UNSUPPORTED_ACCESS) == 1;
+
+    if (ok) {
+        printf("  ✓ Unsecured request refused, burner command needs CASE\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ Wrong access checks (%d calls)\n", invoke_calls);
+        tests_failed++;
+    }
+}
+
+// Test: Timed windows belong to one exchange, expire and are used once
+void test_timed_window(void) {
+    printf("Test: TimedRequest window...\n");
+
+    uint8_t buf[16];
+    tlv_writer_t w;
+    uint16_t timeout = 0;
+    bool timed = true;
+
+    tlv_writer_init(&w, buf, sizeof(buf));
+    tlv_encode_structure_start(&w, 0xFF);
+    tlv_encode_uint16(&w, 0, 500);
+    tlv_encode_container_end(&w);
+
+    bool ok = timed_handler_parse_request(buf, tlv_writer_get_length(&w), &timeout) == 0 &&
+              timeout == 500;
+
+    // Action on another exchange: not timed, window stays open
+    timed_handler_begin(3, 100, timeout, 0xFFFFFF00u);
+    ok = ok && timed_handler_end(3, 101, 0xFFFFFF10u, &timed) == 0 && !timed;
+    // In time (across the millisecond counter wrap)
+    ok = ok && timed_handler_end(3, 100, 0x000000F0u, &timed) == 0 && timed;
+    // Used up
+    ok = ok && timed_handler_end(3, 100, 0x000000F0u, &timed) == 0 && !timed;
+
+    // Too late
+    timed_handler_begin(3, 102, 100, 1000);
+    ok = ok && timed_handler_end(3, 102, 1101, &timed) < 0 && !timed;
+
+    // Reset drops the window
+    timed_handler_begin(3, 103, 100, 1000);
+    timed_handler_reset();
+    ok = ok && timed_handler_end(3, 103, 1000, &timed) == 0 && !timed;
+
+    if (ok) {
+        printf("  ✓ Window per exchange, expiry and single use\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ Wrong timed window handling\n");
+        tests_failed++;
+    }
+}
+
+int main(void) {
+    printf("=== Matter Command Handler Tests ===\n\n");
+
+    test_command_table_sorted();
+    test_command_find_status();
+    test_invoke_responses();
+    test_invoke_paths();
+    test_invoke_request_errors();
+    test_invoke_access();
+    test_timed_window();
+
+    printf("\n=== Test Summary ===\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,378 @@
+/*
+ * test_event_log.c
+ * Unit tests for the Matter event log and event reports
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "../../src/matter_minimal/interaction/event_log.h"
+#include "../../src/matter_minimal/interaction/read_handler.h"
+#include "../../src/matter_minimal/interaction/subscribe_handler.h"
+#include "../../src/matter_minimal/interaction/report_generator.h"
+#include "../../src/matter_minimal/codec/tlv.h"
+#include "../../src/matter_minimal/codec/msg_pool.h"
+#include "host/fake_storage.h"
+
+// Test counter
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Mock cluster read functions
+#define MOCK_UNREADABLE(name) \
+    int name(uint8_t endpoint, uint32_t attr_id, \
+             attribute_value_t *value, attribute_type_t *type) { \
+        (void)endpoint; (void)attr_id; (void)value; (void)type; \
+        return -1; \
+    }
+
+MOCK_UNREADABLE(cluster_descriptor_read)
+MOCK_UNREADABLE(cluster_basic_read)
+MOCK_UNREADABLE(cluster_network_commissioning_read_attribute)
+MOCK_UNREADABLE(cluster_onoff_read)
+MOCK_UNREADABLE(cluster_level_control_read)
+MOCK_UNREADABLE(cluster_diagnostics_read)
+MOCK_UNREADABLE(cluster_temperature_read)
+
+im_status_code_t cluster_basic_write(uint8_t endpoint, uint32_t attr_id,
+                                     const attribute_value_t *value) {
+    (void)endpoint; (void)attr_id; (void)value;
+    return IM_STATUS_UNSUPPORTED_WRITE;
+}
+
+#define TEST_CLUSTER_DIAGNOSTICS    0x0033
+#define TEST_CLUSTER_BASIC          0x0028
+
+// Event fields: { Value [0]: uint8 }
+static int encode_value(tlv_writer_t *writer, const void *arg) {
+    return tlv_encode_uint8(writer, 0, *(const uint8_t *)arg);
+}
+
+// Event fields: a string too long for EVENT_LOG_MAX_EVENT_LEN
+static int encode_oversized(tlv_writer_t *writer, const void *arg) {
+    (void)arg;
+    return tlv_encode_string(writer, 0,
+                             "0123456789012345678901234567890123456789012345678901234567890123");
+}
+
+static int emit(uint32_t cluster_id, uint32_t event_id, uint8_t priority, uint8_t value,
+                uint32_t now_ms) {
+    return event_log_emit(1, cluster_id, event_id, priority, encode_value, &value,
+                          now_ms, NULL);
+}
+
+/**
+ * EventNumbers of the EventReportIBs in a response's EventReports [2] list
+ */
+static size_t event_numbers(const uint8_t *buf, size_t len, uint64_t *numbers, size_t max) {
+    tlv_reader_t r;
+    tlv_element_t e;
+    int depth = 0;
+    bool in_events = false;
+    size_t count = 0;
+
+    // EventReports [2] / EventReportIB / EventData [1] / EventNumber [1]
+    tlv_reader_init(&r, buf, len);
+    while (tlv_reader_next(&r, &e) == 0) {
+        if (e.type == TLV_TYPE_END_OF_CONTAINER) {
+            depth--;
+            if (depth == 0) {
+                in_events = false;
+            }
+        } else if (e.type == TLV_TYPE_STRUCTURE || e.type == TLV_TYPE_ARRAY ||
+                   e.type == TLV_TYPE_LIST) {
+            if (depth == 0 && e.tag == 2) {
+                in_events = true;
+            }
+            depth++;
+        } else if (in_events && depth == 3 && e.tag == 1 && count < max) {
+            numbers[count++] = e.value.u64;
+        }
+    }
+    return count;
+}
+
+// Test: Numbering and one ring per priority
+void test_event_rings(void) {
+    printf("Test: Event numbering and priority rings...\n");
+
+    uint64_t first = 0;
+    uint64_t number = 0;
+    uint8_t value = 1;
+
+    event_log_clear();
+    event_log_emit(1, TEST_CLUSTER_DIAGNOSTICS, 0, EVENT_PRIORITY_CRITICAL,
+                   encode_value, &value, 1000, &first);
+
+    // Twice as many debug events as slots: the critical one survives
+    for (int i = 0; i < 2 * EVENT_LOG_DEBUG_SLOTS; i++) {
+        emit(TEST_CLUSTER_DIAGNOSTICS, 1, EVENT_PRIORITY_DEBUG, (uint8_t)i, 1000);
+    }
+    event_log_emit(1, TEST_CLUSTER_DIAGNOSTICS, 2, EVENT_PRIORITY_INFO,
+                   NULL, NULL, 1000, &number);
+
+    bool ok = event_log_count(EVENT_PRIORITY_CRITICAL) == 1 &&
+              event_log_count(EVENT_PRIORITY_DEBUG) == EVENT_LOG_DEBUG_SLOTS &&
+              event_log_count(EVENT_PRIORITY_INFO) == 1 &&
+              number == first + 2 * EVENT_LOG_DEBUG_SLOTS + 1 &&
+              event_log_next_number() == number + 1;
+
+    // Unknown priority and oversized events are refused without a number
+    ok = ok && event_log_emit(1, TEST_CLUSTER_DIAGNOSTICS, 3, EVENT_PRIORITY_COUNT,
+                              NULL, NULL, 1000, NULL) < 0 &&
+         event_log_emit(1, TEST_CLUSTER_DIAGNOSTICS, 3, EVENT_PRIORITY_INFO,
+                        encode_oversized, NULL, 1000, NULL) < 0 &&
+         event_log_next_number() == number + 1;
+
+    if (ok) {
+        printf("  ✓ Shared numbering, oldest debug events dropped first\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ Wrong ring contents\n");
+        tests_failed++;
+    }
+}
+
+// Test: Path and EventMin filtering, rollback when out of room
+void test_event_encode(void) {
+    printf("Test: Event report encoding...\n");
+
+    uint8_t buf[256];
+    uint64_t numbers[8];
+    uint64_t base = event_log_next_number();
+    uint64_t event_min = base;
+    bool more;
+    event_path_t path = { 1, TEST_CLUSTER_DIAGNOSTICS, 0, EVENT_PATH_WILDCARD_EVENT, false };
+
+    event_log_clear();
+    emit(TEST_CLUSTER_DIAGNOSTICS, 0, EVENT_PRIORITY_INFO, 1, 2000);     // base
+    emit(TEST_CLUSTER_BASIC, 0, EVENT_PRIORITY_CRITICAL, 2, 2000);       // base + 1
+    emit(TEST_CLUSTER_DIAGNOSTICS, 1, EVENT_PRIORITY_CRITICAL, 3, 2000); // base + 2
+    emit(TEST_CLUSTER_DIAGNOSTICS, 2, EVENT_PRIORITY_DEBUG, 4, 2000);    // base + 3
+
+    // Everything on the path, oldest first across the priority rings
+    tlv_writer_t w;
+    tlv_writer_init(&w, buf, sizeof(buf));
+    tlv_encode_array_start(&w, 2);
+    size_t n = event_log_encode_reports(&w, &path, 1, &event_min, &more);
+    tlv_encode_container_end(&w);
+    size_t found = event_numbers(buf, tlv_writer_get_length(&w), numbers, 8);
+
+    bool ok = n == 3 && !more && found == 3 && numbers[0] == base &&
+              numbers[1] == base + 2 && numbers[2] == base + 3 &&
+              event_min == base + 4 && !event_log_pending(&path, 1, event_min);
+
+    // From EventMin on, with room for one and a half reports
+    size_t one_report = (tlv_writer_get_length(&w) - 3) / 3;
+    event_min = base + 1;
+    tlv_writer_init(&w, buf, 2 + one_report + one_report / 2);
+    tlv_encode_array_start(&w, 2);
+    n = event_log_encode_reports(&w, &path, 1, &event_min, &more);
+    w.buffer_size = sizeof(buf);
+    tlv_encode_container_end(&w);
+    ok = ok && n == 1 && more && event_min == base + 3 &&
+         event_numbers(buf, tlv_writer_get_length(&w), numbers, 8) == 1 &&
+         numbers[0] == base + 2 && event_log_pending(&path, 1, event_min);
+
+    if (ok) {
+        printf("  ✓ Filtered by path and EventMin, partial report rolled back\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ Wrong event reports (%zu encoded, %zu found)\n", n, found);
+        tests_failed++;
+    }
+}
+
+// Test: ReadRequest with EventRequests and EventFilters
+void test_read_events(void) {
+    printf("Test: ReadRequest event reports...\n");
+
+    uint8_t request[128];
+    uint8_t response[512];
+    uint64_t numbers[8];
+    size_t response_len = 0;
+    bool more = true;
+    read_cursor_t cursor;
+    uint64_t base = event_log_next_number();
+
+    event_log_clear();
+    emit(TEST_CLUSTER_DIAGNOSTICS, 0, EVENT_PRIORITY_INFO, 1, 3000);
+    emit(TEST_CLUSTER_DIAGNOSTICS, 1, EVENT_PRIORITY_INFO, 2, 3000);
+    emit(TEST_CLUSTER_BASIC, 0, EVENT_PRIORITY_CRITICAL, 3, 3000);
+
+    // ReadRequest ::= { EventRequests [1], EventFilters [2], FabricFiltered [3] }
+    tlv_writer_t w;
+    tlv_writer_init(&w, request, sizeof(request));
+    tlv_encode_structure_start(&w, 0xFF);
+    tlv_encode_array_start(&w, 1);
+    tlv_encode_list_start(&w, 0xFF);
+    tlv_encode_uint8(&w, 1, 1);
+    tlv_encode_uint32(&w, 2, TEST_CLUSTER_DIAGNOSTICS);
+    tlv_encode_container_end(&w);
+    tlv_encode_container_end(&w);
+    tlv_encode_array_start(&w, 2);
+    tlv_encode_structure_start(&w, 0xFF);
+    tlv_encode_uint64(&w, 1, base + 1);
+    tlv_encode_container_end(&w);
+    tlv_encode_container_end(&w);
+    tlv_encode_bool(&w, 3, true);
+    tlv_encode_container_end(&w);
+
+    bool ok = read_handler_parse_request(request, tlv_writer_get_length(&w), &cursor) == 0 &&
+              cursor.path_count == 0 && cursor.event_path_count == 1 &&
+              cursor.event_min == base + 1 &&
+              read_handler_encode_chunk(&cursor, response, sizeof(response),
+                                        &response_len, &more) == 0 &&
+              !more &&
+              event_numbers(response, response_len, numbers, 8) == 1 &&
+              numbers[0] == base + 1;
+
+    if (ok) {
+        printf("  ✓ Events from EventMin on the requested cluster\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ Wrong event read\n");
+        tests_failed++;
+    }
+}
+
+// Reports sent to the fake transport
+static int sent_count = 0;
+static size_t sent_events = 0;
+static uint64_t sent_numbers[8];
+
+static int fake_sender(uint16_t session_id, packet_buffer_t *pb) {
+    (void)session_id;
+    sent_count++;
+    sent_events = event_numbers(packet_buffer_data(pb), pb->length, sent_numbers, 8);
+    msg_pool_release(pb);
+    return REPORT_SEND_OK;
+}
+
+// Test: Subscription with an event path
+void test_subscription_events(void) {
+    printf("Test: Subscription event reports...\n");
+
+    uint8_t request[128];
+    uint8_t response[64];
+    size_t response_len = 0;
+    uint32_t t = 10000;
+    uint64_t base = event_log_next_number();
+
+    event_log_clear();
+    subscribe_handler_clear_all();
+    report_generator_set_sender(fake_sender);
+    sent_count = 0;
+
+    // Logged before the subscription: in the first report
+    emit(TEST_CLUSTER_DIAGNOSTICS, 0, EVENT_PRIORITY_INFO, 1, t);
+
+    // SubscribeRequest ::= { EventRequests [1], Min [2], Max [3], Keep [4] }
+    tlv_writer_t w;
+    tlv_writer_init(&w, request, sizeof(request));
+    tlv_encode_array_start(&w, 1);
+    tlv_encode_list_start(&w, 0xFF);
+    tlv_encode_uint8(&w, 1, 1);
+    tlv_encode_uint32(&w, 2, TEST_CLUSTER_DIAGNOSTICS);
+    tlv_encode_bool(&w, 4, true);
+    tlv_encode_container_end(&w);
+    tlv_encode_container_end(&w);
+    tlv_encode_uint16(&w, 2, 1);
+    tlv_encode_uint16(&w, 3, 60);
+    tlv_encode_bool(&w, 4, false);
+
+    im_status_code_t status;
+    uint32_t id = 0;
+    bool ok = subscribe_handler_process_request(request, tlv_writer_get_length(&w),
+                                                response, sizeof(response),
+                                                &response_len, 0x1234, &id,
+                                                &status) == 0 &&
+              subscribe_handler_get_count() == 1;
+
+    // The priming report carries it
+    bool more = true;
+    const subscription_t *sub = subscribe_handler_get_subscription(id);
+    ok = ok && sub && sub->events_pending &&
+         subscribe_handler_send_priming(id, t, &more) == REPORT_SEND_OK && !more &&
+         subscribe_handler_activate(id, t) == 0 && sent_count == 1 &&
+         sent_events == 1 && sent_numbers[0] == base &&
+         sub->event_min == base + 1 && !sub->events_pending;
+
+    // Urgent path: a new event is reported once min_interval has passed
+    // without waiting for max_interval; other clusters are not
+    emit(TEST_CLUSTER_BASIC, 0, EVENT_PRIORITY_CRITICAL, 2, t + 100);
+    ok = ok && sub && !sub->events_pending;
+    emit(TEST_CLUSTER_DIAGNOSTICS, 1, EVENT_PRIORITY_INFO, 3, t + 200);
+    ok = ok && sub && sub->events_pending &&
+         subscribe_handler_check_intervals(t + 1000) == 1 && sent_count == 2 &&
+         sent_events == 1 && sent_numbers[0] == base + 2 && !sub->events_pending;
+
+    if (ok) {
+        printf("  ✓ Logged events reported once, on the subscribed cluster only\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ Wrong subscription event reports (%d sent, %zu events)\n",
+               sent_count, sent_events);
+        tests_failed++;
+    }
+
+    subscribe_handler_clear_all();
+}
+
+// Test: Numbers keep increasing across a reset, one flash write per block
+void test_number_epoch(void) {
+    printf("Test: Event number epoch...\n");
+
+    // First boot: numbering from 0, the first block reserved
+    fake_storage_clear();
+    event_log_deinit();
+    fake_storage_writes = 0;
+    bool ok = event_log_init() == 0 && event_log_next_number() == 0 &&
+              fake_storage_writes == 1;
+
+    // A whole block costs no further write; the first number past it does
+    for (uint32_t i = 0; ok && i < EVENT_LOG_NUMBER_BLOCK; i++) {
+        ok = emit(TEST_CLUSTER_DIAGNOSTICS, 0, EVENT_PRIORITY_DEBUG, 0, 1000) == 0;
+    }
+    ok = ok && fake_storage_writes == 1 &&
+         emit(TEST_CLUSTER_DIAGNOSTICS, 0, EVENT_PRIORITY_DEBUG, 0, 1000) == 0 &&
+         fake_storage_writes == 2 &&
+         event_log_next_number() == EVENT_LOG_NUMBER_BLOCK + 1;
+
+    // Reset: the RAM rings are gone, numbering resumes past the block in use
+    event_log_deinit();
+    ok = ok && event_log_init() == 0 &&
+         event_log_next_number() == 2 * (uint64_t)EVENT_LOG_NUMBER_BLOCK &&
+         event_log_count(EVENT_PRIORITY_DEBUG) == 0 && fake_storage_writes == 3;
+
+    if (ok) {
+        printf("  ✓ Numbers resume past the reserved block after a reset\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ Wrong numbering across reset (next %llu, %d writes)\n",
+               (unsigned long long)event_log_next_number(), fake_storage_writes);
+        tests_failed++;
+    }
+}
+
+int main(void) {
+    printf("=== Matter Event Log Tests ===\n\n");
+
+    msg_pool_init();
+    if (event_log_init() < 0 || read_handler_init() < 0 ||
+        subscribe_handler_init() < 0 || report_generator_init() < 0) {
+        printf("ERROR: Failed to initialize\n");
+        return 1;
+    }
+
+    test_event_rings();
+    test_event_encode();
+    test_read_events();
+    test_subscription_events();
+    test_number_epoch();
+
+    printf("\n=== Test Summary ===\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return (tests_failed == 0) ? 0 : 1;
+}
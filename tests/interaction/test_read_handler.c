@@ -8,6 +8,7 @@
 #include <string.h>
 #include <assert.h>
 #include "../../src/matter_minimal/interaction/read_handler.h"
+#include "../../src/matter_minimal/interaction/attribute_table.h"
 #include "../../src/matter_minimal/interaction/interaction_model.h"
 #include "../../src/matter_minimal/codec/tlv.h"
 
@@ -64,6 +65,13 @@ int cluster_diagnostics_read(uint8_t endpoint, uint32_t attr_id,
     return -1;
 }
 
+int cluster_network_commissioning_read_attribute(uint8_t endpoint, uint32_t attr_id,
+                                                 attribute_value_t *value,
+                                                 attribute_type_t *type) {
+    (void)endpoint; (void)attr_id; (void)value; (void)type;
+    return -1;
+}
+
 int cluster_basic_read(uint8_t endpoint, uint32_t attr_id,
                        attribute_value_t *value, attribute_type_t *type) {
     if (endpoint != 0) return -1;
@@ -76,6 +84,12 @@ int cluster_basic_read(uint8_t endpoint, uint32_t attr_id,
     return -1;
 }
 
+im_status_code_t cluster_basic_write(uint8_t endpoint, uint32_t attr_id,
+                                     const attribute_value_t *value) {
+    (void)endpoint; (void)attr_id; (void)value;
+    return IM_STATUS_UNSUPPORTED_WRITE;
+}
+
 // Helper to create a simple ReadRequest TLV
 static size_t create_read_request(uint8_t endpoint, uint32_t cluster_id,
                                   uint32_t attr_id, uint8_t *buffer, size_t max_len) {
@@ -309,6 +323,304 @@ void test_read_request_response_roundtrip(void) {
     }
 }
 
+// Count the AttributeReports in a ReadResponse, and how many are statuses
+static int count_reports(const uint8_t *response, size_t len, int *statuses) {
+    tlv_reader_t reader;
+    tlv_element_t element;
+    int depth = 0;
+    int reports = 0;
+    
+    *statuses = 0;
+    tlv_reader_init(&reader, response, len);
+    while (tlv_reader_next(&reader, &element) == 0) {
+        if (element.type == TLV_TYPE_END_OF_CONTAINER) {
+            depth--;
+        } else if (element.type == TLV_TYPE_STRUCTURE ||
+                   element.type == TLV_TYPE_LIST ||
+                   element.type == TLV_TYPE_ARRAY) {
+            if (depth == 1) {
+                reports++;
+            } else if (depth == 2 && element.tag == 0) {
+                (*statuses)++;
+            }
+            depth++;
+        }
+    }
+    return reports;
+}
+
+// Test: Wildcard paths expand through the attribute table
+void test_read_wildcard_paths(void) {
+    printf("Test: Wildcard ReadRequest expansion...\n");
+    
+    uint8_t request[256];
+    tlv_writer_t writer;
+    tlv_writer_init(&writer, request, sizeof(request));
+    
+    tlv_encode_array_start(&writer, 0);
+    
+    // Every attribute on endpoint 1 (cluster and attribute omitted)
+    tlv_encode_structure_start(&writer, 0xFF);
+    tlv_encode_uint8(&writer, 0, 1);
+    tlv_encode_container_end(&writer);
+    
+    // Concrete path on an endpoint the device does not have
+    tlv_encode_structure_start(&writer, 0xFF);
+    tlv_encode_uint8(&writer, 0, 7);
+    tlv_encode_uint32(&writer, 2, 0x0006);
+    tlv_encode_uint32(&writer, 3, 0x0000);
+    tlv_encode_container_end(&writer);
+    
+    tlv_encode_container_end(&writer);
+    
+    uint8_t response[1024];
+    size_t response_len;
+    int statuses;
+    
+    int result = read_handler_process_request(request, tlv_writer_get_length(&writer),
+                                              response, sizeof(response),
+                                              &response_len);
+    
+    // The mocks can read OnOff, CurrentLevel and MeasuredValue on endpoint 1;
+    // the other attributes the wildcard covers are left out, the concrete
+    // path gets a status
+    int reports = result == 0 ? count_reports(response, response_len, &statuses) : -1;
+    if (reports == 4 && statuses == 1) {
+        printf("  ✓ Wildcard expanded to readable attributes only\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ Expected 4 reports (1 status), got %d (%d)\n", reports, statuses);
+        tests_failed++;
+    }
+}
+
+// ReadRequest for OnOff on endpoint 1 with one DataVersionFilter on it
+static size_t create_filtered_read_request(uint32_t data_version,
+                                           uint8_t *buffer, size_t max_len) {
+    tlv_writer_t writer;
+    tlv_writer_init(&writer, buffer, max_len);
+    
+    tlv_encode_array_start(&writer, 0);
+    tlv_encode_structure_start(&writer, 0xFF);
+    tlv_encode_uint8(&writer, 0, 1);
+    tlv_encode_uint32(&writer, 2, 0x0006);
+    tlv_encode_uint32(&writer, 3, 0x0000);
+    tlv_encode_container_end(&writer);
+    tlv_encode_container_end(&writer);
+    
+    // DataVersionFilters [4]
+    tlv_encode_array_start(&writer, 4);
+    tlv_encode_structure_start(&writer, 0xFF);
+    tlv_encode_structure_start(&writer, 0);     // Path
+    tlv_encode_uint8(&writer, 1, 1);            // Endpoint
+    tlv_encode_uint32(&writer, 2, 0x0006);      // Cluster
+    tlv_encode_container_end(&writer);
+    tlv_encode_uint32(&writer, 1, data_version);
+    tlv_encode_container_end(&writer);
+    tlv_encode_container_end(&writer);
+    
+    return tlv_writer_get_length(&writer);
+}
+
+// DataVersion of the first AttributeData in a ReadResponse
+static bool first_data_version(const uint8_t *response, size_t len, uint32_t *version) {
+    tlv_reader_t reader;
+    tlv_element_t element;
+    int depth = 0;
+    bool in_data = false;
+    
+    tlv_reader_init(&reader, response, len);
+    while (tlv_reader_next(&reader, &element) == 0) {
+        if (element.type == TLV_TYPE_END_OF_CONTAINER) {
+            depth--;
+        } else if (element.type == TLV_TYPE_STRUCTURE ||
+                   element.type == TLV_TYPE_LIST ||
+                   element.type == TLV_TYPE_ARRAY) {
+            in_data = (depth == 2 && element.tag == 1);
+            depth++;
+        } else if (in_data && depth == 3 && element.tag == 0) {
+            *version = element.value.u32;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Test: DataVersionFilter skips clusters the controller already has
+void test_read_data_version_filter(void) {
+    printf("Test: ReadRequest with DataVersionFilter...\n");
+    
+    attribute_table_init(0xC0FFEE);
+    uint32_t current;
+    attribute_table_get_data_version(1, 0x0006, &current);
+    
+    uint8_t request[256];
+    uint8_t response[512];
+    size_t response_len;
+    int statuses;
+    
+    // Stale version: the attribute is sent with the current DataVersion
+    size_t request_len = create_filtered_read_request(current - 1, request, sizeof(request));
+    uint32_t reported = 0;
+    if (read_handler_process_request(request, request_len, response, sizeof(response),
+                                     &response_len) < 0 ||
+        count_reports(response, response_len, &statuses) != 1 ||
+        !first_data_version(response, response_len, &reported) || reported != current) {
+        printf("  ✗ Stale filter: report or DataVersion missing (%u)\n", (unsigned)reported);
+        tests_failed++;
+        return;
+    }
+    
+    // Current version: nothing to send
+    request_len = create_filtered_read_request(current, request, sizeof(request));
+    if (read_handler_process_request(request, request_len, response, sizeof(response),
+                                     &response_len) < 0 ||
+        count_reports(response, response_len, &statuses) != 0) {
+        printf("  ✗ Matching filter did not skip the cluster\n");
+        tests_failed++;
+        return;
+    }
+    
+    // After a change the filter no longer matches
+    attribute_table_bump_data_version(1, 0x0006);
+    if (read_handler_process_request(request, request_len, response, sizeof(response),
+                                     &response_len) < 0 ||
+        count_reports(response, response_len, &statuses) != 1) {
+        printf("  ✗ Changed cluster filtered out\n");
+        tests_failed++;
+        return;
+    }
+    
+    printf("  ✓ Unchanged cluster skipped, DataVersion reported\n");
+    tests_passed++;
+}
+
+// MoreChunkedMessages [3] at the top level of a ReadResponse
+static bool more_chunked(const uint8_t *response, size_t len) {
+    tlv_reader_t reader;
+    tlv_element_t element;
+    int depth = 0;
+    
+    tlv_reader_init(&reader, response, len);
+    while (tlv_reader_next(&reader, &element) == 0) {
+        if (element.type == TLV_TYPE_END_OF_CONTAINER) {
+            depth--;
+        } else if (element.type == TLV_TYPE_STRUCTURE ||
+                   element.type == TLV_TYPE_LIST ||
+                   element.type == TLV_TYPE_ARRAY) {
+            depth++;
+        } else if (depth == 0 && element.tag == 3 && element.type == TLV_TYPE_BOOL) {
+            return element.value.boolean;
+        }
+    }
+    return false;
+}
+
+// Test: A read larger than one packet is sent in chunks from a cursor
+void test_read_chunked(void) {
+    printf("Test: Chunked ReadResponse...\n");
+    
+    uint8_t request[256];
+    tlv_writer_t writer;
+    tlv_writer_init(&writer, request, sizeof(request));
+    
+    // Whole device, then a concrete path the device does not have
+    tlv_encode_array_start(&writer, 0);
+    tlv_encode_structure_start(&writer, 0xFF);
+    tlv_encode_container_end(&writer);
+    tlv_encode_structure_start(&writer, 0xFF);
+    tlv_encode_uint8(&writer, 0, 7);
+    tlv_encode_uint32(&writer, 2, 0x0006);
+    tlv_encode_uint32(&writer, 3, 0x0000);
+    tlv_encode_container_end(&writer);
+    tlv_encode_container_end(&writer);
+    size_t request_len = tlv_writer_get_length(&writer);
+    
+    // Everything in one packet
+    uint8_t response[1024];
+    size_t response_len;
+    int statuses;
+    read_cursor_t cursor;
+    bool more = true;
+    
+    if (read_handler_parse_request(request, request_len, &cursor) < 0 ||
+        read_handler_encode_chunk(&cursor, response, sizeof(response),
+                                  &response_len, &more) < 0 || more ||
+        more_chunked(response, response_len)) {
+        printf("  ✗ Unchunked read failed\n");
+        tests_failed++;
+        return;
+    }
+    int expected = count_reports(response, response_len, &statuses);
+    
+    // The same read through 64-byte packets: one report each
+    const size_t chunk_max = 64;
+    int total = 0;
+    int chunks = 0;
+    read_handler_parse_request(request, request_len, &cursor);
+    do {
+        uint8_t chunk[64];
+        int chunk_statuses;
+        
+        if (read_handler_encode_chunk(&cursor, chunk, chunk_max,
+                                      &response_len, &more) < 0 ||
+            response_len > chunk_max || more != more_chunked(chunk, response_len)) {
+            printf("  ✗ Chunk %d malformed\n", chunks);
+            tests_failed++;
+            return;
+        }
+        total += count_reports(chunk, response_len, &chunk_statuses);
+        statuses -= chunk_statuses;
+        chunks++;
+    } while (more && chunks < 32);
+    
+    // A buffer too small for any report cannot make progress
+    uint8_t tiny[16];
+    read_handler_parse_request(request, request_len, &cursor);
+    bool stuck = read_handler_encode_chunk(&cursor, tiny, sizeof(tiny),
+                                           &response_len, &more) < 0;
+    
+    if (expected == 5 && total == expected && statuses == 0 && chunks > 1 && stuck) {
+        printf("  ✓ %d reports in %d chunks, none repeated or lost\n", total, chunks);
+        tests_passed++;
+    } else {
+        printf("  ✗ Expected %d reports, got %d in %d chunks\n", expected, total, chunks);
+        tests_failed++;
+    }
+}
+
+// Test: StatusResponse parsing (flow control between chunks)
+void test_parse_status_response(void) {
+    printf("Test: StatusResponse parsing...\n");
+    
+    uint8_t buffer[16];
+    tlv_writer_t writer;
+    im_status_code_t status = IM_STATUS_SUCCESS;
+    
+    tlv_writer_init(&writer, buffer, sizeof(buffer));
+    tlv_encode_structure_start(&writer, 0xFF);
+    tlv_encode_uint8(&writer, 0, IM_STATUS_FAILURE);
+    tlv_encode_container_end(&writer);
+    
+    bool ok = read_handler_parse_status_response(buffer, tlv_writer_get_length(&writer),
+                                                 &status) == 0 &&
+              status == IM_STATUS_FAILURE;
+    
+    tlv_writer_init(&writer, buffer, sizeof(buffer));
+    tlv_encode_structure_start(&writer, 0xFF);
+    tlv_encode_container_end(&writer);
+    ok = ok && read_handler_parse_status_response(buffer, tlv_writer_get_length(&writer),
+                                                  &status) < 0;
+    
+    if (ok) {
+        printf("  ✓ Status read, missing status rejected\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ StatusResponse parsing wrong\n");
+        tests_failed++;
+    }
+}
+
 int main(void) {
     printf("\n========================================\n");
     printf("  Matter ReadHandler Tests\n");
@@ -327,6 +639,10 @@ int main(void) {
     test_encode_read_response_unsupported_cluster();
     test_read_all_clusters();
     test_read_request_response_roundtrip();
+    test_read_wildcard_paths();
+    test_read_data_version_filter();
+    test_read_chunked();
+    test_parse_status_response();
     
     // Print results
     printf("\n========================================\n");
@@ -55,6 +55,13 @@ int cluster_diagnostics_read(uint8_t endpoint, uint32_t attr_id,
     return -1;
 }
 
+int cluster_network_commissioning_read_attribute(uint8_t endpoint, uint32_t attr_id,
+                                                 attribute_value_t *value,
+                                                 attribute_type_t *type) {
+    (void)endpoint; (void)attr_id; (void)value; (void)type;
+    return -1;
+}
+
 int cluster_basic_read(uint8_t endpoint, uint32_t attr_id,
                        attribute_value_t *value, attribute_type_t *type) {
     if (endpoint != 0) return -1;
@@ -67,6 +74,12 @@ int cluster_basic_read(uint8_t endpoint, uint32_t attr_id,
     return -1;
 }
 
+im_status_code_t cluster_basic_write(uint8_t endpoint, uint32_t attr_id,
+                                     const attribute_value_t *value) {
+    (void)endpoint; (void)attr_id; (void)value;
+    return IM_STATUS_UNSUPPORTED_WRITE;
+}
+
 // Test: Encode report with single attribute
 void test_encode_report_single_attribute(void) {
     printf("Test: Encode ReportData with single attribute...\n");
@@ -306,7 +319,7 @@ void test_send_report_with_paths(void) {
         {1, 0x0008, 0x0000, false}
     };
     
-    int result = report_generator_send_report(200, 111, paths, 2);
+    int result = report_generator_send_report(200, 111, paths, 2, NULL, 0, NULL, NULL);
     
     if (result == 0) {
         printf("  ✓ Report sent successfully\n");
@@ -8,8 +8,10 @@
 #include <string.h>
 #include <assert.h>
 #include "../../src/matter_minimal/interaction/subscribe_handler.h"
+#include "../../src/matter_minimal/interaction/report_generator.h"
 #include "../../src/matter_minimal/interaction/interaction_model.h"
 #include "../../src/matter_minimal/codec/tlv.h"
+#include "../../src/matter_minimal/codec/msg_pool.h"
 
 // Test counter
 static int tests_passed = 0;
@@ -54,6 +56,13 @@ int cluster_diagnostics_read(uint8_t endpoint, uint32_t attr_id,
     return -1;
 }
 
+int cluster_network_commissioning_read_attribute(uint8_t endpoint, uint32_t attr_id,
+                                                 attribute_value_t *value,
+                                                 attribute_type_t *type) {
+    (void)endpoint; (void)attr_id; (void)value; (void)type;
+    return -1;
+}
+
 int cluster_basic_read(uint8_t endpoint, uint32_t attr_id,
                        attribute_value_t *value, attribute_type_t *type) {
     if (endpoint != 0) return -1;
@@ -66,6 +75,12 @@ int cluster_basic_read(uint8_t endpoint, uint32_t attr_id,
     return -1;
 }
 
+im_status_code_t cluster_basic_write(uint8_t endpoint, uint32_t attr_id,
+                                     const attribute_value_t *value) {
+    (void)endpoint; (void)attr_id; (void)value;
+    return IM_STATUS_UNSUPPORTED_WRITE;
+}
+
 // Helper to create a SubscribeRequest TLV
 static size_t create_subscribe_request(uint8_t endpoint, uint32_t cluster_id,
                                        uint32_t attr_id, uint16_t min_interval,
@@ -106,9 +121,10 @@ void test_subscribe_request_parsing(void) {
     uint8_t response[256];
     size_t response_len;
     
+    im_status_code_t status;
     int result = subscribe_handler_process_request(request, request_len,
                                                    response, sizeof(response),
-                                                   &response_len, 100);
+                                                   &response_len, 100, NULL, &status);
     
     if (result == 0 && response_len > 0) {
         printf("  ✓ SubscribeRequest parsed successfully\n");
@@ -130,9 +146,10 @@ void test_subscribe_response_encoding(void) {
     uint8_t response[256];
     size_t response_len;
     
+    im_status_code_t status;
     int result = subscribe_handler_process_request(request, request_len,
                                                    response, sizeof(response),
-                                                   &response_len, 101);
+                                                   &response_len, 101, NULL, &status);
     
     if (result == 0 && response_len > 0) {
         // Parse response to verify structure
@@ -337,9 +354,641 @@ void test_subscription_expiry(void) {
     }
 }
 
+// Fake report transport: records what the engine sends
+static int sent_count = 0;
+static uint16_t sent_session = 0;
+static uint32_t sent_subscription = 0;
+static bool sent_has_attributes = false;
+static int sent_attribute_count = 0;
+static bool sent_more_chunks = false;
+static int sender_result = REPORT_SEND_OK;
+
+static int fake_sender(uint16_t session_id, packet_buffer_t *pb) {
+    tlv_reader_t reader;
+    tlv_element_t element;
+    
+    if (sender_result != REPORT_SEND_OK) {
+        msg_pool_release(pb);
+        return sender_result;
+    }
+    
+    sent_count++;
+    sent_session = session_id;
+    sent_subscription = 0;
+    sent_has_attributes = false;
+    sent_attribute_count = 0;
+    sent_more_chunks = false;
+    
+    tlv_reader_init(&reader, packet_buffer_data(pb), pb->length);
+    if (tlv_reader_next(&reader, &element) == 0 && element.tag == 0) {
+        sent_subscription = element.value.u32;
+    }
+    if (tlv_reader_next(&reader, &element) == 0 && element.tag == 1) {
+        sent_has_attributes = true;
+        
+        // Count AttributeReport structures directly inside the array
+        int depth = 1;
+        while (depth > 0 && tlv_reader_next(&reader, &element) == 0) {
+            if (element.type == TLV_TYPE_END_OF_CONTAINER) {
+                depth--;
+            } else if (element.type == TLV_TYPE_STRUCTURE ||
+                       element.type == TLV_TYPE_LIST ||
+                       element.type == TLV_TYPE_ARRAY) {
+                if (depth == 1) {
+                    sent_attribute_count++;
+                }
+                depth++;
+            }
+        }
+    }
+    while (tlv_reader_next(&reader, &element) == 0) {
+        if (element.tag == 3 && element.type == TLV_TYPE_BOOL) {
+            sent_more_chunks = element.value.boolean;
+        }
+    }
+    
+    msg_pool_release(pb);
+    return REPORT_SEND_OK;
+}
+
+static uint32_t add_onoff_subscription(uint16_t session_id,
+                                       uint16_t min_interval, uint16_t max_interval) {
+    attribute_path_t path = {1, 0x0006, 0x0000, false};
+    return subscribe_handler_add(session_id, &path, min_interval, max_interval);
+}
+
+// Test: First report, then changes coalesced within min_interval
+void test_report_engine_min_interval(void) {
+    printf("Test: Report engine coalesces changes within min_interval...\n");
+    
+    subscribe_handler_clear_all();
+    report_generator_set_sender(fake_sender);
+    sender_result = REPORT_SEND_OK;
+    sent_count = 0;
+    
+    uint32_t t = 100000;
+    subscribe_handler_check_intervals(t);
+    uint32_t sub_id = add_onoff_subscription(200, 2, 60);
+    
+    // First report with current values on the next pass
+    int reports = subscribe_handler_check_intervals(t);
+    if (reports != 1 || sent_count != 1 || sent_session != 200 ||
+        sent_subscription != sub_id || !sent_has_attributes) {
+        printf("  ✗ Initial report not sent\n");
+        tests_failed++;
+        return;
+    }
+    
+    // Two changes inside the window: nothing sent until it closes
+    subscribe_handler_notify_change(1, 0x0006, 0x0000, t + 500);
+    subscribe_handler_notify_change(1, 0x0006, 0x0000, t + 1000);
+    reports = subscribe_handler_check_intervals(t + 1000);
+    
+    uint32_t deadline = 0;
+    if (reports != 0 || !subscribe_handler_next_deadline(&deadline) ||
+        deadline != t + 2000) {
+        printf("  ✗ Report not held until min_interval (deadline %u)\n",
+               (unsigned)deadline);
+        tests_failed++;
+        return;
+    }
+    
+    reports = subscribe_handler_check_intervals(t + 2000);
+    if (reports != 1 || sent_count != 2 || !sent_has_attributes) {
+        printf("  ✗ Coalesced report not sent\n");
+        tests_failed++;
+        return;
+    }
+    
+    // Unrelated attribute does not trigger a report
+    subscribe_handler_notify_change(1, 0x0008, 0x0000, t + 5000);
+    if (subscribe_handler_check_intervals(t + 5000) != 0) {
+        printf("  ✗ Unrelated change reported\n");
+        tests_failed++;
+        return;
+    }
+    
+    // A change after the window is reported on the next pass
+    subscribe_handler_notify_change(1, 0x0006, 0x0000, t + 9000);
+    if (subscribe_handler_check_intervals(t + 9000) != 1 || sent_count != 3) {
+        printf("  ✗ Change after min_interval not reported immediately\n");
+        tests_failed++;
+        return;
+    }
+    
+    printf("  ✓ One report per min_interval window\n");
+    tests_passed++;
+}
+
+// Test: Keep-alive at max_interval carries no attributes
+void test_report_engine_keep_alive(void) {
+    printf("Test: Report engine sends max_interval keep-alives...\n");
+    
+    subscribe_handler_clear_all();
+    report_generator_set_sender(fake_sender);
+    sender_result = REPORT_SEND_OK;
+    
+    uint32_t t = 200000;
+    subscribe_handler_check_intervals(t);
+    uint32_t sub_id = add_onoff_subscription(201, 1, 10);
+    subscribe_handler_check_intervals(t);
+    sent_count = 0;
+    
+    if (subscribe_handler_check_intervals(t + 9999) != 0 ||
+        subscribe_handler_check_intervals(t + 10000) != 1 ||
+        sent_count != 1 || sent_subscription != sub_id || sent_has_attributes) {
+        printf("  ✗ Keep-alive missing or not empty\n");
+        tests_failed++;
+        return;
+    }
+    
+    printf("  ✓ Empty ReportData at max_interval\n");
+    tests_passed++;
+}
+
+// Test: Deadline heap orders subscriptions and survives removal
+void test_report_engine_deadlines(void) {
+    printf("Test: Report engine deadline queue...\n");
+    
+    subscribe_handler_clear_all();
+    report_generator_set_sender(fake_sender);
+    sender_result = REPORT_SEND_OK;
+    
+    uint32_t t = 300000;
+    subscribe_handler_check_intervals(t);
+    uint32_t ids[5];
+    static const uint16_t max_intervals[5] = {30, 5, 20, 10, 40};
+    for (int i = 0; i < 5; i++) {
+        ids[i] = add_onoff_subscription((uint16_t)(210 + i), 1, max_intervals[i]);
+    }
+    subscribe_handler_check_intervals(t);
+    
+    // Remove the earliest (5 s) and one from the middle (20 s)
+    subscribe_handler_remove(211, ids[1]);
+    subscribe_handler_remove(212, ids[2]);
+    
+    uint32_t deadline = 0;
+    if (!subscribe_handler_next_deadline(&deadline) || deadline != t + 10000) {
+        printf("  ✗ Wrong earliest deadline after removal\n");
+        tests_failed++;
+        return;
+    }
+    
+    // Keep-alives come due in order 10 s, 30 s, 40 s
+    sent_count = 0;
+    subscribe_handler_check_intervals(t + 10000);
+    bool ok = sent_count == 1 && sent_subscription == ids[3];
+    subscribe_handler_check_intervals(t + 30000);
+    ok = ok && sent_count == 3;     // 30 s, and the 10 s one again (due at 20 s)
+    subscribe_handler_check_intervals(t + 40000);
+    ok = ok && sent_count == 5;
+    
+    if (!ok) {
+        printf("  ✗ Keep-alives out of order (sent %d)\n", sent_count);
+        tests_failed++;
+        return;
+    }
+    
+    printf("  ✓ Deadlines served in order\n");
+    tests_passed++;
+}
+
+// Test: Failed sends are retried, closed sessions drop the subscription
+void test_report_engine_send_failures(void) {
+    printf("Test: Report engine send failures...\n");
+    
+    subscribe_handler_clear_all();
+    report_generator_set_sender(fake_sender);
+    
+    uint32_t t = 400000;
+    subscribe_handler_check_intervals(t);
+    uint32_t sub_id = add_onoff_subscription(220, 1, 60);
+    
+    sender_result = REPORT_SEND_RETRY;
+    sent_count = 0;
+    if (subscribe_handler_check_intervals(t) != 0) {
+        printf("  ✗ Failed send counted as report\n");
+        tests_failed++;
+        return;
+    }
+    
+    // Still dirty: retried after SUBSCRIPTION_RETRY_MS with attribute data
+    sender_result = REPORT_SEND_OK;
+    if (subscribe_handler_check_intervals(t + SUBSCRIPTION_RETRY_MS) != 1 ||
+        !sent_has_attributes) {
+        printf("  ✗ Report not retried\n");
+        tests_failed++;
+        return;
+    }
+    
+    sender_result = REPORT_SEND_NO_SESSION;
+    subscribe_handler_notify_change(1, 0x0006, 0x0000, t + 10000);
+    subscribe_handler_check_intervals(t + 10000);
+    sender_result = REPORT_SEND_OK;
+    
+    if (subscribe_handler_get_subscription(sub_id) != NULL ||
+        subscribe_handler_next_deadline(NULL)) {
+        printf("  ✗ Subscription kept after its session closed\n");
+        tests_failed++;
+        return;
+    }
+    
+    printf("  ✓ Retry on failure, removal on closed session\n");
+    tests_passed++;
+}
+
+// Test: One SubscribeRequest with several paths reports changes together
+void test_multi_path_subscription(void) {
+    printf("Test: Multi-path subscription batches changes...\n");
+    
+    subscribe_handler_clear_all();
+    report_generator_set_sender(fake_sender);
+    sender_result = REPORT_SEND_OK;
+    
+    uint32_t t = 500000;
+    subscribe_handler_check_intervals(t);
+    
+    // OnOff, LevelControl and Temperature on endpoint 1, plus every
+    // attribute of BasicInformation on endpoint 0 (attribute omitted)
+    uint8_t request[256];
+    tlv_writer_t writer;
+    tlv_writer_init(&writer, request, sizeof(request));
+    tlv_encode_array_start(&writer, 0);
+    static const uint32_t clusters[3] = {0x0006, 0x0008, 0x0402};
+    for (int i = 0; i < 3; i++) {
+        tlv_encode_structure_start(&writer, 0xFF);
+        tlv_encode_uint8(&writer, 0, 1);
+        tlv_encode_uint32(&writer, 2, clusters[i]);
+        tlv_encode_uint32(&writer, 3, 0x0000);
+        tlv_encode_container_end(&writer);
+    }
+    tlv_encode_structure_start(&writer, 0xFF);
+    tlv_encode_uint8(&writer, 0, 0);
+    tlv_encode_uint32(&writer, 2, 0x0028);
+    tlv_encode_container_end(&writer);
+    tlv_encode_container_end(&writer);
+    tlv_encode_uint16(&writer, 2, 1);
+    tlv_encode_uint16(&writer, 3, 60);
+    
+    uint8_t response[64];
+    size_t response_len;
+    uint32_t id = 0;
+    im_status_code_t status;
+    if (subscribe_handler_process_request(request, tlv_writer_get_length(&writer),
+                                          response, sizeof(response),
+                                          &response_len, 230, &id, &status) < 0 ||
+        subscribe_handler_get_count() != 1) {
+        printf("  ✗ Expected one subscription for the request\n");
+        tests_failed++;
+        return;
+    }
+    
+    // First report, sent as the priming report: the three concrete paths
+    // and the ten BasicInformation attributes the wildcard expands to
+    sent_count = 0;
+    bool more = true;
+    if (subscribe_handler_send_priming(id, t, &more) != REPORT_SEND_OK || more ||
+        subscribe_handler_activate(id, t) < 0 ||
+        sent_count != 1 || sent_attribute_count != 13) {
+        printf("  ✗ First report had %d attributes\n", sent_attribute_count);
+        tests_failed++;
+        return;
+    }
+    
+    // Four changes within min_interval, one through the wildcard path,
+    // one repeated, one not subscribed
+    subscribe_handler_notify_change(1, 0x0006, 0x0000, t + 100);
+    subscribe_handler_notify_change(1, 0x0008, 0x0000, t + 200);
+    subscribe_handler_notify_change(1, 0x0402, 0x0000, t + 300);
+    subscribe_handler_notify_change(0, 0x0028, 0x0001, t + 400);
+    subscribe_handler_notify_change(1, 0x0006, 0x0000, t + 500);
+    subscribe_handler_notify_change(1, 0x0028, 0x0001, t + 600);
+    
+    subscribe_handler_check_intervals(t + 999);
+    if (sent_count != 1) {
+        printf("  ✗ Report sent inside min_interval\n");
+        tests_failed++;
+        return;
+    }
+    
+    subscribe_handler_check_intervals(t + 1000);
+    if (sent_count != 2 || sent_attribute_count != 4) {
+        printf("  ✗ Expected one report with 4 attributes, got %d reports / %d\n",
+               sent_count - 1, sent_attribute_count);
+        tests_failed++;
+        return;
+    }
+    
+    printf("  ✓ One ReportData with every changed attribute\n");
+    tests_passed++;
+}
+
+// Test: Wildcard path matching
+void test_wildcard_path_matching(void) {
+    printf("Test: Wildcard path matching...\n");
+    
+    attribute_path_t all_on_ep1 = {1, 0, 0,
+        ATTR_PATH_WILDCARD_CLUSTER | ATTR_PATH_WILDCARD_ATTRIBUTE};
+    attribute_path_t onoff_any_ep = {0, 0x0006, 0x0000, ATTR_PATH_WILDCARD_ENDPOINT};
+    attribute_path_t concrete = {1, 0x0006, 0x0000, 0};
+    
+    bool ok = attribute_path_matches(&all_on_ep1, 1, 0x0402, 0x0000) &&
+              !attribute_path_matches(&all_on_ep1, 0, 0x0028, 0x0001) &&
+              attribute_path_matches(&onoff_any_ep, 2, 0x0006, 0x0000) &&
+              !attribute_path_matches(&onoff_any_ep, 1, 0x0006, 0x4000) &&
+              attribute_path_matches(&concrete, 1, 0x0006, 0x0000) &&
+              !attribute_path_matches(&concrete, 1, 0x0008, 0x0000);
+    
+    if (ok) {
+        printf("  ✓ Wildcard fields match any value\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ Wildcard matching wrong\n");
+        tests_failed++;
+    }
+}
+
+// Test: Wildcard subscription primes every attribute it covers
+void test_wildcard_subscription(void) {
+    printf("Test: Wildcard subscription priming and changes...\n");
+    
+    subscribe_handler_clear_all();
+    report_generator_set_sender(fake_sender);
+    sender_result = REPORT_SEND_OK;
+    
+    uint32_t t = 600000;
+    subscribe_handler_check_intervals(t);
+    
+    // Whole device, plus a concrete path the device does not have
+    attribute_path_t paths[2] = {
+        {0, 0, 0, ATTR_PATH_WILDCARD_ENDPOINT | ATTR_PATH_WILDCARD_CLUSTER |
+                  ATTR_PATH_WILDCARD_ATTRIBUTE},
+        {1, 0x0006, 0x4000, 0},
+    };
+    uint32_t sub_id = subscribe_handler_add_paths(240, paths, 2, 1, 60);
+    
+    // Every non-list attribute in the table, plus the status; more than
+    // one report holds, so the rest follows in the same pass
+    size_t expected = 1;
+    for (size_t i = 0; i < attribute_table_count(); i++) {
+        if (!(attribute_table_get(i)->quality & ATTR_QUALITY_LIST)) {
+            expected++;
+        }
+    }
+    
+    sent_count = 0;
+    int total = 0;
+    int reports = subscribe_handler_check_intervals(t);
+    if (reports >= 1 && sent_count == reports) {
+        total = sent_attribute_count + (reports - 1) * MAX_READ_PATHS;
+    }
+    if (expected <= MAX_READ_PATHS || reports != 2 || total != (int)expected) {
+        printf("  ✗ Priming sent %d reports / %d attributes, expected %zu\n",
+               reports, total, expected);
+        tests_failed++;
+        return;
+    }
+    
+    // Non-reportable and unknown attributes do not schedule a report
+    if (subscribe_handler_notify_change(1, 0x0033, 0x0003, t + 5000) != 0 ||
+        subscribe_handler_notify_change(1, 0x0006, 0x4000, t + 5000) != 0 ||
+        subscribe_handler_check_intervals(t + 5000) != 0) {
+        printf("  ✗ Non-reportable change scheduled a report\n");
+        tests_failed++;
+        return;
+    }
+    
+    // A reportable change is sent alone
+    if (subscribe_handler_notify_change(0, 0x0031, 0x0004, t + 6000) != 1 ||
+        subscribe_handler_check_intervals(t + 6000) != 1 ||
+        sent_subscription != sub_id || sent_attribute_count != 1) {
+        printf("  ✗ Change not reported through the wildcard\n");
+        tests_failed++;
+        return;
+    }
+    
+    printf("  ✓ Wildcard priming split over %d reports, changes by table bit\n",
+           reports);
+    tests_passed++;
+}
+
+// Test: Priming reports go out in chunks before the subscription is scheduled
+void test_subscribe_priming(void) {
+    printf("Test: SubscribeRequest priming chunks...\n");
+    
+    subscribe_handler_clear_all();
+    report_generator_set_sender(fake_sender);
+    sender_result = REPORT_SEND_OK;
+    
+    uint32_t t = 650000;
+    subscribe_handler_check_intervals(t);
+    
+    // Whole device: more attributes than one report holds
+    uint8_t request[64];
+    tlv_writer_t writer;
+    tlv_writer_init(&writer, request, sizeof(request));
+    tlv_encode_array_start(&writer, 0);
+    tlv_encode_structure_start(&writer, 0xFF);
+    tlv_encode_container_end(&writer);
+    tlv_encode_container_end(&writer);
+    tlv_encode_uint16(&writer, 2, 1);
+    tlv_encode_uint16(&writer, 3, 60);
+    
+    uint8_t response[64];
+    size_t response_len;
+    uint32_t id = 0;
+    im_status_code_t status;
+    bool ok = subscribe_handler_process_request(request, tlv_writer_get_length(&writer),
+                                                response, sizeof(response),
+                                                &response_len, 245, &id, &status) == 0;
+    
+    // Nothing is scheduled while priming, even after a change
+    sent_count = 0;
+    subscribe_handler_notify_change(1, 0x0006, 0x0000, t);
+    ok = ok && subscribe_handler_check_intervals(t) == 0 && sent_count == 0;
+    
+    // Each chunk but the last carries MoreChunkedMessages
+    bool more = true;
+    bool flagged = true;
+    while (ok && more && sent_count < 4) {
+        ok = subscribe_handler_send_priming(id, t, &more) == REPORT_SEND_OK;
+        flagged = flagged && sent_more_chunks == more;
+    }
+    ok = ok && !more && flagged && sent_count == 2;
+    
+    // Scheduled once the SubscribeResponse is out: keep-alive after
+    // max_interval, no more priming
+    ok = ok && subscribe_handler_activate(id, t + 100) == 0 &&
+         subscribe_handler_send_priming(id, t, &more) != REPORT_SEND_OK &&
+         subscribe_handler_check_intervals(t + 59000) == 0 &&
+         subscribe_handler_check_intervals(t + 60100) == 1 &&
+         sent_has_attributes == false;
+    
+    if (ok) {
+        printf("  ✓ Two priming chunks, then the report schedule\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ Wrong priming (%d reports sent)\n", sent_count);
+        tests_failed++;
+    }
+    
+    subscribe_handler_clear_all();
+}
+
+// Test: DataVersionFilter trims the first report
+void test_subscribe_data_version_filter(void) {
+    printf("Test: SubscribeRequest with DataVersionFilter...\n");
+    
+    subscribe_handler_clear_all();
+    report_generator_set_sender(fake_sender);
+    sender_result = REPORT_SEND_OK;
+    
+    uint32_t t = 700000;
+    subscribe_handler_check_intervals(t);
+    
+    uint32_t onoff_version;
+    attribute_table_get_data_version(1, 0x0006, &onoff_version);
+    
+    // OnOff and LevelControl; the controller already has OnOff
+    uint8_t request[256];
+    tlv_writer_t writer;
+    tlv_writer_init(&writer, request, sizeof(request));
+    tlv_encode_array_start(&writer, 0);
+    static const uint32_t clusters[2] = {0x0006, 0x0008};
+    for (int i = 0; i < 2; i++) {
+        tlv_encode_structure_start(&writer, 0xFF);
+        tlv_encode_uint8(&writer, 0, 1);
+        tlv_encode_uint32(&writer, 2, clusters[i]);
+        tlv_encode_uint32(&writer, 3, 0x0000);
+        tlv_encode_container_end(&writer);
+    }
+    tlv_encode_container_end(&writer);
+    tlv_encode_uint16(&writer, 2, 1);
+    tlv_encode_uint16(&writer, 3, 60);
+    tlv_encode_array_start(&writer, 8);
+    tlv_encode_structure_start(&writer, 0xFF);
+    tlv_encode_structure_start(&writer, 0);
+    tlv_encode_uint8(&writer, 1, 1);
+    tlv_encode_uint32(&writer, 2, 0x0006);
+    tlv_encode_container_end(&writer);
+    tlv_encode_uint32(&writer, 1, onoff_version);
+    tlv_encode_container_end(&writer);
+    tlv_encode_container_end(&writer);
+    
+    uint8_t response[64];
+    size_t response_len;
+    uint32_t id = 0;
+    im_status_code_t status;
+    if (subscribe_handler_process_request(request, tlv_writer_get_length(&writer),
+                                          response, sizeof(response),
+                                          &response_len, 250, &id, &status) < 0) {
+        printf("  ✗ SubscribeRequest rejected\n");
+        tests_failed++;
+        return;
+    }
+    
+    sent_count = 0;
+    bool more = true;
+    if (subscribe_handler_send_priming(id, t, &more) != REPORT_SEND_OK || more ||
+        subscribe_handler_activate(id, t) < 0 ||
+        sent_count != 1 || sent_attribute_count != 1) {
+        printf("  ✗ First report had %d attributes, expected 1\n", sent_attribute_count);
+        tests_failed++;
+        return;
+    }
+    
+    // Later OnOff changes are still reported
+    subscribe_handler_notify_change(1, 0x0006, 0x0000, t + 5000);
+    if (subscribe_handler_check_intervals(t + 5000) != 1 || sent_attribute_count != 1) {
+        printf("  ✗ Filtered cluster change not reported\n");
+        tests_failed++;
+        return;
+    }
+    
+    printf("  ✓ Unchanged cluster left out of the first report only\n");
+    tests_passed++;
+}
+
+/**
+ * Build a SubscribeRequest for OnOff on endpoint 1, repeated count times
+ */
+static size_t create_multi_path_request(size_t count, uint8_t *buf, size_t len) {
+    tlv_writer_t writer;
+    tlv_writer_init(&writer, buf, len);
+    tlv_encode_array_start(&writer, 0);
+    for (size_t i = 0; i < count; i++) {
+        tlv_encode_structure_start(&writer, 0xFF);
+        tlv_encode_uint8(&writer, 0, 1);
+        tlv_encode_uint32(&writer, 2, 0x0006);
+        tlv_encode_uint32(&writer, 3, 0x0000);
+        tlv_encode_container_end(&writer);
+    }
+    tlv_encode_container_end(&writer);
+    tlv_encode_uint16(&writer, 2, 1);
+    tlv_encode_uint16(&writer, 3, 60);
+    return tlv_writer_get_length(&writer);
+}
+
+// Test: Too many paths are refused before the session's subscriptions go
+void test_subscribe_path_limit(void) {
+    printf("Test: SubscribeRequest path limit...\n");
+    
+    subscribe_handler_clear_all();
+    
+    attribute_path_t path = {
+        .endpoint = 1,
+        .cluster_id = 0x0006,
+        .attribute_id = 0x0000,
+        .wildcard = false
+    };
+    uint32_t existing = subscribe_handler_add(260, &path, 1, 10);
+    
+    uint8_t request[512];
+    uint8_t response[64];
+    size_t response_len;
+    im_status_code_t status = IM_STATUS_SUCCESS;
+    
+    // One path over the limit: refused, the existing subscription is kept
+    size_t len = create_multi_path_request(SUBSCRIPTION_MAX_PATHS + 1,
+                                           request, sizeof(request));
+    bool ok = subscribe_handler_process_request(request, len, response, sizeof(response),
+                                                &response_len, 260, NULL, &status) < 0 &&
+              status == IM_STATUS_RESOURCE_EXHAUSTED &&
+              subscribe_handler_get_subscription(existing) != NULL;
+    
+    // Exactly at the limit: replaces it
+    len = create_multi_path_request(SUBSCRIPTION_MAX_PATHS, request, sizeof(request));
+    ok = ok && subscribe_handler_process_request(request, len, response, sizeof(response),
+                                                 &response_len, 260, NULL, &status) == 0 &&
+         subscribe_handler_get_subscription(existing) == NULL &&
+         subscribe_handler_get_count() == 1;
+    
+    // No free slot: refused, the other sessions' subscriptions are kept
+    for (int i = 0; i < MAX_SUBSCRIPTIONS; i++) {
+        subscribe_handler_add(261, &path, 1, 10);
+    }
+    len = create_multi_path_request(1, request, sizeof(request));
+    ok = ok && subscribe_handler_process_request(request, len, response, sizeof(response),
+                                                 &response_len, 262, NULL, &status) < 0 &&
+         status == IM_STATUS_RESOURCE_EXHAUSTED &&
+         subscribe_handler_get_count() == MAX_SUBSCRIPTIONS;
+    
+    if (ok) {
+        printf("  ✓ Over-limit and no-slot requests refused, subscriptions kept\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ Wrong path limit handling (status 0x%02X)\n", status);
+        tests_failed++;
+    }
+    
+    subscribe_handler_clear_all();
+}
+
 int main() {
     printf("=== Matter Subscribe Handler Tests ===\n\n");
     
+    msg_pool_init();
+    
     // Initialize subscribe handler
     if (subscribe_handler_init() < 0) {
         printf("ERROR: Failed to initialize subscribe handler\n");
@@ -354,6 +1003,16 @@ int main() {
     test_subscription_limit();
     test_remove_subscription();
     test_subscription_expiry();
+    test_report_engine_min_interval();
+    test_report_engine_keep_alive();
+    test_report_engine_deadlines();
+    test_report_engine_send_failures();
+    test_multi_path_subscription();
+    test_wildcard_path_matching();
+    test_wildcard_subscription();
+    test_subscribe_priming();
+    test_subscribe_data_version_filter();
+    test_subscribe_path_limit();
     
     // Summary
     printf("\n=== Test Summary ===\n");
@@ -0,0 +1,310 @@
+/*
+ * test_write_handler.c
+ * Unit tests for Matter WriteRequest/WriteResponse handler
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "../../src/matter_minimal/interaction/write_handler.h"
+#include "../../src/matter_minimal/interaction/attribute_table.h"
+#include "../../src/matter_minimal/codec/tlv.h"
+
+// Test counter
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Mock cluster read functions
+#define MOCK_UNREADABLE(name) \
+    int name(uint8_t endpoint, uint32_t attr_id, \
+             attribute_value_t *value, attribute_type_t *type) { \
+        (void)endpoint; (void)attr_id; (void)value; (void)type; \
+        return -1; \
+    }
+
+MOCK_UNREADABLE(cluster_descriptor_read)
+MOCK_UNREADABLE(cluster_basic_read)
+MOCK_UNREADABLE(cluster_network_commissioning_read_attribute)
+MOCK_UNREADABLE(cluster_onoff_read)
+MOCK_UNREADABLE(cluster_level_control_read)
+MOCK_UNREADABLE(cluster_diagnostics_read)
+MOCK_UNREADABLE(cluster_temperature_read)
+
+// Mock Basic Information writes: NodeLabel up to 32 characters
+static char node_label[33];
+static int write_calls = 0;
+
+im_status_code_t cluster_basic_write(uint8_t endpoint, uint32_t attr_id,
+                                     const attribute_value_t *value) {
+    write_calls++;
+    if (endpoint != 0 || attr_id != 0x0005) {
+        return IM_STATUS_UNSUPPORTED_WRITE;
+    }
+    if (value->string_val.len > 32) {
+        return IM_STATUS_CONSTRAINT_ERROR;
+    }
+    memcpy(node_label, value->string_val.str, value->string_val.len);
+    node_label[value->string_val.len] = '\0';
+    return IM_STATUS_SUCCESS;
+}
+
+/**
+ * Attribute write of a test WriteRequest
+ */
+typedef struct {
+    uint8_t endpoint;
+    uint32_t cluster_id;
+    uint32_t attribute_id;
+    const char *label;              // String value, or NULL for uint8 42
+    bool has_version;
+    uint32_t data_version;
+} test_write_t;
+
+static size_t build_write(uint8_t *buf, size_t len, bool suppress, bool timed,
+                          const test_write_t *writes, size_t count) {
+    tlv_writer_t w;
+    tlv_writer_init(&w, buf, len);
+    tlv_encode_structure_start(&w, 0xFF);
+    tlv_encode_bool(&w, 0, suppress);
+    tlv_encode_bool(&w, 1, timed);
+    tlv_encode_array_start(&w, 2);
+    for (size_t i = 0; i < count; i++) {
+        tlv_encode_structure_start(&w, 0xFF);
+        if (writes[i].has_version) {
+            tlv_encode_uint32(&w, 0, writes[i].data_version);
+        }
+        tlv_encode_list_start(&w, 1);
+        tlv_encode_uint8(&w, 0, writes[i].endpoint);
+        tlv_encode_uint32(&w, 2, writes[i].cluster_id);
+        tlv_encode_uint32(&w, 3, writes[i].attribute_id);
+        tlv_encode_container_end(&w);
+        if (writes[i].label) {
+            tlv_encode_string(&w, 2, writes[i].label);
+        } else {
+            tlv_encode_uint8(&w, 2, 42);
+        }
+        tlv_encode_container_end(&w);
+    }
+    tlv_encode_container_end(&w);
+    tlv_encode_container_end(&w);
+    return tlv_writer_get_length(&w);
+}
+
+/**
+ * Statuses of a WriteResponse's AttributeStatusIBs, in order
+ */
+static size_t response_statuses(const uint8_t *buf, size_t len, uint8_t *statuses,
+                                size_t max) {
+    tlv_reader_t r;
+    tlv_element_t e;
+    size_t depth = 0;
+    uint8_t parent = 0;
+    size_t count = 0;
+
+    // WriteResponses [0] / AttributeStatusIB / Status [1] / Status [0]
+    tlv_reader_init(&r, buf, len);
+    while (tlv_reader_next(&r, &e) == 0) {
+        if (e.type == TLV_TYPE_END_OF_CONTAINER) {
+            depth--;
+        } else if (e.type == TLV_TYPE_STRUCTURE || e.type == TLV_TYPE_ARRAY ||
+                   e.type == TLV_TYPE_LIST) {
+            depth++;
+            parent = e.tag;
+        } else if (depth == 3 && parent == 1 && e.tag == 0 && count < max) {
+            statuses[count++] = tlv_read_uint8(&e);
+        }
+    }
+    return count;
+}
+
+// Test: Writable, read-only and missing attributes
+void test_write_statuses(void) {
+    printf("Test: WriteResponse statuses...\n");
+
+    uint8_t request[512];
+    uint8_t response[256];
+    uint8_t statuses[8];
+    size_t response_len = 0;
+    bool suppress = true;
+    im_status_code_t status;
+    uint32_t before, after;
+    const test_write_t writes[] = {
+        { 0, 0x0028, 0x0005, "Boiler room", false, 0 },    // NodeLabel
+        { 0, 0x0028, 0x0001, "Vendor", false, 0 },         // VendorName, read-only
+        { 0, 0x0028, 0x4000, "x", false, 0 },              // No such attribute
+        { 9, 0x0028, 0x0005, "x", false, 0 },              // No such endpoint
+        { 0, 0x0028, 0x0005, NULL, false, 0 },             // Wrong type
+        { 0, 0x0028, 0x0005, "0123456789012345678901234567890123", false, 0 },
+    };
+
+    attribute_table_init(0x1234);
+    attribute_table_get_data_version(0, 0x0028, &before);
+    write_calls = 0;
+
+    size_t len = build_write(request, sizeof(request), false, false, writes, 6);
+    int ret = write_handler_process_request(request, len, false, IM_AUTH_PASE, 0,
+                                            response, sizeof(response),
+                                            &response_len, &suppress, &status);
+    size_t n = response_statuses(response, response_len, statuses, 8);
+    attribute_table_get_data_version(0, 0x0028, &after);
+
+    bool ok = ret == 0 && status == IM_STATUS_SUCCESS && !suppress && n == 6 &&
+              statuses[0] == IM_STATUS_SUCCESS &&
+              statuses[1] == IM_STATUS_UNSUPPORTED_WRITE &&
+              statuses[2] == IM_STATUS_UNSUPPORTED_ATTRIBUTE &&
+              statuses[3] == IM_STATUS_UNSUPPORTED_ENDPOINT &&
+              statuses[4] == IM_STATUS_INVALID_DATA_TYPE &&
+              statuses[5] == IM_STATUS_CONSTRAINT_ERROR;
+    // Only the two NodeLabel strings reached the cluster; one was stored
+    ok = ok && write_calls == 2 && strcmp(node_label, "Boiler room") == 0 &&
+         after == before + 1;
+
+    if (ok) {
+        printf("  ✓ One status per write, DataVersion bumped once\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ Wrong statuses (ret %d, %zu statuses, %d writes)\n",
+               ret, n, write_calls);
+        tests_failed++;
+    }
+}
+
+// Test: Writes conditional on the cluster's DataVersion
+void test_write_data_version(void) {
+    printf("Test: WriteRequest DataVersion...\n");
+
+    uint8_t request[256];
+    uint8_t response[128];
+    uint8_t statuses[4];
+    size_t response_len;
+    bool suppress;
+    im_status_code_t status;
+    uint32_t version;
+
+    attribute_table_get_data_version(0, 0x0028, &version);
+    test_write_t writes[] = {
+        { 0, 0x0028, 0x0005, "Stale", true, version - 1 },
+        { 0, 0x0028, 0x0005, "Current", true, version },
+    };
+
+    size_t len = build_write(request, sizeof(request), false, false, writes, 2);
+    bool ok = write_handler_process_request(request, len, false, IM_AUTH_PASE, 0,
+                                            response, sizeof(response),
+                                            &response_len, &suppress, &status) == 0 &&
+              response_statuses(response, response_len, statuses, 4) == 2 &&
+              statuses[0] == IM_STATUS_DATA_VERSION_MISMATCH &&
+              statuses[1] == IM_STATUS_SUCCESS &&
+              strcmp(node_label, "Current") == 0;
+
+    if (ok) {
+        printf("  ✓ Stale version refused, current version written\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ Wrong DataVersion handling\n");
+        tests_failed++;
+    }
+}
+
+// Test: Request-level handling: suppress, timed mismatch, wildcards, no room
+void test_write_request_flags(void) {
+    printf("Test: WriteRequest flags...\n");
+
+    uint8_t request[256];
+    uint8_t response[128];
+    size_t response_len;
+    bool suppress = false;
+    im_status_code_t status;
+    const test_write_t label = { 0, 0x0028, 0x0005, "Suppressed", false, 0 };
+
+    // SuppressResponse: still written, caller told not to answer
+    size_t len = build_write(request, sizeof(request), true, false, &label, 1);
+    bool ok = write_handler_process_request(request, len, false, IM_AUTH_PASE, 0,
+                                            response, sizeof(response),
+                                            &response_len, &suppress, &status) == 0 &&
+              suppress && strcmp(node_label, "Suppressed") == 0;
+
+    // TimedRequest flag without a TimedRequest: nothing written
+    write_calls = 0;
+    len = build_write(request, sizeof(request), false, true, &label, 1);
+    ok = ok && write_handler_process_request(request, len, false, IM_AUTH_PASE, 0,
+                                             response, sizeof(response),
+                                             &response_len, &suppress, &status) < 0 &&
+         status == IM_STATUS_TIMED_REQUEST_MISMATCH && write_calls == 0;
+
+    // Wildcard path (attribute omitted)
+    tlv_writer_t w;
+    tlv_writer_init(&w, request, sizeof(request));
+    tlv_encode_array_start(&w, 2);
+    tlv_encode_structure_start(&w, 0xFF);
+    tlv_encode_list_start(&w, 1);
+    tlv_encode_uint8(&w, 0, 0);
+    tlv_encode_uint32(&w, 2, 0x0028);
+    tlv_encode_container_end(&w);
+    tlv_encode_string(&w, 2, "Everything");
+    tlv_encode_container_end(&w);
+    tlv_encode_container_end(&w);
+    ok = ok && write_handler_process_request(request, tlv_writer_get_length(&w), false, IM_AUTH_PASE, 0,
+                                             response, sizeof(response),
+                                             &response_len, &suppress, &status) < 0 &&
+         status == IM_STATUS_INVALID_ACTION && write_calls == 0;
+
+    // Valid write followed by a wildcard one: refused before the first is applied
+    tlv_writer_init(&w, request, sizeof(request));
+    tlv_encode_array_start(&w, 2);
+    tlv_encode_structure_start(&w, 0xFF);
+    tlv_encode_list_start(&w, 1);
+    tlv_encode_uint8(&w, 0, 0);
+    tlv_encode_uint32(&w, 2, 0x0028);
+    tlv_encode_uint32(&w, 3, 0x0005);
+    tlv_encode_container_end(&w);
+    tlv_encode_string(&w, 2, "Partial");
+    tlv_encode_container_end(&w);
+    tlv_encode_structure_start(&w, 0xFF);
+    tlv_encode_list_start(&w, 1);
+    tlv_encode_uint8(&w, 0, 0);
+    tlv_encode_uint32(&w, 2, 0x0028);
+    tlv_encode_container_end(&w);
+    tlv_encode_string(&w, 2, "Everything");
+    tlv_encode_container_end(&w);
+    tlv_encode_container_end(&w);
+    ok = ok && write_handler_process_request(request, tlv_writer_get_length(&w), false, IM_AUTH_PASE, 0,
+                                             response, sizeof(response),
+                                             &response_len, &suppress, &status) < 0 &&
+         status == IM_STATUS_INVALID_ACTION && write_calls == 0 &&
+         strcmp(node_label, "Suppressed") == 0;
+
+    // Statuses do not fit: nothing written
+    len = build_write(request, sizeof(request), false, false, &label, 1);
+    ok = ok && write_handler_process_request(request, len, false, IM_AUTH_PASE, 0,
+                                             response, 12,
+                                             &response_len, &suppress, &status) < 0 &&
+         status == IM_STATUS_RESOURCE_EXHAUSTED && write_calls == 0;
+
+    // Unsecured session: nothing written
+    len = build_write(request, sizeof(request), false, false, &label, 1);
+    ok = ok && write_handler_process_request(request, len, false, IM_AUTH_NONE, 0,
+                                             response, sizeof(response),
+                                             &response_len, &suppress, &status) < 0 &&
+         status == IM_STATUS_UNSUPPORTED_ACCESS && write_calls == 0;
+
+    if (ok) {
+        printf("  ✓ Suppress honoured, mismatch, wildcard, oversized and unsecured refused\n");
+        tests_passed++;
+    } else {
+        printf("  ✗ Wrong request flag handling\n");
+        tests_failed++;
+    }
+}
+
+int main(void) {
+    printf("=== Matter Write Handler Tests ===\n\n");
+
+    test_write_statuses();
+    test_write_data_version();
+    test_write_request_flags();
+
+    printf("\n=== Test Summary ===\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return (tests_failed == 0) ? 0 : 1;
+}
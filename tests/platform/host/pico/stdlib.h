@@ -0,0 +1,27 @@
+/*
+ * pico/stdlib.h (host stand-in)
+ * Just the Pico SDK time API matter_attributes.cpp uses, on a clock the
+ * tests set
+ */
+
+#ifndef HOST_PICO_STDLIB_H
+#define HOST_PICO_STDLIB_H
+
+#include <stdint.h>
+
+typedef uint64_t absolute_time_t;
+
+/**
+ * Current time in milliseconds since boot; tests advance it
+ */
+extern uint32_t host_now_ms;
+
+static inline absolute_time_t get_absolute_time(void) {
+    return (absolute_time_t)host_now_ms * 1000u;
+}
+
+static inline uint32_t to_ms_since_boot(absolute_time_t t) {
+    return (uint32_t)(t / 1000u);
+}
+
+#endif // HOST_PICO_STDLIB_H
@@ -0,0 +1,288 @@
+/*
+ * test_matter_attributes.cpp
+ *
+ * Test suite for the attribute store's reportable-change thresholds
+ *
+ * Runs on the host: pico/stdlib.h is a stand-in with a clock the tests
+ * set, and the storage adapter and attribute table are faked below.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "matter_attributes.h"
+
+// Host clock (pico/stdlib.h stand-in)
+uint32_t host_now_ms = 0;
+
+// Fake flash: one saved value, enough for the thresholds
+static char stored_key[32];
+static uint8_t stored_value[128];
+static size_t stored_len = 0;
+
+extern "C" {
+
+int storage_adapter_write(const char *key, const uint8_t *value, size_t value_len) {
+    if (value_len > sizeof(stored_value)) {
+        return -1;
+    }
+    strncpy(stored_key, key, sizeof(stored_key) - 1);
+    memcpy(stored_value, value, value_len);
+    stored_len = value_len;
+    return 0;
+}
+
+int storage_adapter_read(const char *key, uint8_t *value, size_t max_value_len,
+                         size_t *actual_len) {
+    if (stored_len == 0 || strcmp(key, stored_key) != 0 || stored_len > max_value_len) {
+        return -1;
+    }
+    memcpy(value, stored_value, stored_len);
+    *actual_len = stored_len;
+    return 0;
+}
+
+int attribute_table_bump_data_version(uint8_t endpoint, uint32_t cluster_id) {
+    (void)endpoint;
+    (void)cluster_id;
+    return 0;
+}
+
+}
+
+// Reports seen by the subscriber
+static int report_count = 0;
+static size_t last_change_count = 0;
+static matter_attr_value_t last_value;
+
+static void record_reports(const matter_attr_change_t *changes, size_t count) {
+    report_count++;
+    last_change_count = count;
+    if (count > 0) {
+        last_value = changes[count - 1].value;
+    }
+}
+
+// Test helper macros
+#define TEST_START(name) printf("\n=== Test: %s ===\n", name)
+#define TEST_PASS() printf("✓ PASSED\n")
+#define TEST_FAIL(msg) printf("✗ FAILED: %s\n", msg)
+#define ASSERT_EQ(a, b, msg) if ((a) != (b)) { TEST_FAIL(msg); return -1; }
+#define ASSERT_TRUE(cond, msg) if (!(cond)) { TEST_FAIL(msg); return -1; }
+
+/**
+ * Start a test from a clean store: one registered attribute with the
+ * given initial value and threshold, and the subscriber counting reports
+ */
+static int setup_attribute(matter_attr_id_t id, uint8_t endpoint, uint32_t cluster_id,
+                           uint32_t attribute_id, matter_attr_type_t type,
+                           const matter_attr_value_t *initial,
+                           const matter_report_threshold_t *threshold) {
+    matter_attributes_clear();
+    if (matter_attributes_register(endpoint, cluster_id, attribute_id, type, initial) != 0 ||
+        matter_attributes_set_report_threshold(id, threshold) != 0 ||
+        matter_attributes_subscribe(record_reports) < 0) {
+        return -1;
+    }
+    report_count = 0;
+    return 0;
+}
+
+static int set_temperature(int16_t centidegrees) {
+    matter_attr_value_t value;
+    value.int16_val = centidegrees;
+    return matter_attributes_set(MATTER_ATTR_ID_MEASURED_VALUE, &value);
+}
+
+/**
+ * Test 1: Below-Threshold Suppression
+ * Moves smaller than abs_delta are stored but not reported
+ */
+int test_below_threshold_suppressed(void) {
+    TEST_START("Below-Threshold Suppression");
+
+    matter_attr_value_t initial;
+    initial.int16_val = 2000;
+    matter_report_threshold_t threshold = {200, 0, 0};
+    int result = setup_attribute(MATTER_ATTR_ID_MEASURED_VALUE, 1,
+                                 MATTER_CLUSTER_TEMPERATURE_MEASUREMENT,
+                                 MATTER_ATTR_MEASURED_VALUE, MATTER_TYPE_INT16,
+                                 &initial, &threshold);
+    ASSERT_EQ(result, 0, "Setup failed");
+    host_now_ms = 10000;
+
+    // Drift of 1.5 °C: stored, not reported
+    ASSERT_EQ(set_temperature(2150), 0, "Set failed");
+    matter_attributes_process_reports();
+    ASSERT_EQ(report_count, 0, "Below-threshold change was reported");
+
+    matter_attr_value_t value;
+    ASSERT_EQ(matter_attributes_read(MATTER_ATTR_ID_MEASURED_VALUE, &value), 0, "Read failed");
+    ASSERT_EQ(value.int16_val, 2150, "Below-threshold change not stored");
+
+    // Wobble back to the reported value: nothing to report either
+    ASSERT_EQ(set_temperature(2000), 0, "Set failed");
+    matter_attributes_process_reports();
+    ASSERT_EQ(report_count, 0, "Wobble was reported");
+
+    // 2 °C from the last reported value: reported once
+    ASSERT_EQ(set_temperature(1800), 0, "Set failed");
+    matter_attributes_process_reports();
+    matter_attributes_process_reports();
+    ASSERT_EQ(report_count, 1, "Threshold crossing not reported once");
+    ASSERT_EQ(last_change_count, 1, "Wrong change set size");
+    ASSERT_EQ(last_value.int16_val, 1800, "Wrong reported value");
+
+    TEST_PASS();
+    return 0;
+}
+
+/**
+ * Test 2: Quiet Time Hold and Release
+ * A reportable change inside min_quiet_ms is held until the quiet time ends
+ */
+int test_quiet_time_hold_release(void) {
+    TEST_START("Quiet Time Hold and Release");
+
+    matter_attr_value_t initial;
+    initial.int16_val = 2000;
+    matter_report_threshold_t threshold = {100, 5000, 0};
+    int result = setup_attribute(MATTER_ATTR_ID_MEASURED_VALUE, 1,
+                                 MATTER_CLUSTER_TEMPERATURE_MEASUREMENT,
+                                 MATTER_ATTR_MEASURED_VALUE, MATTER_TYPE_INT16,
+                                 &initial, &threshold);
+    ASSERT_EQ(result, 0, "Setup failed");
+
+    // First report starts the quiet time
+    host_now_ms = 20000;
+    ASSERT_EQ(set_temperature(2200), 0, "Set failed");
+    matter_attributes_process_reports();
+    ASSERT_EQ(report_count, 1, "First change not reported");
+
+    // Reportable change 1 s later: held
+    host_now_ms = 21000;
+    ASSERT_EQ(set_temperature(2500), 0, "Set failed");
+    matter_attributes_process_reports();
+    ASSERT_EQ(report_count, 1, "Change reported inside the quiet time");
+
+    host_now_ms = 24999;
+    matter_attributes_process_reports();
+    ASSERT_EQ(report_count, 1, "Held change released early");
+
+    // Quiet time over: the held change goes out with its latest value
+    host_now_ms = 25000;
+    matter_attributes_process_reports();
+    ASSERT_EQ(report_count, 2, "Held change not released after the quiet time");
+    ASSERT_EQ(last_value.int16_val, 2500, "Wrong released value");
+
+    TEST_PASS();
+    return 0;
+}
+
+/**
+ * Test 3: Percent Threshold from Zero
+ * With a last reported value of 0 any move counts as a reportable change
+ */
+int test_percent_from_zero(void) {
+    TEST_START("Percent Threshold from Zero");
+
+    matter_attr_value_t initial;
+    initial.uint8_val = 0;
+    matter_report_threshold_t threshold = {0, 0, 10};
+    int result = setup_attribute(MATTER_ATTR_ID_CURRENT_LEVEL, 1,
+                                 MATTER_CLUSTER_LEVEL_CONTROL,
+                                 MATTER_ATTR_CURRENT_LEVEL, MATTER_TYPE_UINT8,
+                                 &initial, &threshold);
+    ASSERT_EQ(result, 0, "Setup failed");
+    host_now_ms = 30000;
+
+    matter_attr_value_t value;
+    value.uint8_val = 1;
+    ASSERT_EQ(matter_attributes_set(MATTER_ATTR_ID_CURRENT_LEVEL, &value), 0, "Set failed");
+    matter_attributes_process_reports();
+    ASSERT_EQ(report_count, 1, "Move away from zero not reported");
+    ASSERT_EQ(last_value.uint8_val, 1, "Wrong reported value");
+
+    // From 1 on the percent applies again: below 10 % of 50 is held back
+    value.uint8_val = 50;
+    matter_attributes_set(MATTER_ATTR_ID_CURRENT_LEVEL, &value);
+    matter_attributes_process_reports();
+    value.uint8_val = 54;
+    matter_attributes_set(MATTER_ATTR_ID_CURRENT_LEVEL, &value);
+    matter_attributes_process_reports();
+    ASSERT_EQ(report_count, 2, "Percent threshold not applied");
+
+    TEST_PASS();
+    return 0;
+}
+
+/**
+ * Test 4: Save and Load Round Trip
+ * Saved thresholds come back; a blob saved for another store layout is
+ * refused
+ */
+int test_save_load_round_trip(void) {
+    TEST_START("Save and Load Round Trip");
+
+    matter_report_threshold_t temperature = {200, 10000, 0};
+    matter_report_threshold_t level = {0, 5000, 5};
+    matter_report_threshold_t readback;
+
+    matter_attributes_set_report_threshold(MATTER_ATTR_ID_MEASURED_VALUE, &temperature);
+    matter_attributes_set_report_threshold(MATTER_ATTR_ID_CURRENT_LEVEL, &level);
+    ASSERT_EQ(matter_attributes_save_report_thresholds(), 0, "Save failed");
+
+    // Overwrite, then load the saved ones back
+    matter_attributes_set_report_threshold(MATTER_ATTR_ID_MEASURED_VALUE, NULL);
+    matter_attributes_set_report_threshold(MATTER_ATTR_ID_CURRENT_LEVEL, NULL);
+    ASSERT_EQ(matter_attributes_load_report_thresholds(), 0, "Load failed");
+
+    matter_attributes_get_report_threshold(MATTER_ATTR_ID_MEASURED_VALUE, &readback);
+    ASSERT_TRUE(readback.abs_delta == 200 && readback.min_quiet_ms == 10000 &&
+                readback.percent == 0, "Temperature threshold mismatch");
+    matter_attributes_get_report_threshold(MATTER_ATTR_ID_CURRENT_LEVEL, &readback);
+    ASSERT_TRUE(readback.abs_delta == 0 && readback.min_quiet_ms == 5000 &&
+                readback.percent == 5, "Level threshold mismatch");
+
+    // A different store layout (hash leads the blob) leaves them unchanged
+    stored_value[0] ^= 0x01;
+    matter_attributes_set_report_threshold(MATTER_ATTR_ID_MEASURED_VALUE, NULL);
+    ASSERT_TRUE(matter_attributes_load_report_thresholds() != 0,
+                "Blob for another layout was loaded");
+    matter_attributes_get_report_threshold(MATTER_ATTR_ID_MEASURED_VALUE, &readback);
+    ASSERT_EQ(readback.abs_delta, 0u, "Thresholds changed by a refused blob");
+
+    TEST_PASS();
+    return 0;
+}
+
+/**
+ * Run all attribute store tests
+ */
+int run_all_matter_attributes_tests(void) {
+    int passed = 0;
+    int failed = 0;
+
+    if (matter_attributes_init() != 0) {
+        printf("✗ Attribute system init failed\n");
+        return -1;
+    }
+
+    // Run tests
+    if (test_below_threshold_suppressed() == 0) passed++; else failed++;
+    if (test_quiet_time_hold_release() == 0) passed++; else failed++;
+    if (test_percent_from_zero() == 0) passed++; else failed++;
+    if (test_save_load_round_trip() == 0) passed++; else failed++;
+
+    // Print summary
+    printf("\n");
+    printf("=== Test Results ===\n");
+    printf("Passed: %d\n", passed);
+    printf("Failed: %d\n", failed);
+
+    return (failed == 0) ? 0 : -1;
+}
+
+int main(void) {
+    return run_all_matter_attributes_tests() == 0 ? 0 : 1;
+}
@@ -0,0 +1,372 @@
+/*
+ * bench_crypto.c
+ * Crypto operation benchmark: PBKDF2, P-256, ECDSA, HKDF, AES-128-CCM,
+ * SHA-256
+ *
+ * Runs each primitive the PASE / CASE / session code uses over a range
+ * of parameters (PBKDF2 iterations, message and output lengths) and
+ * prints per-operation latency from the crypto_stats counters, plus the
+ * loop's wall-clock time per operation (more precise on a fast host,
+ * where one operation can take well under a microsecond).
+ *
+ * Builds for the host (tests/security, when mbedTLS is installed) and as
+ * a standalone RP2040 image (BUILD_BENCH_CRYPTO=ON in the top-level
+ * build; results are printed on USB serial).  Known-answer and round-trip
+ * checks make it double as a test.
+ *
+ * The stack only uses P-256 and AES-128, so those are the only key sizes.
+ */
+
+#include "crypto_stats.h"
+#include "p256_fixed.h"
+#include "session_mgr.h"
+#include <stdio.h>
+#include <string.h>
+
+#include "mbedtls/md.h"
+#include "mbedtls/pkcs5.h"
+#include "mbedtls/hkdf.h"
+#include "mbedtls/sha256.h"
+#include "mbedtls/ecp.h"
+#include "mbedtls/ecdsa.h"
+#include "mbedtls/bignum.h"
+#include "pico/rand.h"
+#include "pico/time.h"
+
+// mbedTLS 2.x has no private-member accessor
+#ifndef MBEDTLS_PRIVATE
+#define MBEDTLS_PRIVATE(member) member
+#endif
+
+#ifdef BENCH_CRYPTO_ON_DEVICE
+#include "pico/stdlib.h"
+// Cortex-M0+ at 125 MHz: keep each case to a few seconds
+#define BENCH_ROUNDS_SLOW           2       // PBKDF2
+#define BENCH_ROUNDS_EC             5       // Scalar multiplications, ECDSA
+#define BENCH_ROUNDS_FAST           200     // HKDF, CCM, SHA-256
+#else
+#define BENCH_ROUNDS_SLOW           5
+#define BENCH_ROUNDS_EC             50
+#define BENCH_ROUNDS_FAST           20000
+#endif
+
+#define BENCH_SESSION_ID            0x2002
+#define BENCH_MAX_MESSAGE           1024
+
+static int failures;
+
+static uint8_t message[BENCH_MAX_MESSAGE];
+static uint8_t sealed[SESSION_NONCE_LENGTH + BENCH_MAX_MESSAGE + SESSION_TAG_LENGTH];
+static uint8_t opened[BENCH_MAX_MESSAGE];
+
+static int rng(void *ctx, unsigned char *buf, size_t len) {
+    (void)ctx;
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)get_rand_32();
+    }
+    return 0;
+}
+
+static void check(int ok, const char *what) {
+    if (!ok) {
+        printf("FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+/**
+ * Print one result row: counters for op, and the loop's time per operation
+ */
+static void report(const char *label, crypto_op_t op, uint64_t loop_start) {
+    uint64_t loop_us = time_us_64() - loop_start;
+    crypto_op_stats_t s;
+    crypto_stats_get(op, &s);
+    if (s.count == 0) {
+        printf("%-30s no samples\n", label);
+        return;
+    }
+    printf("%-30s %6lu %10lu %10lu %10lu %12llu\n", label,
+           (unsigned long)s.count,
+           (unsigned long)(s.total_us / s.count),
+           (unsigned long)s.min_us, (unsigned long)s.max_us,
+           (unsigned long long)(loop_us * 1000u / s.count));
+}
+
+static void bench_pbkdf2(void) {
+    static const uint32_t iterations[] = {1000, 2000, 5000};
+    static const uint8_t pin[] = "20202021";
+    uint8_t salt[32];
+    uint8_t out[64];
+    rng(NULL, salt, sizeof(salt));
+
+    const mbedtls_md_info_t *md = mbedtls_md_info_from_type(MBEDTLS_MD_SHA256);
+    mbedtls_md_context_t md_ctx;
+    mbedtls_md_init(&md_ctx);
+    check(mbedtls_md_setup(&md_ctx, md, 1) == 0, "md_setup");
+
+    for (size_t i = 0; i < sizeof(iterations) / sizeof(iterations[0]); i++) {
+        char label[40];
+        snprintf(label, sizeof(label), "PBKDF2 %lu iterations",
+                 (unsigned long)iterations[i]);
+        crypto_stats_reset();
+        uint64_t loop = time_us_64();
+        for (int r = 0; r < BENCH_ROUNDS_SLOW; r++) {
+            uint64_t t0 = crypto_stats_begin();
+            int ret = mbedtls_pkcs5_pbkdf2_hmac(&md_ctx, pin, 8, salt, sizeof(salt),
+                                                iterations[i], sizeof(out), out);
+            crypto_stats_end(CRYPTO_OP_PBKDF2, t0, 0);
+            check(ret == 0, "pbkdf2");
+        }
+        report(label, CRYPTO_OP_PBKDF2, loop);
+    }
+    mbedtls_md_free(&md_ctx);
+}
+
+static void bench_p256(void) {
+    uint8_t k[P256_SCALAR_LENGTH];
+    uint8_t pub[P256_POINT_LENGTH];
+    uint8_t ref[P256_POINT_LENGTH];
+    uint8_t out[P256_POINT_LENGTH];
+    size_t olen;
+
+    mbedtls_ecp_group grp;
+    mbedtls_ecp_point Q, R;
+    mbedtls_mpi d;
+    mbedtls_ecp_group_init(&grp);
+    mbedtls_ecp_point_init(&Q);
+    mbedtls_ecp_point_init(&R);
+    mbedtls_mpi_init(&d);
+    check(mbedtls_ecp_group_load(&grp, MBEDTLS_ECP_DP_SECP256R1) == 0, "group_load");
+
+    // k*G: comb table vs. mbedTLS
+    crypto_stats_reset();
+    uint64_t loop = time_us_64();
+    for (int r = 0; r < BENCH_ROUNDS_EC; r++) {
+        do {
+            rng(NULL, k, sizeof(k));
+        } while (p256_scalar_check(k) != 0);
+        uint64_t t0 = crypto_stats_begin();
+        check(p256_fixed_mul(P256_BASE_G, k, pub) == 0, "p256_fixed_mul");
+        crypto_stats_end(CRYPTO_OP_KEYGEN, t0, 0);
+    }
+    report("P-256 k*G (comb table)", CRYPTO_OP_KEYGEN, loop);
+
+    crypto_stats_reset();
+    loop = time_us_64();
+    for (int r = 0; r < BENCH_ROUNDS_EC; r++) {
+        uint64_t t0 = crypto_stats_begin();
+        int ret = mbedtls_mpi_read_binary(&d, k, sizeof(k));
+        if (ret == 0) ret = mbedtls_ecp_mul(&grp, &R, &d, &grp.MBEDTLS_PRIVATE(G), rng, NULL);
+        crypto_stats_end(CRYPTO_OP_KEYGEN, t0, 0);
+        check(ret == 0, "ecp_mul(G)");
+    }
+    report("P-256 k*G (mbedTLS)", CRYPTO_OP_KEYGEN, loop);
+    check(mbedtls_ecp_point_write_binary(&grp, &R, MBEDTLS_ECP_PF_UNCOMPRESSED,
+                                         &olen, ref, sizeof(ref)) == 0 &&
+          memcmp(ref, pub, sizeof(pub)) == 0, "comb k*G matches mbedTLS");
+
+    // SPAKE2+ pB = y*G + w0*N
+    crypto_stats_reset();
+    loop = time_us_64();
+    for (int r = 0; r < BENCH_ROUNDS_EC; r++) {
+        uint64_t t0 = crypto_stats_begin();
+        check(p256_fixed_add(pub, P256_BASE_N, k, out) == 0, "p256_fixed_add");
+        crypto_stats_end(CRYPTO_OP_P256_FIXED, t0, 0);
+    }
+    report("SPAKE2+ P + k*N (comb table)", CRYPTO_OP_P256_FIXED, loop);
+
+    // ECDH: variable base (the peer's public key)
+    check(mbedtls_ecp_point_read_binary(&grp, &Q, pub, sizeof(pub)) == 0,
+          "point_read_binary");
+    crypto_stats_reset();
+    loop = time_us_64();
+    for (int r = 0; r < BENCH_ROUNDS_EC; r++) {
+        uint64_t t0 = crypto_stats_begin();
+        int ret = mbedtls_ecp_mul(&grp, &R, &d, &Q, rng, NULL);
+        crypto_stats_end(CRYPTO_OP_ECDH, t0, 0);
+        check(ret == 0, "ecp_mul(ECDH)");
+    }
+    report("ECDH P-256 (mbedTLS)", CRYPTO_OP_ECDH, loop);
+
+    mbedtls_mpi_free(&d);
+    mbedtls_ecp_point_free(&R);
+    mbedtls_ecp_point_free(&Q);
+    mbedtls_ecp_group_free(&grp);
+}
+
+static void bench_ecdsa(void) {
+    static const size_t lengths[] = {32, 256, 1024};
+    uint8_t hash[32];
+
+    mbedtls_ecp_group grp;
+    mbedtls_ecp_point Q;
+    mbedtls_mpi d, r, s;
+    mbedtls_ecp_group_init(&grp);
+    mbedtls_ecp_point_init(&Q);
+    mbedtls_mpi_init(&d);
+    mbedtls_mpi_init(&r);
+    mbedtls_mpi_init(&s);
+    check(mbedtls_ecp_group_load(&grp, MBEDTLS_ECP_DP_SECP256R1) == 0 &&
+          mbedtls_ecp_gen_keypair(&grp, &d, &Q, rng, NULL) == 0, "gen_keypair");
+
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        size_t len = lengths[i];
+        char label[40];
+
+        // Sign = hash + ECDSA, as attestation_sign_challenge() does
+        crypto_stats_reset();
+        uint64_t loop = time_us_64();
+        for (int n = 0; n < BENCH_ROUNDS_EC; n++) {
+            uint64_t t0 = crypto_stats_begin();
+            mbedtls_sha256(message, len, hash, 0);
+            int ret = mbedtls_ecdsa_sign(&grp, &r, &s, &d, hash, sizeof(hash), rng, NULL);
+            crypto_stats_end(CRYPTO_OP_ECDSA_SIGN, t0, len);
+            check(ret == 0, "ecdsa_sign");
+        }
+        snprintf(label, sizeof(label), "ECDSA sign %u B", (unsigned)len);
+        report(label, CRYPTO_OP_ECDSA_SIGN, loop);
+
+        crypto_stats_reset();
+        loop = time_us_64();
+        for (int n = 0; n < BENCH_ROUNDS_EC; n++) {
+            uint64_t t0 = crypto_stats_begin();
+            mbedtls_sha256(message, len, hash, 0);
+            int ret = mbedtls_ecdsa_verify(&grp, hash, sizeof(hash), &Q, &r, &s);
+            crypto_stats_end(CRYPTO_OP_ECDSA_VERIFY, t0, len);
+            check(ret == 0, "ecdsa_verify");
+        }
+        snprintf(label, sizeof(label), "ECDSA verify %u B", (unsigned)len);
+        report(label, CRYPTO_OP_ECDSA_VERIFY, loop);
+    }
+
+    // A modified message must not verify
+    message[0] ^= 1;
+    mbedtls_sha256(message, lengths[0], hash, 0);
+    check(mbedtls_ecdsa_verify(&grp, hash, sizeof(hash), &Q, &r, &s) != 0,
+          "ecdsa_verify rejects modified message");
+    message[0] ^= 1;
+
+    mbedtls_mpi_free(&s);
+    mbedtls_mpi_free(&r);
+    mbedtls_mpi_free(&d);
+    mbedtls_ecp_point_free(&Q);
+    mbedtls_ecp_group_free(&grp);
+}
+
+static void bench_hkdf(void) {
+    static const size_t lengths[] = {16, 32, 48, 64};
+    static const uint8_t info[] = "SigmaSessionKeys";
+    uint8_t salt[32], ikm[32], out[64];
+    rng(NULL, salt, sizeof(salt));
+    rng(NULL, ikm, sizeof(ikm));
+    const mbedtls_md_info_t *md = mbedtls_md_info_from_type(MBEDTLS_MD_SHA256);
+
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        char label[40];
+        snprintf(label, sizeof(label), "HKDF-SHA256 %u B out", (unsigned)lengths[i]);
+        crypto_stats_reset();
+        uint64_t loop = time_us_64();
+        for (int r = 0; r < BENCH_ROUNDS_FAST; r++) {
+            uint64_t t0 = crypto_stats_begin();
+            int ret = mbedtls_hkdf(md, salt, sizeof(salt), ikm, sizeof(ikm),
+                                   info, sizeof(info) - 1, out, lengths[i]);
+            crypto_stats_end(CRYPTO_OP_HKDF, t0, lengths[i]);
+            check(ret == 0, "hkdf");
+        }
+        report(label, CRYPTO_OP_HKDF, loop);
+    }
+}
+
+static void bench_ccm(void) {
+    static const size_t lengths[] = {16, 64, 256, 1024};
+    static const uint8_t key[SESSION_KEY_LENGTH] = {
+        0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+        0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF
+    };
+    size_t sealed_len = 0, opened_len = 0;
+
+    session_mgr_init();
+    check(session_create(BENCH_SESSION_ID, key, sizeof(key)) == 0, "session_create");
+
+    // session_encrypt() / session_decrypt() record their own samples
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        size_t len = lengths[i];
+        char label[40];
+
+        crypto_stats_reset();
+        uint64_t loop = time_us_64();
+        for (int r = 0; r < BENCH_ROUNDS_FAST; r++) {
+            check(session_encrypt(BENCH_SESSION_ID, message, len, sealed,
+                                  sizeof(sealed), &sealed_len) == 0, "session_encrypt");
+        }
+        snprintf(label, sizeof(label), "AES-128-CCM encrypt %u B", (unsigned)len);
+        report(label, CRYPTO_OP_CCM_ENCRYPT, loop);
+
+        crypto_stats_reset();
+        loop = time_us_64();
+        for (int r = 0; r < BENCH_ROUNDS_FAST; r++) {
+            check(session_decrypt(BENCH_SESSION_ID, sealed, sealed_len, opened,
+                                  sizeof(opened), &opened_len) == 0, "session_decrypt");
+        }
+        snprintf(label, sizeof(label), "AES-128-CCM decrypt %u B", (unsigned)len);
+        report(label, CRYPTO_OP_CCM_DECRYPT, loop);
+        check(opened_len == len && memcmp(opened, message, len) == 0,
+              "CCM round trip");
+    }
+
+    session_destroy(BENCH_SESSION_ID);
+}
+
+static void bench_sha256(void) {
+    static const size_t lengths[] = {64, 256, 1024};
+    uint8_t hash[32];
+
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        char label[40];
+        snprintf(label, sizeof(label), "SHA-256 %u B", (unsigned)lengths[i]);
+        crypto_stats_reset();
+        uint64_t loop = time_us_64();
+        for (int r = 0; r < BENCH_ROUNDS_FAST; r++) {
+            uint64_t t0 = crypto_stats_begin();
+            mbedtls_sha256(message, lengths[i], hash, 0);
+            crypto_stats_end(CRYPTO_OP_SHA256, t0, lengths[i]);
+        }
+        report(label, CRYPTO_OP_SHA256, loop);
+    }
+
+    // FIPS 180-2 "abc"
+    static const uint8_t abc_hash[4] = {0xba, 0x78, 0x16, 0xbf};
+    mbedtls_sha256((const uint8_t *)"abc", 3, hash, 0);
+    check(memcmp(hash, abc_hash, sizeof(abc_hash)) == 0, "SHA-256 known answer");
+}
+
+int main(void) {
+#ifdef BENCH_CRYPTO_ON_DEVICE
+    stdio_init_all();
+    sleep_ms(3000);     // Time to open the USB serial console
+#endif
+
+    for (size_t i = 0; i < sizeof(message); i++) {
+        message[i] = (uint8_t)(i * 7 + 3);
+    }
+
+    printf("=== Crypto Operation Benchmark ===\n\n");
+    printf("%-30s %6s %10s %10s %10s %12s\n",
+           "operation", "count", "avg us", "min us", "max us", "loop ns/op");
+
+    bench_pbkdf2();
+    bench_p256();
+    bench_ecdsa();
+    bench_hkdf();
+    bench_ccm();
+    bench_sha256();
+
+    printf("\n%s (%d failures)\n", failures == 0 ? "PASS" : "FAIL", failures);
+
+#ifdef BENCH_CRYPTO_ON_DEVICE
+    while (true) {
+        sleep_ms(1000);
+    }
+#endif
+    return failures == 0 ? 0 : 1;
+}
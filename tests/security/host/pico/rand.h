@@ -0,0 +1,26 @@
+/*
+ * pico/rand.h (host stand-in)
+ * Minimal Pico SDK random API for host tests: xorshift32, not
+ * cryptographically secure
+ */
+
+#ifndef HOST_PICO_RAND_H
+#define HOST_PICO_RAND_H
+
+#include <stdint.h>
+
+/**
+ * Generator state; tests may reseed it
+ */
+__attribute__((weak)) uint32_t host_rand_state = 0x2545F491u;
+
+static inline uint32_t get_rand_32(void) {
+    uint32_t x = host_rand_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    host_rand_state = x;
+    return x;
+}
+
+#endif // HOST_PICO_RAND_H
@@ -0,0 +1,29 @@
+/*
+ * pico/time.h (host stand-in)
+ * Minimal Pico SDK time API so session_mgr.c builds for host tests and
+ * benchmarks
+ */
+
+#ifndef HOST_PICO_TIME_H
+#define HOST_PICO_TIME_H
+
+#include <stdint.h>
+#include <time.h>
+
+/**
+ * Added to the monotonic clock; tests advance it to simulate idle time
+ */
+__attribute__((weak)) uint64_t host_time_offset_us = 0;
+
+static inline uint64_t time_us_64(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u +
+           host_time_offset_us;
+}
+
+static inline uint32_t time_us_32(void) {
+    return (uint32_t)time_us_64();
+}
+
+#endif // HOST_PICO_TIME_H
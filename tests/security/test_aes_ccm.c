@@ -0,0 +1,272 @@
+/*
+ * test_aes_ccm.c
+ * Known-answer tests for the AES-128 backend and fused AES-128-CCM
+ *
+ * Vectors: FIPS-197 Appendix B and C.1 (block cipher), NIST SP 800-38C
+ * Appendix C and RFC 3610 packet vectors (CCM).
+ */
+
+#include "aes_ccm.h"
+#include <stdio.h>
+#include <string.h>
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(cond, msg) do { \
+    if (!(cond)) { \
+        printf("FAIL: %s - %s\n", __func__, msg); \
+        tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define TEST_PASS() do { \
+    printf("PASS: %s\n", __func__); \
+    tests_passed++; \
+} while(0)
+
+static void fill_sequence(uint8_t *buf, size_t len, uint8_t start) {
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)(start + i);
+    }
+}
+
+/**
+ * Test FIPS-197 block vectors, both lanes of the two-block call
+ */
+void test_aes_block_vectors(void) {
+    static const uint8_t key_b[16] = {
+        0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+        0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+    };
+    static const uint8_t pt_b[16] = {
+        0x32, 0x43, 0xf6, 0xa8, 0x88, 0x5a, 0x30, 0x8d,
+        0x31, 0x31, 0x98, 0xa2, 0xe0, 0x37, 0x07, 0x34
+    };
+    static const uint8_t ct_b[16] = {
+        0x39, 0x25, 0x84, 0x1d, 0x02, 0xdc, 0x09, 0xfb,
+        0xdc, 0x11, 0x85, 0x97, 0x19, 0x6a, 0x0b, 0x32
+    };
+    static const uint8_t ct_c1[16] = {
+        0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+        0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a
+    };
+    uint8_t key_c1[16];
+    uint8_t pt_c1[16];
+    uint8_t out0[16];
+    uint8_t out1[16];
+    aes_ccm_ctx_t ctx;
+
+    fill_sequence(key_c1, sizeof(key_c1), 0x00);
+    for (int i = 0; i < 16; i++) {
+        pt_c1[i] = (uint8_t)(i * 0x11);
+    }
+
+    TEST_ASSERT(aes_ccm_setkey(&ctx, key_c1, sizeof(key_c1)) == 0, "setkey C.1");
+    aes_ccm_block_encrypt_x2(&ctx, pt_c1, pt_b, out0, out1);
+    TEST_ASSERT(memcmp(out0, ct_c1, 16) == 0, "FIPS-197 C.1 (lane 0)");
+    aes_ccm_block_encrypt_x2(&ctx, pt_b, pt_c1, out0, out1);
+    TEST_ASSERT(memcmp(out1, ct_c1, 16) == 0, "FIPS-197 C.1 (lane 1)");
+
+    TEST_ASSERT(aes_ccm_setkey(&ctx, key_b, sizeof(key_b)) == 0, "setkey B");
+    aes_ccm_block_encrypt_x2(&ctx, pt_b, pt_c1, out0, out1);
+    TEST_ASSERT(memcmp(out0, ct_b, 16) == 0, "FIPS-197 Appendix B");
+
+    // Output may overwrite the input
+    memcpy(out0, pt_b, 16);
+    aes_ccm_block_encrypt_x2(&ctx, out0, out0, out0, out1);
+    TEST_ASSERT(memcmp(out0, ct_b, 16) == 0 && memcmp(out1, ct_b, 16) == 0,
+                "In-place block encryption");
+
+    aes_ccm_free(&ctx);
+#ifndef AES_CCM_USE_MBEDTLS
+    TEST_ASSERT(ctx.rk[0][0] == 0 && ctx.rk[AES_CCM_ROUNDS][7] == 0,
+                "Key schedule not wiped");
+#endif
+
+    TEST_PASS();
+}
+
+/**
+ * Test NIST SP 800-38C examples 1 and 2
+ */
+void test_ccm_sp800_38c(void) {
+    static const uint8_t c1[] = {
+        0x71, 0x62, 0x01, 0x5b, 0x4d, 0xac, 0x25, 0x5d
+    };
+    static const uint8_t c2[] = {
+        0xd2, 0xa1, 0xf0, 0xe0, 0x51, 0xea, 0x5f, 0x62,
+        0x08, 0x1a, 0x77, 0x92, 0x07, 0x3d, 0x59, 0x3d,
+        0x1f, 0xc6, 0x4f, 0xbf, 0xac, 0xcd
+    };
+    uint8_t key[16], nonce[8], aad[16], pt[16], out[16], tag[16];
+    aes_ccm_ctx_t ctx;
+
+    fill_sequence(key, sizeof(key), 0x40);
+    fill_sequence(nonce, sizeof(nonce), 0x10);
+    fill_sequence(aad, sizeof(aad), 0x00);
+    fill_sequence(pt, sizeof(pt), 0x20);
+    TEST_ASSERT(aes_ccm_setkey(&ctx, key, sizeof(key)) == 0, "setkey");
+
+    TEST_ASSERT(aes_ccm_encrypt(&ctx, nonce, 7, aad, 8, pt, 4, out, tag, 4) == 0,
+                "Example 1 encrypt");
+    TEST_ASSERT(memcmp(out, c1, 4) == 0 && memcmp(tag, c1 + 4, 4) == 0,
+                "Example 1 mismatch");
+
+    TEST_ASSERT(aes_ccm_encrypt(&ctx, nonce, 8, aad, 16, pt, 16, out, tag, 6) == 0,
+                "Example 2 encrypt");
+    TEST_ASSERT(memcmp(out, c2, 16) == 0 && memcmp(tag, c2 + 16, 6) == 0,
+                "Example 2 mismatch");
+
+    TEST_ASSERT(aes_ccm_decrypt(&ctx, nonce, 8, aad, 16, c2, 16, out, c2 + 16, 6) == 0,
+                "Example 2 decrypt");
+    TEST_ASSERT(memcmp(out, pt, 16) == 0, "Example 2 plaintext");
+
+    aes_ccm_free(&ctx);
+    TEST_PASS();
+}
+
+/**
+ * Test RFC 3610 packet vectors 1 and 2 (13-byte nonce, as Matter uses)
+ */
+void test_ccm_rfc3610(void) {
+    static const uint8_t nonce1[13] = {
+        0x00, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00,
+        0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5
+    };
+    static const uint8_t c1[] = {
+        0x58, 0x8C, 0x97, 0x9A, 0x61, 0xC6, 0x63, 0xD2,
+        0xF0, 0x66, 0xD0, 0xC2, 0xC0, 0xF9, 0x89, 0x80,
+        0x6D, 0x5F, 0x6B, 0x61, 0xDA, 0xC3, 0x84,
+        0x17, 0xE8, 0xD1, 0x2C, 0xFD, 0xF9, 0x26, 0xE0
+    };
+    static const uint8_t nonce2[13] = {
+        0x00, 0x00, 0x00, 0x04, 0x03, 0x02, 0x01,
+        0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5
+    };
+    static const uint8_t c2[] = {
+        0x72, 0xC9, 0x1A, 0x36, 0xE1, 0x35, 0xF8, 0xCF,
+        0x29, 0x1C, 0xA8, 0x94, 0x08, 0x5C, 0x87, 0xE3,
+        0xCC, 0x15, 0xC4, 0x39, 0xC9, 0xE4, 0x3A, 0x3B,
+        0xA0, 0x91, 0xD5, 0x6E, 0x10, 0x40, 0x09, 0x16
+    };
+    uint8_t key[16], packet[32], tag[8];
+    aes_ccm_ctx_t ctx;
+
+    fill_sequence(key, sizeof(key), 0xC0);
+    TEST_ASSERT(aes_ccm_setkey(&ctx, key, sizeof(key)) == 0, "setkey");
+
+    // Header bytes 0-7 are AAD; payload encrypted in place
+    fill_sequence(packet, sizeof(packet), 0x00);
+    TEST_ASSERT(aes_ccm_encrypt(&ctx, nonce1, 13, packet, 8, packet + 8, 23,
+                                packet + 8, tag, 8) == 0, "Vector 1 encrypt");
+    TEST_ASSERT(memcmp(packet + 8, c1, 23) == 0, "Vector 1 ciphertext");
+    TEST_ASSERT(memcmp(tag, c1 + 23, 8) == 0, "Vector 1 tag");
+
+    fill_sequence(packet, sizeof(packet), 0x00);
+    TEST_ASSERT(aes_ccm_encrypt(&ctx, nonce2, 13, packet, 8, packet + 8, 24,
+                                packet + 8, tag, 8) == 0, "Vector 2 encrypt");
+    TEST_ASSERT(memcmp(packet + 8, c2, 24) == 0, "Vector 2 ciphertext");
+    TEST_ASSERT(memcmp(tag, c2 + 24, 8) == 0, "Vector 2 tag");
+
+    TEST_ASSERT(aes_ccm_decrypt(&ctx, nonce2, 13, packet, 8, packet + 8, 24,
+                                packet + 8, tag, 8) == 0, "Vector 2 decrypt");
+    for (int i = 8; i < 32; i++) {
+        TEST_ASSERT(packet[i] == i, "Vector 2 in-place plaintext");
+    }
+
+    aes_ccm_free(&ctx);
+    TEST_PASS();
+}
+
+/**
+ * Test round trips across block boundaries and tag/AAD tampering
+ */
+void test_ccm_roundtrip_and_tamper(void) {
+    uint8_t key[16], nonce[13], aad[20], pt[70], buf[70], tag[16];
+    aes_ccm_ctx_t ctx;
+
+    fill_sequence(key, sizeof(key), 0x5A);
+    fill_sequence(nonce, sizeof(nonce), 0x01);
+    fill_sequence(aad, sizeof(aad), 0x80);
+    fill_sequence(pt, sizeof(pt), 0x33);
+    TEST_ASSERT(aes_ccm_setkey(&ctx, key, sizeof(key)) == 0, "setkey");
+
+    for (size_t len = 0; len <= sizeof(pt); len++) {
+        memcpy(buf, pt, len);
+        TEST_ASSERT(aes_ccm_encrypt(&ctx, nonce, 13, aad, len % 21, buf, len,
+                                    buf, tag, 16) == 0, "Encrypt");
+        TEST_ASSERT(aes_ccm_decrypt(&ctx, nonce, 13, aad, len % 21, buf, len,
+                                    buf, tag, 16) == 0, "Decrypt");
+        TEST_ASSERT(memcmp(buf, pt, len) == 0, "Round-trip mismatch");
+    }
+
+    // Flipped ciphertext bit: rejected and output wiped
+    memcpy(buf, pt, 40);
+    TEST_ASSERT(aes_ccm_encrypt(&ctx, nonce, 13, aad, 8, buf, 40, buf, tag, 16) == 0,
+                "Encrypt");
+    buf[17] ^= 0x04;
+    TEST_ASSERT(aes_ccm_decrypt(&ctx, nonce, 13, aad, 8, buf, 40, buf, tag, 16) ==
+                AES_CCM_ERR_AUTH, "Tampered ciphertext accepted");
+    for (int i = 0; i < 40; i++) {
+        TEST_ASSERT(buf[i] == 0, "Output not wiped on auth failure");
+    }
+
+    // Modified AAD is rejected
+    memcpy(buf, pt, 40);
+    TEST_ASSERT(aes_ccm_encrypt(&ctx, nonce, 13, aad, 8, buf, 40, buf, tag, 16) == 0,
+                "Encrypt");
+    aad[3] ^= 0x01;
+    TEST_ASSERT(aes_ccm_decrypt(&ctx, nonce, 13, aad, 8, buf, 40, buf, tag, 16) ==
+                AES_CCM_ERR_AUTH, "Tampered AAD accepted");
+
+    aes_ccm_free(&ctx);
+    TEST_PASS();
+}
+
+/**
+ * Test parameter validation
+ */
+void test_ccm_invalid_params(void) {
+    uint8_t key[16] = {0}, nonce[13] = {0}, buf[16] = {0}, tag[16];
+    aes_ccm_ctx_t ctx;
+
+    TEST_ASSERT(aes_ccm_setkey(&ctx, key, 32) == AES_CCM_ERR_INVALID, "AES-256 key");
+    TEST_ASSERT(aes_ccm_setkey(&ctx, key, 16) == 0, "setkey");
+
+    TEST_ASSERT(aes_ccm_encrypt(&ctx, nonce, 6, NULL, 0, buf, 16, buf, tag, 16) ==
+                AES_CCM_ERR_INVALID, "Short nonce");
+    TEST_ASSERT(aes_ccm_encrypt(&ctx, nonce, 13, NULL, 0, buf, 16, buf, tag, 5) ==
+                AES_CCM_ERR_INVALID, "Odd tag length");
+    TEST_ASSERT(aes_ccm_encrypt(&ctx, nonce, 13, NULL, 0, buf, 16, buf, tag, 18) ==
+                AES_CCM_ERR_INVALID, "Long tag");
+    TEST_ASSERT(aes_ccm_encrypt(&ctx, nonce, 13, NULL, 4, buf, 16, buf, tag, 16) ==
+                AES_CCM_ERR_INVALID, "AAD length without AAD");
+    // 13-byte nonce leaves a 2-byte length field
+    TEST_ASSERT(aes_ccm_encrypt(&ctx, nonce, 13, NULL, 0, buf, 0x10000, buf, tag, 16) ==
+                AES_CCM_ERR_INVALID, "Length overflows L field");
+
+    aes_ccm_free(&ctx);
+    TEST_PASS();
+}
+
+/**
+ * Main test runner
+ */
+int main(void) {
+    printf("=== AES-128-CCM Tests ===\n\n");
+
+    test_aes_block_vectors();
+    test_ccm_sp800_38c();
+    test_ccm_rfc3610();
+    test_ccm_roundtrip_and_tamper();
+    test_ccm_invalid_params();
+
+    printf("\n=== Test Results ===\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,645 @@
+/*
+ * test_case.c
+ * End-to-end tests for the CASE responder: full Sigma1/2/3 handshake,
+ * initiator verification, and session resumption
+ *
+ * The test plays the initiator with its own fabric (RCAC, optional ICAC
+ * and NOCs signed with mbedTLS ECDSA).  storage_adapter_* is an
+ * in-memory fake, and there is no DAC key, so Sigma2 carries no
+ * attestation signature (not checked by this initiator).
+ */
+
+#include "case.h"
+#include "case_resumption.h"
+#include "certificate_store.h"
+#include "matter_cert.h"
+#include "session_mgr.h"
+#include "aes_ccm.h"
+#include "ephemeral_pool.h"
+#include "tlv.h"
+#include "msg_pool.h"
+#include "pico/rand.h"
+#include "mbedtls/ecp.h"
+#include "mbedtls/ecdsa.h"
+#include "mbedtls/hkdf.h"
+#include "mbedtls/md.h"
+#include "mbedtls/sha256.h"
+#include <stdio.h>
+#include <string.h>
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(cond, msg) do { \
+    if (!(cond)) { \
+        printf("FAIL: %s - %s\n", __func__, msg); \
+        tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define TEST_PASS() do { \
+    printf("PASS: %s\n", __func__); \
+    tests_passed++; \
+} while(0)
+
+/* ------------------------------------------------------------------ */
+/* Fakes                                                                */
+/* ------------------------------------------------------------------ */
+
+#define FAKE_FILES  4
+
+static struct {
+    char    key[32];
+    uint8_t data[CERT_STORE_MAX_CERT_SIZE];
+    size_t  len;
+    int     used;
+} g_files[FAKE_FILES];
+
+static int fake_find(const char *key) {
+    for (int i = 0; i < FAKE_FILES; i++) {
+        if (g_files[i].used && strcmp(g_files[i].key, key) == 0) return i;
+    }
+    return -1;
+}
+
+int storage_adapter_write(const char *key, const uint8_t *value, size_t value_len) {
+    if (value_len > CERT_STORE_MAX_CERT_SIZE) return -1;
+    int i = fake_find(key);
+    if (i < 0) {
+        for (i = 0; i < FAKE_FILES && g_files[i].used; i++) {}
+        if (i == FAKE_FILES) return -1;
+    }
+    snprintf(g_files[i].key, sizeof(g_files[i].key), "%s", key);
+    memcpy(g_files[i].data, value, value_len);
+    g_files[i].len = value_len;
+    g_files[i].used = 1;
+    return 0;
+}
+
+int storage_adapter_read(const char *key, uint8_t *value, size_t max_value_len,
+                         size_t *actual_len) {
+    int i = fake_find(key);
+    if (i < 0 || g_files[i].len > max_value_len) return -1;
+    memcpy(value, g_files[i].data, g_files[i].len);
+    *actual_len = g_files[i].len;
+    return 0;
+}
+
+int storage_adapter_delete(const char *key) {
+    int i = fake_find(key);
+    if (i >= 0) memset(&g_files[i], 0, sizeof(g_files[i]));
+    return 0;
+}
+
+/* No DAC provisioned */
+int attestation_sign_challenge(const uint8_t *challenge, size_t challenge_len,
+                               uint8_t *sig_out, size_t *sig_len) {
+    (void)challenge; (void)challenge_len; (void)sig_out; (void)sig_len;
+    return -1;
+}
+
+/* ------------------------------------------------------------------ */
+/* Initiator-side crypto                                                */
+/* ------------------------------------------------------------------ */
+
+#define FABRIC_ID       0xFAB000000000001Dull
+#define ROOT_ID         0xCACACACA00000001ull
+#define ICA_ID          0xCACACACA00000002ull
+#define DEVICE_NODE_ID  0xDEDEDEDE00010001ull
+#define PEER_NODE_ID    0x000000000001B669ull
+
+typedef struct {
+    mbedtls_ecp_group grp;
+    mbedtls_mpi       d;
+    uint8_t           pub[MATTER_CERT_PUBKEY_LEN];
+} test_key_t;
+
+static int rng(void *ctx, unsigned char *buf, size_t len) {
+    (void)ctx;
+    for (size_t i = 0; i < len; i++) buf[i] = (uint8_t)get_rand_32();
+    return 0;
+}
+
+static void key_gen(test_key_t *k) {
+    mbedtls_ecp_point q;
+    size_t olen = 0;
+    mbedtls_ecp_group_init(&k->grp);
+    mbedtls_mpi_init(&k->d);
+    mbedtls_ecp_point_init(&q);
+    mbedtls_ecp_group_load(&k->grp, MBEDTLS_ECP_DP_SECP256R1);
+    mbedtls_ecp_gen_keypair(&k->grp, &k->d, &q, rng, NULL);
+    mbedtls_ecp_point_write_binary(&k->grp, &q, MBEDTLS_ECP_PF_UNCOMPRESSED,
+                                   &olen, k->pub, sizeof(k->pub));
+    mbedtls_ecp_point_free(&q);
+}
+
+static void key_free(test_key_t *k) {
+    mbedtls_mpi_free(&k->d);
+    mbedtls_ecp_group_free(&k->grp);
+}
+
+/* ECDSA-P256-SHA256; sig is r || s */
+static void key_sign(test_key_t *k, const uint8_t *msg, size_t len,
+                     uint8_t sig[MATTER_CERT_SIGNATURE_LEN]) {
+    uint8_t hash[32];
+    mbedtls_mpi r, s;
+    mbedtls_sha256(msg, len, hash, 0);
+    mbedtls_mpi_init(&r);
+    mbedtls_mpi_init(&s);
+    mbedtls_ecdsa_sign(&k->grp, &r, &s, &k->d, hash, sizeof(hash), rng, NULL);
+    mbedtls_mpi_write_binary(&r, sig, 32);
+    mbedtls_mpi_write_binary(&s, sig + 32, 32);
+    mbedtls_mpi_free(&s);
+    mbedtls_mpi_free(&r);
+}
+
+/* Z = X(d * P) */
+static void ecdh(test_key_t *k, const uint8_t *peer_pub, uint8_t z[32]) {
+    mbedtls_ecp_point p, r;
+    mbedtls_ecp_point_init(&p);
+    mbedtls_ecp_point_init(&r);
+    mbedtls_ecp_point_read_binary(&k->grp, &p, peer_pub, MATTER_CERT_PUBKEY_LEN);
+    mbedtls_ecp_mul(&k->grp, &r, &k->d, &p, rng, NULL);
+    mbedtls_mpi_write_binary(&r.MBEDTLS_PRIVATE(X), z, 32);
+    mbedtls_ecp_point_free(&r);
+    mbedtls_ecp_point_free(&p);
+}
+
+static void hkdf(const uint8_t *salt, size_t salt_len,
+                 const uint8_t *ikm, size_t ikm_len,
+                 const char *info, uint8_t *out, size_t out_len) {
+    mbedtls_hkdf(mbedtls_md_info_from_type(MBEDTLS_MD_SHA256),
+                 salt, salt_len, ikm, ikm_len,
+                 (const uint8_t *)info, strlen(info), out, out_len);
+}
+
+/* ------------------------------------------------------------------ */
+/* Certificates                                                         */
+/* ------------------------------------------------------------------ */
+
+typedef enum { CERT_RCAC, CERT_ICAC, CERT_NOC } cert_kind_t;
+
+/* Subject DN of each kind; the issuer DN is the signer's subject DN */
+static void encode_dn(tlv_writer_t *w, uint8_t tag, cert_kind_t kind,
+                      uint64_t id) {
+    tlv_encode_list_start(w, tag);
+    if (kind == CERT_RCAC) {
+        tlv_encode_uint64(w, 20, id);
+    } else if (kind == CERT_ICAC) {
+        tlv_encode_uint64(w, 19, id);
+    } else {
+        tlv_encode_uint64(w, 17, id);
+        tlv_encode_uint64(w, 21, FABRIC_ID);
+    }
+    tlv_encode_container_end(w);
+}
+
+/*
+ * Build a certificate for key's public half, signed by signer (key itself
+ * for the RCAC).  Key IDs are the first bytes of the public keys.
+ */
+static size_t build_cert(uint8_t *buf, size_t size,
+                         cert_kind_t kind, uint64_t id, test_key_t *key,
+                         cert_kind_t signer_kind, uint64_t signer_id,
+                         test_key_t *signer) {
+    static uint8_t tbs[MATTER_CERT_MAX_TBS_SIZE];
+    uint8_t serial[] = { 0x01, (uint8_t)kind };
+    uint8_t sig[MATTER_CERT_SIGNATURE_LEN] = { 0 };
+
+    tlv_writer_t w;
+    tlv_writer_init(&w, buf, size);
+    tlv_encode_structure_start(&w, 0);
+    tlv_encode_bytes(&w, 1, serial, sizeof(serial));
+    tlv_encode_uint8(&w, 2, 1);
+    encode_dn(&w, 3, signer_kind, signer_id);
+    tlv_encode_uint32(&w, 4, 749433600u);
+    tlv_encode_uint32(&w, 5, 0);
+    encode_dn(&w, 6, kind, id);
+    tlv_encode_uint8(&w, 7, 1);
+    tlv_encode_uint8(&w, 8, 1);
+    tlv_encode_bytes(&w, 9, key->pub, MATTER_CERT_PUBKEY_LEN);
+    tlv_encode_list_start(&w, 10);
+    tlv_encode_structure_start(&w, 1);
+    tlv_encode_bool(&w, 1, kind != CERT_NOC);
+    tlv_encode_container_end(&w);
+    if (kind == CERT_NOC) {
+        tlv_encode_uint16(&w, 2, 0x0001);       /* digitalSignature */
+        tlv_encode_array_start(&w, 3);
+        tlv_encode_uint8(&w, 0, 2);             /* clientAuth */
+        tlv_encode_uint8(&w, 0, 1);             /* serverAuth */
+        tlv_encode_container_end(&w);
+    } else {
+        tlv_encode_uint16(&w, 2, 0x0060);       /* keyCertSign | cRLSign */
+    }
+    tlv_encode_bytes(&w, 4, key->pub + 1, MATTER_CERT_KEY_ID_LEN);
+    tlv_encode_bytes(&w, 5, signer->pub + 1, MATTER_CERT_KEY_ID_LEN);
+    tlv_encode_container_end(&w);
+    tlv_encode_bytes(&w, 11, sig, sizeof(sig));
+    tlv_encode_container_end(&w);
+    size_t len = tlv_writer_get_length(&w);
+
+    /* Sign the DER TBS and patch the signature (the last byte string) */
+    size_t tbs_len = 0;
+    if (matter_cert_encode_tbs(buf, len, tbs, sizeof(tbs), &tbs_len) != 0) {
+        return 0;
+    }
+    key_sign(signer, tbs, tbs_len, buf + len - 1 - MATTER_CERT_SIGNATURE_LEN);
+    return len;
+}
+
+/* ------------------------------------------------------------------ */
+/* Initiator                                                            */
+/* ------------------------------------------------------------------ */
+
+static test_key_t g_root, g_ica, g_device, g_peer, g_eph;
+static uint8_t    g_peer_noc[CERT_STORE_MAX_CERT_SIZE];
+static size_t     g_peer_noc_len;
+static uint8_t    g_peer_icac[CERT_STORE_MAX_CERT_SIZE];
+static size_t     g_peer_icac_len;
+
+/* State kept by the initiator across a handshake */
+static struct {
+    uint8_t  random[32];
+    uint8_t  shared_secret[32];
+    uint8_t  resumption_id[CASE_RESUMPTION_ID_LEN];
+    uint16_t responder_session_id;
+} g_init;
+
+static int find_bytes(const uint8_t *buf, size_t len, uint8_t tag,
+                      const uint8_t **out, size_t *out_len) {
+    tlv_reader_t r;
+    tlv_element_t el;
+    tlv_reader_init(&r, buf, len);
+    tlv_reader_next(&r, &el);                   /* Anonymous structure */
+    while (tlv_reader_next(&r, &el) == 0) {
+        if (el.type == TLV_TYPE_END_OF_CONTAINER) break;
+        if (el.tag == tag && el.type == TLV_TYPE_BYTE_STRING) {
+            *out = el.value.bytes.data;
+            *out_len = el.value.bytes.length;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static int find_uint16(const uint8_t *buf, size_t len, uint8_t tag,
+                       uint16_t *out) {
+    tlv_reader_t r;
+    tlv_element_t el;
+    tlv_reader_init(&r, buf, len);
+    tlv_reader_next(&r, &el);
+    while (tlv_reader_next(&r, &el) == 0) {
+        if (el.type == TLV_TYPE_END_OF_CONTAINER) break;
+        if (el.tag == tag && el.type == TLV_TYPE_UNSIGNED_INT) {
+            *out = el.value.u16;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static int ccm(bool encrypt, const uint8_t *key, const uint8_t *nonce,
+               const uint8_t *in, size_t len, uint8_t *out, uint8_t *tag) {
+    aes_ccm_ctx_t ctx;
+    int ret = aes_ccm_setkey(&ctx, key, 16);
+    if (ret == 0) {
+        ret = encrypt
+            ? aes_ccm_encrypt(&ctx, nonce, 13, NULL, 0, in, len, out, tag, 16)
+            : aes_ccm_decrypt(&ctx, nonce, 13, NULL, 0, in, len, out, tag, 16);
+    }
+    aes_ccm_free(&ctx);
+    return ret;
+}
+
+/*
+ * Run Sigma1/2/3 against the responder, signing Sigma3 with signer and
+ * sending the peer NOC (and ICAC, if with_icac).
+ */
+static int full_handshake(test_key_t *signer, bool with_icac) {
+    static uint8_t sigma1[CASE_SIGMA1_MAX_SIZE];
+    static uint8_t sigma2[CASE_SIGMA2_MAX_SIZE];
+    static uint8_t sigma3[CASE_SIGMA3_MAX_SIZE];
+    static uint8_t buf[CASE_SIGMA3_MAX_SIZE];
+    static uint8_t tbe[CASE_SIGMA3_MAX_SIZE];
+    const uint8_t zero_nonce[13] = { 0 };
+    uint8_t dest_id[32] = { 0 };
+    uint8_t t_hash[32], key[16];
+    size_t len1 = 0, len2 = 0, len3 = 0, out_len = 0;
+
+    key_free(&g_eph);
+    key_gen(&g_eph);
+    rng(NULL, g_init.random, sizeof(g_init.random));
+
+    tlv_writer_t w;
+    tlv_writer_init(&w, sigma1, sizeof(sigma1));
+    tlv_encode_structure_start(&w, 0);
+    tlv_encode_bytes(&w, 1, g_init.random, 32);
+    tlv_encode_uint16(&w, 2, 0x1234);
+    tlv_encode_bytes(&w, 3, dest_id, sizeof(dest_id));
+    tlv_encode_bytes(&w, 4, g_eph.pub, MATTER_CERT_PUBKEY_LEN);
+    tlv_encode_container_end(&w);
+    len1 = tlv_writer_get_length(&w);
+
+    if (case_handle_sigma1_resume(sigma1, len1, sigma2, sizeof(sigma2),
+                                  &len2) != CASE_RESUME_NOT_APPLICABLE
+            || case_handle_sigma1(sigma1, len1, sigma2, sizeof(sigma2),
+                                  &len2) != 0) {
+        return -1;
+    }
+
+    /* Sigma2: shared secret, then the resumption ID from TBE2 */
+    const uint8_t *reph = NULL, *enc2 = NULL;
+    size_t reph_len = 0, enc2_len = 0;
+    if (find_bytes(sigma2, len2, 3, &reph, &reph_len) != 0
+            || find_bytes(sigma2, len2, 4, &enc2, &enc2_len) != 0
+            || find_uint16(sigma2, len2, 2, &g_init.responder_session_id) != 0
+            || enc2_len <= 16) {
+        return -1;
+    }
+    ecdh(&g_eph, reph, g_init.shared_secret);
+    mbedtls_sha256(sigma1, len1, t_hash, 0);
+    hkdf(g_init.shared_secret, 32, t_hash, 32, "Sigma2ResumeSessionKey",
+         key, sizeof(key));
+    if (ccm(false, key, zero_nonce, enc2, enc2_len - 16, tbe,
+            (uint8_t *)enc2 + enc2_len - 16) != 0) {
+        return -1;
+    }
+    const uint8_t *rid = NULL;
+    size_t rid_len = 0;
+    if (find_bytes(tbe, enc2_len - 16, 4, &rid, &rid_len) != 0
+            || rid_len != CASE_RESUMPTION_ID_LEN) {
+        return -1;
+    }
+    memcpy(g_init.resumption_id, rid, CASE_RESUMPTION_ID_LEN);
+
+    /* Sigma3: TBS3 = { NOC, ICAC, Ieph_pub, Reph_pub }, signed */
+    uint8_t sig[MATTER_CERT_SIGNATURE_LEN];
+    tlv_writer_init(&w, buf, sizeof(buf));
+    tlv_encode_structure_start(&w, 0);
+    tlv_encode_bytes(&w, 1, g_peer_noc, g_peer_noc_len);
+    if (with_icac) tlv_encode_bytes(&w, 2, g_peer_icac, g_peer_icac_len);
+    tlv_encode_bytes(&w, 3, g_eph.pub, MATTER_CERT_PUBKEY_LEN);
+    tlv_encode_bytes(&w, 4, reph, reph_len);
+    tlv_encode_container_end(&w);
+    key_sign(signer, buf, tlv_writer_get_length(&w), sig);
+
+    tlv_writer_init(&w, buf, sizeof(buf));
+    tlv_encode_structure_start(&w, 0);
+    tlv_encode_bytes(&w, 1, g_peer_noc, g_peer_noc_len);
+    if (with_icac) tlv_encode_bytes(&w, 2, g_peer_icac, g_peer_icac_len);
+    tlv_encode_bytes(&w, 3, sig, sizeof(sig));
+    tlv_encode_container_end(&w);
+    size_t tbe3_len = tlv_writer_get_length(&w);
+
+    mbedtls_sha256_context sh;
+    mbedtls_sha256_init(&sh);
+    mbedtls_sha256_starts(&sh, 0);
+    mbedtls_sha256_update(&sh, sigma1, len1);
+    mbedtls_sha256_update(&sh, sigma2, len2);
+    mbedtls_sha256_finish(&sh, t_hash);
+    mbedtls_sha256_free(&sh);
+    hkdf(g_init.shared_secret, 32, t_hash, 32, "Sigma3TBEKey", key, sizeof(key));
+    ccm(true, key, zero_nonce, buf, tbe3_len, tbe, tbe + tbe3_len);
+
+    tlv_writer_init(&w, sigma3, sizeof(sigma3));
+    tlv_encode_structure_start(&w, 0);
+    tlv_encode_bytes(&w, 1, tbe, tbe3_len + 16);
+    tlv_encode_container_end(&w);
+    len3 = tlv_writer_get_length(&w);
+
+    return case_handle_sigma3(sigma3, len3, NULL, 0, &out_len);
+}
+
+/* Sigma1 carrying the stored resumption ID and its MIC */
+static size_t build_resume_sigma1(uint8_t *buf, size_t size, bool bad_mic) {
+    uint8_t salt[32 + CASE_RESUMPTION_ID_LEN], key[16], mic[16];
+    const uint8_t nonce[] = "NCASE_SigmaS1";
+    rng(NULL, g_init.random, sizeof(g_init.random));
+    memcpy(salt, g_init.random, 32);
+    memcpy(salt + 32, g_init.resumption_id, CASE_RESUMPTION_ID_LEN);
+    hkdf(salt, sizeof(salt), g_init.shared_secret, 32, "Sigma1_Resume",
+         key, sizeof(key));
+    ccm(true, key, nonce, NULL, 0, NULL, mic);
+    if (bad_mic) mic[0] ^= 0x01;
+
+    tlv_writer_t w;
+    tlv_writer_init(&w, buf, size);
+    tlv_encode_structure_start(&w, 0);
+    tlv_encode_bytes(&w, 1, g_init.random, 32);
+    tlv_encode_uint16(&w, 2, 0x5678);
+    tlv_encode_bytes(&w, 4, g_eph.pub, MATTER_CERT_PUBKEY_LEN);
+    tlv_encode_bytes(&w, 6, g_init.resumption_id, CASE_RESUMPTION_ID_LEN);
+    tlv_encode_bytes(&w, 7, mic, sizeof(mic));
+    tlv_encode_container_end(&w);
+    return tlv_writer_get_length(&w);
+}
+
+/* Fresh responder with the device's credentials on our fabric */
+static void setup(void) {
+    static uint8_t cert[CERT_STORE_MAX_CERT_SIZE];
+    size_t len;
+
+    case_deinit();
+    memset(g_files, 0, sizeof(g_files));
+    session_mgr_init();
+    ephemeral_pool_init();
+    case_resumption_clear();
+
+    len = build_cert(cert, sizeof(cert), CERT_RCAC, ROOT_ID, &g_root,
+                     CERT_RCAC, ROOT_ID, &g_root);
+    certificate_store_save_rcac(cert, len);
+    len = build_cert(cert, sizeof(cert), CERT_NOC, DEVICE_NODE_ID, &g_device,
+                     CERT_RCAC, ROOT_ID, &g_root);
+    certificate_store_save_noc(cert, len);
+    case_init();
+}
+
+/* ------------------------------------------------------------------ */
+/* Tests                                                                */
+/* ------------------------------------------------------------------ */
+
+/**
+ * Test that a verified initiator gets a session and a resumption ticket
+ */
+void test_verified_initiator(void) {
+    setup();
+    g_peer_noc_len = build_cert(g_peer_noc, sizeof(g_peer_noc), CERT_NOC,
+                                PEER_NODE_ID, &g_peer,
+                                CERT_RCAC, ROOT_ID, &g_root);
+    TEST_ASSERT(g_peer_noc_len > 0, "NOC build failed");
+    TEST_ASSERT(full_handshake(&g_peer, false) == 0, "Handshake failed");
+    TEST_ASSERT(session_is_active(g_init.responder_session_id),
+                "Session not created");
+    TEST_ASSERT(case_resumption_count() == 1, "No resumption ticket");
+
+    case_resumption_ticket_t ticket;
+    TEST_ASSERT(case_resumption_find(g_init.resumption_id, &ticket) == 0,
+                "Ticket not under the TBE2 resumption ID");
+    TEST_ASSERT(ticket.peer_node_id == PEER_NODE_ID, "Ticket peer node ID");
+    TEST_ASSERT(ticket.local_node_id == DEVICE_NODE_ID, "Ticket local node ID");
+    TEST_ASSERT(memcmp(ticket.shared_secret, g_init.shared_secret, 32) == 0,
+                "Ticket shared secret");
+    TEST_PASS();
+}
+
+/**
+ * Test a NOC issued through an ICAC
+ */
+void test_verified_initiator_icac(void) {
+    setup();
+    g_peer_icac_len = build_cert(g_peer_icac, sizeof(g_peer_icac), CERT_ICAC,
+                                 ICA_ID, &g_ica, CERT_RCAC, ROOT_ID, &g_root);
+    g_peer_noc_len = build_cert(g_peer_noc, sizeof(g_peer_noc), CERT_NOC,
+                                PEER_NODE_ID, &g_peer,
+                                CERT_ICAC, ICA_ID, &g_ica);
+    TEST_ASSERT(full_handshake(&g_peer, true) == 0, "Handshake failed");
+    TEST_ASSERT(case_resumption_count() == 1, "No resumption ticket");
+
+    /* Without the ICAC the NOC does not chain to the root */
+    setup();
+    TEST_ASSERT(full_handshake(&g_peer, false) == 0, "Handshake failed");
+    TEST_ASSERT(case_resumption_count() == 0, "Ticket without the ICAC");
+    TEST_PASS();
+}
+
+/**
+ * Test that unverified initiators get a session but no ticket
+ */
+void test_unverified_initiator(void) {
+    /* Sigma3 signed with a key other than the NOC's */
+    setup();
+    g_peer_noc_len = build_cert(g_peer_noc, sizeof(g_peer_noc), CERT_NOC,
+                                PEER_NODE_ID, &g_peer,
+                                CERT_RCAC, ROOT_ID, &g_root);
+    TEST_ASSERT(full_handshake(&g_ica, false) == 0, "Handshake failed");
+    TEST_ASSERT(session_is_active(g_init.responder_session_id),
+                "Session not created");
+    TEST_ASSERT(case_resumption_count() == 0, "Ticket for a bad signature");
+
+    /* NOC signed by a root other than ours */
+    setup();
+    g_peer_noc_len = build_cert(g_peer_noc, sizeof(g_peer_noc), CERT_NOC,
+                                PEER_NODE_ID, &g_peer,
+                                CERT_RCAC, ROOT_ID, &g_ica);
+    TEST_ASSERT(full_handshake(&g_peer, false) == 0, "Handshake failed");
+    TEST_ASSERT(case_resumption_count() == 0, "Ticket for a foreign root");
+
+    /* Unresumable: the advertised ID has no ticket */
+    uint8_t sigma1[CASE_SIGMA1_MAX_SIZE], out[CASE_SIGMA2_MAX_SIZE];
+    size_t len = build_resume_sigma1(sigma1, sizeof(sigma1), false);
+    size_t out_len = 0;
+    TEST_ASSERT(case_handle_sigma1_resume(sigma1, len, out, sizeof(out),
+                                          &out_len) == CASE_RESUME_NOT_APPLICABLE,
+                "Resumed without a ticket");
+    TEST_PASS();
+}
+
+/**
+ * Test resumption end to end: Sigma1 with ResumptionID and MIC is
+ * answered with a valid Sigma2_Resume and a new session
+ */
+void test_resume(void) {
+    setup();
+    g_peer_noc_len = build_cert(g_peer_noc, sizeof(g_peer_noc), CERT_NOC,
+                                PEER_NODE_ID, &g_peer,
+                                CERT_RCAC, ROOT_ID, &g_root);
+    TEST_ASSERT(full_handshake(&g_peer, false) == 0, "Handshake failed");
+    uint16_t first_session = g_init.responder_session_id;
+
+    /* A bad MIC falls back to full CASE and keeps the ticket */
+    uint8_t sigma1[CASE_SIGMA1_MAX_SIZE], out[CASE_SIGMA2_MAX_SIZE];
+    size_t out_len = 0;
+    size_t len = build_resume_sigma1(sigma1, sizeof(sigma1), true);
+    TEST_ASSERT(case_handle_sigma1_resume(sigma1, len, out, sizeof(out),
+                                          &out_len) == CASE_RESUME_NOT_APPLICABLE,
+                "Bad MIC accepted");
+    TEST_ASSERT(case_resumption_count() == 1, "Bad MIC revoked the ticket");
+
+    len = build_resume_sigma1(sigma1, sizeof(sigma1), false);
+    TEST_ASSERT(case_handle_sigma1_resume(sigma1, len, out, sizeof(out),
+                                          &out_len) == 0, "Resume failed");
+
+    /* Sigma2_Resume: new ID, MIC under Sigma2_Resume, session ID */
+    const uint8_t *new_id = NULL, *mic = NULL;
+    size_t id_len = 0, mic_len = 0;
+    uint16_t session_id = 0;
+    TEST_ASSERT(find_bytes(out, out_len, 1, &new_id, &id_len) == 0
+                && id_len == CASE_RESUMPTION_ID_LEN, "Missing ResumptionID");
+    TEST_ASSERT(find_bytes(out, out_len, 2, &mic, &mic_len) == 0
+                && mic_len == 16, "Missing Sigma2ResumeMIC");
+    TEST_ASSERT(find_uint16(out, out_len, 3, &session_id) == 0,
+                "Missing ResponderSessionId");
+    TEST_ASSERT(memcmp(new_id, g_init.resumption_id, id_len) != 0,
+                "Resumption ID reused");
+
+    uint8_t salt[32 + CASE_RESUMPTION_ID_LEN], key[16];
+    const uint8_t nonce[] = "NCASE_SigmaS2";
+    memcpy(salt, g_init.random, 32);
+    memcpy(salt + 32, new_id, CASE_RESUMPTION_ID_LEN);
+    hkdf(salt, sizeof(salt), g_init.shared_secret, 32, "Sigma2_Resume",
+         key, sizeof(key));
+    TEST_ASSERT(ccm(false, key, nonce, NULL, 0, NULL, (uint8_t *)mic) == 0,
+                "Sigma2ResumeMIC invalid");
+
+    TEST_ASSERT(session_is_active(session_id) && session_id != first_session,
+                "Resumed session not created");
+    uint16_t by_peer = 0;
+    TEST_ASSERT(session_find_by_peer_node(PEER_NODE_ID, &by_peer) == 0,
+                "Resumed session lacks the peer node ID");
+
+    /* Resumed session keys match the initiator's: [nonce || I2R ct || tag] */
+    uint8_t keys[48], blob[13 + 8 + 16], dec[8];
+    const uint8_t plain[8] = { 'r', 'e', 's', 'u', 'm', 'e', 'd', '!' };
+    size_t dec_len = 0;
+    hkdf(salt, sizeof(salt), g_init.shared_secret, 32, "SessionResumptionKeys",
+         keys, sizeof(keys));
+    memset(blob, 0, 13);
+    ccm(true, keys, blob, plain, sizeof(plain), blob + 13, blob + 13 + 8);
+    TEST_ASSERT(session_decrypt(session_id, blob, sizeof(blob),
+                                dec, sizeof(dec), &dec_len) == 0
+                && dec_len == sizeof(plain)
+                && memcmp(dec, plain, sizeof(plain)) == 0,
+                "Resumed session I2R key mismatch");
+
+    /* The old ID is single use; the new one replaces it */
+    case_resumption_ticket_t ticket;
+    TEST_ASSERT(case_resumption_find(g_init.resumption_id, &ticket) != 0,
+                "Old resumption ID still valid");
+    TEST_ASSERT(case_resumption_find(new_id, &ticket) == 0,
+                "New resumption ID not stored");
+    TEST_ASSERT(ticket.peer_node_id == PEER_NODE_ID, "Ticket peer node ID");
+    TEST_ASSERT(case_resumption_count() == 1, "Ticket count");
+
+    len = build_resume_sigma1(sigma1, sizeof(sigma1), false);
+    TEST_ASSERT(case_handle_sigma1_resume(sigma1, len, out, sizeof(out),
+                                          &out_len) == CASE_RESUME_NOT_APPLICABLE,
+                "Old resumption ID replayed");
+    TEST_PASS();
+}
+
+/**
+ * Main test runner
+ */
+int main(void) {
+    printf("=== CASE Tests ===\n\n");
+
+    msg_pool_init();
+    key_gen(&g_root);
+    key_gen(&g_ica);
+    key_gen(&g_device);
+    key_gen(&g_peer);
+    key_gen(&g_eph);
+
+    test_verified_initiator();
+    test_verified_initiator_icac();
+    test_unverified_initiator();
+    test_resume();
+
+    printf("\n=== Test Results ===\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return (tests_failed == 0) ? 0 : 1;
+}
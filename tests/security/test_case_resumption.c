@@ -0,0 +1,137 @@
+/*
+ * test_case_resumption.c
+ * Unit tests for the CASE resumption ticket store
+ */
+
+#include "case_resumption.h"
+#include <stdio.h>
+#include <string.h>
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(cond, msg) do { \
+    if (!(cond)) { \
+        printf("FAIL: %s - %s\n", __func__, msg); \
+        tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define TEST_PASS() do { \
+    printf("PASS: %s\n", __func__); \
+    tests_passed++; \
+} while(0)
+
+static case_resumption_ticket_t make_ticket(uint8_t id, uint64_t peer) {
+    case_resumption_ticket_t t;
+    memset(&t, 0, sizeof(t));
+    memset(t.resumption_id, id, sizeof(t.resumption_id));
+    memset(t.shared_secret, (uint8_t)(id ^ 0x5A), sizeof(t.shared_secret));
+    t.peer_node_id = peer;
+    t.local_node_id = 0x1000;
+    return t;
+}
+
+/**
+ * Test store, lookup and single-use removal
+ */
+void test_save_find_remove(void) {
+    case_resumption_init();
+    case_resumption_ticket_t t = make_ticket(0x11, 0xA1);
+    case_resumption_ticket_t out;
+
+    TEST_ASSERT(case_resumption_save(&t) == 0, "Save failed");
+    TEST_ASSERT(case_resumption_find(t.resumption_id, &out) == 0, "Ticket not found");
+    TEST_ASSERT(memcmp(&out, &t, sizeof(t)) == 0, "Ticket contents differ");
+
+    uint8_t unknown[CASE_RESUMPTION_ID_LEN];
+    memset(unknown, 0x99, sizeof(unknown));
+    TEST_ASSERT(case_resumption_find(unknown, &out) != 0, "Unknown ID matched");
+
+    TEST_ASSERT(case_resumption_remove(t.resumption_id) == 0, "Remove failed");
+    TEST_ASSERT(case_resumption_find(t.resumption_id, &out) != 0, "Removed ticket found");
+    TEST_ASSERT(case_resumption_remove(t.resumption_id) != 0, "Double remove succeeded");
+    TEST_ASSERT(case_resumption_count() == 0, "Count mismatch");
+
+    TEST_PASS();
+}
+
+/**
+ * Test a new handshake with the same peer supersedes its old ticket
+ */
+void test_one_ticket_per_peer(void) {
+    case_resumption_init();
+    case_resumption_ticket_t a = make_ticket(0x21, 0xB1);
+    case_resumption_ticket_t b = make_ticket(0x22, 0xB1);
+    case_resumption_ticket_t anon1 = make_ticket(0x23, 0);
+    case_resumption_ticket_t anon2 = make_ticket(0x24, 0);
+    case_resumption_ticket_t out;
+
+    case_resumption_save(&a);
+    case_resumption_save(&b);
+    TEST_ASSERT(case_resumption_count() == 1, "Peer should hold one ticket");
+    TEST_ASSERT(case_resumption_find(a.resumption_id, &out) != 0, "Old ticket kept");
+    TEST_ASSERT(case_resumption_find(b.resumption_id, &out) == 0, "New ticket missing");
+
+    // Unknown peers (node ID 0) never replace each other
+    case_resumption_save(&anon1);
+    case_resumption_save(&anon2);
+    TEST_ASSERT(case_resumption_count() == 3, "Anonymous tickets merged");
+
+    TEST_PASS();
+}
+
+/**
+ * Test the oldest ticket is replaced when the store is full
+ */
+void test_replace_oldest(void) {
+    case_resumption_init();
+    case_resumption_ticket_t out;
+
+    for (int i = 0; i < CASE_RESUMPTION_SLOTS; i++) {
+        case_resumption_ticket_t t = make_ticket((uint8_t)(0x30 + i), 0xC0 + i);
+        case_resumption_save(&t);
+    }
+    TEST_ASSERT(case_resumption_count() == CASE_RESUMPTION_SLOTS, "Store not full");
+
+    // Refreshing the first peer makes the second the oldest
+    case_resumption_ticket_t refresh = make_ticket(0x40, 0xC0);
+    case_resumption_save(&refresh);
+    case_resumption_ticket_t extra = make_ticket(0x41, 0xD0);
+    case_resumption_save(&extra);
+
+    case_resumption_ticket_t second = make_ticket(0x31, 0xC1);
+    TEST_ASSERT(case_resumption_find(second.resumption_id, &out) != 0,
+                "Oldest ticket should be replaced");
+    TEST_ASSERT(case_resumption_find(refresh.resumption_id, &out) == 0,
+                "Refreshed ticket evicted");
+    TEST_ASSERT(case_resumption_find(extra.resumption_id, &out) == 0,
+                "New ticket missing");
+    TEST_ASSERT(case_resumption_count() == CASE_RESUMPTION_SLOTS, "Count mismatch");
+
+    case_resumption_clear();
+    TEST_ASSERT(case_resumption_count() == 0, "Clear left tickets");
+    TEST_ASSERT(case_resumption_find(extra.resumption_id, &out) != 0,
+                "Cleared ticket found");
+
+    TEST_PASS();
+}
+
+/**
+ * Main test runner
+ */
+int main(void) {
+    printf("=== CASE Resumption Ticket Store Tests ===\n\n");
+
+    test_save_find_remove();
+    test_one_ticket_per_peer();
+    test_replace_oldest();
+
+    printf("\n=== Test Results ===\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return (tests_failed == 0) ? 0 : 1;
+}
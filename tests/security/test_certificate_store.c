@@ -0,0 +1,263 @@
+/*
+ * test_certificate_store.c
+ * Unit tests for the certificate store RAM cache
+ *
+ * storage_adapter_* is replaced by an in-memory fake that counts reads,
+ * so the tests can check that loads after the first never hit flash.
+ */
+
+#include "certificate_store.h"
+#include "tlv.h"
+#include <stdio.h>
+#include <string.h>
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(cond, msg) do { \
+    if (!(cond)) { \
+        printf("FAIL: %s - %s\n", __func__, msg); \
+        tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define TEST_PASS() do { \
+    printf("PASS: %s\n", __func__); \
+    tests_passed++; \
+} while(0)
+
+/* ------------------------------------------------------------------ */
+/* Fake storage adapter                                                 */
+/* ------------------------------------------------------------------ */
+
+#define FAKE_FILES  3
+
+static struct {
+    char    key[32];
+    uint8_t data[CERT_STORE_MAX_CERT_SIZE];
+    size_t  len;
+    int     used;
+} g_files[FAKE_FILES];
+
+static int g_reads;
+static int g_fail_writes;
+
+static int fake_find(const char *key) {
+    for (int i = 0; i < FAKE_FILES; i++) {
+        if (g_files[i].used && strcmp(g_files[i].key, key) == 0) return i;
+    }
+    return -1;
+}
+
+int storage_adapter_write(const char *key, const uint8_t *value, size_t value_len) {
+    if (g_fail_writes || value_len > CERT_STORE_MAX_CERT_SIZE) return -1;
+    int i = fake_find(key);
+    if (i < 0) {
+        for (i = 0; i < FAKE_FILES && g_files[i].used; i++) {}
+        if (i == FAKE_FILES) return -1;
+    }
+    snprintf(g_files[i].key, sizeof(g_files[i].key), "%s", key);
+    memcpy(g_files[i].data, value, value_len);
+    g_files[i].len = value_len;
+    g_files[i].used = 1;
+    return 0;
+}
+
+int storage_adapter_read(const char *key, uint8_t *value, size_t max_value_len,
+                         size_t *actual_len) {
+    g_reads++;
+    int i = fake_find(key);
+    if (i < 0 || g_files[i].len > max_value_len) return -1;
+    memcpy(value, g_files[i].data, g_files[i].len);
+    *actual_len = g_files[i].len;
+    return 0;
+}
+
+int storage_adapter_delete(const char *key) {
+    int i = fake_find(key);
+    if (i >= 0) memset(&g_files[i], 0, sizeof(g_files[i]));
+    return 0;
+}
+
+/* ------------------------------------------------------------------ */
+/* Helpers                                                              */
+/* ------------------------------------------------------------------ */
+
+/* Minimal Matter TLV NOC: serial, issuer DN, subject DN with node ID */
+static size_t make_noc(uint8_t *buf, size_t size, uint32_t node_id) {
+    tlv_writer_t w;
+    tlv_writer_init(&w, buf, size);
+    tlv_encode_structure_start(&w, 0);
+    tlv_encode_uint8(&w, 1, 0x42);              /* Serial number */
+    tlv_encode_list_start(&w, 3);               /* Issuer */
+    tlv_encode_uint32(&w, 17, 0xDEAD);          /* Not the subject */
+    tlv_encode_container_end(&w);
+    tlv_encode_list_start(&w, 6);               /* Subject */
+    tlv_encode_uint32(&w, 21, 0xFAB1);          /* Fabric ID */
+    tlv_encode_uint32(&w, 17, node_id);         /* matter-node-id */
+    tlv_encode_container_end(&w);
+    tlv_encode_container_end(&w);
+    return tlv_writer_get_length(&w);
+}
+
+static void reset(void) {
+    memset(g_files, 0, sizeof(g_files));
+    g_reads = 0;
+    g_fail_writes = 0;
+    /* Drop cached state left by the previous test */
+    certificate_store_clear_all();
+    g_reads = 0;
+}
+
+/* ------------------------------------------------------------------ */
+/* Tests                                                                */
+/* ------------------------------------------------------------------ */
+
+/**
+ * Test that loads after a save are served from RAM
+ */
+void test_single_flash_read(void) {
+    reset();
+    uint8_t noc[CERT_STORE_MAX_CERT_SIZE];
+    size_t noc_len = make_noc(noc, sizeof(noc), 0x1234);
+
+    TEST_ASSERT(certificate_store_save_noc(noc, noc_len) == 0, "Save failed");
+    g_reads = 0;
+
+    uint8_t out[CERT_STORE_MAX_CERT_SIZE];
+    size_t out_len = 0;
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT(certificate_store_load_noc(out, sizeof(out), &out_len) == 0,
+                    "Load failed");
+        TEST_ASSERT(out_len == noc_len && memcmp(out, noc, noc_len) == 0,
+                    "Loaded NOC differs");
+    }
+    const uint8_t *ref = NULL;
+    size_t ref_len = 0;
+    TEST_ASSERT(certificate_store_get_noc(&ref, &ref_len) == 0, "get_noc failed");
+    TEST_ASSERT(ref_len == noc_len && memcmp(ref, noc, noc_len) == 0,
+                "Cached NOC differs");
+    TEST_ASSERT(certificate_store_has_noc() == 1, "has_noc false");
+    TEST_ASSERT(g_reads == 0, "Flash read after save");
+
+    /* Buffer too small */
+    TEST_ASSERT(certificate_store_load_noc(out, noc_len - 1, &out_len) != 0,
+                "Short buffer accepted");
+
+    TEST_PASS();
+}
+
+/**
+ * Test that init reads each uncached certificate from flash once
+ */
+void test_init_populates_cache(void) {
+    reset();
+    TEST_ASSERT(certificate_store_has_noc() == 0, "Stale NOC after clear");
+
+    uint8_t rcac[40];
+    memset(rcac, 0xAB, sizeof(rcac));
+    storage_adapter_write(CERT_STORE_RCAC_PATH, rcac, sizeof(rcac));
+
+    /* A failed save invalidates the entry, forcing a re-read */
+    g_fail_writes = 1;
+    TEST_ASSERT(certificate_store_save_rcac(rcac, sizeof(rcac)) != 0,
+                "Failed write reported success");
+    g_fail_writes = 0;
+
+    g_reads = 0;
+    certificate_store_init();
+    uint8_t out[CERT_STORE_MAX_CERT_SIZE];
+    size_t out_len = 0;
+    TEST_ASSERT(certificate_store_load_rcac(out, sizeof(out), &out_len) == 0,
+                "RCAC load failed");
+    TEST_ASSERT(out_len == sizeof(rcac) && memcmp(out, rcac, sizeof(rcac)) == 0,
+                "RCAC differs");
+    TEST_ASSERT(certificate_store_load_icac(out, sizeof(out), &out_len) != 0,
+                "Absent ICAC loaded");
+    TEST_ASSERT(g_reads == 1, "Expected exactly one flash read (RCAC)");
+
+    certificate_store_init();
+    TEST_ASSERT(g_reads == 1, "Second init re-read flash");
+
+    TEST_PASS();
+}
+
+/**
+ * Test that saves replace the cached copy and node ID
+ */
+void test_save_refreshes_cache(void) {
+    reset();
+    uint8_t noc[CERT_STORE_MAX_CERT_SIZE];
+    size_t noc_len = make_noc(noc, sizeof(noc), 0x1111);
+    uint64_t node_id = 0;
+
+    TEST_ASSERT(certificate_store_get_node_id(&node_id) != 0,
+                "Node ID without a NOC");
+    TEST_ASSERT(certificate_store_save_noc(noc, noc_len) == 0, "Save failed");
+    TEST_ASSERT(certificate_store_get_node_id(&node_id) == 0 && node_id == 0x1111,
+                "Wrong node ID");
+
+    noc_len = make_noc(noc, sizeof(noc), 0x22223333);
+    TEST_ASSERT(certificate_store_save_noc(noc, noc_len) == 0, "Re-save failed");
+    TEST_ASSERT(certificate_store_get_node_id(&node_id) == 0 && node_id == 0x22223333,
+                "Node ID not refreshed");
+
+    const uint8_t *ref = NULL;
+    size_t ref_len = 0;
+    TEST_ASSERT(certificate_store_get_noc(&ref, &ref_len) == 0 &&
+                ref_len == noc_len && memcmp(ref, noc, noc_len) == 0,
+                "Cached NOC not refreshed");
+
+    TEST_ASSERT(certificate_store_clear_all() == 0, "Clear failed");
+    TEST_ASSERT(certificate_store_has_noc() == 0, "NOC survived clear");
+    TEST_ASSERT(certificate_store_get_node_id(&node_id) != 0,
+                "Node ID survived clear");
+    TEST_ASSERT(g_reads == 0, "Flash read during test");
+
+    TEST_PASS();
+}
+
+/**
+ * Test node ID extraction from the subject DN only
+ */
+void test_parse_node_id(void) {
+    uint8_t noc[CERT_STORE_MAX_CERT_SIZE];
+    uint64_t node_id = 0;
+    size_t noc_len = make_noc(noc, sizeof(noc), 0xCAFE);
+
+    TEST_ASSERT(certificate_store_parse_node_id(noc, noc_len, &node_id) == 0,
+                "Parse failed");
+    TEST_ASSERT(node_id == 0xCAFE, "Issuer node ID taken instead of subject");
+
+    /* No subject list */
+    tlv_writer_t w;
+    tlv_writer_init(&w, noc, sizeof(noc));
+    tlv_encode_structure_start(&w, 0);
+    tlv_encode_uint32(&w, 17, 0xBEEF);
+    tlv_encode_container_end(&w);
+    TEST_ASSERT(certificate_store_parse_node_id(noc, tlv_writer_get_length(&w),
+                                                &node_id) != 0,
+                "Node ID outside subject accepted");
+
+    TEST_PASS();
+}
+
+/**
+ * Main test runner
+ */
+int main(void) {
+    printf("=== Certificate Store Cache Tests ===\n\n");
+
+    test_single_flash_read();
+    test_init_populates_cache();
+    test_save_refreshes_cache();
+    test_parse_node_id();
+
+    printf("\n=== Test Results ===\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,130 @@
+/*
+ * test_crypto_stats.c
+ * Unit tests for the crypto operation counters
+ *
+ * Elapsed time is simulated by advancing host_time_offset_us (host
+ * pico/time.h stand-in) between begin and end.
+ */
+
+#include "crypto_stats.h"
+#include "pico/time.h"
+#include <stdio.h>
+#include <string.h>
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(cond, msg) do { \
+    if (!(cond)) { \
+        printf("FAIL: %s - %s\n", __func__, msg); \
+        tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define TEST_PASS() do { \
+    printf("PASS: %s\n", __func__); \
+    tests_passed++; \
+} while(0)
+
+/**
+ * Record an operation that takes (at least) us microseconds
+ */
+static void record(crypto_op_t op, uint32_t us, size_t bytes) {
+    uint64_t t0 = crypto_stats_begin();
+    host_time_offset_us += us;
+    crypto_stats_end(op, t0, bytes);
+}
+
+/**
+ * Test count, min, max, total and bytes for one operation
+ */
+void test_accumulate(void) {
+    crypto_stats_reset();
+
+    record(CRYPTO_OP_CCM_ENCRYPT, 5000, 64);
+    record(CRYPTO_OP_CCM_ENCRYPT, 1000, 128);
+    record(CRYPTO_OP_CCM_ENCRYPT, 9000, 16);
+
+    crypto_op_stats_t s;
+    crypto_stats_get(CRYPTO_OP_CCM_ENCRYPT, &s);
+    TEST_ASSERT(s.count == 3, "Wrong count");
+    TEST_ASSERT(s.bytes == 64 + 128 + 16, "Wrong byte total");
+    // Real elapsed time is added on top of the simulated delay
+    TEST_ASSERT(s.min_us >= 1000 && s.min_us < 5000, "Wrong min");
+    TEST_ASSERT(s.max_us >= 9000, "Wrong max");
+    TEST_ASSERT(s.total_us >= 15000 && s.total_us >= s.max_us + s.min_us,
+                "Wrong total");
+
+    // Other operations untouched
+    crypto_stats_get(CRYPTO_OP_CCM_DECRYPT, &s);
+    TEST_ASSERT(s.count == 0 && s.total_us == 0, "Unrelated op counted");
+
+    TEST_PASS();
+}
+
+/**
+ * Test reset and out-of-range operations
+ */
+void test_reset_and_bounds(void) {
+    crypto_stats_reset();
+    record(CRYPTO_OP_ECDH, 100, 0);
+    record(CRYPTO_OP_COUNT, 100, 0);            // Ignored
+
+    crypto_op_stats_t s;
+    memset(&s, 0xFF, sizeof(s));
+    crypto_stats_get(CRYPTO_OP_COUNT, &s);
+    TEST_ASSERT(s.count == 0 && s.max_us == 0, "Out-of-range op not zeroed");
+
+    crypto_stats_get(CRYPTO_OP_ECDH, &s);
+    TEST_ASSERT(s.count == 1, "ECDH not counted");
+
+    crypto_stats_reset();
+    crypto_stats_get(CRYPTO_OP_ECDH, &s);
+    TEST_ASSERT(s.count == 0 && s.min_us == 0 && s.max_us == 0, "Reset failed");
+
+    // min restarts after a reset
+    record(CRYPTO_OP_ECDH, 700, 0);
+    crypto_stats_get(CRYPTO_OP_ECDH, &s);
+    TEST_ASSERT(s.min_us >= 700 && s.min_us == s.max_us, "Min not restarted");
+
+    TEST_PASS();
+}
+
+/**
+ * Test operation names and the console dump
+ */
+void test_names_and_print(void) {
+    for (int op = 0; op < CRYPTO_OP_COUNT; op++) {
+        const char *name = crypto_stats_op_name((crypto_op_t)op);
+        TEST_ASSERT(name && name[0] != '\0' && strcmp(name, "?") != 0,
+                    "Missing op name");
+    }
+    TEST_ASSERT(strcmp(crypto_stats_op_name(CRYPTO_OP_COUNT), "?") == 0,
+                "Out-of-range name");
+
+    crypto_stats_reset();
+    record(CRYPTO_OP_PBKDF2, 2000, 0);
+    record(CRYPTO_OP_HKDF, 10, 48);
+    crypto_stats_print();
+
+    TEST_PASS();
+}
+
+/**
+ * Main test runner
+ */
+int main(void) {
+    printf("=== Crypto Stats Tests ===\n\n");
+
+    test_accumulate();
+    test_reset_and_bounds();
+    test_names_and_print();
+
+    printf("\n=== Test Results ===\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+/*
+ * test_ephemeral_pool.c
+ * Unit tests for the precomputed ephemeral key pair pool
+ */
+
+#include "ephemeral_pool.h"
+#include <stdio.h>
+#include <string.h>
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(cond, msg) do { \
+    if (!(cond)) { \
+        printf("FAIL: %s - %s\n", __func__, msg); \
+        tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define TEST_PASS() do { \
+    printf("PASS: %s\n", __func__); \
+    tests_passed++; \
+} while(0)
+
+/**
+ * Check pub == priv * G and priv is a valid scalar
+ */
+static int key_pair_valid(const uint8_t *priv, const uint8_t *pub) {
+    uint8_t expected[P256_POINT_LENGTH];
+    if (p256_scalar_check(priv) != 0) return 0;
+    if (p256_fixed_mul(P256_BASE_G, priv, expected) != 0) return 0;
+    return memcmp(expected, pub, sizeof(expected)) == 0;
+}
+
+/**
+ * Test poll fills the pool one key pair per call, up to its size
+ */
+void test_poll_fills_pool(void) {
+    ephemeral_pool_stats_t stats;
+    ephemeral_pool_init();
+
+    ephemeral_pool_get_stats(&stats);
+    TEST_ASSERT(stats.ready == 0, "Pool not empty after init");
+
+    for (int i = 0; i < EPHEMERAL_POOL_SIZE; i++) {
+        TEST_ASSERT(ephemeral_pool_poll() == 1, "Poll did not add a key pair");
+        ephemeral_pool_get_stats(&stats);
+        TEST_ASSERT(stats.ready == (uint32_t)(i + 1), "Ready count mismatch");
+    }
+    TEST_ASSERT(ephemeral_pool_poll() == 0, "Poll added to a full pool");
+    ephemeral_pool_get_stats(&stats);
+    TEST_ASSERT(stats.generated == EPHEMERAL_POOL_SIZE, "Generated count mismatch");
+
+    TEST_PASS();
+}
+
+/**
+ * Test take serves distinct, valid pairs from the pool, then falls back
+ * to inline generation
+ */
+void test_take_and_fallback(void) {
+    uint8_t priv[EPHEMERAL_POOL_SIZE + 1][P256_SCALAR_LENGTH];
+    uint8_t pub[EPHEMERAL_POOL_SIZE + 1][P256_POINT_LENGTH];
+    ephemeral_pool_stats_t stats;
+
+    ephemeral_pool_init();
+    while (ephemeral_pool_poll() == 1) {}
+
+    for (int i = 0; i <= EPHEMERAL_POOL_SIZE; i++) {
+        TEST_ASSERT(ephemeral_pool_take(priv[i], pub[i]) == 0, "Take failed");
+        TEST_ASSERT(key_pair_valid(priv[i], pub[i]), "pub != priv * G");
+        for (int j = 0; j < i; j++) {
+            TEST_ASSERT(memcmp(priv[i], priv[j], P256_SCALAR_LENGTH) != 0,
+                        "Key pair handed out twice");
+        }
+    }
+
+    ephemeral_pool_get_stats(&stats);
+    TEST_ASSERT(stats.hits == EPHEMERAL_POOL_SIZE, "Hit count mismatch");
+    TEST_ASSERT(stats.misses == 1, "Miss count mismatch");
+    TEST_ASSERT(stats.ready == 0, "Pool not drained");
+
+    /* Refills after being drained */
+    TEST_ASSERT(ephemeral_pool_poll() == 1, "Refill failed");
+    TEST_ASSERT(ephemeral_pool_take(priv[0], pub[0]) == 0, "Take after refill failed");
+    ephemeral_pool_get_stats(&stats);
+    TEST_ASSERT(stats.hits == EPHEMERAL_POOL_SIZE + 1, "Refilled pair not used");
+
+    TEST_ASSERT(ephemeral_pool_take(NULL, pub[0]) != 0, "NULL priv accepted");
+
+    TEST_PASS();
+}
+
+/**
+ * Main test runner
+ */
+int main(void) {
+    printf("=== Ephemeral Key Pool Tests ===\n\n");
+
+    test_poll_fills_pool();
+    test_take_and_fallback();
+
+    printf("\n=== Test Results ===\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,332 @@
+/*
+ * test_matter_cert.c
+ * Unit tests for Matter TLV certificate parsing and DER TBS reconstruction
+ *
+ * The expected TBSCertificate bytes were produced by an independent X.509
+ * encoder (Python cryptography's CertificateBuilder) from the same fields
+ * as the TLV certificates built here.
+ */
+
+#include "matter_cert.h"
+#include "tlv.h"
+#include <stdio.h>
+#include <string.h>
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(cond, msg) do { \
+    if (!(cond)) { \
+        printf("FAIL: %s - %s\n", __func__, msg); \
+        tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define TEST_PASS() do { \
+    printf("PASS: %s\n", __func__); \
+    tests_passed++; \
+} while(0)
+
+/* Subject public key of both certificates */
+static const uint8_t PUBKEY[MATTER_CERT_PUBKEY_LEN] = {
+    0x04, 0x02, 0x17, 0xE6, 0x17, 0xF0, 0xB6, 0x44, 0x39, 0x28, 0x27, 0x8F,
+    0x96, 0x99, 0x9E, 0x69, 0xA2, 0x3A, 0x4F, 0x2C, 0x15, 0x2B, 0xDF, 0x6D,
+    0x6C, 0xDF, 0x66, 0xE5, 0xB8, 0x02, 0x82, 0xD4, 0xED, 0x19, 0x4A, 0x7D,
+    0xEB, 0xCB, 0x97, 0x71, 0x2D, 0x2D, 0xDA, 0x3C, 0xA8, 0x5A, 0xA8, 0x76,
+    0x5A, 0x56, 0xF4, 0x5F, 0xC7, 0x58, 0x59, 0x96, 0x52, 0xF2, 0x89, 0x7C,
+    0x65, 0x30, 0x6E, 0x57, 0x94
+};
+
+/* NOC: node/fabric/CAT IDs, PrintableString CN, no expiry, EKU */
+static const uint8_t NOC_TBS[] = {
+    0x30, 0x82, 0x01, 0xD3, 0xA0, 0x03, 0x02, 0x01, 0x02, 0x02, 0x08, 0x11,
+    0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x30, 0x0A, 0x06, 0x08, 0x2A,
+    0x86, 0x48, 0xCE, 0x3D, 0x04, 0x03, 0x02, 0x30, 0x44, 0x31, 0x20, 0x30,
+    0x1E, 0x06, 0x0A, 0x2B, 0x06, 0x01, 0x04, 0x01, 0x82, 0xA2, 0x7C, 0x01,
+    0x04, 0x0C, 0x10, 0x43, 0x41, 0x43, 0x41, 0x43, 0x41, 0x43, 0x41, 0x30,
+    0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x31, 0x31, 0x20, 0x30, 0x1E, 0x06,
+    0x0A, 0x2B, 0x06, 0x01, 0x04, 0x01, 0x82, 0xA2, 0x7C, 0x01, 0x05, 0x0C,
+    0x10, 0x46, 0x41, 0x42, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+    0x30, 0x30, 0x30, 0x31, 0x44, 0x30, 0x20, 0x17, 0x0D, 0x32, 0x33, 0x31,
+    0x30, 0x30, 0x31, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x5A, 0x18, 0x0F,
+    0x39, 0x39, 0x39, 0x39, 0x31, 0x32, 0x33, 0x31, 0x32, 0x33, 0x35, 0x39,
+    0x35, 0x39, 0x5A, 0x30, 0x6D, 0x31, 0x20, 0x30, 0x1E, 0x06, 0x0A, 0x2B,
+    0x06, 0x01, 0x04, 0x01, 0x82, 0xA2, 0x7C, 0x01, 0x01, 0x0C, 0x10, 0x44,
+    0x45, 0x44, 0x45, 0x44, 0x45, 0x44, 0x45, 0x30, 0x30, 0x30, 0x31, 0x30,
+    0x30, 0x30, 0x31, 0x31, 0x20, 0x30, 0x1E, 0x06, 0x0A, 0x2B, 0x06, 0x01,
+    0x04, 0x01, 0x82, 0xA2, 0x7C, 0x01, 0x05, 0x0C, 0x10, 0x46, 0x41, 0x42,
+    0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x31,
+    0x44, 0x31, 0x18, 0x30, 0x16, 0x06, 0x0A, 0x2B, 0x06, 0x01, 0x04, 0x01,
+    0x82, 0xA2, 0x7C, 0x01, 0x06, 0x0C, 0x08, 0x41, 0x42, 0x43, 0x44, 0x30,
+    0x30, 0x30, 0x32, 0x31, 0x0D, 0x30, 0x0B, 0x06, 0x03, 0x55, 0x04, 0x03,
+    0x13, 0x04, 0x54, 0x65, 0x73, 0x74, 0x30, 0x59, 0x30, 0x13, 0x06, 0x07,
+    0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x02, 0x01, 0x06, 0x08, 0x2A, 0x86, 0x48,
+    0xCE, 0x3D, 0x03, 0x01, 0x07, 0x03, 0x42, 0x00, 0x04, 0x02, 0x17, 0xE6,
+    0x17, 0xF0, 0xB6, 0x44, 0x39, 0x28, 0x27, 0x8F, 0x96, 0x99, 0x9E, 0x69,
+    0xA2, 0x3A, 0x4F, 0x2C, 0x15, 0x2B, 0xDF, 0x6D, 0x6C, 0xDF, 0x66, 0xE5,
+    0xB8, 0x02, 0x82, 0xD4, 0xED, 0x19, 0x4A, 0x7D, 0xEB, 0xCB, 0x97, 0x71,
+    0x2D, 0x2D, 0xDA, 0x3C, 0xA8, 0x5A, 0xA8, 0x76, 0x5A, 0x56, 0xF4, 0x5F,
+    0xC7, 0x58, 0x59, 0x96, 0x52, 0xF2, 0x89, 0x7C, 0x65, 0x30, 0x6E, 0x57,
+    0x94, 0xA3, 0x81, 0x83, 0x30, 0x81, 0x80, 0x30, 0x0C, 0x06, 0x03, 0x55,
+    0x1D, 0x13, 0x01, 0x01, 0xFF, 0x04, 0x02, 0x30, 0x00, 0x30, 0x0E, 0x06,
+    0x03, 0x55, 0x1D, 0x0F, 0x01, 0x01, 0xFF, 0x04, 0x04, 0x03, 0x02, 0x07,
+    0x80, 0x30, 0x20, 0x06, 0x03, 0x55, 0x1D, 0x25, 0x01, 0x01, 0xFF, 0x04,
+    0x16, 0x30, 0x14, 0x06, 0x08, 0x2B, 0x06, 0x01, 0x05, 0x05, 0x07, 0x03,
+    0x02, 0x06, 0x08, 0x2B, 0x06, 0x01, 0x05, 0x05, 0x07, 0x03, 0x01, 0x30,
+    0x1D, 0x06, 0x03, 0x55, 0x1D, 0x0E, 0x04, 0x16, 0x04, 0x14, 0x10, 0x11,
+    0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D,
+    0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x30, 0x1F, 0x06, 0x03, 0x55, 0x1D,
+    0x23, 0x04, 0x18, 0x30, 0x16, 0x80, 0x14, 0x40, 0x41, 0x42, 0x43, 0x44,
+    0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F, 0x50,
+    0x51, 0x52, 0x53
+};
+
+/* CA: ICAC ID, UTF8String O, IA5String DC, 2051 expiry, path length 0 */
+static const uint8_t CA_TBS[] = {
+    0x30, 0x82, 0x01, 0x68, 0xA0, 0x03, 0x02, 0x01, 0x02, 0x02, 0x01, 0x5A,
+    0x30, 0x0A, 0x06, 0x08, 0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x04, 0x03, 0x02,
+    0x30, 0x22, 0x31, 0x20, 0x30, 0x1E, 0x06, 0x0A, 0x2B, 0x06, 0x01, 0x04,
+    0x01, 0x82, 0xA2, 0x7C, 0x01, 0x04, 0x0C, 0x10, 0x43, 0x41, 0x43, 0x41,
+    0x43, 0x41, 0x43, 0x41, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x31,
+    0x30, 0x20, 0x17, 0x0D, 0x30, 0x30, 0x30, 0x31, 0x30, 0x31, 0x30, 0x30,
+    0x30, 0x30, 0x30, 0x30, 0x5A, 0x18, 0x0F, 0x32, 0x30, 0x35, 0x31, 0x30,
+    0x33, 0x31, 0x35, 0x31, 0x32, 0x33, 0x30, 0x34, 0x35, 0x5A, 0x30, 0x49,
+    0x31, 0x20, 0x30, 0x1E, 0x06, 0x0A, 0x2B, 0x06, 0x01, 0x04, 0x01, 0x82,
+    0xA2, 0x7C, 0x01, 0x03, 0x0C, 0x10, 0x43, 0x41, 0x43, 0x41, 0x43, 0x41,
+    0x43, 0x41, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x32, 0x31, 0x0C,
+    0x30, 0x0A, 0x06, 0x03, 0x55, 0x04, 0x0A, 0x0C, 0x03, 0x43, 0x53, 0x41,
+    0x31, 0x17, 0x30, 0x15, 0x06, 0x0A, 0x09, 0x92, 0x26, 0x89, 0x93, 0xF2,
+    0x2C, 0x64, 0x01, 0x19, 0x16, 0x07, 0x65, 0x78, 0x61, 0x6D, 0x70, 0x6C,
+    0x65, 0x30, 0x59, 0x30, 0x13, 0x06, 0x07, 0x2A, 0x86, 0x48, 0xCE, 0x3D,
+    0x02, 0x01, 0x06, 0x08, 0x2A, 0x86, 0x48, 0xCE, 0x3D, 0x03, 0x01, 0x07,
+    0x03, 0x42, 0x00, 0x04, 0x02, 0x17, 0xE6, 0x17, 0xF0, 0xB6, 0x44, 0x39,
+    0x28, 0x27, 0x8F, 0x96, 0x99, 0x9E, 0x69, 0xA2, 0x3A, 0x4F, 0x2C, 0x15,
+    0x2B, 0xDF, 0x6D, 0x6C, 0xDF, 0x66, 0xE5, 0xB8, 0x02, 0x82, 0xD4, 0xED,
+    0x19, 0x4A, 0x7D, 0xEB, 0xCB, 0x97, 0x71, 0x2D, 0x2D, 0xDA, 0x3C, 0xA8,
+    0x5A, 0xA8, 0x76, 0x5A, 0x56, 0xF4, 0x5F, 0xC7, 0x58, 0x59, 0x96, 0x52,
+    0xF2, 0x89, 0x7C, 0x65, 0x30, 0x6E, 0x57, 0x94, 0xA3, 0x66, 0x30, 0x64,
+    0x30, 0x12, 0x06, 0x03, 0x55, 0x1D, 0x13, 0x01, 0x01, 0xFF, 0x04, 0x08,
+    0x30, 0x06, 0x01, 0x01, 0xFF, 0x02, 0x01, 0x00, 0x30, 0x0E, 0x06, 0x03,
+    0x55, 0x1D, 0x0F, 0x01, 0x01, 0xFF, 0x04, 0x04, 0x03, 0x02, 0x01, 0x06,
+    0x30, 0x1D, 0x06, 0x03, 0x55, 0x1D, 0x0E, 0x04, 0x16, 0x04, 0x14, 0x10,
+    0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1B, 0x1C,
+    0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x30, 0x1F, 0x06, 0x03, 0x55,
+    0x1D, 0x23, 0x04, 0x18, 0x30, 0x16, 0x80, 0x14, 0x40, 0x41, 0x42, 0x43,
+    0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F,
+    0x50, 0x51, 0x52, 0x53
+};
+
+static uint8_t g_cert[600];
+static uint8_t g_tbs[MATTER_CERT_MAX_TBS_SIZE];
+
+static void key_id(uint8_t *id, uint8_t first) {
+    for (int i = 0; i < MATTER_CERT_KEY_ID_LEN; i++) id[i] = (uint8_t)(first + i);
+}
+
+/* NOC issued by RCAC 0xCACACACA00000001 on fabric 0xFAB000000000001D */
+static size_t build_noc(uint8_t *buf, size_t size, bool with_pubkey) {
+    uint8_t serial[] = { 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88 };
+    uint8_t skid[MATTER_CERT_KEY_ID_LEN], akid[MATTER_CERT_KEY_ID_LEN];
+    uint8_t sig[MATTER_CERT_SIGNATURE_LEN];
+    key_id(skid, 0x10);
+    key_id(akid, 0x40);
+    memset(sig, 0xA5, sizeof(sig));
+
+    tlv_writer_t w;
+    tlv_writer_init(&w, buf, size);
+    tlv_encode_structure_start(&w, 0);
+    tlv_encode_bytes(&w, 1, serial, sizeof(serial));
+    tlv_encode_uint8(&w, 2, 1);
+    tlv_encode_list_start(&w, 3);
+    tlv_encode_uint64(&w, 20, 0xCACACACA00000001ull);
+    tlv_encode_uint64(&w, 21, 0xFAB000000000001Dull);
+    tlv_encode_container_end(&w);
+    tlv_encode_uint32(&w, 4, 749433600u);       /* 2023-10-01 00:00:00 */
+    tlv_encode_uint32(&w, 5, 0);                /* No expiry */
+    tlv_encode_list_start(&w, 6);
+    tlv_encode_uint64(&w, 17, 0xDEDEDEDE00010001ull);
+    tlv_encode_uint64(&w, 21, 0xFAB000000000001Dull);
+    tlv_encode_uint32(&w, 22, 0xABCD0002u);
+    tlv_encode_string(&w, 0x81, "Test");        /* PrintableString CN */
+    tlv_encode_container_end(&w);
+    tlv_encode_uint8(&w, 7, 1);
+    tlv_encode_uint8(&w, 8, 1);
+    if (with_pubkey) tlv_encode_bytes(&w, 9, PUBKEY, sizeof(PUBKEY));
+    tlv_encode_list_start(&w, 10);
+    tlv_encode_structure_start(&w, 1);
+    tlv_encode_bool(&w, 1, false);
+    tlv_encode_container_end(&w);
+    tlv_encode_uint16(&w, 2, 0x0001);           /* digitalSignature */
+    tlv_encode_array_start(&w, 3);
+    tlv_encode_uint8(&w, 0, 2);                 /* clientAuth */
+    tlv_encode_uint8(&w, 0, 1);                 /* serverAuth */
+    tlv_encode_container_end(&w);
+    tlv_encode_bytes(&w, 4, skid, sizeof(skid));
+    tlv_encode_bytes(&w, 5, akid, sizeof(akid));
+    tlv_encode_container_end(&w);
+    tlv_encode_bytes(&w, 11, sig, sizeof(sig));
+    tlv_encode_container_end(&w);
+    return tlv_writer_get_length(&w);
+}
+
+/* ICAC 0xCACACACA00000002 issued by RCAC 0xCACACACA00000001 */
+static size_t build_ca(uint8_t *buf, size_t size) {
+    uint8_t serial[] = { 0x5A };
+    uint8_t skid[MATTER_CERT_KEY_ID_LEN], akid[MATTER_CERT_KEY_ID_LEN];
+    uint8_t sig[MATTER_CERT_SIGNATURE_LEN];
+    key_id(skid, 0x10);
+    key_id(akid, 0x40);
+    memset(sig, 0x5A, sizeof(sig));
+
+    tlv_writer_t w;
+    tlv_writer_init(&w, buf, size);
+    tlv_encode_structure_start(&w, 0);
+    tlv_encode_bytes(&w, 1, serial, sizeof(serial));
+    tlv_encode_uint8(&w, 2, 1);
+    tlv_encode_list_start(&w, 3);
+    tlv_encode_uint64(&w, 20, 0xCACACACA00000001ull);
+    tlv_encode_container_end(&w);
+    tlv_encode_uint32(&w, 4, 0);                /* 2000-01-01 00:00:00 */
+    tlv_encode_uint32(&w, 5, 1615811445u);      /* 2051-03-15 12:30:45 */
+    tlv_encode_list_start(&w, 6);
+    tlv_encode_uint64(&w, 19, 0xCACACACA00000002ull);
+    tlv_encode_string(&w, 7, "CSA");            /* UTF8String O */
+    tlv_encode_string(&w, 16, "example");       /* IA5String DC */
+    tlv_encode_container_end(&w);
+    tlv_encode_uint8(&w, 7, 1);
+    tlv_encode_uint8(&w, 8, 1);
+    tlv_encode_bytes(&w, 9, PUBKEY, sizeof(PUBKEY));
+    tlv_encode_list_start(&w, 10);
+    tlv_encode_structure_start(&w, 1);
+    tlv_encode_bool(&w, 1, true);
+    tlv_encode_uint8(&w, 2, 0);
+    tlv_encode_container_end(&w);
+    tlv_encode_uint16(&w, 2, 0x0060);           /* keyCertSign | cRLSign */
+    tlv_encode_bytes(&w, 4, skid, sizeof(skid));
+    tlv_encode_bytes(&w, 5, akid, sizeof(akid));
+    tlv_encode_container_end(&w);
+    tlv_encode_bytes(&w, 11, sig, sizeof(sig));
+    tlv_encode_container_end(&w);
+    return tlv_writer_get_length(&w);
+}
+
+/**
+ * Test NOC fields: Matter DN IDs, time formats, leaf extensions
+ */
+void test_noc_tbs(void) {
+    size_t len = build_noc(g_cert, sizeof(g_cert), true);
+    size_t tbs_len = 0;
+    TEST_ASSERT(matter_cert_encode_tbs(g_cert, len, g_tbs, sizeof(g_tbs),
+                                       &tbs_len) == 0, "Encode failed");
+    TEST_ASSERT(tbs_len == sizeof(NOC_TBS), "TBS length mismatch");
+    TEST_ASSERT(memcmp(g_tbs, NOC_TBS, tbs_len) == 0, "TBS bytes mismatch");
+    TEST_PASS();
+}
+
+/**
+ * Test CA fields: standard DN strings, GeneralizedTime, path length
+ */
+void test_ca_tbs(void) {
+    size_t len = build_ca(g_cert, sizeof(g_cert));
+    size_t tbs_len = 0;
+    TEST_ASSERT(matter_cert_encode_tbs(g_cert, len, g_tbs, sizeof(g_tbs),
+                                       &tbs_len) == 0, "Encode failed");
+    TEST_ASSERT(tbs_len == sizeof(CA_TBS), "TBS length mismatch");
+    TEST_ASSERT(memcmp(g_tbs, CA_TBS, tbs_len) == 0, "TBS bytes mismatch");
+    TEST_PASS();
+}
+
+/**
+ * Test parsed fields and issuer matching
+ */
+void test_parse_and_issuer(void) {
+    static uint8_t ca_buf[600];
+    size_t noc_len = build_noc(g_cert, sizeof(g_cert), true);
+    size_t ca_len = build_ca(ca_buf, sizeof(ca_buf));
+    matter_cert_t noc, ca;
+
+    TEST_ASSERT(matter_cert_parse(g_cert, noc_len, &noc) == 0, "NOC parse failed");
+    TEST_ASSERT(noc.has_node_id && noc.node_id == 0xDEDEDEDE00010001ull,
+                "Node ID");
+    TEST_ASSERT(noc.has_fabric_id && noc.fabric_id == 0xFAB000000000001Dull,
+                "Fabric ID");
+    TEST_ASSERT(!noc.is_ca, "NOC marked as CA");
+    TEST_ASSERT(memcmp(noc.public_key, PUBKEY, sizeof(PUBKEY)) == 0, "Public key");
+    TEST_ASSERT(noc.signature && noc.signature[0] == 0xA5, "Signature");
+    TEST_ASSERT(noc.subject_key_id && noc.subject_key_id[0] == 0x10, "SKID");
+    TEST_ASSERT(noc.authority_key_id && noc.authority_key_id[0] == 0x40, "AKID");
+
+    TEST_ASSERT(matter_cert_parse(ca_buf, ca_len, &ca) == 0, "CA parse failed");
+    TEST_ASSERT(ca.is_ca, "CA not marked as CA");
+    TEST_ASSERT(!ca.has_node_id && !ca.has_fabric_id, "CA has node/fabric ID");
+
+    /* Both name RCAC 1 as issuer; neither is the other's issuer */
+    TEST_ASSERT(!matter_cert_issued_by(&noc, &ca), "Wrong issuer accepted");
+    matter_cert_t rcac = ca;
+    rcac.subject = noc.issuer;
+    rcac.subject_len = noc.issuer_len;
+    rcac.subject_key_id = noc.authority_key_id;
+    TEST_ASSERT(matter_cert_issued_by(&noc, &rcac), "Issuer not matched");
+    rcac.subject_key_id = noc.subject_key_id;
+    TEST_ASSERT(!matter_cert_issued_by(&noc, &rcac), "Key ID mismatch accepted");
+
+    TEST_PASS();
+}
+
+/**
+ * Test malformed certificates and short output buffers
+ */
+void test_rejects(void) {
+    size_t len = build_noc(g_cert, sizeof(g_cert), false);
+    size_t tbs_len = 0;
+    matter_cert_t cert;
+    TEST_ASSERT(matter_cert_parse(g_cert, len, &cert) != 0,
+                "Missing public key accepted");
+    TEST_ASSERT(matter_cert_encode_tbs(g_cert, len, g_tbs, sizeof(g_tbs),
+                                       &tbs_len) != 0,
+                "TBS without public key accepted");
+
+    len = build_noc(g_cert, sizeof(g_cert), true);
+    TEST_ASSERT(matter_cert_encode_tbs(g_cert, len, g_tbs, sizeof(NOC_TBS) - 1,
+                                       &tbs_len) != 0, "Short buffer accepted");
+    TEST_ASSERT(matter_cert_parse(g_cert, len - 4, &cert) != 0,
+                "Truncated certificate accepted");
+
+    /* Unsupported signature algorithm */
+    uint8_t *algo = NULL;
+    for (size_t i = 0; i + 3 < len; i++) {
+        if (g_cert[i] == 0x11 && g_cert[i + 1] == 2 && g_cert[i + 2] == 0) {
+            algo = &g_cert[i + 3];
+            break;
+        }
+    }
+    TEST_ASSERT(algo && *algo == 1, "Signature algorithm not found");
+    *algo = 2;
+    TEST_ASSERT(matter_cert_parse(g_cert, len, &cert) != 0,
+                "Unknown signature algorithm accepted");
+    TEST_ASSERT(matter_cert_encode_tbs(g_cert, len, g_tbs, sizeof(g_tbs),
+                                       &tbs_len) != 0,
+                "TBS with unknown algorithm accepted");
+
+    TEST_PASS();
+}
+
+/**
+ * Main test runner
+ */
+int main(void) {
+    printf("=== Matter Certificate Tests ===\n\n");
+
+    test_noc_tbs();
+    test_ca_tbs();
+    test_parse_and_issuer();
+    test_rejects();
+
+    printf("\n=== Test Results ===\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,259 @@
+/*
+ * test_p256_fixed.c
+ * Known-answer tests for fixed-base P-256 multiplication (comb tables)
+ *
+ * Expected points were computed independently with affine double-and-add
+ * over Python integers.
+ */
+
+#include "p256_fixed.h"
+#include <stdio.h>
+#include <string.h>
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(cond, msg) do { \
+    if (!(cond)) { \
+        printf("FAIL: %s - %s\n", __func__, msg); \
+        tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define TEST_PASS() do { \
+    printf("PASS: %s\n", __func__); \
+    tests_passed++; \
+} while(0)
+
+static const char *K1 = "f3f49249dc28ff90a5aec7978306d03bf38b2ffc80a4df5a51c9bc701e7ea419";
+static const char *K2 = "6bad6be28e7aa6e99f19950499dd251de512148239292d22e255accb1a466884";
+static const char *K3 = "7dabe929c4a334bfc6cd75e9bb049a79d7a7a3cc8c3d5f169293de8fc88b2875";
+
+static const char *P256_G_HEX =
+    "046b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296"
+    "4fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5";
+static const char *SPAKE2_M_HEX =
+    "04886e2f97ace46e55ba9dd7242579f2993b64e16ef3dcab95afd497333d8fa12f"
+    "5ff355163e43ce224e0b0e65ff02ac8e5c7be09419c785e0ca547d55a12e2d20";
+static const char *SPAKE2_N_HEX =
+    "04d8bbd6c639c62937b04d997f38c3770719c629d7014d49a24b4f98baa1292b49"
+    "07d60aa6bfade45008a636337f5168c64d9bd36034808cd564490b1e656edbe7";
+
+static void from_hex(const char *hex, uint8_t *out, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        unsigned v = 0;
+        sscanf(hex + 2 * i, "%2x", &v);
+        out[i] = (uint8_t)v;
+    }
+}
+
+static int point_equals(const uint8_t *point, const char *hex) {
+    uint8_t expected[P256_POINT_LENGTH];
+    from_hex(hex, expected, sizeof(expected));
+    return memcmp(point, expected, sizeof(expected)) == 0;
+}
+
+/**
+ * Test 1 * B returns the base point itself for G, M and N
+ */
+void test_base_points(void) {
+    uint8_t one[P256_SCALAR_LENGTH] = {0};
+    uint8_t out[P256_POINT_LENGTH];
+    one[31] = 1;
+
+    TEST_ASSERT(p256_fixed_mul(P256_BASE_G, one, out) == 0, "1*G failed");
+    TEST_ASSERT(point_equals(out, P256_G_HEX), "1*G != G");
+    TEST_ASSERT(p256_fixed_mul(P256_BASE_M, one, out) == 0, "1*M failed");
+    TEST_ASSERT(point_equals(out, SPAKE2_M_HEX), "1*M != M");
+    TEST_ASSERT(p256_fixed_mul(P256_BASE_N, one, out) == 0, "1*N failed");
+    TEST_ASSERT(point_equals(out, SPAKE2_N_HEX), "1*N != N");
+
+    TEST_PASS();
+}
+
+/**
+ * Test k * B against reference results
+ */
+void test_fixed_mul(void) {
+    uint8_t k[P256_SCALAR_LENGTH];
+    uint8_t out[P256_POINT_LENGTH];
+
+    from_hex(K1, k, sizeof(k));
+    TEST_ASSERT(p256_fixed_mul(P256_BASE_G, k, out) == 0, "k1*G failed");
+    TEST_ASSERT(point_equals(out,
+        "04699279104fb767357f26bafaaee58d2ac349a5b861681c692f46e93baa1853a0"
+        "b42d888470f58bcfbfb5aba816e96aa779ba3a4f33f2533e313715192c83d11c"),
+        "k1*G mismatch");
+
+    from_hex(K2, k, sizeof(k));
+    TEST_ASSERT(p256_fixed_mul(P256_BASE_M, k, out) == 0, "k2*M failed");
+    TEST_ASSERT(point_equals(out,
+        "0425121e8064362a5b50811ed0210998ee3a62b44fe9a036faf250abd08e98ea47"
+        "34ac77b377e0aad000f5ac518a03a084a091042cf0f35987556708ebb3d85202"),
+        "k2*M mismatch");
+
+    from_hex(K3, k, sizeof(k));
+    TEST_ASSERT(p256_fixed_mul(P256_BASE_N, k, out) == 0, "k3*N failed");
+    TEST_ASSERT(point_equals(out,
+        "04afd498be089b7a2b9b5a6d062c4d95c0d5ebe0a456b89accd9e38db5c35240cc"
+        "4902884b7c9f31dfd7c306a1361b4a8f04542453a78a50f1b46288bdb06d724f"),
+        "k3*N mismatch");
+
+    TEST_PASS();
+}
+
+/**
+ * Test scalar edge cases: n - 1, reduction mod n, zero and n
+ */
+void test_scalar_edges(void) {
+    uint8_t k[P256_SCALAR_LENGTH];
+    uint8_t out[P256_POINT_LENGTH];
+
+    /* n - 1: -G */
+    from_hex("ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632550",
+             k, sizeof(k));
+    TEST_ASSERT(p256_scalar_check(k) == 0, "n-1 rejected");
+    TEST_ASSERT(p256_fixed_mul(P256_BASE_G, k, out) == 0, "(n-1)*G failed");
+    TEST_ASSERT(point_equals(out,
+        "046b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296"
+        "b01cbd1c01e58065711814b583f061e9d431cca994cea1313449bf97c840ae0a"),
+        "(n-1)*G != -G");
+
+    /* 2^256 - 1 is reduced mod n */
+    memset(k, 0xFF, sizeof(k));
+    TEST_ASSERT(p256_scalar_check(k) != 0, "Scalar >= n accepted");
+    TEST_ASSERT(p256_fixed_mul(P256_BASE_G, k, out) == 0, "(2^256-1)*G failed");
+    TEST_ASSERT(point_equals(out,
+        "04f72cbd240e26c0d21b1023179586eb532c6102c49c3677cc1a3d132b9db9d31a"
+        "43e4ca77e2a36621dc0dbd91bfe7a5d223250ef0cdca831ee453d93fa83408a7"),
+        "(2^256-1)*G mismatch");
+
+    /* 0 and n give the point at infinity */
+    memset(k, 0, sizeof(k));
+    TEST_ASSERT(p256_scalar_check(k) != 0, "Zero accepted");
+    TEST_ASSERT(p256_fixed_mul(P256_BASE_G, k, out) != 0, "0*G succeeded");
+    from_hex("ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632551",
+             k, sizeof(k));
+    TEST_ASSERT(p256_scalar_check(k) != 0, "n accepted");
+    TEST_ASSERT(p256_fixed_mul(P256_BASE_M, k, out) != 0, "n*M succeeded");
+
+    TEST_PASS();
+}
+
+/**
+ * Test k1 * G + k2 * N (SPAKE2+ pB)
+ */
+void test_fixed_muladd(void) {
+    uint8_t k1[P256_SCALAR_LENGTH], k2[P256_SCALAR_LENGTH];
+    uint8_t out[P256_POINT_LENGTH];
+
+    from_hex(K1, k1, sizeof(k1));
+    from_hex(K2, k2, sizeof(k2));
+    TEST_ASSERT(p256_fixed_muladd(P256_BASE_G, k1, P256_BASE_N, k2, out) == 0,
+                "muladd failed");
+    TEST_ASSERT(point_equals(out,
+        "0476437abb42d50da6d7d5f5818f6d8f461d3a962c19ab9574cc72473abf6c71e4"
+        "f972b86bb275724526784f78c212c400f02d204a0d4436f060a58d9e2af8c389"),
+        "k1*G + k2*N mismatch");
+
+    /* k*G + (n-k)*G = infinity */
+    from_hex("ffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632550",
+             k2, sizeof(k2));
+    memset(k1, 0, sizeof(k1));
+    k1[31] = 1;
+    TEST_ASSERT(p256_fixed_muladd(P256_BASE_G, k1, P256_BASE_G, k2, out) != 0,
+                "G + (-G) succeeded");
+
+    TEST_PASS();
+}
+
+/**
+ * Test P + k * N (SPAKE2+ pB from a precomputed y*G)
+ */
+void test_fixed_add(void) {
+    uint8_t a[P256_POINT_LENGTH];
+    uint8_t k[P256_SCALAR_LENGTH];
+
+    from_hex("04adce41ed62e8c5643e3eec4f19a1163bfb526efaedaa5d26989eb794af65be06"
+             "08b4c7da05bc81d1a20aec551214174204215060616c7b635fdf149d8b6ab80e",
+             a, sizeof(a));
+    from_hex(K1, k, sizeof(k));
+    TEST_ASSERT(p256_fixed_add(a, P256_BASE_N, k, a) == 0, "add failed");
+    TEST_ASSERT(point_equals(a,
+        "04a76899ec3524d09e5ca2857ed03cf887209b6940983acd7818a8ba4498bdc671"
+        "5fb1d37d7bb2f675e55a4e98476e52f7da95d709db1adf82821cad0f4ce2a8de"),
+        "A + k1*N mismatch");
+
+    /* G + 1*G takes the doubling path */
+    uint8_t g2[P256_POINT_LENGTH];
+    from_hex(P256_G_HEX, a, sizeof(a));
+    memset(k, 0, sizeof(k));
+    k[31] = 2;
+    TEST_ASSERT(p256_fixed_mul(P256_BASE_G, k, g2) == 0, "2*G failed");
+    k[31] = 1;
+    TEST_ASSERT(p256_fixed_add(a, P256_BASE_G, k, a) == 0, "G + G failed");
+    TEST_ASSERT(memcmp(a, g2, sizeof(a)) == 0, "G + G != 2*G");
+
+    TEST_PASS();
+}
+
+/**
+ * Test P - k * M (SPAKE2+ pA - w0*M) and point validation
+ */
+void test_fixed_sub(void) {
+    uint8_t a[P256_POINT_LENGTH];
+    uint8_t k[P256_SCALAR_LENGTH];
+    uint8_t out[P256_POINT_LENGTH];
+
+    from_hex("04adce41ed62e8c5643e3eec4f19a1163bfb526efaedaa5d26989eb794af65be06"
+             "08b4c7da05bc81d1a20aec551214174204215060616c7b635fdf149d8b6ab80e",
+             a, sizeof(a));
+    from_hex(K1, k, sizeof(k));
+    TEST_ASSERT(p256_fixed_sub(a, P256_BASE_M, k, out) == 0, "sub failed");
+    TEST_ASSERT(point_equals(out,
+        "0410b7be1dcfb256fdd71f428489ac6f8fd2911e33e01501ec1652d89383e8078d"
+        "bcbee9b59294f1120af9a4afbaa4cdca9fea075a56839bcb80b86d597e2fc7f4"),
+        "A - k1*M mismatch");
+
+    /* M - 1*M = infinity; in-place output */
+    from_hex(SPAKE2_M_HEX, a, sizeof(a));
+    memset(k, 0, sizeof(k));
+    k[31] = 1;
+    TEST_ASSERT(p256_fixed_sub(a, P256_BASE_M, k, a) != 0, "M - M succeeded");
+
+    /* Point not on the curve */
+    from_hex(P256_G_HEX, a, sizeof(a));
+    a[64] ^= 0x01;
+    TEST_ASSERT(p256_fixed_sub(a, P256_BASE_M, k, out) != 0,
+                "Off-curve point accepted");
+
+    /* Compressed encoding */
+    from_hex(P256_G_HEX, a, sizeof(a));
+    a[0] = 0x02;
+    TEST_ASSERT(p256_fixed_sub(a, P256_BASE_M, k, out) != 0,
+                "Non-uncompressed point accepted");
+
+    TEST_PASS();
+}
+
+/**
+ * Main test runner
+ */
+int main(void) {
+    printf("=== P-256 Fixed-Base Comb Tests (%d teeth) ===\n\n", P256_COMB_TEETH);
+
+    test_base_points();
+    test_fixed_mul();
+    test_scalar_edges();
+    test_fixed_muladd();
+    test_fixed_add();
+    test_fixed_sub();
+
+    printf("\n=== Test Results ===\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return (tests_failed == 0) ? 0 : 1;
+}
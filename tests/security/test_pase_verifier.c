@@ -0,0 +1,199 @@
+/*
+ * test_pase_verifier.c
+ * Unit tests for the persistent PASE verifier record
+ *
+ * storage_adapter_* is replaced by a single-file in-memory fake so the
+ * tests can inspect and corrupt the stored bytes.
+ */
+
+#include "pase_verifier.h"
+#include <stdio.h>
+#include <string.h>
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(cond, msg) do { \
+    if (!(cond)) { \
+        printf("FAIL: %s - %s\n", __func__, msg); \
+        tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define TEST_PASS() do { \
+    printf("PASS: %s\n", __func__); \
+    tests_passed++; \
+} while(0)
+
+/* ------------------------------------------------------------------ */
+/* Fake storage adapter                                                 */
+/* ------------------------------------------------------------------ */
+
+static uint8_t g_file[256];
+static size_t  g_file_len;
+static int     g_file_used;
+static int     g_fail_writes;
+
+int storage_adapter_write(const char *key, const uint8_t *value, size_t value_len) {
+    if (g_fail_writes || strcmp(key, PASE_VERIFIER_PATH) != 0 ||
+        value_len > sizeof(g_file)) return -1;
+    memcpy(g_file, value, value_len);
+    g_file_len = value_len;
+    g_file_used = 1;
+    return 0;
+}
+
+/* Truncates to the buffer size like the LittleFS adapter */
+int storage_adapter_read(const char *key, uint8_t *value, size_t max_value_len,
+                         size_t *actual_len) {
+    if (!g_file_used || strcmp(key, PASE_VERIFIER_PATH) != 0) return -1;
+    size_t n = g_file_len < max_value_len ? g_file_len : max_value_len;
+    memcpy(value, g_file, n);
+    *actual_len = n;
+    return 0;
+}
+
+int storage_adapter_delete(const char *key) {
+    if (strcmp(key, PASE_VERIFIER_PATH) == 0) {
+        memset(g_file, 0, sizeof(g_file));
+        g_file_len = 0;
+        g_file_used = 0;
+    }
+    return 0;
+}
+
+/* ------------------------------------------------------------------ */
+/* Helpers                                                              */
+/* ------------------------------------------------------------------ */
+
+static void make_verifier(pase_verifier_t *v, uint8_t seed) {
+    v->iterations = PASE_PBKDF2_ITERATIONS;
+    for (size_t i = 0; i < sizeof(v->salt); i++) v->salt[i] = (uint8_t)(seed + i);
+    for (size_t i = 0; i < sizeof(v->w0); i++) v->w0[i] = (uint8_t)(seed ^ (0x80 + i));
+    v->L[0] = 0x04;
+    for (size_t i = 1; i < sizeof(v->L); i++) v->L[i] = (uint8_t)(seed * 3 + i);
+    for (size_t i = 0; i < sizeof(v->generation_tag); i++) v->generation_tag[i] = (uint8_t)(seed + 7 * i);
+}
+
+static void reset(void) {
+    storage_adapter_delete(PASE_VERIFIER_PATH);
+    g_fail_writes = 0;
+}
+
+/* ------------------------------------------------------------------ */
+/* Tests                                                                */
+/* ------------------------------------------------------------------ */
+
+/**
+ * Test store/load round trip and the on-flash layout
+ */
+void test_round_trip(void) {
+    reset();
+
+    pase_verifier_t v, out;
+    make_verifier(&v, 0x11);
+    TEST_ASSERT(pase_verifier_store(&v) == 0, "Store failed");
+    TEST_ASSERT(g_file_len == PASE_VERIFIER_RECORD_LENGTH, "Wrong record length");
+
+    /* Layout shared with tools/provision_attestation.py */
+    TEST_ASSERT(g_file[0] == PASE_VERIFIER_VERSION, "Wrong version byte");
+    TEST_ASSERT(g_file[1] == (PASE_PBKDF2_ITERATIONS & 0xFF) &&
+                g_file[2] == (PASE_PBKDF2_ITERATIONS >> 8) &&
+                g_file[3] == 0 && g_file[4] == 0, "Iterations not little-endian");
+    TEST_ASSERT(memcmp(g_file + 5, v.salt, sizeof(v.salt)) == 0, "Salt misplaced");
+    TEST_ASSERT(memcmp(g_file + 37, v.w0, sizeof(v.w0)) == 0, "w0 misplaced");
+    TEST_ASSERT(memcmp(g_file + 69, v.L, sizeof(v.L)) == 0, "L misplaced");
+    TEST_ASSERT(memcmp(g_file + 134, v.generation_tag, sizeof(v.generation_tag)) == 0,
+                "Generation tag misplaced");
+
+    memset(&out, 0, sizeof(out));
+    TEST_ASSERT(pase_verifier_load(&out) == 0, "Load failed");
+    TEST_ASSERT(memcmp(&out, &v, sizeof(v)) == 0, "Loaded verifier differs");
+
+    TEST_PASS();
+}
+
+/**
+ * Test that missing or malformed records are rejected
+ */
+void test_invalid_records(void) {
+    reset();
+
+    pase_verifier_t v, out;
+    TEST_ASSERT(pase_verifier_load(&out) != 0, "Loaded with nothing stored");
+    TEST_ASSERT(pase_verifier_load(NULL) != 0, "NULL accepted");
+
+    make_verifier(&v, 0x22);
+    TEST_ASSERT(pase_verifier_store(&v) == 0, "Store failed");
+
+    /* Unknown version */
+    g_file[0] = PASE_VERIFIER_VERSION + 1;
+    TEST_ASSERT(pase_verifier_load(&out) != 0, "Unknown version accepted");
+    g_file[0] = PASE_VERIFIER_VERSION;
+
+    /* Truncated and oversized */
+    g_file_len = PASE_VERIFIER_RECORD_LENGTH - 1;
+    TEST_ASSERT(pase_verifier_load(&out) != 0, "Truncated record accepted");
+    g_file_len = PASE_VERIFIER_RECORD_LENGTH + 1;
+    TEST_ASSERT(pase_verifier_load(&out) != 0, "Oversized record accepted");
+    g_file_len = PASE_VERIFIER_RECORD_LENGTH;
+
+    /* Iterations out of range */
+    v.iterations = PASE_PBKDF2_ITERATIONS_MIN - 1;
+    TEST_ASSERT(pase_verifier_store(&v) == 0, "Store failed");
+    TEST_ASSERT(pase_verifier_load(&out) != 0, "Low iteration count accepted");
+    v.iterations = PASE_PBKDF2_ITERATIONS_MAX + 1;
+    TEST_ASSERT(pase_verifier_store(&v) == 0, "Store failed");
+    TEST_ASSERT(pase_verifier_load(&out) != 0, "High iteration count accepted");
+
+    /* Compressed or garbage L */
+    v.iterations = PASE_PBKDF2_ITERATIONS;
+    v.L[0] = 0x02;
+    TEST_ASSERT(pase_verifier_store(&v) == 0, "Store failed");
+    TEST_ASSERT(pase_verifier_load(&out) != 0, "Bad L prefix accepted");
+
+    v.L[0] = 0x04;
+    TEST_ASSERT(pase_verifier_store(&v) == 0, "Store failed");
+    TEST_ASSERT(pase_verifier_load(&out) == 0, "Valid record rejected");
+
+    TEST_PASS();
+}
+
+/**
+ * Test clear and write failure
+ */
+void test_clear(void) {
+    reset();
+
+    pase_verifier_t v, out;
+    make_verifier(&v, 0x33);
+    TEST_ASSERT(pase_verifier_store(&v) == 0, "Store failed");
+    TEST_ASSERT(pase_verifier_clear() == 0, "Clear failed");
+    TEST_ASSERT(pase_verifier_load(&out) != 0, "Loaded after clear");
+    TEST_ASSERT(pase_verifier_clear() == 0, "Clear of absent record failed");
+
+    g_fail_writes = 1;
+    TEST_ASSERT(pase_verifier_store(&v) != 0, "Failed write reported success");
+    TEST_ASSERT(pase_verifier_store(NULL) != 0, "NULL accepted");
+
+    TEST_PASS();
+}
+
+/**
+ * Main test runner
+ */
+int main(void) {
+    printf("=== PASE Verifier Store Tests ===\n\n");
+
+    test_round_trip();
+    test_invalid_records();
+    test_clear();
+
+    printf("\n=== Test Results ===\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return (tests_failed == 0) ? 0 : 1;
+}
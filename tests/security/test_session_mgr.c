@@ -4,6 +4,7 @@
  */
 
 #include "session_mgr.h"
+#include "pico/time.h"
 #include <stdio.h>
 #include <string.h>
 #include <assert.h>
@@ -152,7 +153,7 @@ void test_multiple_sessions(void) {
 }
 
 /**
- * Test: Session limit (max 5 sessions)
+ * Test: Session limit (MAX_SESSIONS, none idle long enough to evict)
  */
 void test_session_limit(void) {
     TEST("test_session_limit");
@@ -161,30 +162,147 @@ void test_session_limit(void) {
     
     uint8_t key[SESSION_KEY_LENGTH] = {0};
     
-    // Create 5 sessions (max)
-    for (int i = 1; i <= 5; i++) {
+    // Fill the table
+    for (int i = 1; i <= MAX_SESSIONS; i++) {
         assert(session_create(i, key, sizeof(key)) == 0);
     }
-    assert(session_get_active_count() == 5);
+    assert(session_get_active_count() == MAX_SESSIONS);
     
-    // Try to create 6th session - should fail
-    int result = session_create(6, key, sizeof(key));
+    // All sessions were just used - one more must fail
+    int result = session_create(MAX_SESSIONS + 1, key, sizeof(key));
     assert(result != 0);
-    assert(session_get_active_count() == 5);
+    assert(session_get_active_count() == MAX_SESSIONS);
     
     // Destroy one and try again
     session_destroy(1);
-    assert(session_create(6, key, sizeof(key)) == 0);
-    assert(session_get_active_count() == 5);
+    assert(session_create(MAX_SESSIONS + 1, key, sizeof(key)) == 0);
+    assert(session_get_active_count() == MAX_SESSIONS);
+    
+    // Every remaining session is still reachable through the index
+    for (int i = 2; i <= MAX_SESSIONS + 1; i++) {
+        assert(session_is_active(i));
+    }
+    assert(!session_is_active(1));
     
     // Clean up
-    for (int i = 2; i <= 6; i++) {
+    for (int i = 2; i <= MAX_SESSIONS + 1; i++) {
         session_destroy(i);
     }
     
     PASS();
 }
 
+/**
+ * Test: LRU eviction of idle sessions when the table is full
+ */
+void test_session_lru_eviction(void) {
+    TEST("test_session_lru_eviction");
+    
+    session_mgr_init();
+    
+    uint8_t key[SESSION_KEY_LENGTH] = {0};
+    uint8_t cipher[64];
+    size_t cipher_len;
+    session_mgr_stats_t before, after;
+    session_mgr_get_stats(&before);
+    
+    // Session IDs spread over the hash space
+    for (int i = 0; i < MAX_SESSIONS; i++) {
+        assert(session_create((uint16_t)(0x100 + i * 0x101), key, sizeof(key)) == 0);
+    }
+    
+    // Everything goes idle, then all but the second-oldest are used again
+    host_time_offset_us += (uint64_t)(SESSION_EVICT_MIN_IDLE_SECONDS + 1) * 1000000u;
+    for (int i = 0; i < MAX_SESSIONS; i++) {
+        if (i != 1) {
+            assert(session_encrypt((uint16_t)(0x100 + i * 0x101),
+                                   (const uint8_t *)"x", 1,
+                                   cipher, sizeof(cipher), &cipher_len) == 0);
+        }
+    }
+    
+    // The least recently used (idle) session makes room
+    assert(session_create(0x7777, key, sizeof(key)) == 0);
+    assert(!session_is_active(0x0201));
+    assert(session_is_active(0x0100));
+    assert(session_is_active(0x7777));
+    assert(session_get_active_count() == MAX_SESSIONS);
+    
+    // The rest were just used, so the next creation is refused
+    assert(session_create(0x7778, key, sizeof(key)) != 0);
+    
+    session_mgr_get_stats(&after);
+    assert(after.evictions == before.evictions + 1);
+    assert(after.create_failures == before.create_failures + 1);
+    assert(after.high_water == MAX_SESSIONS);
+    
+    for (int i = 0; i < MAX_SESSIONS; i++) {
+        session_destroy((uint16_t)(0x100 + i * 0x101));
+    }
+    session_destroy(0x7777);
+    assert(session_get_active_count() == 0);
+    
+    PASS();
+}
+
+/**
+ * Test: Idle expiry from the LRU tail and lookup by peer node ID
+ */
+void test_session_expiry_and_peer_lookup(void) {
+    TEST("test_session_expiry_and_peer_lookup");
+    
+    session_mgr_init();
+    
+    uint8_t key[SESSION_KEY_LENGTH] = {0};
+    session_params_t params = {
+        .local_session_id = 0x10,
+        .peer_session_id = 0x20,
+        .tx_key = key,
+        .rx_key = key,
+        .local_node_id = 1,
+        .peer_node_id = 0xABCD00000001ULL,
+    };
+    uint16_t found = 0;
+    
+    assert(session_create_secure(&params) == 0);
+    host_time_offset_us += 10u * 1000000u;
+    params.local_session_id = 0x11;
+    assert(session_create_secure(&params) == 0);
+    params.local_session_id = 0x12;
+    params.peer_node_id = 0xABCD00000002ULL;
+    params.auth_mode = SESSION_AUTH_CASE;
+    assert(session_create_secure(&params) == 0);
+    
+    // Sessions remember how they were established (PASE by default)
+    uint8_t auth_mode = 0xFF;
+    assert(session_get_auth_mode(0x11, &auth_mode) == 0 && auth_mode == SESSION_AUTH_PASE);
+    assert(session_get_auth_mode(0x12, &auth_mode) == 0 && auth_mode == SESSION_AUTH_CASE);
+    assert(session_get_auth_mode(0x13, &auth_mode) != 0);
+    
+    // Most recently used session with the peer wins
+    assert(session_find_by_peer_node(0xABCD00000001ULL, &found) == 0 && found == 0x11);
+    assert(session_find_by_peer_node(0xABCD00000002ULL, &found) == 0 && found == 0x12);
+    assert(session_find_by_peer_node(0xABCD00000003ULL, &found) != 0);
+    assert(session_find_by_peer_node(0, &found) != 0);
+    
+    // Nothing is due yet
+    assert(session_mgr_poll() == 0);
+    assert(session_get_active_count() == 3);
+    
+    // Only the oldest session crosses the timeout
+    host_time_offset_us += (uint64_t)(SESSION_TIMEOUT_SECONDS - 5) * 1000000u;
+    assert(session_mgr_poll() == 1);
+    assert(!session_is_active(0x10));
+    assert(session_find_by_peer_node(0xABCD00000001ULL, &found) == 0 && found == 0x11);
+    
+    host_time_offset_us += 10u * 1000000u;
+    assert(session_mgr_poll() == 2);
+    assert(session_get_active_count() == 0);
+    assert(session_find_by_peer_node(0xABCD00000001ULL, &found) != 0);
+    
+    PASS();
+}
+
 /**
  * Test: Message counter increment
  */
@@ -198,8 +316,9 @@ void test_message_counter_increment(void) {
     
     session_create(session_id, key, sizeof(key));
     
-    // Initial counter should be 0
-    assert(session_get_message_counter(session_id) == 0);
+    // Initial counter is random in [1, 2^28]
+    uint32_t start = session_get_message_counter(session_id);
+    assert(start >= 1 && start <= SESSION_COUNTER_INIT_MASK + 1u);
     
     // Encrypt a message - counter should increment
     const char *msg = "Test";
@@ -208,13 +327,18 @@ void test_message_counter_increment(void) {
     
     session_encrypt(session_id, (uint8_t*)msg, strlen(msg),
                    cipher, sizeof(cipher), &cipher_len);
-    assert(session_get_message_counter(session_id) == 1);
+    assert(session_get_message_counter(session_id) == start + 1);
     
     // Encrypt another message
     session_encrypt(session_id, (uint8_t*)msg, strlen(msg),
                    cipher, sizeof(cipher), &cipher_len);
-    assert(session_get_message_counter(session_id) == 2);
+    assert(session_get_message_counter(session_id) == start + 2);
+    
+    session_destroy(session_id);
     
+    // A new session does not reuse the previous start
+    session_create(session_id, key, sizeof(key));
+    assert(session_get_message_counter(session_id) != start);
     session_destroy(session_id);
     
     PASS();
@@ -331,6 +455,100 @@ void test_invalid_key_length(void) {
     PASS();
 }
 
+/**
+ * Test: Secured message encrypted in place with spec nonce and header AAD
+ * Two sessions stand in for both ends: we send on 0x1111 (peer 0x2222) and
+ * the peer's side is local session 0x2222 with the keys swapped.
+ */
+void test_secured_message_in_place(void) {
+    TEST("test_secured_message_in_place");
+    
+    session_mgr_init();
+    
+    uint8_t key_r2i[SESSION_KEY_LENGTH] = {0x5A, 0x01};
+    uint8_t key_i2r[SESSION_KEY_LENGTH] = {0xA5, 0x02};
+    session_params_t ours = {
+        .local_session_id = 0x1111, .peer_session_id = 0x2222,
+        .tx_key = key_r2i, .rx_key = key_i2r,
+        .local_node_id = 0xAAAA0001ull, .peer_node_id = 0xBBBB0002ull,
+    };
+    session_params_t theirs = {
+        .local_session_id = 0x2222, .peer_session_id = 0x1111,
+        .tx_key = key_i2r, .rx_key = key_r2i,
+        .local_node_id = 0xBBBB0002ull, .peer_node_id = 0xAAAA0001ull,
+    };
+    assert(session_create_secure(&ours) == 0);
+    assert(session_create_secure(&theirs) == 0);
+    
+    static packet_buffer_t pb;
+    const char *report = "attribute report payload";
+    size_t report_len = strlen(report);
+    packet_buffer_reset(&pb);
+    memcpy(packet_buffer_tail(&pb), report, report_len);
+    assert(packet_buffer_commit(&pb, report_len) == 0);
+    
+    matter_message_t msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.protocol_id = MATTER_PROTOCOL_INTERACTION_MODEL;
+    msg.protocol_opcode = MATTER_IM_OPCODE_REPORT_DATA;
+    msg.exchange_id = 0x0042;
+    msg.exchange_flags = MATTER_EXCH_FLAG_RELIABILITY;
+    
+    uint32_t counter = session_get_message_counter(0x1111);
+    assert(session_encrypt_packet(0x1111, &pb, &msg) == 0);
+    assert(msg.header.message_counter == counter);
+    assert(session_get_message_counter(0x1111) == counter + 1);
+    assert(pb.length == 8 + 6 + report_len + SESSION_TAG_LENGTH);
+    
+    // Header carries the peer's session ID; no nonce precedes the payload
+    uint8_t *wire = packet_buffer_data(&pb);
+    assert(wire[1] == 0x22 && wire[2] == 0x22);
+    
+    // Recompute per spec: nonce = flags | counter LE | source node LE,
+    // AAD = message header, plaintext = exchange header + payload
+    uint8_t expected[64];
+    uint8_t nonce[SESSION_NONCE_LENGTH] = {
+        0x00, (uint8_t)counter, (uint8_t)(counter >> 8),
+        (uint8_t)(counter >> 16), (uint8_t)(counter >> 24),
+        0x01, 0x00, 0xAA, 0xAA, 0x00, 0x00, 0x00, 0x00
+    };
+    uint8_t plain[64] = {0x04, MATTER_IM_OPCODE_REPORT_DATA, 0x42, 0x00, 0x01, 0x00};
+    memcpy(plain + 6, report, report_len);
+    aes_ccm_ctx_t ccm;
+    assert(aes_ccm_setkey(&ccm, key_r2i, sizeof(key_r2i)) == 0);
+    assert(aes_ccm_encrypt(&ccm, nonce, sizeof(nonce), wire, 8,
+                           plain, 6 + report_len, expected,
+                           expected + 6 + report_len, SESSION_TAG_LENGTH) == 0);
+    aes_ccm_free(&ccm);
+    assert(memcmp(wire + 8, expected, 6 + report_len + SESSION_TAG_LENGTH) == 0);
+    
+    // Receive on the peer's side and decrypt in place
+    matter_message_t rx;
+    assert(matter_message_decode_fast(wire, pb.length, &rx) == MATTER_MSG_SUCCESS);
+    assert(rx.header.session_id == 0x2222);
+    assert(session_decrypt_message(wire, &rx) == 0);
+    assert(matter_exchange_header_decode(&rx) == MATTER_MSG_SUCCESS);
+    assert(rx.protocol_opcode == MATTER_IM_OPCODE_REPORT_DATA);
+    assert(rx.exchange_id == 0x0042);
+    assert(rx.payload_length == report_len);
+    assert(memcmp(rx.payload, report, report_len) == 0);
+    
+    // A modified message header (AAD) fails authentication
+    packet_buffer_reset(&pb);
+    memcpy(packet_buffer_tail(&pb), report, report_len);
+    packet_buffer_commit(&pb, report_len);
+    assert(session_encrypt_packet(0x1111, &pb, &msg) == 0);
+    wire = packet_buffer_data(&pb);
+    wire[3] ^= 0x80;                        // Security flags: privacy bit
+    assert(matter_message_decode_fast(wire, pb.length, &rx) == MATTER_MSG_SUCCESS);
+    assert(session_decrypt_message(wire, &rx) != 0);
+    
+    session_destroy(0x1111);
+    session_destroy(0x2222);
+    
+    PASS();
+}
+
 int main(void) {
     printf("=====================================\n");
     printf("Session Manager Unit Tests\n");
@@ -340,10 +558,13 @@ int main(void) {
     test_encrypt_decrypt_roundtrip();
     test_multiple_sessions();
     test_session_limit();
+    test_session_lru_eviction();
+    test_session_expiry_and_peer_lookup();
     test_message_counter_increment();
     test_decrypt_with_wrong_session_id();
     test_replay_protection();
     test_invalid_key_length();
+    test_secured_message_in_place();
     
     printf("\n=====================================\n");
     printf("All Session Manager tests passed!\n");
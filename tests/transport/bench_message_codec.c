@@ -0,0 +1,91 @@
+/*
+ * bench_message_codec.c
+ * Host benchmark: general message codec vs. header-template fast path
+ *
+ * Encodes and decodes a typical unicast IM report (source node ID present,
+ * small TLV payload) with both code paths and prints ns/message.  Also
+ * checks that both paths produce identical bytes, so it doubles as a test.
+ */
+
+#include "message_codec.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_ITERATIONS    2000000
+
+static volatile uint32_t sink;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+int main(void) {
+    static uint8_t buffer[MATTER_MAX_MESSAGE_SIZE] __attribute__((aligned(4)));
+    static uint8_t reference[MATTER_MAX_MESSAGE_SIZE];
+    const uint8_t payload[24] = {0x15, 0x36, 0x01, 0x15, 0x35, 0x01, 0x24, 0x00};
+    size_t len = 0, ref_len = 0;
+
+    matter_header_template_t tmpl;
+    matter_header_template_init(&tmpl, 0, 0, 0x0123456789ABCDEFULL, 0);
+
+    matter_message_t msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.header.source_node_id = 0x0123456789ABCDEFULL;
+    msg.protocol_id = MATTER_PROTOCOL_INTERACTION_MODEL;
+    msg.protocol_opcode = MATTER_IM_OPCODE_REPORT_DATA;
+    msg.exchange_id = 0x4321;
+    msg.payload = payload;
+    msg.payload_length = sizeof(payload);
+
+    printf("=== Matter Message Codec Benchmark (%d iterations) ===\n\n", BENCH_ITERATIONS);
+
+    // Encode: general path
+    double t0 = now_ns();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        msg.header.message_counter = i;
+        matter_message_encode(&msg, buffer, sizeof(buffer), &len);
+        sink += buffer[4];
+    }
+    double general_enc = (now_ns() - t0) / BENCH_ITERATIONS;
+    memcpy(reference, buffer, len);
+    ref_len = len;
+
+    // Encode: template fast path
+    t0 = now_ns();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        msg.header.message_counter = i;
+        matter_message_encode_fast(&tmpl, &msg, buffer, sizeof(buffer), &len);
+        sink += buffer[4];
+    }
+    double fast_enc = (now_ns() - t0) / BENCH_ITERATIONS;
+
+    if (len != ref_len || memcmp(buffer, reference, len) != 0) {
+        printf("FAIL: fast path output differs from general encoder\n");
+        return 1;
+    }
+
+    // Decode: general path
+    matter_message_t out;
+    t0 = now_ns();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        matter_message_decode(reference, ref_len, &out);
+        sink += out.header.message_counter;
+    }
+    double general_dec = (now_ns() - t0) / BENCH_ITERATIONS;
+
+    // Decode: fixed-layout fast path
+    t0 = now_ns();
+    for (uint32_t i = 0; i < BENCH_ITERATIONS; i++) {
+        matter_message_decode_fast(reference, ref_len, &out);
+        sink += out.header.message_counter;
+    }
+    double fast_dec = (now_ns() - t0) / BENCH_ITERATIONS;
+
+    printf("encode  general: %6.1f ns/msg   fast: %6.1f ns/msg\n", general_enc, fast_enc);
+    printf("decode  general: %6.1f ns/msg   fast: %6.1f ns/msg\n", general_dec, fast_dec);
+
+    return 0;
+}
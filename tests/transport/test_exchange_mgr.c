@@ -0,0 +1,293 @@
+/*
+ * test_exchange_mgr.c
+ * Unit tests for the exchange manager and MRP (reliable messaging)
+ */
+
+#include "exchange_mgr.h"
+#include "msg_pool.h"
+#include <stdio.h>
+#include <string.h>
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(cond, msg) do { \
+    if (!(cond)) { \
+        printf("FAIL: %s - %s\n", __func__, msg); \
+        tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define TEST_PASS() do { \
+    printf("PASS: %s\n", __func__); \
+    tests_passed++; \
+} while(0)
+
+#define PEER_IP     "192.168.1.50"
+#define PEER_PORT   5540
+
+// Mock transport
+static uint32_t mock_now = 0;
+static int transmit_count = 0;
+static uint32_t transmit_times[MRP_MAX_TRANSMISSIONS];
+static int ack_count = 0;
+static uint32_t last_ack_counter = 0;
+static uint16_t last_ack_exchange = 0;
+
+static int mock_transmit(const exchange_ctx_t *ex, const packet_buffer_t *pb) {
+    (void)ex;
+    (void)pb;
+    if (transmit_count < MRP_MAX_TRANSMISSIONS) {
+        transmit_times[transmit_count] = mock_now;
+    }
+    transmit_count++;
+    return 0;
+}
+
+static int mock_ack(const exchange_ctx_t *ex, uint32_t ack_counter) {
+    ack_count++;
+    last_ack_counter = ack_counter;
+    last_ack_exchange = ex->exchange_id;
+    return 0;
+}
+
+static void reset(void) {
+    mock_now = 1000;
+    transmit_count = 0;
+    ack_count = 0;
+    last_ack_counter = 0;
+    last_ack_exchange = 0;
+    exchange_mgr_init(mock_transmit, mock_ack);
+}
+
+static matter_message_t make_request(uint16_t exchange_id, uint32_t counter,
+                                     uint8_t flags) {
+    matter_message_t msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.header.message_counter = counter;
+    msg.protocol_id = MATTER_PROTOCOL_INTERACTION_MODEL;
+    msg.protocol_opcode = MATTER_IM_OPCODE_READ_REQUEST;
+    msg.exchange_id = exchange_id;
+    msg.exchange_flags = flags;
+    return msg;
+}
+
+/**
+ * Send a reliable response on ex at mock_now; returns the message as sent
+ */
+static matter_message_t send_response(exchange_ctx_t *ex, uint32_t counter) {
+    matter_message_t rsp;
+    memset(&rsp, 0, sizeof(rsp));
+    rsp.header.message_counter = counter;
+    rsp.protocol_id = MATTER_PROTOCOL_INTERACTION_MODEL;
+    rsp.protocol_opcode = MATTER_IM_OPCODE_REPORT_DATA;
+    exchange_mgr_prepare(ex, &rsp, true);
+
+    packet_buffer_t *pb = msg_pool_alloc();
+    exchange_mgr_sent(ex, &rsp, pb, mock_now);
+    msg_pool_release(pb);
+    return rsp;
+}
+
+/**
+ * Test the ACK for a request rides on the response
+ */
+void test_piggybacked_ack(void) {
+    reset();
+    exchange_ctx_t *ex = NULL;
+    matter_message_t req = make_request(0x10, 100,
+        MATTER_EXCH_FLAG_INITIATOR | MATTER_EXCH_FLAG_RELIABILITY);
+
+    TEST_ASSERT(exchange_mgr_on_message(&req, false, PEER_IP, PEER_PORT, mock_now, &ex)
+                == EXCHANGE_RX_DELIVER && ex != NULL, "Request should be delivered");
+
+    matter_message_t rsp = send_response(ex, 7);
+    TEST_ASSERT(rsp.exchange_id == 0x10, "Response must use the request's exchange");
+    TEST_ASSERT(rsp.exchange_flags == (MATTER_EXCH_FLAG_ACK | MATTER_EXCH_FLAG_RELIABILITY),
+                "Responder sets A and R, not I");
+    TEST_ASSERT(rsp.ack_counter == 100, "Piggybacked counter mismatch");
+    exchange_mgr_close(ex);
+
+    mock_now += 1000;
+    matter_message_t ack = make_request(0x10, 101,
+        MATTER_EXCH_FLAG_INITIATOR | MATTER_EXCH_FLAG_ACK);
+    ack.protocol_id = MATTER_PROTOCOL_SECURE_CHANNEL;
+    ack.protocol_opcode = MATTER_SC_OPCODE_MRP_STANDALONE_ACK;
+    ack.ack_counter = 7;
+    TEST_ASSERT(exchange_mgr_on_message(&ack, false, PEER_IP, PEER_PORT, mock_now, &ex)
+                == EXCHANGE_RX_DROP, "Standalone ACK must not reach handlers");
+
+    exchange_mgr_poll(mock_now + 5000);
+    exchange_stats_t stats;
+    exchange_mgr_get_stats(&stats);
+    TEST_ASSERT(ack_count == 0, "No standalone ACK expected");
+    TEST_ASSERT(transmit_count == 0, "ACKed response must not be retransmitted");
+    TEST_ASSERT(stats.piggybacked_acks == 1, "Piggyback count mismatch");
+    TEST_ASSERT(stats.active == 0, "Exchange should be freed");
+    TEST_ASSERT(msg_pool_available() == MSG_POOL_BLOCK_COUNT, "Retained block leaked");
+
+    TEST_PASS();
+}
+
+/**
+ * Test a standalone ACK goes out when the handler does not respond
+ */
+void test_standalone_ack_timeout(void) {
+    reset();
+    exchange_ctx_t *ex = NULL;
+    matter_message_t req = make_request(0x20, 555,
+        MATTER_EXCH_FLAG_INITIATOR | MATTER_EXCH_FLAG_RELIABILITY);
+
+    TEST_ASSERT(exchange_mgr_on_message(&req, false, PEER_IP, PEER_PORT, mock_now, &ex)
+                == EXCHANGE_RX_DELIVER, "Request should be delivered");
+    exchange_mgr_close(ex);
+
+    exchange_mgr_poll(mock_now + MRP_STANDALONE_ACK_TIMEOUT_MS - 1);
+    TEST_ASSERT(ack_count == 0, "ACK sent before timeout");
+
+    exchange_mgr_poll(mock_now + MRP_STANDALONE_ACK_TIMEOUT_MS);
+    TEST_ASSERT(ack_count == 1 && last_ack_counter == 555 && last_ack_exchange == 0x20,
+                "Standalone ACK mismatch");
+
+    exchange_stats_t stats;
+    exchange_mgr_get_stats(&stats);
+    TEST_ASSERT(stats.active == 0, "Exchange should be freed after ACK");
+
+    TEST_PASS();
+}
+
+/**
+ * Test a retransmitted request is re-acknowledged, not re-delivered
+ */
+void test_duplicate_request(void) {
+    reset();
+    exchange_ctx_t *ex = NULL;
+    matter_message_t req = make_request(0x30, 9000,
+        MATTER_EXCH_FLAG_INITIATOR | MATTER_EXCH_FLAG_RELIABILITY);
+
+    exchange_mgr_on_message(&req, false, PEER_IP, PEER_PORT, mock_now, &ex);
+    send_response(ex, 11);
+    exchange_mgr_close(ex);
+
+    // Our response was lost; the controller retransmits its request.  The
+    // exchange remembers the counter even without the replay window.
+    mock_now += 300;
+    TEST_ASSERT(exchange_mgr_on_message(&req, false, PEER_IP, PEER_PORT, mock_now, &ex)
+                == EXCHANGE_RX_DROP, "Retransmitted request must not be delivered");
+    TEST_ASSERT(ack_count == 1 && last_ack_counter == 9000, "Duplicate must be re-ACKed");
+
+    // Duplicate flagged by the replay window with no context left
+    matter_message_t other = make_request(0x31, 42,
+        MATTER_EXCH_FLAG_INITIATOR | MATTER_EXCH_FLAG_RELIABILITY);
+    TEST_ASSERT(exchange_mgr_on_message(&other, true, PEER_IP, PEER_PORT, mock_now, &ex)
+                == EXCHANGE_RX_DROP, "Replay-window duplicate must be dropped");
+    TEST_ASSERT(ack_count == 2 && last_ack_exchange == 0x31, "Context-free re-ACK mismatch");
+
+    exchange_stats_t stats;
+    exchange_mgr_get_stats(&stats);
+    TEST_ASSERT(stats.duplicates == 2, "Duplicate count mismatch");
+    TEST_ASSERT(stats.active == 1, "Only the unacknowledged exchange should remain");
+
+    TEST_PASS();
+}
+
+/**
+ * Test retransmission with exponential backoff and giving up
+ */
+void test_retransmission_backoff(void) {
+    reset();
+    exchange_ctx_t *ex = exchange_mgr_open(0, PEER_IP, PEER_PORT);
+    TEST_ASSERT(ex != NULL && ex->initiator, "Open failed");
+
+    matter_message_t out = send_response(ex, 77);
+    TEST_ASSERT(out.exchange_flags == (MATTER_EXCH_FLAG_INITIATOR | MATTER_EXCH_FLAG_RELIABILITY),
+                "Initiator sets I and R");
+    exchange_mgr_close(ex);
+    TEST_ASSERT(msg_pool_available() == MSG_POOL_BLOCK_COUNT - 1, "Block should be retained");
+
+    uint32_t start = mock_now;
+    for (uint32_t t = 0; t < 20000; t += 10) {
+        mock_now = start + t;
+        exchange_mgr_poll(mock_now);
+    }
+
+    TEST_ASSERT(transmit_count == MRP_MAX_TRANSMISSIONS - 1, "Retry count mismatch");
+
+    // Idle peer: first wait is 500 * 1.1 plus up to 25% jitter
+    uint32_t first = transmit_times[0] - start;
+    TEST_ASSERT(first >= 550 && first <= 700, "First retransmission timing");
+    uint32_t prev_gap = first;
+    for (int i = 1; i < transmit_count; i++) {
+        uint32_t gap = transmit_times[i] - transmit_times[i - 1];
+        if (i >= 2) {
+            TEST_ASSERT(gap > prev_gap, "Backoff should grow");
+        }
+        prev_gap = gap;
+    }
+
+    exchange_stats_t stats;
+    exchange_mgr_get_stats(&stats);
+    TEST_ASSERT(stats.retransmissions == MRP_MAX_TRANSMISSIONS - 1, "Stats retransmissions");
+    TEST_ASSERT(stats.delivery_failures == 1, "Delivery failure not recorded");
+    TEST_ASSERT(stats.active == 0, "Failed exchange should be freed");
+    TEST_ASSERT(msg_pool_available() == MSG_POOL_BLOCK_COUNT, "Block not released");
+
+    TEST_PASS();
+}
+
+/**
+ * Test an ACK piggybacked on the peer's next message stops retransmission
+ */
+void test_ack_stops_retransmission(void) {
+    reset();
+    exchange_ctx_t *ex = NULL;
+    matter_message_t req = make_request(0x40, 1,
+        MATTER_EXCH_FLAG_INITIATOR | MATTER_EXCH_FLAG_RELIABILITY);
+
+    exchange_mgr_on_message(&req, false, PEER_IP, PEER_PORT, mock_now, &ex);
+    send_response(ex, 500);
+    exchange_mgr_close(ex);
+
+    // Next request on the same exchange acknowledges our response
+    mock_now += 100;
+    matter_message_t next = make_request(0x40, 2,
+        MATTER_EXCH_FLAG_INITIATOR | MATTER_EXCH_FLAG_RELIABILITY | MATTER_EXCH_FLAG_ACK);
+    next.ack_counter = 500;
+    exchange_ctx_t *ex2 = NULL;
+    TEST_ASSERT(exchange_mgr_on_message(&next, false, PEER_IP, PEER_PORT, mock_now, &ex2)
+                == EXCHANGE_RX_DELIVER, "Next request should be delivered");
+    TEST_ASSERT(ex2 == ex && ex2->retrans_pb == NULL, "ACK should clear retransmission");
+
+    // A different peer using the same exchange ID gets its own context
+    exchange_ctx_t *ex3 = NULL;
+    TEST_ASSERT(exchange_mgr_on_message(&req, false, "192.168.1.51", PEER_PORT, mock_now, &ex3)
+                == EXCHANGE_RX_DELIVER && ex3 != ex2, "Peers must not share exchanges");
+
+    exchange_mgr_poll(mock_now + 2000);
+    TEST_ASSERT(transmit_count == 0, "Nothing should be retransmitted");
+
+    TEST_PASS();
+}
+
+/**
+ * Main test runner
+ */
+int main(void) {
+    printf("=== Exchange Manager / MRP Tests ===\n\n");
+
+    msg_pool_init();
+
+    test_piggybacked_ack();
+    test_standalone_ack_timeout();
+    test_duplicate_request();
+    test_retransmission_backoff();
+    test_ack_stops_retransmission();
+
+    printf("\n=== Test Results ===\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return (tests_failed == 0) ? 0 : 1;
+}
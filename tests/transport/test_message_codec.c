@@ -264,6 +264,187 @@ void test_invalid_message_handling(void) {
     TEST_PASS();
 }
 
+/**
+ * Test that the template fast path is byte-identical to the general encoder
+ */
+void test_fast_encode_matches_general(void) {
+    static const struct {
+        uint16_t session_id;
+        uint8_t security_flags;
+        uint64_t source_node_id;
+        uint64_t dest_node_id;
+    } shapes[] = {
+        {0, 0, 0, 0},
+        {0, 0, 0x1122334455667788ULL, 0},
+        {0, 0, 0, 0x8877665544332211ULL},
+        {0x1234, 0, 0x0102030405060708ULL, 0xA1A2A3A4A5A6A7A8ULL},
+        {0x0042, 0x01, 0, 0},   // Group session type → general path
+    };
+    const uint8_t payload[] = {0x15, 0x24, 0x00, 0x2A, 0x18};
+    uint8_t general[64];
+    uint8_t fast[64 + 1];
+
+    for (size_t i = 0; i < sizeof(shapes) / sizeof(shapes[0]); i++) {
+        matter_header_template_t tmpl;
+        matter_header_template_init(&tmpl, shapes[i].session_id,
+                                    shapes[i].security_flags,
+                                    shapes[i].source_node_id,
+                                    shapes[i].dest_node_id);
+
+        matter_message_t msg = {0};
+        msg.header.session_id = shapes[i].session_id;
+        msg.header.security_flags = shapes[i].security_flags;
+        msg.header.source_node_id = shapes[i].source_node_id;
+        msg.header.dest_node_id = shapes[i].dest_node_id;
+        msg.header.message_counter = 0xDEADBEEF;
+        msg.protocol_id = MATTER_PROTOCOL_INTERACTION_MODEL;
+        msg.protocol_opcode = MATTER_IM_OPCODE_REPORT_DATA;
+        msg.exchange_id = 0xBEEF;
+        msg.payload = payload;
+        msg.payload_length = sizeof(payload);
+
+        size_t general_len = 0, fast_len = 0;
+        TEST_ASSERT(matter_message_encode(&msg, general, sizeof(general), &general_len)
+                    == MATTER_MSG_SUCCESS, "General encode failed");
+
+        // Aligned and unaligned output buffers must both match
+        for (size_t skew = 0; skew < 2; skew++) {
+            memset(fast, 0xCC, sizeof(fast));
+            TEST_ASSERT(matter_message_encode_fast(&tmpl, &msg, fast + skew,
+                                                   sizeof(fast) - skew, &fast_len)
+                        == MATTER_MSG_SUCCESS, "Fast encode failed");
+            TEST_ASSERT(fast_len == general_len, "Fast encode length mismatch");
+            TEST_ASSERT(memcmp(fast + skew, general, general_len) == 0,
+                        "Fast encode bytes differ from general path");
+        }
+
+        // Fixed-layout decode must agree with the general decoder
+        matter_message_t a, b;
+        memset(&a, 0, sizeof(a));
+        memset(&b, 0, sizeof(b));
+        TEST_ASSERT(matter_message_decode(general, general_len, &a) == MATTER_MSG_SUCCESS,
+                    "General decode failed");
+        TEST_ASSERT(matter_message_decode_fast(general, general_len, &b) == MATTER_MSG_SUCCESS,
+                    "Fast decode failed");
+        TEST_ASSERT(memcmp(&a.header, &b.header, sizeof(a.header)) == 0,
+                    "Fast decode header mismatch");
+        TEST_ASSERT(a.protocol_id == b.protocol_id &&
+                    a.protocol_opcode == b.protocol_opcode &&
+                    a.exchange_id == b.exchange_id, "Fast decode exchange header mismatch");
+        TEST_ASSERT(a.payload == b.payload && a.payload_length == b.payload_length,
+                    "Fast decode payload mismatch");
+    }
+
+    TEST_PASS();
+}
+
+/**
+ * Test fast path error handling and fallbacks
+ */
+void test_fast_path_edge_cases(void) {
+    uint8_t buffer[32];
+    size_t encoded_length;
+    matter_header_template_t tmpl;
+    matter_message_t msg = {0};
+
+    matter_header_template_init(&tmpl, 0, 0, 0x55, 0);
+    TEST_ASSERT(tmpl.fast, "Plain unicast template should take the fast path");
+    TEST_ASSERT(tmpl.header_len == 16, "Template header length mismatch");
+
+    TEST_ASSERT(matter_message_encode_fast(NULL, &msg, buffer, sizeof(buffer), &encoded_length)
+                == MATTER_MSG_ERROR_INVALID_INPUT, "Should reject NULL template");
+
+    msg.payload_length = sizeof(buffer);
+    TEST_ASSERT(matter_message_encode_fast(&tmpl, &msg, buffer, sizeof(buffer), &encoded_length)
+                == MATTER_MSG_ERROR_BUFFER_TOO_SMALL, "Should reject oversized payload");
+
+    TEST_ASSERT(matter_message_decode_fast(buffer, 4, &msg)
+                == MATTER_MSG_ERROR_INVALID_INPUT, "Should reject short buffer");
+
+    // Source node ID flagged but truncated
+    memset(buffer, 0, sizeof(buffer));
+    buffer[0] = MATTER_MSG_FLAG_S;
+    buffer[1] = 0x01;  // Secured session, no exchange header parsing
+    TEST_ASSERT(matter_message_decode_fast(buffer, 12, &msg)
+                == MATTER_MSG_ERROR_BUFFER_UNDERFLOW, "Should reject truncated node ID");
+
+    // Unusual flags are delegated to the general decoder
+    buffer[0] = 0xF0;
+    TEST_ASSERT(matter_message_decode_fast(buffer, 20, &msg)
+                == MATTER_MSG_ERROR_INVALID_VERSION, "Should reject invalid version");
+
+    // Ack flag in the exchange header: counter is parsed and skipped
+    memset(buffer, 0, sizeof(buffer));
+    buffer[8] = MATTER_EXCH_FLAG_ACK;
+    TEST_ASSERT(matter_message_decode_fast(buffer, 20, &msg) == MATTER_MSG_SUCCESS,
+                "Ack-flagged decode failed");
+    TEST_ASSERT(msg.payload_length == 20 - 8 - 6 - 4, "Ack counter not skipped");
+
+    TEST_PASS();
+}
+
+/**
+ * Test MRP exchange flags and the acknowledged counter round-trip
+ */
+void test_exchange_ack_roundtrip(void) {
+    const uint8_t payload[] = {0x15, 0x18};
+    uint8_t general[64];
+    uint8_t fast[64];
+    size_t general_len = 0, fast_len = 0;
+    matter_header_template_t tmpl;
+    matter_header_template_init(&tmpl, 0, 0, 0x1122334455667788ULL, 0);
+
+    matter_message_t msg = {0};
+    msg.header.source_node_id = 0x1122334455667788ULL;
+    msg.header.message_counter = 9;
+    msg.protocol_id = MATTER_PROTOCOL_INTERACTION_MODEL;
+    msg.protocol_opcode = MATTER_IM_OPCODE_REPORT_DATA;
+    msg.exchange_id = 0x0A0B;
+    msg.exchange_flags = MATTER_EXCH_FLAG_ACK | MATTER_EXCH_FLAG_RELIABILITY;
+    msg.ack_counter = 0xCAFEF00D;
+    msg.payload = payload;
+    msg.payload_length = sizeof(payload);
+
+    TEST_ASSERT(matter_exchange_header_size(&msg) == 10, "Ack adds 4 bytes");
+    TEST_ASSERT(matter_message_encode(&msg, general, sizeof(general), &general_len)
+                == MATTER_MSG_SUCCESS, "General encode failed");
+    TEST_ASSERT(general_len == 16 + 10 + sizeof(payload), "Encoded length mismatch");
+    TEST_ASSERT(matter_message_encode_fast(&tmpl, &msg, fast, sizeof(fast), &fast_len)
+                == MATTER_MSG_SUCCESS, "Fast encode failed");
+    TEST_ASSERT(fast_len == general_len && memcmp(fast, general, general_len) == 0,
+                "Fast encode differs with ack counter");
+
+    matter_message_t a, b;
+    memset(&a, 0, sizeof(a));
+    memset(&b, 0, sizeof(b));
+    TEST_ASSERT(matter_message_decode(general, general_len, &a) == MATTER_MSG_SUCCESS &&
+                matter_message_decode_fast(general, general_len, &b) == MATTER_MSG_SUCCESS,
+                "Decode failed");
+    TEST_ASSERT(a.exchange_flags == msg.exchange_flags && b.exchange_flags == msg.exchange_flags,
+                "Exchange flags mismatch");
+    TEST_ASSERT(a.ack_counter == 0xCAFEF00D && b.ack_counter == 0xCAFEF00D,
+                "Ack counter mismatch");
+    TEST_ASSERT(b.payload_length == sizeof(payload) && b.payload[0] == 0x15,
+                "Payload mismatch");
+
+    // Secured messages: exchange header decoded from the (decrypted) payload
+    matter_message_t sec = {0};
+    sec.payload = general + 16;
+    sec.payload_length = general_len - 16;
+    TEST_ASSERT(matter_exchange_header_decode(&sec) == MATTER_MSG_SUCCESS,
+                "Exchange header decode failed");
+    TEST_ASSERT(sec.exchange_id == 0x0A0B && sec.ack_counter == 0xCAFEF00D &&
+                sec.protocol_opcode == MATTER_IM_OPCODE_REPORT_DATA &&
+                sec.payload_length == sizeof(payload), "Exchange header fields mismatch");
+
+    sec.payload = general + 16;
+    sec.payload_length = 8;     // Ack flagged but counter truncated
+    TEST_ASSERT(matter_exchange_header_decode(&sec) == MATTER_MSG_ERROR_BUFFER_UNDERFLOW,
+                "Should reject truncated exchange header");
+
+    TEST_PASS();
+}
+
 /**
  * Main test runner
  */
@@ -277,6 +458,9 @@ int main(void) {
     test_payload_with_tlv_data();
     test_message_counter_increment();
     test_invalid_message_handling();
+    test_fast_encode_matches_general();
+    test_fast_path_edge_cases();
+    test_exchange_ack_roundtrip();
     
     printf("\n=== Test Results ===\n");
     printf("Passed: %d\n", tests_passed);
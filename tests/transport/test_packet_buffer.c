@@ -0,0 +1,139 @@
+/*
+ * test_packet_buffer.c
+ * Unit tests for the headroom-reserving packet buffer
+ */
+
+#include "packet_buffer.h"
+#include "message_codec.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+// Test result tracking
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+#define TEST_ASSERT(cond, msg) do { \
+    if (!(cond)) { \
+        printf("FAIL: %s - %s\n", __func__, msg); \
+        tests_failed++; \
+        return; \
+    } \
+} while(0)
+
+#define TEST_PASS() do { \
+    printf("PASS: %s\n", __func__); \
+    tests_passed++; \
+} while(0)
+
+static packet_buffer_t pb;
+
+/**
+ * Test reset geometry and tailroom accounting
+ */
+void test_reset_and_tailroom(void) {
+    packet_buffer_reset(&pb);
+    TEST_ASSERT(pb.length == 0, "Reset buffer should be empty");
+    TEST_ASSERT(packet_buffer_tail(&pb) == &pb.data[PACKET_BUFFER_HEADER_RESERVE],
+                "Payload should start after header reserve");
+    TEST_ASSERT(packet_buffer_tailroom(&pb) ==
+                PACKET_BUFFER_SIZE - PACKET_BUFFER_HEADER_RESERVE - PACKET_BUFFER_MIC_RESERVE,
+                "Tailroom should exclude header and MIC reserves");
+
+    TEST_ASSERT(packet_buffer_commit(&pb, 100) == 0, "Commit failed");
+    TEST_ASSERT(pb.length == 100, "Commit length mismatch");
+    TEST_ASSERT(packet_buffer_commit(&pb, packet_buffer_tailroom(&pb) + 1) == -1,
+                "Should reject commit past MIC reserve");
+
+    TEST_PASS();
+}
+
+/**
+ * Test that in-place header encoding matches the general encoder
+ */
+void test_prepend_header_matches_encode(void) {
+    const uint8_t payload[] = {0x15, 0x35, 0x01, 0x24, 0x00, 0x01, 0x18, 0x18};
+    const uint64_t node_ids[] = {0, 0x1122334455667788ULL};
+
+    for (size_t i = 0; i < 2; i++) {
+        matter_header_template_t tmpl;
+        matter_header_template_init(&tmpl, 0, 0, node_ids[i], 0);
+
+        matter_message_t msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.header.source_node_id = node_ids[i];
+        msg.header.message_counter = 77;
+        msg.protocol_id = MATTER_PROTOCOL_INTERACTION_MODEL;
+        msg.protocol_opcode = MATTER_IM_OPCODE_REPORT_DATA;
+        msg.exchange_id = 0x1234;
+        msg.payload = payload;
+        msg.payload_length = sizeof(payload);
+
+        uint8_t expected[64];
+        size_t expected_len = 0;
+        TEST_ASSERT(matter_message_encode(&msg, expected, sizeof(expected), &expected_len)
+                    == MATTER_MSG_SUCCESS, "Reference encode failed");
+
+        packet_buffer_reset(&pb);
+        memcpy(packet_buffer_tail(&pb), payload, sizeof(payload));
+        TEST_ASSERT(packet_buffer_commit(&pb, sizeof(payload)) == 0, "Commit failed");
+        TEST_ASSERT(packet_buffer_prepend_header(&pb, &tmpl, &msg) == MATTER_MSG_SUCCESS,
+                    "Prepend header failed");
+
+        TEST_ASSERT(pb.length == expected_len, "Encoded length mismatch");
+        TEST_ASSERT(memcmp(packet_buffer_data(&pb), expected, expected_len) == 0,
+                    "In-place encoding differs from general encoder");
+        TEST_ASSERT(((uintptr_t)packet_buffer_data(&pb) & 3u) == 0,
+                    "Message header should start word-aligned");
+    }
+
+    TEST_PASS();
+}
+
+/**
+ * Test headroom exhaustion and rollback
+ */
+void test_prepend_errors(void) {
+    matter_header_template_t tmpl;
+    matter_message_t msg;
+    memset(&msg, 0, sizeof(msg));
+    matter_header_template_init(&tmpl, 0, 0, 0, 0);
+
+    packet_buffer_reset(&pb);
+    TEST_ASSERT(packet_buffer_prepend(&pb, PACKET_BUFFER_HEADER_RESERVE + 1) == NULL,
+                "Should reject prepend beyond headroom");
+    TEST_ASSERT(pb.start == PACKET_BUFFER_HEADER_RESERVE && pb.length == 0,
+                "Failed prepend must not modify buffer");
+
+    TEST_ASSERT(packet_buffer_prepend_header(NULL, &tmpl, &msg)
+                == MATTER_MSG_ERROR_INVALID_INPUT, "Should reject NULL buffer");
+
+    // Headers already consumed the reserve: a second prepend must fail cleanly
+    TEST_ASSERT(packet_buffer_prepend_header(&pb, &tmpl, &msg) == MATTER_MSG_SUCCESS,
+                "First prepend failed");
+    size_t start = pb.start, length = pb.length;
+    matter_header_template_init(&tmpl, 0, 0, 1, 2);
+    TEST_ASSERT(packet_buffer_prepend_header(&pb, &tmpl, &msg)
+                == MATTER_MSG_ERROR_BUFFER_TOO_SMALL, "Should run out of headroom");
+    TEST_ASSERT(pb.start == start && pb.length == length,
+                "Failed prepend must not modify buffer");
+
+    TEST_PASS();
+}
+
+/**
+ * Main test runner
+ */
+int main(void) {
+    printf("=== Packet Buffer Tests ===\n\n");
+
+    test_reset_and_tailroom();
+    test_prepend_header_matches_encode();
+    test_prepend_errors();
+
+    printf("\n=== Test Results ===\n");
+    printf("Passed: %d\n", tests_passed);
+    printf("Failed: %d\n", tests_failed);
+
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+"""
+Generate the fixed-base comb tables used by src/matter_minimal/security/p256_fixed.c.
+
+For each base point B (the P-256 generator G and the SPAKE2+ points M and N)
+and a comb of T teeth spaced D = ceil(256 / T) bits apart, entry j
+(1 <= j < 2^T) holds
+
+    sum over set bits i of j:  2^(i * D) * B
+
+as an affine point.  Coordinates are written in Montgomery form
+(x * 2^256 mod p) as eight little-endian 32-bit limbs, which is the
+representation p256_fixed.c computes in, so the table can live in flash as
+plain `const` data.
+
+Run by CMake at build time; can also be run by hand:
+
+    ./tools/gen_p256_comb.py --teeth 6 --output p256_comb_tables.c
+"""
+
+import argparse
+import sys
+
+# P-256 domain parameters (SEC 2 / FIPS 186-4)
+P = 0xFFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF
+A = P - 3
+B = 0x5AC635D8AA3A93E7B3EBBD55769886BC651D06B0CC53B0F63BCE3C3E27D2604B
+N = 0xFFFFFFFF00000000FFFFFFFFFFFFFFFFBCE6FAADA7179E84F3B9CAC2FC632551
+
+# Base points: name -> (x, y).  M and N are the SPAKE2+ P-256 points from
+# the Matter Core Specification (same values as SPAKE2_M_P256 / SPAKE2_N_P256
+# in pase.c).
+BASES = [
+    ("G", (0x6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296,
+           0x4FE342E2FE1A7F9B8EE7EB4A7C0F9E162BCE33576B315ECECBB6406837BF51F5)),
+    ("M", (0x886E2F97ACE46E55BA9DD7242579F2993B64E16EF3DCAB95AFD497333D8FA12F,
+           0x5FF355163E43CE224E0B0E65FF02AC8E5C7BE09419C785E0CA547D55A12E2D20)),
+    ("N", (0xD8BBD6C639C62937B04D997F38C3770719C629D7014D49A24B4F98BAA1292B49,
+           0x07D60AA6BFADE45008A636337F5168C64D9BD36034808CD564490B1E656EDBE7)),
+]
+
+MONT_R = 1 << 256
+
+
+def on_curve(pt):
+    x, y = pt
+    return (y * y - (x * x * x + A * x + B)) % P == 0
+
+
+def add(p1, p2):
+    if p1 is None:
+        return p2
+    if p2 is None:
+        return p1
+    x1, y1 = p1
+    x2, y2 = p2
+    if x1 == x2:
+        if (y1 + y2) % P == 0:
+            return None
+        lam = (3 * x1 * x1 + A) * pow(2 * y1, P - 2, P) % P
+    else:
+        lam = (y2 - y1) * pow(x2 - x1, P - 2, P) % P
+    x3 = (lam * lam - x1 - x2) % P
+    return x3, (lam * (x1 - x3) - y1) % P
+
+
+def mul(k, pt):
+    result = None
+    while k:
+        if k & 1:
+            result = add(result, pt)
+        pt = add(pt, pt)
+        k >>= 1
+    return result
+
+
+def comb_table(base, teeth, spacing):
+    # Tooth points 2^(i * spacing) * B, then every subset sum
+    tooth = [mul(1 << (i * spacing), base) for i in range(teeth)]
+    table = [None] * (1 << teeth)
+    for j in range(1, 1 << teeth):
+        top = j.bit_length() - 1
+        table[j] = add(table[j ^ (1 << top)], tooth[top])
+    return table[1:]
+
+
+def limbs(v):
+    v = v * MONT_R % P
+    return ["0x%08X" % ((v >> (32 * i)) & 0xFFFFFFFF) for i in range(8)]
+
+
+def generate(teeth):
+    spacing = (256 + teeth - 1) // teeth
+    out = []
+    out.append("/*")
+    out.append(" * p256_comb_tables.c")
+    out.append(" * GENERATED by tools/gen_p256_comb.py - do not edit.")
+    out.append(" *")
+    out.append(" * Fixed-base comb tables for P-256: %d teeth, %d bits apart." % (teeth, spacing))
+    out.append(" * Affine points, Montgomery form, little-endian 32-bit limbs (x then y).")
+    out.append(" */")
+    out.append("")
+    out.append('#include "p256_fixed.h"')
+    out.append("")
+    out.append("#if P256_COMB_TEETH != %d" % teeth)
+    out.append('#error "p256_comb_tables.c was generated for a different P256_COMB_TEETH"')
+    out.append("#endif")
+    out.append("")
+    out.append("const uint32_t p256_comb_tables[P256_BASE_COUNT][P256_COMB_POINTS][16] = {")
+    for name, base in BASES:
+        if not on_curve(base):
+            sys.exit("base point %s is not on P-256" % name)
+        if mul(N, base) is not None:
+            sys.exit("base point %s does not have order n" % name)
+        out.append("    /* %s */" % name)
+        out.append("    {")
+        for pt in comb_table(base, teeth, spacing):
+            x, y = limbs(pt[0]), limbs(pt[1])
+            out.append("        { %s," % ", ".join(x[:4]))
+            out.append("          %s," % ", ".join(x[4:]))
+            out.append("          %s," % ", ".join(y[:4]))
+            out.append("          %s }," % ", ".join(y[4:]))
+        out.append("    },")
+    out.append("};")
+    out.append("")
+    return "\n".join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--teeth", type=int, default=6,
+                        help="comb teeth (table has 2^teeth - 1 points per base)")
+    parser.add_argument("--output", required=True, help="C file to write")
+    args = parser.parse_args()
+    if not 2 <= args.teeth <= 8:
+        sys.exit("--teeth must be between 2 and 8")
+    with open(args.output, "w") as f:
+        f.write(generate(args.teeth))
+
+
+if __name__ == "__main__":
+    main()
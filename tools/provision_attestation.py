@@ -24,6 +24,12 @@ Usage:
       --key  certs/dac_key.der \\
       --cd   certs/cd.der       # optional
 
+  # Precompute the PASE verifier (w0, L) so the device never runs PBKDF2.
+  # The setup PIN is derived from the MAC address as the firmware does
+  # (tools/derive_pin.py); --pin, if also given, must match it:
+  python3 tools/provision_attestation.py --port /dev/ttyACM0 \\
+      --mac 28:CD:C1:00:00:01
+
   # Verify what was stored:
   python3 tools/provision_attestation.py --port /dev/ttyACM0 --verify
 
@@ -41,6 +47,8 @@ import sys
 import os
 import time
 import binascii
+import hashlib
+import struct
 
 try:
     import serial
@@ -56,12 +64,19 @@ PATH_DAC = "/att_dac"
 PATH_PAI = "/att_pai"
 PATH_KEY = "/att_key"
 PATH_CD  = "/att_cd"
+PATH_PASE_VERIFIER = "/pase_verifier"   # PASE_VERIFIER_PATH in pase_verifier.h
 
 # Maximum sizes (must match firmware ATT_MAX_CERT_SIZE / ATT_MAX_KEY_SIZE)
 MAX_CERT = 600
 MAX_KEY  = 128
 MAX_CD   = 512
 
+# PASE verifier record (must match pase_verifier.h / pase.h)
+PASE_VERIFIER_VERSION = 2
+PASE_PROVISIONING_GENERATION = 1        # default, see --generation
+PASE_PBKDF2_ITERATIONS = 2000
+PASE_SALT_LENGTH = 32
+
 
 # ── Utility ──────────────────────────────────────────────────────────────────
 
@@ -103,6 +118,65 @@ def read_der(path: str, max_size: int, label: str) -> bytes:
     return data
 
 
+def make_pase_verifier(pin: str, generation: int) -> bytes:
+    """
+    Derive the SPAKE2+ verifier for a setup PIN the same way pase_init()
+    does on first boot: w0 || w1 = PBKDF2-HMAC-SHA256(PIN, salt, 64 bytes),
+    L = w1 * G.  Returns the record stored at PATH_PASE_VERIFIER:
+    version (1) | iterations (4, LE) | salt (32) | w0 (32) | L (65) |
+    generation tag (32), the tag being
+    SHA-256(salt | iterations (4, LE) | generation (4, LE)).
+    The tag does not cover the PIN, so pass the PIN from setup_pin_for().
+    """
+    if len(pin) != 8 or not pin.isdigit():
+        sys.exit("ERROR: setup PIN must be 8 digits")
+
+    # Reuse the P-256 reference arithmetic from the comb table generator
+    sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+    from gen_p256_comb import BASES, N, mul
+
+    salt = os.urandom(PASE_SALT_LENGTH)
+    derived = hashlib.pbkdf2_hmac("sha256", pin.encode("ascii"), salt,
+                                  PASE_PBKDF2_ITERATIONS, 64)
+    w0 = derived[:32]
+    w1 = int.from_bytes(derived[32:], "big") % N
+    if w1 == 0:
+        sys.exit("ERROR: degenerate w1, run again for a new salt")
+    x, y = mul(w1, BASES[0][1])
+    L = b"\x04" + x.to_bytes(32, "big") + y.to_bytes(32, "big")
+
+    print(f"  [PASE] verifier for PIN ******** "
+          f"({PASE_PBKDF2_ITERATIONS} iterations)")
+    generation_tag = hashlib.sha256(
+        salt + struct.pack("<II", PASE_PBKDF2_ITERATIONS, generation)).digest()
+    return (struct.pack("<BI", PASE_VERIFIER_VERSION, PASE_PBKDF2_ITERATIONS)
+            + salt + w0 + L + generation_tag)
+
+
+def setup_pin_for(mac: str, pin: str) -> str:
+    """
+    The setup PIN the device uses: the firmware derives it from its MAC
+    address (platform_manager_derive_setup_pin()), so derive it the same
+    way with tools/derive_pin.py.  A PIN given as well must match, since a
+    verifier for any other PIN would never let PASE succeed.
+    """
+    if not mac:
+        sys.exit("ERROR: --mac is required for the PASE verifier: the device "
+                 "derives its setup PIN from its MAC address")
+
+    sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+    from derive_pin import parse_mac, derive_pin_from_mac
+
+    try:
+        derived = derive_pin_from_mac(parse_mac(mac))
+    except ValueError as e:
+        sys.exit(f"ERROR: {e}")
+    if pin is not None and pin != derived:
+        sys.exit("ERROR: --pin does not match the PIN the device derives "
+                 "from this MAC (check PRODUCT_SALT in tools/derive_pin.py)")
+    return derived
+
+
 # ── Serial-based provisioning ────────────────────────────────────────────────
 
 def provision_via_serial(port: str, baud: int, credentials: dict):
@@ -173,6 +247,13 @@ def main():
     parser.add_argument("--pai",  help="Path to PAI cert (DER or PEM)")
     parser.add_argument("--key",  help="Path to DAC private key (DER or PEM)")
     parser.add_argument("--cd",   help="Path to Certification Declaration (DER, optional)")
+    parser.add_argument("--mac",  help="Device MAC address: store the precomputed PASE "
+                                       "verifier for the setup PIN derived from it")
+    parser.add_argument("--pin",  help="Expected setup PIN, checked against the one "
+                                       "derived from --mac")
+    parser.add_argument("--generation", type=int, default=PASE_PROVISIONING_GENERATION,
+                        help="Provisioning generation of the PASE verifier "
+                             "(must match the firmware's PASE_PROVISIONING_GENERATION)")
     parser.add_argument("--verify", action="store_true",
                         help="Verify stored credentials (do not write)")
     args = parser.parse_args()
@@ -181,8 +262,8 @@ def main():
         verify_via_serial(args.port, args.baud)
         return
 
-    if not any([args.dac, args.pai, args.key]):
-        parser.error("At least one of --dac, --pai, --key is required")
+    if not any([args.dac, args.pai, args.key, args.mac, args.pin]):
+        parser.error("At least one of --dac, --pai, --key, --mac is required")
 
     print("Viking Bio Matter – Attestation Credential Provisioning")
     print("=========================================================")
@@ -199,6 +280,9 @@ def main():
         credentials[PATH_KEY] = read_der(args.key, MAX_KEY,  "DAC key")
     if args.cd:
         credentials[PATH_CD]  = read_der(args.cd,  MAX_CD,   "CD")
+    if args.mac or args.pin:
+        pin = setup_pin_for(args.mac, args.pin)
+        credentials[PATH_PASE_VERIFIER] = make_pase_verifier(pin, args.generation)
 
     provision_via_serial(args.port, args.baud, credentials)
 